@@ -66,6 +66,38 @@ typedef enum
     CF_CFDP_CLASS_2 = 1, /**< \brief CFDP class 2 - Reliable transfer */
 } CF_CFDP_Class_t;
 
+/**
+ * @brief Order the files of a playback directory are sent in
+ *
+ * In name order the directory is read once, and each
+ * CF_PLAYBACK_WORK_LIST_SIZE entries are sorted and sent as they are read.
+ * The other orders are over the whole directory: every file is stat'd, and
+ * the directory is read to the end before any of it is sent, then again for
+ * each CF_PLAYBACK_ORDER_LIST_SIZE files sent. A directory of N files takes
+ * about N * N / CF_PLAYBACK_ORDER_LIST_SIZE reads and stats in all, and
+ * nothing is sent while each pass is read. Entries that are equal otherwise
+ * are sent in name order.
+ */
+typedef enum
+{
+    CF_PlaybackOrder_NAME     = 0, /**< \brief by name */
+    CF_PlaybackOrder_OLDEST   = 1, /**< \brief oldest modification time first */
+    CF_PlaybackOrder_NEWEST   = 2, /**< \brief newest modification time first */
+    CF_PlaybackOrder_SMALLEST = 3, /**< \brief smallest first, to get the most files down */
+    CF_PlaybackOrder_NUM      = 4,
+} CF_PlaybackOrder_t;
+
+/**
+ * @brief Whether the file data of a commanded send is compressed
+ */
+typedef enum
+{
+    CF_TxCompress_CHANNEL = 0, /**< \brief as the channel's tx_compress sets */
+    CF_TxCompress_ON      = 1, /**< \brief compressed, for receivers that are CF */
+    CF_TxCompress_OFF     = 2, /**< \brief sent as it is */
+    CF_TxCompress_NUM     = 3,
+} CF_TxCompress_t;
+
 /**
  * @brief CF queue identifiers
  */
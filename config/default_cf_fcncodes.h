@@ -80,6 +80,7 @@ typedef enum
      *       - 2 = fault counters
      *       - 3 = up counters
      *       - 4 = down counters
+     *       - 5 = diagnostics latency histograms
      *
      *  \par Command Verification
      *       Successful execution of this command may be verified with
@@ -104,7 +105,8 @@ typedef enum
      * \brief Transmit file
      *
      *  \par Description
-     *       Requests transmission of a file
+     *       Requests transmission of a file, compressed as compress
+     *       (#CF_TxCompress_t) sets
      *
      *  \par Command Structure
      *       #CF_TxFileCmd_t
@@ -135,7 +137,9 @@ typedef enum
      * \brief Playback a directory
      *
      *  \par Description
-     *       Transmits all the files in a directory
+     *       Transmits all the files in a directory, at most max_ts of them at once,
+     *       in the order given by order (#CF_PlaybackOrder_t), each compressed as
+     *       compress (#CF_TxCompress_t) sets
      *
      *  \par Command Structure
      *       #CF_PlaybackDirCmd_t - note it's currently a typedef of CF_TxFileCmd_t, where
@@ -722,8 +726,115 @@ typedef enum
      */
     CF_DISABLE_ENGINE_CC = 23,
 
+    /**
+     * \brief Write trace
+     *
+     *  \par Description
+     *       Writes the binary trace ring to a file. The command opens the
+     *       file, and the entries that are in the ring at that point are
+     *       written a few at a time on the following wakeups while tracing
+     *       carries on. Entries that are overwritten before they can be
+     *       written are skipped. The file can be decoded on the ground with
+     *       tools/cf_trace_decode.py.
+     *
+     *  \par Command Structure
+     *       #CF_WriteTraceCmd_t
+     *
+     *  \par Command Verification
+     *       Successful execution of this command may be verified with
+     *       the following telemetry:
+     *       - #CF_HkPacket_Payload_t.counters #CF_HkCmdCounters_t.cmd will increment
+     *       - #CF_CMD_WRITE_TRACE_INF_EID
+     *       - #CF_TRACE_DUMP_INF_EID once the dump is complete
+     *
+     *  \par Error Conditions
+     *       This command may fail for the following reason(s):
+     *       - Command packet length not as expected, #CF_CMD_LEN_ERR_EID
+     *       - Trace dump already in progress, or open file to write failed, #CF_CMD_WRITE_TRACE_ERR_EID
+     *       - Write to the file failed during the dump, #CF_TRACE_DUMP_ERR_EID
+     *
+     *  \par Evidence of failure may be found in the following telemetry:
+     *       - #CF_HkPacket_Payload_t.counters #CF_HkCmdCounters_t.err will increment
+     *
+     *  \par Criticality
+     *       None
+     *
+     *  \sa #CF_WRITE_QUEUE_CC
+     */
+    CF_WRITE_TRACE_CC = 24,
+
+    /**
+     * \brief Transmit file to multiple destinations
+     *
+     *  \par Description
+     *       Requests transmission of a file to up to #CF_TX_MULTI_MAX_DEST
+     *       destinations. Each destination gets its own transaction, with its
+     *       own NAK handling, but the file is opened, read and checksummed
+     *       once for all of them.
+     *
+     *  \par Command Structure
+     *       #CF_TxFileMultiCmd_t
+     *
+     *  \par Command Verification
+     *       Successful execution of this command may be verified with
+     *       the following telemetry:
+     *       - #CF_HkPacket_Payload_t.counters #CF_HkCmdCounters_t.cmd will increment
+     *       - #CF_CMD_TX_FILE_MULTI_INF_EID
+     *
+     *  \par Error Conditions
+     *       This command may fail for the following reason(s):
+     *       - Command packet length not as expected, #CF_CMD_LEN_ERR_EID
+     *       - Invalid parameter, #CF_CMD_BAD_PARAM_ERR_EID
+     *       - No fan-out group free, or the file cannot be opened, #CF_CFDP_FANOUT_ERR_EID
+     *       - Transaction initialization failure, #CF_CMD_TX_FILE_MULTI_ERR_EID
+     *
+     *  \par Evidence of failure may be found in the following telemetry:
+     *       - #CF_HkPacket_Payload_t.counters #CF_HkCmdCounters_t.err will increment
+     *
+     *  \par Criticality
+     *       None
+     *
+     *  \sa #CF_TX_FILE_CC
+     */
+    CF_TX_FILE_MULTI_CC = 25,
+
+    /**
+     * \brief Transmit a file that is still being written
+     *
+     *  \par Description
+     *       Requests transmission of a file that another application is still
+     *       writing. File data is sent as it appears, and the EOF is only sent
+     *       once the size of the file has not changed for the channel's
+     *       tx_follow_quiet_s seconds. The metadata gives the size as 0,
+     *       unbounded, and the EOF gives the final size.
+     *
+     *  \par Command Structure
+     *       #CF_TxFileFollowCmd_t
+     *
+     *  \par Command Verification
+     *       Successful execution of this command may be verified with
+     *       the following telemetry:
+     *       - #CF_HkPacket_Payload_t.counters #CF_HkCmdCounters_t.cmd will increment
+     *       - #CF_CMD_TX_FILE_FOLLOW_INF_EID
+     *
+     *  \par Error Conditions
+     *       This command may fail for the following reason(s):
+     *       - Command packet length not as expected, #CF_CMD_LEN_ERR_EID
+     *       - Invalid parameter, #CF_CMD_BAD_PARAM_ERR_EID
+     *       - Transaction initialization failure, #CF_CMD_TX_FILE_FOLLOW_ERR_EID
+     *
+     *  \par Evidence of failure may be found in the following telemetry:
+     *       - #CF_HkPacket_Payload_t.counters #CF_HkCmdCounters_t.err will increment
+     *
+     *  \par Criticality
+     *       None
+     *
+     *  \sa #CF_TX_FILE_CC
+     */
+    CF_TX_FILE_FOLLOW_CC = 26,
+
     /** \brief Command code limit used for validity check and array sizing */
-    CF_NUM_COMMANDS = 24,
+    CF_NUM_COMMANDS = 27,
 } CF_CMDS;
 
 /**\}*/
@@ -78,6 +78,48 @@
  */
 #define CF_MAX_POLLING_DIR_PER_CHAN (5)
 
+/**
+ *  @brief Number of peer entities tracked by flow control
+ *
+ *  @par Description:
+ *       Each destination entity that CF sends file data to is assigned
+ *       a flow control entry, up to this many. The state of each entry is
+ *       reported in housekeeping telemetry. Destinations beyond this number
+ *       are sent to without flow control.
+ *
+ *  @par Limits:
+ *       Must be at least 1.
+ */
+#define CF_NUM_FLOW_PEERS (4)
+
+/**
+ *  @brief Maximum destinations of a multi-destination transmit command
+ *
+ *  @par Description:
+ *       Size of the destination entity id list in the multi-destination
+ *       transmit command. Each destination is sent the file by its own
+ *       transaction, and all of them share one read of the source file.
+ *
+ *  @par Limits:
+ *       Must be at least 1.
+ */
+#define CF_TX_MULTI_MAX_DEST (4)
+
+/**
+ *  @brief Number of buckets in each latency histogram
+ *
+ *  @par Description:
+ *       Each latency histogram in the diagnostics packet has this many
+ *       buckets. The first bucket counts samples shorter than 16
+ *       microseconds, each following bucket covers four times the range
+ *       of the one before it, and the last bucket counts everything
+ *       longer. With 8 buckets the last one starts at 65.536 ms.
+ *
+ *  @par Limits:
+ *       2 - 15.
+ */
+#define CF_INSTR_NUM_BUCKETS (8)
+
 /**
  *  @brief Max PDU size.
  *
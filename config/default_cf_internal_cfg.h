@@ -157,14 +157,50 @@
  *  @brief Number of transactions per playback directory.
  *
  *  @par Description:
- *       Each playback/polling directory operation will be able to have this
- *       many active transfers at a time pending or active.
+ *       Each playback/polling directory operation has this many transfers
+ *       pending or active at a time, unless the playback command or the
+ *       polling directory configuration gives a number other than 0. The
+ *       channel has this many transactions per playback, but they are
+ *       shared by all of its playbacks, so one can use more while the
+ *       others are idle.
  *
  *  @par Limits:
- *
+ *       Must be less than 256.
  */
 #define CF_NUM_TRANSACTIONS_PER_PLAYBACK (5)
 
+/**
+ *  @brief Number of directory entries a playback in name order reads at a time.
+ *
+ *  @par Description:
+ *       A playback/polling directory operation in name order reads this
+ *       many entries of its directory into a work list, sorts them by name
+ *       and sends them, then reads on from there. The directory is read
+ *       once, and its files are only in name order within each list.
+ *
+ *  @par Limits:
+ *       Must be at least 1, and less than 65536.
+ */
+#define CF_PLAYBACK_WORK_LIST_SIZE (16)
+
+/**
+ *  @brief Number of directory entries a playback in time or size order sends in each pass.
+ *
+ *  @par Description:
+ *       A playback/polling directory operation in oldest, newest or
+ *       smallest first order reads and stats all of its directory, keeping
+ *       this many of the entries that go first, then sends them before
+ *       reading all of the directory again for the next lot. A directory
+ *       of N files is read about N / CF_PLAYBACK_ORDER_LIST_SIZE times, so
+ *       a larger list reads a large directory fewer times. Each entry takes
+ *       a little over CF_FILENAME_MAX_NAME bytes in every playback and
+ *       polling directory, whatever its order.
+ *
+ *  @par Limits:
+ *       Must be at least CF_PLAYBACK_WORK_LIST_SIZE, and less than 65536.
+ */
+#define CF_PLAYBACK_ORDER_LIST_SIZE (64)
+
 /**
  *  @brief Name of the CF Configuration Table
  *
@@ -203,11 +239,417 @@
  */
 #define CF_R2_CRC_CHUNK_SIZE (1024)
 
+/**
+ *  @brief Number of RAM staging buffers for R2 file data received before metadata
+ *
+ *  @par Description:
+ *       On a channel with rx_staging_enabled set, an R2 transaction that starts
+ *       without metadata takes one of these buffers instead of creating a temp
+ *       file. Once metadata arrives the staged data is written directly to the
+ *       destination file, so no rename or copy out of the temp directory is needed.
+ *       If no buffer is free, the temp file is used as before.
+ *
+ *  @par Limits:
+ *       Must be at least 1.
+ */
+#define CF_NUM_RX_STAGING_BUFFERS (2)
+
+/**
+ *  @brief Size in bytes of each R2 RAM staging buffer
+ *
+ *  @par Description:
+ *       File data at offsets beyond this size cannot be staged. When such data
+ *       arrives, the transaction spills what it has staged to the temp file
+ *       and continues from there.
+ *
+ *  @par Limits:
+ *       Must be at least 1.
+ */
+#define CF_RX_STAGING_BUFFER_SIZE (16384)
+
+/**
+ *  @brief Number of pending sends that can have their files got ready ahead
+ *
+ *  @par Description:
+ *       On a channel with tx_prefetch_depth set, the next pending sends have
+ *       their files opened, sized and first block read while the one before
+ *       them is still sending. Each such send takes one of these buffers,
+ *       and holds its file open, until its first file data PDU goes out.
+ *       This is the most files the engine holds open ahead of time.
+ *
+ *  @par Limits:
+ *       Must be at least 1.
+ */
+#define CF_NUM_TX_PREFETCH_BUFFERS (2)
+
+/**
+ *  @brief Path prefix served by the RAM filestore
+ *
+ *  @par Description:
+ *       Files whose names start with this prefix are held in memory by CF
+ *       rather than on a file system. They can be sent and received like
+ *       any other file, which allows memory-resident products to be
+ *       downlinked without first writing them to storage.
+ *
+ *  @par Limits:
+ *       Must not be a prefix of any path used on a real file system.
+ */
+#define CF_MEMSTORE_PATH_PREFIX ("/cfmem/")
+
+/**
+ *  @brief Number of files the RAM filestore can hold
+ *
+ *  @par Limits:
+ *       Must be at least 1.
+ */
+#define CF_MEMSTORE_NUM_FILES (2)
+
+/**
+ *  @brief Capacity in bytes of each file in the RAM filestore
+ *
+ *  @par Description:
+ *       Writes beyond this size are short, which CF treats as a write error.
+ *       Buffers attached with CF_Memstore_Attach() are not limited by this.
+ *
+ *  @par Limits:
+ *       Must be at least 1.
+ */
+#define CF_MEMSTORE_FILE_SIZE (32768)
+
+/**
+ *  @brief Number of RAM filestore files that may be open at once
+ *
+ *  @par Limits:
+ *       Must be at least 1.
+ */
+#define CF_MEMSTORE_NUM_HANDLES (4)
+
+/**
+ *  @brief Maximum number of PDUs received and dispatched as one batch
+ *
+ *  @par Description:
+ *       Each wakeup, a channel receives up to this many PDUs at a time,
+ *       decodes their headers, and then dispatches them grouped by
+ *       transaction, so that consecutive PDUs of the same transaction are
+ *       handled back to back. Received PDUs are held in the engine until
+ *       the batch is done, at CF_MAX_PDU_SIZE bytes each.
+ *
+ *  @par Limits:
+ *       Must be at least 1.
+ */
+#define CF_TRANSPORT_RX_BATCH_SIZE (8)
+
 /**
  *  @brief Number of milliseconds to wait for a SB message
  */
 #define CF_RCVMSG_TIMEOUT (100)
 
+/**
+ *  @brief Number of milliseconds to wait for a SB message when a channel is event-driven
+ *
+ *  @par Description:
+ *       A cFE app can only pend on one pipe, so while any channel has
+ *       rx_event_driven set, the command pipe wait is shortened to this and
+ *       the channel input is checked every time the wait ends. This bounds
+ *       how long a received PDU waits for its response. CF wakes this often
+ *       whether or not anything has arrived, so a shorter wait costs CPU time
+ *       even while the channel is idle.
+ *
+ *  @par Limits:
+ *       Must be at least 1 and no more than CF_RCVMSG_TIMEOUT.
+ */
+#define CF_EVENT_POLL_TIMEOUT (5)
+
+/**
+ *  @brief Maximum per-peer flow control window
+ *
+ *  @par Description:
+ *       Upper bound, in file data bytes per wakeup, that the loss-driven
+ *       flow control window for a single destination entity may grow to.
+ *       A new peer starts with this window and it is reduced multiplicatively
+ *       whenever the loss reported in NAK PDUs exceeds CF_FLOW_LOSS_THRESHOLD.
+ *       The window only becomes the limiting factor once it is smaller than the
+ *       channel's max_outgoing_messages_per_wakeup budget.
+ *
+ *  @par Limits:
+ *       Must be at least as large as the outgoing_file_chunk_size.
+ */
+#define CF_FLOW_MAX_WINDOW (65536)
+
+/**
+ *  @brief Per-peer loss threshold for window reduction
+ *
+ *  @par Description:
+ *       Fraction of file data (in parts per thousand) that a peer may NAK
+ *       relative to the bytes sent since its previous feedback before the
+ *       flow control window for that peer is halved.
+ *
+ *  @par Limits:
+ *       0 - 1000.  0 reduces the window on any reported loss.
+ */
+#define CF_FLOW_LOSS_THRESHOLD (20)
+
+/**
+ *  @brief Engine cycles an idle peer keeps its flow control entry
+ *
+ *  @par Description:
+ *       A peer that has had no file data sent to it and none in flight for
+ *       this many engine cycles gives up its flow control entry, so that
+ *       entries are not held by peers that are no longer being sent to.
+ *       Its window starts over at CF_FLOW_MAX_WINDOW if it is used again.
+ *
+ *  @par Limits:
+ *       Must be greater than 0.
+ */
+#define CF_FLOW_PEER_IDLE_CYCLES (6000)
+
+/**
+ *  @brief Enable hot path latency instrumentation
+ *
+ *  @par Description:
+ *       When nonzero, the per-channel engine work in each wakeup, the
+ *       dispatch of each received PDU, file reads, writes and seeks,
+ *       directory reads and SB buffer allocations are timed into the
+ *       latency histograms of the diagnostics packet, which is sent with
+ *       every housekeeping packet. When zero, the timing compiles away and
+ *       no diagnostics packet is sent.
+ *
+ *  @par Limits:
+ *       0 or 1.
+ */
+#define CF_INSTR_ENABLE (1)
+
+/**
+ *  @brief Enable the binary trace ring
+ *
+ *  @par Description:
+ *       When nonzero, PDUs sent and received, transaction state changes,
+ *       timer expirations and output stalls are recorded as fixed size
+ *       binary entries in an in-memory ring, which the write trace command
+ *       dumps to a file. When zero, the trace points compile away.
+ *
+ *  @par Limits:
+ *       0 or 1.
+ */
+#define CF_TRACE_ENABLE (1)
+
+/**
+ *  @brief Number of entries in the trace ring
+ *
+ *  @par Description:
+ *       Once the ring is full, each new entry replaces the oldest one.
+ *       Each entry takes 24 bytes.
+ *
+ *  @par Limits:
+ *       Must be a power of two.
+ */
+#define CF_TRACE_RING_ENTRIES (2048)
+
+/**
+ *  @brief Trace entries written to the dump file per wakeup
+ *
+ *  @par Description:
+ *       The write trace command only opens the file. The entries are
+ *       written a few at a time on each wakeup, so that a dump does not
+ *       delay the engine.
+ *
+ *  @par Limits:
+ *       Must be greater than zero.
+ */
+#define CF_TRACE_DUMP_ENTRIES_PER_WAKEUP (128)
+
+/**
+ *  @brief Interval over which repeated hot path error events are aggregated, in seconds
+ *
+ *  @par Description:
+ *       Error events that can be raised for every PDU, such as a PDU being
+ *       dropped, are sent in full the first time they happen in an interval.
+ *       Repeats within the interval are only counted, and one summary event
+ *       with the count and the last arguments is sent when it ends.
+ *
+ *  @par Limits:
+ *       Must be greater than zero.
+ */
+#define CF_EVENT_AGG_INTERVAL_S (10)
+
+/**
+ *  @brief Directory that transaction checkpoints are written to
+ *
+ *  @par Description:
+ *       Each long-running class 2 transaction is saved here as one small
+ *       file, and the transactions found here are resumed when the engine
+ *       starts. The directory must already exist.
+ *
+ *  @par Limits:
+ *       Must be on a filesystem that survives a restart, not the RAM filestore.
+ */
+#define CF_CHECKPOINT_DIR ("/cf/ckpt")
+
+/**
+ *  @brief Interval between checkpoints of a transaction, in seconds
+ *
+ *  @par Description:
+ *       Only transactions that have been running for at least this long
+ *       are checkpointed, so short transfers never cost a file write.
+ *       Set to 0 to turn checkpointing off. Checkpoints already in
+ *       CF_CHECKPOINT_DIR are still resumed.
+ *
+ *  @par Limits:
+ *       None.
+ */
+#define CF_CHECKPOINT_INTERVAL_S (30)
+
+/**
+ *  @brief Checkpoint files written per wakeup
+ *
+ *  @par Description:
+ *       A checkpoint pass over all transactions is spread across as many
+ *       wakeups as it takes, so that it never delays the engine by more
+ *       than this many file writes.
+ *
+ *  @par Limits:
+ *       Must be greater than zero.
+ */
+#define CF_CHECKPOINT_WRITES_PER_WAKEUP (2)
+
+/**
+ *  @brief Number of multi-destination sends that may run at once
+ *
+ *  @par Description:
+ *       Each multi-destination transmit command takes a fan-out group,
+ *       which holds the source file open once for all of its destinations
+ *       along with a read cache of CF_FANOUT_CACHE_BLOCKS blocks of
+ *       CF_FANOUT_CACHE_BLOCK_SIZE bytes.
+ *
+ *  @par Limits:
+ *       Must be at least 1.
+ */
+#define CF_NUM_FANOUT_GROUPS (2)
+
+/**
+ *  @brief Number of read cache blocks in each fan-out group
+ *
+ *  @par Description:
+ *       The destinations of a multi-destination send take turns sending
+ *       one PDU each, so in the common case they all read a block while
+ *       it is cached. A destination can still fall behind, when its flow
+ *       control window is used up or it is being sent retransmits. More
+ *       blocks let it read from the cache instead of the file.
+ *
+ *  @par Limits:
+ *       Must be at least 1.
+ */
+#define CF_FANOUT_CACHE_BLOCKS (4)
+
+/**
+ *  @brief Size of each fan-out read cache block in bytes
+ *
+ *  @par Description:
+ *       The source file of a multi-destination send is read in blocks of
+ *       this size, each of which serves the file data PDUs of every
+ *       destination that falls within it.
+ *
+ *  @par Limits:
+ *       Must be at least as large as the outgoing_file_chunk_size.
+ */
+#define CF_FANOUT_CACHE_BLOCK_SIZE (4096)
+
+/**
+ *  @brief File that the index of delivered files is kept in
+ *
+ *  @par Description:
+ *       On channels with tx_skip_delivered set, each file that a class 2
+ *       send delivers successfully is recorded here by destination entity,
+ *       destination file name, size and checksum. The index is read when
+ *       the engine starts and rewritten whenever an entry is added.
+ *
+ *  @par Limits:
+ *       Must be on a filesystem that survives a restart, not the RAM filestore.
+ */
+#define CF_DELIVERED_INDEX_FILE ("/cf/delivered.idx")
+
+/**
+ *  @brief Number of entries in the index of delivered files
+ *
+ *  @par Description:
+ *       Once the index is full, a new entry replaces the one that was
+ *       added or matched the longest time ago.
+ *
+ *  @par Limits:
+ *       Must be at least 1.
+ */
+#define CF_DELIVERED_INDEX_ENTRIES (32)
+
+/**
+ *  @brief Size of each block of a file that is compressed on its own
+ *
+ *  @par Description:
+ *       A file that is sent compressed is read and packed a block of
+ *       this many bytes at a time as it is sent, and each block can be
+ *       expanded by the receiver without the others. A larger block
+ *       compresses better, but the engine holds one block, and its
+ *       compressed form, in RAM.
+ *
+ *  @par Limits:
+ *       Must be between 64 and 32768.
+ */
+#define CF_COMPRESS_BLOCK_SIZE (4096)
+
+/**
+ *  @brief Directory that the block signatures of delivered files are kept in
+ *
+ *  @par Description:
+ *       On channels with tx_delta set, each file that a class 2 send
+ *       delivers successfully has the signatures of its blocks saved here,
+ *       one small file per destination entity and file name. The next send
+ *       to the same place sends only the blocks that differ from them. The
+ *       directory must already exist.
+ *
+ *  @par Limits:
+ *       Must be on a filesystem that survives a restart, not the RAM filestore.
+ */
+#define CF_DELTA_SIG_DIR ("/cf/sig")
+
+/**
+ *  @brief Size of each block of a file that is matched on its own by a delta
+ *
+ *  @par Description:
+ *       A smaller block finds more of an updated file unchanged, but takes
+ *       more signatures to cover a file of the same size.
+ *
+ *  @par Limits:
+ *       Must be between 64 and 32768.
+ */
+#define CF_DELTA_BLOCK_SIZE (1024)
+
+/**
+ *  @brief Largest number of blocks of a file that a delta is made against
+ *
+ *  @par Description:
+ *       The engine holds the signatures of the file last delivered and of
+ *       the file being sent, 16 bytes a block each, so this and
+ *       CF_DELTA_BLOCK_SIZE set the largest file that can be sent as a
+ *       delta. A larger file is sent whole.
+ *
+ *  @par Limits:
+ *       Must be between 1 and 65535.
+ */
+#define CF_DELTA_MAX_BLOCKS (2048)
+
+/**
+ *  @brief Largest number of files sent together in one bundle
+ *
+ *  @par Description:
+ *       On channels with bundle_file_size set, small files found by a
+ *       playback or polling directory are sent together in one transaction.
+ *       The engine holds the index of the bundle being built, about
+ *       CF_FILENAME_MAX_NAME bytes a file.
+ *
+ *  @par Limits:
+ *       Must be at least 2.
+ */
+#define CF_BUNDLE_MAX_FILES (64)
+
 /**
  * @brief Limits the number of retries to obtain the CF throttle sem
  *
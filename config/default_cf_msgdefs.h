@@ -27,6 +27,7 @@
 
 #include "common_types.h"
 #include "cf_extern_typedefs.h"
+#include "cfe_time_extern_typedefs.h"
 
 /**
  * \defgroup cfscftlm CFS CFDP Telemetry
@@ -107,20 +108,118 @@ typedef struct CF_HkChannel_Data
     uint8           poll_counter;            /**< \brief Number of active polling directories */
     uint8           playback_counter;        /**< \brief Number of active playback directories */
     uint8           frozen;                  /**< \brief Frozen state: 0 == not frozen, else frozen */
-    uint8           spare[7];                /**< \brief Alignment spare (uint64 values in the counters) */
+    uint8           spare;                   /**< \brief Alignment spare */
+    uint16          rx_pipe_high_water;      /**< \brief Most input messages drained in one wakeup */
+    uint16          rx_pipe_full;            /**< \brief Wakeups that drained a whole pipe depth of messages, so
+                                              *          the pipe was likely full; not a count of drops */
+    uint16          rx_budget;               /**< \brief Current rx messages per wakeup */
 } CF_HkChannel_Data_t;
 
+/**
+ * \brief Housekeeping per-peer flow control data
+ */
+typedef struct CF_HkPeer_Data
+{
+    CF_EntityId_t eid;       /**< \brief Destination entity id of this entry (0 if unused) */
+    uint32        window;    /**< \brief Current flow control window in file data bytes per wakeup */
+    uint32        rate;      /**< \brief Smoothed file data bytes sent to this peer per active wakeup */
+    uint32        in_flight; /**< \brief Class 2 file data bytes not yet acknowledged by this peer */
+    uint16        loss;      /**< \brief Smoothed NAK-reported loss estimate in parts per thousand */
+    uint16        spare;     /**< \brief Alignment spare */
+} CF_HkPeer_Data_t;
+
+/**
+ * \brief Housekeeping engine cycle timing data
+ */
+typedef struct CF_HkCycle_Data
+{
+    uint32 count;     /**< \brief Number of engine cycles measured */
+    uint32 min_usec;  /**< \brief Shortest engine cycle in microseconds */
+    uint32 mean_usec; /**< \brief Smoothed engine cycle duration in microseconds */
+    uint32 max_usec;  /**< \brief Longest engine cycle in microseconds */
+    uint32 overruns;  /**< \brief Engine cycles that ran longer than the configured cycle_max_usec */
+} CF_HkCycle_Data_t;
+
 /**
  * \brief Housekeeping packet
  */
 typedef struct CF_HkPacket_Payload
 {
     CF_HkCmdCounters_t counters; /**< \brief Command counters */
-    uint8              spare[4]; /**< \brief Alignment spare (CF_HkCmdCounters_t is 4 bytes) */
+    CF_HkCycle_Data_t  cycle;    /**< \brief Engine cycle timing (also keeps channel_hk 8-byte aligned) */
 
     CF_HkChannel_Data_t channel_hk[CF_NUM_CHANNELS]; /**< \brief Per channel housekeeping data */
+    CF_HkPeer_Data_t    peer_hk[CF_NUM_FLOW_PEERS];  /**< \brief Per peer flow control data */
 } CF_HkPacket_Payload_t;
 
+/**
+ * \brief Latency histograms in the diagnostics packet
+ */
+typedef enum
+{
+    CF_InstrHist_CYCLE    = 0,  /**< \brief Engine work on the channel in one wakeup */
+    CF_InstrHist_RX_FD    = 1,  /**< \brief Dispatch of a received file data PDU */
+    CF_InstrHist_RX_MD    = 2,  /**< \brief Dispatch of a received metadata PDU */
+    CF_InstrHist_RX_EOF   = 3,  /**< \brief Dispatch of a received EOF PDU */
+    CF_InstrHist_RX_FIN   = 4,  /**< \brief Dispatch of a received FIN PDU */
+    CF_InstrHist_RX_ACK   = 5,  /**< \brief Dispatch of a received ACK PDU */
+    CF_InstrHist_RX_NAK   = 6,  /**< \brief Dispatch of a received NAK PDU */
+    CF_InstrHist_RX_OTHER = 7,  /**< \brief Dispatch of any other received PDU */
+    CF_InstrHist_FREAD    = 8,  /**< \brief File read */
+    CF_InstrHist_FWRITE   = 9,  /**< \brief File write */
+    CF_InstrHist_FSEEK    = 10, /**< \brief File seek */
+    CF_InstrHist_DIRREAD  = 11, /**< \brief Directory read */
+    CF_InstrHist_SB_ALLOC = 12, /**< \brief SB message buffer allocation */
+    CF_InstrHist_NUM      = 13
+} CF_InstrHist_t;
+
+/**
+ * \brief Latency histogram
+ */
+typedef struct CF_DiagHist_Data
+{
+    uint32 bucket[CF_INSTR_NUM_BUCKETS]; /**< \brief Sample counts, see #CF_INSTR_NUM_BUCKETS for the ranges */
+    uint32 max_usec;                     /**< \brief Longest sample in microseconds */
+} CF_DiagHist_Data_t;
+
+/**
+ * \brief Diagnostics channel data
+ */
+typedef struct CF_DiagChannel_Data
+{
+    CF_DiagHist_Data_t hist[CF_InstrHist_NUM]; /**< \brief Latency histograms, indexed by #CF_InstrHist_t */
+} CF_DiagChannel_Data_t;
+
+/**
+ * \brief Diagnostics packet
+ */
+typedef struct CF_DiagPacket_Payload
+{
+    CF_DiagChannel_Data_t channel[CF_NUM_CHANNELS]; /**< \brief Per channel latency histograms */
+} CF_DiagPacket_Payload_t;
+
+/**
+ * \brief Per transaction performance record
+ *
+ * Accumulated over the life of a transaction and reported in the
+ * end of transaction packet.  Time totals are in microseconds.
+ */
+typedef struct CF_TxnPerf
+{
+    CFE_TIME_SysTime_t start_time;   /**< \brief Time the transaction was started */
+    CFE_TIME_SysTime_t end_time;     /**< \brief Time the transaction was finished */
+    uint32             file_bytes;   /**< \brief File data bytes sent or received, including retransmissions */
+    uint32             retx_bytes;   /**< \brief File data bytes retransmitted in response to NAKs (TX only) */
+    uint32             nak_rounds;   /**< \brief NAK PDUs sent (RX) or received (TX) */
+    uint32             nak_segments; /**< \brief Segments requested over all NAK rounds */
+    uint32             pdus_sent;    /**< \brief PDUs sent by this transaction */
+    uint32             pdus_recv;    /**< \brief PDUs received by this transaction */
+    uint32             wait_usec;    /**< \brief Time spent waiting for an output buffer or flow control */
+    uint32             io_usec;      /**< \brief Time spent in file seek, read and write calls */
+    uint32             crc_usec;     /**< \brief Time spent computing the file checksum */
+    uint32             zip_usec;     /**< \brief Time spent compressing, expanding, or delta coding file data */
+} CF_TxnPerf_t;
+
 /**
  * \brief End of transaction packet
  */
@@ -133,9 +232,14 @@ typedef struct CF_EotPacket_Payload
     uint32              txn_stat;   /**< \brief final status code of transaction (extended CFDP CC) */
     CF_EntityId_t       src_eid;    /**< \brief the source eid of the transaction */
     CF_EntityId_t       peer_eid;   /**< \brief peer_eid is always the "other guy", same src_eid for RX */
-    uint32              fsize;      /**< \brief File size */
+    uint32              fsize;      /**< \brief File size, as sent if the file data was compressed or a delta */
     uint32              crc_result; /**< \brief CRC result */
+    uint32              delivered;  /**< \brief 1 if the file had already been delivered, so nothing was sent */
+    uint32              raw_size;   /**< \brief File size before compression or delta, else the same as fsize */
+    uint32              zip_ratio;  /**< \brief raw_size over fsize in hundredths, so 100 if sent as is */
+    uint32              zip_per_mb; /**< \brief perf.zip_usec per MiB of raw_size */
     CF_TxnFilenames_t   fnames;     /**< \brief file names associated with this transaction */
+    CF_TxnPerf_t        perf;       /**< \brief performance record of this transaction */
 } CF_EotPacket_Payload_t;
 
 /**\}*/
@@ -164,7 +268,8 @@ typedef enum
     CF_Reset_command = 1, /**< \brief Reset command */
     CF_Reset_fault   = 2, /**< \brief Reset fault */
     CF_Reset_up      = 3, /**< \brief Reset up */
-    CF_Reset_down    = 4  /**< \brief Reset down */
+    CF_Reset_down    = 4, /**< \brief Reset down */
+    CF_Reset_diag    = 5  /**< \brief Reset diagnostics histograms */
 } CF_Reset_t;
 
 /**
@@ -206,6 +311,7 @@ typedef enum
     CF_GetSet_ValueID_nak_limit,                             /**< \brief NAK retry limit key */
     CF_GetSet_ValueID_local_eid,                             /**< \brief Local entity id key */
     CF_GetSet_ValueID_chan_max_outgoing_messages_per_wakeup, /**< \brief Max outgoing messages per wake-up key */
+    CF_GetSet_ValueID_cycle_max_usec,                        /**< \brief Max microseconds of engine work per wake-up key */
     CF_GetSet_ValueID_MAX                                    /**< \brief Key limit used for validity check */
 } CF_GetSet_ValueID_t;
 
@@ -237,6 +343,10 @@ typedef struct CF_SetParam_Payload
  * \brief Transmit file command structure
  *
  * For command details see #CF_TX_FILE_CC
+ *
+ * The fields after dst_filename made this 4 bytes longer than in earlier
+ * versions of CF. As the command length is checked exactly, ground command
+ * definitions of every command that uses this must match it.
  */
 typedef struct CF_TxFile_Payload
 {
@@ -247,8 +357,33 @@ typedef struct CF_TxFile_Payload
     CF_EntityId_t dest_id;                           /**< \brief Destination entity id */
     char          src_filename[CF_FILENAME_MAX_LEN]; /**< \brief Source file/directory name */
     char          dst_filename[CF_FILENAME_MAX_LEN]; /**< \brief Destination file/directory name */
+    uint8         max_ts;                            /**< \brief Directory playback only, most files sent at once:
+                                                      *          0=#CF_NUM_TRANSACTIONS_PER_PLAYBACK */
+    uint8         order;                             /**< \brief Directory playback only, order files are sent in,
+                                                      *          see #CF_PlaybackOrder_t */
+    uint8         compress;                          /**< \brief Not for follow sends, whether file data is
+                                                      *          compressed, see #CF_TxCompress_t */
+    uint8         spare[1];                          /**< \brief Alignment spare, uint32 multiple */
 } CF_TxFile_Payload_t;
 
+/**
+ * \brief Transmit file to multiple destinations command structure
+ *
+ * For command details see #CF_TX_FILE_MULTI_CC
+ */
+typedef struct CF_TxFileMulti_Payload
+{
+    uint8         cfdp_class;                        /**< \brief CFDP class: 0=class 1, 1=class 2 */
+    uint8         keep;                              /**< \brief Keep file flag: 1=keep, else delete */
+    uint8         chan_num;                          /**< \brief Channel number */
+    uint8         priority;                          /**< \brief Priority: 0=highest priority */
+    uint8         num_dest;                          /**< \brief Number of entries used in dest_id */
+    uint8         spare[3];                          /**< \brief Alignment spare, uint32 multiple */
+    CF_EntityId_t dest_id[CF_TX_MULTI_MAX_DEST];     /**< \brief Destination entity ids */
+    char          src_filename[CF_FILENAME_MAX_LEN]; /**< \brief Source file name */
+    char          dst_filename[CF_FILENAME_MAX_LEN]; /**< \brief Destination file name, same for all destinations */
+} CF_TxFileMulti_Payload_t;
+
 /**
  * \brief Write Queue command structure
  *
@@ -264,6 +399,16 @@ typedef struct CF_WriteQueue_Payload
     char filename[CF_FILENAME_MAX_LEN]; /**< \brief Filename written to */
 } CF_WriteQueue_Payload_t;
 
+/**
+ * \brief Write Trace command structure
+ *
+ * For command details see #CF_WRITE_TRACE_CC
+ */
+typedef struct CF_WriteTrace_Payload
+{
+    char filename[CF_FILENAME_MAX_LEN]; /**< \brief Filename written to */
+} CF_WriteTrace_Payload_t;
+
 /**
  * \brief Transaction command structure
  *
@@ -54,6 +54,9 @@
 /** \brief Message ID for end of transaction telemetry */
 #define CF_EOT_TLM_MID CFE_PLATFORM_TLM_TOPICID_TO_MIDV(CFE_MISSION_CF_EOT_TLM_TOPICID)
 
+/** \brief Message ID for diagnostics telemetry */
+#define CF_DIAG_TLM_MID CFE_PLATFORM_TLM_TOPICID_TO_MIDV(CFE_MISSION_CF_DIAG_TLM_TOPICID)
+
 /**\}*/
 
 /**
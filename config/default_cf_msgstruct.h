@@ -59,6 +59,15 @@ typedef struct CF_EotPacket
     CF_EotPacket_Payload_t    Payload;
 } CF_EotPacket_t;
 
+/**
+ * \brief Diagnostics packet
+ */
+typedef struct CF_DiagPacket
+{
+    CFE_MSG_TelemetryHeader_t TelemetryHeader; /**< \brief Telemetry header */
+    CF_DiagPacket_Payload_t   Payload;
+} CF_DiagPacket_t;
+
 /**\}*/
 
 /**
@@ -217,6 +226,28 @@ typedef struct CF_TxFileCmd
     CF_TxFile_Payload_t     Payload;
 } CF_TxFileCmd_t;
 
+/**
+ * \brief Transmit file to multiple destinations command structure
+ *
+ * For command details see #CF_TX_FILE_MULTI_CC
+ */
+typedef struct CF_TxFileMultiCmd
+{
+    CFE_MSG_CommandHeader_t  CommandHeader; /**< \brief Command header */
+    CF_TxFileMulti_Payload_t Payload;
+} CF_TxFileMultiCmd_t;
+
+/**
+ * \brief Transmit a file still being written command structure
+ *
+ * For command details see #CF_TX_FILE_FOLLOW_CC
+ */
+typedef struct CF_TxFileFollowCmd
+{
+    CFE_MSG_CommandHeader_t CommandHeader; /**< \brief Command header */
+    CF_TxFile_Payload_t     Payload;
+} CF_TxFileFollowCmd_t;
+
 /**
  * \brief Write Queue command structure
  *
@@ -228,6 +259,17 @@ typedef struct CF_WriteQueueCmd
     CF_WriteQueue_Payload_t Payload;
 } CF_WriteQueueCmd_t;
 
+/**
+ * \brief Write Trace command structure
+ *
+ * For command details see #CF_WRITE_TRACE_CC
+ */
+typedef struct CF_WriteTraceCmd
+{
+    CFE_MSG_CommandHeader_t CommandHeader; /**< \brief Command header */
+    CF_WriteTrace_Payload_t Payload;
+} CF_WriteTraceCmd_t;
+
 /**
  * \brief Playback directory command structure
  *
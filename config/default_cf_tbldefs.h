@@ -49,6 +49,8 @@ typedef struct CF_PollDir
     char dst_dir[CF_FILENAME_MAX_PATH]; /**< \brief path to destination dir */
 
     uint8 enabled; /**< \brief Enabled flag */
+    uint8 max_ts;  /**< \brief most files sent at once, 0 means CF_NUM_TRANSACTIONS_PER_PLAYBACK */
+    uint8 order;   /**< \brief order files are sent in, see #CF_PlaybackOrder_t */
 } CF_PollDir_t;
 
 /**
@@ -58,10 +60,19 @@ typedef struct CF_ChannelConfig
 {
     uint32 max_outgoing_messages_per_wakeup; /**< \brief max number of messages to send per wakeup (0 - unlimited) */
     uint32 rx_max_messages_per_wakeup;       /**< \brief max number of rx messages to process per wakeup */
+    uint32 rx_adaptive_max_per_wakeup;       /**< \brief if above rx_max_messages_per_wakeup, the rx budget
+                                              *          adapts to the input backlog up to this many messages */
+    uint32 rx_max_usec_per_wakeup;           /**< \brief max microseconds spent receiving per wakeup (0 - unlimited) */
 
     uint32 ack_timer_s;        /**< \brief Acknowledge timer in seconds */
     uint32 nak_timer_s;        /**< \brief Non-acknowledge timer in seconds */
     uint32 inactivity_timer_s; /**< \brief Inactivity timer in seconds */
+    uint32 prompt_nak_bytes;   /**< \brief S2 sends a Prompt (NAK) after this many file bytes (0 - never) */
+    uint32 prompt_nak_s;       /**< \brief S2 sends a Prompt (NAK) at this interval in seconds (0 - never) */
+    uint32 keep_alive_s;       /**< \brief R2 sends a Keep Alive at this interval in seconds (0 - never) */
+    uint32 bundle_file_size;   /**< \brief playback files up to this size are sent in bundles, for CF (0 - never) */
+    uint32 bundle_max_size;    /**< \brief most bytes of file data sent in one bundle */
+    uint32 tx_follow_quiet_s;  /**< \brief a followed file is done once its size is unchanged this many seconds */
 
     uint8 ack_limit; /**< number of times to retry ACK (for ex, send FIN and wait for fin-ack) */
     uint8 nak_limit; /**< number of times to retry NAK before giving up (resets on a single response */
@@ -75,7 +86,22 @@ typedef struct CF_ChannelConfig
 
     char  sem_name[OS_MAX_API_NAME]; /**< \brief name of throttling semaphore in TO */
     uint8 dequeue_enabled;           /**< \brief if 1, then the channel will make pending transactions active */
-    char  move_dir[OS_MAX_PATH_LEN]; /**< \brief Move directory if not empty */
+    uint8 rx_staging_enabled;        /**< \brief if 1, R2 file data received before metadata is staged in RAM */
+    uint8 rx_event_driven;           /**< \brief if 1, received PDUs are answered as they arrive, not only at wakeup;
+                                      *          CF then wakes every CF_EVENT_POLL_TIMEOUT even when idle */
+    uint8 rx_retain_partial;         /**< \brief if 1, a failed R2 keeps its partial file to resume from on a re-send */
+    uint8 tx_keep_alive_trim;        /**< \brief if 1, S2 drops pending retransmits below a Keep Alive's progress */
+    uint8 tx_skip_delivered;         /**< \brief if 1, files already delivered to the destination are not sent again */
+    uint8 tx_compress;               /**< \brief if 1, file data is sent compressed, for receivers that are CF */
+    uint8 tx_delta;                  /**< \brief if 1, S2 sends only changes from the last file delivered, for CF */
+    uint8 tx_prefetch_depth;         /**< \brief number of pending sends to open and read ahead (0 - none) */
+
+    uint16 dir_reads_per_wakeup;           /**< \brief most playback dir entries read per wakeup (0 - unlimited) */
+    uint16 udp_local_port;                 /**< \brief if nonzero, PDUs go over UDP bound to this port instead of SB */
+    uint16 udp_peer_port;                  /**< \brief UDP port of the peer entity */
+    char   udp_peer_addr[OS_MAX_API_NAME]; /**< \brief IPv4 address of the peer entity, e.g. "127.0.0.1" */
+
+    char move_dir[OS_MAX_PATH_LEN]; /**< \brief Move directory if not empty */
 } CF_ChannelConfig_t;
 
 
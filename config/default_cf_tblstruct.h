@@ -43,6 +43,8 @@ typedef struct CF_ConfigTable
     uint32 rx_crc_calc_bytes_per_wakeup; /**< \brief max number of bytes per wakeup to calculate
                                           * r2 CRC for recvd file (must be 1024-byte aligned)
                                           */
+    uint32 cycle_max_usec;               /**< \brief max microseconds of engine work per wakeup, remaining
+                                          * work resumes on the next wakeup (0 - unlimited) */
 
     CF_EntityId_t local_eid; /**< \brief the local entity ID of the CF app */
 
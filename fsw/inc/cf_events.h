@@ -246,6 +246,9 @@
  *  \par Cause:
  *
  *  Failure processing PDU header
+ *
+ *  Repeats within the same CF_EVENT_AGG_INTERVAL_S interval are counted, and
+ *  reported together in one event with the same ID at the end of the interval
  */
 #define CF_PDU_SHORT_HEADER_ERR_EID (41)
 
@@ -356,6 +359,9 @@
  *  \par Cause:
  *
  *  PDU Header received with the unsupported large file flag set
+ *
+ *  Repeats within the same CF_EVENT_AGG_INTERVAL_S interval are counted, and
+ *  reported together in one event with the same ID at the end of the interval
  */
 #define CF_PDU_LARGE_FILE_ERR_EID (55)
 
@@ -367,6 +373,9 @@
  *  \par Cause:
  *
  *  PDU Header received with fields that would be truncated with the cf configuration
+ *
+ *  Repeats within the same CF_EVENT_AGG_INTERVAL_S interval are counted, and
+ *  reported together in one event with the same ID at the end of the interval
  */
 #define CF_PDU_TRUNCATION_ERR_EID (56)
 
@@ -396,6 +405,9 @@
  *
  *  PDU without a matching/existing transaction received when channel receive queue is already
  *  handling the maximum number of concurrent receive transactions
+ *
+ *  Repeats within the same CF_EVENT_AGG_INTERVAL_S interval are counted, and
+ *  reported together in one event with the same ID at the end of the interval
  */
 #define CF_CFDP_RX_DROPPED_ERR_EID (60)
 
@@ -408,6 +420,9 @@
  *
  *  PDU without a matching/existing transaction received with an entity ID that doesn't
  *  match the receiving channel's entity ID
+ *
+ *  Repeats within the same CF_EVENT_AGG_INTERVAL_S interval are counted, and
+ *  reported together in one event with the same ID at the end of the interval
  */
 #define CF_CFDP_INVALID_DST_ERR_EID (61)
 
@@ -476,6 +491,9 @@
  *  \par Cause:
  *
  *  Failure from SB allocate message buffer call when constructing PDU
+ *
+ *  Repeats within the same CF_EVENT_AGG_INTERVAL_S interval are counted, and
+ *  reported together in one event with the same ID at the end of the interval
  */
 #define CF_CFDP_NO_MSG_ERR_EID (67)
 
@@ -1539,6 +1557,317 @@
  */
 #define CF_EID_INF_CFDP_BUF_EXCEED (166)
 
+/**
+ * \brief CF Channel UDP Socket Initialization Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Failure to open or bind the UDP socket of a channel configured for the
+ *  UDP transport during engine channel initialization
+ */
+#define CF_INIT_UDP_ERR_EID (167)
+
+/**
+ * \brief CF Write Trace Command Received Event ID
+ *
+ *  \par Type: INFORMATION
+ *
+ *  \par Cause:
+ *
+ *  Receipt of write trace command, the trace dump has been started
+ */
+#define CF_CMD_WRITE_TRACE_INF_EID (168)
+
+/**
+ * \brief CF Write Trace Command Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Write trace command received while a trace dump is already in progress,
+ *  or the trace dump file could not be created
+ */
+#define CF_CMD_WRITE_TRACE_ERR_EID (169)
+
+/**
+ * \brief CF Trace Dump Complete Event ID
+ *
+ *  \par Type: INFORMATION
+ *
+ *  \par Cause:
+ *
+ *  All trace entries that were in the ring when the write trace command was
+ *  received have been written, or skipped because they were overwritten
+ */
+#define CF_TRACE_DUMP_INF_EID (170)
+
+/**
+ * \brief CF Trace Dump Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Failure to write to the trace dump file, the dump has been stopped
+ */
+#define CF_TRACE_DUMP_ERR_EID (171)
+
+/**
+ * \brief CF Transaction Resumed From Checkpoint Event ID
+ *
+ *  \par Type: INFORMATION
+ *
+ *  \par Cause:
+ *
+ *  A class 2 transaction that was in progress before the restart has been
+ *  resumed from its checkpoint
+ */
+#define CF_CKPT_RESUME_INF_EID (172)
+
+/**
+ * \brief CF Checkpoint Not Resumed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  A checkpoint found at startup could not be read, is not valid, names a
+ *  source file that has changed size, or there was no free transaction for
+ *  it. The checkpoint is removed
+ */
+#define CF_CKPT_RESUME_ERR_EID (173)
+
+/**
+ * \brief CF Checkpoint Write Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Failure to write the checkpoint of a transaction. Any earlier checkpoint
+ *  of the transaction is left in place
+ */
+#define CF_CKPT_WRITE_ERR_EID (174)
+
+/**
+ * \brief CF Partial File Resumed Event ID
+ *
+ *  \par Type: INFORMATION
+ *
+ *  \par Cause:
+ *
+ *  A file is being received again from the same source with the same size
+ *  after an earlier attempt failed, and the partial file kept from that
+ *  attempt is used, so only the missing ranges are requested
+ */
+#define CF_CKPT_PARTIAL_INF_EID (175)
+
+/**
+ * \brief CF Prompt PDU Too Short Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Failure processing prompt PDU
+ */
+#define CF_PDU_PROMPT_SHORT_ERR_EID (176)
+
+/**
+ * \brief CF Keep Alive PDU Too Short Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Failure processing keep alive PDU
+ */
+#define CF_PDU_KEEP_ALIVE_SHORT_ERR_EID (177)
+
+/**
+ * \brief CF TX Received Keep Alive PDU Invalid Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Failure processing received keep alive PDU relating to a current
+ *  transaction, or its progress is beyond the end of the file
+ */
+#define CF_CFDP_S_PDU_KEEP_ALIVE_ERR_EID (178)
+
+/**
+ * \brief CF Transmit File Multi Command Received Event ID
+ *
+ *  \par Type: INFORMATION
+ *
+ *  \par Cause:
+ *
+ *  Receipt and successful processing of transmit file multi command
+ */
+#define CF_CMD_TX_FILE_MULTI_INF_EID (179)
+
+/**
+ * \brief CF Transmit File Multi Command Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Transmit file multi command was unsuccessful
+ */
+#define CF_CMD_TX_FILE_MULTI_ERR_EID (180)
+
+/**
+ * \brief CF Multi-Destination Send Open Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  No fan-out group was free for a multi-destination send, or its source
+ *  file is already open or could not be opened
+ */
+#define CF_CFDP_FANOUT_ERR_EID (181)
+
+/**
+ * \brief CF TX File Already Delivered Event ID
+ *
+ *  \par Type: INFORMATION
+ *
+ *  \par Cause:
+ *
+ *  A file to be sent matches one already delivered to the same destination
+ *  entity and file name, with the same size and checksum, so the transaction
+ *  was completed without sending anything
+ */
+#define CF_CFDP_S_DELIVERED_INF_EID (182)
+
+/**
+ * \brief CF Delivered File Index Write Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Failure to write the index of delivered files. The entry is still used
+ *  until the next restart
+ */
+#define CF_DELIVERED_WRITE_ERR_EID (183)
+
+/**
+ * \brief CF TX Compressed File Data Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Failure to create or write the compressed copy of a file to be sent on a
+ *  channel with tx_compress set
+ */
+#define CF_CFDP_S_COMPRESS_ERR_EID (184)
+
+/**
+ * \brief CF RX Compressed File Data Expand Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  File data received compressed could not be expanded, either because the
+ *  compressed data is malformed or because the expanded file could not be
+ *  created or written
+ */
+#define CF_CFDP_R_EXPAND_ERR_EID (185)
+
+/**
+ * \brief CF TX Delta Encode Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Failure to create or write the delta of a file to be sent on a channel
+ *  with tx_delta set, or its block signatures
+ */
+#define CF_CFDP_S_DELTA_ERR_EID (186)
+
+/**
+ * \brief CF RX Delta Apply Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  File data received as a delta could not be applied to the destination
+ *  file already on board, either because that file is missing or is not the
+ *  one the delta was made against, or because the delta is malformed, or
+ *  because the new file could not be created or written
+ */
+#define CF_CFDP_R_DELTA_ERR_EID (187)
+
+/**
+ * \brief CF Bundle Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Failure to build a bundle of small files from a playback directory on a
+ *  channel with bundle_file_size set, or to dispose of its files once sent
+ */
+#define CF_CFDP_BUNDLE_ERR_EID (188)
+
+/**
+ * \brief CF RX Bundle Unpack Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  A bundle of files received could not be unpacked, either because its
+ *  index is malformed or because one of its files could not be created or
+ *  written
+ */
+#define CF_CFDP_R_BUNDLE_ERR_EID (189)
+
+/**
+ * \brief CF Transmit File Follow Command Received Event ID
+ *
+ *  \par Type: INFORMATION
+ *
+ *  \par Cause:
+ *
+ *  Receipt and successful processing of transmit file follow command
+ */
+#define CF_CMD_TX_FILE_FOLLOW_INF_EID (190)
+
+/**
+ * \brief CF Transmit File Follow Command Failed Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  Transmit file follow command was unsuccessful
+ */
+#define CF_CMD_TX_FILE_FOLLOW_ERR_EID (191)
+
+/**
+ * \brief CF Followed File Shrank Event ID
+ *
+ *  \par Type: ERROR
+ *
+ *  \par Cause:
+ *
+ *  A file sent with the transmit file follow command got smaller while it
+ *  was being sent, so what was already sent no longer matches it
+ */
+#define CF_CFDP_S_FOLLOW_ERR_EID (192)
+
 /**\}*/
 
 #endif /* !CF_EVENTS_H */
@@ -31,6 +31,7 @@
 #include "cf_events.h"
 #include "cf_perfids.h"
 #include "cf_cfdp.h"
+#include "cf_instr.h"
 #include "cf_version.h"
 #include "cf_dispatch.h"
 #include "cf_tbl.h"
@@ -198,6 +199,7 @@ CFE_Status_t CF_AppInit(void)
     CF_AppData.RunStatus = CFE_ES_RunStatus_APP_RUN;
 
     CFE_MSG_Init(CFE_MSG_PTR(CF_AppData.hk.TelemetryHeader), CFE_SB_ValueToMsgId(CF_HK_TLM_MID), sizeof(CF_AppData.hk));
+    CF_Instr_Init();
 
     status = CFE_EVS_Register(NULL, 0, CFE_EVS_EventFilter_BINARY);
     if (status != CFE_SUCCESS)
@@ -256,7 +258,8 @@ CFE_Status_t CF_AppInit(void)
 void CF_AppMain(void)
 {
     int32            status;
-    CFE_SB_Buffer_t *BufPtr = NULL;
+    CFE_SB_Buffer_t *BufPtr  = NULL;
+    int32            timeout = CF_RCVMSG_TIMEOUT;
 
     CFE_ES_PerfLogEntry(CF_PERF_ID_APPMAIN);
 
@@ -270,7 +273,7 @@ void CF_AppMain(void)
     {
         CFE_ES_PerfLogExit(CF_PERF_ID_APPMAIN);
 
-        status = CFE_SB_ReceiveBuffer(&BufPtr, CF_AppData.CmdPipe, CF_RCVMSG_TIMEOUT);
+        status = CFE_SB_ReceiveBuffer(&BufPtr, CF_AppData.CmdPipe, timeout);
         CFE_ES_PerfLogEntry(CF_PERF_ID_APPMAIN);
 
         if (status == CFE_SUCCESS)
@@ -287,6 +290,17 @@ void CF_AppMain(void)
         {
             /* nothing */
         }
+
+        /* answer PDUs received since the last wakeup on event-driven channels; while any channel is
+         * event-driven the pipe is polled every CF_EVENT_POLL_TIMEOUT, even when nothing arrives */
+        if (CF_CFDP_ServiceInput())
+        {
+            timeout = CF_EVENT_POLL_TIMEOUT;
+        }
+        else
+        {
+            timeout = CF_RCVMSG_TIMEOUT;
+        }
     }
 
     CFE_ES_PerfLogExit(CF_PERF_ID_APPMAIN);
@@ -36,6 +36,11 @@
 #include "cf_platform_cfg.h"
 #include "cf_cfdp.h"
 #include "cf_clist.h"
+#include "cf_memstore.h"
+#include "cf_trace.h"
+#include "cf_evagg.h"
+#include "cf_ckpt.h"
+#include "cf_delivered.h"
 
 /**************************************************************************
  **
@@ -84,7 +89,8 @@
  */
 typedef struct
 {
-    CF_HkPacket_t hk;
+    CF_HkPacket_t   hk;
+    CF_DiagPacket_t diag; /**< \brief diagnostics packet, also holds the latency histograms */
 
     uint32 RunStatus;
 
@@ -94,6 +100,12 @@ typedef struct
     CF_ConfigTable_t *config_table;
 
     CF_Engine_t engine;
+
+    CF_Memstore_t  memstore;  /**< \brief RAM filestore, kept across engine restarts */
+    CF_Trace_t     trace;     /**< \brief binary trace ring, kept across engine restarts */
+    CF_EvAgg_t     evagg;     /**< \brief hot path event aggregation */
+    CF_Ckpt_t      ckpt;      /**< \brief transaction checkpoint schedule */
+    CF_Delivered_t delivered; /**< \brief index of files already delivered by class 2 sends */
 } CF_AppData_t;
 
 /**************************************************************************
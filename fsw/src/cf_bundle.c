@@ -0,0 +1,334 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ *  The CF Application small file bundle source file
+ *
+ *  A bundle is the data of each file one after another, then an index
+ *  giving the name, offset and size of each, then a trailer giving where
+ *  the index starts. The index goes last so that a bundle is written in
+ *  one pass as the files are found, and the trailer is at a known place
+ *  once the whole bundle has arrived.
+ */
+
+#include "cfe.h"
+#include "cf_verify.h"
+#include "cf_bundle.h"
+#include "cf_app.h"
+#include "cf_utils.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static uint8 *CF_Bundle_Put32(uint8 *op, uint32 val)
+{
+    *op++ = (val >> 24) & 0xff;
+    *op++ = (val >> 16) & 0xff;
+    *op++ = (val >> 8) & 0xff;
+    *op++ = val & 0xff;
+
+    return op;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static uint32 CF_Bundle_Get32(const uint8 *ip)
+{
+    return ((uint32)ip[0] << 24) | ((uint32)ip[1] << 16) | ((uint32)ip[2] << 8) | ip[3];
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_bundle.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_Bundle_Start(CF_Bundle_t *bundle, struct CF_Playback *owner)
+{
+    char         fname[OS_MAX_PATH_LEN];
+    CFE_Status_t ret = CF_ERROR;
+
+    CF_Bundle_GetBuildFilename(fname, sizeof(fname));
+
+    if (CF_WrappedOpenCreate(&bundle->fd, fname, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY) >= 0)
+    {
+        bundle->owner = owner;
+        bundle->size  = 0;
+        bundle->count = 0;
+        ret           = CFE_SUCCESS;
+    }
+    else
+    {
+        bundle->fd = OS_OBJECT_ID_UNDEFINED; /* just in case */
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_bundle.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_Bundle_AddFile(CF_Bundle_t *bundle, const char *src_filename, const char *name, uint32 size)
+{
+    CF_BundleEntry_t *entry = &bundle->entries[bundle->count];
+    osal_id_t         fd;
+    uint32            done = 0;
+    int32             len;
+    int32             pos;
+    CFE_Status_t      ret = CF_ERROR;
+
+    if (CF_WrappedOpenCreate(&fd, src_filename, OS_FILE_FLAG_NONE, OS_READ_ONLY) >= 0)
+    {
+        while (done < size)
+        {
+            len = size - done;
+            if (len > (int32)sizeof(bundle->buf))
+            {
+                len = sizeof(bundle->buf);
+            }
+
+            if (CF_WrappedRead(fd, bundle->buf, len) != len || CF_WrappedWrite(bundle->fd, bundle->buf, len) != len)
+            {
+                break;
+            }
+
+            done += len;
+        }
+
+        CF_WrappedClose(fd);
+
+        if (done == size)
+        {
+            entry->offset = bundle->size;
+            entry->size   = size;
+            strncpy(entry->name, name, sizeof(entry->name) - 1);
+            entry->name[sizeof(entry->name) - 1] = 0;
+
+            bundle->size += size;
+            ++bundle->count;
+            ret = CFE_SUCCESS;
+        }
+        else
+        {
+            /* there is no truncating a file, so whatever got written is left out of the index */
+            pos = CF_WrappedLseek(bundle->fd, 0, OS_SEEK_CUR);
+            if (pos < 0)
+            {
+                CF_WrappedClose(bundle->fd);
+                bundle->fd = OS_OBJECT_ID_UNDEFINED;
+            }
+            else
+            {
+                bundle->size = pos;
+            }
+        }
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_bundle.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_Bundle_Finish(CF_Bundle_t *bundle)
+{
+    uint32       len = 0;
+    uint32       i;
+    CFE_Status_t ret = CFE_SUCCESS;
+
+    /* entries are written a buffer at a time, and the trailer goes out with the last of them */
+    for (i = 0; i <= bundle->count && ret == CFE_SUCCESS; ++i)
+    {
+        if ((len + CF_BUNDLE_ENTRY_HDR_SIZE + CF_FILENAME_MAX_NAME) > sizeof(bundle->buf))
+        {
+            if (CF_WrappedWrite(bundle->fd, bundle->buf, len) != (CFE_Status_t)len)
+            {
+                ret = CF_ERROR;
+            }
+            len = 0;
+        }
+
+        if (i < bundle->count)
+        {
+            len += CF_Bundle_PutEntry(&bundle->buf[len], &bundle->entries[i]);
+        }
+    }
+
+    if (ret == CFE_SUCCESS)
+    {
+        CF_Bundle_PutTrailer(&bundle->buf[len], bundle->count, bundle->size);
+        len += CF_BUNDLE_TRAILER_SIZE;
+        if (CF_WrappedWrite(bundle->fd, bundle->buf, len) != (CFE_Status_t)len)
+        {
+            ret = CF_ERROR;
+        }
+    }
+
+    CF_WrappedClose(bundle->fd);
+    bundle->fd = OS_OBJECT_ID_UNDEFINED;
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_bundle.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Bundle_Release(CF_Bundle_t *bundle)
+{
+    char fname[OS_MAX_PATH_LEN];
+
+    if (OS_ObjectIdDefined(bundle->fd))
+    {
+        CF_WrappedClose(bundle->fd);
+        bundle->fd = OS_OBJECT_ID_UNDEFINED;
+
+        CF_Bundle_GetBuildFilename(fname, sizeof(fname));
+        CF_WrappedRemove(fname);
+    }
+
+    bundle->owner = NULL;
+    bundle->size  = 0;
+    bundle->count = 0;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_bundle.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+uint32 CF_Bundle_PutEntry(uint8 *out, const CF_BundleEntry_t *entry)
+{
+    uint32 name_len = OS_strnlen(entry->name, sizeof(entry->name));
+
+    out    = CF_Bundle_Put32(out, entry->offset);
+    out    = CF_Bundle_Put32(out, entry->size);
+    *out++ = name_len;
+    memcpy(out, entry->name, name_len);
+
+    return CF_BUNDLE_ENTRY_HDR_SIZE + name_len;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_bundle.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+uint32 CF_Bundle_ParseEntry(const uint8 *in, uint32 in_len, CF_BundleEntry_t *entry)
+{
+    uint32 name_len;
+    uint32 ret = 0;
+
+    memset(entry, 0, sizeof(*entry));
+
+    if (in_len >= CF_BUNDLE_ENTRY_HDR_SIZE)
+    {
+        name_len      = in[8];
+        entry->offset = CF_Bundle_Get32(&in[0]);
+        entry->size   = CF_Bundle_Get32(&in[4]);
+
+        if (name_len != 0 && name_len < sizeof(entry->name) && in_len >= (CF_BUNDLE_ENTRY_HDR_SIZE + name_len))
+        {
+            memcpy(entry->name, &in[CF_BUNDLE_ENTRY_HDR_SIZE], name_len);
+
+            /* a name with a NUL or a slash in it, or a name for a directory, could land outside the directory */
+            if (OS_strnlen(entry->name, name_len) == name_len && strchr(entry->name, '/') == NULL &&
+                strcmp(entry->name, ".") != 0 && strcmp(entry->name, "..") != 0)
+            {
+                ret = CF_BUNDLE_ENTRY_HDR_SIZE + name_len;
+            }
+        }
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_bundle.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Bundle_PutTrailer(uint8 *out, uint32 count, uint32 index_offset)
+{
+    out = CF_Bundle_Put32(out, CF_BUNDLE_MAGIC);
+    out = CF_Bundle_Put32(out, count);
+    CF_Bundle_Put32(out, index_offset);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_bundle.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_Bundle_ParseTrailer(const uint8 *in, uint32 fsize, uint32 *count, uint32 *index_offset)
+{
+    *count        = CF_Bundle_Get32(&in[4]);
+    *index_offset = CF_Bundle_Get32(&in[8]);
+
+    /* each entry takes at least its header and one byte of name */
+    return (CF_Bundle_Get32(&in[0]) == CF_BUNDLE_MAGIC && fsize >= CF_BUNDLE_TRAILER_SIZE &&
+            *index_offset <= (fsize - CF_BUNDLE_TRAILER_SIZE) &&
+            *count <= ((fsize - CF_BUNDLE_TRAILER_SIZE - *index_offset) / (CF_BUNDLE_ENTRY_HDR_SIZE + 1)));
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_bundle.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Bundle_GetBuildFilename(char *buf, size_t buf_size)
+{
+    snprintf(buf, buf_size, "%.*s/bundle%s", CF_FILENAME_MAX_PATH - 1, CF_AppData.config_table->tmp_dir,
+             CF_BUNDLE_EXT);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_bundle.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Bundle_GetFilename(char *buf, size_t buf_size, CF_EntityId_t src_eid, CF_TransactionSeq_t seq_num)
+{
+    snprintf(buf, buf_size, "%.*s/%lu:%lu%s", CF_FILENAME_MAX_PATH - 1, CF_AppData.config_table->tmp_dir,
+             (unsigned long)src_eid, (unsigned long)seq_num, CF_BUNDLE_EXT);
+}
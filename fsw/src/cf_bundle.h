@@ -0,0 +1,254 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ *  The CF Application small file bundle header file
+ */
+
+#ifndef CF_BUNDLE_H
+#define CF_BUNDLE_H
+
+#include "cfe.h"
+#include "cf_platform_cfg.h"
+#include "cf_extern_typedefs.h"
+
+/**
+ * @brief Contents of the metadata Message To User TLV that marks a bundle of files
+ */
+#define CF_BUNDLE_TLV_MSG "CFB1"
+
+/**
+ * @brief Magic number at the start of the trailer of a bundle, "CFB1"
+ */
+#define CF_BUNDLE_MAGIC (0x43464231)
+
+/**
+ * @brief Size of the trailer at the end of a bundle
+ *
+ * The trailer is the magic number, the number of files, and the offset of
+ * the index, all 32 bit big endian.
+ */
+#define CF_BUNDLE_TRAILER_SIZE (12)
+
+/**
+ * @brief Size of an index entry, not counting its name
+ *
+ * An entry is the offset and size of the file's data, both 32 bit big
+ * endian, then the length of the name, 8 bits, then the name.
+ */
+#define CF_BUNDLE_ENTRY_HDR_SIZE (9)
+
+/**
+ * @brief Size of the buffer files are copied through
+ */
+#define CF_BUNDLE_BUF_SIZE (1024)
+
+/**
+ * @brief Extension of a bundle file
+ */
+#define CF_BUNDLE_EXT ".cfb"
+
+struct CF_Playback;
+
+/**
+ * @brief Index entry of one file in a bundle
+ */
+typedef struct CF_BundleEntry
+{
+    uint32 offset;                     /**< \brief offset of the file's data in the bundle */
+    uint32 size;                       /**< \brief size of the file */
+    char   name[CF_FILENAME_MAX_NAME]; /**< \brief name of the file, without its directory */
+} CF_BundleEntry_t;
+
+/**
+ * @brief Work area of a bundle being built
+ *
+ * A bundle is built from one playback directory at a time, and the index is
+ * kept here until the bundle is finished.
+ */
+typedef struct CF_Bundle
+{
+    struct CF_Playback *owner; /**< \brief the playback whose bundle is being built, NULL if free */
+
+    osal_id_t        fd;                           /**< \brief bundle file being built */
+    uint32           size;                         /**< \brief bytes of file data in the bundle */
+    uint32           count;                        /**< \brief number of files in the bundle */
+    CF_BundleEntry_t entries[CF_BUNDLE_MAX_FILES]; /**< \brief index of the files in the bundle */
+    uint8            buf[CF_BUNDLE_BUF_SIZE];      /**< \brief also used by senders and receivers to read one */
+} CF_Bundle_t;
+
+/************************************************************************/
+/** @brief Start building a bundle.
+ *
+ * @par Description
+ *       Creates the bundle file, and marks the work area as held by the
+ *       given playback.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       bundle must not be NULL, and must not be held.
+ *
+ * @param bundle  Bundle work area
+ * @param owner   Playback the bundle is for
+ *
+ * @retval #CFE_SUCCESS \copydoc CFE_SUCCESS
+ * @retval #CF_ERROR if the bundle file could not be created
+ */
+CFE_Status_t CF_Bundle_Start(CF_Bundle_t *bundle, struct CF_Playback *owner);
+
+/************************************************************************/
+/** @brief Copy a file into the bundle being built.
+ *
+ * @par Description
+ *       Appends the file's data to the bundle, and adds it to the index.
+ *       If the file cannot be read, the bundle is put back as it was. If
+ *       that fails too, the bundle file is closed and the bundle cannot be
+ *       used.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       bundle, src_filename, and name must not be NULL. The bundle must
+ *       have room for another file, and name must be shorter than
+ *       CF_FILENAME_MAX_NAME.
+ *
+ * @param bundle        Bundle work area
+ * @param src_filename  Path of the file
+ * @param name          Name of the file in the index
+ * @param size          Size of the file
+ *
+ * @retval #CFE_SUCCESS \copydoc CFE_SUCCESS
+ * @retval #CF_ERROR if the file was not added
+ */
+CFE_Status_t CF_Bundle_AddFile(CF_Bundle_t *bundle, const char *src_filename, const char *name, uint32 size);
+
+/************************************************************************/
+/** @brief Finish the bundle being built.
+ *
+ * @par Description
+ *       Writes the index and the trailer, and closes the bundle file. The
+ *       work area is still held, so the caller can move the file into
+ *       place before letting it go.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       bundle must not be NULL.
+ *
+ * @param bundle  Bundle work area
+ *
+ * @retval #CFE_SUCCESS \copydoc CFE_SUCCESS
+ * @retval #CF_ERROR if the index could not be written
+ */
+CFE_Status_t CF_Bundle_Finish(CF_Bundle_t *bundle);
+
+/************************************************************************/
+/** @brief Let go of the bundle work area.
+ *
+ * @par Description
+ *       A bundle still being built is closed and its file removed.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       bundle must not be NULL.
+ *
+ * @param bundle  Bundle work area
+ */
+void CF_Bundle_Release(CF_Bundle_t *bundle);
+
+/************************************************************************/
+/** @brief Encode an index entry.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       out and entry must not be NULL. out must have room for
+ *       CF_BUNDLE_ENTRY_HDR_SIZE bytes plus the name.
+ *
+ * @param out    Buffer for the entry
+ * @param entry  Entry values
+ *
+ * @returns Size of the entry
+ */
+uint32 CF_Bundle_PutEntry(uint8 *out, const CF_BundleEntry_t *entry);
+
+/************************************************************************/
+/** @brief Decode an index entry.
+ *
+ * @par Description
+ *       Only a plain file name is accepted, so a bundle cannot place a
+ *       file outside the directory it is unpacked into.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       in and entry must not be NULL.
+ *
+ * @param in      Entry bytes
+ * @param in_len  Number of bytes available at in
+ * @param entry   Output entry values
+ *
+ * @returns Size of the entry, 0 if it is malformed or cut short
+ */
+uint32 CF_Bundle_ParseEntry(const uint8 *in, uint32 in_len, CF_BundleEntry_t *entry);
+
+/************************************************************************/
+/** @brief Encode the trailer of a bundle.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       out must not be NULL, and must have room for CF_BUNDLE_TRAILER_SIZE bytes.
+ *
+ * @param out           Buffer for the trailer
+ * @param count         Number of files in the bundle
+ * @param index_offset  Offset of the index
+ */
+void CF_Bundle_PutTrailer(uint8 *out, uint32 count, uint32 index_offset);
+
+/************************************************************************/
+/** @brief Decode the trailer of a bundle.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       in, count, and index_offset must not be NULL.
+ *
+ * @param in            CF_BUNDLE_TRAILER_SIZE bytes of trailer
+ * @param fsize         Size of the bundle
+ * @param count         Output number of files in the bundle
+ * @param index_offset  Output offset of the index
+ *
+ * @returns true if the trailer describes a bundle of that size
+ */
+bool CF_Bundle_ParseTrailer(const uint8 *in, uint32 fsize, uint32 *count, uint32 *index_offset);
+
+/************************************************************************/
+/** @brief Get the name of the file a bundle is built in.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       buf must not be NULL.
+ *
+ * @param buf       Buffer for the file name
+ * @param buf_size  Size of buf
+ */
+void CF_Bundle_GetBuildFilename(char *buf, size_t buf_size);
+
+/************************************************************************/
+/** @brief Get the name of the temp file a bundle is sent from.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       buf must not be NULL.
+ *
+ * @param buf       Buffer for the file name
+ * @param buf_size  Size of buf
+ * @param src_eid   Source entity ID of the transaction
+ * @param seq_num   Sequence number of the transaction
+ */
+void CF_Bundle_GetFilename(char *buf, size_t buf_size, CF_EntityId_t src_eid, CF_TransactionSeq_t seq_num);
+
+#endif /* !CF_BUNDLE_H */
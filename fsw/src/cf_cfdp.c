@@ -37,11 +37,16 @@
 #include "cf_perfids.h"
 #include "cf_cfdp.h"
 #include "cf_utils.h"
+#include "cf_instr.h"
+#include "cf_trace.h"
+#include "cf_evagg.h"
+#include "cf_ckpt.h"
 
 #include "cf_cfdp_r.h"
 #include "cf_cfdp_s.h"
 #include "cf_cfdp_dispatch.h"
 #include "cf_cfdp_sbintf.h"
+#include "cf_udpintf.h"
 
 #include <string.h>
 #include "cf_assert.h"
@@ -174,8 +179,17 @@ void CF_CFDP_DispatchRecv(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
                                                                     [CF_TxnState_R2]   = CF_CFDP_R2_Recv,
                                                                     [CF_TxnState_S2]   = CF_CFDP_S2_Recv,
                                                                     [CF_TxnState_DROP] = CF_CFDP_RecvDrop}};
+    CF_TraceStateStamp_t saved;
 
+    /* file data is traced once its header is decoded, in CF_CFDP_RecvFd() */
+    if (!ph->pdu_header.pdu_type)
+    {
+        CF_TRACE_PDU(CF_TraceEvent_PDU_RX, txn->chan_num, ph);
+    }
+
+    CF_TRACE_STATE_SAVE(saved, txn);
     CF_CFDP_RxStateDispatch(txn, ph, &state_fns);
+    CF_TRACE_STATE_CHECK(saved, txn);
     CF_CFDP_ArmInactTimer(txn); /* whenever a packet was received by the other size, always arm its inactivity timer */
 }
 
@@ -188,16 +202,20 @@ static void CF_CFDP_DispatchTx(CF_Transaction_t *txn)
 {
     static const CF_CFDP_TxnSendDispatchTable_t state_fns = {
         .tx = {[CF_TxnState_S1] = CF_CFDP_S1_Tx, [CF_TxnState_S2] = CF_CFDP_S2_Tx}};
+    CF_TraceStateStamp_t saved;
 
+    CF_TRACE_STATE_SAVE(saved, txn);
     CF_CFDP_TxStateDispatch(txn, &state_fns);
+    CF_TRACE_STATE_CHECK(saved, txn);
 }
 
 /*----------------------------------------------------------------
  *
- * Internal helper routine only, not part of API.
+ * Application-scope internal function
+ * See description in cf_cfdp.h for argument/return detail
  *
  *-----------------------------------------------------------------*/
-static CF_ChunkWrapper_t *CF_CFDP_FindUnusedChunks(CF_Channel_t *chan, CF_Direction_t dir)
+CF_ChunkWrapper_t *CF_CFDP_FindUnusedChunks(CF_Channel_t *chan, CF_Direction_t dir)
 {
     CF_ChunkWrapper_t *ret;
 
@@ -229,6 +247,42 @@ static void CF_CFDP_SetPduLength(CF_Logical_PduBuffer_t *ph)
     CF_CFDP_EncodeHeaderFinalSize(ph->penc, &ph->pdu_header);
 }
 
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_PerfWait(CF_History_t *history, bool waiting)
+{
+    if (waiting && !history->waiting)
+    {
+        OS_GetLocalTime(&history->wait_start);
+        history->waiting = true;
+    }
+    else if (!waiting && history->waiting)
+    {
+        CF_AddElapsedUsec(&history->perf.wait_usec, history->wait_start);
+        history->waiting = false;
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_CFDP_SendTxnPdu(const CF_Transaction_t *txn, const CF_Logical_PduBuffer_t *ph)
+{
+    CF_TRACE_PDU(CF_TraceEvent_PDU_TX, txn->chan_num, ph);
+    CF_CFDP_Send(txn->chan_num, ph);
+
+    if (txn->history != NULL)
+    {
+        ++txn->history->perf.pdus_sent;
+    }
+}
+
 /*----------------------------------------------------------------
  *
  * Application-scope internal function
@@ -246,7 +300,17 @@ CF_Logical_PduBuffer_t *CF_CFDP_ConstructPduHeader(const CF_Transaction_t *txn,
 
     ph = CF_CFDP_MsgOutGet(txn, silent);
 
-    if (ph)
+    /* the temporary transaction used to answer a spurious FIN has no history */
+    if (txn->history != NULL)
+    {
+        CF_CFDP_PerfWait(txn->history, (ph == NULL));
+    }
+
+    if (!ph)
+    {
+        CF_TRACE(CF_TraceEvent_STALL, txn->chan_num, (uint32)tsn, CF_TraceStall_NO_BUF, 0, 0, 0);
+    }
+    else
     {
         hdr = &ph->pdu_header;
 
@@ -323,7 +387,9 @@ CFE_Status_t CF_CFDP_SendMd(CF_Transaction_t *txn)
 
         CF_Assert((txn->state == CF_TxnState_S1) || (txn->state == CF_TxnState_S2));
 
-        md->size = txn->fsize;
+        /* a file still being written, or still being compressed, has no size yet,
+         * and a size of 0 tells the receiver the EOF has it */
+        md->size = (txn->flags.tx.follow || txn->flags.tx.compressing) ? 0 : txn->fsize;
 
         /* at this point, need to append filenames into md packet */
         /* this does not actually copy here - that is done during encode */
@@ -334,9 +400,26 @@ CFE_Status_t CF_CFDP_SendMd(CF_Transaction_t *txn)
             OS_strnlen(txn->history->fnames.dst_filename, sizeof(txn->history->fnames.dst_filename));
         md->dest_filename.data_ptr = txn->history->fnames.dst_filename;
 
+        if (txn->flags.com.compressed)
+        {
+            CF_CFDP_AppendTlv(&md->tlv_list, CF_CFDP_TLV_TYPE_MESSAGE_TO_USER);
+        }
+        else if (txn->flags.com.delta && md->tlv_list.num_tlv < CF_PDU_MAX_TLV)
+        {
+            CF_CFDP_AppendTlv(&md->tlv_list, CF_CFDP_TLV_TYPE_MESSAGE_TO_USER);
+            md->tlv_list.tlv[md->tlv_list.num_tlv - 1].data.data_ptr = CF_DELTA_TLV_MSG;
+            md->tlv_list.tlv[md->tlv_list.num_tlv - 1].length        = sizeof(CF_DELTA_TLV_MSG) - 1;
+        }
+        else if (txn->flags.com.bundle && md->tlv_list.num_tlv < CF_PDU_MAX_TLV)
+        {
+            CF_CFDP_AppendTlv(&md->tlv_list, CF_CFDP_TLV_TYPE_MESSAGE_TO_USER);
+            md->tlv_list.tlv[md->tlv_list.num_tlv - 1].data.data_ptr = CF_BUNDLE_TLV_MSG;
+            md->tlv_list.tlv[md->tlv_list.num_tlv - 1].length        = sizeof(CF_BUNDLE_TLV_MSG) - 1;
+        }
+
         CF_CFDP_EncodeMd(ph->penc, md);
         CF_CFDP_SetPduLength(ph);
-        CF_CFDP_Send(txn->chan_num, ph);
+        CF_CFDP_SendTxnPdu(txn, ph);
     }
 
     return sret;
@@ -357,7 +440,7 @@ CFE_Status_t CF_CFDP_SendFd(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
 
     /* update PDU length */
     CF_CFDP_SetPduLength(ph);
-    CF_CFDP_Send(txn->chan_num, ph);
+    CF_CFDP_SendTxnPdu(txn, ph);
 
     return ret;
 }
@@ -391,6 +474,12 @@ void CF_CFDP_AppendTlv(CF_Logical_TlvList_t *ptlv_list, CF_CFDP_TlvType_t tlv_ty
             ptlv->data.eid = CF_AppData.config_table->local_eid;
             ptlv->length   = CF_CFDP_GetValueEncodedSize(ptlv->data.eid);
         }
+        else if (tlv_type == CF_CFDP_TLV_TYPE_MESSAGE_TO_USER)
+        {
+            /* compressed file data is marked by default, SendMd changes it for a delta */
+            ptlv->data.data_ptr = CF_COMPRESS_TLV_MSG;
+            ptlv->length        = sizeof(CF_COMPRESS_TLV_MSG) - 1;
+        }
         else
         {
             ptlv->data.data_ptr = NULL;
@@ -432,7 +521,7 @@ CFE_Status_t CF_CFDP_SendEof(CF_Transaction_t *txn)
 
         CF_CFDP_EncodeEof(ph->penc, eof);
         CF_CFDP_SetPduLength(ph);
-        CF_CFDP_Send(txn->chan_num, ph);
+        CF_CFDP_SendTxnPdu(txn, ph);
     }
 
     return ret;
@@ -483,7 +572,7 @@ CFE_Status_t CF_CFDP_SendAck(CF_Transaction_t *txn, CF_CFDP_AckTxnStatus_t ts, C
 
         CF_CFDP_EncodeAck(ph->penc, ack);
         CF_CFDP_SetPduLength(ph);
-        CF_CFDP_Send(txn->chan_num, ph);
+        CF_CFDP_SendTxnPdu(txn, ph);
     }
 
     return ret;
@@ -523,7 +612,7 @@ CFE_Status_t CF_CFDP_SendFin(CF_Transaction_t *txn, CF_CFDP_FinDeliveryCode_t dc
 
         CF_CFDP_EncodeFin(ph->penc, fin);
         CF_CFDP_SetPduLength(ph);
-        CF_CFDP_Send(txn->chan_num, ph);
+        CF_CFDP_SendTxnPdu(txn, ph);
     }
 
     return ret;
@@ -557,7 +646,71 @@ CFE_Status_t CF_CFDP_SendNak(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
 
         CF_CFDP_EncodeNak(ph->penc, nak);
         CF_CFDP_SetPduLength(ph);
-        CF_CFDP_Send(txn->chan_num, ph);
+        CF_CFDP_SendTxnPdu(txn, ph);
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_CFDP_SendPrompt(CF_Transaction_t *txn, CF_CFDP_PromptResponse_t response)
+{
+    CF_Logical_PduBuffer_t *ph =
+        CF_CFDP_ConstructPduHeader(txn, CF_CFDP_FileDirective_PROMPT, CF_AppData.config_table->local_eid,
+                                   txn->history->peer_eid, 0, txn->history->seq_num, 0);
+    CF_Logical_PduPrompt_t *prompt;
+    CFE_Status_t            ret = CFE_SUCCESS;
+
+    if (!ph)
+    {
+        ret = CF_SEND_PDU_NO_BUF_AVAIL_ERROR;
+    }
+    else
+    {
+        prompt = &ph->int_header.prompt;
+
+        prompt->response_required = response;
+
+        CF_CFDP_EncodePrompt(ph->penc, prompt);
+        CF_CFDP_SetPduLength(ph);
+        CF_CFDP_SendTxnPdu(txn, ph);
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_CFDP_SendKeepAlive(CF_Transaction_t *txn, CF_FileSize_t progress)
+{
+    CF_Logical_PduBuffer_t *ph =
+        CF_CFDP_ConstructPduHeader(txn, CF_CFDP_FileDirective_KEEP_ALIVE, txn->history->peer_eid,
+                                   CF_AppData.config_table->local_eid, 1, txn->history->seq_num, 0);
+    CF_Logical_PduKeepAlive_t *ka;
+    CFE_Status_t               ret = CFE_SUCCESS;
+
+    if (!ph)
+    {
+        ret = CF_SEND_PDU_NO_BUF_AVAIL_ERROR;
+    }
+    else
+    {
+        ka = &ph->int_header.keep_alive;
+
+        ka->progress = progress;
+
+        CF_CFDP_EncodeKeepAlive(ph->penc, ka);
+        CF_CFDP_SetPduLength(ph);
+        CF_CFDP_SendTxnPdu(txn, ph);
     }
 
     return ret;
@@ -581,8 +734,11 @@ CFE_Status_t CF_CFDP_RecvPh(uint8 chan_num, CF_Logical_PduBuffer_t *ph)
      */
     if (CF_CFDP_DecodeHeader(ph->pdec, &ph->pdu_header) != CFE_SUCCESS)
     {
-        CFE_EVS_SendEvent(CF_PDU_TRUNCATION_ERR_EID, CFE_EVS_EventType_ERROR,
-                          "CF: PDU rejected due to EID/seq number field truncation");
+        if (!CF_EvAgg_Suppress(CF_EvAgg_PDU_TRUNCATION, 0, 0))
+        {
+            CFE_EVS_SendEvent(CF_PDU_TRUNCATION_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "CF: PDU rejected due to EID/seq number field truncation");
+        }
         ++CF_AppData.hk.Payload.channel_hk[chan_num].counters.recv.error;
         ret = CF_ERROR;
     }
@@ -594,8 +750,11 @@ CFE_Status_t CF_CFDP_RecvPh(uint8 chan_num, CF_Logical_PduBuffer_t *ph)
      */
     else if (CF_CODEC_IS_OK(ph->pdec) && ph->pdu_header.large_flag)
     {
-        CFE_EVS_SendEvent(CF_PDU_LARGE_FILE_ERR_EID, CFE_EVS_EventType_ERROR,
-                          "CF: PDU with large file bit received (unsupported)");
+        if (!CF_EvAgg_Suppress(CF_EvAgg_PDU_LARGE_FILE, 0, 0))
+        {
+            CFE_EVS_SendEvent(CF_PDU_LARGE_FILE_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "CF: PDU with large file bit received (unsupported)");
+        }
         ++CF_AppData.hk.Payload.channel_hk[chan_num].counters.recv.error;
         ret = CF_ERROR;
     }
@@ -608,8 +767,11 @@ CFE_Status_t CF_CFDP_RecvPh(uint8 chan_num, CF_Logical_PduBuffer_t *ph)
 
         if (!CF_CODEC_IS_OK(ph->pdec))
         {
-            CFE_EVS_SendEvent(CF_PDU_SHORT_HEADER_ERR_EID, CFE_EVS_EventType_ERROR, "CF: PDU too short (%lu received)",
-                              (unsigned long)CF_CODEC_GET_SIZE(ph->pdec));
+            if (!CF_EvAgg_Suppress(CF_EvAgg_PDU_SHORT_HEADER, (uint32)CF_CODEC_GET_SIZE(ph->pdec), 0))
+            {
+                CFE_EVS_SendEvent(CF_PDU_SHORT_HEADER_ERR_EID, CFE_EVS_EventType_ERROR,
+                                  "CF: PDU too short (%lu received)", (unsigned long)CF_CODEC_GET_SIZE(ph->pdec));
+            }
             ++CF_AppData.hk.Payload.channel_hk[chan_num].counters.recv.error;
             ret = CF_SHORT_PDU_ERROR;
         }
@@ -632,7 +794,9 @@ CFE_Status_t CF_CFDP_RecvPh(uint8 chan_num, CF_Logical_PduBuffer_t *ph)
 CFE_Status_t CF_CFDP_RecvMd(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
 {
     const CF_Logical_PduMd_t *md = &ph->int_header.md;
+    const CF_Logical_Tlv_t *  tlv;
     int                       lv_ret;
+    int                       i;
     CFE_Status_t              ret = CFE_SUCCESS;
 
     CF_CFDP_DecodeMd(ph->pdec, &ph->int_header.md);
@@ -649,6 +813,33 @@ CFE_Status_t CF_CFDP_RecvMd(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
         /* store the expected file size in transaction */
         txn->fsize = md->size;
 
+        /* a CF sender marks compressed file data, a delta or a bundle with a message to user, any other is ignored */
+        txn->flags.com.compressed = false;
+        txn->flags.com.delta      = false;
+        txn->flags.com.bundle     = false;
+        for (i = 0; i < md->tlv_list.num_tlv; ++i)
+        {
+            tlv = &md->tlv_list.tlv[i];
+            if (tlv->type == CF_CFDP_TLV_TYPE_MESSAGE_TO_USER && tlv->data.data_ptr != NULL &&
+                tlv->length == (sizeof(CF_COMPRESS_TLV_MSG) - 1) &&
+                memcmp(tlv->data.data_ptr, CF_COMPRESS_TLV_MSG, tlv->length) == 0)
+            {
+                txn->flags.com.compressed = true;
+            }
+            else if (tlv->type == CF_CFDP_TLV_TYPE_MESSAGE_TO_USER && tlv->data.data_ptr != NULL &&
+                     tlv->length == (sizeof(CF_DELTA_TLV_MSG) - 1) &&
+                     memcmp(tlv->data.data_ptr, CF_DELTA_TLV_MSG, tlv->length) == 0)
+            {
+                txn->flags.com.delta = true;
+            }
+            else if (tlv->type == CF_CFDP_TLV_TYPE_MESSAGE_TO_USER && tlv->data.data_ptr != NULL &&
+                     tlv->length == (sizeof(CF_BUNDLE_TLV_MSG) - 1) &&
+                     memcmp(tlv->data.data_ptr, CF_BUNDLE_TLV_MSG, tlv->length) == 0)
+            {
+                txn->flags.com.bundle = true;
+            }
+        }
+
         /*
          * store the filenames in transaction.
          *
@@ -683,6 +874,12 @@ CFE_Status_t CF_CFDP_RecvMd(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
                 CFE_EVS_SendEvent(CF_PDU_MD_RECVD_INF_EID, CFE_EVS_EventType_INFORMATION,
                                   "CF: md received for source: %s, dest: %s", txn->history->fnames.src_filename,
                                   txn->history->fnames.dst_filename);
+
+                if (txn->flags.com.delta)
+                {
+                    /* the delta is received in place of the file, and applied against the old copy */
+                    CF_CFDP_R_DeltaSetAside(txn);
+                }
             }
         }
     }
@@ -732,6 +929,10 @@ CFE_Status_t CF_CFDP_RecvFd(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
         ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.error;
         ret = CF_ERROR;
     }
+    else
+    {
+        CF_TRACE_PDU(CF_TraceEvent_PDU_RX, txn->chan_num, ph);
+    }
 
     return ret;
 }
@@ -827,6 +1028,51 @@ CFE_Status_t CF_CFDP_RecvNak(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
     return ret;
 }
 
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_CFDP_RecvPrompt(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
+{
+    CFE_Status_t ret = CFE_SUCCESS;
+
+    CF_CFDP_DecodePrompt(ph->pdec, &ph->int_header.prompt);
+
+    if (!CF_CODEC_IS_OK(ph->pdec))
+    {
+        CFE_EVS_SendEvent(CF_PDU_PROMPT_SHORT_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "CF: PROMPT PDU too short: %lu bytes received", (unsigned long)CF_CODEC_GET_SIZE(ph->pdec));
+        ret = CF_SHORT_PDU_ERROR;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_CFDP_RecvKeepAlive(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
+{
+    CFE_Status_t ret = CFE_SUCCESS;
+
+    CF_CFDP_DecodeKeepAlive(ph->pdec, &ph->int_header.keep_alive);
+
+    if (!CF_CODEC_IS_OK(ph->pdec))
+    {
+        CFE_EVS_SendEvent(CF_PDU_KEEP_ALIVE_SHORT_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "CF: KEEP ALIVE PDU too short: %lu bytes received",
+                          (unsigned long)CF_CODEC_GET_SIZE(ph->pdec));
+        ret = CF_SHORT_PDU_ERROR;
+    }
+
+    return ret;
+}
+
 /*----------------------------------------------------------------
  *
  * Application-scope internal function
@@ -1001,6 +1247,15 @@ CFE_Status_t CF_CFDP_InitEngine(void)
             }
         }
 
+        if (CF_AppData.config_table->chan[i].udp_local_port)
+        {
+            ret = CF_UdpIntf_Open(i);
+            if (ret != OS_SUCCESS)
+            {
+                break;
+            }
+        }
+
         for (j = 0; j < CF_NUM_TRANSACTIONS_PER_CHANNEL; ++j, ++txn)
         {
             txn->chan_num = i;
@@ -1026,6 +1281,11 @@ CFE_Status_t CF_CFDP_InitEngine(void)
 
     if (ret == CFE_SUCCESS)
     {
+        CF_Delivered_Load();
+
+        /* pick up the transactions that were in progress when the engine last stopped */
+        CF_Ckpt_Restore();
+
         CF_AppData.engine.enabled = true;
     }
 
@@ -1048,21 +1308,100 @@ CF_CListTraverse_Status_t CF_CFDP_CycleTxFirstActive(CF_CListNode_t *node, void
     {
         ret = CF_CLIST_CONT; /* suspended, so move on to next */
     }
+    else if (txn->fanout)
+    {
+        CF_Assert(txn->flags.com.q_index == CF_QueueIdx_TXA);
+
+        /* the members of a multi-destination send take one step each in turn, so they all read a block of
+         * the file while it is still in the group's cache. CF_CFDP_CycleTx() keeps making passes. */
+        if (!args->chan->cur && !CF_CFDP_CycleBudgetExpired())
+        {
+            CFE_ES_PerfLogEntry(CF_PERF_ID_PDUSENT(txn->chan_num));
+            CF_CFDP_DispatchTx(txn);
+            CFE_ES_PerfLogExit(CF_PERF_ID_PDUSENT(txn->chan_num));
+
+            args->ran_fanout = true;
+        }
+
+        args->ran_one = 1;
+
+        if (!args->chan->cur)
+        {
+            ret = CF_CLIST_CONT; /* on to the next member */
+        }
+    }
     else
     {
         CF_Assert(txn->flags.com.q_index == CF_QueueIdx_TXA); /* huh? */
 
         /* if no more messages, then chan->cur will be set.
          * If the transaction sent the last filedata PDU and EOF, it will move itself
-         * off the active queue. Run until either of these occur. */
-        while (!args->chan->cur && txn->flags.com.q_index == CF_QueueIdx_TXA)
+         * off the active queue. Run until either of these occur, or the cycle is out of time. */
+        while (!args->chan->cur && txn->flags.com.q_index == CF_QueueIdx_TXA && !CF_CFDP_CycleBudgetExpired())
         {
             CFE_ES_PerfLogEntry(CF_PERF_ID_PDUSENT(txn->chan_num));
             CF_CFDP_DispatchTx(txn);
             CFE_ES_PerfLogExit(CF_PERF_ID_PDUSENT(txn->chan_num));
         }
 
-        args->ran_one = 1;
+        if (txn->flags.tx.follow_wait && !args->chan->cur && !CF_CFDP_CycleBudgetExpired())
+        {
+            /* a followed file with nothing new has stepped aside to TXW, so the next send gets the channel */
+            ret = CF_CLIST_CONT;
+        }
+        else
+        {
+            args->ran_one = 1;
+        }
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CF_CListTraverse_Status_t CF_CFDP_ActivateFanOut(CF_CListNode_t *node, void *context)
+{
+    CF_Transaction_t *txn = container_of(node, CF_Transaction_t, cl_node);
+
+    if (txn->fanout == context)
+    {
+        CF_MoveTransaction(txn, CF_QueueIdx_TXA);
+    }
+
+    return CF_CLIST_CONT;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CF_CListTraverse_Status_t CF_CFDP_PrefetchTxNext(CF_CListNode_t *node, void *context)
+{
+    CF_CFDP_PrefetchTx_args_t *args = (CF_CFDP_PrefetchTx_args_t *)context;
+    CF_Transaction_t *         txn  = container_of(node, CF_Transaction_t, cl_node);
+    CF_CListTraverse_Status_t  ret  = CF_CLIST_CONT;
+
+    if (args->count >= args->depth || CF_CFDP_CycleBudgetExpired())
+    {
+        ret = CF_CLIST_EXIT;
+    }
+    else
+    {
+        ++args->count;
+
+        /* one resumed part way through, or already open, has nothing to gain */
+        if (!txn->flags.com.suspended && !txn->fanout && txn->foffs == 0 && !OS_ObjectIdDefined(txn->fd) &&
+            txn->state_data.send.sub_state == CF_TxSubState_METADATA && !CF_CFDP_S_Prefetch(txn))
+        {
+            ret = CF_CLIST_EXIT; /* no buffer free, so none of the rest can be done either */
+        }
     }
 
     return ret;
@@ -1076,12 +1415,13 @@ CF_CListTraverse_Status_t CF_CFDP_CycleTxFirstActive(CF_CListNode_t *node, void
  *-----------------------------------------------------------------*/
 void CF_CFDP_CycleTx(CF_Channel_t *chan)
 {
-    CF_Transaction_t *     txn;
-    CF_CFDP_CycleTx_args_t args;
+    CF_Transaction_t *        txn;
+    CF_CFDP_CycleTx_args_t    args;
+    CF_CFDP_PrefetchTx_args_t pf_args;
 
     if (CF_AppData.config_table->chan[(chan - CF_AppData.engine.channels)].dequeue_enabled)
     {
-        args = (CF_CFDP_CycleTx_args_t) {chan, 0};
+        args = (CF_CFDP_CycleTx_args_t) {chan, 0, false};
 
         /* loop through as long as there are pending transactions, and a message buffer to send their PDUs on */
 
@@ -1092,9 +1432,18 @@ void CF_CFDP_CycleTx(CF_Channel_t *chan)
 
             while (true)
             {
+                args.ran_one    = 0;
+                args.ran_fanout = false;
+
                 /* Attempt to run something on TXA */
                 CF_CList_Traverse(chan->qs[CF_QueueIdx_TXA], CF_CFDP_CycleTxFirstActive, &args);
 
+                /* members of a multi-destination send get another turn each, while there is room to send */
+                if (args.ran_fanout && !chan->cur && !CF_CFDP_CycleBudgetExpired())
+                {
+                    continue;
+                }
+
                 /* Keep going until CF_QueueIdx_PEND is empty or something is run */
                 if (args.ran_one || chan->qs[CF_QueueIdx_PEND] == NULL)
                 {
@@ -1103,9 +1452,23 @@ void CF_CFDP_CycleTx(CF_Channel_t *chan)
 
                 txn = container_of(chan->qs[CF_QueueIdx_PEND], CF_Transaction_t, cl_node);
                 CF_MoveTransaction(txn, CF_QueueIdx_TXA);
+
+                if (txn->fanout)
+                {
+                    /* the rest of its group starts with it, so they go through the file together */
+                    CF_CList_Traverse(chan->qs[CF_QueueIdx_PEND], CF_CFDP_ActivateFanOut, txn->fanout);
+                }
             }
         }
 
+        /* what is left of the cycle gets the next files ready, so they follow this one without a gap */
+        pf_args.count = 0;
+        pf_args.depth = CF_AppData.config_table->chan[(chan - CF_AppData.engine.channels)].tx_prefetch_depth;
+        if (pf_args.depth)
+        {
+            CF_CList_Traverse(chan->qs[CF_QueueIdx_PEND], CF_CFDP_PrefetchTxNext, &pf_args);
+        }
+
         /* in case the loop exited due to no message buffers, clear it and start from the top next time */
         chan->cur = NULL;
     }
@@ -1122,13 +1485,23 @@ CF_CListTraverse_Status_t CF_CFDP_DoTick(CF_CListNode_t *node, void *context)
     CF_CListTraverse_Status_t ret  = CF_CLIST_CONT; /* CF_CLIST_CONT means don't tick one, keep looking for cur */
     CF_CFDP_Tick_args_t *     args = (CF_CFDP_Tick_args_t *)context;
     CF_Transaction_t *        txn  = container_of(node, CF_Transaction_t, cl_node);
+    CF_TraceStateStamp_t      saved;
+
     if (!args->chan->cur || (args->chan->cur == txn))
     {
         /* found where we left off, so clear that and move on */
         args->chan->cur = NULL;
-        if (!txn->flags.com.suspended)
+        if (args->ticked && CF_CFDP_CycleBudgetExpired())
+        {
+            /* out of time, so this one is the first to be ticked next cycle */
+            args->chan->cur = txn;
+        }
+        else if (!txn->flags.com.suspended)
         {
+            CF_TRACE_STATE_SAVE(saved, txn);
             args->fn(txn, &args->cont);
+            CF_TRACE_STATE_CHECK(saved, txn);
+            args->ticked = true;
         }
 
         /* if args->chan->cur was set to not-NULL above, then exit early */
@@ -1185,14 +1558,20 @@ void CF_CFDP_TickTransactions(CF_Channel_t *chan)
                  * NAK response (could be many)
                  *
                  * New file data on TXA
+                 *
+                 * When the cycle ran out of time instead, NAK response also picks up
+                 * where it left off, so a long NAK list still makes progress.
                  */
-                if (chan->tick_type != CF_TickType_TXW_NAK)
+                if (chan->tick_type != CF_TickType_TXW_NAK || CF_AppData.engine.cycle_expired)
                 {
                     reset = false;
                 }
 
                 break;
             }
+
+            /* a resume point left by an earlier cycle that is no longer on this queue is dropped */
+            chan->cur = NULL;
         } while (args.cont);
 
         if (!reset)
@@ -1207,6 +1586,38 @@ void CF_CFDP_TickTransactions(CF_Channel_t *chan)
     }
 }
 
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_RespondTransactions(CF_Channel_t *chan)
+{
+    const CF_Transaction_t *cur  = chan->cur;
+    CF_CFDP_Tick_args_t     args = {chan, CF_CFDP_R_Respond, 0, 0};
+
+    /* responses go to every transaction, not just from where the last tick left off */
+    chan->cur = NULL;
+
+    CF_CList_Traverse(chan->qs[CF_QueueIdx_RX], CF_CFDP_DoTick, &args);
+    if (!args.early_exit)
+    {
+        args.fn = CF_CFDP_S_Respond;
+        CF_CList_Traverse(chan->qs[CF_QueueIdx_TXW], CF_CFDP_DoTick, &args);
+    }
+
+    /* put back where the tick left off, unless that transaction has since finished */
+    if (cur && cur->flags.com.q_index != CF_QueueIdx_FREE)
+    {
+        chan->cur = cur;
+    }
+    else
+    {
+        chan->cur = NULL;
+    }
+}
+
 /*----------------------------------------------------------------
  *
  * Application-scope internal function
@@ -1226,8 +1637,21 @@ void CF_CFDP_InitTxnTxFile(CF_Transaction_t *txn, CF_CFDP_Class_t cfdp_class, ui
  * Internal helper routine only, not part of API.
  *
  *-----------------------------------------------------------------*/
-static void CF_CFDP_TxFile_Initiate(CF_Transaction_t *txn, CF_CFDP_Class_t cfdp_class, uint8 keep, uint8 chan,
-                                    uint8 priority, CF_EntityId_t dest_id)
+static void CF_CFDP_TxFile_SetNames(CF_Transaction_t *txn, const char *src_filename, const char *dst_filename)
+{
+    strncpy(txn->history->fnames.src_filename, src_filename, sizeof(txn->history->fnames.src_filename) - 1);
+    txn->history->fnames.src_filename[sizeof(txn->history->fnames.src_filename) - 1] = 0;
+    strncpy(txn->history->fnames.dst_filename, dst_filename, sizeof(txn->history->fnames.dst_filename) - 1);
+    txn->history->fnames.dst_filename[sizeof(txn->history->fnames.dst_filename) - 1] = 0;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_CFDP_TxFile_Initiate(CF_Transaction_t *txn, CF_CFDP_Class_t cfdp_class, uint8 keep, uint8 chan,
+                                    uint8 priority, CF_EntityId_t dest_id)
 {
     CFE_EVS_SendEvent(CF_CFDP_S_START_SEND_INF_EID, CFE_EVS_EventType_INFORMATION,
                       "CF: start class %d tx of file %lu:%.*s -> %lu:%.*s", cfdp_class + 1,
@@ -1255,24 +1679,21 @@ static void CF_CFDP_TxFile_Initiate(CF_Transaction_t *txn, CF_CFDP_Class_t cfdp_
 
 /*----------------------------------------------------------------
  *
- * Application-scope internal function
- * See description in cf_cfdp.h for argument/return detail
+ * Internal helper routine only, not part of API.
  *
  *-----------------------------------------------------------------*/
-CFE_Status_t CF_CFDP_TxFile(const char *src_filename, const char *dst_filename, CF_CFDP_Class_t cfdp_class, uint8 keep,
-                            uint8 chan_num, uint8 priority, CF_EntityId_t dest_id)
+static CF_Transaction_t *CF_CFDP_TxFile_Command(const char *src_filename, const char *dst_filename,
+                                                CF_CFDP_Class_t cfdp_class, uint8 keep, uint8 chan_num, uint8 priority,
+                                                CF_EntityId_t dest_id)
 {
-    CF_Transaction_t *txn;
+    CF_Transaction_t *txn  = NULL;
     CF_Channel_t *    chan = &CF_AppData.engine.channels[chan_num];
     CF_Assert(chan_num < CF_NUM_CHANNELS);
 
-    CFE_Status_t ret = CFE_SUCCESS;
-
     if (chan->num_cmd_tx == CF_MAX_COMMANDED_PLAYBACK_FILES_PER_CHAN)
     {
         CFE_EVS_SendEvent(CF_CFDP_MAX_CMD_TX_ERR_EID, CFE_EVS_EventType_ERROR,
                           "CF: max number of commanded files reached");
-        ret = CF_ERROR;
     }
     else
     {
@@ -1282,16 +1703,116 @@ CFE_Status_t CF_CFDP_TxFile(const char *src_filename, const char *dst_filename,
         CF_Assert(txn->state == CF_TxnState_IDLE);
 
         /* NOTE: the caller of this function ensures the provided src and dst filenames are NULL terminated */
-        strncpy(txn->history->fnames.src_filename, src_filename, sizeof(txn->history->fnames.src_filename) - 1);
-        txn->history->fnames.src_filename[sizeof(txn->history->fnames.src_filename) - 1] = 0;
-        strncpy(txn->history->fnames.dst_filename, dst_filename, sizeof(txn->history->fnames.dst_filename) - 1);
-        txn->history->fnames.dst_filename[sizeof(txn->history->fnames.dst_filename) - 1] = 0;
+        CF_CFDP_TxFile_SetNames(txn, src_filename, dst_filename);
         CF_CFDP_TxFile_Initiate(txn, cfdp_class, keep, chan_num, priority, dest_id);
 
         ++chan->num_cmd_tx;
         txn->flags.tx.cmd_tx = true;
     }
 
+    return txn;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_CFDP_TxFile(const char *src_filename, const char *dst_filename, CF_CFDP_Class_t cfdp_class, uint8 keep,
+                            uint8 chan_num, uint8 priority, CF_EntityId_t dest_id, uint8 compress)
+{
+    CF_Transaction_t *txn;
+    CFE_Status_t      ret = CF_ERROR;
+
+    txn = CF_CFDP_TxFile_Command(src_filename, dst_filename, cfdp_class, keep, chan_num, priority, dest_id);
+    if (txn)
+    {
+        txn->compress = compress;
+        ret           = CFE_SUCCESS;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_CFDP_TxFileFollow(const char *src_filename, const char *dst_filename, CF_CFDP_Class_t cfdp_class,
+                                  uint8 keep, uint8 chan_num, uint8 priority, CF_EntityId_t dest_id)
+{
+    CF_Transaction_t *txn;
+    CFE_Status_t      ret = CF_ERROR;
+
+    txn = CF_CFDP_TxFile_Command(src_filename, dst_filename, cfdp_class, keep, chan_num, priority, dest_id);
+    if (txn)
+    {
+        txn->flags.tx.follow = true;
+        ret                  = CFE_SUCCESS;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_CFDP_TxFileMulti(const char *src_filename, const char *dst_filename, CF_CFDP_Class_t cfdp_class,
+                                 uint8 keep, uint8 chan_num, uint8 priority, const CF_EntityId_t *dest_ids,
+                                 uint8 num_dest)
+{
+    CF_Transaction_t *txn;
+    CF_FanOut_t *     group = NULL;
+    CF_Channel_t *    chan  = &CF_AppData.engine.channels[chan_num];
+    uint8             i;
+    CF_Assert(chan_num < CF_NUM_CHANNELS);
+
+    CFE_Status_t ret = CFE_SUCCESS;
+
+    if ((chan->num_cmd_tx + num_dest) > CF_MAX_COMMANDED_PLAYBACK_FILES_PER_CHAN)
+    {
+        CFE_EVS_SendEvent(CF_CFDP_MAX_CMD_TX_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "CF: max number of commanded files reached");
+        ret = CF_ERROR;
+    }
+    else
+    {
+        group = CF_FanOut_Open(src_filename);
+        if (!group)
+        {
+            CFE_EVS_SendEvent(CF_CFDP_FANOUT_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "CF: could not open %.*s for a multi-destination send", CF_FILENAME_MAX_LEN,
+                              src_filename);
+            ret = CF_ERROR;
+        }
+    }
+
+    if (ret == CFE_SUCCESS)
+    {
+        /* one transaction per destination, each with its own sequence number and NAK handling */
+        for (i = 0; i < num_dest; ++i)
+        {
+            txn = CF_FindUnusedTransaction(chan);
+            CF_Assert(txn); /* should always have a free transaction at this point */
+
+            CF_Assert(txn->state == CF_TxnState_IDLE);
+
+            CF_CFDP_TxFile_SetNames(txn, src_filename, dst_filename);
+            txn->fanout = group;
+            CF_FanOut_Attach(group);
+            CF_CFDP_TxFile_Initiate(txn, cfdp_class, keep, chan_num, priority, dest_ids[i]);
+
+            ++chan->num_cmd_tx;
+            txn->flags.tx.cmd_tx = true;
+        }
+    }
+
     return ret;
 }
 
@@ -1302,7 +1823,7 @@ CFE_Status_t CF_CFDP_TxFile(const char *src_filename, const char *dst_filename,
  *-----------------------------------------------------------------*/
 static CFE_Status_t CF_CFDP_PlaybackDir_Initiate(CF_Playback_t *pb, const char *src_filename, const char *dst_filename,
                                                  CF_CFDP_Class_t cfdp_class, uint8 keep, uint8 chan, uint8 priority,
-                                                 CF_EntityId_t dest_id)
+                                                 CF_EntityId_t dest_id, uint8 max_ts, uint8 order, uint8 compress)
 {
     CFE_Status_t ret;
 
@@ -1322,6 +1843,19 @@ static CFE_Status_t CF_CFDP_PlaybackDir_Initiate(CF_Playback_t *pb, const char *
         pb->priority   = priority;
         pb->dest_id    = dest_id;
         pb->cfdp_class = cfdp_class;
+        pb->order      = order;
+        pb->compress   = compress;
+        pb->work_count = 0;
+        pb->work_next  = 0;
+        pb->ready      = false;
+        pb->has_last   = false;
+
+        /* the channel is sized for this many per playback, but any one can use more while others are idle */
+        if (max_ts == 0)
+        {
+            max_ts = CF_NUM_TRANSACTIONS_PER_PLAYBACK;
+        }
+        pb->max_ts = max_ts;
 
         /* NOTE: the caller of this function ensures the provided src and dst filenames are NULL terminated */
         strncpy(pb->fnames.src_filename, src_filename, sizeof(pb->fnames.src_filename) - 1);
@@ -1341,7 +1875,8 @@ static CFE_Status_t CF_CFDP_PlaybackDir_Initiate(CF_Playback_t *pb, const char *
  *
  *-----------------------------------------------------------------*/
 CFE_Status_t CF_CFDP_PlaybackDir(const char *src_filename, const char *dst_filename, CF_CFDP_Class_t cfdp_class,
-                                 uint8 keep, uint8 chan, uint8 priority, uint16 dest_id)
+                                 uint8 keep, uint8 chan, uint8 priority, uint16 dest_id, uint8 max_ts, uint8 order,
+                                 uint8 compress)
 {
     int            i;
     CF_Playback_t *pb;
@@ -1361,29 +1896,333 @@ CFE_Status_t CF_CFDP_PlaybackDir(const char *src_filename, const char *dst_filen
         return CF_ERROR;
     }
 
-    return CF_CFDP_PlaybackDir_Initiate(pb, src_filename, dst_filename, cfdp_class, keep, chan, priority, dest_id);
+    return CF_CFDP_PlaybackDir_Initiate(pb, src_filename, dst_filename, cfdp_class, keep, chan, priority, dest_id,
+                                        max_ts, order, compress);
 }
 
 /*----------------------------------------------------------------
  *
- * Application-scope internal function
- * See description in cf_cfdp.h for argument/return detail
+ * Internal helper routine only, not part of API.
  *
  *-----------------------------------------------------------------*/
-void CF_CFDP_ProcessPlaybackDirectory(CF_Channel_t *chan, CF_Playback_t *pb)
+static void CF_CFDP_PlaybackFile(CF_Channel_t *chan, CF_Playback_t *pb, const char *name)
 {
     CF_Transaction_t *txn;
-    os_dirent_t       dirent;
-    int32             status;
 
-    /* either there's no transaction (first one) or the last one was finished, so check for a new one */
+    txn = CF_FindUnusedTransaction(chan);
+    CF_Assert(txn); /* the caller checked that one is free */
+
+    /* the -1 below is to make room for the slash */
+    snprintf(txn->history->fnames.src_filename, sizeof(txn->history->fnames.src_filename), "%.*s/%.*s",
+             CF_FILENAME_MAX_PATH - 1, pb->fnames.src_filename, CF_FILENAME_MAX_NAME - 1, name);
+    snprintf(txn->history->fnames.dst_filename, sizeof(txn->history->fnames.dst_filename), "%.*s/%.*s",
+             CF_FILENAME_MAX_PATH - 1, pb->fnames.dst_filename, CF_FILENAME_MAX_NAME - 1, name);
+
+    /* in case snprintf didn't have room for NULL terminator */
+    txn->history->fnames.src_filename[CF_FILENAME_MAX_LEN - 1] = 0;
+    txn->history->fnames.dst_filename[CF_FILENAME_MAX_LEN - 1] = 0;
+
+    CF_CFDP_TxFile_Initiate(txn, pb->cfdp_class, pb->keep, (chan - CF_AppData.engine.channels), pb->priority,
+                            pb->dest_id);
+
+    txn->compress = pb->compress;
+    txn->pb       = pb;
+    ++pb->num_ts;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_CFDP_SendBundle(CF_Channel_t *chan, CF_Playback_t *pb)
+{
+    CF_Bundle_t *       bundle = &CF_AppData.engine.bundle;
+    CF_Transaction_t *  txn;
+    CF_TransactionSeq_t seq_num;
+    char                bname[OS_MAX_PATH_LEN];
+    char                src[OS_MAX_PATH_LEN];
+    char                dst[OS_MAX_PATH_LEN];
+
+    if (bundle->count == 1)
+    {
+        /* a lone file gains nothing from a bundle, so it goes as it is */
+        CF_CFDP_PlaybackFile(chan, pb, bundle->entries[0].name);
+    }
+    else if (bundle->count > 1)
+    {
+        /* named for the sequence number the transaction is about to get, so no two bundles share a temp file */
+        seq_num = CF_AppData.engine.seq_num + 1;
+        CF_Bundle_GetBuildFilename(bname, sizeof(bname));
+        CF_Bundle_GetFilename(src, sizeof(src), CF_AppData.config_table->local_eid, seq_num);
+        snprintf(dst, sizeof(dst), "%.*s/%lu_%lu%s", CF_FILENAME_MAX_PATH - 1, pb->fnames.dst_filename,
+                 (unsigned long)CF_AppData.config_table->local_eid, (unsigned long)seq_num, CF_BUNDLE_EXT);
+
+        if (CF_Bundle_Finish(bundle) != CFE_SUCCESS || CF_WrappedRename(bname, src) != OS_SUCCESS)
+        {
+            CFE_EVS_SendEvent(CF_CFDP_BUNDLE_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "CF: failed to build bundle of %lu files from %s, they are left in place",
+                              (unsigned long)bundle->count, pb->fnames.src_filename);
+            CF_WrappedRemove(bname);
+        }
+        else
+        {
+            txn = CF_FindUnusedTransaction(chan);
+            CF_Assert(txn); /* the caller checked that one is free, same as for a lone file */
+
+            CF_CFDP_TxFile_SetNames(txn, src, dst);
+            txn->flags.com.bundle = true;
+
+            /* the temp file is kept until reset, which then keeps or moves the files in it as the playback says */
+            CF_CFDP_TxFile_Initiate(txn, pb->cfdp_class, 1, (chan - CF_AppData.engine.channels), pb->priority,
+                                    pb->dest_id);
+
+            txn->pb = pb;
+            ++pb->num_ts;
+        }
+    }
+
+    CF_Bundle_Release(bundle);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static bool CF_CFDP_BundleFile(CF_Channel_t *chan, CF_Playback_t *pb, const char *name)
+{
+    CF_ChannelConfig_t *cc     = &CF_AppData.config_table->chan[chan - CF_AppData.engine.channels];
+    CF_Bundle_t *       bundle = &CF_AppData.engine.bundle;
+    os_fstat_t          fst;
+    uint32              fsize = 0;
+    char                path[OS_MAX_PATH_LEN];
+    bool                ret = false;
+
+    /* another playback building a bundle just means this one sends its files alone until it is done */
+    if (cc->bundle_file_size && (bundle->owner == NULL || bundle->owner == pb) &&
+        OS_strnlen(name, CF_FILENAME_MAX_NAME) < CF_FILENAME_MAX_NAME)
+    {
+        snprintf(path, sizeof(path), "%.*s/%s", CF_FILENAME_MAX_PATH - 1, pb->fnames.src_filename, name);
+        if (CF_WrappedStat(path, &fst) == OS_SUCCESS && !OS_FILESTAT_ISDIR(fst))
+        {
+            fsize = OS_FILESTAT_SIZE(fst);
+            ret   = (fsize <= cc->bundle_file_size && fsize <= cc->bundle_max_size);
+        }
+    }
+
+    if (ret)
+    {
+        if (bundle->owner == pb &&
+            (bundle->count == CF_BUNDLE_MAX_FILES || (bundle->size + fsize) > cc->bundle_max_size))
+        {
+            /* full, so it goes now and this file starts the next one */
+            CF_CFDP_SendBundle(chan, pb);
+        }
+
+        /*
+         * The file is taken even if it could not be added. Sending it alone
+         * here could go over the playback's transactions when the full bundle
+         * just went, and whatever kept it out would likely stop that too.
+         */
+        if (bundle->owner == NULL && CF_Bundle_Start(bundle, pb) != CFE_SUCCESS)
+        {
+            CFE_EVS_SendEvent(CF_CFDP_BUNDLE_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "CF: failed to create bundle, %s is left in place", path);
+        }
+        else if (CF_Bundle_AddFile(bundle, path, name, fsize) != CFE_SUCCESS)
+        {
+            CFE_EVS_SendEvent(CF_CFDP_BUNDLE_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "CF: failed to add %s to bundle, it is left in place", path);
+
+            if (!OS_ObjectIdDefined(bundle->fd))
+            {
+                /* the files already in it go in a later pass */
+                CF_Bundle_Release(bundle);
+            }
+        }
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static bool CF_CFDP_PlaybackIsGlobalOrder(const CF_Playback_t *pb)
+{
+    /* these are the orders that pick from the whole directory, and need each file stat'd to do it */
+    return (pb->order == CF_PlaybackOrder_OLDEST || pb->order == CF_PlaybackOrder_NEWEST ||
+            pb->order == CF_PlaybackOrder_SMALLEST);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static int CF_CFDP_PlaybackEntryCmp(uint8 order, const CF_PlaybackEntry_t *a, const CF_PlaybackEntry_t *b)
+{
+    int ret = 0;
+
+    switch (order)
+    {
+        case CF_PlaybackOrder_OLDEST:
+            ret = (a->mtime > b->mtime) - (a->mtime < b->mtime);
+            break;
+        case CF_PlaybackOrder_NEWEST:
+            ret = (a->mtime < b->mtime) - (a->mtime > b->mtime);
+            break;
+        case CF_PlaybackOrder_SMALLEST:
+            ret = (a->size > b->size) - (a->size < b->size);
+            break;
+        default:
+            break;
+    }
+
+    /* anything else, or a tie, goes by name so the order is always the same */
+    if (!ret)
+    {
+        ret = strncmp(a->name, b->name, sizeof(a->name));
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_CFDP_SiftPlaybackWork(CF_Playback_t *pb, uint32 root, uint32 count)
+{
+    CF_PlaybackEntry_t *work = pb->work;
+    CF_PlaybackEntry_t  tmp;
+    uint32              child = (2 * root) + 1;
+
+    while (child < count)
+    {
+        if ((child + 1) < count && CF_CFDP_PlaybackEntryCmp(pb->order, &work[child], &work[child + 1]) < 0)
+        {
+            ++child;
+        }
+
+        if (CF_CFDP_PlaybackEntryCmp(pb->order, &work[root], &work[child]) >= 0)
+        {
+            break;
+        }
+
+        tmp         = work[root];
+        work[root]  = work[child];
+        work[child] = tmp;
+
+        root  = child;
+        child = (2 * root) + 1;
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_CFDP_HeapPlaybackWork(CF_Playback_t *pb)
+{
+    uint32 i;
+
+    for (i = pb->work_count / 2; i > 0; --i)
+    {
+        CF_CFDP_SiftPlaybackWork(pb, i - 1, pb->work_count);
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_CFDP_SortPlaybackWork(CF_Playback_t *pb, uint32 size)
+{
+    CF_PlaybackEntry_t tmp;
+    uint32             i;
+
+    /* a full list is already a heap, as it was made one when it filled */
+    if (pb->work_count < size)
+    {
+        CF_CFDP_HeapPlaybackWork(pb);
+    }
+
+    /* heap sort, so the list is sorted where it is in a bounded number of steps */
+    for (i = pb->work_count; i > 1; --i)
+    {
+        tmp             = pb->work[0];
+        pb->work[0]     = pb->work[i - 1];
+        pb->work[i - 1] = tmp;
+        CF_CFDP_SiftPlaybackWork(pb, 0, i - 1);
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_CFDP_KeepPlaybackEntry(CF_Playback_t *pb, const CF_PlaybackEntry_t *entry, uint32 size)
+{
+    if (pb->has_last && CF_CFDP_PlaybackEntryCmp(pb->order, entry, &pb->last) <= 0)
+    {
+        /* sent in an earlier pass, so it is left out */
+        return;
+    }
+
+    if (pb->work_count < size)
+    {
+        pb->work[pb->work_count] = *entry;
+        ++pb->work_count;
+
+        if (pb->work_count == size)
+        {
+            CF_CFDP_HeapPlaybackWork(pb);
+        }
+    }
+    else if (CF_CFDP_PlaybackEntryCmp(pb->order, entry, &pb->work[0]) < 0)
+    {
+        /* the full list is a heap with the one that goes last on top, so this one goes in its place */
+        pb->work[0] = *entry;
+        CF_CFDP_SiftPlaybackWork(pb, 0, pb->work_count);
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_CFDP_ReadPlaybackDirectory(CF_Channel_t *chan, CF_Playback_t *pb)
+{
+    CF_ChannelConfig_t *cc = &CF_AppData.config_table->chan[chan - CF_AppData.engine.channels];
+    CF_PlaybackEntry_t  entry;
+    os_dirent_t         dirent;
+    os_fstat_t          fst;
+    char                path[OS_MAX_PATH_LEN];
+    int32               status;
+    CF_InstrStamp_t     stamp;
+    bool                global = CF_CFDP_PlaybackIsGlobalOrder(pb);
+    uint32              size   = global ? CF_PLAYBACK_ORDER_LIST_SIZE : CF_PLAYBACK_WORK_LIST_SIZE;
 
     memset(&dirent, 0, sizeof(dirent));
 
-    while (pb->diropen && (pb->num_ts < CF_NUM_TRANSACTIONS_PER_PLAYBACK))
+    while (pb->diropen && !pb->ready &&
+           (!cc->dir_reads_per_wakeup || chan->dir_reads < cc->dir_reads_per_wakeup) && !CF_CFDP_CycleBudgetExpired())
     {
+        ++chan->dir_reads;
+
         CFE_ES_PerfLogEntry(CF_PERF_ID_DIRREAD);
+        CF_INSTR_START(stamp);
         status = OS_DirectoryRead(pb->dir_id, &dirent);
+        CF_INSTR_RECORD(CF_InstrHist_DIRREAD, stamp);
         CFE_ES_PerfLogExit(CF_PERF_ID_DIRREAD);
 
         if (status == CFE_SUCCESS)
@@ -1393,35 +2232,151 @@ void CF_CFDP_ProcessPlaybackDirectory(CF_Channel_t *chan, CF_Playback_t *pb)
                 continue;
             }
 
-            txn = CF_FindUnusedTransaction(chan);
-            CF_Assert(pt); /* should be impossible not to have one because there are limits on the number of uses of
-                                them */
-
-            /* the -1 below is to make room for the slash */
-            snprintf(txn->history->fnames.src_filename, sizeof(txn->history->fnames.src_filename), "%.*s/%.*s",
-                     CF_FILENAME_MAX_PATH - 1, pb->fnames.src_filename, CF_FILENAME_MAX_NAME - 1, dirent.FileName);
-            snprintf(txn->history->fnames.dst_filename, sizeof(txn->history->fnames.dst_filename), "%.*s/%.*s",
-                     CF_FILENAME_MAX_PATH - 1, pb->fnames.dst_filename, CF_FILENAME_MAX_NAME - 1, dirent.FileName);
+            strncpy(entry.name, dirent.FileName, sizeof(entry.name) - 1);
+            entry.name[sizeof(entry.name) - 1] = 0;
+            entry.mtime                        = 0;
+            entry.size                         = 0;
 
-            /* in case snprintf didn't have room for NULL terminator */
-            txn->history->fnames.src_filename[CF_FILENAME_MAX_LEN - 1] = 0;
-            txn->history->fnames.dst_filename[CF_FILENAME_MAX_LEN - 1] = 0;
+            /* a file that cannot be stat'd sorts as the oldest and smallest */
+            if (global)
+            {
+                snprintf(path, sizeof(path), "%.*s/%s", CF_FILENAME_MAX_PATH - 1, pb->fnames.src_filename,
+                         entry.name);
+                if (CF_WrappedStat(path, &fst) == OS_SUCCESS)
+                {
+                    entry.mtime = OS_FILESTAT_TIME(fst);
+                    entry.size  = OS_FILESTAT_SIZE(fst);
+                }
+            }
 
-            CF_CFDP_TxFile_Initiate(txn, pb->cfdp_class, pb->keep, (chan - CF_AppData.engine.channels), pb->priority,
-                                    pb->dest_id);
+            CF_CFDP_KeepPlaybackEntry(pb, &entry, size);
 
-            txn->pb = pb;
-            ++pb->num_ts;
+            /* in name order each batch goes as soon as it is read, so the directory is read once */
+            if (!global && pb->work_count == size)
+            {
+                pb->ready = true;
+            }
         }
         else
         {
             /* PFTO: can we figure out the difference between "end of dir" and an error? */
-            OS_DirectoryClose(pb->dir_id);
-            pb->diropen = false;
+            pb->ready = true;
+
+            if (pb->work_count < size)
+            {
+                /* all that is left is in the list, so the playback is done with the directory */
+                OS_DirectoryClose(pb->dir_id);
+                pb->diropen = false;
+            }
         }
     }
 
-    if (!pb->diropen && !pb->num_ts)
+    if (pb->ready)
+    {
+        CF_CFDP_SortPlaybackWork(pb, size);
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static bool CF_CFDP_PlaybackHasRoom(CF_Channel_t *chan, const CF_Playback_t *pb)
+{
+    const CF_HkChannel_Data_t *hk       = &CF_AppData.hk.Payload.channel_hk[chan - CF_AppData.engine.channels];
+    uint32                     reserved = 0;
+    bool                       has_room;
+
+    if (pb->num_ts >= pb->max_ts)
+    {
+        has_room = false;
+    }
+    else
+    {
+        /* playbacks share the channel's free transactions, less those that receives and commanded sends
+         * are yet to use, as those have no way to wait for one */
+        if (hk->q_size[CF_QueueIdx_RX] < CF_MAX_SIMULTANEOUS_RX)
+        {
+            reserved += CF_MAX_SIMULTANEOUS_RX - hk->q_size[CF_QueueIdx_RX];
+        }
+        if (chan->num_cmd_tx < CF_MAX_COMMANDED_PLAYBACK_FILES_PER_CHAN)
+        {
+            reserved += CF_MAX_COMMANDED_PLAYBACK_FILES_PER_CHAN - chan->num_cmd_tx;
+        }
+
+        has_room = (hk->q_size[CF_QueueIdx_FREE] > reserved);
+    }
+
+    return has_room;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_ProcessPlaybackDirectory(CF_Channel_t *chan, CF_Playback_t *pb)
+{
+    CF_PlaybackEntry_t *entry;
+    bool                more = true;
+
+    while (more)
+    {
+        if (pb->ready && pb->work_next == pb->work_count)
+        {
+            /* all of the last list was sent, so the next one is read */
+            if (pb->diropen && CF_CFDP_PlaybackIsGlobalOrder(pb))
+            {
+                /* the last list was full, so the whole directory is read again for the ones after it */
+                pb->last     = pb->work[pb->work_count - 1];
+                pb->has_last = true;
+
+                if (OS_DirectoryRewind(pb->dir_id) != OS_SUCCESS)
+                {
+                    OS_DirectoryClose(pb->dir_id);
+                    pb->diropen = false;
+                }
+            }
+
+            pb->work_next  = 0;
+            pb->work_count = 0;
+            pb->ready      = false;
+        }
+
+        if (pb->diropen && !pb->ready)
+        {
+            CF_CFDP_ReadPlaybackDirectory(chan, pb);
+        }
+
+        /* nothing is sent until the list is complete and sorted, which may take more than one wakeup */
+        more = pb->ready;
+
+        while (more && pb->work_next < pb->work_count && CF_CFDP_PlaybackHasRoom(chan, pb) &&
+               !CF_CFDP_CycleBudgetExpired())
+        {
+            entry = &pb->work[pb->work_next];
+            ++pb->work_next;
+
+            if (!CF_CFDP_BundleFile(chan, pb, entry->name))
+            {
+                CF_CFDP_PlaybackFile(chan, pb, entry->name);
+            }
+        }
+
+        /* all of this list was sent, so there may be more in the directory to read now */
+        more = (more && pb->diropen && pb->work_next == pb->work_count);
+    }
+
+    if (!pb->diropen && pb->work_next == pb->work_count && CF_AppData.engine.bundle.owner == pb &&
+        CF_CFDP_PlaybackHasRoom(chan, pb))
+    {
+        /* the directory has been exhausted, so whatever is in the bundle goes now */
+        CF_CFDP_SendBundle(chan, pb);
+    }
+
+    if (!pb->diropen && pb->work_next == pb->work_count && !pb->num_ts && CF_AppData.engine.bundle.owner != pb)
     {
         /* the directory has been exhausted, and there are no more active transactions
          * for this playback -- so mark it as not busy */
@@ -1509,7 +2464,8 @@ void CF_CFDP_ProcessPollingDirectories(CF_Channel_t *chan)
                 {
                     /* the timer has expired */
                     ret = CF_CFDP_PlaybackDir_Initiate(&poll->pb, pd->src_dir, pd->dst_dir, pd->cfdp_class, 0,
-                                                       chan_index, pd->priority, pd->dest_eid);
+                                                       chan_index, pd->priority, pd->dest_eid, pd->max_ts, pd->order,
+                                                       CF_TxCompress_CHANNEL);
                     if (!ret)
                     {
                         poll->timer_set = false;
@@ -1548,36 +2504,183 @@ void CF_CFDP_ProcessPollingDirectories(CF_Channel_t *chan)
  *-----------------------------------------------------------------*/
 void CF_CFDP_CycleEngine(void)
 {
-    CF_Channel_t *chan;
-    int           i;
+    CF_Channel_t *  chan;
+    OS_time_t       now;
+    CF_InstrStamp_t stamp;
+    int             i;
+    int             n;
+    bool            deferred = false;
 
     if (CF_AppData.engine.enabled)
     {
-        for (i = 0; i < CF_NUM_CHANNELS; ++i)
+        OS_GetLocalTime(&CF_AppData.engine.cycle_start);
+        CF_AppData.engine.cycle_usec    = CF_AppData.config_table->cycle_max_usec;
+        CF_AppData.engine.cycle_expired = false;
+        ++CF_AppData.engine.cycle_num;
+
+        /* open a new flow control interval for every peer before any file data goes out */
+        CF_Flow_Cycle();
+
+        /* start with the channel that ran out of time last cycle, so every channel gets its turn */
+        i = CF_AppData.engine.cycle_chan % CF_NUM_CHANNELS;
+        for (n = 0; n < CF_NUM_CHANNELS; ++n, i = (i + 1) % CF_NUM_CHANNELS)
         {
-            chan                               = &CF_AppData.engine.channels[i];
-            CF_AppData.engine.outgoing_counter = 0;
+            chan = &CF_AppData.engine.channels[i];
+
+            /* a new wakeup period; CF_CFDP_ServiceInput() passes until the next one share what is left */
+            chan->outgoing_counter = 0;
+
+            CF_Instr_SetChannel(i);
+            CF_INSTR_START(stamp);
 
             /* consume all received messages, even if channel is frozen */
             CF_CFDP_ReceiveMessage(chan);
 
             if (!CF_AppData.hk.Payload.channel_hk[i].frozen)
             {
-                /* handle ticks before tx cycle. Do this because there may be a limited number of TX messages available
-                 * this cycle, and it's important to respond to class 2 ACK/NAK more than it is to send new filedata
-                 * PDUs. */
+                if (!CF_CFDP_CycleBudgetExpired())
+                {
+                    /* handle ticks before tx cycle. Do this because there may be a limited number of TX messages
+                     * available this cycle, and it's important to respond to class 2 ACK/NAK more than it is to send
+                     * new filedata PDUs. */
+
+                    /* cycle all transactions (tick) */
+                    CF_CFDP_TickTransactions(chan);
+                }
 
-                /* cycle all transactions (tick) */
-                CF_CFDP_TickTransactions(chan);
+                /* when out of time, chan->cur holds the tick resume point, which CF_CFDP_CycleTx() would clear */
+                if (!CF_CFDP_CycleBudgetExpired())
+                {
+                    /* cycle the current tx transaction */
+                    CF_CFDP_CycleTx(chan);
+                }
 
-                /* cycle the current tx transaction */
-                CF_CFDP_CycleTx(chan);
+                if (!CF_CFDP_CycleBudgetExpired())
+                {
+                    chan->dir_reads = 0;
+                    CF_CFDP_ProcessPlaybackDirectories(chan);
+                    CF_CFDP_ProcessPollingDirectories(chan);
+                }
 
-                CF_CFDP_ProcessPlaybackDirectories(chan);
-                CF_CFDP_ProcessPollingDirectories(chan);
+                if (!deferred && CF_AppData.engine.cycle_expired)
+                {
+                    deferred                     = true;
+                    CF_AppData.engine.cycle_chan = i;
+                }
+            }
+
+            CF_INSTR_RECORD(CF_InstrHist_CYCLE, stamp);
+        }
+
+        CF_Ckpt_Cycle();
+
+        OS_GetLocalTime(&now);
+        CF_CFDP_UpdateCycleStats(OS_TimeGetTotalMicroseconds(OS_TimeSubtract(now, CF_AppData.engine.cycle_start)),
+                                 CF_AppData.engine.cycle_usec);
+
+        /* work done between cycles (CF_CFDP_ServiceInput) is not budgeted */
+        CF_AppData.engine.cycle_usec    = 0;
+        CF_AppData.engine.cycle_expired = false;
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_CFDP_CycleBudgetExpired(void)
+{
+    OS_time_t now;
+
+    if (CF_AppData.engine.cycle_usec != 0 && !CF_AppData.engine.cycle_expired)
+    {
+        OS_GetLocalTime(&now);
+        CF_AppData.engine.cycle_expired =
+            (OS_TimeGetTotalMicroseconds(OS_TimeSubtract(now, CF_AppData.engine.cycle_start)) >=
+             CF_AppData.engine.cycle_usec);
+    }
+
+    return CF_AppData.engine.cycle_expired;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_UpdateCycleStats(uint32 usec, uint32 budget)
+{
+    CF_HkCycle_Data_t *hk = &CF_AppData.hk.Payload.cycle;
+
+    if (hk->count == 0)
+    {
+        hk->min_usec  = usec;
+        hk->mean_usec = usec;
+        hk->max_usec  = usec;
+    }
+    else
+    {
+        if (usec < hk->min_usec)
+        {
+            hk->min_usec = usec;
+        }
+        if (usec > hk->max_usec)
+        {
+            hk->max_usec = usec;
+        }
+        hk->mean_usec = (uint32)((((uint64)hk->mean_usec * 7) + usec) / 8);
+    }
+
+    if (hk->count != UINT32_MAX)
+    {
+        ++hk->count;
+    }
+
+    if (budget != 0 && usec > budget)
+    {
+        ++hk->overruns;
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_CFDP_ServiceInput(void)
+{
+    CF_Channel_t *chan;
+    uint32        recv_pdu;
+    bool          event_driven = false;
+    int           i;
+
+    if (CF_AppData.engine.enabled)
+    {
+        for (i = 0; i < CF_NUM_CHANNELS; ++i)
+        {
+            if (CF_AppData.config_table->chan[i].rx_event_driven)
+            {
+                event_driven = true;
+                chan         = &CF_AppData.engine.channels[i];
+                recv_pdu     = CF_AppData.hk.Payload.channel_hk[i].counters.recv.pdu;
+
+                CF_CFDP_ReceiveMessage(chan);
+
+                /* responses only come from received PDUs, and a frozen channel sends nothing */
+                if (CF_AppData.hk.Payload.channel_hk[i].counters.recv.pdu != recv_pdu &&
+                    !CF_AppData.hk.Payload.channel_hk[i].frozen)
+                {
+                    CF_CFDP_RespondTransactions(chan);
+                }
             }
         }
     }
+
+    return event_driven;
 }
 
 /*----------------------------------------------------------------
@@ -1590,6 +2693,7 @@ void CF_CFDP_ResetTransaction(CF_Transaction_t *txn, bool keep_history)
 {
 
     CF_Channel_t *chan   = &CF_AppData.engine.channels[txn->chan_num];
+    char          zname[OS_MAX_PATH_LEN];
     CF_Assert(txn->chan_num < CF_NUM_CHANNELS);
 
     if (txn->flags.com.q_index == CF_QueueIdx_FREE)
@@ -1599,23 +2703,91 @@ void CF_CFDP_ResetTransaction(CF_Transaction_t *txn, bool keep_history)
         return;
     }
 
+    /* close out the performance record before it is reported */
+    CF_CFDP_PerfWait(txn->history, false);
+    txn->history->perf.end_time = CFE_TIME_GetTime();
+
     CF_CFDP_SendEotPkt(txn);
 
     CF_DequeueTransaction(txn);
 
-    if (OS_ObjectIdDefined(txn->fd))
+    /*
+     * only class 2 knows the file arrived, and a file found already delivered is in the index already,
+     * and a bundle is a temp file that is never sent again
+     */
+    if (txn->state == CF_TxnState_S2 && txn->history->txn_stat == CF_TxnStatus_NO_ERROR &&
+        txn->flags.com.crc_calc && !txn->flags.tx.delivered && !txn->flags.com.bundle &&
+        CF_AppData.config_table->chan[txn->chan_num].tx_skip_delivered)
+    {
+        if (txn->flags.com.compressed || txn->flags.com.delta)
+        {
+            /* the index is of the file as it is at both ends, not as it was sent */
+            CF_Delivered_Add(txn->history->peer_eid, txn->history->fnames.dst_filename, txn->raw_size,
+                             txn->state_data.send.raw_crc);
+        }
+        else
+        {
+            CF_Delivered_Add(txn->history->peer_eid, txn->history->fnames.dst_filename, txn->fsize,
+                             txn->crc.result);
+        }
+    }
+
+    if (txn->fanout)
+    {
+        /* the source file is shared, so it is only let go of once every destination is done with it */
+        if (CF_FanOut_Release(txn->fanout, !CF_TxnStatus_IsError(txn->history->txn_stat)) && !txn->keep)
+        {
+            CF_CFDP_HandleNotKeepFile(txn);
+        }
+    }
+    else if (OS_ObjectIdDefined(txn->fd))
     {
         CF_WrappedClose(txn->fd);
 
-        if (!txn->keep)
+        /* a failed receive may leave its partial file for a later send of the same file to finish,
+         * and a send that was only opened ahead of time never started, so its file is left as it is */
+        if (!txn->keep && !(txn->history->dir == CF_Direction_TX && txn->flags.tx.prefetched) &&
+            !CF_Ckpt_RetainPartial(txn))
         {
             CF_CFDP_HandleNotKeepFile(txn);
         }
     }
 
+    if (OS_ObjectIdDefined(txn->zfd))
+    {
+        CF_WrappedClose(txn->zfd);
+    }
+
+    if (txn->flags.com.compressed)
+    {
+        /* a finished expansion has already moved its temp file into place, so this only finds one left over */
+        CF_Compress_GetFilename(zname, sizeof(zname), txn->history->src_eid, txn->history->seq_num);
+        CF_WrappedRemove(zname);
+    }
+
+    if (txn->flags.com.delta)
+    {
+        /* likewise a delta sent, or a file rebuilt from one that did not check out */
+        CF_Delta_GetFilename(zname, sizeof(zname), txn->history->src_eid, txn->history->seq_num, CF_DELTA_TEMP_EXT);
+        CF_WrappedRemove(zname);
+    }
+
+    /* a finished transaction must not be resumed after a restart */
+    CF_Ckpt_Remove(txn);
+
     /* extra bookkeeping for tx direction only */
     if (txn->history->dir == CF_Direction_TX)
     {
+        CF_CFDP_S_DeltaReset(txn);
+        CF_CFDP_S_BundleReset(txn);
+        CF_CFDP_S_PrefetchRelease(txn);
+
+        if (txn->state_data.send.s2.fc_in_flight)
+        {
+            /* the peer will never acknowledge this data now */
+            CF_Flow_Release(CF_Flow_LookupPeer(txn->history->peer_eid), txn->state_data.send.s2.fc_in_flight);
+        }
+
         if (txn->flags.tx.cmd_tx)
         {
             CF_Assert(chan->num_cmd_tx); /* sanity check */
@@ -1629,6 +2801,13 @@ void CF_CFDP_ResetTransaction(CF_Transaction_t *txn, bool keep_history)
             --txn->pb->num_ts;
         }
     }
+    else
+    {
+        /* an R2 transaction that never got its metadata may still hold staged file data */
+        CF_CFDP_R2_StagingRelease(txn);
+
+        CF_CFDP_R_DeltaReset(txn);
+    }
 
     /* bookkeeping for all transactions */
     /* move transaction history to history queue */
@@ -1674,11 +2853,14 @@ void CF_CFDP_SendEotPkt(CF_Transaction_t *txn)
 {
     CF_EotPacket_t * EotPktPtr;
     CFE_SB_Buffer_t *BufPtr;
+    CF_InstrStamp_t  stamp;
 
     /*
     ** Get a Message block of memory and initialize it
     */
+    CF_INSTR_START(stamp);
     BufPtr = CFE_SB_AllocateMessageBuffer(sizeof(*EotPktPtr));
+    CF_INSTR_RECORD(CF_InstrHist_SB_ALLOC, stamp);
 
     if (BufPtr != NULL)
     {
@@ -1696,6 +2878,26 @@ void CF_CFDP_SendEotPkt(CF_Transaction_t *txn)
         EotPktPtr->Payload.seq_num    = txn->history->seq_num;
         EotPktPtr->Payload.fsize      = txn->fsize;
         EotPktPtr->Payload.crc_result = txn->crc.result;
+        EotPktPtr->Payload.delivered  = (txn->history->dir == CF_Direction_TX && txn->flags.tx.delivered);
+        EotPktPtr->Payload.perf       = txn->history->perf;
+
+        /* the ratio is in hundredths, and the compression time is per MiB of the original file */
+        EotPktPtr->Payload.raw_size = txn->fsize;
+        if (txn->flags.com.compressed || txn->flags.com.delta)
+        {
+            EotPktPtr->Payload.raw_size = txn->raw_size;
+        }
+        EotPktPtr->Payload.zip_ratio  = 100;
+        EotPktPtr->Payload.zip_per_mb = 0;
+        if (txn->fsize != 0)
+        {
+            EotPktPtr->Payload.zip_ratio = (uint32)(((uint64)EotPktPtr->Payload.raw_size * 100) / txn->fsize);
+        }
+        if (EotPktPtr->Payload.raw_size != 0)
+        {
+            EotPktPtr->Payload.zip_per_mb =
+                (uint32)(((uint64)txn->history->perf.zip_usec << 20) / EotPktPtr->Payload.raw_size);
+        }
 
         /*
         ** Timestamp and send eod of transaction telemetry
@@ -1751,10 +2953,19 @@ void CF_CFDP_CancelTransaction(CF_Transaction_t *txn)
 CF_CListTraverse_Status_t CF_CFDP_CloseFiles(CF_CListNode_t *node, void *context)
 {
     CF_Transaction_t *txn = container_of(node, CF_Transaction_t, cl_node);
-    if (OS_ObjectIdDefined(txn->fd))
+    if (txn->fanout)
+    {
+        /* the transfer did not finish, so the shared source file is closed but never moved */
+        CF_FanOut_Release(txn->fanout, false);
+    }
+    else if (OS_ObjectIdDefined(txn->fd))
     {
         CF_WrappedClose(txn->fd);
     }
+    if (OS_ObjectIdDefined(txn->zfd))
+    {
+        CF_WrappedClose(txn->zfd);
+    }
     return CF_CLIST_CONT;
 }
 
@@ -1768,7 +2979,8 @@ void CF_CFDP_DisableEngine(void)
 {
     int                        i;
     int                        j;
-    static const CF_QueueIdx_t CLOSE_QUEUES[] = {CF_QueueIdx_RX, CF_QueueIdx_TXA, CF_QueueIdx_TXW};
+    static const CF_QueueIdx_t CLOSE_QUEUES[] = {CF_QueueIdx_RX, CF_QueueIdx_TXA, CF_QueueIdx_TXW,
+                                                 CF_QueueIdx_PEND};
     CF_Channel_t *             chan;
 
     CF_AppData.engine.enabled = false;
@@ -1777,7 +2989,7 @@ void CF_CFDP_DisableEngine(void)
     {
         chan = &CF_AppData.engine.channels[i];
 
-        /* first, close all active files */
+        /* first, close all active files, and those of pending sends opened ahead of time */
         for (j = 0; j < (sizeof(CLOSE_QUEUES) / sizeof(CLOSE_QUEUES[0])); ++j)
         {
             CF_CList_Traverse(chan->qs[CLOSE_QUEUES[j]], CF_CFDP_CloseFiles, NULL);
@@ -1804,7 +3016,11 @@ void CF_CFDP_DisableEngine(void)
         memset(&CF_AppData.hk.Payload.channel_hk[i].q_size, 0, sizeof(CF_AppData.hk.Payload.channel_hk[i].q_size));
 
         CFE_SB_DeletePipe(chan->pipe);
+        CF_UdpIntf_Close(i);
     }
+
+    /* a bundle still being built is thrown away, its files are still in their directories */
+    CF_Bundle_Release(&CF_AppData.engine.bundle);
 }
 
 /*----------------------------------------------------------------
@@ -1870,7 +3086,7 @@ void CF_CFDP_HandleNotKeepFile(CF_Transaction_t *txn)
     /* Not Sender */
     else
     {
-        OS_remove(txn->history->fnames.dst_filename);
+        CF_WrappedRemove(txn->history->fnames.dst_filename);
     }
 }
 
@@ -1902,12 +3118,12 @@ void CF_CFDP_MoveFile(const char *src, const char *dest_dir)
                 CFE_EVS_SendEvent(CF_EID_INF_CFDP_BUF_EXCEED, CFE_EVS_EventType_INFORMATION,
                                   "CF: destination has been truncated to %s", destination);
             }
-            status = OS_mv(src, destination);
+            status = CF_WrappedRename(src, destination);
         }
     }
 
     if (status != OS_SUCCESS)
     {
-        OS_remove(src);
+        CF_WrappedRemove(src);
     }
 }
\ No newline at end of file
@@ -33,10 +33,20 @@
  */
 typedef struct CF_CFDP_CycleTx_args
 {
-    CF_Channel_t *chan;    /**< \brief channel structure */
-    int           ran_one; /**< \brief should be set to 1 if a transaction was cycled */
+    CF_Channel_t *chan;       /**< \brief channel structure */
+    int           ran_one;    /**< \brief should be set to 1 if a transaction was cycled */
+    bool          ran_fanout; /**< \brief set if a member of a multi-destination send took a turn */
 } CF_CFDP_CycleTx_args_t;
 
+/**
+ * @brief Structure for use with the CF_CFDP_PrefetchTxNext() function
+ */
+typedef struct CF_CFDP_PrefetchTx_args
+{
+    uint8 count; /**< \brief number of pending transactions looked at so far */
+    uint8 depth; /**< \brief number of pending transactions to look at */
+} CF_CFDP_PrefetchTx_args_t;
+
 /**
  * @brief Structure for use with the CF_CFDP_DoTick() function
  */
@@ -46,6 +56,7 @@ typedef struct CF_CFDP_Tick_args
     void (*fn)(CF_Transaction_t *, int *); /**< \brief function pointer */
     bool early_exit;                        /**< \brief early exit result */
     int cont;                              /**< \brief if 1, then re-traverse the list */
+    bool ticked;                            /**< \brief set once a transaction was ticked in this traversal */
 } CF_CFDP_Tick_args_t;
 
 /********************************************************************************/
@@ -117,6 +128,24 @@ void CF_CFDP_SetTxnStatus(CF_Transaction_t *txn, CF_TxnStatus_t txn_stat);
  */
 void CF_CFDP_SendEotPkt(CF_Transaction_t *txn);
 
+/************************************************************************/
+/** @brief Start or stop timing a transaction's wait for output.
+ *
+ * @par Description
+ *       Called with waiting set when the transaction could not get an
+ *       output buffer or was held back by flow control, and with waiting
+ *       clear once it makes progress again.  The time between the two is
+ *       added to the wait_usec total of the performance record.  Repeated
+ *       calls with the same value have no further effect.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       history must not be NULL.
+ *
+ * @param history  Pointer to the history entry of the transaction
+ * @param waiting  Whether the transaction is now waiting
+ */
+void CF_CFDP_PerfWait(CF_History_t *history, bool waiting);
+
 /************************************************************************/
 /** @brief Initialization function for the CFDP engine
  *
@@ -134,6 +163,12 @@ CFE_Status_t CF_CFDP_InitEngine(void);
 
 /************************************************************************/
 /** @brief Cycle the engine. Called once per wakeup.
+ *
+ * @par Description
+ *       When cycle_max_usec is set in the config table, the work of the
+ *       cycle stops once that much time has passed. Transaction ticks
+ *       resume from chan->cur and chan->tick_type on the next cycle,
+ *       which starts with the channel that was cut short.
  *
  * @par Assumptions, External Events, and Notes:
  *       None
@@ -141,6 +176,53 @@ CFE_Status_t CF_CFDP_InitEngine(void);
  */
 void CF_CFDP_CycleEngine(void);
 
+/************************************************************************/
+/** @brief Check whether the current engine cycle has used up its time budget.
+ *
+ * @par Description
+ *       Called between units of work (PDUs, directory reads, checksum
+ *       blocks). Once the budget is used up this keeps returning true
+ *       until the cycle ends.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       Always returns false outside of CF_CFDP_CycleEngine(), or when
+ *       cycle_max_usec is 0.
+ *
+ * @returns true if the remaining work should be left for the next cycle
+ */
+bool CF_CFDP_CycleBudgetExpired(void);
+
+/************************************************************************/
+/** @brief Add the duration of an engine cycle to the housekeeping statistics.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       None
+ *
+ * @param usec   Duration of the cycle in microseconds
+ * @param budget cycle_max_usec the cycle ran with (0 - unlimited)
+ */
+void CF_CFDP_UpdateCycleStats(uint32 usec, uint32 budget);
+
+/************************************************************************/
+/** @brief Service channels in event-driven mode between wakeups.
+ *
+ * @par Description
+ *       For every channel with rx_event_driven set, processes received
+ *       PDUs and sends the ACK, NAK, FIN and FIN-ACK responses they
+ *       lead to. Timers, NAK retransmits and new file data are left to
+ *       CF_CFDP_CycleEngine().
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       Called by the main loop every time it wakes up. Responses count
+ *       against the channel's max_outgoing_messages_per_wakeup together
+ *       with what the last CF_CFDP_CycleEngine() sent, so the limit holds
+ *       over each wakeup period however often this runs.
+ *
+ * @returns true if any channel is in event-driven mode, so the caller
+ *          should wake up more often
+ */
+bool CF_CFDP_ServiceInput(void);
+
 /************************************************************************/
 /** @brief Disables the CFDP engine and resets all state in it.
  *
@@ -167,12 +249,66 @@ void CF_CFDP_DisableEngine(void);
  * @param chan          CF channel number to use
  * @param priority      CF priority level
  * @param dest_id       Entity ID of remote receiver
+ * @param compress      Whether the file data is compressed, see #CF_TxCompress_t
  *
  * @retval #CFE_SUCCESS \copydoc CFE_SUCCESS
  * @returns CFE_SUCCESS on success. CF_ERROR on error.
  */
 CFE_Status_t CF_CFDP_TxFile(const char *src_filename, const char *dst_filename, CF_CFDP_Class_t cfdp_class, uint8 keep,
-                            uint8 chan, uint8 priority, CF_EntityId_t dest_id);
+                            uint8 chan, uint8 priority, CF_EntityId_t dest_id, uint8 compress);
+
+/************************************************************************/
+/** @brief Begin transmit of a file to several destinations.
+ *
+ * @par Description
+ *       Sets up one transaction per destination, all sharing a fan-out
+ *       group, so the file is opened, read and checksummed once however
+ *       many destinations it goes to.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       src_filename must not be NULL. dst_filename must not be NULL.
+ *       dest_ids must hold num_dest entity ids, and num_dest must not be 0.
+ *
+ * @param src_filename  Local filename
+ * @param dst_filename  Remote filename, the same at every destination
+ * @param cfdp_class    Whether to perform a class 1 or class 2 transfer
+ * @param keep          Whether to keep or delete the local file after all destinations completed
+ * @param chan          CF channel number to use
+ * @param priority      CF priority level
+ * @param dest_ids      Entity IDs of the remote receivers
+ * @param num_dest      Number of entries in dest_ids
+ *
+ * @retval #CFE_SUCCESS \copydoc CFE_SUCCESS
+ * @returns CFE_SUCCESS on success. CF_ERROR on error.
+ */
+CFE_Status_t CF_CFDP_TxFileMulti(const char *src_filename, const char *dst_filename, CF_CFDP_Class_t cfdp_class,
+                                 uint8 keep, uint8 chan, uint8 priority, const CF_EntityId_t *dest_ids,
+                                 uint8 num_dest);
+
+/************************************************************************/
+/** @brief Begin transmit of a file that is still being written.
+ *
+ * @par Description
+ *       As CF_CFDP_TxFile(), but the transaction follows the file as it
+ *       grows, and only sends the EOF once its size has stopped changing
+ *       for the channel's tx_follow_quiet_s seconds.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       src_filename must not be NULL. dst_filename must not be NULL.
+ *
+ * @param src_filename  Local filename
+ * @param dst_filename  Remote filename
+ * @param cfdp_class    Whether to perform a class 1 or class 2 transfer
+ * @param keep          Whether to keep or delete the local file after completion
+ * @param chan          CF channel number to use
+ * @param priority      CF priority level
+ * @param dest_id       Entity ID of remote receiver
+ *
+ * @retval #CFE_SUCCESS \copydoc CFE_SUCCESS
+ * @returns CFE_SUCCESS on success. CF_ERROR on error.
+ */
+CFE_Status_t CF_CFDP_TxFileFollow(const char *src_filename, const char *dst_filename, CF_CFDP_Class_t cfdp_class,
+                                  uint8 keep, uint8 chan, uint8 priority, CF_EntityId_t dest_id);
 
 /************************************************************************/
 /** @brief Begin transmit of a directory.
@@ -191,12 +327,16 @@ CFE_Status_t CF_CFDP_TxFile(const char *src_filename, const char *dst_filename,
  * @param chan          CF channel number to use
  * @param priority      CF priority level
  * @param dest_id       Entity ID of remote receiver
+ * @param max_ts        Most files sent at once, 0 for #CF_NUM_TRANSACTIONS_PER_PLAYBACK
+ * @param order         Order files are sent in, see #CF_PlaybackOrder_t
+ * @param compress      Whether the file data is compressed, see #CF_TxCompress_t
  *
  * @retval #CFE_SUCCESS \copydoc CFE_SUCCESS
  * @returns CFE_SUCCESS on success. CF_ERROR on error.
  */
 CFE_Status_t CF_CFDP_PlaybackDir(const char *src_filename, const char *dst_filename, CF_CFDP_Class_t cfdp_class,
-                                 uint8 keep, uint8 chan, uint8 priority, uint16 dest_id);
+                                 uint8 keep, uint8 chan, uint8 priority, uint16 dest_id, uint8 max_ts, uint8 order,
+                                 uint8 compress);
 
 /************************************************************************/
 /** @brief Build the PDU header in the output buffer to prepare to send a packet.
@@ -328,18 +468,51 @@ CFE_Status_t CF_CFDP_SendFin(CF_Transaction_t *txn, CF_CFDP_FinDeliveryCode_t dc
  */
 CFE_Status_t CF_CFDP_SendNak(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph);
 
+/************************************************************************/
+/** @brief Build a Prompt PDU for transmit.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL.
+ *
+ * @param txn       Pointer to the transaction object
+ * @param response  Response being solicited from the receiver (NAK or Keep Alive)
+ *
+ * @returns CFE_Status_t status code
+ * @retval CFE_SUCCESS on success.
+ * @retval CF_SEND_PDU_NO_BUF_AVAIL_ERROR if message buffer cannot be obtained.
+ */
+CFE_Status_t CF_CFDP_SendPrompt(CF_Transaction_t *txn, CF_CFDP_PromptResponse_t response);
+
+/************************************************************************/
+/** @brief Build a Keep Alive PDU for transmit.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL.
+ *
+ * @param txn       Pointer to the transaction object
+ * @param progress  File data received without gaps from the start of the file
+ *
+ * @returns CFE_Status_t status code
+ * @retval CFE_SUCCESS on success.
+ * @retval CF_SEND_PDU_NO_BUF_AVAIL_ERROR if message buffer cannot be obtained.
+ */
+CFE_Status_t CF_CFDP_SendKeepAlive(CF_Transaction_t *txn, CF_FileSize_t progress);
+
 /************************************************************************/
 /** @brief Appends a single TLV value to the logical PDU data
  *
  * This function implements common functionality between SendEof and SendFin
- * which append a TLV value specifying the faulting entity ID.
+ * which append a TLV value specifying the faulting entity ID, and SendMd
+ * which appends a message to user marking compressed file data, changed by
+ * the caller for a delta.
  *
  * @par Assumptions, External Events, and Notes:
  *       ptlv_list must not be NULL.
- *       Only CF_CFDP_TLV_TYPE_ENTITY_ID type is currently implemented
+ *       Only CF_CFDP_TLV_TYPE_ENTITY_ID and CF_CFDP_TLV_TYPE_MESSAGE_TO_USER
+ *       types are currently implemented
  *
  * @param ptlv_list TLV list from current PDU buffer.
- * @param tlv_type  Type of TLV to append.  Currently must be CF_CFDP_TLV_TYPE_ENTITY_ID.
+ * @param tlv_type  Type of TLV to append.
  */
 void CF_CFDP_AppendTlv(CF_Logical_TlvList_t *ptlv_list, CF_CFDP_TlvType_t tlv_type);
 
@@ -472,6 +645,42 @@ CFE_Status_t CF_CFDP_RecvFin(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph);
  */
 CFE_Status_t CF_CFDP_RecvNak(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph);
 
+/************************************************************************/
+/** @brief Unpack a Prompt PDU from a received message.
+ *
+ * This should only be invoked for buffers that have been identified
+ * as a prompt PDU.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL.
+ *
+ * @param txn    Pointer to the transaction state
+ * @param ph   The logical PDU buffer being received
+ *
+ * @returns integer status code
+ * @retval CFE_SUCCESS on success
+ * @retval CF_SHORT_PDU_ERROR on error
+ */
+CFE_Status_t CF_CFDP_RecvPrompt(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph);
+
+/************************************************************************/
+/** @brief Unpack a Keep Alive PDU from a received message.
+ *
+ * This should only be invoked for buffers that have been identified
+ * as a keep alive PDU.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL.
+ *
+ * @param txn    Pointer to the transaction state
+ * @param ph   The logical PDU buffer being received
+ *
+ * @returns integer status code
+ * @retval CFE_SUCCESS on success
+ * @retval CF_SHORT_PDU_ERROR on error
+ */
+CFE_Status_t CF_CFDP_RecvKeepAlive(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph);
+
 /************************************************************************/
 /** @brief Dispatch received packet to its handler.
  *
@@ -555,6 +764,20 @@ int CF_CFDP_CopyStringFromLV(char *buf, size_t buf_maxsz, const CF_Logical_Lv_t
  */
 void CF_CFDP_ArmAckTimer(CF_Transaction_t *txn);
 
+/************************************************************************/
+/** @brief Take a free chunk list from a channel.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       chan must not be NULL. The channel must have a free chunk list for
+ *       the direction, which is always so for a newly acquired transaction.
+ *
+ * @param chan   Pointer to the channel
+ * @param dir    Direction the chunk list is for
+ *
+ * @returns Pointer to the chunk list wrapper, which is no longer on the free list
+ */
+CF_ChunkWrapper_t *CF_CFDP_FindUnusedChunks(CF_Channel_t *chan, CF_Direction_t dir);
+
 /************************************************************************/
 /** @brief Receive state function to ignore a packet.
  *
@@ -611,7 +834,8 @@ CF_CListTraverse_Status_t CF_CFDP_CloseFiles(CF_CListNode_t *node, void *context
  *       First traverses all tx transactions on the active queue. If at
  *       least one is found, then it stops. Otherwise it moves a
  *       transaction on the pending queue to the active queue and
- *       tries again to find an active one.
+ *       tries again to find an active one. Then, on a channel with
+ *       tx_prefetch_depth set, the next pending sends are got ready.
  *
  * @par Assumptions, External Events, and Notes:
  *       None
@@ -630,6 +854,12 @@ void CF_CFDP_CycleTx(CF_Channel_t *chan);
  *       This function finds the first active, and then sends file
  *       data PDUs until there are no outgoing message buffers.
  *
+ *       The exception is a multi-destination send, whose members are all
+ *       active together. Each of them is run for one step and the
+ *       traversal goes on to the next, so the members go through the
+ *       file in step. CF_CFDP_CycleTx() repeats the traversal while
+ *       ran_fanout is set and there is room to send.
+ *
  * @par Assumptions, External Events, and Notes:
  *       node must not be NULL. Context must not be NULL.
  *
@@ -638,10 +868,51 @@ void CF_CFDP_CycleTx(CF_Channel_t *chan);
  *
  * @returns integer traversal code
  * @retval CF_CLIST_EXIT when it's found, which terminates list traversal
- * @retval CF_CLIST_CONT when it's isn't found, which causes list traversal to continue
+ * @retval CF_CLIST_CONT when it's isn't found, or is a fan-out member, which causes list traversal to continue
  */
 CF_CListTraverse_Status_t CF_CFDP_CycleTxFirstActive(CF_CListNode_t *node, void *context);
 
+/************************************************************************/
+/** @brief List traversal function that moves the pending members of a fan-out group to TXA.
+ *
+ * @par Description
+ *       Called when the first transaction of a multi-destination send is
+ *       started, so that all of its destinations are sent together.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       node must not be NULL. context must be the fan-out group.
+ *
+ * @param node    Pointer to list node
+ * @param context Pointer to CF_FanOut_t object
+ *
+ * @returns integer traversal code
+ * @retval CF_CLIST_CONT always, so every pending transaction is looked at
+ */
+CF_CListTraverse_Status_t CF_CFDP_ActivateFanOut(CF_CListNode_t *node, void *context);
+
+/************************************************************************/
+/** @brief List traversal function that gets the next pending tx ready.
+ *
+ * This helper is used in conjunction with CF_CList_Traverse().
+ *
+ * @par Description
+ *       Looks at the pending transactions in the order they will be made
+ *       active, and has each send from the start of a file that is not
+ *       open yet opened and read ahead, until the depth is reached, the
+ *       read ahead buffers run out, or the cycle is out of time.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       node must not be NULL. Context must not be NULL.
+ *
+ * @param node    Pointer to list node
+ * @param context Pointer to CF_CFDP_PrefetchTx_args_t object (passed through)
+ *
+ * @returns integer traversal code
+ * @retval CF_CLIST_EXIT when there is nothing more to do, which terminates list traversal
+ * @retval CF_CLIST_CONT otherwise, which causes list traversal to continue
+ */
+CF_CListTraverse_Status_t CF_CFDP_PrefetchTxNext(CF_CListNode_t *node, void *context);
+
 /************************************************************************/
 /** @brief Call R and then S tick functions for all active transactions.
  *
@@ -657,12 +928,38 @@ CF_CListTraverse_Status_t CF_CFDP_CycleTxFirstActive(CF_CListNode_t *node, void
  */
 void CF_CFDP_TickTransactions(CF_Channel_t *chan);
 
+/************************************************************************/
+/** @brief Send pending responses for all active transactions.
+ *
+ * @par Description
+ *       Traverses all transactions in the RX and TXW queues, and calls
+ *       their respond functions. Stops when no more output messages are
+ *       available. The point where tick processing will resume on the
+ *       next wakeup is kept.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       chan must not be NULL.
+ *
+ * @param chan Channel to respond on
+ */
+void CF_CFDP_RespondTransactions(CF_Channel_t *chan);
+
 /************************************************************************/
 /** @brief Step each active playback directory.
  *
  * @par Description
  *       Check if a playback directory needs iterated, and if so does, and
- *       if a valid file is found initiates playback on it.
+ *       if a valid file is found initiates playback on it. The directory is
+ *       read up to the channel's directory reads per wakeup into the
+ *       playback's work list. In name order the list is sorted and sent
+ *       each time it fills, and the directory is read on from there. In
+ *       time or size order each entry is stat'd, the whole directory is
+ *       read and the first entries in that order are kept; if the list was
+ *       full, once it is sent the directory is read again for the entries
+ *       after the last one sent. Files are sent as many at once as the
+ *       playback allows. A file is only started while the channel has a
+ *       free transaction that is not held back for receives or commanded
+ *       sends.
  *
  * @par Assumptions, External Events, and Notes:
  *       chan must not be NULL, pb must not be NULL.
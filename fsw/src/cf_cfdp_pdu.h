@@ -231,6 +231,20 @@ typedef enum
     CF_CFDP_AckTxnStatus_INVALID      = 4,
 } CF_CFDP_AckTxnStatus_t;
 
+/**
+ * @brief Values for "response required"
+ *
+ * This enum is pertinent to the Prompt PDU type, defines the
+ * response the receiver is asked for.
+ *
+ * Defined per section 5.2.7 / table 5-12 of CCSDS 727.0-B-5
+ */
+typedef enum
+{
+    CF_CFDP_PromptResponse_NAK        = 0,
+    CF_CFDP_PromptResponse_KEEP_ALIVE = 1,
+} CF_CFDP_PromptResponse_t;
+
 /**
  * @brief Values for "finished delivery code"
  *
@@ -344,6 +358,26 @@ typedef struct CF_CFDP_PduNak
     CF_CFDP_uint32_t scope_end;
 } CF_CFDP_PduNak_t;
 
+/**
+ * @brief Structure representing CFDP Prompt PDU
+ *
+ * Defined per section 5.2.7 / table 5-12 of CCSDS 727.0-B-5
+ */
+typedef struct CF_CFDP_PduPrompt
+{
+    CF_CFDP_uint8_t response_required;
+} CF_CFDP_PduPrompt_t;
+
+/**
+ * @brief Structure representing CFDP Keep Alive PDU
+ *
+ * Defined per section 5.2.8 / table 5-13 of CCSDS 727.0-B-5
+ */
+typedef struct CF_CFDP_PduKeepAlive
+{
+    CF_CFDP_uint32_t progress;
+} CF_CFDP_PduKeepAlive_t;
+
 /**
  * @brief Structure representing CFDP Metadata PDU
  *
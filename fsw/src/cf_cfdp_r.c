@@ -30,6 +30,7 @@
 #include "cf_perfids.h"
 #include "cf_cfdp.h"
 #include "cf_utils.h"
+#include "cf_trace.h"
 
 #include "cf_cfdp_r.h"
 #include "cf_cfdp_dispatch.h"
@@ -164,6 +165,7 @@ void CF_CFDP_R2_Complete(CF_Transaction_t *txn, int ok_to_send_nak)
             else
             {
                 txn->flags.rx.send_nak = true;
+                txn->flags.rx.prompted = false; /* this NAK covers the whole file */
             }
         }
 
@@ -190,12 +192,15 @@ void CF_CFDP_R2_Complete(CF_Transaction_t *txn, int ok_to_send_nak)
 CFE_Status_t CF_CFDP_R_ProcessFd(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
 {
     const CF_Logical_PduFileDataHeader_t *fd;
+    CF_RxStaging_t *                      staging;
     int32                                 fret;
     CFE_Status_t                          ret;
+    OS_time_t                             started;
 
     /* this function is only entered for data PDUs */
-    fd  = &ph->int_header.fd;
-    ret = CFE_SUCCESS;
+    fd      = &ph->int_header.fd;
+    staging = txn->state_data.receive.staging;
+    ret     = CFE_SUCCESS;
 
     /*
      * NOTE: The decode routine should have left a direct pointer to the data and actual data length
@@ -203,39 +208,69 @@ CFE_Status_t CF_CFDP_R_ProcessFd(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *
      * adjustments here, just write it.
      */
 
-    if (txn->state_data.receive.cached_pos != fd->offset)
+    if (staging &&
+        (fd->data_len > sizeof(staging->data) || fd->offset > (sizeof(staging->data) - fd->data_len)))
     {
-        fret = CF_WrappedLseek(txn->fd, fd->offset, OS_SEEK_SET);
-        if (fret != fd->offset)
+        /* this data is too far into the file to stage, so move what is staged to the temp file and carry on there */
+        CFE_EVS_SendEvent(CF_CFDP_R_TEMP_FILE_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "CF R%d(%lu:%lu): making temp file %s for transaction without MD",
+                          (txn->state == CF_TxnState_R2), (unsigned long)txn->history->src_eid,
+                          (unsigned long)txn->history->seq_num, txn->history->fnames.dst_filename);
+        ret     = CF_CFDP_R2_StagingFlush(txn);
+        staging = NULL;
+    }
+
+    if (staging)
+    {
+        memcpy(&staging->data[fd->offset], fd->data_ptr, fd->data_len);
+        if (staging->size < (fd->offset + fd->data_len))
         {
-            CFE_EVS_SendEvent(CF_CFDP_R_SEEK_FD_ERR_EID, CFE_EVS_EventType_ERROR,
-                              "CF R%d(%lu:%lu): failed to seek offset %ld, got %ld", (txn->state == CF_TxnState_R2),
-                              (unsigned long)txn->history->src_eid, (unsigned long)txn->history->seq_num,
-                              (long)fd->offset, (long)fret);
-            CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_FILE_SIZE_ERROR);
-            ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_seek;
-            ret = CF_ERROR; /* connection will reset in caller */
+            staging->size = fd->offset + fd->data_len;
         }
+        CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.file_data_bytes += fd->data_len;
+        txn->history->perf.file_bytes += fd->data_len;
     }
-
-    if (ret != CF_ERROR)
+    else if (ret != CF_ERROR)
     {
-        fret = CF_WrappedWrite(txn->fd, fd->data_ptr, fd->data_len);
-        if (fret != fd->data_len)
+        OS_GetLocalTime(&started);
+
+        if (txn->state_data.receive.cached_pos != fd->offset)
         {
-            CFE_EVS_SendEvent(CF_CFDP_R_WRITE_ERR_EID, CFE_EVS_EventType_ERROR,
-                              "CF R%d(%lu:%lu): OS_write expected %ld, got %ld", (txn->state == CF_TxnState_R2),
-                              (unsigned long)txn->history->src_eid, (unsigned long)txn->history->seq_num,
-                              (long)fd->data_len, (long)fret);
-            CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_FILESTORE_REJECTION);
-            ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_write;
-            ret = CF_ERROR; /* connection will reset in caller */
+            fret = CF_WrappedLseek(txn->fd, fd->offset, OS_SEEK_SET);
+            if (fret != fd->offset)
+            {
+                CFE_EVS_SendEvent(CF_CFDP_R_SEEK_FD_ERR_EID, CFE_EVS_EventType_ERROR,
+                                  "CF R%d(%lu:%lu): failed to seek offset %ld, got %ld",
+                                  (txn->state == CF_TxnState_R2), (unsigned long)txn->history->src_eid,
+                                  (unsigned long)txn->history->seq_num, (long)fd->offset, (long)fret);
+                CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_FILE_SIZE_ERROR);
+                ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_seek;
+                ret = CF_ERROR; /* connection will reset in caller */
+            }
         }
-        else
+
+        if (ret != CF_ERROR)
         {
-            txn->state_data.receive.cached_pos = fd->data_len + fd->offset;
-            CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.file_data_bytes += fd->data_len;
+            fret = CF_WrappedWrite(txn->fd, fd->data_ptr, fd->data_len);
+            if (fret != fd->data_len)
+            {
+                CFE_EVS_SendEvent(CF_CFDP_R_WRITE_ERR_EID, CFE_EVS_EventType_ERROR,
+                                  "CF R%d(%lu:%lu): OS_write expected %ld, got %ld", (txn->state == CF_TxnState_R2),
+                                  (unsigned long)txn->history->src_eid, (unsigned long)txn->history->seq_num,
+                                  (long)fd->data_len, (long)fret);
+                CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_FILESTORE_REJECTION);
+                ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_write;
+                ret = CF_ERROR; /* connection will reset in caller */
+            }
+            else
+            {
+                txn->state_data.receive.cached_pos = fd->data_len + fd->offset;
+                CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.file_data_bytes += fd->data_len;
+                txn->history->perf.file_bytes += fd->data_len;
+            }
         }
+
+        CF_AddElapsedUsec(&txn->history->perf.io_usec, started);
     }
 
     return ret;
@@ -258,7 +293,12 @@ CFE_Status_t CF_CFDP_R_SubstateRecvEof(CF_Transaction_t *txn, CF_Logical_PduBuff
         eof = &ph->int_header.eof;
 
         /* only check size if MD received, otherwise it's still OK */
-        if (txn->flags.rx.md_recv && (eof->size != txn->fsize))
+        if (txn->flags.rx.md_recv && txn->fsize == 0)
+        {
+            /* the metadata gave the size as unbounded, so it is the EOF that gives it */
+            txn->fsize = eof->size;
+        }
+        else if (txn->flags.rx.md_recv && (eof->size != txn->fsize))
         {
             CFE_EVS_SendEvent(CF_CFDP_R_SIZE_MISMATCH_ERR_EID, CFE_EVS_EventType_ERROR,
                               "CF R%d(%lu:%lu): EOF file size mismatch: got %lu expected %lu",
@@ -304,6 +344,20 @@ void CF_CFDP_R1_SubstateRecvEof(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *p
         {
             /* successfully processed the file */
             txn->keep = 1; /* save the file */
+
+            if (txn->flags.com.compressed)
+            {
+                /* class 1 ends here, so it is all expanded at once */
+                CF_CFDP_R_ExpandChunk(txn, txn->fsize);
+            }
+            else if (txn->flags.com.delta)
+            {
+                CF_CFDP_R_ApplyDelta(txn, UINT32_MAX);
+            }
+            else if (txn->flags.com.bundle)
+            {
+                CF_CFDP_R_Unbundle(txn, UINT32_MAX);
+            }
         }
         /* if file failed to process, there's nothing to do. CF_CFDP_R_CheckCrc() generates an event on failure */
     }
@@ -378,7 +432,8 @@ void CF_CFDP_R2_SubstateRecvEof(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *p
  *-----------------------------------------------------------------*/
 void CF_CFDP_R1_SubstateRecvFileData(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
 {
-    int ret;
+    int       ret;
+    OS_time_t started;
 
     /* got file data PDU? */
     ret = CF_CFDP_RecvFd(txn, ph);
@@ -390,7 +445,9 @@ void CF_CFDP_R1_SubstateRecvFileData(CF_Transaction_t *txn, CF_Logical_PduBuffer
     if (ret == CFE_SUCCESS)
     {
         /* class 1 digests CRC */
+        OS_GetLocalTime(&started);
         CF_CRC_Digest(&txn->crc, ph->int_header.fd.data_ptr, ph->int_header.fd.data_len);
+        CF_AddElapsedUsec(&txn->history->perf.crc_usec, started);
     }
     else
     {
@@ -488,8 +545,10 @@ CFE_Status_t CF_CFDP_R_SubstateSendNak(CF_Transaction_t *txn)
         CF_CFDP_ConstructPduHeader(txn, CF_CFDP_FileDirective_NAK, txn->history->peer_eid,
                                    CF_AppData.config_table->local_eid, 1, txn->history->seq_num, 1);
     CF_Logical_PduNak_t *nak;
+    const CF_Chunk_t *   last;
     CFE_Status_t         sret;
     uint32               cret;
+    uint32               total;
     CFE_Status_t         ret = CF_ERROR;
 
     if (ph)
@@ -501,14 +560,31 @@ CFE_Status_t CF_CFDP_R_SubstateSendNak(CF_Transaction_t *txn)
             /* we have metadata, so send valid NAK */
             CF_GapComputeArgs_t args = {txn, nak};
 
+            total = txn->fsize;
+            if (txn->flags.rx.prompted)
+            {
+                /* answering a prompt before EOF, so only gaps below the furthest data received count */
+                total = 0;
+                if (txn->chunks->chunks.count)
+                {
+                    last  = &txn->chunks->chunks.chunks[txn->chunks->chunks.count - 1];
+                    total = last->offset + last->size;
+                }
+            }
+
             nak->scope_start = 0;
             cret             = CF_ChunkList_ComputeGaps(&txn->chunks->chunks,
                                             (txn->chunks->chunks.count < txn->chunks->chunks.max_chunks)
                                                             ? txn->chunks->chunks.max_chunks
                                                             : (txn->chunks->chunks.max_chunks - 1),
-                                            txn->fsize, 0, CF_CFDP_R2_GapCompute, &args);
+                                            total, 0, CF_CFDP_R2_GapCompute, &args);
 
-            if (!cret)
+            if (!cret && txn->flags.rx.prompted)
+            {
+                /* nothing missing so far, so there is nothing to NAK */
+                ret = CFE_SUCCESS;
+            }
+            else if (!cret)
             {
                 /* no gaps left, so go ahead and check for completion */
                 txn->flags.rx.complete = true; /* we know md was received, and there's no gaps -- it's complete */
@@ -517,7 +593,22 @@ CFE_Status_t CF_CFDP_R_SubstateSendNak(CF_Transaction_t *txn)
             else
             {
                 /* gaps are present, so let's send the NAK PDU */
-                nak->scope_end            = 0;
+                nak->scope_end = 0;
+                if (txn->flags.rx.partial || txn->flags.rx.prompted)
+                {
+                    /* the sender may skip new data within the scope that is not NAK'd, so unless every
+                     * gap is certain to be listed, the scope ends where the listed segments do */
+                    if (cret < CF_PDU_MAX_SEGMENTS && txn->chunks->chunks.count < txn->chunks->chunks.max_chunks)
+                    {
+                        nak->scope_end = total;
+                    }
+                    else
+                    {
+                        nak->scope_end =
+                            nak->segment_list.segments[nak->segment_list.num_segments - 1].offset_end;
+                    }
+                }
+
                 sret                      = CF_CFDP_SendNak(txn, ph);
                 txn->flags.rx.fd_nak_sent = true; /* latch that at least one NAK has been sent requesting filedata */
                 CF_Assert(sret != CF_SEND_PDU_ERROR); /* NOTE: this CF_Assert is here because CF_CFDP_SendNak()
@@ -526,6 +617,8 @@ CFE_Status_t CF_CFDP_R_SubstateSendNak(CF_Transaction_t *txn)
                 if (sret == CFE_SUCCESS)
                 {
                     CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.sent.nak_segment_requests += cret;
+                    ++txn->history->perf.nak_rounds;
+                    txn->history->perf.nak_segments += cret;
                     ret = CFE_SUCCESS;
                 }
             }
@@ -549,11 +642,17 @@ CFE_Status_t CF_CFDP_R_SubstateSendNak(CF_Transaction_t *txn)
                                                     return CF_SEND_PDU_ERROR */
             if (sret == CFE_SUCCESS)
             {
+                ++txn->history->perf.nak_rounds;
                 ret = CFE_SUCCESS;
             }
         }
     }
 
+    if (ret == CFE_SUCCESS)
+    {
+        txn->flags.rx.prompted = false;
+    }
+
     return ret;
 }
 
@@ -578,17 +677,37 @@ void CF_CFDP_R_Init(CF_Transaction_t *txn)
             snprintf(txn->history->fnames.dst_filename, sizeof(txn->history->fnames.dst_filename) - 1, "%.*s/%lu:%lu.tmp",
                      CF_FILENAME_MAX_PATH - 1, CF_AppData.config_table->tmp_dir, 
                      (unsigned long)txn->history->src_eid, (unsigned long)txn->history->seq_num);
-            CFE_EVS_SendEvent(CF_CFDP_R_TEMP_FILE_INF_EID, CFE_EVS_EventType_INFORMATION,
-                              "CF R%d(%lu:%lu): making temp file %s for transaction without MD",
-                              (txn->state == CF_TxnState_R2), (unsigned long)txn->history->src_eid,
-                              (unsigned long)txn->history->seq_num, txn->history->fnames.dst_filename);
+
+            /* the temp filename is still needed if staged data has to be spilled to it later */
+            if (!CF_CFDP_R2_StagingAcquire(txn))
+            {
+                CFE_EVS_SendEvent(CF_CFDP_R_TEMP_FILE_INF_EID, CFE_EVS_EventType_INFORMATION,
+                                  "CF R%d(%lu:%lu): making temp file %s for transaction without MD",
+                                  (txn->state == CF_TxnState_R2), (unsigned long)txn->history->src_eid,
+                                  (unsigned long)txn->history->seq_num, txn->history->fnames.dst_filename);
+            }
         }
 
         CF_CFDP_ArmAckTimer(txn);
+        CF_Timer_InitRelSec(&txn->state_data.receive.r2.keep_alive_timer,
+                            CF_AppData.config_table->chan[txn->chan_num].keep_alive_s);
     }
 
-    ret = CF_WrappedOpenCreate(&txn->fd, txn->history->fnames.dst_filename, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE,
-                               OS_READ_WRITE);
+    if (txn->state_data.receive.staging)
+    {
+        /* no file is opened until the staged data is flushed */
+        ret = CFE_SUCCESS;
+    }
+    else if (txn->state == CF_TxnState_R2 && txn->flags.rx.md_recv && CF_Ckpt_ClaimPartial(txn))
+    {
+        /* the partial file kept from an earlier attempt is already open */
+        ret = CFE_SUCCESS;
+    }
+    else
+    {
+        ret = CF_WrappedOpenCreate(&txn->fd, txn->history->fnames.dst_filename,
+                                   OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_READ_WRITE);
+    }
     if (ret < 0)
     {
         CFE_EVS_SendEvent(CF_CFDP_R_CREAT_ERR_EID, CFE_EVS_EventType_ERROR,
@@ -612,6 +731,106 @@ void CF_CFDP_R_Init(CF_Transaction_t *txn)
     }
 }
 
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_r.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_CFDP_R2_StagingAcquire(CF_Transaction_t *txn)
+{
+    CF_RxStaging_t *staging;
+    int             i;
+
+    txn->state_data.receive.staging = NULL;
+
+    if (CF_AppData.config_table->chan[txn->chan_num].rx_staging_enabled)
+    {
+        for (i = 0; i < CF_NUM_RX_STAGING_BUFFERS; ++i)
+        {
+            staging = &CF_AppData.engine.rx_staging[i];
+            if (!staging->txn)
+            {
+                /* clear it, so gaps that are flushed before being filled never carry another file's data */
+                memset(staging, 0, sizeof(*staging));
+                staging->txn                    = txn;
+                txn->state_data.receive.staging = staging;
+                break;
+            }
+        }
+    }
+
+    return (txn->state_data.receive.staging != NULL);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_r.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_CFDP_R2_StagingFlush(CF_Transaction_t *txn)
+{
+    CF_RxStaging_t *staging = txn->state_data.receive.staging;
+    int32           fret;
+    CFE_Status_t    ret = CFE_SUCCESS;
+
+    fret = CF_WrappedOpenCreate(&txn->fd, txn->history->fnames.dst_filename,
+                                OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_READ_WRITE);
+    if (fret < 0)
+    {
+        CFE_EVS_SendEvent(CF_CFDP_R_CREAT_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "CF R%d(%lu:%lu): failed to create file %s for writing, error=%ld",
+                          (txn->state == CF_TxnState_R2), (unsigned long)txn->history->src_eid,
+                          (unsigned long)txn->history->seq_num, txn->history->fnames.dst_filename, (long)fret);
+        ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_open;
+        txn->fd = OS_OBJECT_ID_UNDEFINED; /* just in case */
+        ret     = CF_ERROR;
+    }
+    else if (staging->size)
+    {
+        /* one write covers all staged data; any gaps are zero and get overwritten once retransmitted */
+        fret = CF_WrappedWrite(txn->fd, staging->data, staging->size);
+        if (fret != staging->size)
+        {
+            CFE_EVS_SendEvent(CF_CFDP_R_WRITE_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "CF R%d(%lu:%lu): OS_write expected %ld, got %ld", (txn->state == CF_TxnState_R2),
+                              (unsigned long)txn->history->src_eid, (unsigned long)txn->history->seq_num,
+                              (long)staging->size, (long)fret);
+            ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_write;
+            ret = CF_ERROR;
+        }
+    }
+
+    if (ret == CFE_SUCCESS)
+    {
+        txn->state_data.receive.cached_pos = staging->size;
+    }
+    else
+    {
+        CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_FILESTORE_REJECTION);
+    }
+
+    CF_CFDP_R2_StagingRelease(txn);
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_r.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_R2_StagingRelease(CF_Transaction_t *txn)
+{
+    if (txn->state_data.receive.staging)
+    {
+        txn->state_data.receive.staging->txn = NULL;
+        txn->state_data.receive.staging      = NULL;
+    }
+}
+
 /*----------------------------------------------------------------
  *
  * Application-scope internal function
@@ -627,6 +846,7 @@ CFE_Status_t CF_CFDP_R2_CalcCrcChunk(CF_Transaction_t *txn)
     int          fret;
     CFE_Status_t ret;
     bool         success = true;
+    OS_time_t    started;
 
     memset(buf, 0, sizeof(buf));
 
@@ -638,8 +858,10 @@ CFE_Status_t CF_CFDP_R2_CalcCrcChunk(CF_Transaction_t *txn)
         CF_CRC_Start(&txn->crc);
     }
 
+    /* at least one block is done per call, so the CRC always makes progress */
     while ((count_bytes < CF_AppData.config_table->rx_crc_calc_bytes_per_wakeup) &&
-           (txn->state_data.receive.r2.rx_crc_calc_bytes < txn->fsize))
+           (txn->state_data.receive.r2.rx_crc_calc_bytes < txn->fsize) &&
+           (count_bytes == 0 || !CF_CFDP_CycleBudgetExpired()))
     {
         want_offs_size = txn->state_data.receive.r2.rx_crc_calc_bytes + sizeof(buf);
 
@@ -652,6 +874,8 @@ CFE_Status_t CF_CFDP_R2_CalcCrcChunk(CF_Transaction_t *txn)
             read_size = sizeof(buf);
         }
 
+        OS_GetLocalTime(&started);
+
         if (txn->state_data.receive.cached_pos != txn->state_data.receive.r2.rx_crc_calc_bytes)
         {
             fret = CF_WrappedLseek(txn->fd, txn->state_data.receive.r2.rx_crc_calc_bytes, OS_SEEK_SET);
@@ -681,7 +905,12 @@ CFE_Status_t CF_CFDP_R2_CalcCrcChunk(CF_Transaction_t *txn)
             break;
         }
 
+        CF_AddElapsedUsec(&txn->history->perf.io_usec, started);
+
+        OS_GetLocalTime(&started);
         CF_CRC_Digest(&txn->crc, buf, read_size);
+        CF_AddElapsedUsec(&txn->history->perf.crc_usec, started);
+
         txn->state_data.receive.r2.rx_crc_calc_bytes += read_size;
         txn->state_data.receive.cached_pos = txn->state_data.receive.r2.rx_crc_calc_bytes;
         count_bytes += read_size;
@@ -718,57 +947,169 @@ CFE_Status_t CF_CFDP_R2_CalcCrcChunk(CF_Transaction_t *txn)
  * See description in cf_cfdp_r.h for argument/return detail
  *
  *-----------------------------------------------------------------*/
-CFE_Status_t CF_CFDP_R2_SubstateSendFin(CF_Transaction_t *txn)
+CFE_Status_t CF_CFDP_R_ExpandChunk(CF_Transaction_t *txn, uint32 max_bytes)
 {
-    CFE_Status_t sret;
-    CFE_Status_t ret = CFE_SUCCESS;
+    CF_Compress_t *work        = &CF_AppData.engine.compress;
+    uint8 *        packed      = &work->packed[CF_COMPRESS_BLOCK_HDR_SIZE];
+    uint32         count_bytes = 0;
+    uint32         packed_len  = 0;
+    uint32         raw_len     = 0;
+    int32          fret;
+    CF_TxnStatus_t status = CF_TxnStatus_NO_ERROR;
+    CFE_Status_t   ret    = CF_ERROR;
+    char           zname[OS_MAX_PATH_LEN];
+    OS_time_t      started;
+
+    CF_Compress_GetFilename(zname, sizeof(zname), txn->history->src_eid, txn->history->seq_num);
+
+    if (!OS_ObjectIdDefined(txn->zfd))
+    {
+        fret = CF_WrappedOpenCreate(&txn->zfd, zname, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY);
+        if (fret < 0)
+        {
+            ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_open;
+            txn->zfd = OS_OBJECT_ID_UNDEFINED; /* just in case */
+            status   = CF_TxnStatus_FILESTORE_REJECTION;
+        }
+        else
+        {
+            txn->zoffs    = 0;
+            txn->raw_size = 0;
+        }
+    }
 
-    if (!CF_TxnStatus_IsError(txn->history->txn_stat) && !txn->flags.com.crc_calc)
+    while (status == CF_TxnStatus_NO_ERROR && txn->zoffs < txn->fsize && count_bytes < max_bytes)
     {
-        /* no error, and haven't checked CRC -- so start checking it */
-        if (CF_CFDP_R2_CalcCrcChunk(txn))
+        if (txn->state_data.receive.cached_pos != txn->zoffs &&
+            CF_WrappedLseek(txn->fd, txn->zoffs, OS_SEEK_SET) != txn->zoffs)
         {
-            ret = CF_ERROR; /* signal to caller to re-enter next tick */
+            ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_seek;
+            status = CF_TxnStatus_FILESTORE_REJECTION;
+        }
+        else if ((txn->fsize - txn->zoffs) < CF_COMPRESS_BLOCK_HDR_SIZE)
+        {
+            status = CF_TxnStatus_INVALID_FILE_STRUCTURE;
+        }
+        else if (CF_WrappedRead(txn->fd, work->packed, CF_COMPRESS_BLOCK_HDR_SIZE) != CF_COMPRESS_BLOCK_HDR_SIZE)
+        {
+            ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_read;
+            status = CF_TxnStatus_FILESTORE_REJECTION;
+        }
+        else if (!CF_Compress_ParseHeader(work->packed, &packed_len, &raw_len) ||
+                 packed_len > (txn->fsize - txn->zoffs - CF_COMPRESS_BLOCK_HDR_SIZE))
+        {
+            status = CF_TxnStatus_INVALID_FILE_STRUCTURE;
+        }
+        else if (CF_WrappedRead(txn->fd, packed, packed_len) != packed_len)
+        {
+            ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_read;
+            status = CF_TxnStatus_FILESTORE_REJECTION;
+        }
+        else
+        {
+            txn->zoffs += CF_COMPRESS_BLOCK_HDR_SIZE + packed_len;
+            txn->state_data.receive.cached_pos = txn->zoffs;
+            count_bytes += CF_COMPRESS_BLOCK_HDR_SIZE + packed_len;
+
+            OS_GetLocalTime(&started);
+            if (!CF_Compress_Unpack(packed, packed_len, work->raw, raw_len))
+            {
+                status = CF_TxnStatus_INVALID_FILE_STRUCTURE;
+            }
+            CF_AddElapsedUsec(&txn->history->perf.zip_usec, started);
+        }
+
+        if (status == CF_TxnStatus_NO_ERROR)
+        {
+            if (CF_WrappedWrite(txn->zfd, work->raw, raw_len) != raw_len)
+            {
+                ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_write;
+                status = CF_TxnStatus_FILESTORE_REJECTION;
+            }
+            else
+            {
+                txn->raw_size += raw_len;
+            }
         }
     }
 
-    if (ret != CF_ERROR)
+    if (status == CF_TxnStatus_NO_ERROR && txn->zoffs == txn->fsize)
     {
-        sret = CF_CFDP_SendFin(txn, txn->state_data.receive.r2.dc, txn->state_data.receive.r2.fs,
-                               CF_TxnStatus_To_ConditionCode(txn->history->txn_stat));
-        CF_Assert(sret != CF_SEND_PDU_ERROR); /* CF_CFDP_SendFin does not return CF_SEND_PDU_ERROR */
-        txn->state_data.receive.sub_state =
-            CF_RxSubState_WAIT_FOR_FIN_ACK; /* whether or not FIN send successful, ok to transition state */
-        if (sret != CFE_SUCCESS)
+        /* the expanded file takes the place of what was received */
+        CF_WrappedClose(txn->zfd);
+        txn->zfd = OS_OBJECT_ID_UNDEFINED;
+        CF_WrappedClose(txn->fd);
+        txn->fd = OS_OBJECT_ID_UNDEFINED;
+
+        if (CF_WrappedRename(zname, txn->history->fnames.dst_filename) != OS_SUCCESS)
         {
-            ret = CF_ERROR;
+            status = CF_TxnStatus_FILESTORE_REJECTION;
+        }
+        else
+        {
+            txn->flags.rx.expanded = true;
+            ret                    = CFE_SUCCESS;
+        }
+    }
+
+    if (status != CF_TxnStatus_NO_ERROR)
+    {
+        CFE_EVS_SendEvent(CF_CFDP_R_EXPAND_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "CF R%d(%lu:%lu): failed to expand compressed file data at offset %lu, status %d",
+                          (txn->state == CF_TxnState_R2), (unsigned long)txn->history->src_eid,
+                          (unsigned long)txn->history->seq_num, (unsigned long)txn->zoffs, (int)status);
+        CF_CFDP_SetTxnStatus(txn, status);
+        txn->keep = 0;
+        if (txn->state == CF_TxnState_R2)
+        {
+            txn->state_data.receive.r2.fs = CF_CFDP_FinFileStatus_DISCARDED;
         }
     }
 
-    /* if no message, then try again next time */
     return ret;
 }
 
 /*----------------------------------------------------------------
  *
- * Application-scope internal function
- * See description in cf_cfdp_r.h for argument/return detail
+ * Internal helper routine only, not part of API.
+ *
+ * Appends len bytes from the current position of from_fd to the file a
+ * delta is being applied into.
  *
  *-----------------------------------------------------------------*/
-void CF_CFDP_R2_Recv_fin_ack(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
+static CF_TxnStatus_t CF_CFDP_R_DeltaCopy(CF_Transaction_t *txn, osal_id_t from_fd, uint32 len)
 {
-    if (!CF_CFDP_RecvAck(txn, ph))
-    {
-        /* got fin-ack, so time to close the state */
-        CF_CFDP_R2_Reset(txn);
-    }
-    else
+    uint8 *        copy   = CF_AppData.engine.delta.copy;
+    CF_TxnStatus_t status = CF_TxnStatus_NO_ERROR;
+    uint32         n;
+
+    while (status == CF_TxnStatus_NO_ERROR && len)
     {
-        CFE_EVS_SendEvent(CF_CFDP_R_PDU_FINACK_ERR_EID, CFE_EVS_EventType_ERROR, "CF R%d(%lu:%lu): invalid fin-ack",
-                          (txn->state == CF_TxnState_R2), (unsigned long)txn->history->src_eid,
-                          (unsigned long)txn->history->seq_num);
-        ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.error;
+        n = len;
+        if (n > sizeof(CF_AppData.engine.delta.copy))
+        {
+            n = sizeof(CF_AppData.engine.delta.copy);
+        }
+
+        if (CF_WrappedRead(from_fd, copy, n) != n)
+        {
+            ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_read;
+            status = CF_TxnStatus_FILESTORE_REJECTION;
+        }
+        else if (CF_WrappedWrite(txn->zfd, copy, n) != n)
+        {
+            ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_write;
+            status = CF_TxnStatus_FILESTORE_REJECTION;
+        }
+        else
+        {
+            CF_CRC_Digest(&txn->zcrc, copy, n);
+            txn->raw_size += n;
+            len -= n;
+        }
     }
+
+    return status;
 }
 
 /*----------------------------------------------------------------
@@ -777,34 +1118,647 @@ void CF_CFDP_R2_Recv_fin_ack(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
  * See description in cf_cfdp_r.h for argument/return detail
  *
  *-----------------------------------------------------------------*/
-void CF_CFDP_R2_RecvMd(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
+CFE_Status_t CF_CFDP_R_ApplyDelta(CF_Transaction_t *txn, uint32 max_bytes)
 {
-    char  fname[CF_FILENAME_MAX_LEN];
-    int   status;
-    int32 ret;
-    bool  success = true;
-
-    /* it isn't an error to get another MD PDU, right? */
-    if (!txn->flags.rx.md_recv)
+    uint8            op[CF_DELTA_COPY_SIZE];
+    uint32           count_bytes = 0;
+    uint32           op_size;
+    uint32           avail;
+    uint32           arg;
+    uint32           count;
+    uint32           len     = 0;
+    osal_id_t        base_fd = OS_OBJECT_ID_UNDEFINED;
+    CF_DeltaHeader_t hdr;
+    CF_Crc_t         crc;
+    CF_TxnStatus_t   status = CF_TxnStatus_NO_ERROR;
+    CFE_Status_t     ret    = CF_ERROR;
+    char             zname[OS_MAX_PATH_LEN];
+    char             bname[OS_MAX_PATH_LEN];
+    OS_time_t        started;
+
+    CF_Delta_GetFilename(zname, sizeof(zname), txn->history->src_eid, txn->history->seq_num, CF_DELTA_TEMP_EXT);
+    CF_Delta_GetFilename(bname, sizeof(bname), txn->history->src_eid, txn->history->seq_num, CF_DELTA_BASE_EXT);
+
+    /* the header is small, so it is read again each time rather than kept */
+    if (txn->fsize < CF_DELTA_HDR_SIZE)
     {
-        /* NOTE: txn->flags.rx.md_recv always 1 in R1, so this is R2 only */
-        /* parse the md PDU. this will overwrite the transaction's history, which contains our filename. so let's
-         * save the filename in a local buffer so it can be used with OS_mv upon successful parsing of
-         * the md PDU */
+        status = CF_TxnStatus_INVALID_FILE_STRUCTURE;
+    }
+    else if (CF_WrappedLseek(txn->fd, 0, OS_SEEK_SET) != 0)
+    {
+        ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_seek;
+        status = CF_TxnStatus_FILESTORE_REJECTION;
+    }
+    else if (CF_WrappedRead(txn->fd, CF_AppData.engine.delta.copy, CF_DELTA_HDR_SIZE) != CF_DELTA_HDR_SIZE)
+    {
+        ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_read;
+        status = CF_TxnStatus_FILESTORE_REJECTION;
+    }
+    else if (!CF_Delta_ParseHeader(CF_AppData.engine.delta.copy, &hdr))
+    {
+        status = CF_TxnStatus_INVALID_FILE_STRUCTURE;
+    }
+    else
+    {
+        txn->state_data.receive.cached_pos = CF_DELTA_HDR_SIZE;
 
-        strcpy(
-            fname,
-            txn->history->fnames.dst_filename); /* strcpy is ok, since fname is CF_FILENAME_MAX_LEN like dst_filename */
-        status = CF_CFDP_RecvMd(txn, ph);
-        if (!status)
+        if (CF_WrappedOpenCreate(&base_fd, bname, OS_FILE_FLAG_NONE, OS_READ_ONLY) < 0)
         {
-            /* successfully obtained md PDU */
-            if (txn->flags.rx.eof_recv)
-            {
-                /* EOF was received, so check that md and EOF sizes match */
-                if (txn->state_data.receive.r2.eof_size != txn->fsize)
-                {
-                    CFE_EVS_SendEvent(CF_CFDP_R_EOF_MD_SIZE_ERR_EID, CFE_EVS_EventType_ERROR,
+            ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_open;
+            base_fd = OS_OBJECT_ID_UNDEFINED; /* just in case */
+            status  = CF_TxnStatus_FILESTORE_REJECTION;
+        }
+        else if (CF_WrappedLseek(base_fd, 0, OS_SEEK_END) != hdr.base_size)
+        {
+            /* not the copy the delta was made against */
+            status = CF_TxnStatus_FILE_SIZE_ERROR;
+        }
+        else
+        {
+            /* the old file is there to copy blocks from */
+        }
+    }
+
+    if (status == CF_TxnStatus_NO_ERROR && !OS_ObjectIdDefined(txn->zfd))
+    {
+        if (CF_WrappedOpenCreate(&txn->zfd, zname, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY) < 0)
+        {
+            ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_open;
+            txn->zfd = OS_OBJECT_ID_UNDEFINED; /* just in case */
+            status   = CF_TxnStatus_FILESTORE_REJECTION;
+        }
+        else
+        {
+            txn->zoffs    = CF_DELTA_HDR_SIZE;
+            txn->raw_size = 0;
+            CF_CRC_Start(&txn->zcrc);
+        }
+    }
+
+    OS_GetLocalTime(&started);
+    while (status == CF_TxnStatus_NO_ERROR && txn->zoffs < txn->fsize && count_bytes < max_bytes)
+    {
+        avail = txn->fsize - txn->zoffs;
+        if (avail > sizeof(op))
+        {
+            avail = sizeof(op);
+        }
+
+        op_size = 0;
+        arg     = 0;
+        count   = 0;
+        if (txn->state_data.receive.cached_pos != txn->zoffs &&
+            CF_WrappedLseek(txn->fd, txn->zoffs, OS_SEEK_SET) != txn->zoffs)
+        {
+            ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_seek;
+            status = CF_TxnStatus_FILESTORE_REJECTION;
+        }
+        else if (CF_WrappedRead(txn->fd, op, avail) != avail)
+        {
+            ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_read;
+            status = CF_TxnStatus_FILESTORE_REJECTION;
+        }
+        else
+        {
+            txn->state_data.receive.cached_pos = txn->zoffs + avail;
+            op_size                            = CF_Delta_ParseOp(op, avail, &arg, &count);
+        }
+
+        if (status != CF_TxnStatus_NO_ERROR)
+        {
+            /* already counted */
+        }
+        else if (op_size == 0)
+        {
+            status = CF_TxnStatus_INVALID_FILE_STRUCTURE;
+        }
+        else if (count)
+        {
+            /* only whole blocks of the old file are ever copied */
+            len = count * hdr.block_size;
+            if (arg >= (hdr.base_size / hdr.block_size) || count > ((hdr.base_size / hdr.block_size) - arg) ||
+                len > (hdr.raw_size - txn->raw_size))
+            {
+                status = CF_TxnStatus_INVALID_FILE_STRUCTURE;
+            }
+            else if (CF_WrappedLseek(base_fd, arg * hdr.block_size, OS_SEEK_SET) != (arg * hdr.block_size))
+            {
+                ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_seek;
+                status = CF_TxnStatus_FILESTORE_REJECTION;
+            }
+            else
+            {
+                status = CF_CFDP_R_DeltaCopy(txn, base_fd, len);
+                txn->zoffs += op_size;
+            }
+        }
+        else
+        {
+            len = arg;
+            if (len > (txn->fsize - txn->zoffs - op_size) || len > (hdr.raw_size - txn->raw_size))
+            {
+                status = CF_TxnStatus_INVALID_FILE_STRUCTURE;
+            }
+            else if (CF_WrappedLseek(txn->fd, txn->zoffs + op_size, OS_SEEK_SET) != (txn->zoffs + op_size))
+            {
+                ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_seek;
+                status = CF_TxnStatus_FILESTORE_REJECTION;
+            }
+            else
+            {
+                status = CF_CFDP_R_DeltaCopy(txn, txn->fd, len);
+                txn->zoffs += op_size + len;
+                txn->state_data.receive.cached_pos = txn->zoffs;
+            }
+        }
+
+        if (status == CF_TxnStatus_NO_ERROR)
+        {
+            count_bytes += len;
+        }
+    }
+    CF_AddElapsedUsec(&txn->history->perf.zip_usec, started);
+
+    if (OS_ObjectIdDefined(base_fd))
+    {
+        CF_WrappedClose(base_fd);
+    }
+
+    if (status == CF_TxnStatus_NO_ERROR && txn->zoffs == txn->fsize)
+    {
+        crc = txn->zcrc;
+        CF_CRC_Finalize(&crc);
+
+        if (txn->raw_size != hdr.raw_size)
+        {
+            status = CF_TxnStatus_FILE_SIZE_ERROR;
+        }
+        else if (crc.result != hdr.raw_crc)
+        {
+            status = CF_TxnStatus_FILE_CHECKSUM_FAILURE;
+        }
+        else
+        {
+            /* the rebuilt file takes the place of the delta, and the old file is removed at reset */
+            CF_WrappedClose(txn->zfd);
+            txn->zfd = OS_OBJECT_ID_UNDEFINED;
+            CF_WrappedClose(txn->fd);
+            txn->fd = OS_OBJECT_ID_UNDEFINED;
+
+            if (CF_WrappedRename(zname, txn->history->fnames.dst_filename) != OS_SUCCESS)
+            {
+                status = CF_TxnStatus_FILESTORE_REJECTION;
+            }
+            else
+            {
+                txn->flags.rx.expanded = true;
+                ret                    = CFE_SUCCESS;
+            }
+        }
+    }
+
+    if (status != CF_TxnStatus_NO_ERROR)
+    {
+        CFE_EVS_SendEvent(CF_CFDP_R_DELTA_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "CF R%d(%lu:%lu): failed to apply delta at offset %lu, status %d",
+                          (txn->state == CF_TxnState_R2), (unsigned long)txn->history->src_eid,
+                          (unsigned long)txn->history->seq_num, (unsigned long)txn->zoffs, (int)status);
+        CF_CFDP_SetTxnStatus(txn, status);
+        txn->keep = 0;
+        if (txn->state == CF_TxnState_R2)
+        {
+            txn->state_data.receive.r2.fs = CF_CFDP_FinFileStatus_DISCARDED;
+        }
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static CF_TxnStatus_t CF_CFDP_R_UnbundleFile(CF_Transaction_t *txn, const CF_BundleEntry_t *entry,
+                                             const char *path)
+{
+    uint8 *        buf  = CF_AppData.engine.bundle.buf;
+    uint32         done = 0;
+    int32          len;
+    osal_id_t      fd;
+    CF_TxnStatus_t status = CF_TxnStatus_NO_ERROR;
+
+    if (CF_WrappedLseek(txn->fd, entry->offset, OS_SEEK_SET) != entry->offset)
+    {
+        ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_seek;
+        status = CF_TxnStatus_FILESTORE_REJECTION;
+    }
+    else if (CF_WrappedOpenCreate(&fd, path, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY) < 0)
+    {
+        ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_open;
+        status = CF_TxnStatus_FILESTORE_REJECTION;
+    }
+    else
+    {
+        txn->state_data.receive.cached_pos = entry->offset;
+
+        while (status == CF_TxnStatus_NO_ERROR && done < entry->size)
+        {
+            len = entry->size - done;
+            if (len > CF_BUNDLE_BUF_SIZE)
+            {
+                len = CF_BUNDLE_BUF_SIZE;
+            }
+
+            if (CF_WrappedRead(txn->fd, buf, len) != len)
+            {
+                ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_read;
+                status = CF_TxnStatus_FILESTORE_REJECTION;
+            }
+            else if (CF_WrappedWrite(fd, buf, len) != len)
+            {
+                ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_write;
+                status = CF_TxnStatus_FILESTORE_REJECTION;
+            }
+            else
+            {
+                done += len;
+                txn->state_data.receive.cached_pos += len;
+            }
+        }
+
+        CF_WrappedClose(fd);
+    }
+
+    return status;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_r.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_CFDP_R_Unbundle(CF_Transaction_t *txn, uint32 max_bytes)
+{
+    uint8 *          buf          = CF_AppData.engine.bundle.buf;
+    uint32           count        = 0;
+    uint32           index_offset = 0;
+    uint32           index_end    = 0;
+    uint32           count_bytes  = 0;
+    uint32           n            = 0;
+    int32            len;
+    CF_BundleEntry_t entry;
+    CF_TxnStatus_t   status = CF_TxnStatus_NO_ERROR;
+    CFE_Status_t     ret    = CF_ERROR;
+    char             dir[OS_MAX_PATH_LEN];
+    char             path[OS_MAX_PATH_LEN];
+    char *           slash;
+
+    /* the files go in the directory the bundle was received into */
+    strncpy(dir, txn->history->fnames.dst_filename, sizeof(dir) - 1);
+    dir[sizeof(dir) - 1] = 0;
+    slash                = strrchr(dir, '/');
+    if (slash != NULL)
+    {
+        slash[1] = 0;
+    }
+    else
+    {
+        dir[0] = 0;
+    }
+
+    /* the trailer is read again each call, so nothing about the bundle needs keeping between calls */
+    if (txn->fsize < CF_BUNDLE_TRAILER_SIZE)
+    {
+        status = CF_TxnStatus_INVALID_FILE_STRUCTURE;
+    }
+    else if (CF_WrappedLseek(txn->fd, txn->fsize - CF_BUNDLE_TRAILER_SIZE, OS_SEEK_SET) !=
+             (txn->fsize - CF_BUNDLE_TRAILER_SIZE))
+    {
+        ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_seek;
+        status = CF_TxnStatus_FILESTORE_REJECTION;
+    }
+    else if (CF_WrappedRead(txn->fd, buf, CF_BUNDLE_TRAILER_SIZE) != CF_BUNDLE_TRAILER_SIZE)
+    {
+        ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_read;
+        status = CF_TxnStatus_FILESTORE_REJECTION;
+    }
+    else if (!CF_Bundle_ParseTrailer(buf, txn->fsize, &count, &index_offset))
+    {
+        status = CF_TxnStatus_INVALID_FILE_STRUCTURE;
+    }
+    else
+    {
+        txn->state_data.receive.cached_pos = txn->fsize;
+        index_end                          = txn->fsize - CF_BUNDLE_TRAILER_SIZE;
+
+        if (txn->zoffs < index_offset)
+        {
+            /* first call, zoffs is the next entry of the index and raw_size counts the files unpacked */
+            txn->zoffs    = index_offset;
+            txn->raw_size = 0;
+        }
+    }
+
+    /* whole files are unpacked, so a call may go over max_bytes by up to one file */
+    while (status == CF_TxnStatus_NO_ERROR && txn->zoffs < index_end && count_bytes < max_bytes)
+    {
+        len = index_end - txn->zoffs;
+        if (len > (CF_BUNDLE_ENTRY_HDR_SIZE + CF_FILENAME_MAX_NAME))
+        {
+            len = CF_BUNDLE_ENTRY_HDR_SIZE + CF_FILENAME_MAX_NAME;
+        }
+
+        if (CF_WrappedLseek(txn->fd, txn->zoffs, OS_SEEK_SET) != txn->zoffs)
+        {
+            ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_seek;
+            status = CF_TxnStatus_FILESTORE_REJECTION;
+        }
+        else if (CF_WrappedRead(txn->fd, buf, len) != len)
+        {
+            ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_read;
+            status = CF_TxnStatus_FILESTORE_REJECTION;
+        }
+        else
+        {
+            txn->state_data.receive.cached_pos = txn->zoffs + len;
+
+            n = CF_Bundle_ParseEntry(buf, len, &entry);
+            if (n == 0 || txn->raw_size >= count || entry.size > index_offset ||
+                entry.offset > (index_offset - entry.size))
+            {
+                status = CF_TxnStatus_INVALID_FILE_STRUCTURE;
+            }
+            else
+            {
+                snprintf(path, sizeof(path), "%s%s", dir, entry.name);
+                status = CF_CFDP_R_UnbundleFile(txn, &entry, path);
+            }
+        }
+
+        if (status == CF_TxnStatus_NO_ERROR)
+        {
+            txn->zoffs += n;
+            ++txn->raw_size;
+            count_bytes += entry.size + n;
+        }
+    }
+
+    if (status == CF_TxnStatus_NO_ERROR && txn->zoffs == index_end)
+    {
+        if (txn->raw_size != count)
+        {
+            status = CF_TxnStatus_INVALID_FILE_STRUCTURE;
+        }
+        else
+        {
+            /* every file is in place, so the bundle itself is not kept */
+            CF_WrappedClose(txn->fd);
+            txn->fd = OS_OBJECT_ID_UNDEFINED;
+            CF_WrappedRemove(txn->history->fnames.dst_filename);
+
+            txn->flags.rx.expanded = true;
+            ret                    = CFE_SUCCESS;
+        }
+    }
+
+    if (status != CF_TxnStatus_NO_ERROR)
+    {
+        CFE_EVS_SendEvent(CF_CFDP_R_BUNDLE_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "CF R%d(%lu:%lu): failed to unpack bundle at offset %lu, status %d",
+                          (txn->state == CF_TxnState_R2), (unsigned long)txn->history->src_eid,
+                          (unsigned long)txn->history->seq_num, (unsigned long)txn->zoffs, (int)status);
+        CF_CFDP_SetTxnStatus(txn, status);
+        txn->keep = 0;
+        if (txn->state == CF_TxnState_R2)
+        {
+            txn->state_data.receive.r2.fs = CF_CFDP_FinFileStatus_DISCARDED;
+        }
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_r.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_R_DeltaSetAside(CF_Transaction_t *txn)
+{
+    char bname[OS_MAX_PATH_LEN];
+
+    CF_Delta_GetFilename(bname, sizeof(bname), txn->history->src_eid, txn->history->seq_num, CF_DELTA_BASE_EXT);
+
+    /* a missing old file is found when the delta is applied */
+    CF_WrappedRename(txn->history->fnames.dst_filename, bname);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_r.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_R_DeltaReset(CF_Transaction_t *txn)
+{
+    char bname[OS_MAX_PATH_LEN];
+
+    if (txn->flags.com.delta)
+    {
+        CF_Delta_GetFilename(bname, sizeof(bname), txn->history->src_eid, txn->history->seq_num,
+                             CF_DELTA_BASE_EXT);
+
+        if (txn->flags.rx.expanded)
+        {
+            CF_WrappedRemove(bname);
+        }
+        else
+        {
+            /* nothing was delivered, so the old file goes back where it was */
+            CF_WrappedRename(bname, txn->history->fnames.dst_filename);
+        }
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_r.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_CFDP_R2_SubstateSendFin(CF_Transaction_t *txn)
+{
+    CFE_Status_t sret;
+    CFE_Status_t ret = CFE_SUCCESS;
+
+    if (!CF_TxnStatus_IsError(txn->history->txn_stat) && !txn->flags.com.crc_calc)
+    {
+        /* no error, and haven't checked CRC -- so start checking it */
+        if (CF_CFDP_R2_CalcCrcChunk(txn))
+        {
+            ret = CF_ERROR; /* signal to caller to re-enter next tick */
+        }
+    }
+
+    if (ret != CF_ERROR && !CF_TxnStatus_IsError(txn->history->txn_stat) && txn->flags.com.compressed &&
+        !txn->flags.rx.expanded)
+    {
+        /* the checksum covers the compressed data, so it is only expanded once that matched */
+        if (CF_CFDP_R_ExpandChunk(txn, CF_AppData.config_table->rx_crc_calc_bytes_per_wakeup))
+        {
+            ret = CF_ERROR; /* signal to caller to re-enter next tick */
+        }
+    }
+    else if (ret != CF_ERROR && !CF_TxnStatus_IsError(txn->history->txn_stat) && txn->flags.com.delta &&
+             !txn->flags.rx.expanded)
+    {
+        /* likewise a delta is only applied once its checksum matched */
+        if (CF_CFDP_R_ApplyDelta(txn, CF_AppData.config_table->rx_crc_calc_bytes_per_wakeup))
+        {
+            ret = CF_ERROR; /* signal to caller to re-enter next tick */
+        }
+    }
+    else if (ret != CF_ERROR && !CF_TxnStatus_IsError(txn->history->txn_stat) && txn->flags.com.bundle &&
+             !txn->flags.rx.expanded)
+    {
+        /* and a bundle is only unpacked once its checksum matched */
+        if (CF_CFDP_R_Unbundle(txn, CF_AppData.config_table->rx_crc_calc_bytes_per_wakeup))
+        {
+            ret = CF_ERROR; /* signal to caller to re-enter next tick */
+        }
+    }
+
+    if (ret != CF_ERROR)
+    {
+        sret = CF_CFDP_SendFin(txn, txn->state_data.receive.r2.dc, txn->state_data.receive.r2.fs,
+                               CF_TxnStatus_To_ConditionCode(txn->history->txn_stat));
+        CF_Assert(sret != CF_SEND_PDU_ERROR); /* CF_CFDP_SendFin does not return CF_SEND_PDU_ERROR */
+        txn->state_data.receive.sub_state =
+            CF_RxSubState_WAIT_FOR_FIN_ACK; /* whether or not FIN send successful, ok to transition state */
+        if (sret != CFE_SUCCESS)
+        {
+            ret = CF_ERROR;
+        }
+    }
+
+    /* if no message, then try again next time */
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_r.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_CFDP_R2_SubstateSendKeepAlive(CF_Transaction_t *txn)
+{
+    const CF_Chunk_t *chunk    = CF_ChunkList_GetFirstChunk(&txn->chunks->chunks);
+    CF_FileSize_t     progress = 0;
+
+    /* chunks are merged as they are added, so the first one is all the data received without a gap */
+    if (chunk != NULL && chunk->offset == 0)
+    {
+        progress = chunk->size;
+    }
+
+    return CF_CFDP_SendKeepAlive(txn, progress);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_r.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_R2_Recv_fin_ack(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
+{
+    if (!CF_CFDP_RecvAck(txn, ph))
+    {
+        /* got fin-ack, so time to close the state */
+        CF_CFDP_R2_Reset(txn);
+    }
+    else
+    {
+        CFE_EVS_SendEvent(CF_CFDP_R_PDU_FINACK_ERR_EID, CFE_EVS_EventType_ERROR, "CF R%d(%lu:%lu): invalid fin-ack",
+                          (txn->state == CF_TxnState_R2), (unsigned long)txn->history->src_eid,
+                          (unsigned long)txn->history->seq_num);
+        ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.error;
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_r.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_R2_RecvPrompt(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
+{
+    if (!CF_CFDP_RecvPrompt(txn, ph))
+    {
+        if (ph->int_header.prompt.response_required == CF_CFDP_PromptResponse_NAK)
+        {
+            /* once EOF is in, the file size is known and the usual NAK already covers the whole file */
+            if (!txn->flags.rx.eof_recv)
+            {
+                txn->flags.rx.prompted = true;
+            }
+            txn->flags.rx.send_nak = true;
+        }
+        else
+        {
+            txn->flags.rx.send_keep_alive = true;
+        }
+    }
+    else
+    {
+        ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.error;
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_r.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_R2_RecvMd(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
+{
+    char  fname[CF_FILENAME_MAX_LEN];
+    int   status;
+    int32 ret;
+    bool  success = true;
+
+    /* it isn't an error to get another MD PDU, right? */
+    if (!txn->flags.rx.md_recv)
+    {
+        /* NOTE: txn->flags.rx.md_recv always 1 in R1, so this is R2 only */
+        /* parse the md PDU. this will overwrite the transaction's history, which contains our filename. so let's
+         * save the filename in a local buffer so it can be used with CF_WrappedRename() upon successful parsing of
+         * the md PDU */
+
+        strcpy(
+            fname,
+            txn->history->fnames.dst_filename); /* strcpy is ok, since fname is CF_FILENAME_MAX_LEN like dst_filename */
+        status = CF_CFDP_RecvMd(txn, ph);
+        if (!status)
+        {
+            /* successfully obtained md PDU */
+            if (txn->flags.rx.eof_recv && txn->fsize == 0)
+            {
+                /* an unbounded size in the metadata is given by the EOF */
+                txn->fsize = txn->state_data.receive.r2.eof_size;
+            }
+            else if (txn->flags.rx.eof_recv)
+            {
+                /* EOF was received, so check that md and EOF sizes match */
+                if (txn->state_data.receive.r2.eof_size != txn->fsize)
+                {
+                    CFE_EVS_SendEvent(CF_CFDP_R_EOF_MD_SIZE_ERR_EID, CFE_EVS_EventType_ERROR,
                                       "CF R%d(%lu:%lu): EOF/md size mismatch md: %lu, EOF: %lu",
                                       (txn->state == CF_TxnState_R2), (unsigned long)txn->history->src_eid,
                                       (unsigned long)txn->history->seq_num, (unsigned long)txn->fsize,
@@ -815,14 +1769,23 @@ void CF_CFDP_R2_RecvMd(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
                 }
             }
 
-            if (success)
+            if (success && txn->state_data.receive.staging)
+            {
+                /* everything received so far is still in RAM, so it goes straight to the destination */
+                if (CF_CFDP_R2_StagingFlush(txn) != CFE_SUCCESS)
+                {
+                    CF_CFDP_R2_SetFinTxnStatus(txn, CF_TxnStatus_FILESTORE_REJECTION);
+                    success = false;
+                }
+            }
+            else if (success)
             {
                 /* close and rename file */
                 CF_WrappedClose(txn->fd);
                 CFE_ES_PerfLogEntry(CF_PERF_ID_RENAME);
 
-                /* Note OS_mv attempts a rename, then copy/delete if that fails so it works across file systems */
-                status = OS_mv(fname, txn->history->fnames.dst_filename);
+                /* a rename across filestores is done as a copy and delete */
+                status = CF_WrappedRename(fname, txn->history->fnames.dst_filename);
 
                 CFE_ES_PerfLogExit(CF_PERF_ID_RENAME);
                 if (status != OS_SUCCESS)
@@ -851,15 +1814,21 @@ void CF_CFDP_R2_RecvMd(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
                         txn->fd = OS_OBJECT_ID_UNDEFINED; /* just in case */
                         success = false;
                     }
+                    else
+                    {
+                        txn->state_data.receive.cached_pos = 0; /* reset psn due to open */
+                    }
                 }
+            }
 
-                if (success)
-                {
-                    txn->state_data.receive.cached_pos      = 0; /* reset psn due to open */
-                    txn->flags.rx.md_recv                   = true;
-                    txn->state_data.receive.r2.acknak_count = 0; /* in case part of NAK */
-                    CF_CFDP_R2_Complete(txn, 1);                 /* check for completion now that md is received */
-                }
+            if (success)
+            {
+                /* the destination was replaced, so a partial file kept for it is gone */
+                CF_Ckpt_DropPartial(txn);
+
+                txn->flags.rx.md_recv                   = true;
+                txn->state_data.receive.r2.acknak_count = 0; /* in case part of NAK */
+                CF_CFDP_R2_Complete(txn, 1);                 /* check for completion now that md is received */
             }
         }
         else
@@ -903,6 +1872,7 @@ void CF_CFDP_R2_Recv(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
         .fdirective = {
             [CF_CFDP_FileDirective_EOF]      = CF_CFDP_R2_SubstateRecvEof,
             [CF_CFDP_FileDirective_METADATA] = CF_CFDP_R2_RecvMd,
+            [CF_CFDP_FileDirective_PROMPT]   = CF_CFDP_R2_RecvPrompt,
         }};
     static const CF_CFDP_FileDirectiveDispatchTable_t r2_fdir_handlers_finack = {
         .fdirective = {
@@ -948,6 +1918,64 @@ void CF_CFDP_R_SendInactivityEvent(CF_Transaction_t *txn)
                       "CF R%d(%lu:%lu): inactivity timer expired", (txn->state == CF_TxnState_R2),
                       (unsigned long)txn->history->src_eid, (unsigned long)txn->history->seq_num);
     ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.inactivity_timer;
+    CF_TRACE(CF_TraceEvent_TIMER, txn->chan_num, (uint32)txn->history->seq_num, CF_TraceTimer_INACTIVITY, 0, 0, 0);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_r.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_R_Respond(CF_Transaction_t *txn, int *cont /* unused */)
+{
+    CFE_Status_t sret;
+
+    /* same order as CF_CFDP_R_Tick(), but keep going while each one gets sent */
+    if (txn->state == CF_TxnState_R2)
+    {
+        if (txn->flags.rx.send_ack)
+        {
+            sret = CF_CFDP_SendAck(txn, CF_CFDP_AckTxnStatus_ACTIVE, CF_CFDP_FileDirective_EOF,
+                                   txn->state_data.receive.r2.eof_cc, txn->history->peer_eid, txn->history->seq_num);
+            CF_Assert(sret != CF_SEND_PDU_ERROR);
+
+            if (sret != CF_SEND_PDU_NO_BUF_AVAIL_ERROR)
+            {
+                txn->flags.rx.send_ack = false;
+            }
+        }
+
+        if (!txn->flags.rx.send_ack && txn->flags.rx.send_nak)
+        {
+            if (!CF_CFDP_R_SubstateSendNak(txn))
+            {
+                txn->flags.rx.send_nak = false;
+            }
+        }
+
+        /* the file CRC is only worked on at wakeup, so the FIN waits for it unless there is nothing to check */
+        if (!txn->flags.rx.send_ack && !txn->flags.rx.send_nak && txn->flags.rx.send_fin &&
+            ((txn->flags.com.crc_calc &&
+              (!(txn->flags.com.compressed || txn->flags.com.delta || txn->flags.com.bundle) ||
+               txn->flags.rx.expanded)) ||
+             CF_TxnStatus_IsError(txn->history->txn_stat)))
+        {
+            if (!CF_CFDP_R2_SubstateSendFin(txn))
+            {
+                txn->flags.rx.send_fin = false;
+            }
+        }
+
+        if (!txn->flags.rx.send_ack && !txn->flags.rx.send_nak && !txn->flags.rx.send_fin &&
+            txn->flags.rx.send_keep_alive)
+        {
+            if (!CF_CFDP_R2_SubstateSendKeepAlive(txn))
+            {
+                txn->flags.rx.send_keep_alive = false;
+            }
+        }
+    }
 }
 
 /*----------------------------------------------------------------
@@ -984,7 +2012,22 @@ void CF_CFDP_R_Tick(CF_Transaction_t *txn, int *cont /* unused */)
             }
         }
 
-        /* rx maintenance: possibly process send_eof_ack, send_nak or send_fin */
+        /* keep the sender from timing out while file data is still coming in */
+        if (CF_AppData.config_table->chan[txn->chan_num].keep_alive_s && !txn->flags.rx.complete)
+        {
+            if (CF_Timer_Expired(&txn->state_data.receive.r2.keep_alive_timer))
+            {
+                txn->flags.rx.send_keep_alive = true;
+                CF_Timer_InitRelSec(&txn->state_data.receive.r2.keep_alive_timer,
+                                    CF_AppData.config_table->chan[txn->chan_num].keep_alive_s);
+            }
+            else
+            {
+                CF_Timer_Tick(&txn->state_data.receive.r2.keep_alive_timer);
+            }
+        }
+
+        /* rx maintenance: possibly process send_eof_ack, send_nak, send_fin or send_keep_alive */
         if (txn->flags.rx.send_ack)
         {
             sret = CF_CFDP_SendAck(txn, CF_CFDP_AckTxnStatus_ACTIVE, CF_CFDP_FileDirective_EOF,
@@ -1012,6 +2055,13 @@ void CF_CFDP_R_Tick(CF_Transaction_t *txn, int *cont /* unused */)
                 txn->flags.rx.send_fin = false; /* will re-enter on error */
             }
         }
+        else if (txn->flags.rx.send_keep_alive)
+        {
+            if (!CF_CFDP_R2_SubstateSendKeepAlive(txn))
+            {
+                txn->flags.rx.send_keep_alive = false; /* will re-enter if no buffer */
+            }
+        }
         else
         {
             /* don't care about any other cases */
@@ -1021,6 +2071,9 @@ void CF_CFDP_R_Tick(CF_Transaction_t *txn, int *cont /* unused */)
         {
             if (CF_Timer_Expired(&txn->ack_timer))
             {
+                CF_TRACE(CF_TraceEvent_TIMER, txn->chan_num, (uint32)txn->history->seq_num, CF_TraceTimer_ACK, 0, 0,
+                         0);
+
                 /* ACK timer expired, so check for completion */
                 if (!txn->flags.rx.complete)
                 {
@@ -64,15 +64,34 @@ void CF_CFDP_R1_Recv(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph);
  */
 void CF_CFDP_R2_Recv(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph);
 
+/************************************************************************/
+/** @brief Send the responses an R transaction has pending.
+ *
+ * @par Description
+ *       Called by the engine between wakeups when the channel is in
+ *       event-driven mode, right after received PDUs are processed.
+ *       Sends the pending ACK, NAK, FIN and Keep Alive in that order,
+ *       stopping at the first one that cannot be sent. The FIN is left
+ *       for the tick while the file CRC still needs to be calculated. No
+ *       timers are touched.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL. cont is unused, so may be NULL
+ *
+ * @param txn  Pointer to the transaction object
+ * @param cont Unused, exists for compatibility with tick processor
+ */
+void CF_CFDP_R_Respond(CF_Transaction_t *txn, int *cont);
+
 /************************************************************************/
 /** @brief Perform tick (time-based) processing for R transactions.
  *
  * @par Description
  *       This function is called on every transaction by the engine on
  *       every CF wakeup. This is where flags are checked to send ACK,
- *       NAK, and FIN. It checks for inactivity timer and processes the
- *       ACK timer. The ACK timer is what triggers re-sends of PDUs
- *       that require acknowledgment.
+ *       NAK, FIN and Keep Alive. It checks for inactivity timer and
+ *       processes the ACK and Keep Alive timers. The ACK timer is what
+ *       triggers re-sends of PDUs that require acknowledgment.
  *
  * @par Assumptions, External Events, and Notes:
  *       txn must not be NULL. cont is unused, so may be NULL
@@ -103,6 +122,45 @@ void CF_CFDP_R_Cancel(CF_Transaction_t *txn);
  */
 void CF_CFDP_R_Init(CF_Transaction_t *txn);
 
+/************************************************************************/
+/** @brief Take a RAM staging buffer for an R2 transaction without metadata.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL. Only used if staging is enabled on the
+ *       transaction's channel.
+ *
+ * @param txn  Pointer to the transaction object
+ *
+ * @retval true if the transaction now stages file data in RAM
+ * @retval false if staging is disabled or no buffer is free
+ */
+bool CF_CFDP_R2_StagingAcquire(CF_Transaction_t *txn);
+
+/************************************************************************/
+/** @brief Write the staged file data of an R2 transaction to a file.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL, and must hold a staging buffer. The file named
+ *       by the transaction's dst_filename is created and becomes txn->fd.
+ *       The staging buffer is released whether or not this succeeds.
+ *
+ * @param txn  Pointer to the transaction object
+ *
+ * @retval CFE_SUCCESS on success.
+ * @retval CF_ERROR on failure to create or write the file.
+ */
+CFE_Status_t CF_CFDP_R2_StagingFlush(CF_Transaction_t *txn);
+
+/************************************************************************/
+/** @brief Give back the RAM staging buffer of an R2 transaction, if it has one.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL. Staged data that was not flushed is discarded.
+ *
+ * @param txn  Pointer to the transaction object
+ */
+void CF_CFDP_R2_StagingRelease(CF_Transaction_t *txn);
+
 /************************************************************************/
 /** @brief Helper function to store transaction status code and set send_fin flag.
  *
@@ -298,7 +356,9 @@ void CF_CFDP_R2_GapCompute(const CF_ChunkList_t *chunks, const CF_Chunk_t *chunk
  *       chunks class tracks this and generates the NAK PDU by calculating
  *       gaps internally and calling CF_CFDP_R2_GapCompute(). There is a special
  *       case where if a metadata PDU has not been received, then a NAK
- *       packet will be sent to request another.
+ *       packet will be sent to request another. A NAK answering a Prompt
+ *       before EOF only covers the file up to the furthest data received,
+ *       and is not sent at all if nothing below that is missing.
  *
  * @par Assumptions, External Events, and Notes:
  *       txn must not be NULL.
@@ -332,6 +392,104 @@ CFE_Status_t CF_CFDP_R_SubstateSendNak(CF_Transaction_t *txn);
  */
 CFE_Status_t CF_CFDP_R2_CalcCrcChunk(CF_Transaction_t *txn);
 
+/************************************************************************/
+/** @brief Expand up to max_bytes of compressed file data.
+ *
+ * @par Description
+ *       Reads the received file block by block, from txn->zoffs, and
+ *       writes the expanded data to a temp file in the tmp_dir. Once the
+ *       whole file is expanded, the temp file is moved over the received
+ *       file and txn->flags.rx.expanded is set. On a failure the
+ *       transaction status is set, and the file is not kept.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL, and the received file must be open and its
+ *       checksum must have matched.
+ *
+ * @param txn        Pointer to the transaction object
+ * @param max_bytes  Number of bytes of compressed data to expand in this call
+ *
+ * @retval CFE_SUCCESS on completion.
+ * @retval CF_ERROR on non-completion or failure.
+ */
+CFE_Status_t CF_CFDP_R_ExpandChunk(CF_Transaction_t *txn, uint32 max_bytes);
+
+/************************************************************************/
+/** @brief Apply up to max_bytes of a received delta.
+ *
+ * @par Description
+ *       Reads the instructions of the received delta from txn->zoffs,
+ *       and writes the blocks they copy from the old file and the data
+ *       they carry to a temp file in the tmp_dir. Once the whole delta is
+ *       applied, the size and checksum of the new file are checked
+ *       against those in the delta header, and the temp file is moved
+ *       over the received file and txn->flags.rx.expanded is set. On a
+ *       failure the transaction status is set, and the file is not kept.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL, the received file must be open and its
+ *       checksum must have matched, and the old file must have been set
+ *       aside by CF_CFDP_R_DeltaSetAside().
+ *
+ * @param txn        Pointer to the transaction object
+ * @param max_bytes  Number of bytes of the new file to write in this call
+ *
+ * @retval CFE_SUCCESS on completion.
+ * @retval CF_ERROR on non-completion or failure.
+ */
+CFE_Status_t CF_CFDP_R_ApplyDelta(CF_Transaction_t *txn, uint32 max_bytes);
+
+/************************************************************************/
+/** @brief Unpack a received bundle of files.
+ *
+ * @par Description
+ *       Reads the index of the received bundle from txn->zoffs, and
+ *       writes each file in it to the directory the bundle was received
+ *       into, whole files at a time until at least max_bytes have been
+ *       written. Once every file is in place the bundle is removed and
+ *       txn->flags.rx.expanded is set. On a failure the transaction status
+ *       is set, and the bundle is not kept. Files already unpacked stay.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL, and the received file must be open and its
+ *       checksum must have matched.
+ *
+ * @param txn        Pointer to the transaction object
+ * @param max_bytes  Number of bytes of file data to unpack in this call
+ *
+ * @retval CFE_SUCCESS on completion.
+ * @retval CF_ERROR on non-completion or failure.
+ */
+CFE_Status_t CF_CFDP_R_Unbundle(CF_Transaction_t *txn, uint32 max_bytes);
+
+/************************************************************************/
+/** @brief Set the old copy of a file aside before a delta of it is received.
+ *
+ * @par Description
+ *       Moves the destination file to a temp file in the tmp_dir, so the
+ *       received delta can be written in its place and applied against it.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL, and its metadata must have been received.
+ *
+ * @param txn  Pointer to the transaction object
+ */
+void CF_CFDP_R_DeltaSetAside(CF_Transaction_t *txn);
+
+/************************************************************************/
+/** @brief Settle the old copy of a file when a delta receive ends.
+ *
+ * @par Description
+ *       If the delta was applied the old copy is removed, otherwise it is
+ *       moved back over the destination file.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL, and the received file must be closed.
+ *
+ * @param txn  Pointer to the transaction object
+ */
+void CF_CFDP_R_DeltaReset(CF_Transaction_t *txn);
+
 /************************************************************************/
 /** @brief Send a FIN PDU.
  *
@@ -345,6 +503,25 @@ CFE_Status_t CF_CFDP_R2_CalcCrcChunk(CF_Transaction_t *txn);
  */
 CFE_Status_t CF_CFDP_R2_SubstateSendFin(CF_Transaction_t *txn);
 
+/************************************************************************/
+/** @brief Send a Keep Alive PDU for R2.
+ *
+ * @par Description
+ *       The progress reported is the file data received without any gap
+ *       from the start of the file, so the sender can rely on all of it
+ *       being held.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL.
+ *
+ * @returns CFE_Status_t status code
+ * @retval CFE_SUCCESS on success.
+ * @retval CF_SEND_PDU_NO_BUF_AVAIL_ERROR if message buffer cannot be obtained.
+ *
+ * @param txn  Pointer to the transaction object
+ */
+CFE_Status_t CF_CFDP_R2_SubstateSendKeepAlive(CF_Transaction_t *txn);
+
 /************************************************************************/
 /** @brief Process receive FIN-ACK PDU.
  *
@@ -360,6 +537,22 @@ CFE_Status_t CF_CFDP_R2_SubstateSendFin(CF_Transaction_t *txn);
  */
 void CF_CFDP_R2_Recv_fin_ack(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph);
 
+/************************************************************************/
+/** @brief Process receive Prompt PDU for R2.
+ *
+ * @par Description
+ *       A Prompt (NAK) asks for a NAK right away rather than at EOF, so
+ *       the sender can repair lost file data while it is still sending.
+ *       A Prompt (Keep Alive) asks for a Keep Alive.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL. ph must not be NULL.
+ *
+ * @param txn  Pointer to the transaction object
+ * @param ph Pointer to the PDU information
+ */
+void CF_CFDP_R2_RecvPrompt(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph);
+
 /************************************************************************/
 /** @brief Process receive metadata PDU for R2.
  *
@@ -32,6 +32,7 @@
 #include "cf_perfids.h"
 #include "cf_cfdp.h"
 #include "cf_utils.h"
+#include "cf_trace.h"
 
 #include "cf_cfdp_s.h"
 #include "cf_cfdp_dispatch.h"
@@ -51,6 +52,60 @@ static inline void CF_CFDP_S_Reset(CF_Transaction_t *txn)
     CF_CFDP_ResetTransaction(txn, true);
 }
 
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_s.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_S2_FlowFeedback(CF_Transaction_t *txn, uint32 lost)
+{
+    /* all file data sent since the previous feedback is now accounted for by the peer */
+    CF_Flow_Feedback(CF_Flow_LookupPeer(txn->history->peer_eid), txn->state_data.send.s2.fc_in_flight, lost);
+    txn->state_data.send.s2.fc_in_flight = 0;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_s.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_CFDP_S_GetFanOutCrc(CF_Transaction_t *txn)
+{
+    CFE_Status_t status;
+    OS_time_t    started;
+    bool         done = true;
+
+    if (txn->fanout && !txn->flags.com.crc_calc)
+    {
+        OS_GetLocalTime(&started);
+        status = CF_FanOut_GetCrc(txn->fanout, &txn->crc, CF_AppData.config_table->rx_crc_calc_bytes_per_wakeup);
+        CF_AddElapsedUsec(&txn->history->perf.crc_usec, started);
+
+        if (status == CF_FANOUT_CRC_PENDING)
+        {
+            /* the reading for this wakeup is used up, pick up from here next time */
+            CF_AppData.engine.channels[txn->chan_num].cur = txn;
+            done                                          = false;
+        }
+        else
+        {
+            if (status != CFE_SUCCESS)
+            {
+                CFE_EVS_SendEvent(CF_CFDP_S_READ_ERR_EID, CFE_EVS_EventType_ERROR,
+                                  "CF S%d(%lu:%lu): error reading file for checksum", (txn->state == CF_TxnState_S2),
+                                  (unsigned long)txn->history->src_eid, (unsigned long)txn->history->seq_num);
+                ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_read;
+                CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_FILESTORE_REJECTION);
+            }
+            txn->flags.com.crc_calc = true;
+        }
+    }
+
+    return done;
+}
+
 /*----------------------------------------------------------------
  *
  * Application-scope internal function
@@ -78,7 +133,7 @@ void CF_CFDP_S1_SubstateSendEof(CF_Transaction_t *txn)
     /* this looks weird, but the idea is we want to reset the transaction if some error occurs while sending
      * and we want to reset the transaction if no error occurs. But, if we couldn't send because there are
      * no buffers, then we need to try and send again next time. */
-    if (CF_CFDP_S_SendEof(txn) != CF_SEND_PDU_NO_BUF_AVAIL_ERROR)
+    if (CF_CFDP_S_GetFanOutCrc(txn) && CF_CFDP_S_SendEof(txn) != CF_SEND_PDU_NO_BUF_AVAIL_ERROR)
     {
         CF_CFDP_S_Reset(txn); /* all done, so clean up */
     }
@@ -92,14 +147,18 @@ void CF_CFDP_S1_SubstateSendEof(CF_Transaction_t *txn)
  *-----------------------------------------------------------------*/
 void CF_CFDP_S2_SubstateSendEof(CF_Transaction_t *txn)
 {
-    txn->state_data.send.sub_state = CF_TxSubState_WAIT_FOR_EOF_ACK;
-    txn->flags.com.ack_timer_armed = true; /* will cause tick to see ack_timer as expired, and act */
+    /* the checksum has to be complete before the tick sends the EOF */
+    if (CF_CFDP_S_GetFanOutCrc(txn))
+    {
+        txn->state_data.send.sub_state = CF_TxSubState_WAIT_FOR_EOF_ACK;
+        txn->flags.com.ack_timer_armed = true; /* will cause tick to see ack_timer as expired, and act */
 
-    /* no longer need to send file data PDU except in the case of NAK response */
+        /* no longer need to send file data PDU except in the case of NAK response */
 
-    /* move this transaction off Q_PEND */
-    CF_DequeueTransaction(txn);
-    CF_InsertSortPrio(txn, CF_QueueIdx_TXW);
+        /* move this transaction off Q_PEND */
+        CF_DequeueTransaction(txn);
+        CF_InsertSortPrio(txn, CF_QueueIdx_TXW);
+    }
 }
 
 /*----------------------------------------------------------------
@@ -113,11 +172,33 @@ CFE_Status_t CF_CFDP_S_SendFileData(CF_Transaction_t *txn, uint32 foffs, uint32
     bool                            success = true;
     int                             status  = 0;
     CFE_Status_t                    ret     = CF_ERROR;
-    CF_Logical_PduBuffer_t *        ph      = CF_CFDP_ConstructPduHeader(txn, 0, CF_AppData.config_table->local_eid,
-                                                            txn->history->peer_eid, 0, txn->history->seq_num, 1);
+    CF_Logical_PduBuffer_t *        ph      = NULL;
+    CF_FlowPeer_t *                 peer    = CF_Flow_FindPeer(txn->history->peer_eid);
     CF_Logical_PduFileDataHeader_t *fd;
     size_t                          actual_bytes;
     void *                          data_ptr;
+    OS_time_t                       started;
+    bool                            prefetched = false;
+
+    /* the flow control window is in file data bytes, so check it before taking an output buffer */
+    actual_bytes = bytes_to_read;
+    if (actual_bytes > CF_AppData.config_table->outgoing_file_chunk_size)
+    {
+        actual_bytes = CF_AppData.config_table->outgoing_file_chunk_size;
+    }
+
+    if (CF_Flow_Permit(peer, actual_bytes))
+    {
+        ph = CF_CFDP_ConstructPduHeader(txn, 0, CF_AppData.config_table->local_eid, txn->history->peer_eid, 0,
+                                        txn->history->seq_num, 1);
+    }
+    else
+    {
+        /* peer window is used up for this wakeup, remember where we were for next time */
+        CF_AppData.engine.channels[txn->chan_num].cur = txn;
+        CF_CFDP_PerfWait(txn->history, true);
+        CF_TRACE(CF_TraceEvent_STALL, txn->chan_num, (uint32)txn->history->seq_num, CF_TraceStall_FLOW, 0, foffs, 0);
+    }
 
     if (!ph)
     {
@@ -162,7 +243,22 @@ CFE_Status_t CF_CFDP_S_SendFileData(CF_Transaction_t *txn, uint32 foffs, uint32
         fd->data_len = actual_bytes;
         fd->data_ptr = data_ptr;
 
-        if (txn->state_data.send.cached_pos != foffs)
+        OS_GetLocalTime(&started);
+
+        if (txn->fanout)
+        {
+            /* the group reads the file once for all of its destinations */
+            status = CF_FanOut_Read(txn->fanout, foffs, data_ptr, actual_bytes);
+        }
+        else if (foffs == 0 && txn->state_data.send.prefetch && actual_bytes <= txn->state_data.send.prefetch->size)
+        {
+            /* read while the send was pending, and the file was left after it */
+            memcpy(data_ptr, txn->state_data.send.prefetch->data, actual_bytes);
+            status     = actual_bytes;
+            prefetched = true;
+            CF_CFDP_S_PrefetchRelease(txn);
+        }
+        else if (txn->state_data.send.cached_pos != foffs)
         {
             status = CF_WrappedLseek(txn->fd, foffs, OS_SEEK_SET);
             if (status != foffs)
@@ -178,65 +274,969 @@ CFE_Status_t CF_CFDP_S_SendFileData(CF_Transaction_t *txn, uint32 foffs, uint32
 
         if (success)
         {
-            status = CF_WrappedRead(txn->fd, data_ptr, actual_bytes);
+            if (!txn->fanout && !prefetched)
+            {
+                status = CF_WrappedRead(txn->fd, data_ptr, actual_bytes);
+            }
             if (status != actual_bytes)
             {
                 CFE_EVS_SendEvent(CF_CFDP_S_READ_ERR_EID, CFE_EVS_EventType_ERROR,
                                   "CF S%d(%lu:%lu): error reading bytes: expected %ld, got %ld",
                                   (txn->state == CF_TxnState_S2), (unsigned long)txn->history->src_eid,
-                                  (unsigned long)txn->history->seq_num, (long)actual_bytes, (long)status);
-                ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_read;
-                success = false;
+                                  (unsigned long)txn->history->seq_num, (long)actual_bytes, (long)status);
+                ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_read;
+                success = false;
+            }
+        }
+
+        CF_AddElapsedUsec(&txn->history->perf.io_usec, started);
+
+        if (success)
+        {
+            if (!prefetched)
+            {
+                txn->state_data.send.cached_pos += status;
+            }
+            CF_CFDP_SendFd(txn, ph); /* CF_CFDP_SendFd only returns CFE_SUCCESS */
+
+            CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.sent.file_data_bytes += actual_bytes;
+            txn->history->perf.file_bytes += actual_bytes;
+            CF_Flow_Sent(peer, actual_bytes, (txn->state == CF_TxnState_S2));
+            if (txn->state == CF_TxnState_S2)
+            {
+                txn->state_data.send.s2.fc_in_flight += actual_bytes;
+            }
+            CF_Assert((foffs + actual_bytes) <= txn->fsize); /* sanity check */
+            if (calc_crc)
+            {
+                /* the checksum of a shared file is worked out by its group as it is read */
+                if (!txn->fanout)
+                {
+                    OS_GetLocalTime(&started);
+                    CF_CRC_Digest(&txn->crc, fd->data_ptr, fd->data_len);
+                    CF_AddElapsedUsec(&txn->history->perf.crc_usec, started);
+                }
+            }
+            else
+            {
+                /* only a NAK response re-reads data that was already sent */
+                txn->history->perf.retx_bytes += actual_bytes;
+            }
+
+            ret = actual_bytes;
+        }
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_s.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_S_SubstateSendFileData(CF_Transaction_t *txn)
+{
+    int32 bytes_processed;
+
+    if (txn->flags.tx.follow && txn->foffs == txn->fsize)
+    {
+        /* caught up with a file still being written */
+        CF_CFDP_S_FollowFile(txn);
+    }
+    else if (txn->flags.tx.compressing && txn->foffs == txn->fsize)
+    {
+        /* all that is compressed so far is sent, so the next block of the file is compressed */
+        if (!CF_CFDP_S_CompressChunk(txn))
+        {
+            CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_FILESTORE_REJECTION);
+            txn->state_data.send.sub_state = CF_TxSubState_EOF;
+        }
+        else if (!txn->flags.tx.compressing && txn->foffs == txn->fsize)
+        {
+            /* nothing was left to compress */
+            txn->state_data.send.sub_state = CF_TxSubState_EOF;
+        }
+    }
+    else
+    {
+        bytes_processed = CF_CFDP_S_SendFileData(txn, txn->foffs, (txn->fsize - txn->foffs), 1);
+
+        if (bytes_processed > 0)
+        {
+            txn->foffs += bytes_processed;
+            if (txn->foffs == txn->fsize && !txn->flags.tx.follow && !txn->flags.tx.compressing)
+            {
+                /* file is done */
+                txn->state_data.send.sub_state = CF_TxSubState_EOF;
+            }
+        }
+        else if (bytes_processed < 0)
+        {
+            /* IO error -- change state and send EOF */
+            CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_FILESTORE_REJECTION);
+            txn->state_data.send.sub_state = CF_TxSubState_EOF;
+        }
+        else
+        {
+            /* don't care about other cases */
+        }
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_CFDP_S_SetFollowWait(CF_Transaction_t *txn, bool wait)
+{
+    if (txn->flags.tx.follow_wait != wait)
+    {
+        /* a followed file with nothing new waits on TXW, where CF_CFDP_S_Tick() checks it again,
+         * so the transactions behind it on TXA and PEND can use the channel meanwhile */
+        txn->flags.tx.follow_wait = wait;
+        CF_DequeueTransaction(txn);
+        CF_InsertSortPrio(txn, wait ? CF_QueueIdx_TXW : CF_QueueIdx_TXA);
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_s.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_S_FollowFile(CF_Transaction_t *txn)
+{
+    OS_time_t now;
+    int32     status;
+    bool      wait = false;
+
+    OS_GetLocalTime(&now);
+
+    status = CF_WrappedLseek(txn->fd, 0, OS_SEEK_END);
+    if (status < 0)
+    {
+        CFE_EVS_SendEvent(CF_CFDP_S_SEEK_END_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "CF S%d(%lu:%lu): failed to seek end file %s, error=%ld", (txn->state == CF_TxnState_S2),
+                          (unsigned long)txn->history->src_eid, (unsigned long)txn->history->seq_num,
+                          txn->history->fnames.src_filename, (long)status);
+        ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_seek;
+        CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_FILESTORE_REJECTION);
+        txn->state_data.send.sub_state = CF_TxSubState_EOF;
+    }
+    else if ((uint32)status < txn->fsize)
+    {
+        /* data already sent, and digested into the checksum, is gone */
+        CFE_EVS_SendEvent(CF_CFDP_S_FOLLOW_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "CF S%d(%lu:%lu): followed file %s shrank from %lu to %lu", (txn->state == CF_TxnState_S2),
+                          (unsigned long)txn->history->src_eid, (unsigned long)txn->history->seq_num,
+                          txn->history->fnames.src_filename, (unsigned long)txn->fsize, (unsigned long)status);
+        ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_size_mismatch;
+        CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_FILE_SIZE_ERROR);
+        txn->state_data.send.sub_state = CF_TxSubState_EOF;
+    }
+    else if ((uint32)status > txn->fsize)
+    {
+        /* the seek left the position at the end, so the next read seeks back */
+        txn->fsize                       = status;
+        txn->state_data.send.cached_pos  = status;
+        txn->state_data.send.follow_time = now;
+    }
+    else if (OS_TimeGetTotalSeconds(OS_TimeSubtract(now, txn->state_data.send.follow_time)) >=
+             CF_AppData.config_table->chan[txn->chan_num].tx_follow_quiet_s)
+    {
+        /* quiet for long enough, so the file is taken as finished and its size goes in the EOF */
+        txn->state_data.send.cached_pos = status;
+        txn->state_data.send.sub_state  = CF_TxSubState_EOF;
+    }
+    else
+    {
+        /* nothing new yet, so step aside until the next wakeup */
+        txn->state_data.send.cached_pos = status;
+        wait                            = true;
+        CF_TRACE(CF_TraceEvent_STALL, txn->chan_num, (uint32)txn->history->seq_num, CF_TraceStall_FOLLOW, 0,
+                 txn->foffs, 0);
+    }
+
+    CF_CFDP_S_SetFollowWait(txn, wait);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_s.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_S2_SubstateSkipFileData(CF_Transaction_t *txn)
+{
+    uint8     buf[CF_R2_CRC_CHUNK_SIZE];
+    uint32    count_bytes = 0;
+    uint32    read_size;
+    int32     status;
+    bool      success = true;
+    OS_time_t started;
+
+    OS_GetLocalTime(&started);
+
+    if (txn->fanout)
+    {
+        /* the group covers this data in the checksum itself, so nothing needs to be read here */
+        txn->foffs = txn->state_data.send.s2.skip_to;
+    }
+
+    /* the receiver already holds this data, but the EOF checksum still has to cover it */
+    while (success && txn->foffs < txn->state_data.send.s2.skip_to &&
+           count_bytes < CF_AppData.config_table->rx_crc_calc_bytes_per_wakeup)
+    {
+        read_size = txn->state_data.send.s2.skip_to - txn->foffs;
+        if (read_size > sizeof(buf))
+        {
+            read_size = sizeof(buf);
+        }
+
+        if (txn->state_data.send.cached_pos != txn->foffs)
+        {
+            status = CF_WrappedLseek(txn->fd, txn->foffs, OS_SEEK_SET);
+            if (status != txn->foffs)
+            {
+                CFE_EVS_SendEvent(CF_CFDP_S_SEEK_FD_ERR_EID, CFE_EVS_EventType_ERROR,
+                                  "CF S%d(%lu:%lu): error seeking to offset %ld, got %ld",
+                                  (txn->state == CF_TxnState_S2), (unsigned long)txn->history->src_eid,
+                                  (unsigned long)txn->history->seq_num, (long)txn->foffs, (long)status);
+                ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_seek;
+                success = false;
+                break;
+            }
+            txn->state_data.send.cached_pos = txn->foffs;
+        }
+
+        status = CF_WrappedRead(txn->fd, buf, read_size);
+        if (status != read_size)
+        {
+            CFE_EVS_SendEvent(CF_CFDP_S_READ_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "CF S%d(%lu:%lu): error reading bytes: expected %ld, got %ld",
+                              (txn->state == CF_TxnState_S2), (unsigned long)txn->history->src_eid,
+                              (unsigned long)txn->history->seq_num, (long)read_size, (long)status);
+            ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_read;
+            success = false;
+            break;
+        }
+
+        CF_CRC_Digest(&txn->crc, buf, read_size);
+        txn->state_data.send.cached_pos += read_size;
+        txn->foffs += read_size;
+        count_bytes += read_size;
+    }
+
+    CF_AddElapsedUsec(&txn->history->perf.crc_usec, started);
+
+    if (!success)
+    {
+        /* IO error -- change state and send EOF */
+        CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_FILESTORE_REJECTION);
+        txn->state_data.send.sub_state = CF_TxSubState_EOF;
+    }
+    else if (txn->foffs == txn->fsize)
+    {
+        /* file is done */
+        txn->state_data.send.sub_state = CF_TxSubState_EOF;
+    }
+    else if (txn->foffs < txn->state_data.send.s2.skip_to)
+    {
+        /* the reading for this wakeup is used up, pick up from here next time */
+        CF_AppData.engine.channels[txn->chan_num].cur = txn;
+    }
+    else
+    {
+        /* new file data to send follows straight on */
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_s.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_CFDP_S_CheckAndRespondNak(CF_Transaction_t *txn)
+{
+    const CF_Chunk_t *chunk;
+    CFE_Status_t      sret;
+    CFE_Status_t      ret = CFE_SUCCESS;
+
+    if (txn->flags.tx.md_need_send)
+    {
+        sret = CF_CFDP_SendMd(txn);
+        if (sret == CF_SEND_PDU_ERROR)
+        {
+            ret = CF_ERROR; /* error occurred */
+        }
+        else
+        {
+            if (sret == CFE_SUCCESS)
+            {
+                txn->flags.tx.md_need_send = false;
+            }
+            /* unless CF_SEND_PDU_ERROR, return 1 to keep caller from sending file data */
+            ret = 1; /* 1 means nak processed, so don't send filedata */
+        }
+    }
+    else
+    {
+        /* Get first chunk and process if available */
+        chunk = CF_ChunkList_GetFirstChunk(&txn->chunks->chunks);
+        if (chunk != NULL)
+        {
+            ret = CF_CFDP_S_SendFileData(txn, chunk->offset, chunk->size, 0);
+            if (ret > 0)
+            {
+                CF_ChunkList_RemoveFromFirst(&txn->chunks->chunks, ret);
+                ret = 1; /* processed nak, so caller doesn't send file data */
+            }
+            else if (ret < 0)
+            {
+                ret = CF_ERROR; /* error occurred */
+            }
+            else
+            {
+                /* nothing to do if ret==0, since nothing was sent */
+            }
+        }
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_s.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_S2_SubstateSendFileData(CF_Transaction_t *txn)
+{
+    uint32 prompt_nak_bytes = CF_AppData.config_table->chan[txn->chan_num].prompt_nak_bytes;
+    uint32 prompt_nak_s     = CF_AppData.config_table->chan[txn->chan_num].prompt_nak_s;
+    int    ret;
+
+    /* this runs for every PDU sent from TXA, but the prompt timer counts wakeups, so tick it once per cycle */
+    if (prompt_nak_s && txn->state_data.send.s2.prompt_cycle != CF_AppData.engine.cycle_num)
+    {
+        txn->state_data.send.s2.prompt_cycle = CF_AppData.engine.cycle_num;
+
+        if (CF_Timer_Expired(&txn->state_data.send.s2.prompt_timer))
+        {
+            txn->flags.tx.send_prompt = true;
+            CF_Timer_InitRelSec(&txn->state_data.send.s2.prompt_timer, prompt_nak_s);
+        }
+        else
+        {
+            CF_Timer_Tick(&txn->state_data.send.s2.prompt_timer);
+        }
+    }
+
+    if (txn->flags.tx.send_prompt)
+    {
+        /* the prompt goes out ahead of any more file data, if no buffer try again next cycle */
+        if (CF_CFDP_SendPrompt(txn, CF_CFDP_PromptResponse_NAK) == CFE_SUCCESS)
+        {
+            txn->flags.tx.send_prompt            = false;
+            txn->state_data.send.s2.prompt_foffs = txn->foffs;
+        }
+    }
+    else
+    {
+        ret = CF_CFDP_S_CheckAndRespondNak(txn);
+
+        if (!ret)
+        {
+            if (txn->foffs < txn->state_data.send.s2.skip_to)
+            {
+                CF_CFDP_S2_SubstateSkipFileData(txn);
+            }
+            else
+            {
+                CF_CFDP_S_SubstateSendFileData(txn);
+            }
+
+            if (prompt_nak_bytes && txn->state == CF_TxnState_S2 &&
+                txn->state_data.send.sub_state == CF_TxSubState_FILEDATA &&
+                (txn->foffs - txn->state_data.send.s2.prompt_foffs) >= prompt_nak_bytes)
+            {
+                txn->flags.tx.send_prompt = true;
+            }
+        }
+        else if (ret < 0)
+        {
+            CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_NAK_RESPONSE_ERROR);
+            CF_CFDP_S_Reset(txn);
+        }
+        else
+        {
+            /* don't care about other cases */
+        }
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_s.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_CFDP_S_CheckDelivered(CF_Transaction_t *txn)
+{
+    uint8     buf[CF_R2_CRC_CHUNK_SIZE];
+    uint32    count_bytes = 0;
+    uint32    read_size;
+    int32     status;
+    bool      success = true;
+    CF_Crc_t  crc;
+    OS_time_t started;
+
+    OS_GetLocalTime(&started);
+
+    /* the file was left at the start when it was opened, so it is read straight through */
+    while (success && txn->state_data.send.cached_pos < txn->fsize &&
+           count_bytes < CF_AppData.config_table->rx_crc_calc_bytes_per_wakeup)
+    {
+        read_size = txn->fsize - txn->state_data.send.cached_pos;
+        if (read_size > sizeof(buf))
+        {
+            read_size = sizeof(buf);
+        }
+
+        status = CF_WrappedRead(txn->fd, buf, read_size);
+        if (status != read_size)
+        {
+            CFE_EVS_SendEvent(CF_CFDP_S_READ_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "CF S%d(%lu:%lu): error reading bytes: expected %ld, got %ld",
+                              (txn->state == CF_TxnState_S2), (unsigned long)txn->history->src_eid,
+                              (unsigned long)txn->history->seq_num, (long)read_size, (long)status);
+            ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_read;
+            success = false;
+        }
+        else
+        {
+            CF_CRC_Digest(&txn->crc, buf, read_size);
+            txn->state_data.send.cached_pos += read_size;
+            count_bytes += read_size;
+        }
+    }
+
+    CF_AddElapsedUsec(&txn->history->perf.crc_usec, started);
+
+    if (success && txn->state_data.send.cached_pos < txn->fsize)
+    {
+        /* the reading for this wakeup is used up, pick up from here next time */
+        CF_AppData.engine.channels[txn->chan_num].cur = txn;
+    }
+    else if (success)
+    {
+        txn->flags.tx.delivered_check = false;
+
+        crc = txn->crc;
+        CF_CRC_Finalize(&crc);
+        if (crc.result == txn->state_data.send.delivered_crc)
+        {
+            txn->crc                = crc;
+            txn->flags.com.crc_calc = true;
+            txn->flags.tx.delivered = true;
+        }
+        else
+        {
+            /* changed since it was delivered, so it is sent as usual, the file data seeks back to the start */
+            CF_CRC_Start(&txn->crc);
+        }
+    }
+    else
+    {
+        /* an error is handled by the caller */
+    }
+
+    return success;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static bool CF_CFDP_S_WantsCompress(const CF_Transaction_t *txn)
+{
+    bool wants;
+
+    if (txn->compress == CF_TxCompress_CHANNEL)
+    {
+        wants = CF_AppData.config_table->chan[txn->chan_num].tx_compress;
+    }
+    else
+    {
+        wants = (txn->compress == CF_TxCompress_ON);
+    }
+
+    return wants;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_s.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_CFDP_S_CompressStart(CF_Transaction_t *txn)
+{
+    osal_id_t zfd = OS_OBJECT_ID_UNDEFINED;
+    int32     status;
+    bool      success = true;
+    char      zname[OS_MAX_PATH_LEN];
+
+    status = CF_WrappedLseek(txn->fd, 0, OS_SEEK_SET);
+    if (status != 0)
+    {
+        CFE_EVS_SendEvent(CF_CFDP_S_SEEK_FD_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "CF S%d(%lu:%lu): error seeking to offset 0, got %ld", (txn->state == CF_TxnState_S2),
+                          (unsigned long)txn->history->src_eid, (unsigned long)txn->history->seq_num, (long)status);
+        ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_seek;
+        success = false;
+    }
+    else
+    {
+        CF_Compress_GetFilename(zname, sizeof(zname), txn->history->src_eid, txn->history->seq_num);
+        status = CF_WrappedOpenCreate(&zfd, zname, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_READ_WRITE);
+        if (status < 0)
+        {
+            CFE_EVS_SendEvent(CF_CFDP_S_COMPRESS_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "CF S%d(%lu:%lu): failed to open compression file %s, error=%ld",
+                              (txn->state == CF_TxnState_S2), (unsigned long)txn->history->src_eid,
+                              (unsigned long)txn->history->seq_num, zname, (long)status);
+            ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_open;
+            success = false;
+        }
+    }
+
+    if (success)
+    {
+        /* set now, so the temp file is removed however the transaction ends */
+        txn->flags.com.compressed = true;
+
+        /* the temp file is the one that is sent, and it grows as the original is read through zfd */
+        txn->zfd                        = txn->fd;
+        txn->fd                         = zfd;
+        txn->raw_size                   = txn->fsize;
+        txn->fsize                      = 0;
+        txn->zoffs                      = 0;
+        txn->state_data.send.cached_pos = 0;
+        CF_CRC_Start(&txn->crc);
+        CF_CRC_Start(&txn->zcrc);
+    }
+
+    return success;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_s.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_CFDP_S_CompressChunk(CF_Transaction_t *txn)
+{
+    CF_Compress_t *work = &CF_AppData.engine.compress;
+    uint32         read_size;
+    uint32         packed_size;
+    int32          status;
+    bool           success = true;
+    CF_Crc_t       crc;
+    OS_time_t      started;
+
+    read_size = txn->raw_size - txn->zoffs;
+    if (read_size > sizeof(work->raw))
+    {
+        read_size = sizeof(work->raw);
+    }
+
+    if (read_size)
+    {
+        status = CF_WrappedRead(txn->zfd, work->raw, read_size);
+        if (status != read_size)
+        {
+            CFE_EVS_SendEvent(CF_CFDP_S_READ_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "CF S%d(%lu:%lu): error reading bytes: expected %ld, got %ld",
+                              (txn->state == CF_TxnState_S2), (unsigned long)txn->history->src_eid,
+                              (unsigned long)txn->history->seq_num, (long)read_size, (long)status);
+            ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_read;
+            success = false;
+        }
+    }
+
+    if (success && read_size)
+    {
+        OS_GetLocalTime(&started);
+        CF_CRC_Digest(&txn->zcrc, work->raw, read_size);
+        CF_AddElapsedUsec(&txn->history->perf.crc_usec, started);
+
+        OS_GetLocalTime(&started);
+        packed_size = CF_Compress_Pack(work, work->raw, read_size, work->packed);
+        CF_AddElapsedUsec(&txn->history->perf.zip_usec, started);
+
+        /* sending reads the temp file too, so the block is put back at the end of it */
+        if (txn->state_data.send.cached_pos != txn->fsize)
+        {
+            status = CF_WrappedLseek(txn->fd, txn->fsize, OS_SEEK_SET);
+            if (status != txn->fsize)
+            {
+                CFE_EVS_SendEvent(CF_CFDP_S_SEEK_FD_ERR_EID, CFE_EVS_EventType_ERROR,
+                                  "CF S%d(%lu:%lu): error seeking to offset %ld, got %ld",
+                                  (txn->state == CF_TxnState_S2), (unsigned long)txn->history->src_eid,
+                                  (unsigned long)txn->history->seq_num, (long)txn->fsize, (long)status);
+                ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_seek;
+                success = false;
+            }
+            else
+            {
+                txn->state_data.send.cached_pos = txn->fsize;
+            }
+        }
+
+        if (success)
+        {
+            status = CF_WrappedWrite(txn->fd, work->packed, packed_size);
+            if (status != packed_size)
+            {
+                CFE_EVS_SendEvent(CF_CFDP_S_COMPRESS_ERR_EID, CFE_EVS_EventType_ERROR,
+                                  "CF S%d(%lu:%lu): error writing compression file: expected %ld, got %ld",
+                                  (txn->state == CF_TxnState_S2), (unsigned long)txn->history->src_eid,
+                                  (unsigned long)txn->history->seq_num, (long)packed_size, (long)status);
+                ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_write;
+                success = false;
+            }
+            else
+            {
+                txn->state_data.send.cached_pos += packed_size;
+                txn->fsize += packed_size;
+                txn->zoffs += read_size;
+            }
+        }
+    }
+
+    if (success && txn->zoffs == txn->raw_size)
+    {
+        /* the checksum of the original is kept for the delivered index, the EOF one covers what is sent */
+        crc = txn->zcrc;
+        CF_CRC_Finalize(&crc);
+        txn->state_data.send.raw_crc = crc.result;
+
+        /* all read, so the original is no longer needed, and the size sent in the EOF is final */
+        CF_WrappedClose(txn->zfd);
+        txn->zfd                  = OS_OBJECT_ID_UNDEFINED;
+        txn->flags.tx.compressing = false;
+    }
+
+    return success;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_s.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_CFDP_S_DeltaChunk(CF_Transaction_t *txn)
+{
+    CF_Delta_t *     delta       = &CF_AppData.engine.delta;
+    uint32           count_bytes = 0;
+    uint32           read_size;
+    int32            status;
+    bool             success = true;
+    bool             done    = false;
+    char             fname[OS_MAX_PATH_LEN];
+    CF_DeltaHeader_t hdr;
+    CF_Crc_t         crc;
+    OS_time_t        started;
+
+    if (delta->owner == NULL)
+    {
+        CF_Delta_Start(delta, txn);
+        txn->zoffs = 0;
+
+        CF_Delta_GetSigFilename(fname, sizeof(fname), txn->history->peer_eid, txn->history->fnames.dst_filename);
+        if ((txn->fsize / CF_DELTA_BLOCK_SIZE) > CF_DELTA_MAX_BLOCKS)
+        {
+            /* too big to sign, so this and the next send of it are whole */
+            CF_WrappedRemove(fname);
+            delta->owner = NULL;
+        }
+        else if (CF_Delta_LoadSigs(delta, fname))
+        {
+            CF_Delta_GetFilename(fname, sizeof(fname), txn->history->src_eid, txn->history->seq_num,
+                                 CF_DELTA_TEMP_EXT);
+            status = CF_WrappedOpenCreate(&txn->zfd, fname, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_READ_WRITE);
+            if (status < 0)
+            {
+                CFE_EVS_SendEvent(CF_CFDP_S_DELTA_ERR_EID, CFE_EVS_EventType_ERROR,
+                                  "CF S%d(%lu:%lu): failed to open delta file %s, error=%ld",
+                                  (txn->state == CF_TxnState_S2), (unsigned long)txn->history->src_eid,
+                                  (unsigned long)txn->history->seq_num, fname, (long)status);
+                ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_open;
+                txn->zfd = OS_OBJECT_ID_UNDEFINED; /* just in case */
+                success  = false;
+            }
+            else
+            {
+                /* set now, so the temp file is removed however the transaction ends */
+                txn->flags.com.delta = true;
+                CF_CRC_Start(&txn->crc);
+
+                /* room for the header, which is written once the checksum is known */
+                memset(delta->out, 0, CF_DELTA_HDR_SIZE);
+                delta->out_len = CF_DELTA_HDR_SIZE;
+            }
+        }
+        else
+        {
+            /* no earlier delivery to match against, only the signatures are made */
+        }
+    }
+
+    while (success && !done && delta->owner == txn &&
+           count_bytes < CF_AppData.config_table->rx_crc_calc_bytes_per_wakeup)
+    {
+        read_size = CF_Delta_Shift(delta);
+        if (read_size > (txn->fsize - txn->zoffs))
+        {
+            read_size = txn->fsize - txn->zoffs;
+        }
+
+        if (read_size)
+        {
+            if (txn->state_data.send.cached_pos != txn->zoffs)
+            {
+                status = CF_WrappedLseek(txn->fd, txn->zoffs, OS_SEEK_SET);
+                if (status != txn->zoffs)
+                {
+                    CFE_EVS_SendEvent(CF_CFDP_S_SEEK_FD_ERR_EID, CFE_EVS_EventType_ERROR,
+                                      "CF S%d(%lu:%lu): error seeking to offset %ld, got %ld",
+                                      (txn->state == CF_TxnState_S2), (unsigned long)txn->history->src_eid,
+                                      (unsigned long)txn->history->seq_num, (long)txn->zoffs, (long)status);
+                    ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_seek;
+                    success = false;
+                    break;
+                }
+                txn->state_data.send.cached_pos = txn->zoffs;
+            }
+
+            status = CF_WrappedRead(txn->fd, &delta->buf[delta->buf_len], read_size);
+            if (status != read_size)
+            {
+                CFE_EVS_SendEvent(CF_CFDP_S_READ_ERR_EID, CFE_EVS_EventType_ERROR,
+                                  "CF S%d(%lu:%lu): error reading bytes: expected %ld, got %ld",
+                                  (txn->state == CF_TxnState_S2), (unsigned long)txn->history->src_eid,
+                                  (unsigned long)txn->history->seq_num, (long)read_size, (long)status);
+                ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_read;
+                success = false;
+                break;
+            }
+            txn->state_data.send.cached_pos += read_size;
+
+            if (txn->flags.com.delta)
+            {
+                OS_GetLocalTime(&started);
+                CF_CRC_Digest(&txn->crc, &delta->buf[delta->buf_len], read_size);
+                CF_AddElapsedUsec(&txn->history->perf.crc_usec, started);
+            }
+
+            delta->buf_len += read_size;
+            txn->zoffs += read_size;
+            count_bytes += read_size;
+        }
+
+        OS_GetLocalTime(&started);
+        CF_Delta_AddSigs(delta);
+        done = CF_Delta_Encode(delta, txn->fsize);
+        CF_AddElapsedUsec(&txn->history->perf.zip_usec, started);
+
+        if (delta->out_len)
+        {
+            status = CF_WrappedWrite(txn->zfd, delta->out, delta->out_len);
+            if (status != delta->out_len)
+            {
+                CFE_EVS_SendEvent(CF_CFDP_S_DELTA_ERR_EID, CFE_EVS_EventType_ERROR,
+                                  "CF S%d(%lu:%lu): error writing delta file: expected %ld, got %ld",
+                                  (txn->state == CF_TxnState_S2), (unsigned long)txn->history->src_eid,
+                                  (unsigned long)txn->history->seq_num, (long)delta->out_len, (long)status);
+                ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_write;
+                success = false;
+                break;
+            }
+            delta->out_len = 0;
+        }
+    }
+
+    if (success && !done && delta->owner != NULL)
+    {
+        /* the reading for this wakeup is used up, or another send holds the work area */
+        CF_AppData.engine.channels[txn->chan_num].cur = txn;
+    }
+    else if (success)
+    {
+        if (delta->owner == txn)
+        {
+            /* the signatures are only kept for the next send if this one is delivered */
+            CF_Delta_GetFilename(fname, sizeof(fname), txn->history->src_eid, txn->history->seq_num,
+                                 CF_DELTA_SIG_EXT);
+            if (CF_Delta_SaveSigs(delta, fname, txn->fsize) == CFE_SUCCESS)
+            {
+                txn->flags.tx.delta_sigs = true;
+            }
+            else
+            {
+                CFE_EVS_SendEvent(CF_CFDP_S_DELTA_ERR_EID, CFE_EVS_EventType_ERROR,
+                                  "CF S%d(%lu:%lu): failed to write block signatures %s, next send is whole",
+                                  (txn->state == CF_TxnState_S2), (unsigned long)txn->history->src_eid,
+                                  (unsigned long)txn->history->seq_num, fname);
+                CF_WrappedRemove(fname);
+            }
+
+            delta->owner = NULL;
+        }
+
+        if (txn->flags.com.delta)
+        {
+            /* the checksum of the original is kept for the delivered index, the EOF one covers what is sent */
+            crc = txn->crc;
+            CF_CRC_Finalize(&crc);
+            txn->state_data.send.raw_crc = crc.result;
+
+            hdr.raw_size   = txn->fsize;
+            hdr.raw_crc    = crc.result;
+            hdr.base_size  = delta->base_size;
+            hdr.block_size = CF_DELTA_BLOCK_SIZE;
+            CF_Delta_PutHeader(delta->out, &hdr);
+
+            status = CF_WrappedLseek(txn->zfd, 0, OS_SEEK_SET);
+            if (status == 0)
+            {
+                status = CF_WrappedWrite(txn->zfd, delta->out, CF_DELTA_HDR_SIZE);
+            }
+            if (status == CF_DELTA_HDR_SIZE)
+            {
+                status = CF_WrappedLseek(txn->zfd, 0, OS_SEEK_END);
+            }
+            if (status < CF_DELTA_HDR_SIZE)
+            {
+                CFE_EVS_SendEvent(CF_CFDP_S_DELTA_ERR_EID, CFE_EVS_EventType_ERROR,
+                                  "CF S%d(%lu:%lu): failed to write delta header, error=%ld",
+                                  (txn->state == CF_TxnState_S2), (unsigned long)txn->history->src_eid,
+                                  (unsigned long)txn->history->seq_num, (long)status);
+                ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_write;
+                success = false;
+            }
+            else
+            {
+                /* from here on the delta is the file that is sent */
+                CF_CRC_Start(&txn->crc);
+                CF_WrappedClose(txn->fd);
+                txn->fd                         = txn->zfd;
+                txn->zfd                        = OS_OBJECT_ID_UNDEFINED;
+                txn->raw_size                   = txn->fsize;
+                txn->fsize                      = status;
+                txn->state_data.send.cached_pos = status;
+            }
+        }
+        else
+        {
+            txn->state_data.send.cached_pos = txn->zoffs;
+            txn->flags.tx.compressing       = CF_CFDP_S_WantsCompress(txn);
+        }
+
+        txn->flags.tx.delta_encoding = false;
+    }
+    else
+    {
+        /* an error is handled by the caller */
+    }
+
+    return success;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_s.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_S_DeltaReset(CF_Transaction_t *txn)
+{
+    char sname[OS_MAX_PATH_LEN];
+    char pending[OS_MAX_PATH_LEN];
+    bool delivered;
+
+    if (CF_AppData.engine.delta.owner == txn)
+    {
+        CF_AppData.engine.delta.owner = NULL;
+    }
+
+    if (txn->flags.tx.delta_sigs || txn->flags.com.delta)
+    {
+        delivered = (txn->state == CF_TxnState_S2 && txn->history->txn_stat == CF_TxnStatus_NO_ERROR &&
+                     txn->flags.com.crc_calc);
+
+        CF_Delta_GetSigFilename(sname, sizeof(sname), txn->history->peer_eid, txn->history->fnames.dst_filename);
+        CF_Delta_GetFilename(pending, sizeof(pending), txn->history->src_eid, txn->history->seq_num,
+                             CF_DELTA_SIG_EXT);
+
+        if (txn->flags.tx.delta_sigs && delivered)
+        {
+            if (CF_WrappedRename(pending, sname) != OS_SUCCESS)
+            {
+                CFE_EVS_SendEvent(CF_CFDP_S_DELTA_ERR_EID, CFE_EVS_EventType_ERROR,
+                                  "CF S%d(%lu:%lu): failed to keep block signatures %s, next send is whole",
+                                  (txn->state == CF_TxnState_S2), (unsigned long)txn->history->src_eid,
+                                  (unsigned long)txn->history->seq_num, sname);
+                CF_WrappedRemove(pending);
+                CF_WrappedRemove(sname);
             }
         }
-
-        if (success)
+        else
         {
-            txn->state_data.send.cached_pos += status;
-            CF_CFDP_SendFd(txn, ph); /* CF_CFDP_SendFd only returns CFE_SUCCESS */
-
-            CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.sent.file_data_bytes += actual_bytes;
-            CF_Assert((foffs + actual_bytes) <= txn->fsize); /* sanity check */
-            if (calc_crc)
+            if (txn->flags.tx.delta_sigs)
             {
-                CF_CRC_Digest(&txn->crc, fd->data_ptr, fd->data_len);
+                CF_WrappedRemove(pending);
+            }
+            if (txn->flags.com.delta)
+            {
+                /* the copy at the far end may no longer match the signatures */
+                CF_WrappedRemove(sname);
             }
-
-            ret = actual_bytes;
         }
-    }
 
-    return ret;
+        txn->flags.tx.delta_sigs = false;
+    }
 }
 
 /*----------------------------------------------------------------
  *
- * Application-scope internal function
- * See description in cf_cfdp_s.h for argument/return detail
+ * Internal helper routine only, not part of API.
  *
  *-----------------------------------------------------------------*/
-void CF_CFDP_S_SubstateSendFileData(CF_Transaction_t *txn)
+static void CF_CFDP_S_BundleSettle(CF_Transaction_t *txn, const char *name)
 {
-    int32 bytes_processed = CF_CFDP_S_SendFileData(txn, txn->foffs, (txn->fsize - txn->foffs), 1);
+    char path[OS_MAX_PATH_LEN];
 
-    if (bytes_processed > 0)
-    {
-        txn->foffs += bytes_processed;
-        if (txn->foffs == txn->fsize)
-        {
-            /* file is done */
-            txn->state_data.send.sub_state = CF_TxSubState_EOF;
-        }
-    }
-    else if (bytes_processed < 0)
+    snprintf(path, sizeof(path), "%.*s/%s", CF_FILENAME_MAX_PATH - 1, txn->pb->fnames.src_filename, name);
+
+    /* each file goes where it would have gone had it been sent alone */
+    if (!CF_TxnStatus_IsError(txn->history->txn_stat))
     {
-        /* IO error -- change state and send EOF */
-        CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_FILESTORE_REJECTION);
-        txn->state_data.send.sub_state = CF_TxSubState_EOF;
+        CF_CFDP_MoveFile(path, CF_AppData.config_table->chan[txn->chan_num].move_dir);
     }
-    else
+    else if (CF_CFDP_IsPollingDir(path, txn->chan_num))
     {
-        /* don't care about other cases */
+        CF_CFDP_MoveFile(path, CF_AppData.config_table->fail_dir);
     }
 }
 
@@ -246,78 +1246,128 @@ void CF_CFDP_S_SubstateSendFileData(CF_Transaction_t *txn)
  * See description in cf_cfdp_s.h for argument/return detail
  *
  *-----------------------------------------------------------------*/
-CFE_Status_t CF_CFDP_S_CheckAndRespondNak(CF_Transaction_t *txn)
+void CF_CFDP_S_BundleReset(CF_Transaction_t *txn)
 {
-    const CF_Chunk_t *chunk;
-    CFE_Status_t      sret;
-    CFE_Status_t      ret = CFE_SUCCESS;
-
-    if (txn->flags.tx.md_need_send)
-    {
-        sret = CF_CFDP_SendMd(txn);
-        if (sret == CF_SEND_PDU_ERROR)
-        {
-            ret = CF_ERROR; /* error occurred */
-        }
-        else
-        {
-            if (sret == CFE_SUCCESS)
-            {
-                txn->flags.tx.md_need_send = false;
-            }
-            /* unless CF_SEND_PDU_ERROR, return 1 to keep caller from sending file data */
-            ret = 1; /* 1 means nak processed, so don't send filedata */
-        }
-    }
-    else
+    uint8 *          buf = CF_AppData.engine.bundle.buf;
+    CF_BundleEntry_t entry;
+    osal_id_t        fd;
+    int32            fsize;
+    int32            len;
+    uint32           count   = 0;
+    uint32           pos     = 0;
+    uint32           i       = 0;
+    uint32           used;
+    uint32           n;
+    bool             indexed = false;
+
+    if (txn->flags.com.bundle && txn->pb && !txn->pb->keep)
     {
-        /* Get first chunk and process if available */
-        chunk = CF_ChunkList_GetFirstChunk(&txn->chunks->chunks);
-        if (chunk != NULL)
+        if (CF_WrappedOpenCreate(&fd, txn->history->fnames.src_filename, OS_FILE_FLAG_NONE, OS_READ_ONLY) >= 0)
         {
-            ret = CF_CFDP_S_SendFileData(txn, chunk->offset, chunk->size, 0);
-            if (ret > 0)
-            {
-                CF_ChunkList_RemoveFromFirst(&txn->chunks->chunks, ret);
-                ret = 1; /* processed nak, so caller doesn't send file data */
-            }
-            else if (ret < 0)
+            fsize = CF_WrappedLseek(fd, 0, OS_SEEK_END);
+            if (fsize >= CF_BUNDLE_TRAILER_SIZE &&
+                CF_WrappedLseek(fd, fsize - CF_BUNDLE_TRAILER_SIZE, OS_SEEK_SET) == (fsize - CF_BUNDLE_TRAILER_SIZE) &&
+                CF_WrappedRead(fd, buf, CF_BUNDLE_TRAILER_SIZE) == CF_BUNDLE_TRAILER_SIZE)
             {
-                ret = CF_ERROR; /* error occurred */
+                indexed = CF_Bundle_ParseTrailer(buf, fsize, &count, &pos);
             }
-            else
+
+            /* the index is read a buffer at a time, taking each entry that is wholly in it */
+            while (indexed && i < count)
             {
-                /* nothing to do if ret==0, since nothing was sent */
+                len = (fsize - CF_BUNDLE_TRAILER_SIZE) - pos;
+                if (len > (int32)CF_BUNDLE_BUF_SIZE)
+                {
+                    len = CF_BUNDLE_BUF_SIZE;
+                }
+
+                used = 0;
+                if (CF_WrappedLseek(fd, pos, OS_SEEK_SET) == (int32)pos && CF_WrappedRead(fd, buf, len) == len)
+                {
+                    while (i < count && (n = CF_Bundle_ParseEntry(&buf[used], len - used, &entry)) != 0)
+                    {
+                        CF_CFDP_S_BundleSettle(txn, entry.name);
+                        used += n;
+                        ++i;
+                    }
+                }
+
+                indexed = (used != 0);
+                pos += used;
             }
+
+            CF_WrappedClose(fd);
+        }
+
+        if (!indexed)
+        {
+            CFE_EVS_SendEvent(CF_CFDP_BUNDLE_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "CF S%d(%lu:%lu): failed to read bundle index, its files are left in place",
+                              (txn->state == CF_TxnState_S2), (unsigned long)txn->history->src_eid,
+                              (unsigned long)txn->history->seq_num);
         }
     }
 
-    return ret;
+    if (txn->flags.com.bundle)
+    {
+        CF_WrappedRemove(txn->history->fnames.src_filename);
+    }
 }
 
 /*----------------------------------------------------------------
  *
- * Application-scope internal function
- * See description in cf_cfdp_s.h for argument/return detail
+ * Internal helper routine only, not part of API.
  *
  *-----------------------------------------------------------------*/
-void CF_CFDP_S2_SubstateSendFileData(CF_Transaction_t *txn)
+static bool CF_CFDP_S_OpenFile(CF_Transaction_t *txn)
 {
-    int ret = CF_CFDP_S_CheckAndRespondNak(txn);
+    int32 ret;
+    int   status  = 0;
+    bool  success = true;
 
-    if (!ret)
+    ret = CF_WrappedOpenCreate(&txn->fd, txn->history->fnames.src_filename, OS_FILE_FLAG_NONE, OS_READ_ONLY);
+    if (ret < 0)
     {
-        CF_CFDP_S_SubstateSendFileData(txn);
+        CFE_EVS_SendEvent(CF_CFDP_S_OPEN_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "CF S%d(%lu:%lu): failed to open file %s, error=%ld", (txn->state == CF_TxnState_S2),
+                          (unsigned long)txn->history->src_eid, (unsigned long)txn->history->seq_num,
+                          txn->history->fnames.src_filename, (long)ret);
+        ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_open;
+        txn->fd = OS_OBJECT_ID_UNDEFINED; /* just in case */
+        success = false;
     }
-    else if (ret < 0)
+
+    if (success)
     {
-        CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_NAK_RESPONSE_ERROR);
-        CF_CFDP_S_Reset(txn);
+        status = CF_WrappedLseek(txn->fd, 0, OS_SEEK_END);
+        if (status < 0)
+        {
+            CFE_EVS_SendEvent(CF_CFDP_S_SEEK_END_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "CF S%d(%lu:%lu): failed to seek end file %s, error=%ld", (txn->state == CF_TxnState_S2),
+                              (unsigned long)txn->history->src_eid, (unsigned long)txn->history->seq_num,
+                              txn->history->fnames.src_filename, (long)status);
+            ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_seek;
+            success = false;
+        }
     }
-    else
+
+    if (success)
     {
-        /* don't care about other cases */
+        txn->fsize = status;
+
+        status = CF_WrappedLseek(txn->fd, 0, OS_SEEK_SET);
+        if (status != 0)
+        {
+            CFE_EVS_SendEvent(CF_CFDP_S_SEEK_BEG_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "CF S%d(%lu:%lu): failed to seek begin file %s, got %ld", (txn->state == CF_TxnState_S2),
+                              (unsigned long)txn->history->src_eid, (unsigned long)txn->history->seq_num,
+                              txn->history->fnames.src_filename, (long)status);
+            ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_seek;
+            success = false;
+        }
     }
+
+    return success;
 }
 
 /*----------------------------------------------------------------
@@ -328,14 +1378,23 @@ void CF_CFDP_S2_SubstateSendFileData(CF_Transaction_t *txn)
  *-----------------------------------------------------------------*/
 void CF_CFDP_S_SubstateSendMetadata(CF_Transaction_t *txn)
 {
-    CFE_Status_t sret;
-    int32        ret;
-    int          status  = 0;
-    bool         success = true;
+    const CF_DeliveredEntry_t *entry;
+    CFE_Status_t               sret;
+    bool                       success = true;
 
-    if (!OS_ObjectIdDefined(txn->fd))
+    if (txn->fanout)
+    {
+        /* the group opened the file for all of its destinations */
+        txn->fsize = txn->fanout->fsize;
+    }
+    else if (!OS_ObjectIdDefined(txn->fd) || txn->flags.tx.prefetched)
     {
-        if (OS_FileOpenCheck(txn->history->fnames.src_filename) == OS_SUCCESS)
+        if (txn->flags.tx.prefetched)
+        {
+            /* opened and sized while it was pending */
+            txn->flags.tx.prefetched = false;
+        }
+        else if (OS_FileOpenCheck(txn->history->fnames.src_filename) == OS_SUCCESS)
         {
             CFE_EVS_SendEvent(CF_CFDP_S_ALREADY_OPEN_ERR_EID, CFE_EVS_EventType_ERROR,
                               "CF S%d(%lu:%lu): file %s already open", (txn->state == CF_TxnState_S2),
@@ -344,56 +1403,88 @@ void CF_CFDP_S_SubstateSendMetadata(CF_Transaction_t *txn)
             ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_open;
             success = false;
         }
+        else
+        {
+            success = CF_CFDP_S_OpenFile(txn);
+        }
 
-        if (success)
+        if (success && txn->flags.tx.follow)
         {
-            ret = CF_WrappedOpenCreate(&txn->fd, txn->history->fnames.src_filename, OS_FILE_FLAG_NONE, OS_READ_ONLY);
-            if (ret < 0)
-            {
-                CFE_EVS_SendEvent(CF_CFDP_S_OPEN_ERR_EID, CFE_EVS_EventType_ERROR,
-                                  "CF S%d(%lu:%lu): failed to open file %s, error=%ld", (txn->state == CF_TxnState_S2),
-                                  (unsigned long)txn->history->src_eid, (unsigned long)txn->history->seq_num,
-                                  txn->history->fnames.src_filename, (long)ret);
-                ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_open;
-                txn->fd = OS_OBJECT_ID_UNDEFINED; /* just in case */
-                success = false;
-            }
+            /* the quiet period before the EOF starts from when the file is opened */
+            OS_GetLocalTime(&txn->state_data.send.follow_time);
         }
 
-        if (success)
+        /* a bundle is a temp file made for this one send, and the receiver unpacks it as it is,
+         * and a followed file has no final size to check it against or to encode it with */
+        if (success && txn->foffs == 0 && !txn->flags.com.bundle && !txn->flags.tx.follow &&
+            CF_AppData.config_table->chan[txn->chan_num].tx_skip_delivered)
         {
-            status = CF_WrappedLseek(txn->fd, 0, OS_SEEK_END);
-            if (status < 0)
+            entry = CF_Delivered_Find(txn->history->peer_eid, txn->history->fnames.dst_filename, txn->fsize);
+            if (entry)
             {
-                CFE_EVS_SendEvent(CF_CFDP_S_SEEK_END_ERR_EID, CFE_EVS_EventType_ERROR,
-                                  "CF S%d(%lu:%lu): failed to seek end file %s, error=%ld",
-                                  (txn->state == CF_TxnState_S2), (unsigned long)txn->history->src_eid,
-                                  (unsigned long)txn->history->seq_num, txn->history->fnames.src_filename,
-                                  (long)status);
-                ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_seek;
-                success = false;
+                /* same name, place and size as an earlier delivery, so the contents decide */
+                txn->flags.tx.delivered_check      = true;
+                txn->state_data.send.delivered_crc = entry->crc;
+
+                /* the file is read on from where it was left, so a first block read ahead goes in first */
+                if (txn->state_data.send.prefetch)
+                {
+                    CF_CRC_Digest(&txn->crc, txn->state_data.send.prefetch->data, txn->state_data.send.prefetch->size);
+                }
+                else
+                {
+                    txn->state_data.send.cached_pos = 0;
+                }
             }
         }
 
-        if (success)
+        if (success && txn->foffs == 0 && !txn->flags.com.bundle && !txn->flags.tx.follow &&
+            txn->state == CF_TxnState_S2 && CF_AppData.config_table->chan[txn->chan_num].tx_delta)
+        {
+            /* only class 2 knows the file arrived, which a delta needs to be made against it next time */
+            txn->flags.tx.delta_encoding = true;
+        }
+        else if (success && txn->foffs == 0 && !txn->flags.com.bundle && !txn->flags.tx.follow)
         {
-            txn->fsize = status;
+            txn->flags.tx.compressing = CF_CFDP_S_WantsCompress(txn);
+        }
 
-            status = CF_WrappedLseek(txn->fd, 0, OS_SEEK_SET);
-            if (status != 0)
-            {
-                CFE_EVS_SendEvent(CF_CFDP_S_SEEK_BEG_ERR_EID, CFE_EVS_EventType_ERROR,
-                                  "CF S%d(%lu:%lu): failed to seek begin file %s, got %ld",
-                                  (txn->state == CF_TxnState_S2), (unsigned long)txn->history->src_eid,
-                                  (unsigned long)txn->history->seq_num, txn->history->fnames.src_filename,
-                                  (long)status);
-                ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_seek;
-                success = false;
-            }
+        if (txn->flags.tx.delta_encoding || txn->flags.tx.compressing || txn->fsize == 0)
+        {
+            /* a first block read ahead is only any use if the file is sent as it is */
+            CF_CFDP_S_PrefetchRelease(txn);
         }
     }
 
-    if (success)
+    if (success && txn->flags.tx.delivered_check)
+    {
+        success = CF_CFDP_S_CheckDelivered(txn);
+    }
+
+    if (success && !txn->flags.tx.delivered && !txn->flags.tx.delivered_check && txn->flags.tx.delta_encoding)
+    {
+        /* as with compression, what is sent must be made before its size goes in the metadata */
+        success = CF_CFDP_S_DeltaChunk(txn);
+    }
+
+    if (success && !txn->flags.tx.delivered && !txn->flags.tx.delivered_check && !txn->flags.tx.delta_encoding &&
+        txn->flags.tx.compressing && !txn->flags.com.compressed)
+    {
+        /* the file is compressed a block at a time as it is sent, so the metadata gives no size */
+        success = CF_CFDP_S_CompressStart(txn);
+    }
+
+    if (success && txn->flags.tx.delivered)
+    {
+        CFE_EVS_SendEvent(CF_CFDP_S_DELIVERED_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "CF S%d(%lu:%lu): %s already delivered to %lu as %s, not sent",
+                          (txn->state == CF_TxnState_S2), (unsigned long)txn->history->src_eid,
+                          (unsigned long)txn->history->seq_num, txn->history->fnames.src_filename,
+                          (unsigned long)txn->history->peer_eid, txn->history->fnames.dst_filename);
+        CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_NO_ERROR);
+        CF_CFDP_S_Reset(txn);
+    }
+    else if (success && !txn->flags.tx.delivered_check && !txn->flags.tx.delta_encoding)
     {
         sret = CF_CFDP_SendMd(txn);
         if (sret == CF_SEND_PDU_ERROR)
@@ -406,8 +1497,24 @@ void CF_CFDP_S_SubstateSendMetadata(CF_Transaction_t *txn)
         }
         else if (sret == CFE_SUCCESS)
         {
-            /* once metadata is sent, switch to filedata mode */
-            txn->state_data.send.sub_state = CF_TxSubState_FILEDATA;
+            /* once metadata is sent, switch to filedata mode, unless resumed after all file data was sent */
+            if (txn->foffs != 0 && txn->foffs == txn->fsize)
+            {
+                txn->state_data.send.sub_state = CF_TxSubState_EOF;
+            }
+            else
+            {
+                txn->state_data.send.sub_state = CF_TxSubState_FILEDATA;
+
+                if (txn->state == CF_TxnState_S2)
+                {
+                    /* prompts during file data are counted from here */
+                    txn->state_data.send.s2.prompt_foffs = txn->foffs;
+                    txn->state_data.send.s2.prompt_cycle = CF_AppData.engine.cycle_num;
+                    CF_Timer_InitRelSec(&txn->state_data.send.s2.prompt_timer,
+                                        CF_AppData.config_table->chan[txn->chan_num].prompt_nak_s);
+                }
+            }
         }
         /* if sret==CF_SEND_PDU_NO_BUF_AVAIL_ERROR, then try to send md again next cycle */
     }
@@ -422,6 +1529,91 @@ void CF_CFDP_S_SubstateSendMetadata(CF_Transaction_t *txn)
     /*CF_CRC_Start(&txn->crc);*/
 }
 
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_s.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_CFDP_S_Prefetch(CF_Transaction_t *txn)
+{
+    CF_TxPrefetch_t *prefetch = NULL;
+    uint32           read_size;
+    int32            status;
+    bool             success;
+    int              i;
+
+    for (i = 0; i < CF_NUM_TX_PREFETCH_BUFFERS && !prefetch; ++i)
+    {
+        if (!CF_AppData.engine.tx_prefetch[i].txn)
+        {
+            prefetch = &CF_AppData.engine.tx_prefetch[i];
+        }
+    }
+
+    /* a file open elsewhere may be closed by the time it is sent, so that is left for the metadata to report */
+    if (prefetch && OS_FileOpenCheck(txn->history->fnames.src_filename) != OS_SUCCESS)
+    {
+        success = CF_CFDP_S_OpenFile(txn);
+
+        read_size = txn->fsize;
+        if (read_size > CF_AppData.config_table->outgoing_file_chunk_size)
+        {
+            read_size = CF_AppData.config_table->outgoing_file_chunk_size;
+        }
+        if (read_size > sizeof(prefetch->data))
+        {
+            read_size = sizeof(prefetch->data);
+        }
+
+        if (success && read_size)
+        {
+            status = CF_WrappedRead(txn->fd, prefetch->data, read_size);
+            if (status != read_size)
+            {
+                CFE_EVS_SendEvent(CF_CFDP_S_READ_ERR_EID, CFE_EVS_EventType_ERROR,
+                                  "CF S%d(%lu:%lu): error reading bytes: expected %ld, got %ld",
+                                  (txn->state == CF_TxnState_S2), (unsigned long)txn->history->src_eid,
+                                  (unsigned long)txn->history->seq_num, (long)read_size, (long)status);
+                ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_read;
+                success = false;
+            }
+        }
+
+        if (success)
+        {
+            prefetch->txn                   = txn;
+            prefetch->size                  = read_size;
+            txn->state_data.send.prefetch   = prefetch;
+            txn->state_data.send.cached_pos = read_size;
+            txn->flags.tx.prefetched        = true;
+        }
+        else
+        {
+            /* the same as it would have been once it was sent, only sooner */
+            CF_CFDP_SetTxnStatus(txn, CF_TxnStatus_FILESTORE_REJECTION);
+            CF_CFDP_S_Reset(txn);
+        }
+    }
+
+    return (prefetch != NULL);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_s.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_S_PrefetchRelease(CF_Transaction_t *txn)
+{
+    if (txn->state_data.send.prefetch)
+    {
+        txn->state_data.send.prefetch->txn = NULL;
+        txn->state_data.send.prefetch      = NULL;
+    }
+}
+
 /*----------------------------------------------------------------
  *
  * Application-scope internal function
@@ -465,6 +1657,7 @@ void CF_CFDP_S2_Fin(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
 {
     txn->state_data.send.s2.fin_cc = ph->int_header.fin.cc;
     txn->state_data.send.sub_state = CF_TxSubState_SEND_FIN_ACK;
+    CF_CFDP_S2_FlowFeedback(txn, 0);
 }
 
 /*----------------------------------------------------------------
@@ -479,8 +1672,10 @@ void CF_CFDP_S2_Nak(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
     const CF_Logical_PduNak_t *        nak;
     uint8                              counter;
     uint8                              bad_sr;
+    uint32                             lost;
 
     bad_sr = 0;
+    lost   = 0;
 
     /* this function is only invoked for NAK PDU types */
     nak = &ph->int_header.nak;
@@ -511,13 +1706,29 @@ void CF_CFDP_S2_Nak(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
                     continue;
                 }
 
+                /* a NAK repeats every gap still outstanding, so only what was not already asked for is new loss */
+                lost += CF_ChunkList_CountUncovered(&txn->chunks->chunks, sr->offset_start,
+                                                    sr->offset_end - sr->offset_start);
+
                 /* insert gap data in chunks */
                 CF_ChunkListAdd(&txn->chunks->chunks, sr->offset_start, sr->offset_end - sr->offset_start);
             }
         }
 
+        CF_CFDP_S2_FlowFeedback(txn, lost);
+
+        /* a receiver that kept a partial file from an earlier attempt NAKs before it has seen any new
+         * data, and everything in the scope it did not NAK it already holds */
+        if (!bad_sr && txn->state_data.send.sub_state == CF_TxSubState_FILEDATA && nak->scope_end > txn->foffs &&
+            nak->scope_end <= txn->fsize && nak->scope_end > txn->state_data.send.s2.skip_to)
+        {
+            txn->state_data.send.s2.skip_to = nak->scope_end;
+        }
+
         CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.nak_segment_requests +=
             nak->segment_list.num_segments;
+        ++txn->history->perf.nak_rounds;
+        txn->history->perf.nak_segments += nak->segment_list.num_segments;
         if (bad_sr)
         {
             CFE_EVS_SendEvent(CF_CFDP_S_INVALID_SR_ERR_EID, CFE_EVS_EventType_ERROR,
@@ -535,6 +1746,44 @@ void CF_CFDP_S2_Nak(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
     }
 }
 
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_s.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_S2_KeepAlive(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
+{
+    const CF_Chunk_t *chunk;
+    CF_FileSize_t     progress;
+
+    /* the inactivity timer was already restarted when the PDU was dispatched */
+    if (CF_CFDP_RecvKeepAlive(txn, ph) == CFE_SUCCESS && ph->int_header.keep_alive.progress <= txn->fsize)
+    {
+        progress = ph->int_header.keep_alive.progress;
+
+        if (CF_AppData.config_table->chan[txn->chan_num].tx_keep_alive_trim)
+        {
+            /* the receiver holds everything below its progress, so retransmits there are not needed */
+            chunk = CF_ChunkList_GetFirstChunk(&txn->chunks->chunks);
+            while (chunk != NULL && chunk->offset < progress)
+            {
+                CF_ChunkList_RemoveFromFirst(&txn->chunks->chunks,
+                                             (chunk->offset + chunk->size <= progress) ? chunk->size
+                                                                                       : (progress - chunk->offset));
+                chunk = CF_ChunkList_GetFirstChunk(&txn->chunks->chunks);
+            }
+        }
+    }
+    else
+    {
+        CFE_EVS_SendEvent(CF_CFDP_S_PDU_KEEP_ALIVE_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "CF S%d(%lu:%lu): received invalid keep alive PDU", (txn->state == CF_TxnState_S2),
+                          (unsigned long)txn->history->src_eid, (unsigned long)txn->history->seq_num);
+        ++CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.error;
+    }
+}
+
 /*----------------------------------------------------------------
  *
  * Application-scope internal function
@@ -567,6 +1816,7 @@ void CF_CFDP_S2_WaitForEofAck(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
         {
             txn->state_data.send.sub_state = CF_TxSubState_WAIT_FOR_FIN;
             txn->flags.com.ack_timer_armed = false; /* just wait for FIN now, nothing to re-send */
+            CF_CFDP_S2_FlowFeedback(txn, 0);
         }
     }
     else
@@ -603,14 +1853,18 @@ void CF_CFDP_S2_Recv(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
                                                                      [CF_CFDP_FileDirective_FIN] = CF_CFDP_S2_EarlyFin,
                                                                  }};
     static const CF_CFDP_FileDirectiveDispatchTable_t s2_fd_or_eof = {
-        .fdirective = {
-            [CF_CFDP_FileDirective_FIN] = CF_CFDP_S2_EarlyFin, [CF_CFDP_FileDirective_NAK] = CF_CFDP_S2_Nak}};
+        .fdirective = {[CF_CFDP_FileDirective_FIN]        = CF_CFDP_S2_EarlyFin,
+                       [CF_CFDP_FileDirective_NAK]        = CF_CFDP_S2_Nak,
+                       [CF_CFDP_FileDirective_KEEP_ALIVE] = CF_CFDP_S2_KeepAlive}};
     static const CF_CFDP_FileDirectiveDispatchTable_t s2_wait_eof_ack = {
-        .fdirective = {[CF_CFDP_FileDirective_FIN] = CF_CFDP_S2_Fin,
-                       [CF_CFDP_FileDirective_ACK] = CF_CFDP_S2_WaitForEofAck,
-                       [CF_CFDP_FileDirective_NAK] = CF_CFDP_S2_Nak_Arm}};
+        .fdirective = {[CF_CFDP_FileDirective_FIN]        = CF_CFDP_S2_Fin,
+                       [CF_CFDP_FileDirective_ACK]        = CF_CFDP_S2_WaitForEofAck,
+                       [CF_CFDP_FileDirective_NAK]        = CF_CFDP_S2_Nak_Arm,
+                       [CF_CFDP_FileDirective_KEEP_ALIVE] = CF_CFDP_S2_KeepAlive}};
     static const CF_CFDP_FileDirectiveDispatchTable_t s2_wait_fin = {
-        .fdirective = {[CF_CFDP_FileDirective_FIN] = CF_CFDP_S2_Fin, [CF_CFDP_FileDirective_NAK] = CF_CFDP_S2_Nak_Arm}};
+        .fdirective = {[CF_CFDP_FileDirective_FIN]        = CF_CFDP_S2_Fin,
+                       [CF_CFDP_FileDirective_NAK]        = CF_CFDP_S2_Nak_Arm,
+                       [CF_CFDP_FileDirective_KEEP_ALIVE] = CF_CFDP_S2_KeepAlive}};
     static const CF_CFDP_FileDirectiveDispatchTable_t s2_fin_ack = {
         .fdirective = {[CF_CFDP_FileDirective_FIN] = CF_CFDP_S2_Fin}};
 
@@ -675,6 +1929,21 @@ void CF_CFDP_S_Cancel(CF_Transaction_t *txn)
     {
         /* if state has not reached CF_TxSubState_EOF, then set it to CF_TxSubState_EOF now. */
         txn->state_data.send.sub_state = CF_TxSubState_EOF;
+        CF_CFDP_S_SetFollowWait(txn, false); /* back on TXA to send it */
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_s.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_S_Respond(CF_Transaction_t *txn, int *cont /* unused */)
+{
+    if (txn->state == CF_TxnState_S2 && txn->state_data.send.sub_state == CF_TxSubState_SEND_FIN_ACK)
+    {
+        CF_CFDP_S_SubstateSendFinAck(txn);
     }
 }
 
@@ -693,11 +1962,18 @@ void CF_CFDP_S_Tick(CF_Transaction_t *txn, int *cont /* unused */)
     bool         early_exit = false;
 
     /* at each tick, various timers used by S are checked */
-    /* first, check inactivity timer */
-    if (txn->state == CF_TxnState_S2)
+    if (txn->flags.tx.follow_wait)
+    {
+        /* a followed file waiting for more data runs no timers, it is only checked for new data */
+        CF_CFDP_S_FollowFile(txn);
+    }
+    /* otherwise, first check inactivity timer */
+    else if (txn->state == CF_TxnState_S2)
     {
         if (CF_Timer_Expired(&txn->inactivity_timer))
         {
+            CF_TRACE(CF_TraceEvent_TIMER, txn->chan_num, (uint32)txn->history->seq_num, CF_TraceTimer_INACTIVITY, 0,
+                     0, 0);
             CFE_EVS_SendEvent(CF_CFDP_S_INACT_TIMER_ERR_EID, CFE_EVS_EventType_ERROR,
                               "CF S2(%lu:%lu): inactivity timer expired", (unsigned long)txn->history->src_eid,
                               (unsigned long)txn->history->seq_num);
@@ -714,6 +1990,9 @@ void CF_CFDP_S_Tick(CF_Transaction_t *txn, int *cont /* unused */)
             {
                 if (CF_Timer_Expired(&txn->ack_timer))
                 {
+                    CF_TRACE(CF_TraceEvent_TIMER, txn->chan_num, (uint32)txn->history->seq_num, CF_TraceTimer_ACK, 0,
+                             0, 0);
+
                     if (txn->state_data.send.sub_state == CF_TxSubState_WAIT_FOR_EOF_ACK)
                     {
                         /* Increment acknak counter */
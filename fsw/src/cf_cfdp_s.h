@@ -73,6 +73,23 @@ void CF_CFDP_S1_Tx(CF_Transaction_t *txn);
  */
 void CF_CFDP_S2_Tx(CF_Transaction_t *txn);
 
+/************************************************************************/
+/** @brief Send the responses an S transaction has pending.
+ *
+ * @par Description
+ *       Called by the engine between wakeups when the channel is in
+ *       event-driven mode, right after received PDUs are processed.
+ *       Sends a pending FIN-ACK. No timers are touched, and no file
+ *       data is sent.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL. cont is unused, so may be NULL
+ *
+ * @param txn  Pointer to the transaction object
+ * @param cont Unused, exists for compatibility with tick processor
+ */
+void CF_CFDP_S_Respond(CF_Transaction_t *txn, int *cont);
+
 /************************************************************************/
 /** @brief Perform tick (time-based) processing for S transactions.
  *
@@ -80,7 +97,8 @@ void CF_CFDP_S2_Tx(CF_Transaction_t *txn);
  *       This function is called on every transaction by the engine on
  *       every CF wakeup. This is where flags are checked to send EOF or
  *       FIN-ACK. If nothing else is sent, it checks to see if a NAK
- *       retransmit must occur.
+ *       retransmit must occur. A followed file waiting for more data is
+ *       checked for it instead.
  *
  * @par Assumptions, External Events, and Notes:
  *       txn must not be NULL. cont is unused, so may be NULL
@@ -123,6 +141,40 @@ void CF_CFDP_S_Cancel(CF_Transaction_t *txn);
  *
  ************************************************************************/
 
+/************************************************************************/
+/** @brief Report peer feedback for an S2 transaction to flow control.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL. Called whenever the peer responds to the
+ *       file data of the transaction (NAK, EOF-ACK or FIN).  All file data
+ *       sent since the previous feedback is released from the in-flight count.
+ *
+ * @param txn  Pointer to the transaction object
+ * @param lost Number of file data bytes the peer requested again
+ */
+void CF_CFDP_S2_FlowFeedback(CF_Transaction_t *txn, uint32 lost);
+
+/************************************************************************/
+/** @brief Complete the checksum of a multi-destination send.
+ *
+ * @par Description
+ *       Reads any of the file that no destination of the fan-out group
+ *       has read yet into the checksum, no more than
+ *       rx_crc_calc_bytes_per_wakeup bytes per call. While some is left
+ *       the channel's current transaction is set to txn, so it carries
+ *       on at the next wakeup. A read error is a filestore rejection,
+ *       and the EOF then goes out with that status.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL. Does nothing for a single-destination send.
+ *
+ * @param txn     Pointer to the transaction object
+ *
+ * @retval true  if the checksum is complete and the EOF can be sent
+ * @retval false if more of the file is left to read
+ */
+bool CF_CFDP_S_GetFanOutCrc(CF_Transaction_t *txn);
+
 /************************************************************************/
 /** @brief Send an EOF PDU.
  *
@@ -186,7 +238,7 @@ CFE_Status_t CF_CFDP_S_SendFileData(CF_Transaction_t *txn, uint32 foffs, uint32
  *       During the transfer of active transaction file data PDUs, the file
  *       offset is saved. This function sends the next chunk of data. If
  *       the file offset equals the file size, then transition to the EOF
- *       state.
+ *       state, unless the file is followed and may still grow.
  *
  * @par Assumptions, External Events, and Notes:
  *       txn must not be NULL.
@@ -195,6 +247,25 @@ CFE_Status_t CF_CFDP_S_SendFileData(CF_Transaction_t *txn, uint32 foffs, uint32
  */
 void CF_CFDP_S_SubstateSendFileData(CF_Transaction_t *txn);
 
+/************************************************************************/
+/** @brief Check a followed file for more data once all of it has been sent.
+ *
+ * @par Description
+ *       Gets the size of the file again. If it grew, the new data is sent
+ *       next. If it has not changed for the channel's tx_follow_quiet_s
+ *       seconds, the file is taken as finished and the EOF is sent with its
+ *       size. Otherwise the transaction waits on TXW until the next
+ *       wakeup, so the channel's other sends can run meanwhile.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL, and all of the file known so far must have
+ *       been sent. Called from CF_CFDP_S_SubstateSendFileData() while on
+ *       TXA, and from CF_CFDP_S_Tick() while waiting.
+ *
+ * @param txn     Pointer to the transaction object
+ */
+void CF_CFDP_S_FollowFile(CF_Transaction_t *txn);
+
 /************************************************************************/
 /** @brief Respond to a NAK by sending filedata PDUs as response.
  *
@@ -213,12 +284,34 @@ void CF_CFDP_S_SubstateSendFileData(CF_Transaction_t *txn);
  */
 CFE_Status_t CF_CFDP_S_CheckAndRespondNak(CF_Transaction_t *txn);
 
+/************************************************************************/
+/** @brief Skip over file data the receiver already holds.
+ *
+ * @par Description
+ *       The file is read from the current offset up to the point the
+ *       receiver has reported holding, so it is included in the file
+ *       checksum, but nothing is sent for it. No more than
+ *       rx_crc_calc_bytes_per_wakeup bytes are read per call.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL, and must be an S2 sending file data with
+ *       txn->foffs below txn->state_data.send.s2.skip_to.
+ *
+ * @param txn     Pointer to the transaction object
+ */
+void CF_CFDP_S2_SubstateSkipFileData(CF_Transaction_t *txn);
+
 /************************************************************************/
 /** @brief Send filedata handling for S2.
  *
  * @par Description
  *       S2 will either respond to a NAK by sending retransmits, or in
  *       absence of a NAK, it will send more of the original file data.
+ *       A Prompt (NAK) that has fallen due, by prompt_nak_bytes of file
+ *       data or by the prompt_nak_s interval, is sent before either.
+ *       The interval timer is run here rather than from the tick, because
+ *       a transaction sending file data is on TXA, which is not ticked.
+ *       It is ticked on the first call of each engine cycle.
  *
  * @par Assumptions, External Events, and Notes:
  *       txn must not be NULL.
@@ -227,12 +320,135 @@ CFE_Status_t CF_CFDP_S_CheckAndRespondNak(CF_Transaction_t *txn);
  */
 void CF_CFDP_S2_SubstateSendFileData(CF_Transaction_t *txn);
 
+/************************************************************************/
+/** @brief Check a file against an earlier delivery of it.
+ *
+ * @par Description
+ *       Reads the file from the start into the file checksum, no more
+ *       than rx_crc_calc_bytes_per_wakeup bytes per call. Once it is all
+ *       read, the checksum is compared with the earlier delivery's. On a
+ *       match txn->flags.tx.delivered is set, otherwise the checksum is
+ *       started again so the file can be sent as usual.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL, and must be sending metadata with
+ *       txn->flags.tx.delivered_check set and the file open.
+ *
+ * @param txn     Pointer to the transaction object
+ *
+ * @retval true  if the file was read without error
+ * @retval false if it could not be read
+ */
+bool CF_CFDP_S_CheckDelivered(CF_Transaction_t *txn);
+
+/************************************************************************/
+/** @brief Set up a send to compress its file as it goes.
+ *
+ * @par Description
+ *       Opens a temp file in the tmp_dir that the file is compressed into,
+ *       and makes it the file that is sent. The original stays open in
+ *       txn->zfd and txn->fsize starts at 0, growing as each block is
+ *       compressed. txn->flags.com.compressed is set so the temp file is
+ *       removed however the transaction ends.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL, and must be sending metadata with
+ *       txn->flags.tx.compressing set and the file open.
+ *
+ * @param txn     Pointer to the transaction object
+ *
+ * @retval true  if the temp file was opened
+ * @retval false if the file could not be rewound, or the temp file opened
+ */
+bool CF_CFDP_S_CompressStart(CF_Transaction_t *txn);
+
+/************************************************************************/
+/** @brief Compress the next block of a file that is being sent.
+ *
+ * @par Description
+ *       Reads up to CF_COMPRESS_BLOCK_SIZE bytes of the original file,
+ *       packs them and adds them to the end of the temp file, so they can
+ *       be sent as file data. The checksum of the original is kept in
+ *       txn->state_data.send.raw_crc once it is all read, at which point
+ *       the original is closed and txn->flags.tx.compressing is cleared,
+ *       so txn->fsize is the size given in the EOF.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL, and CF_CFDP_S_CompressStart() must have
+ *       succeeded for it.
+ *
+ * @param txn     Pointer to the transaction object
+ *
+ * @retval true  if the block was compressed, or there was none left
+ * @retval false if it could not be read, or the temp file not written
+ */
+bool CF_CFDP_S_CompressChunk(CF_Transaction_t *txn);
+
+/************************************************************************/
+/** @brief Make a delta of a file against the copy last delivered.
+ *
+ * @par Description
+ *       Reads the file from the start, no more than
+ *       rx_crc_calc_bytes_per_wakeup bytes per call, signing each block
+ *       for the next send of it. If the signatures of the copy last
+ *       delivered to the same destination are on hand, the file is also
+ *       encoded against them into a temp file in the tmp_dir, and once
+ *       done that temp file replaces the original as the file that is
+ *       sent. Otherwise the file is sent whole, compressed if the send
+ *       asks for it, see #CF_TxCompress_t. txn->flags.tx.delta_encoding is cleared when
+ *       done.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL, and must be sending metadata with
+ *       txn->flags.tx.delta_encoding set and the file open. The codec
+ *       work area is shared, so a send waits while another is using it.
+ *
+ * @param txn     Pointer to the transaction object
+ *
+ * @retval true  if the file was encoded without error so far
+ * @retval false if it could not be read, or the temp file not written
+ */
+bool CF_CFDP_S_DeltaChunk(CF_Transaction_t *txn);
+
+/************************************************************************/
+/** @brief Settle the delta signatures of a send that is ending.
+ *
+ * @par Description
+ *       Releases the delta work area if held. If the file was delivered,
+ *       the signatures made of it are kept for the next send, otherwise
+ *       they are removed. A delta that failed also removes the signatures
+ *       it was made against, so the next send is whole.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL.
+ *
+ * @param txn     Pointer to the transaction object
+ */
+void CF_CFDP_S_DeltaReset(CF_Transaction_t *txn);
+
+/************************************************************************/
+/** @brief Settle the files of a bundle whose send is ending.
+ *
+ * @par Description
+ *       Reads the index of the bundle and, unless the playback keeps its
+ *       files, moves or removes each of them as it would a file sent alone.
+ *       The bundle itself is a temp file, so it is always removed.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL. Does nothing for a send that is not a bundle.
+ *
+ * @param txn     Pointer to the transaction object
+ */
+void CF_CFDP_S_BundleReset(CF_Transaction_t *txn);
+
 /************************************************************************/
 /** @brief Send metadata PDU.
  *
  * @par Description
  *       Construct and send a metadata PDU. This function determines the
- *       size of the file to put in the metadata PDU.
+ *       size of the file to put in the metadata PDU. On a channel with
+ *       tx_skip_delivered set, a file that matches an earlier delivery
+ *       to the same destination is completed without sending anything.
  *
  * @par Assumptions, External Events, and Notes:
  *       txn must not be NULL.
@@ -241,6 +457,38 @@ void CF_CFDP_S2_SubstateSendFileData(CF_Transaction_t *txn);
  */
 void CF_CFDP_S_SubstateSendMetadata(CF_Transaction_t *txn);
 
+/************************************************************************/
+/** @brief Get the file of a pending send ready ahead of time.
+ *
+ * @par Description
+ *       Opens and sizes the file, and reads its first block, so the
+ *       metadata and first file data PDU go out without waiting on the
+ *       file system. A file that cannot be opened, sized or read fails
+ *       the transaction as it would have once it was sent. A file open
+ *       elsewhere is left for when it is sent.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL, and must be a pending send from the start
+ *       of a file that is not open and not shared with a multi-destination
+ *       group.
+ *
+ * @param txn     Pointer to the transaction object
+ *
+ * @retval true if a buffer was free, whether or not it was used
+ * @retval false if no buffer was free
+ */
+bool CF_CFDP_S_Prefetch(CF_Transaction_t *txn);
+
+/************************************************************************/
+/** @brief Give back the read ahead buffer of a send, if it has one.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL. The file is left open.
+ *
+ * @param txn     Pointer to the transaction object
+ */
+void CF_CFDP_S_PrefetchRelease(CF_Transaction_t *txn);
+
 /************************************************************************/
 /** @brief Send FIN-ACK packet for S2.
  *
@@ -289,6 +537,22 @@ void CF_CFDP_S2_Fin(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph);
  */
 void CF_CFDP_S2_Nak(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph);
 
+/************************************************************************/
+/** @brief S2 received Keep Alive PDU.
+ *
+ * @par Description
+ *       Receiving it keeps the transaction from timing out. If the
+ *       channel has tx_keep_alive_trim set, pending retransmits below
+ *       the progress the receiver reports are dropped.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL. ph must not be NULL.
+ *
+ * @param txn  Pointer to the transaction object
+ * @param ph Pointer to the PDU information
+ */
+void CF_CFDP_S2_KeepAlive(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph);
+
 /************************************************************************/
 /** @brief S2 NAK handling but with arming the NAK timer.
  *
@@ -20,18 +20,19 @@
 /**
  * @file
  *
- * This is the interface to the CFE Software Bus for CF transmit/recv.
- * Specifically this implements 3 functions used by the CFDP engine:
+ * This is the interface between the CFDP engine and the PDU transport
+ * for CF transmit/recv. Specifically this implements 3 functions used
+ * by the CFDP engine:
  *  - CF_CFDP_MsgOutGet() - gets a buffer prior to transmitting
  *  - CF_CFDP_Send() - sends the buffer from CF_CFDP_MsgOutGet
  *  - CF_CFDP_ReceiveMessage() - gets a received message
  *
  * These functions were originally part of the CFDP engine itself
  * but were split into a separate file, both to improve testability
- * as well as to (potentially) allow interfaces to message/packet services
- * other than the CFE software bus.  However, Note that in this version,
- * there is still a fair amount of CFDP engine mixed into these functions
- * that would have to be isolated.
+ * as well as to allow interfaces to message/packet services other than
+ * the CFE software bus. The transport used by each channel is selected
+ * by CF_CFDP_GetTransport(). The CFE software bus transport is also
+ * implemented here, see cf_udpintf.c for the UDP transport.
  *
  * Also note that the creation and deletion of SB pipes is not yet
  * moved into this file.
@@ -44,14 +45,169 @@
 #include "cf_perfids.h"
 #include "cf_cfdp.h"
 #include "cf_utils.h"
+#include "cf_instr.h"
+#include "cf_evagg.h"
 
 #include "cf_cfdp_r.h"
 #include "cf_cfdp_s.h"
 #include "cf_cfdp_sbintf.h"
+#include "cf_udpintf.h"
 
 #include <string.h>
 #include "cf_assert.h"
 
+/**
+ * @brief The CFE software bus transport
+ */
+const CF_Transport_t CF_Transport_Sb = {.GetBuffer     = CF_CFDP_SbGetBuffer,
+                                        .ReleaseBuffer = CF_CFDP_SbReleaseBuffer,
+                                        .Send          = CF_CFDP_SbSend,
+                                        .ReceiveBatch  = CF_CFDP_SbReceiveBatch};
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_sbintf.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+const CF_Transport_t *CF_CFDP_GetTransport(uint8 chan_num)
+{
+    const CF_Transport_t *transport;
+
+    if (CF_AppData.config_table->chan[chan_num].udp_local_port)
+    {
+        transport = &CF_Transport_Udp;
+    }
+    else
+    {
+        transport = &CF_Transport_Sb;
+    }
+
+    return transport;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_sbintf.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void *CF_CFDP_SbGetBuffer(uint8 chan_num, size_t *encap_hdr_size)
+{
+    CFE_SB_Buffer_t *msg;
+    CF_InstrStamp_t  stamp;
+
+    CF_INSTR_START(stamp);
+    msg = CFE_SB_AllocateMessageBuffer(offsetof(CF_PduTlmMsg_t, ph) + CF_MAX_PDU_SIZE +
+                                       CF_PDU_ENCAPSULATION_EXTRA_TRAILING_BYTES);
+    CF_INSTR_RECORD(CF_InstrHist_SB_ALLOC, stamp);
+    if (msg)
+    {
+        CFE_MSG_Init(&msg->Msg, CFE_SB_ValueToMsgId(CF_AppData.config_table->chan[chan_num].mid_output),
+                     offsetof(CF_PduTlmMsg_t, ph));
+    }
+
+    *encap_hdr_size = offsetof(CF_PduTlmMsg_t, ph);
+
+    return msg;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_sbintf.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_SbReleaseBuffer(uint8 chan_num, void *buf)
+{
+    CFE_SB_ReleaseMessageBuffer(buf);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_sbintf.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_SbSend(uint8 chan_num, void *buf, size_t pdu_size)
+{
+    CFE_SB_Buffer_t *msg = buf;
+    CFE_MSG_Size_t   sb_msgsize;
+
+    /* now handle the SB encapsulation - this should reflect the
+     * length of the entire message, including encapsulation */
+    sb_msgsize = offsetof(CF_PduTlmMsg_t, ph);
+    sb_msgsize += pdu_size;
+    sb_msgsize += CF_PDU_ENCAPSULATION_EXTRA_TRAILING_BYTES;
+
+    CFE_MSG_SetSize(&msg->Msg, sb_msgsize);
+    CFE_MSG_SetMsgTime(&msg->Msg, CFE_TIME_GetTime());
+    CFE_SB_TransmitBuffer(msg, true);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_sbintf.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+uint32 CF_CFDP_SbReceiveBatch(uint8 chan_num, CF_TransportRxMsg_t *msgs, uint32 max_msgs)
+{
+    CF_Input_t *     in = &CF_AppData.engine.in;
+    uint32           count;
+    CFE_MSG_Type_t   msg_type = CFE_MSG_Type_Invalid;
+    CFE_SB_Buffer_t *bufptr;
+    CFE_MSG_Size_t   msg_size;
+    size_t           encap_hdr_size;
+
+    CF_Assert(max_msgs <= CF_TRANSPORT_RX_BATCH_SIZE);
+
+    for (count = 0; count < max_msgs; ++count)
+    {
+        if (CFE_SB_ReceiveBuffer(&bufptr, CF_AppData.engine.channels[chan_num].pipe, CFE_SB_POLL) != CFE_SUCCESS)
+        {
+            break; /* no more messages */
+        }
+
+        CFE_MSG_GetSize(&bufptr->Msg, &msg_size);
+        CFE_MSG_GetType(&bufptr->Msg, &msg_type);
+        if (msg_type == CFE_MSG_Type_Tlm)
+        {
+            encap_hdr_size = offsetof(CF_PduTlmMsg_t, ph);
+        }
+        else
+        {
+            encap_hdr_size = offsetof(CF_PduCmdMsg_t, ph);
+        }
+
+        if (msg_size > (encap_hdr_size + CF_PDU_ENCAPSULATION_EXTRA_TRAILING_BYTES))
+        {
+            /* Ignore/subtract the encapsulation and any fixed trailing bytes */
+            msg_size -= encap_hdr_size + CF_PDU_ENCAPSULATION_EXTRA_TRAILING_BYTES;
+        }
+        else
+        {
+            /* bad message size - not supposed to happen */
+            msg_size = 0;
+        }
+
+        if (msg_size > sizeof(in->rx_buf[count]))
+        {
+            /* larger than any PDU CF accepts, the header decode will reject it as short */
+            msg_size = sizeof(in->rx_buf[count]);
+        }
+
+        /* the SB buffer is only valid until the next receive on this pipe, so keep a copy of the PDU */
+        memcpy(in->rx_buf[count], (const uint8 *)bufptr + encap_hdr_size, msg_size);
+
+        msgs[count].buf            = in->rx_buf[count];
+        msgs[count].encap_hdr_size = 0;
+        msgs[count].total_size     = msg_size;
+    }
+
+    return count;
+}
+
 /*----------------------------------------------------------------
  *
  * Application-scope internal function
@@ -65,6 +221,7 @@ CF_Logical_PduBuffer_t *CF_CFDP_MsgOutGet(const CF_Transaction_t *txn, bool sile
     bool                    success = true;
     CF_Logical_PduBuffer_t *ret;
     int32                   os_status;
+    size_t                  encap_hdr_size = 0;
 
     /* this function should not be called more than once before the message
      * is sent, so if there's already an outgoing message allocated
@@ -72,12 +229,12 @@ CF_Logical_PduBuffer_t *CF_CFDP_MsgOutGet(const CF_Transaction_t *txn, bool sile
     ret = NULL;
     if (CF_AppData.engine.out.msg)
     {
-        CFE_SB_ReleaseMessageBuffer(CF_AppData.engine.out.msg);
+        CF_AppData.engine.out.transport->ReleaseBuffer(txn->chan_num, CF_AppData.engine.out.msg);
         CF_AppData.engine.out.msg = NULL;
     }
 
     if (CF_AppData.config_table->chan[txn->chan_num].max_outgoing_messages_per_wakeup &&
-        (CF_AppData.engine.outgoing_counter ==
+        (chan->outgoing_counter ==
          CF_AppData.config_table->chan[txn->chan_num].max_outgoing_messages_per_wakeup))
     {
         /* no more messages this wakeup allowed */
@@ -100,14 +257,14 @@ CF_Logical_PduBuffer_t *CF_CFDP_MsgOutGet(const CF_Transaction_t *txn, bool sile
         /* Allocate message buffer on success */
         if (os_status == OS_SUCCESS)
         {
-            CF_AppData.engine.out.msg = CFE_SB_AllocateMessageBuffer(offsetof(CF_PduTlmMsg_t, ph) + CF_MAX_PDU_SIZE +
-                                                                     CF_PDU_ENCAPSULATION_EXTRA_TRAILING_BYTES);
+            CF_AppData.engine.out.transport = CF_CFDP_GetTransport(txn->chan_num);
+            CF_AppData.engine.out.msg       = CF_AppData.engine.out.transport->GetBuffer(txn->chan_num, &encap_hdr_size);
         }
 
         if (!CF_AppData.engine.out.msg)
         {
             chan->cur = txn; /* remember where we were for next time */
-            if (!silent && (os_status == OS_SUCCESS))
+            if (!silent && (os_status == OS_SUCCESS) && !CF_EvAgg_Suppress(CF_EvAgg_NO_MSG, 0, 0))
             {
                 CFE_EVS_SendEvent(CF_CFDP_NO_MSG_ERR_EID, CFE_EVS_EventType_ERROR,
                                   "CF: no output message buffer available");
@@ -117,11 +274,8 @@ CF_Logical_PduBuffer_t *CF_CFDP_MsgOutGet(const CF_Transaction_t *txn, bool sile
 
         if (success)
         {
-            CFE_MSG_Init(&CF_AppData.engine.out.msg->Msg,
-                         CFE_SB_ValueToMsgId(CF_AppData.config_table->chan[txn->chan_num].mid_output),
-                         offsetof(CF_PduTlmMsg_t, ph));
-            ++CF_AppData.engine.outgoing_counter; /* even if max_outgoing_messages_per_wakeup is 0 (unlimited), it's ok
-                                                    to inc this */
+            ++chan->outgoing_counter; /* even if max_outgoing_messages_per_wakeup is 0 (unlimited), it's ok
+                                        to inc this */
 
             /* prepare for encoding - the "tx_pdudata" is what serves as the temporary holding area for content */
             ret = &CF_AppData.engine.out.tx_pdudata;
@@ -131,8 +285,8 @@ CF_Logical_PduBuffer_t *CF_CFDP_MsgOutGet(const CF_Transaction_t *txn, bool sile
     /* if returning a buffer, then reset the encoder state to point to the beginning of the encapsulation msg */
     if (success && ret != NULL)
     {
-        CF_CFDP_EncodeStart(&CF_AppData.engine.out.encode, CF_AppData.engine.out.msg, ret, offsetof(CF_PduTlmMsg_t, ph),
-                            offsetof(CF_PduTlmMsg_t, ph) + CF_MAX_PDU_SIZE);
+        CF_CFDP_EncodeStart(&CF_AppData.engine.out.encode, CF_AppData.engine.out.msg, ret, encap_hdr_size,
+                            encap_hdr_size + CF_MAX_PDU_SIZE);
     }
 
     return ret;
@@ -146,20 +300,10 @@ CF_Logical_PduBuffer_t *CF_CFDP_MsgOutGet(const CF_Transaction_t *txn, bool sile
  *-----------------------------------------------------------------*/
 void CF_CFDP_Send(uint8 chan_num, const CF_Logical_PduBuffer_t *ph)
 {
-    CFE_MSG_Size_t sb_msgsize;
-
     CF_Assert(chan_num < CF_NUM_CHANNELS);
 
-    /* now handle the SB encapsulation - this should reflect the
-     * length of the entire message, including encapsulation */
-    sb_msgsize = offsetof(CF_PduTlmMsg_t, ph);
-    sb_msgsize += ph->pdu_header.header_encoded_length;
-    sb_msgsize += ph->pdu_header.data_encoded_length;
-    sb_msgsize += CF_PDU_ENCAPSULATION_EXTRA_TRAILING_BYTES;
-
-    CFE_MSG_SetSize(&CF_AppData.engine.out.msg->Msg, sb_msgsize);
-    CFE_MSG_SetMsgTime(&CF_AppData.engine.out.msg->Msg, CFE_TIME_GetTime());
-    CFE_SB_TransmitBuffer(CF_AppData.engine.out.msg, true);
+    CF_AppData.engine.out.transport->Send(chan_num, CF_AppData.engine.out.msg,
+                                          ph->pdu_header.header_encoded_length + ph->pdu_header.data_encoded_length);
 
     ++CF_AppData.hk.Payload.channel_hk[chan_num].counters.sent.pdu;
 
@@ -172,132 +316,301 @@ void CF_CFDP_Send(uint8 chan_num, const CF_Logical_PduBuffer_t *ph)
  * See description in cf_cfdp_sbintf.h for argument/return detail
  *
  *-----------------------------------------------------------------*/
-void CF_CFDP_ReceiveMessage(CF_Channel_t *chan)
+CF_Transaction_t *CF_CFDP_ReceivePdu(CF_Channel_t *chan, CF_Logical_PduBuffer_t *ph, CF_Transaction_t *hint)
 {
-    CF_Transaction_t *txn; /* initialized below */
-    uint32            count = 0;
-    int32             status;
+    CF_Transaction_t *txn = NULL;
     const int         chan_num = (chan - CF_AppData.engine.channels);
-    CFE_SB_Buffer_t * bufptr;
-    CFE_MSG_Size_t    msg_size;
-    CFE_MSG_Type_t    msg_type = CFE_MSG_Type_Invalid;
+    CF_Transaction_t  t_finack;
+    CF_InstrStamp_t   stamp;
 
-    CF_Logical_PduBuffer_t *ph;
-    CF_Transaction_t        t_finack;
+    CFE_ES_PerfLogEntry(CF_PERF_ID_PDURCVD(chan_num));
+    CF_INSTR_START(stamp);
 
-    for (; count < CF_AppData.config_table->chan[chan_num].rx_max_messages_per_wakeup; ++count)
+    /* the hint saves the lookup when it is still the live transaction this PDU belongs to */
+    if (hint && hint->state > CF_TxnState_IDLE && hint->history->src_eid == ph->pdu_header.source_eid &&
+        hint->history->seq_num == ph->pdu_header.sequence_num)
+    {
+        txn = hint;
+    }
+    else
+    {
+        /* look it up by sequence number */
+        txn = CF_FindTransactionBySequenceNumber(chan, ph->pdu_header.sequence_num, ph->pdu_header.source_eid);
+    }
+
+    if (txn)
+    {
+        /* found one! Send it to the transaction state processor */
+        CF_Assert(txn->state > CF_TxnState_IDLE);
+        ++txn->history->perf.pdus_recv;
+        CF_CFDP_DispatchRecv(txn, ph);
+    }
+    else
     {
-        status = CFE_SB_ReceiveBuffer(&bufptr, chan->pipe, CFE_SB_POLL);
-        if (status != CFE_SUCCESS)
+        /* didn't find a match, but there's a special case:
+         *
+         * If an R2 sent FIN-ACK, the transaction is freed and the history data
+         * is placed in the history queue. It's possible that the peer missed the
+         * FIN-ACK and is sending another FIN. Since we don't know about this
+         * transaction, we don't want to leave R2 hanging. That wouldn't be elegant.
+         * So, send a FIN-ACK by cobbling together a temporary transaction on the
+         * stack and calling CF_CFDP_SendAck() */
+        if (ph->pdu_header.source_eid == CF_AppData.config_table->local_eid &&
+            ph->fdirective.directive_code == CF_CFDP_FileDirective_FIN)
         {
-            break; /* no more messages */
-        }
+            if (!CF_CFDP_RecvFin(txn, ph))
+            {
+                memset(&t_finack, 0, sizeof(t_finack));
+                CF_CFDP_InitTxnTxFile(&t_finack, CF_CFDP_CLASS_2, 1, chan_num,
+                                      0); /* populate transaction with needed fields for CF_CFDP_SendAck() */
+                if (CF_CFDP_SendAck(&t_finack, CF_CFDP_AckTxnStatus_UNRECOGNIZED, CF_CFDP_FileDirective_FIN,
+                                    ph->int_header.fin.cc, ph->pdu_header.destination_eid,
+                                    ph->pdu_header.sequence_num) != CF_SEND_PDU_NO_BUF_AVAIL_ERROR)
+                {
+                    /* CF_CFDP_SendAck does not return CF_SEND_PDU_ERROR */
+                    chan->cur = NULL; /* do not remember temp transaction for next time */
+                }
 
-        ph = &CF_AppData.engine.in.rx_pdudata;
-        CFE_ES_PerfLogEntry(CF_PERF_ID_PDURCVD(chan_num));
-        CFE_MSG_GetSize(&bufptr->Msg, &msg_size);
-        CFE_MSG_GetType(&bufptr->Msg, &msg_type);
-        if (msg_size > CF_PDU_ENCAPSULATION_EXTRA_TRAILING_BYTES)
+                /* NOTE: recv and recv_spurious will both be incremented */
+                ++CF_AppData.hk.Payload.channel_hk[chan_num].counters.recv.spurious;
+            }
+        }
+        /* if no match found, then it must be the case that we would be the destination entity id, so verify it
+         */
+        else if (ph->pdu_header.destination_eid == CF_AppData.config_table->local_eid)
         {
-            /* Ignore/subtract any fixed trailing bytes */
-            msg_size -= CF_PDU_ENCAPSULATION_EXTRA_TRAILING_BYTES;
+            /* we didn't find a match, so assign it to a transaction */
+            if (CF_AppData.hk.Payload.channel_hk[chan_num].q_size[CF_QueueIdx_RX] == CF_MAX_SIMULTANEOUS_RX)
+            {
+                if (!CF_EvAgg_Suppress(CF_EvAgg_RX_DROPPED, (uint32)ph->pdu_header.source_eid,
+                                       (uint32)ph->pdu_header.sequence_num))
+                {
+                    CFE_EVS_SendEvent(
+                        CF_CFDP_RX_DROPPED_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "CF: dropping packet from %lu transaction number 0x%08lx due max RX transactions reached",
+                        (unsigned long)ph->pdu_header.source_eid, (unsigned long)ph->pdu_header.sequence_num);
+                }
+
+                /* NOTE: as there is no transaction (txn) associated with this, there is no known channel,
+                    and therefore no known counter to account it to (because dropped is per-chan) */
+            }
+            else
+            {
+                txn = CF_FindUnusedTransaction(chan);
+                CF_Assert(txn);
+                txn->history->dir = CF_Direction_RX;
+
+                /* set default FIN status */
+                txn->state_data.receive.r2.dc = CF_CFDP_FinDeliveryCode_INCOMPLETE;
+                txn->state_data.receive.r2.fs = CF_CFDP_FinFileStatus_DISCARDED;
+
+                txn->flags.com.q_index = CF_QueueIdx_RX;
+                CF_CList_InsertBack_Ex(chan, txn->flags.com.q_index, &txn->cl_node);
+                ++txn->history->perf.pdus_recv;
+                CF_CFDP_DispatchRecv(txn, ph); /* will enter idle state */
+            }
         }
         else
         {
-            /* bad message size - not supposed to happen */
-            msg_size = 0;
+            if (!CF_EvAgg_Suppress(CF_EvAgg_INVALID_DST, (uint32)ph->pdu_header.destination_eid, 0))
+            {
+                CFE_EVS_SendEvent(CF_CFDP_INVALID_DST_ERR_EID, CFE_EVS_EventType_ERROR,
+                                  "CF: dropping packet for invalid destination eid 0x%lx",
+                                  (unsigned long)ph->pdu_header.destination_eid);
+            }
         }
-        if (msg_type == CFE_MSG_Type_Tlm)
+    }
+
+    CF_INSTR_RECORD(CF_Instr_PduHist(ph), stamp);
+    CFE_ES_PerfLogExit(CF_PERF_ID_PDURCVD(chan_num));
+
+    return txn;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_sbintf.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+uint32 CF_CFDP_GetRxBudget(uint8 chan_num)
+{
+    const CF_ChannelConfig_t *cc   = &CF_AppData.config_table->chan[chan_num];
+    CF_Channel_t *            chan = &CF_AppData.engine.channels[chan_num];
+
+    if (cc->rx_adaptive_max_per_wakeup <= cc->rx_max_messages_per_wakeup ||
+        chan->rx_budget < cc->rx_max_messages_per_wakeup)
+    {
+        /* adaptive mode is off, or this is the first wakeup since it was turned on */
+        chan->rx_budget = cc->rx_max_messages_per_wakeup;
+    }
+    else if (chan->rx_budget > cc->rx_adaptive_max_per_wakeup)
+    {
+        /* table was changed to a lower limit */
+        chan->rx_budget = cc->rx_adaptive_max_per_wakeup;
+    }
+
+    return chan->rx_budget;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_sbintf.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_UpdateRxBudget(uint8 chan_num, uint32 count, bool time_limited)
+{
+    const CF_ChannelConfig_t *cc     = &CF_AppData.config_table->chan[chan_num];
+    CF_Channel_t *            chan   = &CF_AppData.engine.channels[chan_num];
+    CF_HkChannel_Data_t *     hk     = &CF_AppData.hk.Payload.channel_hk[chan_num];
+    uint32                    budget = chan->rx_budget;
+    bool                      full;
+
+    if (count > hk->rx_pipe_high_water)
+    {
+        hk->rx_pipe_high_water = (count > UINT16_MAX) ? UINT16_MAX : count;
+    }
+
+    /*
+     * The SB drops messages sent to a full pipe without telling the receiver.
+     * Draining at least a pipe's worth in one wakeup means it was full, or close
+     * to it, before the drain started. This can only be seen once the budget
+     * reaches the pipe depth. UDP has no such pipe, so it is not checked.
+     */
+    full = (CF_CFDP_GetTransport(chan_num) == &CF_Transport_Sb && cc->pipe_depth_input != 0 &&
+            count >= cc->pipe_depth_input);
+    if (full)
+    {
+        ++hk->rx_pipe_full;
+    }
+
+    if (cc->rx_adaptive_max_per_wakeup > cc->rx_max_messages_per_wakeup)
+    {
+        if (full)
+        {
+            /* already at risk of losing messages, drain as fast as allowed */
+            budget = cc->rx_adaptive_max_per_wakeup;
+        }
+        else if (count >= budget && !time_limited)
+        {
+            /* budget ran out with messages possibly left behind, grow quickly */
+            budget *= 2;
+            if (budget > cc->rx_adaptive_max_per_wakeup)
+            {
+                budget = cc->rx_adaptive_max_per_wakeup;
+            }
+        }
+        else if (count < (budget / 2))
         {
-            CF_CFDP_DecodeStart(&CF_AppData.engine.in.decode, bufptr, ph, offsetof(CF_PduTlmMsg_t, ph), msg_size);
+            /* mostly idle, give back half of the excess over the configured cap */
+            budget -= (budget - cc->rx_max_messages_per_wakeup) / 2;
         }
         else
         {
-            CF_CFDP_DecodeStart(&CF_AppData.engine.in.decode, bufptr, ph, offsetof(CF_PduCmdMsg_t, ph), msg_size);
+            /* about right, or limited by time rather than by the budget */
+        }
+
+        chan->rx_budget = budget;
+    }
+
+    hk->rx_budget = (chan->rx_budget > UINT16_MAX) ? UINT16_MAX : chan->rx_budget;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cfdp_sbintf.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_ReceiveMessage(CF_Channel_t *chan)
+{
+    const int               chan_num     = (chan - CF_AppData.engine.channels);
+    const CF_Transport_t *  transport    = CF_CFDP_GetTransport(chan_num);
+    CF_Input_t *            in           = &CF_AppData.engine.in;
+    uint32                  max_count    = CF_CFDP_GetRxBudget(chan_num);
+    uint32                  max_usec     = CF_AppData.config_table->chan[chan_num].rx_max_usec_per_wakeup;
+    uint32                  count        = 0;
+    bool                    time_limited = false;
+    OS_time_t               start        = {0};
+    OS_time_t               now;
+    uint32                  num_msgs;
+    uint32                  i;
+    uint32                  j;
+    CF_Transaction_t *      txn;
+    CF_Logical_PduBuffer_t *ph;
+    bool                    done[CF_TRANSPORT_RX_BATCH_SIZE];
+    CF_TransportRxMsg_t     msgs[CF_TRANSPORT_RX_BATCH_SIZE];
+
+    CF_Instr_SetChannel(chan_num);
+
+    if (max_usec != 0)
+    {
+        OS_GetLocalTime(&start);
+    }
+
+    while (count < max_count && !time_limited)
+    {
+        num_msgs = max_count - count;
+        if (num_msgs > CF_TRANSPORT_RX_BATCH_SIZE)
+        {
+            num_msgs = CF_TRANSPORT_RX_BATCH_SIZE;
+        }
+
+        num_msgs = transport->ReceiveBatch(chan_num, msgs, num_msgs);
+        if (num_msgs == 0)
+        {
+            break; /* no more messages */
         }
-        if (!CF_CFDP_RecvPh(chan_num, ph))
+
+        /* decode all the headers first, so the batch can be grouped by transaction */
+        for (i = 0; i < num_msgs; ++i)
         {
-            /* got a valid PDU -- look it up by sequence number */
-            txn = CF_FindTransactionBySequenceNumber(chan, ph->pdu_header.sequence_num, ph->pdu_header.source_eid);
-            if (txn)
+            CF_CFDP_DecodeStart(&in->decode[i], msgs[i].buf, &in->rx_pdudata[i], msgs[i].encap_hdr_size,
+                                msgs[i].total_size);
+            done[i] = (CF_CFDP_RecvPh(chan_num, &in->rx_pdudata[i]) != CFE_SUCCESS);
+        }
+
+        /*
+         * Dispatch each transaction's PDUs back to back, in the order they arrived.
+         * The transaction found for the first PDU of a group is passed along as the
+         * hint for the rest, so the lookup is done once per transaction per batch
+         * rather than once per PDU.
+         */
+        for (i = 0; i < num_msgs; ++i)
+        {
+            if (done[i])
             {
-                /* found one! Send it to the transaction state processor */
-                CF_Assert(txn->state > CF_TxnState_IDLE);
-                CF_CFDP_DispatchRecv(txn, ph);
+                continue;
             }
-            else
-            {
-                /* didn't find a match, but there's a special case:
-                 *
-                 * If an R2 sent FIN-ACK, the transaction is freed and the history data
-                 * is placed in the history queue. It's possible that the peer missed the
-                 * FIN-ACK and is sending another FIN. Since we don't know about this
-                 * transaction, we don't want to leave R2 hanging. That wouldn't be elegant.
-                 * So, send a FIN-ACK by cobbling together a temporary transaction on the
-                 * stack and calling CF_CFDP_SendAck() */
-                if (ph->pdu_header.source_eid == CF_AppData.config_table->local_eid &&
-                    ph->fdirective.directive_code == CF_CFDP_FileDirective_FIN)
-                {
-                    if (!CF_CFDP_RecvFin(txn, ph))
-                    {
-                        memset(&t_finack, 0, sizeof(t_finack));
-                        CF_CFDP_InitTxnTxFile(&t_finack, CF_CFDP_CLASS_2, 1, chan_num,
-                                              0); /* populate transaction with needed fields for CF_CFDP_SendAck() */
-                        if (CF_CFDP_SendAck(&t_finack, CF_CFDP_AckTxnStatus_UNRECOGNIZED, CF_CFDP_FileDirective_FIN,
-                                            ph->int_header.fin.cc, ph->pdu_header.destination_eid,
-                                            ph->pdu_header.sequence_num) != CF_SEND_PDU_NO_BUF_AVAIL_ERROR)
-                        {
-                            /* CF_CFDP_SendAck does not return CF_SEND_PDU_ERROR */
-                            chan->cur = NULL; /* do not remember temp transaction for next time */
-                        }
-
-                        /* NOTE: recv and recv_spurious will both be incremented */
-                        ++CF_AppData.hk.Payload.channel_hk[chan_num].counters.recv.spurious;
-                    }
-
-                    CFE_ES_PerfLogExit(CF_PERF_ID_PDURCVD(chan_num));
-                    continue;
-                }
 
-                /* if no match found, then it must be the case that we would be the destination entity id, so verify it
-                 */
-                if (ph->pdu_header.destination_eid == CF_AppData.config_table->local_eid)
-                {
-                    /* we didn't find a match, so assign it to a transaction */
-                    if (CF_AppData.hk.Payload.channel_hk[chan_num].q_size[CF_QueueIdx_RX] == CF_MAX_SIMULTANEOUS_RX)
-                    {
-                        CFE_EVS_SendEvent(
-                            CF_CFDP_RX_DROPPED_ERR_EID, CFE_EVS_EventType_ERROR,
-                            "CF: dropping packet from %lu transaction number 0x%08lx due max RX transactions reached",
-                            (unsigned long)ph->pdu_header.source_eid, (unsigned long)ph->pdu_header.sequence_num);
-
-                        /* NOTE: as there is no transaction (txn) associated with this, there is no known channel,
-                            and therefore no known counter to account it to (because dropped is per-chan) */
-                    }
-                    else
-                    {
-                        txn = CF_FindUnusedTransaction(chan);
-                        CF_Assert(txn);
-                        txn->history->dir = CF_Direction_RX;
-
-                        /* set default FIN status */
-                        txn->state_data.receive.r2.dc = CF_CFDP_FinDeliveryCode_INCOMPLETE;
-                        txn->state_data.receive.r2.fs = CF_CFDP_FinFileStatus_DISCARDED;
-
-                        txn->flags.com.q_index = CF_QueueIdx_RX;
-                        CF_CList_InsertBack_Ex(chan, txn->flags.com.q_index, &txn->cl_node);
-                        CF_CFDP_DispatchRecv(txn, ph); /* will enter idle state */
-                    }
-                }
-                else
+            ph  = &in->rx_pdudata[i];
+            txn = CF_CFDP_ReceivePdu(chan, ph, NULL);
+
+            for (j = i + 1; j < num_msgs; ++j)
+            {
+                if (!done[j] && in->rx_pdudata[j].pdu_header.source_eid == ph->pdu_header.source_eid &&
+                    in->rx_pdudata[j].pdu_header.sequence_num == ph->pdu_header.sequence_num)
                 {
-                    CFE_EVS_SendEvent(CF_CFDP_INVALID_DST_ERR_EID, CFE_EVS_EventType_ERROR,
-                                      "CF: dropping packet for invalid destination eid 0x%lx",
-                                      (unsigned long)ph->pdu_header.destination_eid);
+                    txn     = CF_CFDP_ReceivePdu(chan, &in->rx_pdudata[j], txn);
+                    done[j] = true;
                 }
             }
         }
 
-        CFE_ES_PerfLogExit(CF_PERF_ID_PDURCVD(chan_num));
+        count += num_msgs;
+
+        /* the time caps are checked once per batch */
+        if (max_usec != 0)
+        {
+            OS_GetLocalTime(&now);
+            time_limited = (OS_TimeGetTotalMicroseconds(OS_TimeSubtract(now, start)) >= max_usec);
+        }
+        if (CF_CFDP_CycleBudgetExpired())
+        {
+            time_limited = true;
+        }
     }
+
+    CF_CFDP_UpdateRxBudget(chan_num, count, time_limited);
 }
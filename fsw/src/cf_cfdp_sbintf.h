@@ -20,10 +20,8 @@
 /**
  * @file
  *
- * This is the interface to the CFE Software Bus for PDU transmit/recv.
- *
- * It may serve as a future point of abstraction to interface with message
- * passing interfaces other than the CFE software bus, if necessary.
+ * This is the interface to the PDU transport for PDU transmit/recv,
+ * and the CFE Software Bus implementation of that transport.
  */
 
 #ifndef CF_CFDP_SBINTF_H
@@ -63,16 +61,94 @@ typedef struct CF_PduTlmMsg
     CF_CFDP_PduHeader_t       ph;  /**< \brief Beginning of CFDP headers */
 } CF_PduTlmMsg_t;
 
+/**
+ * @brief The CFE software bus transport
+ */
+extern const CF_Transport_t CF_Transport_Sb;
+
+/************************************************************************/
+/** @brief Get the transport a channel sends and receives PDUs with.
+ *
+ * @par Description
+ *       A channel with a nonzero udp_local_port in its configuration
+ *       uses UDP, any other channel uses the software bus.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       chan_num must be less than CF_NUM_CHANNELS.
+ *
+ * @param chan_num Channel number
+ *
+ * @returns Pointer to the transport, never NULL
+ */
+const CF_Transport_t *CF_CFDP_GetTransport(uint8 chan_num);
+
+/************************************************************************/
+/** @brief Get a software bus buffer to encode a PDU into.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       encap_hdr_size must not be NULL.
+ *
+ * @param chan_num       Channel number, selects the output message ID
+ * @param encap_hdr_size Output: size of the SB header ahead of the PDU
+ *
+ * @returns Pointer to the SB buffer, already initialized as a message
+ * @retval  NULL if no buffer is available
+ */
+void *CF_CFDP_SbGetBuffer(uint8 chan_num, size_t *encap_hdr_size);
+
+/************************************************************************/
+/** @brief Give back a software bus buffer without sending it.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       buf must be from CF_CFDP_SbGetBuffer()
+ *
+ * @param chan_num Channel number, not used
+ * @param buf      Buffer to give back
+ */
+void CF_CFDP_SbReleaseBuffer(uint8 chan_num, void *buf);
+
+/************************************************************************/
+/** @brief Send a PDU on the software bus.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       buf must be from CF_CFDP_SbGetBuffer(), and is given back to SB.
+ *
+ * @param chan_num Channel number, not used
+ * @param buf      Buffer holding the PDU
+ * @param pdu_size Size of the encoded PDU, not counting the SB header
+ */
+void CF_CFDP_SbSend(uint8 chan_num, void *buf, size_t pdu_size);
+
+/************************************************************************/
+/** @brief Receive a PDU from the channel's software bus pipe.
+ *
+ * @par Description
+ *       An SB buffer is only valid until the next receive on the same
+ *       pipe, so each PDU is copied out of it into the engine's receive
+ *       buffers, where it stays until the next call.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       msgs must have room for max_msgs entries, and max_msgs must not
+ *       exceed CF_TRANSPORT_RX_BATCH_SIZE.
+ *
+ * @param chan_num Channel number
+ * @param msgs     Output: received messages
+ * @param max_msgs Maximum number of messages to return
+ *
+ * @returns Number of messages returned, 0 if the pipe is empty
+ */
+uint32 CF_CFDP_SbReceiveBatch(uint8 chan_num, CF_TransportRxMsg_t *msgs, uint32 max_msgs);
+
 /************************************************************************/
 /** @brief Obtain a message buffer to construct a PDU inside.
  *
  * @par Description
  *       This performs the handshaking via semaphore with the consumer
- *       of the PDU. If the semaphore can be obtained, a software bus
- *       buffer is obtained and it is returned. If the semaphore is
- *       unavailable, then the current transaction is remembered for next
- *       engine cycle. If silent is true, then the event message is not
- *       printed in the case of no buffer available.
+ *       of the PDU. If the semaphore can be obtained, a buffer is
+ *       obtained from the channel's transport and it is returned. If the
+ *       semaphore is unavailable, then the current transaction is
+ *       remembered for next engine cycle. If silent is true, then the
+ *       event message is not printed in the case of no buffer available.
  *
  * @par Assumptions, External Events, and Notes:
  *       txn must not be NULL.
@@ -86,7 +162,7 @@ typedef struct CF_PduTlmMsg
 CF_Logical_PduBuffer_t *CF_CFDP_MsgOutGet(const CF_Transaction_t *txn, bool silent);
 
 /************************************************************************/
-/** @brief Sends the current output buffer via the software bus.
+/** @brief Sends the current output buffer via the channel's transport.
  *
  * @par Assumptions, External Events, and Notes:
  *       The PDU in the output buffer is ready to transmit.
@@ -98,7 +174,75 @@ CF_Logical_PduBuffer_t *CF_CFDP_MsgOutGet(const CF_Transaction_t *txn, bool sile
 void CF_CFDP_Send(uint8 chan_num, const CF_Logical_PduBuffer_t *ph);
 
 /************************************************************************/
-/** @brief Process received message on channel PDU input pipe.
+/** @brief Process one received PDU.
+ *
+ * @par Description
+ *       Hands a PDU with a decoded header to its transaction,
+ *       starting a new RX transaction if needed.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       chan must be a member of the array within the CF_AppData global object.
+ *       ph must not be NULL and its header must have passed CF_CFDP_RecvPh().
+ *       hint may be NULL. If it is still an active transaction matching the
+ *       source EID and sequence number of the PDU, it is used without a lookup.
+ *
+ * @param chan       Channel the PDU was received on
+ * @param ph         Received PDU
+ * @param hint       Transaction the previous PDU of the same transaction went to
+ *
+ * @returns Transaction the PDU was given to, or NULL if it was not given to one
+ */
+CF_Transaction_t *CF_CFDP_ReceivePdu(CF_Channel_t *chan, CF_Logical_PduBuffer_t *ph, CF_Transaction_t *hint);
+
+/************************************************************************/
+/** @brief Get the number of messages a channel may receive this wakeup.
+ *
+ * @par Description
+ *       This is rx_max_messages_per_wakeup from the table, unless
+ *       rx_adaptive_max_per_wakeup is above it. Then it is the adaptive
+ *       budget kept by CF_CFDP_UpdateRxBudget(), limited to the table range.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       chan_num must be less than CF_NUM_CHANNELS.
+ *
+ * @param chan_num Channel number
+ *
+ * @returns Maximum number of messages to receive this wakeup
+ */
+uint32 CF_CFDP_GetRxBudget(uint8 chan_num);
+
+/************************************************************************/
+/** @brief Update the receive budget and pipe statistics after a wakeup.
+ *
+ * @par Description
+ *       Records the input pipe high-water mark, and counts wakeups that
+ *       drained at least the SB input pipe depth. The SB does not report
+ *       drops, so that is only taken to mean the pipe was likely full, and
+ *       the count is not a number of lost messages. In adaptive mode, the budget is
+ *       raised to the adaptive maximum after a full pipe, doubled when it
+ *       was used up, and moved halfway back to the configured cap when
+ *       less than half of it was used. It is not raised when the time
+ *       limit ended the wakeup.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       chan_num must be less than CF_NUM_CHANNELS.
+ *
+ * @param chan_num     Channel number
+ * @param count        Number of messages received this wakeup
+ * @param time_limited Whether rx_max_usec_per_wakeup or the engine cycle budget ended the wakeup
+ */
+void CF_CFDP_UpdateRxBudget(uint8 chan_num, uint32 count, bool time_limited);
+
+/************************************************************************/
+/** @brief Process received messages from the channel's transport.
+ *
+ * @par Description
+ *       Up to CF_CFDP_GetRxBudget() messages are received, in batches of up
+ *       to CF_TRANSPORT_RX_BATCH_SIZE, stopping early once
+ *       rx_max_usec_per_wakeup has passed or the engine cycle is out of
+ *       time (see CF_CFDP_CycleBudgetExpired()).
+ *       All headers in a batch are decoded first, then the PDUs are
+ *       dispatched grouped by transaction, in arrival order within each group.
  *
  * @par Assumptions, External Events, and Notes:
  *       chan must be a member of the array within the CF_AppData global object
@@ -40,6 +40,11 @@
 #include "cf_chunk.h"
 #include "cf_timer.h"
 #include "cf_crc.h"
+#include "cf_flow.h"
+#include "cf_fanout.h"
+#include "cf_compress.h"
+#include "cf_delta.h"
+#include "cf_bundle.h"
 #include "cf_codec.h"
 
 /**
@@ -179,6 +184,10 @@ typedef struct CF_History
     CF_EntityId_t       src_eid;  /**< \brief the source eid of the transaction */
     CF_EntityId_t       peer_eid; /**< \brief peer_eid is always the "other guy", same src_eid for RX */
     CF_TransactionSeq_t seq_num;  /**< \brief transaction identifier, stays constant for entire transfer */
+
+    CF_TxnPerf_t perf;       /**< \brief performance record, reported in the EOT packet */
+    OS_time_t    wait_start; /**< \brief start of the current wait for an output buffer or flow control */
+    bool         waiting;    /**< \brief set while the transaction is waiting for an output buffer or flow control */
 } CF_History_t;
 
 /**
@@ -192,6 +201,16 @@ typedef struct CF_ChunkWrapper
     CF_CListNode_t cl_node;
 } CF_ChunkWrapper_t;
 
+/**
+ * @brief Directory entry waiting in a playback's work list
+ */
+typedef struct CF_PlaybackEntry
+{
+    char   name[CF_FILENAME_MAX_NAME]; /**< \brief name of the file, without its directory */
+    int64  mtime;                      /**< \brief modification time, only if the order needs it */
+    uint32 size;                       /**< \brief size of the file, only if the order needs it */
+} CF_PlaybackEntry_t;
+
 /**
  * @brief CF Playback entry
  *
@@ -202,14 +221,25 @@ typedef struct CF_Playback
     osal_id_t         dir_id;
     CF_CFDP_Class_t   cfdp_class;
     CF_TxnFilenames_t fnames;
-    uint16            num_ts; /**< \brief number of transactions */
+    uint16            num_ts;   /**< \brief number of transactions */
+    uint16            max_ts;   /**< \brief most transactions at once */
+    uint8             order;    /**< \brief order files are sent in, see #CF_PlaybackOrder_t */
+    uint8             compress; /**< \brief whether file data is compressed, see #CF_TxCompress_t */
     uint8             priority;
     CF_EntityId_t     dest_id;
 
+    CF_PlaybackEntry_t work[CF_PLAYBACK_ORDER_LIST_SIZE]; /**< \brief entries to send next, sorted */
+    uint16             work_count;                        /**< \brief number of entries in the work list */
+    uint16             work_next;                         /**< \brief next entry to send, 0 while still reading */
+
+    CF_PlaybackEntry_t last; /**< \brief last entry of the previous pass, only those after it are taken */
+
     bool busy;
     bool diropen;
     bool keep;
     bool counted;
+    bool ready;    /**< \brief work list is read and sorted, so it can be sent */
+    bool has_last; /**< \brief a pass in time or size order has been sent, so last is set */
 } CF_Playback_t;
 
 /**
@@ -229,17 +259,37 @@ typedef struct CF_Poll
  */
 typedef struct CF_TxS2_Data
 {
-    uint8 fin_cc; /**< \brief remember the cc in the received FIN PDU to echo in eof-fin */
-    uint8 acknak_count;
+    uint8  fin_cc; /**< \brief remember the cc in the received FIN PDU to echo in eof-fin */
+    uint8  acknak_count;
+    uint32 fc_in_flight; /**< \brief file data bytes sent since the last feedback from the peer */
+    uint32 skip_to;      /**< \brief new file data before this offset is already held by the receiver */
+
+    uint32     prompt_foffs; /**< \brief file offset when the last Prompt (NAK) was sent */
+    CF_Timer_t prompt_timer; /**< \brief interval timer for sending a Prompt (NAK) */
+    uint32     prompt_cycle; /**< \brief engine cycle on which prompt_timer was last ticked */
 } CF_TxS2_Data_t;
 
+/**
+ * @brief First block of the file of a pending send, read ahead of time
+ */
+typedef struct CF_TxPrefetch
+{
+    struct CF_Transaction *txn;  /**< \brief owning transaction, NULL if the buffer is free */
+    uint32                 size; /**< \brief bytes read from offset 0 */
+    uint8                  data[sizeof(CF_CFDP_PduFileDataContent_t)];
+} CF_TxPrefetch_t;
+
 /**
  * @brief Data specific to a send file transaction
  */
 typedef struct CF_TxState_Data
 {
-    CF_TxSubState_t sub_state;
-    uint32          cached_pos;
+    CF_TxSubState_t  sub_state;
+    uint32           cached_pos;
+    uint32           delivered_crc; /**< \brief checksum of the earlier delivery the file is checked against */
+    uint32           raw_crc;       /**< \brief checksum of the file before it was compressed or made a delta */
+    OS_time_t        follow_time;   /**< \brief when a followed file was last seen to grow */
+    CF_TxPrefetch_t *prefetch;      /**< \brief first block of file data is held here until it is sent, if set */
 
     CF_TxS2_Data_t s2;
 } CF_TxState_Data_t;
@@ -256,8 +306,19 @@ typedef struct CF_RxS2_Data
     CF_CFDP_FinFileStatus_t   fs;
     uint8                     eof_cc; /**< \brief remember the cc in the received EOF PDU to echo in eof-ack */
     uint8                     acknak_count;
+    CF_Timer_t                keep_alive_timer; /**< \brief interval timer for sending a Keep Alive */
 } CF_RxS2_Data_t;
 
+/**
+ * @brief RAM staging buffer for R2 file data received before metadata
+ */
+typedef struct CF_RxStaging
+{
+    struct CF_Transaction *txn;  /**< \brief owning transaction, NULL if the buffer is free */
+    uint32                 size; /**< \brief end of the highest staged file data, from offset 0 */
+    uint8                  data[CF_RX_STAGING_BUFFER_SIZE];
+} CF_RxStaging_t;
+
 /**
  * @brief Data specific to a receive file transaction
  */
@@ -266,7 +327,8 @@ typedef struct CF_RxState_Data
     CF_RxSubState_t sub_state;
     uint32          cached_pos;
 
-    CF_RxS2_Data_t r2;
+    CF_RxS2_Data_t  r2;
+    CF_RxStaging_t *staging; /**< \brief file data is held here instead of in txn->fd, if set */
 } CF_RxState_Data_t;
 
 /**
@@ -279,6 +341,10 @@ typedef struct CF_Flags_Common
     bool  suspended;
     bool  canceled;
     bool  crc_calc;
+    bool  checkpointed; /**< \brief a checkpoint file has been written for this transaction */
+    bool  compressed;   /**< \brief the file data is sent compressed */
+    bool  delta;        /**< \brief the file data is sent as a delta against the file last delivered */
+    bool  bundle;       /**< \brief the file is a bundle of small files, unpacked by the receiver */
 } CF_Flags_Common_t;
 
 /**
@@ -296,6 +362,10 @@ typedef struct CF_Flags_Rx
     bool inactivity_fired; /**< \brief used for r2 */
     bool complete;         /**< \brief r2 */
     bool fd_nak_sent;      /**< \brief latches that at least one NAK has been sent for file data */
+    bool partial;          /**< \brief r2, resumed a retained partial file, so NAKs give their scope */
+    bool prompted;         /**< \brief r2, a Prompt (NAK) asked for a NAK before EOF */
+    bool send_keep_alive;  /**< \brief r2, a Keep Alive is due */
+    bool expanded;         /**< \brief compressed data or a delta made into the file, or a bundle unpacked */
 } CF_Flags_Rx_t;
 
 /**
@@ -306,7 +376,16 @@ typedef struct CF_Flags_Tx
     CF_Flags_Common_t com;
 
     bool md_need_send;
-    bool cmd_tx; /**< \brief indicates transaction is commanded (ground) tx */
+    bool cmd_tx;          /**< \brief indicates transaction is commanded (ground) tx */
+    bool send_prompt;     /**< \brief s2, a Prompt (NAK) is due before the next file data */
+    bool delivered_check; /**< \brief file is being read to see if it matches an earlier delivery */
+    bool delivered;       /**< \brief file matched an earlier delivery, so nothing was sent */
+    bool compressing;     /**< \brief file is being compressed into a temp file before it is sent */
+    bool delta_encoding;  /**< \brief s2, file is being signed, and its delta made if possible, before it is sent */
+    bool delta_sigs;      /**< \brief s2, signatures of the file are waiting to be kept once it is delivered */
+    bool follow;          /**< \brief file is still being written, so its EOF waits until it stops growing */
+    bool follow_wait;     /**< \brief followed file had nothing new, so it waits on TXW for more */
+    bool prefetched;      /**< \brief file was opened and sized while pending, and its metadata is yet to be sent */
 } CF_Flags_Tx_t;
 
 /**
@@ -346,15 +425,22 @@ typedef struct CF_Transaction
     uint32    foffs; /**< \brief offset into file for next read */
     osal_id_t fd;
 
+    uint32    raw_size; /**< \brief file size before compression or delta, or files unpacked from a bundle */
+    uint32    zoffs;    /**< \brief offset reached by the compression, expansion, delta, or unbundling pass */
+    osal_id_t zfd;      /**< \brief the other file of the compression, expansion, or delta pass */
+    CF_Crc_t  zcrc;     /**< \brief checksum of the file a received delta rebuilds */
+
     CF_Crc_t crc;
 
     uint8 keep;
     uint8 chan_num; /**< \brief if ever more than one engine, this may need to change to pointer */
     uint8 priority;
+    uint8 compress; /**< \brief whether a send compresses its file data, see #CF_TxCompress_t */
 
     CF_CListNode_t cl_node;
 
-    CF_Playback_t *pb; /**< \brief NULL if transaction does not belong to a playback */
+    CF_Playback_t *pb;     /**< \brief NULL if transaction does not belong to a playback */
+    CF_FanOut_t *  fanout; /**< \brief NULL if transaction does not share its source file with others */
 
     CF_StateData_t state_data;
 
@@ -407,9 +493,66 @@ typedef struct CF_Channel
 
     const CF_Transaction_t *cur; /**< \brief current transaction during channel cycle */
 
+    uint32 rx_budget;        /**< \brief adaptive rx messages per wakeup, 0 until the first wakeup */
+    uint32 dir_reads;        /**< \brief playback directory entries read this wakeup */
+    uint32 outgoing_counter; /**< \brief messages sent this wakeup period, see max_outgoing_messages_per_wakeup */
+
     uint8 tick_type;
 } CF_Channel_t;
 
+/**
+ * @brief A received message, as handed to the engine by a transport
+ */
+typedef struct CF_TransportRxMsg
+{
+    const void *buf;            /**< \brief Start of the message, including any encapsulation */
+    size_t      encap_hdr_size; /**< \brief Size of the encapsulation before the PDU */
+    size_t      total_size;     /**< \brief Size of the encapsulation plus the PDU, no trailing bytes */
+} CF_TransportRxMsg_t;
+
+/**
+ * @brief PDU transport operations
+ *
+ * The engine moves PDUs through one of these per channel. A transport
+ * provides the buffer a PDU is encoded into, and the encapsulation around
+ * it, so the engine does not need to know how PDUs leave or arrive.
+ */
+typedef struct CF_Transport
+{
+    /**
+     * \brief Get a buffer to encode an outgoing PDU into
+     *
+     * Sets encap_hdr_size to the space reserved ahead of the PDU.
+     * Returns NULL if no buffer is available.
+     */
+    void *(*GetBuffer)(uint8 chan_num, size_t *encap_hdr_size);
+
+    /** \brief Give back a buffer from GetBuffer without sending it */
+    void (*ReleaseBuffer)(uint8 chan_num, void *buf);
+
+    /** \brief Send a buffer from GetBuffer holding a PDU of pdu_size bytes, and give it back */
+    void (*Send)(uint8 chan_num, void *buf, size_t pdu_size);
+
+    /**
+     * \brief Receive up to max_msgs messages without blocking
+     *
+     * Returns the number of entries filled in msgs. The buffers they point to
+     * stay valid until the next call for the same channel.
+     */
+    uint32 (*ReceiveBatch)(uint8 chan_num, CF_TransportRxMsg_t *msgs, uint32 max_msgs);
+} CF_Transport_t;
+
+/**
+ * @brief UDP transport state
+ */
+typedef struct CF_UdpIntf
+{
+    osal_id_t     sock_id[CF_NUM_CHANNELS];   /**< \brief socket per channel, undefined if the channel uses SB */
+    OS_SockAddr_t peer_addr[CF_NUM_CHANNELS]; /**< \brief where PDUs sent on each channel go */
+
+    uint8 tx_buf[CF_MAX_PDU_SIZE]; /**< \brief the one outgoing PDU */
+} CF_UdpIntf_t;
+
 /**
  * @brief CF engine output state
  *
@@ -417,7 +560,8 @@ typedef struct CF_Channel
  */
 typedef struct CF_Output
 {
-    CFE_SB_Buffer_t       *msg;        /**< \brief Binary message to be sent to underlying transport */
+    void                  *msg;        /**< \brief Binary message to be sent to underlying transport */
+    const CF_Transport_t  *transport;  /**< \brief Transport that msg came from */
     CF_EncoderState_t      encode;     /**< \brief Encoding state (while building message) */
     CF_Logical_PduBuffer_t tx_pdudata; /**< \brief Tx PDU logical values */
 } CF_Output_t;
@@ -425,13 +569,15 @@ typedef struct CF_Output
 /**
  * @brief CF engine input state
  *
- * Keeps the state of the current input PDU in the CF engine
+ * Keeps the state of the current batch of input PDUs in the CF engine.
+ * Entry i of each array belongs to the same PDU.
  */
 typedef struct CF_Input
 {
-    CFE_SB_Buffer_t       *msg;        /**< \brief Binary message received from underlying transport */
-    CF_DecoderState_t      decode;     /**< \brief Decoding state (while interpreting message) */
-    CF_Logical_PduBuffer_t rx_pdudata; /**< \brief Rx PDU logical values */
+    CF_DecoderState_t      decode[CF_TRANSPORT_RX_BATCH_SIZE];     /**< \brief Decoding state per PDU */
+    CF_Logical_PduBuffer_t rx_pdudata[CF_TRANSPORT_RX_BATCH_SIZE]; /**< \brief Rx PDU logical values per PDU */
+
+    uint8 rx_buf[CF_TRANSPORT_RX_BATCH_SIZE][CF_MAX_PDU_SIZE]; /**< \brief Received PDUs, held until the batch is done */
 } CF_Input_t;
 
 /**
@@ -454,8 +600,27 @@ typedef struct CF_Engine
     CF_ChunkWrapper_t chunks[CF_NUM_TRANSACTIONS * CF_Direction_NUM];
     CF_Chunk_t        chunk_mem[CF_NUM_CHUNKS_ALL_CHANNELS];
 
-    uint32 outgoing_counter;
-    bool  enabled;
+    CF_FlowPeer_t flow_peers[CF_NUM_FLOW_PEERS]; /**< \brief per destination flow control state */
+
+    CF_FanOut_t fanouts[CF_NUM_FANOUT_GROUPS]; /**< \brief source files of multi-destination sends */
+
+    CF_Compress_t compress; /**< \brief work area of the file data compression codec */
+    CF_Delta_t    delta;    /**< \brief work area of the delta codec */
+    CF_Bundle_t   bundle;   /**< \brief work area of the bundle being built */
+
+    CF_RxStaging_t  rx_staging[CF_NUM_RX_STAGING_BUFFERS];   /**< \brief pool for R2 file data received before md */
+    CF_TxPrefetch_t tx_prefetch[CF_NUM_TX_PREFETCH_BUFFERS]; /**< \brief pool for files of pending sends */
+
+    CF_UdpIntf_t udp; /**< \brief state of the UDP transport */
+
+    OS_time_t cycle_start;   /**< \brief when the current engine cycle started */
+    uint32    cycle_usec;    /**< \brief work budget of the current cycle (0 - unlimited, or not in a cycle) */
+    bool      cycle_expired; /**< \brief set once the current cycle has used up its budget */
+    uint8     cycle_chan;    /**< \brief channel the next cycle starts with */
+    uint8     instr_chan;    /**< \brief channel that latency samples are recorded against */
+    uint32    cycle_num;     /**< \brief count of engine cycles run, wraps */
+
+    bool enabled;
 } CF_Engine_t;
 
 #endif
@@ -327,6 +327,39 @@ const CF_Chunk_t *CF_ChunkList_GetFirstChunk(const CF_ChunkList_t *chunks)
     return chunks->count ? &chunks->chunks[0] : NULL;
 }
 
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_chunk.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CF_ChunkSize_t CF_ChunkList_CountUncovered(const CF_ChunkList_t *chunks, CF_ChunkOffset_t offset, CF_ChunkSize_t size)
+{
+    const CF_Chunk_t *chunk;
+    CF_ChunkOffset_t  start;
+    CF_ChunkOffset_t  end;
+    CF_ChunkIdx_t     i;
+
+    /* the chunks never overlap each other, so what each one covers of the range can be taken off in turn */
+    for (i = 0; i < chunks->count && size; ++i)
+    {
+        chunk = &chunks->chunks[i];
+        start = CF_Chunk_MAX(chunk->offset, offset);
+        end   = chunk->offset + chunk->size;
+        if (end > (offset + size))
+        {
+            end = offset + size;
+        }
+
+        if (end > start)
+        {
+            size -= end - start;
+        }
+    }
+
+    return size;
+}
+
 /*----------------------------------------------------------------
  *
  * Application-scope internal function
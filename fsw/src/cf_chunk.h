@@ -156,6 +156,20 @@ void CF_ChunkList_RemoveFromFirst(CF_ChunkList_t *chunks, CF_ChunkSize_t size);
  */
 const CF_Chunk_t *CF_ChunkList_GetFirstChunk(const CF_ChunkList_t *chunks);
 
+/************************************************************************/
+/** @brief Count the bytes of a range that are not in the list.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       chunks must not be NULL.
+ *
+ * @param chunks   Pointer to CF_ChunkList_t object
+ * @param offset   Start of the range
+ * @param size     Size of the range
+ *
+ * @returns Number of bytes in the range that no chunk covers
+ */
+CF_ChunkSize_t CF_ChunkList_CountUncovered(const CF_ChunkList_t *chunks, CF_ChunkOffset_t offset, CF_ChunkSize_t size);
+
 /************************************************************************/
 /** @brief Compute gaps between chunks, and call a callback for each.
  *
@@ -0,0 +1,694 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ *  The CF Application transaction checkpoint source file
+ *
+ *  Only class 2 transactions are checkpointed, since only they can recover
+ *  the file data that was in flight at the restart: a resumed sender
+ *  carries on from its last offset and resends whatever the receiver NAKs,
+ *  and a resumed receiver NAKs whatever its chunk list shows is missing.
+ *
+ *  Partial file records of failed receives live in the same directory, but
+ *  are keyed by the file rather than the transaction, since it is a new
+ *  transaction that picks them up.
+ */
+
+#include "cfe.h"
+#include "cf_verify.h"
+#include "cf_ckpt.h"
+#include "cf_app.h"
+#include "cf_events.h"
+#include "cf_utils.h"
+#include "cf_cfdp.h"
+#include "cf_cfdp_r.h"
+#include "cf_crc.h"
+#include "cf_filestore.h"
+#include "cf_assert.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_ckpt.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Ckpt_GetFilename(char *buf, size_t buf_size, const CF_Transaction_t *txn, const char *ext)
+{
+    snprintf(buf, buf_size, "%s/%u_%lu_%lu%s", CF_CHECKPOINT_DIR, (unsigned int)txn->chan_num,
+             (unsigned long)txn->history->src_eid, (unsigned long)txn->history->seq_num, ext);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static bool CF_Ckpt_IsDue(const CF_Transaction_t *txn)
+{
+    CFE_TIME_SysTime_t now;
+    bool               ret = false;
+
+    /* compressed file data, a delta or a bundle is sent from, or rebuilt from, a temp file a restart loses track of,
+     * and a followed file would be resumed as if it had stopped growing */
+    if (txn->flags.com.q_index != CF_QueueIdx_FREE && !txn->flags.com.canceled && !txn->flags.com.compressed &&
+        !txn->flags.com.delta && !txn->flags.com.bundle && !CF_TxnStatus_IsError(txn->history->txn_stat) &&
+        !(txn->state == CF_TxnState_S2 && txn->flags.tx.follow))
+    {
+        now = CFE_TIME_GetTime();
+        if ((now.Seconds - txn->history->perf.start_time.Seconds) >= CF_CHECKPOINT_INTERVAL_S)
+        {
+            if (txn->state == CF_TxnState_S2)
+            {
+                /* once the FIN has arrived there is nothing left worth resuming, the checksum of a
+                 * multi-destination send is kept by its fan-out group, which is not saved, and a file
+                 * being checked against an earlier delivery has a checksum that does not match foffs */
+                ret = (txn->state_data.send.sub_state < CF_TxSubState_SEND_FIN_ACK) && !txn->fanout &&
+                      !txn->flags.tx.delivered_check &&
+                      (CF_Filestore_FromPath(txn->history->fnames.src_filename) == &CF_Filestore_Osal);
+            }
+            else if (txn->state == CF_TxnState_R2)
+            {
+                /* before metadata the data is still in a temp file or in RAM, and a RAM file is lost anyway */
+                ret = txn->flags.rx.md_recv && !txn->flags.rx.complete && !txn->state_data.receive.staging &&
+                      (CF_Filestore_FromPath(txn->history->fnames.dst_filename) == &CF_Filestore_Osal);
+            }
+        }
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Ckpt_FillRecord(CF_CkptRecord_t *rec, const CF_Transaction_t *txn)
+{
+    memset(rec, 0, sizeof(*rec));
+    rec->magic      = CF_CKPT_FILE_MAGIC;
+    rec->version    = CF_CKPT_FILE_VERSION;
+    rec->chan_num   = txn->chan_num;
+    rec->state      = txn->state;
+    rec->priority   = txn->priority;
+    rec->keep       = txn->keep;
+    rec->src_eid    = txn->history->src_eid;
+    rec->peer_eid   = txn->history->peer_eid;
+    rec->seq_num    = txn->history->seq_num;
+    rec->fsize      = txn->fsize;
+    rec->num_chunks = txn->chunks->chunks.count;
+    rec->fnames     = txn->history->fnames;
+
+    if (txn->state == CF_TxnState_S2)
+    {
+        rec->sub_state = txn->state_data.send.sub_state;
+        rec->foffs     = txn->foffs;
+        rec->crc       = txn->crc;
+    }
+    else
+    {
+        rec->sub_state = txn->state_data.receive.sub_state;
+        rec->eof_recv  = txn->flags.rx.eof_recv;
+        rec->eof_cc    = txn->state_data.receive.r2.eof_cc;
+        rec->eof_crc   = txn->state_data.receive.r2.eof_crc;
+        rec->eof_size  = txn->state_data.receive.r2.eof_size;
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static CFE_Status_t CF_Ckpt_WriteFile(const CF_CkptRecord_t *rec, const CF_ChunkList_t *chunks, const char *tmpname,
+                                      const char *fname)
+{
+    osal_id_t    fd;
+    int32        bytes;
+    CFE_Status_t ret;
+
+    ret = CF_WrappedOpenCreate(&fd, tmpname, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY);
+    if (ret >= 0)
+    {
+        bytes = chunks->count * sizeof(CF_Chunk_t);
+        if (CF_WrappedWrite(fd, rec, sizeof(*rec)) != (CFE_Status_t)sizeof(*rec) ||
+            (bytes > 0 && CF_WrappedWrite(fd, chunks->chunks, bytes) != bytes))
+        {
+            ret = CF_ERROR;
+        }
+        else
+        {
+            ret = CFE_SUCCESS;
+        }
+
+        CF_WrappedClose(fd);
+
+        /* the previous file is only replaced once the new one is complete */
+        if (ret == CFE_SUCCESS && CF_WrappedRename(tmpname, fname) != OS_SUCCESS)
+        {
+            ret = CF_ERROR;
+        }
+    }
+    else
+    {
+        ret = CF_ERROR;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_ckpt.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_Ckpt_Write(CF_Transaction_t *txn)
+{
+    CF_CkptRecord_t rec;
+    char            tmpname[OS_MAX_PATH_LEN];
+    char            fname[OS_MAX_PATH_LEN];
+    CFE_Status_t    ret;
+
+    CF_Ckpt_FillRecord(&rec, txn);
+
+    CF_Ckpt_GetFilename(tmpname, sizeof(tmpname), txn, ".tmp");
+    CF_Ckpt_GetFilename(fname, sizeof(fname), txn, CF_CKPT_FILE_EXT);
+
+    ret = CF_Ckpt_WriteFile(&rec, &txn->chunks->chunks, tmpname, fname);
+    if (ret == CFE_SUCCESS)
+    {
+        txn->flags.com.checkpointed = true;
+    }
+    else
+    {
+        CFE_EVS_SendEvent(CF_CKPT_WRITE_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "CF(%lu:%lu): failed to write checkpoint %s", (unsigned long)txn->history->src_eid,
+                          (unsigned long)txn->history->seq_num, fname);
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_ckpt.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Ckpt_Remove(CF_Transaction_t *txn)
+{
+    char fname[OS_MAX_PATH_LEN];
+
+    if (txn->flags.com.checkpointed)
+    {
+        CF_Ckpt_GetFilename(fname, sizeof(fname), txn, CF_CKPT_FILE_EXT);
+        CF_WrappedRemove(fname);
+        txn->flags.com.checkpointed = false;
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_ckpt.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Ckpt_Cycle(void)
+{
+    CF_Ckpt_t *       ckpt   = &CF_AppData.ckpt;
+    uint32            writes = 0;
+    CF_Transaction_t *txn;
+
+    if (CF_CHECKPOINT_INTERVAL_S > 0)
+    {
+        /* a pass that takes longer than the interval delays the next one rather than overlapping it */
+        if (!CF_Timer_Expired(&ckpt->interval))
+        {
+            CF_Timer_Tick(&ckpt->interval);
+        }
+        else if (!ckpt->active)
+        {
+            ckpt->active = true;
+            ckpt->next   = 0;
+            CF_Timer_InitRelSec(&ckpt->interval, CF_CHECKPOINT_INTERVAL_S);
+        }
+
+        while (ckpt->active && writes < CF_CHECKPOINT_WRITES_PER_WAKEUP)
+        {
+            if (ckpt->next >= CF_NUM_TRANSACTIONS)
+            {
+                ckpt->active = false;
+            }
+            else
+            {
+                txn = &CF_AppData.engine.transactions[ckpt->next];
+                ++ckpt->next;
+
+                if (CF_Ckpt_IsDue(txn))
+                {
+                    /* a failed write counts too, so a bad checkpoint directory cannot hold up the engine */
+                    CF_Ckpt_Write(txn);
+                    ++writes;
+                }
+            }
+        }
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_ckpt.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Ckpt_Restore(void)
+{
+    osal_id_t   dir_id;
+    os_dirent_t dirent;
+    char        fname[OS_MAX_PATH_LEN];
+    const char *name;
+    size_t      len;
+    size_t      ext_len = strlen(CF_CKPT_FILE_EXT);
+
+    memset(&CF_AppData.ckpt, 0, sizeof(CF_AppData.ckpt));
+    CF_Timer_InitRelSec(&CF_AppData.ckpt.interval, CF_CHECKPOINT_INTERVAL_S);
+
+    if (OS_DirectoryOpen(&dir_id, CF_CHECKPOINT_DIR) == OS_SUCCESS)
+    {
+        while (OS_DirectoryRead(dir_id, &dirent) == OS_SUCCESS)
+        {
+            name = OS_DIRENTRY_NAME(dirent);
+            len  = strlen(name);
+
+            /* anything else, including a checkpoint that was never finished, is left alone */
+            if (len > ext_len && strcmp(&name[len - ext_len], CF_CKPT_FILE_EXT) == 0)
+            {
+                snprintf(fname, sizeof(fname), "%s/%s", CF_CHECKPOINT_DIR, name);
+                if (CF_Ckpt_Load(fname) != CFE_SUCCESS)
+                {
+                    CFE_EVS_SendEvent(CF_CKPT_RESUME_ERR_EID, CFE_EVS_EventType_ERROR,
+                                      "CF: could not resume checkpoint %s, removing it", fname);
+                    CF_WrappedRemove(fname);
+                }
+            }
+        }
+
+        OS_DirectoryClose(dir_id);
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_ckpt.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_Ckpt_Load(const char *fname)
+{
+    CF_CkptRecord_t rec;
+    osal_id_t       fd;
+    CFE_Status_t    ret;
+
+    ret = CF_WrappedOpenCreate(&fd, fname, OS_FILE_FLAG_NONE, OS_READ_ONLY);
+    if (ret >= 0)
+    {
+        if (CF_WrappedRead(fd, &rec, sizeof(rec)) == (CFE_Status_t)sizeof(rec))
+        {
+            ret = CF_Ckpt_Resume(&rec, fd);
+        }
+        else
+        {
+            ret = CF_ERROR;
+        }
+
+        CF_WrappedClose(fd);
+    }
+    else
+    {
+        ret = CF_ERROR;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static CFE_Status_t CF_Ckpt_CheckRecord(const CF_CkptRecord_t *rec)
+{
+    const CF_Channel_t *chan;
+    os_fstat_t          fst;
+    CFE_Status_t        ret = CF_ERROR;
+
+    if (rec->magic == CF_CKPT_FILE_MAGIC && rec->version == CF_CKPT_FILE_VERSION && rec->chan_num < CF_NUM_CHANNELS)
+    {
+        chan = &CF_AppData.engine.channels[rec->chan_num];
+
+        if (!chan->qs[CF_QueueIdx_FREE])
+        {
+            /* no transaction to resume it with */
+        }
+        else if (rec->state == CF_TxnState_S2)
+        {
+            /* data already sent can only be trusted if the file has not changed since */
+            if (chan->num_cmd_tx < CF_MAX_COMMANDED_PLAYBACK_FILES_PER_CHAN && rec->foffs <= rec->fsize &&
+                (rec->foffs == 0 ||
+                 (CF_WrappedStat(rec->fnames.src_filename, &fst) == OS_SUCCESS && OS_FILESTAT_SIZE(fst) == rec->fsize)))
+            {
+                ret = CFE_SUCCESS;
+            }
+        }
+        else if (rec->state == CF_TxnState_R2)
+        {
+            if (CF_AppData.hk.Payload.channel_hk[rec->chan_num].q_size[CF_QueueIdx_RX] < CF_MAX_SIMULTANEOUS_RX)
+            {
+                ret = CFE_SUCCESS;
+            }
+        }
+        else
+        {
+            /* only class 2 transactions are checkpointed */
+        }
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_ckpt.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_Ckpt_Resume(const CF_CkptRecord_t *rec, osal_id_t fd)
+{
+    CF_Channel_t *     chan;
+    CF_Transaction_t * txn;
+    CF_ChunkWrapper_t *cw;
+    CF_Direction_t     dir;
+    osal_id_t          file_fd = OS_OBJECT_ID_UNDEFINED;
+    int32              bytes;
+    CFE_Status_t       ret;
+
+    ret = CF_Ckpt_CheckRecord(rec);
+
+    if (ret == CFE_SUCCESS && rec->state == CF_TxnState_R2)
+    {
+        /* the received data is in the destination file, which must not be truncated */
+        if (CF_WrappedOpenCreate(&file_fd, rec->fnames.dst_filename, OS_FILE_FLAG_NONE, OS_READ_WRITE) < 0)
+        {
+            ret = CF_ERROR;
+        }
+    }
+
+    if (ret == CFE_SUCCESS)
+    {
+        chan = &CF_AppData.engine.channels[rec->chan_num];
+        dir  = (rec->state == CF_TxnState_S2) ? CF_Direction_TX : CF_Direction_RX;
+        cw   = CF_CFDP_FindUnusedChunks(chan, dir);
+
+        bytes = rec->num_chunks * sizeof(CF_Chunk_t);
+        if (rec->num_chunks > cw->chunks.max_chunks ||
+            (bytes > 0 && CF_WrappedRead(fd, cw->chunks.chunks, bytes) != bytes))
+        {
+            CF_CList_InsertBack(&chan->cs[dir], &cw->cl_node);
+            if (OS_ObjectIdDefined(file_fd))
+            {
+                CF_WrappedClose(file_fd);
+            }
+            ret = CF_ERROR;
+        }
+        else
+        {
+            cw->chunks.count = rec->num_chunks;
+
+            txn = CF_FindUnusedTransaction(chan);
+            CF_Assert(txn); /* checked for by CF_Ckpt_CheckRecord() */
+
+            txn->chunks                 = cw;
+            txn->priority               = rec->priority;
+            txn->keep                   = rec->keep;
+            txn->fsize                  = rec->fsize;
+            txn->flags.com.checkpointed = true;
+            txn->history->src_eid       = rec->src_eid;
+            txn->history->peer_eid      = rec->peer_eid;
+            txn->history->seq_num       = rec->seq_num;
+            txn->history->fnames        = rec->fnames;
+
+            CF_Timer_InitRelSec(&txn->inactivity_timer,
+                                CF_AppData.config_table->chan[txn->chan_num].inactivity_timer_s);
+
+            if (rec->state == CF_TxnState_S2)
+            {
+                /* metadata goes out again, then new file data from foffs, or the EOF if it was all sent */
+                txn->history->dir              = CF_Direction_TX;
+                txn->state                     = CF_TxnState_S2;
+                txn->state_data.send.sub_state = CF_TxSubState_METADATA;
+                txn->foffs                     = rec->foffs;
+                txn->crc                       = rec->crc;
+
+                /* it can no longer be tied to the playback that started it, so it counts as commanded */
+                txn->flags.tx.cmd_tx = true;
+                ++chan->num_cmd_tx;
+
+                if (rec->src_eid == CF_AppData.config_table->local_eid && rec->seq_num > CF_AppData.engine.seq_num)
+                {
+                    CF_AppData.engine.seq_num = rec->seq_num;
+                }
+
+                CF_InsertSortPrio(txn, CF_QueueIdx_PEND);
+            }
+            else
+            {
+                txn->history->dir                   = CF_Direction_RX;
+                txn->state                          = CF_TxnState_R2;
+                txn->fd                             = file_fd;
+                txn->state_data.receive.sub_state   = CF_RxSubState_FILEDATA;
+                txn->state_data.receive.r2.dc       = CF_CFDP_FinDeliveryCode_INCOMPLETE;
+                txn->state_data.receive.r2.fs       = CF_CFDP_FinFileStatus_DISCARDED;
+                txn->state_data.receive.r2.eof_cc   = rec->eof_cc;
+                txn->state_data.receive.r2.eof_crc  = rec->eof_crc;
+                txn->state_data.receive.r2.eof_size = rec->eof_size;
+                txn->flags.rx.md_recv               = true;
+                txn->flags.rx.eof_recv              = rec->eof_recv;
+
+                txn->flags.com.q_index = CF_QueueIdx_RX;
+                CF_CList_InsertBack_Ex(chan, CF_QueueIdx_RX, &txn->cl_node);
+
+                /* NAK whatever is missing straight away, or go on to the FIN if nothing is */
+                CF_CFDP_ArmAckTimer(txn);
+                CF_CFDP_R2_Complete(txn, 1);
+            }
+
+            CFE_EVS_SendEvent(CF_CKPT_RESUME_INF_EID, CFE_EVS_EventType_INFORMATION,
+                              "CF: resumed %s transaction (%lu:%lu) from checkpoint, %lu chunks",
+                              (rec->state == CF_TxnState_S2) ? "S2" : "R2", (unsigned long)rec->src_eid,
+                              (unsigned long)rec->seq_num, (unsigned long)rec->num_chunks);
+        }
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_ckpt.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Ckpt_GetPartialFilename(char *buf, size_t buf_size, CF_EntityId_t src_eid, const char *dst_filename,
+                                const char *ext)
+{
+    CF_Crc_t crc;
+
+    memset(&crc, 0, sizeof(crc));
+    CF_CRC_Start(&crc);
+    CF_CRC_Digest(&crc, (const uint8 *)dst_filename, strlen(dst_filename));
+    CF_CRC_Finalize(&crc);
+
+    snprintf(buf, buf_size, "%s/p%lu_%08lx%s", CF_CHECKPOINT_DIR, (unsigned long)src_eid, (unsigned long)crc.result,
+             ext);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static bool CF_Ckpt_IsRetainable(const CF_Transaction_t *txn)
+{
+    bool ret;
+
+    switch (txn->history->txn_stat)
+    {
+        case CF_TxnStatus_NO_ERROR:
+        case CF_TxnStatus_FILESTORE_REJECTION:
+        case CF_TxnStatus_FILE_CHECKSUM_FAILURE:
+        case CF_TxnStatus_FILE_SIZE_ERROR:
+        case CF_TxnStatus_INVALID_FILE_STRUCTURE:
+            /* the data itself cannot be trusted, or there is nothing to resume */
+            ret = false;
+            break;
+        default:
+            ret = true;
+            break;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_ckpt.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_Ckpt_RetainPartial(CF_Transaction_t *txn)
+{
+    CF_CkptRecord_t rec;
+    char            tmpname[OS_MAX_PATH_LEN];
+    char            fname[OS_MAX_PATH_LEN];
+    bool            ret = false;
+
+    /* before metadata the data is in a temp file under another name, and a RAM file is lost anyway,
+     * compressed data, a delta or a bundle only ever goes with the transfer it was made for,
+     * and a size of 0 may be an unbounded one that cannot tell one file from another */
+    if (CF_AppData.config_table->chan[txn->chan_num].rx_retain_partial && txn->state == CF_TxnState_R2 &&
+        txn->flags.rx.md_recv && !txn->flags.com.compressed && !txn->flags.com.delta && !txn->flags.com.bundle &&
+        txn->fsize != 0 && !txn->state_data.receive.staging && txn->chunks->chunks.count > 0 &&
+        CF_Ckpt_IsRetainable(txn) && CF_Filestore_FromPath(txn->history->fnames.dst_filename) == &CF_Filestore_Osal)
+    {
+        CF_Ckpt_FillRecord(&rec, txn);
+
+        CF_Ckpt_GetPartialFilename(tmpname, sizeof(tmpname), txn->history->src_eid,
+                                   txn->history->fnames.dst_filename, ".tmp");
+        CF_Ckpt_GetPartialFilename(fname, sizeof(fname), txn->history->src_eid, txn->history->fnames.dst_filename,
+                                   CF_CKPT_PARTIAL_EXT);
+
+        if (CF_Ckpt_WriteFile(&rec, &txn->chunks->chunks, tmpname, fname) == CFE_SUCCESS)
+        {
+            ret = true;
+        }
+        else
+        {
+            /* without its record the file could never be picked up again */
+            CFE_EVS_SendEvent(CF_CKPT_WRITE_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "CF(%lu:%lu): failed to write partial file record %s",
+                              (unsigned long)txn->history->src_eid, (unsigned long)txn->history->seq_num, fname);
+        }
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_ckpt.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_Ckpt_ClaimPartial(CF_Transaction_t *txn)
+{
+    CF_CkptRecord_t rec;
+    CF_ChunkList_t *chunks = &txn->chunks->chunks;
+    char            fname[OS_MAX_PATH_LEN];
+    osal_id_t       fd;
+    int32           bytes;
+    uint32          held;
+    uint32          i;
+    bool            ret = false;
+
+    /* an unbounded size in the metadata is no way to know a partial file is of the same one */
+    if (CF_AppData.config_table->chan[txn->chan_num].rx_retain_partial && !txn->flags.com.compressed &&
+        !txn->flags.com.delta && !txn->flags.com.bundle && txn->fsize != 0)
+    {
+        CF_Ckpt_GetPartialFilename(fname, sizeof(fname), txn->history->src_eid, txn->history->fnames.dst_filename,
+                                   CF_CKPT_PARTIAL_EXT);
+
+        if (CF_WrappedOpenCreate(&fd, fname, OS_FILE_FLAG_NONE, OS_READ_ONLY) >= 0)
+        {
+            /* a different size means a different file, and the name CRC could collide */
+            if (CF_WrappedRead(fd, &rec, sizeof(rec)) == (CFE_Status_t)sizeof(rec) &&
+                rec.magic == CF_CKPT_FILE_MAGIC && rec.version == CF_CKPT_FILE_VERSION &&
+                rec.state == CF_TxnState_R2 && rec.src_eid == txn->history->src_eid && rec.fsize == txn->fsize &&
+                rec.num_chunks <= chunks->max_chunks &&
+                strncmp(rec.fnames.dst_filename, txn->history->fnames.dst_filename,
+                        sizeof(rec.fnames.dst_filename)) == 0)
+            {
+                bytes = rec.num_chunks * sizeof(CF_Chunk_t);
+                if ((bytes == 0 || CF_WrappedRead(fd, chunks->chunks, bytes) == bytes) &&
+                    CF_WrappedOpenCreate(&txn->fd, txn->history->fnames.dst_filename, OS_FILE_FLAG_NONE,
+                                         OS_READ_WRITE) >= 0)
+                {
+                    chunks->count = rec.num_chunks;
+                    ret           = true;
+                }
+            }
+
+            CF_WrappedClose(fd);
+            CF_WrappedRemove(fname);
+        }
+    }
+
+    if (ret)
+    {
+        held = 0;
+        for (i = 0; i < chunks->count; ++i)
+        {
+            held += chunks->chunks[i].size;
+        }
+
+        /* NAK the missing ranges now, so the sender need not send what is already here */
+        txn->flags.rx.partial  = true;
+        txn->flags.rx.send_nak = true;
+
+        CFE_EVS_SendEvent(CF_CKPT_PARTIAL_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "CF R2(%lu:%lu): resuming partial file %s, %lu of %lu bytes held",
+                          (unsigned long)txn->history->src_eid, (unsigned long)txn->history->seq_num,
+                          txn->history->fnames.dst_filename, (unsigned long)held, (unsigned long)txn->fsize);
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_ckpt.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Ckpt_DropPartial(CF_Transaction_t *txn)
+{
+    char fname[OS_MAX_PATH_LEN];
+
+    if (CF_AppData.config_table->chan[txn->chan_num].rx_retain_partial)
+    {
+        CF_Ckpt_GetPartialFilename(fname, sizeof(fname), txn->history->src_eid, txn->history->fnames.dst_filename,
+                                   CF_CKPT_PARTIAL_EXT);
+        CF_WrappedRemove(fname);
+    }
+}
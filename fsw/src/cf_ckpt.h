@@ -0,0 +1,280 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ *  The CF Application transaction checkpoint header file
+ *
+ *  A checkpoint is one small file per long-running class 2 transaction,
+ *  holding what is needed to pick the transaction up again after a
+ *  restart: its identity, file names, size, progress and chunk list.
+ *
+ *  The same record is used for the partial file a failed class 2 receive
+ *  leaves behind on a channel with rx_retain_partial set, so a later send
+ *  of the same file only needs the ranges that are still missing.
+ */
+
+#ifndef CF_CKPT_H
+#define CF_CKPT_H
+
+#include "cfe.h"
+#include "cf_platform_cfg.h"
+#include "cf_extern_typedefs.h"
+#include "cf_cfdp_types.h"
+
+/**
+ * @brief Magic number at the start of a checkpoint file, "CFCK"
+ */
+#define CF_CKPT_FILE_MAGIC (0x4346434B)
+
+/**
+ * @brief Version of the checkpoint file layout
+ */
+#define CF_CKPT_FILE_VERSION (1)
+
+/**
+ * @brief Extension of checkpoint files in CF_CHECKPOINT_DIR
+ *
+ * A checkpoint is written under another name first and renamed to this
+ * one when complete, so a restart part way through a write never leaves
+ * a truncated checkpoint to be resumed.
+ */
+#define CF_CKPT_FILE_EXT ".ckp"
+
+/**
+ * @brief Extension of retained partial file records in CF_CHECKPOINT_DIR
+ */
+#define CF_CKPT_PARTIAL_EXT ".prt"
+
+/**
+ * @brief Checkpoint of one transaction, as written at the start of its file
+ *
+ * The chunk list follows, as num_chunks CF_Chunk_t entries. For a sender
+ * these are the ranges the receiver has asked to be sent again, for a
+ * receiver the ranges received so far.
+ */
+typedef struct CF_CkptRecord
+{
+    uint32              magic;      /**< \brief #CF_CKPT_FILE_MAGIC */
+    uint16              version;    /**< \brief #CF_CKPT_FILE_VERSION */
+    uint8               chan_num;   /**< \brief Channel number */
+    uint8               state;      /**< \brief CF_TxnState_S2 or CF_TxnState_R2 */
+    uint8               sub_state;  /**< \brief Send or receive sub state */
+    uint8               priority;   /**< \brief Transaction priority */
+    uint8               keep;       /**< \brief Keep the file when done */
+    uint8               eof_recv;   /**< \brief Receiver only, the EOF has been received */
+    uint8               eof_cc;     /**< \brief Receiver only, condition code of the EOF */
+    uint8               spare[3];
+    CF_EntityId_t       src_eid;    /**< \brief Transaction source entity */
+    CF_EntityId_t       peer_eid;   /**< \brief Remote entity */
+    CF_TransactionSeq_t seq_num;    /**< \brief Transaction sequence number */
+    uint32              fsize;      /**< \brief File size */
+    uint32              foffs;      /**< \brief Sender only, offset of the next new file data to send */
+    CF_Crc_t            crc;        /**< \brief Sender only, running CRC of the file data up to foffs */
+    uint32              eof_crc;    /**< \brief Receiver only, CRC from the EOF */
+    uint32              eof_size;   /**< \brief Receiver only, file size from the EOF */
+    uint32              num_chunks; /**< \brief Entries in the chunk list that follows */
+    CF_TxnFilenames_t   fnames;     /**< \brief Source and destination file names */
+} CF_CkptRecord_t;
+
+/**
+ * @brief Checkpoint schedule
+ *
+ * Every CF_CHECKPOINT_INTERVAL_S a pass is made over all transactions,
+ * writing at most CF_CHECKPOINT_WRITES_PER_WAKEUP checkpoints per wakeup.
+ */
+typedef struct CF_Ckpt
+{
+    CF_Timer_t interval; /**< \brief Time until the next pass starts */
+    uint32     next;     /**< \brief Index of the next transaction the current pass looks at */
+    bool       active;   /**< \brief A pass is in progress */
+} CF_Ckpt_t;
+
+/************************************************************************/
+/** @brief Get the name of the checkpoint file of a transaction.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       buf must not be NULL. txn must not be NULL and must have a history.
+ *
+ * @param buf      Buffer for the name
+ * @param buf_size Size of buf
+ * @param txn      Transaction
+ * @param ext      Extension to add to the name
+ */
+void CF_Ckpt_GetFilename(char *buf, size_t buf_size, const CF_Transaction_t *txn, const char *ext);
+
+/************************************************************************/
+/** @brief Write the checkpoint of a transaction.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL, and must be an active S2 or R2 transaction.
+ *
+ * @param txn  Transaction
+ *
+ * @retval CFE_SUCCESS if the checkpoint was written
+ * @retval CF_ERROR if it could not be written, any earlier checkpoint is left in place
+ */
+CFE_Status_t CF_Ckpt_Write(CF_Transaction_t *txn);
+
+/************************************************************************/
+/** @brief Remove the checkpoint of a transaction, if one was written.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL and must have a history. Called as the
+ *       transaction finishes, whether it succeeded or not.
+ *
+ * @param txn  Transaction
+ */
+void CF_Ckpt_Remove(CF_Transaction_t *txn);
+
+/************************************************************************/
+/** @brief Carry on with checkpointing.
+ *
+ * @par Description
+ *       Starts a pass over all transactions once the interval has passed,
+ *       and writes the checkpoints of the transactions that need one, up
+ *       to CF_CHECKPOINT_WRITES_PER_WAKEUP per call.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       Called once per wakeup while the engine is enabled. Does nothing
+ *       if CF_CHECKPOINT_INTERVAL_S is 0.
+ */
+void CF_Ckpt_Cycle(void);
+
+/************************************************************************/
+/** @brief Resume the transactions checkpointed in CF_CHECKPOINT_DIR.
+ *
+ * @par Description
+ *       Every checkpoint is either resumed or, if it cannot be, removed.
+ *       Also starts the checkpoint schedule.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       Called once the engine has been initialized, before it runs.
+ */
+void CF_Ckpt_Restore(void);
+
+/************************************************************************/
+/** @brief Resume the transaction in a checkpoint file.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       fname must not be NULL.
+ *
+ * @param fname  Checkpoint file
+ *
+ * @retval CFE_SUCCESS if the transaction was resumed
+ * @retval CF_ERROR if the file could not be read, or the transaction could not be resumed
+ */
+CFE_Status_t CF_Ckpt_Load(const char *fname);
+
+/************************************************************************/
+/** @brief Resume a transaction from its checkpoint.
+ *
+ * @par Description
+ *       A sender is put back on the pending queue to send metadata again,
+ *       and then carries on with new file data from where it had got to.
+ *       A receiver reopens its file and asks for whatever the chunk list
+ *       shows is still missing.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       rec must not be NULL. fd must be positioned at the chunk list.
+ *
+ * @param rec  Checkpoint record
+ * @param fd   Checkpoint file, to read the chunk list from
+ *
+ * @retval CFE_SUCCESS if the transaction was resumed
+ * @retval CF_ERROR if the checkpoint is not valid or the transaction could not be resumed
+ */
+CFE_Status_t CF_Ckpt_Resume(const CF_CkptRecord_t *rec, osal_id_t fd);
+
+/************************************************************************/
+/** @brief Get the name of the partial file record for a received file.
+ *
+ * @par Description
+ *       The record is found again by the source entity and the destination
+ *       file name, so the name is built from the source entity and a CRC
+ *       of the destination file name.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       buf and dst_filename must not be NULL.
+ *
+ * @param buf          Buffer for the name
+ * @param buf_size     Size of buf
+ * @param src_eid      Source entity of the file
+ * @param dst_filename Destination file name
+ * @param ext          Extension to add to the name
+ */
+void CF_Ckpt_GetPartialFilename(char *buf, size_t buf_size, CF_EntityId_t src_eid, const char *dst_filename,
+                                const char *ext);
+
+/************************************************************************/
+/** @brief Keep the partial file of a failed receive.
+ *
+ * @par Description
+ *       If the channel has rx_retain_partial set, and the transaction is
+ *       an R2 that got its metadata and some file data before failing for
+ *       a reason other than the file itself, its chunk list is written to
+ *       a partial file record and the destination file is left in place.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL. Called as the transaction is reset, after its
+ *       file has been closed, in place of removing the file.
+ *
+ * @param txn  Transaction
+ *
+ * @retval true if the partial file was kept
+ * @retval false if the file should be removed as usual
+ */
+bool CF_Ckpt_RetainPartial(CF_Transaction_t *txn);
+
+/************************************************************************/
+/** @brief Pick up a retained partial file for a new receive.
+ *
+ * @par Description
+ *       If a partial file record exists for the source entity and
+ *       destination file of the transaction, and it is for a file of the
+ *       same size, the destination file is opened without truncating it
+ *       and the chunk list is loaded from the record. The transaction then
+ *       NAKs the missing ranges straight away. The record is removed
+ *       either way, since a failure of this transaction writes a new one.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL, and must be an R2 that has just received its
+ *       metadata and has not opened its file yet.
+ *
+ * @param txn  Transaction
+ *
+ * @retval true if the partial file was picked up and txn->fd is open on it
+ * @retval false if the destination file should be created as usual
+ */
+bool CF_Ckpt_ClaimPartial(CF_Transaction_t *txn);
+
+/************************************************************************/
+/** @brief Remove the partial file record for the file of a transaction.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       txn must not be NULL. Used when the destination file is replaced
+ *       without being claimed, so a stale record cannot be picked up later.
+ *       Does nothing unless the channel has rx_retain_partial set.
+ *
+ * @param txn  Transaction
+ */
+void CF_Ckpt_DropPartial(CF_Transaction_t *txn);
+
+#endif /* !CF_CKPT_H */
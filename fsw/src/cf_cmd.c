@@ -31,6 +31,9 @@
 #include "cf_events.h"
 #include "cf_perfids.h"
 #include "cf_utils.h"
+#include "cf_instr.h"
+#include "cf_trace.h"
+#include "cf_evagg.h"
 #include "cf_version.h"
 #include "cf_platform_cfg.h"
 
@@ -64,13 +67,13 @@ CFE_Status_t CF_NoopCmd(const CF_NoopCmd_t *msg)
 CFE_Status_t CF_ResetCountersCmd(const CF_ResetCountersCmd_t *msg)
 {
     const CF_UnionArgs_Payload_t *data     = &msg->Payload;
-    static const char            *names[5] = {"all", "cmd", "fault", "up", "down"};
-    /* 0=all, 1=cmd, 2=fault 3=up 4=down */
+    static const char            *names[6] = {"all", "cmd", "fault", "up", "down", "diag"};
+    /* 0=all, 1=cmd, 2=fault 3=up 4=down 5=diag */
     uint8 param = data->byte[0];
     int   i;
     bool  acc = true;
 
-    if (param > 4)
+    if (param > 5)
     {
         CFE_EVS_SendEvent(CF_CMD_RESET_INVALID_ERR_EID, CFE_EVS_EventType_ERROR,
                           "CF: Received RESET COUNTERS command with invalid parameter %d", param);
@@ -103,8 +106,12 @@ CFE_Status_t CF_ResetCountersCmd(const CF_ResetCountersCmd_t *msg)
         {
             /* up counters */
             for (i = 0; i < CF_NUM_CHANNELS; ++i)
+            {
                 memset(&CF_AppData.hk.Payload.channel_hk[i].counters.recv, 0,
                        sizeof(CF_AppData.hk.Payload.channel_hk[i].counters.recv));
+                CF_AppData.hk.Payload.channel_hk[i].rx_pipe_high_water = 0;
+                CF_AppData.hk.Payload.channel_hk[i].rx_pipe_full       = 0;
+            }
         }
 
         /* if the param is CF_Reset_down, or all counters */
@@ -116,6 +123,19 @@ CFE_Status_t CF_ResetCountersCmd(const CF_ResetCountersCmd_t *msg)
                        sizeof(CF_AppData.hk.Payload.channel_hk[i].counters.sent));
         }
 
+        /* engine cycle timing is not in any of the counter groups */
+        if (param == CF_Reset_all)
+        {
+            memset(&CF_AppData.hk.Payload.cycle, 0, sizeof(CF_AppData.hk.Payload.cycle));
+        }
+
+        /* if the param is CF_Reset_diag, or all counters */
+        if ((param == CF_Reset_all) || (param == CF_Reset_diag))
+        {
+            /* latency histograms */
+            CF_Instr_Reset();
+        }
+
         if (acc)
         {
             ++CF_AppData.hk.Payload.counters.cmd;
@@ -138,14 +158,16 @@ CFE_Status_t CF_TxFileCmd(const CF_TxFileCmd_t *msg)
     /*
      * This needs to validate all its inputs.
      * "keep" should only be 0 or 1 (logical true/false).
+     * "compress" must be one of CF_TxCompress_t.
      * For priority and dest_id params, anything is acceptable.
      */
     if ((tx->cfdp_class != CF_CFDP_CLASS_1 && tx->cfdp_class != CF_CFDP_CLASS_2) || tx->chan_num >= CF_NUM_CHANNELS ||
-        (int)tx->keep > 1)
+        (int)tx->keep > 1 || tx->compress >= CF_TxCompress_NUM)
     {
         CFE_EVS_SendEvent(CF_CMD_BAD_PARAM_ERR_EID, CFE_EVS_EventType_ERROR,
-                          "CF: bad parameter in CF_TxFileCmd(): chan=%u, class=%u keep=%u", (unsigned int)tx->chan_num,
-                          (unsigned int)tx->cfdp_class, (unsigned int)tx->keep);
+                          "CF: bad parameter in CF_TxFileCmd(): chan=%u, class=%u keep=%u compress=%u",
+                          (unsigned int)tx->chan_num, (unsigned int)tx->cfdp_class, (unsigned int)tx->keep,
+                          (unsigned int)tx->compress);
         ++CF_AppData.hk.Payload.counters.err;
 
         /* This must return CFE_SUCCESS because the command is done (error counter was incremented, no more events) */
@@ -159,7 +181,7 @@ CFE_Status_t CF_TxFileCmd(const CF_TxFileCmd_t *msg)
 #endif
 
     if (CF_CFDP_TxFile(tx->src_filename, tx->dst_filename, tx->cfdp_class, tx->keep, tx->chan_num, tx->priority,
-                       tx->dest_id) == CFE_SUCCESS)
+                       tx->dest_id, tx->compress) == CFE_SUCCESS)
     {
         CFE_EVS_SendEvent(CF_CMD_TX_FILE_INF_EID, CFE_EVS_EventType_INFORMATION,
                           "CF: file transfer successfully initiated");
@@ -180,7 +202,52 @@ CFE_Status_t CF_TxFileCmd(const CF_TxFileCmd_t *msg)
  * See description in cf_cmd.h for argument/return detail
  *
  *-----------------------------------------------------------------*/
-CFE_Status_t CF_PlaybackDirCmd(const CF_PlaybackDirCmd_t *msg)
+CFE_Status_t CF_TxFileMultiCmd(const CF_TxFileMultiCmd_t *msg)
+{
+    const CF_TxFileMulti_Payload_t *tx = &msg->Payload;
+
+    /*
+     * This needs to validate all its inputs.
+     * "keep" should only be 0 or 1 (logical true/false).
+     * For priority and dest_id params, anything is acceptable.
+     */
+    if ((tx->cfdp_class != CF_CFDP_CLASS_1 && tx->cfdp_class != CF_CFDP_CLASS_2) || tx->chan_num >= CF_NUM_CHANNELS ||
+        (int)tx->keep > 1 || tx->num_dest == 0 || tx->num_dest > CF_TX_MULTI_MAX_DEST)
+    {
+        CFE_EVS_SendEvent(CF_CMD_BAD_PARAM_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "CF: bad parameter in CF_TxFileMultiCmd(): chan=%u, class=%u keep=%u num_dest=%u",
+                          (unsigned int)tx->chan_num, (unsigned int)tx->cfdp_class, (unsigned int)tx->keep,
+                          (unsigned int)tx->num_dest);
+        ++CF_AppData.hk.Payload.counters.err;
+
+        /* This must return CFE_SUCCESS because the command is done (error counter was incremented, no more events) */
+        return CFE_SUCCESS;
+    }
+
+    if (CF_CFDP_TxFileMulti(tx->src_filename, tx->dst_filename, tx->cfdp_class, tx->keep, tx->chan_num, tx->priority,
+                            tx->dest_id, tx->num_dest) == CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(CF_CMD_TX_FILE_MULTI_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "CF: file transfer to %u destinations successfully initiated", (unsigned int)tx->num_dest);
+        ++CF_AppData.hk.Payload.counters.cmd;
+    }
+    else
+    {
+        CFE_EVS_SendEvent(CF_CMD_TX_FILE_MULTI_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "CF: multi-destination file transfer initiation failed");
+        ++CF_AppData.hk.Payload.counters.err;
+    }
+
+    return CFE_SUCCESS;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cmd.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_TxFileFollowCmd(const CF_TxFileFollowCmd_t *msg)
 {
     const CF_TxFile_Payload_t *tx = &msg->Payload;
 
@@ -193,7 +260,7 @@ CFE_Status_t CF_PlaybackDirCmd(const CF_PlaybackDirCmd_t *msg)
         (int)tx->keep > 1)
     {
         CFE_EVS_SendEvent(CF_CMD_BAD_PARAM_ERR_EID, CFE_EVS_EventType_ERROR,
-                          "CF: bad parameter in CF_PlaybackDirCmd(): chan=%u, class=%u keep=%u",
+                          "CF: bad parameter in CF_TxFileFollowCmd(): chan=%u, class=%u keep=%u",
                           (unsigned int)tx->chan_num, (unsigned int)tx->cfdp_class, (unsigned int)tx->keep);
         ++CF_AppData.hk.Payload.counters.err;
 
@@ -201,6 +268,53 @@ CFE_Status_t CF_PlaybackDirCmd(const CF_PlaybackDirCmd_t *msg)
         return CFE_SUCCESS;
     }
 
+    if (CF_CFDP_TxFileFollow(tx->src_filename, tx->dst_filename, tx->cfdp_class, tx->keep, tx->chan_num, tx->priority,
+                             tx->dest_id) == CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(CF_CMD_TX_FILE_FOLLOW_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "CF: followed file transfer successfully initiated");
+        ++CF_AppData.hk.Payload.counters.cmd;
+    }
+    else
+    {
+        CFE_EVS_SendEvent(CF_CMD_TX_FILE_FOLLOW_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "CF: followed file transfer initiation failed");
+        ++CF_AppData.hk.Payload.counters.err;
+    }
+
+    return CFE_SUCCESS;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cmd.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_PlaybackDirCmd(const CF_PlaybackDirCmd_t *msg)
+{
+    const CF_TxFile_Payload_t *tx = &msg->Payload;
+
+    /*
+     * This needs to validate all its inputs.
+     * "keep" should only be 0 or 1 (logical true/false).
+     * "order" must be one of CF_PlaybackOrder_t, and "compress" one of CF_TxCompress_t.
+     * For priority and dest_id params, anything is acceptable.
+     */
+    if ((tx->cfdp_class != CF_CFDP_CLASS_1 && tx->cfdp_class != CF_CFDP_CLASS_2) || tx->chan_num >= CF_NUM_CHANNELS ||
+        (int)tx->keep > 1 || tx->order >= CF_PlaybackOrder_NUM || tx->compress >= CF_TxCompress_NUM)
+    {
+        CFE_EVS_SendEvent(CF_CMD_BAD_PARAM_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "CF: bad parameter in CF_PlaybackDirCmd(): chan=%u, class=%u keep=%u max_ts=%u order=%u "
+                          "compress=%u",
+                          (unsigned int)tx->chan_num, (unsigned int)tx->cfdp_class, (unsigned int)tx->keep,
+                          (unsigned int)tx->max_ts, (unsigned int)tx->order, (unsigned int)tx->compress);
+        ++CF_AppData.hk.Payload.counters.err;
+
+        /* This must return CFE_SUCCESS because the command is done (error counter was incremented, no more events) */
+        return CFE_SUCCESS;
+    }
+
 #ifdef jphfix
     /* make sure that the src and dst filenames are null terminated */
     tx->src_filename[sizeof(tx->src_filename) - 1] = 0;
@@ -208,7 +322,7 @@ CFE_Status_t CF_PlaybackDirCmd(const CF_PlaybackDirCmd_t *msg)
 #endif
 
     if (CF_CFDP_PlaybackDir(tx->src_filename, tx->dst_filename, tx->cfdp_class, tx->keep, tx->chan_num, tx->priority,
-                            tx->dest_id) == CFE_SUCCESS)
+                            tx->dest_id, tx->max_ts, tx->order, tx->compress) == CFE_SUCCESS)
     {
         CFE_EVS_SendEvent(CF_CMD_PLAYBACK_DIR_INF_EID, CFE_EVS_EventType_INFORMATION,
                           "CF: directory playback initiation successful");
@@ -940,6 +1054,32 @@ CFE_Status_t CF_WriteQueueCmd(const CF_WriteQueueCmd_t *msg)
     return CFE_SUCCESS;
 }
 
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_cmd.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_WriteTraceCmd(const CF_WriteTraceCmd_t *msg)
+{
+    const CF_WriteTrace_Payload_t *wt = &msg->Payload;
+
+    if (CF_Trace_StartDump(wt->filename) == CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(CF_CMD_WRITE_TRACE_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "CF: writing trace to %s", wt->filename);
+        ++CF_AppData.hk.Payload.counters.cmd;
+    }
+    else
+    {
+        CFE_EVS_SendEvent(CF_CMD_WRITE_TRACE_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "CF: write trace failed, dump already in progress or failed to open file %s", wt->filename);
+        ++CF_AppData.hk.Payload.counters.err;
+    }
+
+    return CFE_SUCCESS;
+}
+
 /*----------------------------------------------------------------
  *
  * Application-scope internal function
@@ -1041,6 +1181,10 @@ void CF_GetSetParamCmd(bool is_set, CF_GetSet_ValueID_t param_id, uint32 value,
             item.size = sizeof(config->chan[chan_num].max_outgoing_messages_per_wakeup);
             item.fn   = CF_ValidateMaxOutgoingCmd;
             break;
+        case CF_GetSet_ValueID_cycle_max_usec:
+            item.ptr  = &config->cycle_max_usec;
+            item.size = sizeof(config->cycle_max_usec);
+            break;
         default:
             break;
     };
@@ -1227,6 +1371,9 @@ CFE_Status_t CF_SendHkCmd(const CF_SendHkCmd_t *msg)
     CFE_SB_TimeStampMsg(CFE_MSG_PTR(CF_AppData.hk.TelemetryHeader));
     /* return value ignored */ CFE_SB_TransmitMsg(CFE_MSG_PTR(CF_AppData.hk.TelemetryHeader), true);
 
+    /* the latency histograms go out at the housekeeping rate */
+    CF_Instr_SendDiag();
+
     /* This is also used to check tables */
     CF_CheckTables();
 
@@ -1245,5 +1392,9 @@ CFE_Status_t CF_WakeupCmd(const CF_WakeupCmd_t *msg)
     CF_CFDP_CycleEngine();
     CFE_ES_PerfLogExit(CF_PERF_ID_CYCLE_ENG);
 
+    /* a trace dump and event aggregation carry on even while the engine is disabled */
+    CF_Trace_DumpCycle();
+    CF_EvAgg_Tick();
+
     return CFE_SUCCESS;
 }
@@ -173,6 +173,36 @@ CFE_Status_t CF_ResetCountersCmd(const CF_ResetCountersCmd_t *msg);
  */
 CFE_Status_t CF_TxFileCmd(const CF_TxFileCmd_t *msg);
 
+/************************************************************************/
+/** @brief Ground command to start a file transfer to several destinations.
+ *
+ * @par Description
+ *       This function has a signature the same of all cmd_ functions.
+ *       Increments the command accept or reject counter.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       msg must not be NULL.
+ *
+ * @param msg   Pointer to command message
+ *
+ */
+CFE_Status_t CF_TxFileMultiCmd(const CF_TxFileMultiCmd_t *msg);
+
+/************************************************************************/
+/** @brief Ground command to start a file transfer of a file still being written.
+ *
+ * @par Description
+ *       This function has a signature the same of all cmd_ functions.
+ *       Increments the command accept or reject counter.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       msg must not be NULL.
+ *
+ * @param msg   Pointer to command message
+ *
+ */
+CFE_Status_t CF_TxFileFollowCmd(const CF_TxFileFollowCmd_t *msg);
+
 /************************************************************************/
 /** @brief Ground command to start directory playback.
  *
@@ -510,6 +540,19 @@ CFE_Status_t CF_PurgeQueueCmd(const CF_PurgeQueueCmd_t *msg);
  */
 CFE_Status_t CF_WriteQueueCmd(const CF_WriteQueueCmd_t *msg);
 
+/************************************************************************/
+/** @brief Ground command to write the trace ring to a file.
+ *
+ * @par Description
+ *       Starts the dump, which is completed over the following wakeups.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       msg must not be NULL.
+ *
+ * @param msg   Pointer to command message
+ */
+CFE_Status_t CF_WriteTraceCmd(const CF_WriteTraceCmd_t *msg);
+
 /************************************************************************/
 /** @brief Checks if the value is less than or equal to the max PDU size.
  *
@@ -102,6 +102,11 @@ static const CF_Codec_BitField_t CF_CFDP_PduAck_DIR_SUBTYPE_CODE   = CF_INIT_FIE
 static const CF_Codec_BitField_t CF_CFDP_PduAck_CC                 = CF_INIT_FIELD(4, 4);
 static const CF_Codec_BitField_t CF_CFDP_PduAck_TRANSACTION_STATUS = CF_INIT_FIELD(2, 0);
 
+/*
+ * Position of the response required flag within the Prompt PDU.
+ */
+static const CF_Codec_BitField_t CF_CFDP_PduPrompt_RESPONSE_REQUIRED = CF_INIT_FIELD(1, 7);
+
 /*
  * Position of the sub-field values within the directive_and_subtype_code
  * and cc_and_transaction_status fields within the ACK PDU.
@@ -585,6 +590,8 @@ void CF_CFDP_EncodeMd(CF_EncoderState_t *state, CF_Logical_PduMd_t *plmd)
         /* Add in LV for src/dest */
         CF_CFDP_EncodeLV(state, &plmd->source_filename);
         CF_CFDP_EncodeLV(state, &plmd->dest_filename);
+
+        CF_CFDP_EncodeAllTlv(state, &plmd->tlv_list);
     }
 }
 
@@ -712,6 +719,41 @@ void CF_CFDP_EncodeNak(CF_EncoderState_t *state, CF_Logical_PduNak_t *plnak)
     }
 }
 
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_codec.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_EncodePrompt(CF_EncoderState_t *state, CF_Logical_PduPrompt_t *plprompt)
+{
+    CF_CFDP_PduPrompt_t *prompt; /* for encoding fixed sized fields */
+
+    prompt = CF_ENCODE_FIXED_CHUNK(state, CF_CFDP_PduPrompt_t);
+    if (prompt != NULL)
+    {
+        CF_Codec_Store_uint8(&(prompt->response_required), 0);
+        FSV(prompt->response_required, CF_CFDP_PduPrompt_RESPONSE_REQUIRED, plprompt->response_required);
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_codec.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_EncodeKeepAlive(CF_EncoderState_t *state, CF_Logical_PduKeepAlive_t *plka)
+{
+    CF_CFDP_PduKeepAlive_t *ka; /* for encoding fixed sized fields */
+
+    ka = CF_ENCODE_FIXED_CHUNK(state, CF_CFDP_PduKeepAlive_t);
+    if (ka != NULL)
+    {
+        CF_Codec_Store_uint32(&(ka->progress), plka->progress);
+    }
+}
+
 /*----------------------------------------------------------------
  *
  * Application-scope internal function
@@ -910,6 +952,8 @@ void CF_CFDP_DecodeMd(CF_DecoderState_t *state, CF_Logical_PduMd_t *plmd)
         /* Add in LV for src/dest */
         CF_CFDP_DecodeLV(state, &plmd->source_filename);
         CF_CFDP_DecodeLV(state, &plmd->dest_filename);
+
+        CF_CFDP_DecodeAllTlv(state, &plmd->tlv_list, CF_PDU_MAX_TLV);
     }
 }
 
@@ -975,6 +1019,40 @@ void CF_CFDP_DecodeFileDataHeader(CF_DecoderState_t *state, bool with_meta, CF_L
     }
 }
 
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_codec.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_DecodePrompt(CF_DecoderState_t *state, CF_Logical_PduPrompt_t *plprompt)
+{
+    const CF_CFDP_PduPrompt_t *prompt; /* for decoding fixed sized fields */
+
+    prompt = CF_DECODE_FIXED_CHUNK(state, CF_CFDP_PduPrompt_t);
+    if (prompt != NULL)
+    {
+        plprompt->response_required = FGV(prompt->response_required, CF_CFDP_PduPrompt_RESPONSE_REQUIRED);
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_codec.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_CFDP_DecodeKeepAlive(CF_DecoderState_t *state, CF_Logical_PduKeepAlive_t *plka)
+{
+    const CF_CFDP_PduKeepAlive_t *ka; /* for decoding fixed sized fields */
+
+    ka = CF_DECODE_FIXED_CHUNK(state, CF_CFDP_PduKeepAlive_t);
+    if (ka != NULL)
+    {
+        CF_Codec_Load_uint32(&(plka->progress), &(ka->progress));
+    }
+}
+
 /*----------------------------------------------------------------
  *
  * Application-scope internal function
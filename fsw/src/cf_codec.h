@@ -584,6 +584,34 @@ void CF_CFDP_EncodeAck(CF_EncoderState_t *state, CF_Logical_PduAck_t *plack);
  */
 void CF_CFDP_EncodeNak(CF_EncoderState_t *state, CF_Logical_PduNak_t *plnak);
 
+/************************************************************************/
+/**
+ * @brief Encodes a CFDP Prompt header block
+ *
+ * The data in the logical header will be appended to the encoded PDU at the current position
+ *
+ * If the encoder is in an error state, nothing is encoded, and the state of the
+ * encoder is not changed.
+ *
+ * @param state     Encoder state object
+ * @param plprompt  Pointer to logical PDU Prompt header data
+ */
+void CF_CFDP_EncodePrompt(CF_EncoderState_t *state, CF_Logical_PduPrompt_t *plprompt);
+
+/************************************************************************/
+/**
+ * @brief Encodes a CFDP Keep Alive header block
+ *
+ * The data in the logical header will be appended to the encoded PDU at the current position
+ *
+ * If the encoder is in an error state, nothing is encoded, and the state of the
+ * encoder is not changed.
+ *
+ * @param state  Encoder state object
+ * @param plka   Pointer to logical PDU Keep Alive header data
+ */
+void CF_CFDP_EncodeKeepAlive(CF_EncoderState_t *state, CF_Logical_PduKeepAlive_t *plka);
+
 /************************************************************************/
 /**
  * @brief Encodes a CFDP CRC/Checksum
@@ -807,6 +835,36 @@ void CF_CFDP_DecodeAck(CF_DecoderState_t *state, CF_Logical_PduAck_t *plack);
  */
 void CF_CFDP_DecodeNak(CF_DecoderState_t *state, CF_Logical_PduNak_t *plnak);
 
+/************************************************************************/
+/**
+ * @brief Decodes a CFDP Prompt header block
+ *
+ * The data will be decoded from the encoded PDU at the current position and
+ * the logical fields will be saved to the given data structure
+ *
+ * If the encoder is in an error state, nothing is decoded, and the state of the
+ * decoder is not changed.
+ *
+ * @param state     Decoder state object
+ * @param plprompt  Pointer to logical PDU Prompt header data
+ */
+void CF_CFDP_DecodePrompt(CF_DecoderState_t *state, CF_Logical_PduPrompt_t *plprompt);
+
+/************************************************************************/
+/**
+ * @brief Decodes a CFDP Keep Alive header block
+ *
+ * The data will be decoded from the encoded PDU at the current position and
+ * the logical fields will be saved to the given data structure
+ *
+ * If the encoder is in an error state, nothing is decoded, and the state of the
+ * decoder is not changed.
+ *
+ * @param state  Decoder state object
+ * @param plka   Pointer to logical PDU Keep Alive header data
+ */
+void CF_CFDP_DecodeKeepAlive(CF_DecoderState_t *state, CF_Logical_PduKeepAlive_t *plka);
+
 /************************************************************************/
 /**
  * @brief Decodes a CFDP CRC/Checksum
@@ -0,0 +1,295 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ *  The CF Application file data compression source file
+ *
+ *  Blocks are coded in the LZ4 block format: each sequence is a token
+ *  holding the literal and match lengths, the literals, then a 16 bit
+ *  little endian match offset. The last sequence of a block has
+ *  literals only. Matches are found with a single entry hash table, so
+ *  the codec is quick and needs no memory beyond its work area, at the
+ *  cost of some ratio.
+ */
+
+#include "cfe.h"
+#include "cf_verify.h"
+#include "cf_compress.h"
+#include "cf_app.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/* the last match must start this far from the end of a block, and end at least 5 bytes from it */
+#define CF_COMPRESS_MATCH_LIMIT (12)
+#define CF_COMPRESS_LAST_LITERALS (5)
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static uint32 CF_Compress_Hash(const uint8 *ptr)
+{
+    uint32 seq = (uint32)ptr[0] | ((uint32)ptr[1] << 8) | ((uint32)ptr[2] << 16) | ((uint32)ptr[3] << 24);
+
+    return (seq * 2654435761U) >> (32 - CF_COMPRESS_HASH_BITS);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static uint8 *CF_Compress_PutLen(uint8 *op, uint32 len)
+{
+    while (len >= 255)
+    {
+        *op++ = 255;
+        len -= 255;
+    }
+    *op++ = len;
+
+    return op;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static uint8 *CF_Compress_PutSeq(uint8 *op, const uint8 *lit, uint32 lit_len, uint32 offset, uint32 match_len)
+{
+    uint8 *token = op++;
+
+    *token = (lit_len >= 15 ? 15 : lit_len) << 4;
+    if (lit_len >= 15)
+    {
+        op = CF_Compress_PutLen(op, lit_len - 15);
+    }
+    memcpy(op, lit, lit_len);
+    op += lit_len;
+
+    if (match_len)
+    {
+        *op++ = offset & 0xff;
+        *op++ = offset >> 8;
+
+        match_len -= CF_COMPRESS_MIN_MATCH;
+        *token |= (match_len >= 15 ? 15 : match_len);
+        if (match_len >= 15)
+        {
+            op = CF_Compress_PutLen(op, match_len - 15);
+        }
+    }
+
+    return op;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static bool CF_Compress_GetLen(const uint8 *packed, uint32 packed_len, uint32 *ip, uint32 *len)
+{
+    uint8 byte = 255;
+
+    while (byte == 255 && *ip < packed_len)
+    {
+        byte = packed[(*ip)++];
+        *len += byte;
+    }
+
+    return (byte != 255);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_compress.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+uint32 CF_Compress_Pack(CF_Compress_t *work, const uint8 *raw, uint32 raw_len, uint8 *out)
+{
+    uint8 *op     = out + CF_COMPRESS_BLOCK_HDR_SIZE;
+    uint32 pos    = 0;
+    uint32 anchor = 0;
+    uint32 limit  = 0;
+    uint32 packed_len;
+    uint32 cand;
+    uint32 len;
+    uint32 hash;
+
+    memset(work->hash, 0, sizeof(work->hash));
+
+    if (raw_len > CF_COMPRESS_MATCH_LIMIT)
+    {
+        limit = raw_len - CF_COMPRESS_MATCH_LIMIT;
+    }
+
+    while (pos < limit)
+    {
+        hash             = CF_Compress_Hash(&raw[pos]);
+        cand             = work->hash[hash];
+        work->hash[hash] = pos;
+
+        /* the table starts out zeroed, so a candidate is only a hint until compared */
+        if (cand < pos && memcmp(&raw[cand], &raw[pos], CF_COMPRESS_MIN_MATCH) == 0)
+        {
+            len = CF_COMPRESS_MIN_MATCH;
+            while ((pos + len) < (raw_len - CF_COMPRESS_LAST_LITERALS) && raw[cand + len] == raw[pos + len])
+            {
+                ++len;
+            }
+
+            op = CF_Compress_PutSeq(op, &raw[anchor], pos - anchor, pos - cand, len);
+            pos += len;
+            anchor = pos;
+        }
+        else
+        {
+            ++pos;
+        }
+    }
+
+    op         = CF_Compress_PutSeq(op, &raw[anchor], raw_len - anchor, 0, 0);
+    packed_len = op - (out + CF_COMPRESS_BLOCK_HDR_SIZE);
+
+    if (packed_len >= raw_len)
+    {
+        /* did not shrink, so it is stored */
+        memcpy(out + CF_COMPRESS_BLOCK_HDR_SIZE, raw, raw_len);
+        packed_len = raw_len;
+    }
+
+    out[0] = (packed_len >> 8) & 0xff;
+    out[1] = packed_len & 0xff;
+    out[2] = (raw_len >> 8) & 0xff;
+    out[3] = raw_len & 0xff;
+
+    return CF_COMPRESS_BLOCK_HDR_SIZE + packed_len;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_compress.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_Compress_ParseHeader(const uint8 *hdr, uint32 *packed_len, uint32 *raw_len)
+{
+    *packed_len = ((uint32)hdr[0] << 8) | hdr[1];
+    *raw_len    = ((uint32)hdr[2] << 8) | hdr[3];
+
+    return (*raw_len != 0 && *raw_len <= CF_COMPRESS_BLOCK_SIZE && *packed_len != 0 && *packed_len <= *raw_len);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_compress.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_Compress_Unpack(const uint8 *packed, uint32 packed_len, uint8 *raw, uint32 raw_len)
+{
+    uint32 ip      = 0;
+    uint32 op      = 0;
+    bool   success = true;
+    uint32 offset;
+    uint32 len;
+    uint8  token;
+
+    if (packed_len == raw_len)
+    {
+        memcpy(raw, packed, raw_len);
+        op = raw_len;
+    }
+    else
+    {
+        while (success && ip < packed_len)
+        {
+            token = packed[ip++];
+
+            len = token >> 4;
+            if (len == 15)
+            {
+                success = CF_Compress_GetLen(packed, packed_len, &ip, &len);
+            }
+            if (!success || len > (packed_len - ip) || len > (raw_len - op))
+            {
+                success = false;
+                break;
+            }
+            memcpy(&raw[op], &packed[ip], len);
+            ip += len;
+            op += len;
+
+            if (ip == packed_len)
+            {
+                /* the last sequence has no match */
+                break;
+            }
+
+            if ((packed_len - ip) < 2)
+            {
+                success = false;
+                break;
+            }
+            offset = packed[ip] | ((uint32)packed[ip + 1] << 8);
+            ip += 2;
+
+            len = token & 15;
+            if (len == 15)
+            {
+                success = CF_Compress_GetLen(packed, packed_len, &ip, &len);
+            }
+            len += CF_COMPRESS_MIN_MATCH;
+            if (!success || offset == 0 || offset > op || len > (raw_len - op))
+            {
+                success = false;
+                break;
+            }
+
+            /* byte by byte, as a match may overlap the data it produces */
+            while (len > 0)
+            {
+                raw[op] = raw[op - offset];
+                ++op;
+                --len;
+            }
+        }
+    }
+
+    return (success && op == raw_len);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_compress.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Compress_GetFilename(char *buf, size_t buf_size, CF_EntityId_t src_eid, CF_TransactionSeq_t seq_num)
+{
+    snprintf(buf, buf_size, "%.*s/%lu:%lu.cfz", CF_FILENAME_MAX_PATH - 1, CF_AppData.config_table->tmp_dir,
+             (unsigned long)src_eid, (unsigned long)seq_num);
+}
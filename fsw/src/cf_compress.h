@@ -0,0 +1,137 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ *  The CF Application file data compression header file
+ */
+
+#ifndef CF_COMPRESS_H
+#define CF_COMPRESS_H
+
+#include "cfe.h"
+#include "cf_platform_cfg.h"
+#include "cf_extern_typedefs.h"
+
+/**
+ * @brief Contents of the metadata Message To User TLV that marks compressed file data
+ */
+#define CF_COMPRESS_TLV_MSG "CFZ1"
+
+/**
+ * @brief Size of the header in front of each compressed block
+ *
+ * The header is the packed length then the raw length, both 16 bit big
+ * endian. A block whose packed length equals its raw length is stored
+ * as is.
+ */
+#define CF_COMPRESS_BLOCK_HDR_SIZE (4)
+
+/**
+ * @brief Largest packed length of a block of n raw bytes
+ */
+#define CF_COMPRESS_BOUND(n) ((n) + ((n) / 255) + 16)
+
+/**
+ * @brief Number of bits of the match finder hash
+ */
+#define CF_COMPRESS_HASH_BITS (12)
+
+/**
+ * @brief Shortest match the codec encodes
+ */
+#define CF_COMPRESS_MIN_MATCH (4)
+
+/**
+ * @brief Work area of the compression codec
+ */
+typedef struct CF_Compress
+{
+    uint16 hash[1 << CF_COMPRESS_HASH_BITS]; /**< \brief last block offset seen for each hash */
+    uint8  raw[CF_COMPRESS_BLOCK_SIZE];      /**< \brief one block of raw file data */
+    uint8  packed[CF_COMPRESS_BLOCK_HDR_SIZE + CF_COMPRESS_BOUND(CF_COMPRESS_BLOCK_SIZE)]; /**< \brief one block out */
+} CF_Compress_t;
+
+/************************************************************************/
+/** @brief Compress one block of file data.
+ *
+ * @par Description
+ *       Writes the block header followed by the block, in the LZ4 block
+ *       format. If that would not be smaller than the raw data, the raw
+ *       data is stored instead.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       work, raw, and out must not be NULL. raw_len must be between 1 and
+ *       CF_COMPRESS_BLOCK_SIZE, and out must have room for
+ *       CF_COMPRESS_BLOCK_HDR_SIZE + CF_COMPRESS_BOUND(raw_len) bytes.
+ *
+ * @param work     Codec work area
+ * @param raw      Raw data
+ * @param raw_len  Number of raw bytes
+ * @param out      Buffer for the header and the packed block
+ *
+ * @returns Number of bytes written to out, including the header
+ */
+uint32 CF_Compress_Pack(CF_Compress_t *work, const uint8 *raw, uint32 raw_len, uint8 *out);
+
+/************************************************************************/
+/** @brief Parse the header of a compressed block.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       hdr, packed_len, and raw_len must not be NULL.
+ *
+ * @param hdr         CF_COMPRESS_BLOCK_HDR_SIZE bytes of header
+ * @param packed_len  Output packed length of the block
+ * @param raw_len     Output raw length of the block
+ *
+ * @returns true if the header describes a block this codec could have written
+ */
+bool CF_Compress_ParseHeader(const uint8 *hdr, uint32 *packed_len, uint32 *raw_len);
+
+/************************************************************************/
+/** @brief Expand one compressed block.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       packed and raw must not be NULL. raw must have room for raw_len
+ *       bytes. A stored block is simply copied.
+ *
+ * @param packed      Packed block, without its header
+ * @param packed_len  Packed length from the block header
+ * @param raw         Buffer for the raw data
+ * @param raw_len     Raw length from the block header
+ *
+ * @returns true if the block expanded to exactly raw_len bytes
+ */
+bool CF_Compress_Unpack(const uint8 *packed, uint32 packed_len, uint8 *raw, uint32 raw_len);
+
+/************************************************************************/
+/** @brief Get the name of the temp file of a compression or expansion pass.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       buf must not be NULL.
+ *
+ * @param buf       Buffer for the file name
+ * @param buf_size  Size of buf
+ * @param src_eid   Source entity ID of the transaction
+ * @param seq_num   Sequence number of the transaction
+ */
+void CF_Compress_GetFilename(char *buf, size_t buf_size, CF_EntityId_t src_eid, CF_TransactionSeq_t seq_num);
+
+#endif /* !CF_COMPRESS_H */
@@ -0,0 +1,207 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ *  The CF Application delivered file index source file
+ *
+ *  The index is small and only changes when a class 2 send completes, so
+ *  it is kept whole in memory and the file is simply rewritten on each
+ *  change, under another name first so a restart part way through a
+ *  write leaves the previous index in place.
+ */
+
+#include "cfe.h"
+#include "cf_verify.h"
+#include "cf_delivered.h"
+#include "cf_app.h"
+#include "cf_events.h"
+#include "cf_utils.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static CFE_Status_t CF_Delivered_Write(void)
+{
+    CF_DeliveredFileHeader_t hdr;
+    char                     tmpname[OS_MAX_PATH_LEN];
+    osal_id_t                fd;
+    CFE_Status_t             ret;
+
+    hdr.magic       = CF_DELIVERED_FILE_MAGIC;
+    hdr.version     = CF_DELIVERED_FILE_VERSION;
+    hdr.num_entries = CF_DELIVERED_INDEX_ENTRIES;
+
+    snprintf(tmpname, sizeof(tmpname), "%s.tmp", CF_DELIVERED_INDEX_FILE);
+
+    ret = CF_WrappedOpenCreate(&fd, tmpname, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY);
+    if (ret >= 0)
+    {
+        if (CF_WrappedWrite(fd, &hdr, sizeof(hdr)) != (CFE_Status_t)sizeof(hdr) ||
+            CF_WrappedWrite(fd, CF_AppData.delivered.entries, sizeof(CF_AppData.delivered.entries)) !=
+                (CFE_Status_t)sizeof(CF_AppData.delivered.entries))
+        {
+            ret = CF_ERROR;
+        }
+        else
+        {
+            ret = CFE_SUCCESS;
+        }
+
+        CF_WrappedClose(fd);
+
+        if (ret == CFE_SUCCESS && CF_WrappedRename(tmpname, CF_DELIVERED_INDEX_FILE) != OS_SUCCESS)
+        {
+            ret = CF_ERROR;
+        }
+    }
+    else
+    {
+        ret = CF_ERROR;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_delivered.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Delivered_Load(void)
+{
+    CF_Delivered_t *         index = &CF_AppData.delivered;
+    CF_DeliveredFileHeader_t hdr;
+    osal_id_t                fd;
+    int32                    bytes;
+    bool                     success = false;
+    int                      i;
+
+    memset(index, 0, sizeof(*index));
+
+    if (CF_WrappedOpenCreate(&fd, CF_DELIVERED_INDEX_FILE, OS_FILE_FLAG_NONE, OS_READ_ONLY) >= 0)
+    {
+        if (CF_WrappedRead(fd, &hdr, sizeof(hdr)) == (CFE_Status_t)sizeof(hdr) &&
+            hdr.magic == CF_DELIVERED_FILE_MAGIC && hdr.version == CF_DELIVERED_FILE_VERSION)
+        {
+            /* an index written with a different number of entries keeps as many as fit */
+            if (hdr.num_entries > CF_DELIVERED_INDEX_ENTRIES)
+            {
+                hdr.num_entries = CF_DELIVERED_INDEX_ENTRIES;
+            }
+
+            bytes   = hdr.num_entries * sizeof(CF_DeliveredEntry_t);
+            success = (CF_WrappedRead(fd, index->entries, bytes) == bytes);
+        }
+
+        CF_WrappedClose(fd);
+    }
+
+    if (success)
+    {
+        for (i = 0; i < CF_DELIVERED_INDEX_ENTRIES; ++i)
+        {
+            index->entries[i].dst_filename[CF_FILENAME_MAX_LEN - 1] = 0;
+            if (index->entries[i].last_use > index->use_count)
+            {
+                index->use_count = index->entries[i].last_use;
+            }
+        }
+    }
+    else
+    {
+        memset(index, 0, sizeof(*index));
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_delivered.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+const CF_DeliveredEntry_t *CF_Delivered_Find(CF_EntityId_t peer_eid, const char *dst_filename, uint32 fsize)
+{
+    CF_Delivered_t *     index = &CF_AppData.delivered;
+    CF_DeliveredEntry_t *entry = NULL;
+    int                  i;
+
+    for (i = 0; i < CF_DELIVERED_INDEX_ENTRIES; ++i)
+    {
+        if (index->entries[i].last_use && index->entries[i].peer_eid == peer_eid &&
+            index->entries[i].fsize == fsize &&
+            strncmp(index->entries[i].dst_filename, dst_filename, CF_FILENAME_MAX_LEN) == 0)
+        {
+            entry           = &index->entries[i];
+            entry->last_use = ++index->use_count;
+            break;
+        }
+    }
+
+    return entry;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_delivered.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Delivered_Add(CF_EntityId_t peer_eid, const char *dst_filename, uint32 fsize, uint32 crc)
+{
+    CF_Delivered_t *     index = &CF_AppData.delivered;
+    CF_DeliveredEntry_t *entry = &index->entries[0];
+    int                  i;
+
+    /* the same destination again, or else an unused entry, or else the least recently used one */
+    for (i = 0; i < CF_DELIVERED_INDEX_ENTRIES; ++i)
+    {
+        if (index->entries[i].last_use && index->entries[i].peer_eid == peer_eid &&
+            strncmp(index->entries[i].dst_filename, dst_filename, CF_FILENAME_MAX_LEN) == 0)
+        {
+            entry = &index->entries[i];
+            break;
+        }
+
+        if (index->entries[i].last_use < entry->last_use)
+        {
+            entry = &index->entries[i];
+        }
+    }
+
+    memset(entry, 0, sizeof(*entry));
+    entry->peer_eid = peer_eid;
+    entry->fsize    = fsize;
+    entry->crc      = crc;
+    entry->last_use = ++index->use_count;
+    strncpy(entry->dst_filename, dst_filename, CF_FILENAME_MAX_LEN - 1);
+
+    if (CF_Delivered_Write() != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(CF_DELIVERED_WRITE_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "CF: failed to write delivered file index %s", CF_DELIVERED_INDEX_FILE);
+    }
+}
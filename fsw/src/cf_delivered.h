@@ -0,0 +1,129 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ *  The CF Application delivered file index header file
+ *
+ *  A small persisted index of the files that class 2 sends have delivered,
+ *  so that a later send of the same file to the same place, e.g. from a
+ *  polling directory after a restart, can be completed without sending it.
+ */
+
+#ifndef CF_DELIVERED_H
+#define CF_DELIVERED_H
+
+#include "cfe.h"
+#include "cf_platform_cfg.h"
+#include "cf_extern_typedefs.h"
+
+/**
+ * @brief Magic number at the start of the index file, "CFDI"
+ */
+#define CF_DELIVERED_FILE_MAGIC (0x43464449)
+
+/**
+ * @brief Version of the index file layout
+ */
+#define CF_DELIVERED_FILE_VERSION (1)
+
+/**
+ * @brief One delivered file
+ */
+typedef struct CF_DeliveredEntry
+{
+    CF_EntityId_t peer_eid;                          /**< \brief Entity the file was delivered to */
+    uint32        fsize;                             /**< \brief File size */
+    uint32        crc;                               /**< \brief File checksum */
+    uint32        last_use;                          /**< \brief Use counter when last added or matched, 0 if unused */
+    char          dst_filename[CF_FILENAME_MAX_LEN]; /**< \brief Destination file name */
+} CF_DeliveredEntry_t;
+
+/**
+ * @brief Header of the index file, followed by num_entries CF_DeliveredEntry_t
+ */
+typedef struct CF_DeliveredFileHeader
+{
+    uint32 magic;       /**< \brief #CF_DELIVERED_FILE_MAGIC */
+    uint16 version;     /**< \brief #CF_DELIVERED_FILE_VERSION */
+    uint16 num_entries; /**< \brief Entries that follow */
+} CF_DeliveredFileHeader_t;
+
+/**
+ * @brief Index of delivered files
+ */
+typedef struct CF_Delivered
+{
+    uint32              use_count; /**< \brief Counts adds and matches, used to pick the entry to replace */
+    CF_DeliveredEntry_t entries[CF_DELIVERED_INDEX_ENTRIES];
+} CF_Delivered_t;
+
+/************************************************************************/
+/** @brief Read the index of delivered files.
+ *
+ * @par Description
+ *       Replaces the index in memory with the contents of
+ *       CF_DELIVERED_INDEX_FILE. The index starts empty if the file does
+ *       not exist or cannot be read.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       Called when the engine is initialized.
+ */
+void CF_Delivered_Load(void);
+
+/************************************************************************/
+/** @brief Look for an earlier delivery of a file.
+ *
+ * @par Description
+ *       The checksum is not part of the lookup, since working it out means
+ *       reading the whole file. The caller compares it once it has.
+ *       A match counts as a use of the entry.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       dst_filename must not be NULL.
+ *
+ * @param peer_eid      Entity the file is being sent to
+ * @param dst_filename  Destination file name
+ * @param fsize         File size
+ *
+ * @returns Pointer to the matching entry
+ * @retval NULL if the file has not been delivered there with that size
+ */
+const CF_DeliveredEntry_t *CF_Delivered_Find(CF_EntityId_t peer_eid, const char *dst_filename, uint32 fsize);
+
+/************************************************************************/
+/** @brief Record a delivered file.
+ *
+ * @par Description
+ *       Replaces any entry for the same entity and destination file name,
+ *       or else takes an unused entry or the least recently used one.
+ *       The index file is then rewritten.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       dst_filename must not be NULL.
+ *
+ * @param peer_eid      Entity the file was delivered to
+ * @param dst_filename  Destination file name
+ * @param fsize         File size
+ * @param crc           File checksum
+ */
+void CF_Delivered_Add(CF_EntityId_t peer_eid, const char *dst_filename, uint32 fsize, uint32 crc);
+
+#endif /* !CF_DELIVERED_H */
@@ -0,0 +1,604 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ *  The CF Application delta transfer source file
+ *
+ *  This is the rsync algorithm with the roles of the two ends swapped
+ *  around: the signatures of the old file are those the sender saved
+ *  when it last delivered that file, so nothing has to come back from
+ *  the receiver before the delta is made. The new file is scanned with
+ *  a block sized window, and each position whose weak checksum is found
+ *  among the old blocks, and whose strong hash then agrees, becomes a
+ *  copy of that block. Everything else is sent as data.
+ */
+
+#include "cfe.h"
+#include "cf_verify.h"
+#include "cf_delta.h"
+#include "cf_app.h"
+#include "cf_utils.h"
+#include "cf_crc.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static uint8 *CF_Delta_Put32(uint8 *op, uint32 val)
+{
+    *op++ = (val >> 24) & 0xff;
+    *op++ = (val >> 16) & 0xff;
+    *op++ = (val >> 8) & 0xff;
+    *op++ = val & 0xff;
+
+    return op;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static uint32 CF_Delta_Get32(const uint8 *ip)
+{
+    return ((uint32)ip[0] << 24) | ((uint32)ip[1] << 16) | ((uint32)ip[2] << 8) | ip[3];
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static uint32 CF_Delta_Bucket(uint32 weak)
+{
+    return (weak * 2654435761U) >> (32 - CF_DELTA_HASH_BITS);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static bool CF_Delta_Match(const CF_Delta_t *delta, uint32 k, const uint8 *block, uint64 *strong, bool *have_strong)
+{
+    if (delta->base[k].weak != delta->weak)
+    {
+        return false;
+    }
+
+    if (!*have_strong)
+    {
+        *strong      = CF_Delta_Strong(block, CF_DELTA_BLOCK_SIZE);
+        *have_strong = true;
+    }
+
+    return (delta->base[k].strong == *strong);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static int32 CF_Delta_Find(const CF_Delta_t *delta, const uint8 *block)
+{
+    uint64 strong      = 0;
+    bool   have_strong = false;
+    uint32 k;
+    int32  ret = -1;
+
+    /* carrying on from the last match keeps a run of blocks in one copy */
+    k = delta->copy_first + delta->copy_count;
+    if (delta->copy_count && k < delta->num_base && CF_Delta_Match(delta, k, block, &strong, &have_strong))
+    {
+        ret = k;
+    }
+    else
+    {
+        k = delta->bucket[CF_Delta_Bucket(delta->weak)];
+        while (k != 0)
+        {
+            if (CF_Delta_Match(delta, k - 1, block, &strong, &have_strong))
+            {
+                ret = k - 1;
+                break;
+            }
+            k = delta->chain[k - 1];
+        }
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Delta_FlushCopy(CF_Delta_t *delta)
+{
+    uint8 *op = &delta->out[delta->out_len];
+
+    if (delta->copy_count)
+    {
+        *op++ = CF_DELTA_OP_COPY;
+        op    = CF_Delta_Put32(op, delta->copy_first);
+        op    = CF_Delta_Put32(op, delta->copy_count);
+
+        delta->out_len += CF_DELTA_COPY_SIZE;
+        delta->copy_count = 0;
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_Delta_FlushData(CF_Delta_t *delta)
+{
+    uint32 len = delta->win - delta->lit;
+    uint8 *op;
+
+    if (len)
+    {
+        /* the copy came first in the file, so it goes first */
+        CF_Delta_FlushCopy(delta);
+
+        op    = &delta->out[delta->out_len];
+        *op++ = CF_DELTA_OP_DATA;
+        *op++ = (len >> 8) & 0xff;
+        *op++ = len & 0xff;
+        memcpy(op, &delta->buf[delta->lit - delta->buf_offs], len);
+
+        delta->out_len += CF_DELTA_DATA_HDR_SIZE + len;
+        delta->lit = delta->win;
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_delta.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+uint32 CF_Delta_Weak(const uint8 *data, uint32 len)
+{
+    uint32 a = 0;
+    uint32 b = 0;
+    uint32 i;
+
+    for (i = 0; i < len; ++i)
+    {
+        a += data[i];
+        b += a;
+    }
+
+    return (a & 0xffff) | ((b & 0xffff) << 16);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_delta.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+uint32 CF_Delta_Roll(uint32 weak, uint8 out_byte, uint8 in_byte, uint32 len)
+{
+    uint32 a = weak & 0xffff;
+    uint32 b = weak >> 16;
+
+    a = (a - out_byte + in_byte) & 0xffff;
+    b = (b - (len * out_byte) + a) & 0xffff;
+
+    return a | (b << 16);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_delta.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+uint64 CF_Delta_Strong(const uint8 *data, uint32 len)
+{
+    uint64 hash = 14695981039346656037ULL;
+    uint32 i;
+
+    for (i = 0; i < len; ++i)
+    {
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_delta.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Delta_Start(CF_Delta_t *delta, struct CF_Transaction *owner)
+{
+    delta->owner      = owner;
+    delta->base_size  = 0;
+    delta->num_base   = 0;
+    delta->num_next   = 0;
+    delta->buf_offs   = 0;
+    delta->buf_len    = 0;
+    delta->win        = 0;
+    delta->lit        = 0;
+    delta->sig_offs   = 0;
+    delta->weak       = 0;
+    delta->rolling    = false;
+    delta->copy_first = 0;
+    delta->copy_count = 0;
+    delta->out_len    = 0;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_delta.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_Delta_LoadSigs(CF_Delta_t *delta, const char *fname)
+{
+    CF_DeltaSigHeader_t hdr;
+    osal_id_t           fd;
+    int32               bytes;
+    uint32              hash;
+    uint32              k;
+    bool                success = false;
+
+    delta->num_base  = 0;
+    delta->base_size = 0;
+
+    if (CF_WrappedOpenCreate(&fd, fname, OS_FILE_FLAG_NONE, OS_READ_ONLY) >= 0)
+    {
+        /* signatures made with another block size are no use */
+        if (CF_WrappedRead(fd, &hdr, sizeof(hdr)) == (CFE_Status_t)sizeof(hdr) && hdr.magic == CF_DELTA_SIG_MAGIC &&
+            hdr.version == CF_DELTA_SIG_VERSION && hdr.block_size == CF_DELTA_BLOCK_SIZE &&
+            hdr.num_blocks <= CF_DELTA_MAX_BLOCKS && hdr.num_blocks <= (hdr.fsize / CF_DELTA_BLOCK_SIZE))
+        {
+            bytes   = hdr.num_blocks * sizeof(CF_DeltaSig_t);
+            success = (CF_WrappedRead(fd, delta->base, bytes) == bytes);
+        }
+
+        CF_WrappedClose(fd);
+    }
+
+    if (success)
+    {
+        delta->num_base  = hdr.num_blocks;
+        delta->base_size = hdr.fsize;
+
+        /* built from the end, so the lowest of equal blocks is found first */
+        memset(delta->bucket, 0, sizeof(delta->bucket));
+        for (k = delta->num_base; k > 0; --k)
+        {
+            hash                = CF_Delta_Bucket(delta->base[k - 1].weak);
+            delta->chain[k - 1] = delta->bucket[hash];
+            delta->bucket[hash] = k;
+        }
+    }
+
+    return (delta->num_base != 0);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_delta.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_Delta_SaveSigs(const CF_Delta_t *delta, const char *fname, uint32 fsize)
+{
+    CF_DeltaSigHeader_t hdr;
+    osal_id_t           fd;
+    int32               bytes;
+    CFE_Status_t        ret = CF_ERROR;
+
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic      = CF_DELTA_SIG_MAGIC;
+    hdr.version    = CF_DELTA_SIG_VERSION;
+    hdr.block_size = CF_DELTA_BLOCK_SIZE;
+    hdr.fsize      = fsize;
+    hdr.num_blocks = delta->num_next;
+
+    if (CF_WrappedOpenCreate(&fd, fname, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY) >= 0)
+    {
+        bytes = delta->num_next * sizeof(CF_DeltaSig_t);
+        if (CF_WrappedWrite(fd, &hdr, sizeof(hdr)) == (CFE_Status_t)sizeof(hdr) &&
+            CF_WrappedWrite(fd, delta->next, bytes) == bytes)
+        {
+            ret = CFE_SUCCESS;
+        }
+
+        CF_WrappedClose(fd);
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_delta.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+uint32 CF_Delta_Shift(CF_Delta_t *delta)
+{
+    uint32 keep = delta->lit;
+    uint32 drop;
+
+    /* data not yet put out, or not yet signed, has to stay */
+    if (delta->sig_offs < keep)
+    {
+        keep = delta->sig_offs;
+    }
+
+    drop = keep - delta->buf_offs;
+    if (drop)
+    {
+        memmove(delta->buf, &delta->buf[drop], delta->buf_len - drop);
+        delta->buf_len -= drop;
+        delta->buf_offs = keep;
+    }
+
+    return sizeof(delta->buf) - delta->buf_len;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_delta.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Delta_AddSigs(CF_Delta_t *delta)
+{
+    const uint8 *block;
+
+    while ((delta->buf_offs + delta->buf_len - delta->sig_offs) >= CF_DELTA_BLOCK_SIZE)
+    {
+        /* the caller only signs files that fit, this just keeps the table from overflowing */
+        if (delta->num_next < CF_DELTA_MAX_BLOCKS)
+        {
+            block                               = &delta->buf[delta->sig_offs - delta->buf_offs];
+            delta->next[delta->num_next].weak   = CF_Delta_Weak(block, CF_DELTA_BLOCK_SIZE);
+            delta->next[delta->num_next].spare  = 0;
+            delta->next[delta->num_next].strong = CF_Delta_Strong(block, CF_DELTA_BLOCK_SIZE);
+            ++delta->num_next;
+        }
+
+        delta->sig_offs += CF_DELTA_BLOCK_SIZE;
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_delta.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_Delta_Encode(CF_Delta_t *delta, uint32 fsize)
+{
+    uint32       end  = delta->buf_offs + delta->buf_len;
+    bool         done = false;
+    const uint8 *block;
+    int32        k;
+
+    if (delta->num_base == 0)
+    {
+        /* nothing to match against, so only the signatures are wanted */
+        delta->win = end;
+        delta->lit = end;
+        done       = (end == fsize);
+    }
+
+    while (!done && delta->out_len <= (sizeof(delta->out) - CF_DELTA_STEP_MAX))
+    {
+        if ((delta->win - delta->lit) == CF_DELTA_BLOCK_SIZE)
+        {
+            CF_Delta_FlushData(delta);
+        }
+
+        if ((fsize - delta->win) >= CF_DELTA_BLOCK_SIZE)
+        {
+            if ((end - delta->win) < CF_DELTA_BLOCK_SIZE)
+            {
+                break; /* the whole block is needed */
+            }
+
+            block = &delta->buf[delta->win - delta->buf_offs];
+            if (!delta->rolling)
+            {
+                delta->weak    = CF_Delta_Weak(block, CF_DELTA_BLOCK_SIZE);
+                delta->rolling = true;
+            }
+
+            k = CF_Delta_Find(delta, block);
+            if (k >= 0)
+            {
+                CF_Delta_FlushData(delta);
+                if (delta->copy_count && (delta->copy_first + delta->copy_count) == (uint32)k &&
+                    delta->copy_count < CF_DELTA_COPY_MAX_BLOCKS)
+                {
+                    ++delta->copy_count;
+                }
+                else
+                {
+                    CF_Delta_FlushCopy(delta);
+                    delta->copy_first = k;
+                    delta->copy_count = 1;
+                }
+
+                delta->win += CF_DELTA_BLOCK_SIZE;
+                delta->lit     = delta->win;
+                delta->rolling = false;
+            }
+            else if ((fsize - delta->win) > CF_DELTA_BLOCK_SIZE)
+            {
+                if ((end - delta->win) == CF_DELTA_BLOCK_SIZE)
+                {
+                    break; /* the byte after the block is needed */
+                }
+
+                delta->weak = CF_Delta_Roll(delta->weak, block[0], block[CF_DELTA_BLOCK_SIZE], CF_DELTA_BLOCK_SIZE);
+                ++delta->win;
+            }
+            else
+            {
+                /* the last whole block did not match either */
+                delta->rolling = false;
+                ++delta->win;
+            }
+        }
+        else if (delta->win < fsize)
+        {
+            if (end < fsize)
+            {
+                break; /* the rest of the file is needed */
+            }
+
+            /* too short to match, so it is all data */
+            delta->win = delta->lit + CF_DELTA_BLOCK_SIZE;
+            if (delta->win > fsize)
+            {
+                delta->win = fsize;
+            }
+        }
+        else
+        {
+            CF_Delta_FlushData(delta);
+            CF_Delta_FlushCopy(delta);
+            done = true;
+        }
+    }
+
+    return done;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_delta.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Delta_PutHeader(uint8 *out, const CF_DeltaHeader_t *hdr)
+{
+    out = CF_Delta_Put32(out, hdr->raw_size);
+    out = CF_Delta_Put32(out, hdr->raw_crc);
+    out = CF_Delta_Put32(out, hdr->base_size);
+    CF_Delta_Put32(out, hdr->block_size);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_delta.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_Delta_ParseHeader(const uint8 *in, CF_DeltaHeader_t *hdr)
+{
+    hdr->raw_size   = CF_Delta_Get32(&in[0]);
+    hdr->raw_crc    = CF_Delta_Get32(&in[4]);
+    hdr->base_size  = CF_Delta_Get32(&in[8]);
+    hdr->block_size = CF_Delta_Get32(&in[12]);
+
+    return (hdr->block_size >= 64 && hdr->block_size <= 32768);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_delta.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+uint32 CF_Delta_ParseOp(const uint8 *in, uint32 in_len, uint32 *arg, uint32 *count)
+{
+    uint32 ret = 0;
+
+    *arg   = 0;
+    *count = 0;
+
+    if (in_len >= CF_DELTA_COPY_SIZE && in[0] == CF_DELTA_OP_COPY)
+    {
+        *arg   = CF_Delta_Get32(&in[1]);
+        *count = CF_Delta_Get32(&in[5]);
+        if (*count != 0 && *count <= CF_DELTA_COPY_MAX_BLOCKS)
+        {
+            ret = CF_DELTA_COPY_SIZE;
+        }
+    }
+    else if (in_len >= CF_DELTA_DATA_HDR_SIZE && in[0] == CF_DELTA_OP_DATA)
+    {
+        *arg = ((uint32)in[1] << 8) | in[2];
+        if (*arg != 0)
+        {
+            ret = CF_DELTA_DATA_HDR_SIZE;
+        }
+    }
+    else
+    {
+        /* unknown, or cut short */
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_delta.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Delta_GetSigFilename(char *buf, size_t buf_size, CF_EntityId_t peer_eid, const char *dst_filename)
+{
+    CF_Crc_t crc;
+
+    memset(&crc, 0, sizeof(crc));
+    CF_CRC_Start(&crc);
+    CF_CRC_Digest(&crc, (const uint8 *)dst_filename, strlen(dst_filename));
+    CF_CRC_Finalize(&crc);
+
+    snprintf(buf, buf_size, "%s/d%lu_%08lx.sig", CF_DELTA_SIG_DIR, (unsigned long)peer_eid,
+             (unsigned long)crc.result);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_delta.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Delta_GetFilename(char *buf, size_t buf_size, CF_EntityId_t src_eid, CF_TransactionSeq_t seq_num,
+                          const char *ext)
+{
+    snprintf(buf, buf_size, "%.*s/%lu:%lu%s", CF_FILENAME_MAX_PATH - 1, CF_AppData.config_table->tmp_dir,
+             (unsigned long)src_eid, (unsigned long)seq_num, ext);
+}
@@ -0,0 +1,384 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ *  The CF Application delta transfer header file
+ */
+
+#ifndef CF_DELTA_H
+#define CF_DELTA_H
+
+#include "cfe.h"
+#include "cf_platform_cfg.h"
+#include "cf_extern_typedefs.h"
+
+/**
+ * @brief Contents of the metadata Message To User TLV that marks file data sent as a delta
+ */
+#define CF_DELTA_TLV_MSG "CFD1"
+
+/**
+ * @brief Size of the header at the start of a delta
+ *
+ * The header is the size and checksum of the new file, the size of the
+ * file the delta was made against, and the block size, all 32 bit big
+ * endian.
+ */
+#define CF_DELTA_HDR_SIZE (16)
+
+/**
+ * @brief Delta instruction that copies whole blocks of the old file
+ *
+ * Followed by the first block and the number of blocks, both 32 bit big endian.
+ */
+#define CF_DELTA_OP_COPY (1)
+
+/**
+ * @brief Delta instruction that carries new data
+ *
+ * Followed by the number of bytes, 16 bit big endian, then the bytes.
+ */
+#define CF_DELTA_OP_DATA (2)
+
+/**
+ * @brief Size of a copy instruction
+ */
+#define CF_DELTA_COPY_SIZE (9)
+
+/**
+ * @brief Size of a data instruction, not counting its data
+ */
+#define CF_DELTA_DATA_HDR_SIZE (3)
+
+/**
+ * @brief Most blocks one copy instruction covers, so the receiver's work per instruction is bounded
+ */
+#define CF_DELTA_COPY_MAX_BLOCKS (16)
+
+/**
+ * @brief Number of bits of the weak signature lookup table
+ */
+#define CF_DELTA_HASH_BITS (12)
+
+/**
+ * @brief Most output one encoding step can produce
+ */
+#define CF_DELTA_STEP_MAX ((2 * CF_DELTA_COPY_SIZE) + CF_DELTA_DATA_HDR_SIZE + CF_DELTA_BLOCK_SIZE)
+
+/**
+ * @brief Magic number at the start of a signature file, "CFDS"
+ */
+#define CF_DELTA_SIG_MAGIC (0x43464453)
+
+/**
+ * @brief Version of the signature file layout
+ */
+#define CF_DELTA_SIG_VERSION (1)
+
+/**
+ * @brief Extension of the temp file a delta is written to or applied into
+ */
+#define CF_DELTA_TEMP_EXT ".cfd"
+
+/**
+ * @brief Extension of the temp file the old file is kept in while a delta is received
+ */
+#define CF_DELTA_BASE_EXT ".base"
+
+/**
+ * @brief Extension of the temp file the signatures of a file being sent are kept in
+ */
+#define CF_DELTA_SIG_EXT ".sig"
+
+struct CF_Transaction;
+
+/**
+ * @brief Signature of one block
+ */
+typedef struct CF_DeltaSig
+{
+    uint32 weak;   /**< \brief rolling checksum, to find candidate matches cheaply */
+    uint32 spare;  /**< \brief keeps the layout the same on every target */
+    uint64 strong; /**< \brief 64 bit FNV-1a hash, to confirm a candidate */
+} CF_DeltaSig_t;
+
+/**
+ * @brief Header of a signature file, followed by num_blocks CF_DeltaSig_t
+ */
+typedef struct CF_DeltaSigHeader
+{
+    uint32 magic;      /**< \brief #CF_DELTA_SIG_MAGIC */
+    uint16 version;    /**< \brief #CF_DELTA_SIG_VERSION */
+    uint16 spare;      /**< \brief keeps the layout the same on every target */
+    uint32 block_size; /**< \brief block size the signatures were made with */
+    uint32 fsize;      /**< \brief size of the file */
+    uint32 num_blocks; /**< \brief number of whole blocks in the file */
+} CF_DeltaSigHeader_t;
+
+/**
+ * @brief Header at the start of a delta
+ */
+typedef struct CF_DeltaHeader
+{
+    uint32 raw_size;   /**< \brief size of the new file */
+    uint32 raw_crc;    /**< \brief CFDP checksum of the new file */
+    uint32 base_size;  /**< \brief size of the old file the delta was made against */
+    uint32 block_size; /**< \brief block size of the copy instructions */
+} CF_DeltaHeader_t;
+
+/**
+ * @brief Work area of the delta codec
+ *
+ * The encoder keeps its place in the file here from one wakeup to the
+ * next, so it is held by one send at a time.
+ */
+typedef struct CF_Delta
+{
+    struct CF_Transaction *owner; /**< \brief the send whose delta is being made, NULL if free */
+
+    uint32        base_size;                        /**< \brief size of the old file */
+    uint32        num_base;                         /**< \brief number of signatures of the old file */
+    CF_DeltaSig_t base[CF_DELTA_MAX_BLOCKS];        /**< \brief signatures of the old file */
+    uint16        bucket[1 << CF_DELTA_HASH_BITS];  /**< \brief first old block with each weak hash, plus 1 */
+    uint16        chain[CF_DELTA_MAX_BLOCKS];       /**< \brief next old block with the same weak hash, plus 1 */
+
+    uint32        num_next;                  /**< \brief number of signatures of the new file */
+    CF_DeltaSig_t next[CF_DELTA_MAX_BLOCKS]; /**< \brief signatures of the new file, for the next delta */
+
+    uint32 buf_offs;   /**< \brief file offset of buf[0] */
+    uint32 buf_len;    /**< \brief number of bytes in buf */
+    uint32 win;        /**< \brief file offset of the block being matched */
+    uint32 lit;        /**< \brief file offset of the first new data not yet put out */
+    uint32 sig_offs;   /**< \brief file offset of the next block of the new file to sign */
+    uint32 weak;       /**< \brief rolling checksum of the block at win */
+    bool   rolling;    /**< \brief weak is valid */
+    uint32 copy_first; /**< \brief first old block of the copy not yet put out */
+    uint32 copy_count; /**< \brief number of blocks of the copy not yet put out */
+
+    uint8  buf[2 * CF_DELTA_BLOCK_SIZE];  /**< \brief file data around the block being matched */
+    uint32 out_len;                       /**< \brief number of bytes in out */
+    uint8  out[2 * CF_DELTA_STEP_MAX];    /**< \brief instructions waiting to be written */
+    uint8  copy[CF_DELTA_BLOCK_SIZE];     /**< \brief used by the receiver to apply a delta */
+} CF_Delta_t;
+
+/************************************************************************/
+/** @brief Compute the weak rolling checksum of a block.
+ *
+ * @par Description
+ *       The checksum of rsync: the sum of the bytes, and the sum of the
+ *       running sums, each 16 bits.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       data must not be NULL.
+ *
+ * @param data  Block data
+ * @param len   Number of bytes
+ *
+ * @returns The checksum
+ */
+uint32 CF_Delta_Weak(const uint8 *data, uint32 len);
+
+/************************************************************************/
+/** @brief Move the weak checksum of a block on by one byte.
+ *
+ * @param weak  Checksum of the block starting with out_byte
+ * @param out_byte  First byte of the block
+ * @param in_byte   Byte just past the end of the block
+ * @param len   Block length
+ *
+ * @returns Checksum of the block one byte further on
+ */
+uint32 CF_Delta_Roll(uint32 weak, uint8 out_byte, uint8 in_byte, uint32 len);
+
+/************************************************************************/
+/** @brief Compute the strong hash of a block.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       data must not be NULL.
+ *
+ * @param data  Block data
+ * @param len   Number of bytes
+ *
+ * @returns 64 bit FNV-1a hash of the block
+ */
+uint64 CF_Delta_Strong(const uint8 *data, uint32 len);
+
+/************************************************************************/
+/** @brief Start making a delta.
+ *
+ * @par Description
+ *       Clears the work area and marks it as held by the given send.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       delta must not be NULL.
+ *
+ * @param delta  Codec work area
+ * @param owner  Transaction the delta is for
+ */
+void CF_Delta_Start(CF_Delta_t *delta, struct CF_Transaction *owner);
+
+/************************************************************************/
+/** @brief Read the signatures of the old file.
+ *
+ * @par Description
+ *       Reads the signature file, and indexes the signatures by weak
+ *       checksum. A missing or unusable file leaves no signatures.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       delta and fname must not be NULL.
+ *
+ * @param delta  Codec work area
+ * @param fname  Signature file name
+ *
+ * @returns true if there is at least one block to match against
+ */
+bool CF_Delta_LoadSigs(CF_Delta_t *delta, const char *fname);
+
+/************************************************************************/
+/** @brief Write the signatures of the new file.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       delta and fname must not be NULL. Only complete once the whole
+ *       new file has been through CF_Delta_AddSigs().
+ *
+ * @param delta  Codec work area
+ * @param fname  Signature file name
+ * @param fsize  Size of the new file
+ *
+ * @retval #CFE_SUCCESS \copydoc CFE_SUCCESS
+ * @retval #CF_ERROR if the file could not be written
+ */
+CFE_Status_t CF_Delta_SaveSigs(const CF_Delta_t *delta, const char *fname, uint32 fsize);
+
+/************************************************************************/
+/** @brief Drop the data the encoder is done with.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       delta must not be NULL.
+ *
+ * @param delta  Codec work area
+ *
+ * @returns Room left at the end of the buffer, always at least 1 while the file is not all read
+ */
+uint32 CF_Delta_Shift(CF_Delta_t *delta);
+
+/************************************************************************/
+/** @brief Sign each whole block of the new file that has been read.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       delta must not be NULL. Called each time data is added to the buffer.
+ *       Blocks past CF_DELTA_MAX_BLOCKS are not signed.
+ *
+ * @param delta  Codec work area
+ */
+void CF_Delta_AddSigs(CF_Delta_t *delta);
+
+/************************************************************************/
+/** @brief Encode as much of the new file as has been read.
+ *
+ * @par Description
+ *       Moves a block sized window through the data a byte at a time,
+ *       looking each position up in the signatures of the old file. A
+ *       match becomes a copy instruction, and the bytes passed over
+ *       become data instructions. Stops when more data is needed, or the
+ *       output buffer is nearly full.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       delta must not be NULL. The caller writes out and clears
+ *       delta->out after each call.
+ *
+ * @param delta  Codec work area
+ * @param fsize  Size of the new file
+ *
+ * @returns true once the whole file is encoded
+ */
+bool CF_Delta_Encode(CF_Delta_t *delta, uint32 fsize);
+
+/************************************************************************/
+/** @brief Encode the header of a delta.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       out and hdr must not be NULL. out must have room for
+ *       CF_DELTA_HDR_SIZE bytes.
+ *
+ * @param out  Buffer for the header
+ * @param hdr  Header values
+ */
+void CF_Delta_PutHeader(uint8 *out, const CF_DeltaHeader_t *hdr);
+
+/************************************************************************/
+/** @brief Decode the header of a delta.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       in and hdr must not be NULL.
+ *
+ * @param in   CF_DELTA_HDR_SIZE bytes of header
+ * @param hdr  Output header values
+ *
+ * @returns true if the header describes a delta this codec could have made
+ */
+bool CF_Delta_ParseHeader(const uint8 *in, CF_DeltaHeader_t *hdr);
+
+/************************************************************************/
+/** @brief Decode one delta instruction.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       in, arg, and count must not be NULL. For a data instruction, arg
+ *       is the number of bytes that follow and count is 0.
+ *
+ * @param in      Instruction bytes
+ * @param in_len  Number of bytes available at in
+ * @param arg     Output first block of a copy, or length of data
+ * @param count   Output number of blocks of a copy
+ *
+ * @returns Size of the instruction not counting any data, 0 if it is malformed or cut short
+ */
+uint32 CF_Delta_ParseOp(const uint8 *in, uint32 in_len, uint32 *arg, uint32 *count);
+
+/************************************************************************/
+/** @brief Get the name of the signature file for a destination.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       buf and dst_filename must not be NULL.
+ *
+ * @param buf           Buffer for the file name
+ * @param buf_size      Size of buf
+ * @param peer_eid      Entity the file is sent to
+ * @param dst_filename  Destination file name
+ */
+void CF_Delta_GetSigFilename(char *buf, size_t buf_size, CF_EntityId_t peer_eid, const char *dst_filename);
+
+/************************************************************************/
+/** @brief Get the name of a temp file of a delta transaction.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       buf and ext must not be NULL.
+ *
+ * @param buf       Buffer for the file name
+ * @param buf_size  Size of buf
+ * @param src_eid   Source entity ID of the transaction
+ * @param seq_num   Sequence number of the transaction
+ * @param ext       One of the CF_DELTA_*_EXT extensions
+ */
+void CF_Delta_GetFilename(char *buf, size_t buf_size, CF_EntityId_t src_eid, CF_TransactionSeq_t seq_num,
+                          const char *ext);
+
+#endif /* !CF_DELTA_H */
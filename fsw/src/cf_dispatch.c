@@ -64,6 +64,9 @@ void CF_ProcessGroundCommand(const CFE_SB_Buffer_t *BufPtr)
         [CF_PURGE_QUEUE_CC]         = (handler_fn_t)CF_PurgeQueueCmd,
         [CF_ENABLE_ENGINE_CC]       = (handler_fn_t)CF_EnableEngineCmd,
         [CF_DISABLE_ENGINE_CC]      = (handler_fn_t)CF_DisableEngineCmd,
+        [CF_WRITE_TRACE_CC]         = (handler_fn_t)CF_WriteTraceCmd,
+        [CF_TX_FILE_MULTI_CC]       = (handler_fn_t)CF_TxFileMultiCmd,
+        [CF_TX_FILE_FOLLOW_CC]      = (handler_fn_t)CF_TxFileFollowCmd,
     };
 
     static const uint16 expected_lengths[] = {
@@ -87,6 +90,9 @@ void CF_ProcessGroundCommand(const CFE_SB_Buffer_t *BufPtr)
         [CF_PURGE_QUEUE_CC]         = sizeof(CF_UnionArgs_Payload_t),
         [CF_ENABLE_ENGINE_CC]       = sizeof(CF_EnableEngineCmd_t),
         [CF_DISABLE_ENGINE_CC]      = sizeof(CF_DisableEngineCmd_t),
+        [CF_WRITE_TRACE_CC]         = sizeof(CF_WriteTraceCmd_t),
+        [CF_TX_FILE_MULTI_CC]       = sizeof(CF_TxFileMultiCmd_t),
+        [CF_TX_FILE_FOLLOW_CC]      = sizeof(CF_TxFileFollowCmd_t),
     };
 
     CFE_MSG_FcnCode_t cmd = 0;
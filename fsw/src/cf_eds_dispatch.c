@@ -31,7 +31,10 @@ static const EdsDispatchTable_CF_Application_CFE_SB_Telecommand_t CF_TC_DISPATCH
             .SuspendCmd_indication           = CF_SuspendCmd,
             .ThawCmd_indication              = CF_ThawCmd,
             .TxFileCmd_indication            = CF_TxFileCmd,
+            .TxFileFollowCmd_indication      = CF_TxFileFollowCmd,
+            .TxFileMultiCmd_indication       = CF_TxFileMultiCmd,
             .WriteQueueCmd_indication        = CF_WriteQueueCmd,
+            .WriteTraceCmd_indication        = CF_WriteTraceCmd,
         },
     .SEND_HK = {.indication = CF_SendHkCmd},
     .WAKE_UP = {.indication = CF_WakeupCmd}};
@@ -0,0 +1,140 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ *  The CF Application hot path event aggregation source file
+ *
+ *  Counting a suppressed event is a couple of stores, so a flood of bad
+ *  PDUs costs no formatting and no EVS traffic beyond the first event and
+ *  one summary per interval.
+ */
+
+#include "cfe.h"
+#include "cf_verify.h"
+#include "cf_evagg.h"
+#include "cf_app.h"
+#include "cf_events.h"
+#include "cf_assert.h"
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_evagg.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_EvAgg_Suppress(CF_EvAggId_t id, uint32 arg1, uint32 arg2)
+{
+    CF_EvAggSlot_t *slot;
+    bool            suppress;
+
+    CF_Assert(id < CF_EvAgg_NUM);
+    slot = &CF_AppData.evagg.slot[id];
+
+    suppress = (slot->count != 0);
+    if (slot->count < UINT32_MAX)
+    {
+        ++slot->count;
+    }
+    slot->arg[0] = arg1;
+    slot->arg[1] = arg2;
+
+    return suppress;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static void CF_EvAgg_SendSummary(CF_EvAggId_t id, const CF_EvAggSlot_t *slot)
+{
+    switch (id)
+    {
+        case CF_EvAgg_PDU_TRUNCATION:
+            CFE_EVS_SendEvent(CF_PDU_TRUNCATION_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "CF: %lu PDUs rejected due to EID/seq number field truncation in the last %lu s",
+                              (unsigned long)slot->count, (unsigned long)CF_EVENT_AGG_INTERVAL_S);
+            break;
+        case CF_EvAgg_PDU_LARGE_FILE:
+            CFE_EVS_SendEvent(CF_PDU_LARGE_FILE_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "CF: %lu PDUs with large file bit received (unsupported) in the last %lu s",
+                              (unsigned long)slot->count, (unsigned long)CF_EVENT_AGG_INTERVAL_S);
+            break;
+        case CF_EvAgg_PDU_SHORT_HEADER:
+            CFE_EVS_SendEvent(CF_PDU_SHORT_HEADER_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "CF: %lu PDUs too short in the last %lu s, last %lu received",
+                              (unsigned long)slot->count, (unsigned long)CF_EVENT_AGG_INTERVAL_S,
+                              (unsigned long)slot->arg[0]);
+            break;
+        case CF_EvAgg_NO_MSG:
+            CFE_EVS_SendEvent(CF_CFDP_NO_MSG_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "CF: no output message buffer available %lu times in the last %lu s",
+                              (unsigned long)slot->count, (unsigned long)CF_EVENT_AGG_INTERVAL_S);
+            break;
+        case CF_EvAgg_RX_DROPPED:
+            CFE_EVS_SendEvent(CF_CFDP_RX_DROPPED_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "CF: dropped %lu packets due max RX transactions reached in the last %lu s, last from "
+                              "%lu transaction number 0x%08lx",
+                              (unsigned long)slot->count, (unsigned long)CF_EVENT_AGG_INTERVAL_S,
+                              (unsigned long)slot->arg[0], (unsigned long)slot->arg[1]);
+            break;
+        case CF_EvAgg_INVALID_DST:
+        default:
+            CFE_EVS_SendEvent(CF_CFDP_INVALID_DST_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "CF: dropped %lu packets for invalid destination eid in the last %lu s, last 0x%lx",
+                              (unsigned long)slot->count, (unsigned long)CF_EVENT_AGG_INTERVAL_S,
+                              (unsigned long)slot->arg[0]);
+            break;
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_evagg.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_EvAgg_Tick(void)
+{
+    CF_EvAggSlot_t *slot;
+    int             i;
+
+    if (CF_Timer_Expired(&CF_AppData.evagg.interval))
+    {
+        for (i = 0; i < CF_EvAgg_NUM; ++i)
+        {
+            slot = &CF_AppData.evagg.slot[i];
+
+            /* a single occurrence was already sent in full */
+            if (slot->count > 1)
+            {
+                CF_EvAgg_SendSummary((CF_EvAggId_t)i, slot);
+            }
+            slot->count = 0;
+        }
+
+        CF_Timer_InitRelSec(&CF_AppData.evagg.interval, CF_EVENT_AGG_INTERVAL_S);
+    }
+    else
+    {
+        CF_Timer_Tick(&CF_AppData.evagg.interval);
+    }
+}
@@ -0,0 +1,101 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ *  The CF Application hot path event aggregation header file
+ */
+
+#ifndef CF_EVAGG_H
+#define CF_EVAGG_H
+
+#include "cfe.h"
+#include "cf_timer.h"
+
+/**
+ * @brief Error events that are aggregated
+ *
+ * Each of these can be raised for every PDU received or every PDU the
+ * engine tries to send, so a flood of bad or excess PDUs would otherwise
+ * turn into a flood of formatted events.
+ */
+typedef enum
+{
+    CF_EvAgg_PDU_TRUNCATION   = 0, /**< \brief #CF_PDU_TRUNCATION_ERR_EID */
+    CF_EvAgg_PDU_LARGE_FILE   = 1, /**< \brief #CF_PDU_LARGE_FILE_ERR_EID */
+    CF_EvAgg_PDU_SHORT_HEADER = 2, /**< \brief #CF_PDU_SHORT_HEADER_ERR_EID, arg is the size received */
+    CF_EvAgg_NO_MSG           = 3, /**< \brief #CF_CFDP_NO_MSG_ERR_EID */
+    CF_EvAgg_RX_DROPPED       = 4, /**< \brief #CF_CFDP_RX_DROPPED_ERR_EID, args are source EID and sequence number */
+    CF_EvAgg_INVALID_DST      = 5, /**< \brief #CF_CFDP_INVALID_DST_ERR_EID, arg is the destination EID */
+    CF_EvAgg_NUM              = 6
+} CF_EvAggId_t;
+
+/**
+ * @brief Occurrences of one aggregated event in the current interval
+ */
+typedef struct CF_EvAggSlot
+{
+    uint32 count;  /**< \brief Occurrences, including the first which was sent in full */
+    uint32 arg[2]; /**< \brief Arguments of the last occurrence */
+} CF_EvAggSlot_t;
+
+/**
+ * @brief Event aggregation state
+ */
+typedef struct CF_EvAgg
+{
+    CF_Timer_t     interval; /**< \brief Expires at the end of the current interval */
+    CF_EvAggSlot_t slot[CF_EvAgg_NUM];
+} CF_EvAgg_t;
+
+/************************************************************************/
+/** @brief Count an occurrence of an aggregated event.
+ *
+ * @par Description
+ *       The first occurrence in an interval is not suppressed, so the
+ *       caller sends the event in full as usual. Later occurrences only
+ *       update the count and the last arguments, and the caller sends
+ *       nothing.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       Unused arguments should be passed as 0.
+ *
+ * @param id    Aggregated event
+ * @param arg1  First argument of the event
+ * @param arg2  Second argument of the event
+ *
+ * @returns true if the caller must not send the event
+ */
+bool CF_EvAgg_Suppress(CF_EvAggId_t id, uint32 arg1, uint32 arg2);
+
+/************************************************************************/
+/** @brief Advance the aggregation interval.
+ *
+ * @par Description
+ *       At the end of each interval, sends one summary event with the count
+ *       and last arguments for every aggregated event that was suppressed,
+ *       and starts counting again.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       Called once per wakeup.
+ */
+void CF_EvAgg_Tick(void);
+
+#endif /* !CF_EVAGG_H */
@@ -0,0 +1,306 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ *  The CF Application multi-destination send (fan-out) source file
+ *
+ *  A file sent to several destinations by one command is opened and
+ *  read once for all of them. Each destination still has its own S
+ *  transaction, with its own NAK handling, but their file data comes
+ *  from a small block cache shared by the group, and so does the file
+ *  checksum.
+ */
+
+#include "cfe.h"
+#include "cf_verify.h"
+#include "cf_fanout.h"
+#include "cf_app.h"
+#include "cf_utils.h"
+#include "cf_assert.h"
+
+#include <string.h>
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static CF_FanOutBlock_t *CF_FanOut_FindBlock(CF_FanOut_t *group, uint32 offset)
+{
+    CF_FanOutBlock_t *block = NULL;
+    int               i;
+
+    for (i = 0; i < CF_FANOUT_CACHE_BLOCKS; ++i)
+    {
+        if (group->blocks[i].len && group->blocks[i].offset == offset)
+        {
+            block = &group->blocks[i];
+            break;
+        }
+    }
+
+    return block;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static CF_FanOutBlock_t *CF_FanOut_LoadBlock(CF_FanOut_t *group, uint32 offset)
+{
+    CF_FanOutBlock_t *block = &group->blocks[0];
+    uint32            len;
+    int32             status;
+    int               i;
+
+    /* use an empty block, or else the least recently used one */
+    for (i = 1; i < CF_FANOUT_CACHE_BLOCKS; ++i)
+    {
+        if (block->len && (!group->blocks[i].len || group->blocks[i].last_use < block->last_use))
+        {
+            block = &group->blocks[i];
+        }
+    }
+
+    len = group->fsize - offset;
+    if (len > CF_FANOUT_CACHE_BLOCK_SIZE)
+    {
+        len = CF_FANOUT_CACHE_BLOCK_SIZE;
+    }
+
+    block->len = 0;
+
+    status = CF_WrappedLseek(group->fd, offset, OS_SEEK_SET);
+    if (status == offset)
+    {
+        status = CF_WrappedRead(group->fd, block->data, len);
+    }
+
+    if (status == len)
+    {
+        block->offset = offset;
+        block->len    = len;
+    }
+    else
+    {
+        block = NULL;
+    }
+
+    return block;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static CF_FanOutBlock_t *CF_FanOut_GetBlock(CF_FanOut_t *group, uint32 offset)
+{
+    CF_FanOutBlock_t *block = CF_FanOut_FindBlock(group, offset);
+
+    if (!block)
+    {
+        block = CF_FanOut_LoadBlock(group, offset);
+    }
+
+    if (block)
+    {
+        block->last_use = ++group->use_count;
+
+        /* the checksum covers each block once, in file order, whichever destination gets there first */
+        if (block->offset == group->crc_offs)
+        {
+            CF_CRC_Digest(&group->crc, block->data, block->len);
+            group->crc_offs += block->len;
+        }
+    }
+
+    return block;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_fanout.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CF_FanOut_t *CF_FanOut_Open(const char *filename)
+{
+    CF_FanOut_t *group = NULL;
+    osal_id_t    fd    = OS_OBJECT_ID_UNDEFINED;
+    int32        status;
+    int          i;
+
+    for (i = 0; i < CF_NUM_FANOUT_GROUPS; ++i)
+    {
+        if (!CF_AppData.engine.fanouts[i].in_use)
+        {
+            group = &CF_AppData.engine.fanouts[i];
+            break;
+        }
+    }
+
+    /* same rule as a single send, the file must not be open for anything else */
+    if (group && (OS_FileOpenCheck(filename) == OS_SUCCESS ||
+                  CF_WrappedOpenCreate(&fd, filename, OS_FILE_FLAG_NONE, OS_READ_ONLY) < 0))
+    {
+        group = NULL;
+    }
+
+    if (group)
+    {
+        status = CF_WrappedLseek(fd, 0, OS_SEEK_END);
+        if (status < 0)
+        {
+            CF_WrappedClose(fd);
+            group = NULL;
+        }
+        else
+        {
+            group->fd        = fd;
+            group->fsize     = status;
+            group->crc_offs  = 0;
+            group->use_count = 0;
+            group->num_txn   = 0;
+            group->in_use    = true;
+            group->failed    = false;
+            CF_CRC_Start(&group->crc);
+
+            for (i = 0; i < CF_FANOUT_CACHE_BLOCKS; ++i)
+            {
+                group->blocks[i].len = 0;
+            }
+        }
+    }
+
+    return group;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_fanout.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_FanOut_Attach(CF_FanOut_t *group)
+{
+    ++group->num_txn;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_fanout.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_FanOut_Release(CF_FanOut_t *group, bool success)
+{
+    bool ret = false;
+
+    CF_Assert(group->num_txn); /* sanity check */
+    --group->num_txn;
+
+    if (!success)
+    {
+        group->failed = true;
+    }
+
+    if (!group->num_txn)
+    {
+        CF_WrappedClose(group->fd);
+        group->fd     = OS_OBJECT_ID_UNDEFINED;
+        group->in_use = false;
+
+        ret = !group->failed;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_fanout.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 CF_FanOut_Read(CF_FanOut_t *group, uint32 offset, void *buf, uint32 len)
+{
+    CF_FanOutBlock_t *block;
+    uint32            done = 0;
+    uint32            pos;
+    uint32            bytes;
+
+    while (done < len)
+    {
+        pos   = offset + done;
+        block = CF_FanOut_GetBlock(group, pos - (pos % CF_FANOUT_CACHE_BLOCK_SIZE));
+        if (!block || pos >= (block->offset + block->len))
+        {
+            break; /* read error, or the file is shorter than the request */
+        }
+
+        bytes = (block->offset + block->len) - pos;
+        if (bytes > (len - done))
+        {
+            bytes = len - done;
+        }
+
+        memcpy((uint8 *)buf + done, &block->data[pos - block->offset], bytes);
+        done += bytes;
+    }
+
+    return done;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_fanout.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_FanOut_GetCrc(CF_FanOut_t *group, CF_Crc_t *crc, uint32 max_bytes)
+{
+    CFE_Status_t ret   = CFE_SUCCESS;
+    uint32       start = group->crc_offs;
+
+    /* only needed if no destination read some of the file in order, e.g. it was skipped as already received */
+    while (ret == CFE_SUCCESS && group->crc_offs < group->fsize && (group->crc_offs - start) < max_bytes)
+    {
+        if (!CF_FanOut_GetBlock(group, group->crc_offs))
+        {
+            ret = CF_ERROR;
+        }
+    }
+
+    if (ret == CFE_SUCCESS && group->crc_offs < group->fsize)
+    {
+        ret = CF_FANOUT_CRC_PENDING;
+    }
+    else if (ret == CFE_SUCCESS)
+    {
+        /* each destination finalizes its own copy, the group may still be in use */
+        *crc = group->crc;
+        CF_CRC_Finalize(crc);
+    }
+
+    return ret;
+}
@@ -0,0 +1,161 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ *  The CF Application multi-destination send (fan-out) header file
+ */
+
+#ifndef CF_FANOUT_H
+#define CF_FANOUT_H
+
+#include "cfe.h"
+#include "cf_platform_cfg.h"
+#include "cf_crc.h"
+
+/**
+ * @brief One block of a fan-out group's read cache
+ */
+typedef struct CF_FanOutBlock
+{
+    uint32 offset;   /**< \brief file offset of the first byte, always a multiple of the block size */
+    uint32 len;      /**< \brief number of valid bytes, 0 if the block holds nothing */
+    uint32 last_use; /**< \brief value of the group's use counter when the block was last read from */
+    uint8  data[CF_FANOUT_CACHE_BLOCK_SIZE];
+} CF_FanOutBlock_t;
+
+/**
+ * @brief State shared by the transactions of one multi-destination send
+ *
+ * The source file is opened once for the whole group, and every
+ * destination's file data, including retransmits, is read through the
+ * block cache. The file checksum is worked out by the group as each block
+ * is first read in order, so it is done once for all destinations.
+ */
+typedef struct CF_FanOut
+{
+    osal_id_t fd;        /**< \brief source file, open while any transaction uses the group */
+    uint32    fsize;     /**< \brief size of the source file when it was opened */
+    uint32    crc_offs;  /**< \brief file data digested into crc so far */
+    CF_Crc_t  crc;       /**< \brief checksum of the source file, final once crc_offs reaches fsize */
+    uint32    use_count; /**< \brief counts cache reads, used to pick the least recently used block */
+    uint8     num_txn;   /**< \brief transactions still using the group */
+    bool      in_use;    /**< \brief group has been taken by CF_FanOut_Open() */
+    bool      failed;    /**< \brief at least one transaction of the group did not complete successfully */
+
+    CF_FanOutBlock_t blocks[CF_FANOUT_CACHE_BLOCKS];
+} CF_FanOut_t;
+
+/************************************************************************/
+/** @brief Open a source file for a multi-destination send.
+ *
+ * @par Description
+ *       Takes a free fan-out group, opens the file and reads its size.
+ *       The group starts with no transactions, see CF_FanOut_Attach().
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       filename must not be NULL. The file must not already be open.
+ *
+ * @param filename  Source file to send
+ *
+ * @returns Pointer to the fan-out group
+ * @retval NULL if no group is free, or the file is already open or cannot be opened
+ */
+CF_FanOut_t *CF_FanOut_Open(const char *filename);
+
+/************************************************************************/
+/** @brief Add a transaction to a fan-out group.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       group must not be NULL. Each call must be matched by a call
+ *       to CF_FanOut_Release() when the transaction ends.
+ *
+ * @param group  Fan-out group
+ */
+void CF_FanOut_Attach(CF_FanOut_t *group);
+
+/************************************************************************/
+/** @brief Remove a transaction from a fan-out group.
+ *
+ * @par Description
+ *       The source file is closed, and the group freed, once the last
+ *       transaction is removed.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       group must not be NULL.
+ *
+ * @param group    Fan-out group
+ * @param success  true if the transaction completed successfully
+ *
+ * @returns true if this was the last transaction and all of them completed successfully
+ */
+bool CF_FanOut_Release(CF_FanOut_t *group, bool success);
+
+/************************************************************************/
+/** @brief Read file data for one destination of a fan-out group.
+ *
+ * @par Description
+ *       Copies the data out of the read cache, reading the blocks that
+ *       are not there from the file. Each block is added to the group's
+ *       checksum the first time it is used in file order.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       group and buf must not be NULL. offset + len must not be beyond
+ *       the size of the file.
+ *
+ * @param group   Fan-out group
+ * @param offset  File offset to read from
+ * @param buf     Buffer to copy the data to
+ * @param len     Number of bytes to read
+ *
+ * @returns Number of bytes read
+ * @retval Less than len if the file could not be read
+ */
+int32 CF_FanOut_Read(CF_FanOut_t *group, uint32 offset, void *buf, uint32 len);
+
+/**
+ * @brief Return code of CF_FanOut_GetCrc() when more of the file is left to read
+ */
+#define CF_FANOUT_CRC_PENDING (1)
+
+/************************************************************************/
+/** @brief Get the checksum of a fan-out group's source file.
+ *
+ * @par Description
+ *       Any part of the file not yet read by a destination is read and
+ *       digested first, so this normally only finalizes the checksum.
+ *       At most max_bytes are read per call, rounded up to a whole cache
+ *       block, so a file that was mostly skipped is digested over
+ *       several calls.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       group and crc must not be NULL, max_bytes must not be 0.
+ *
+ * @param group      Fan-out group
+ * @param crc        Set to the finalized checksum, once all of the file is digested
+ * @param max_bytes  Most bytes of the file to read in this call
+ *
+ * @retval CFE_SUCCESS on success
+ * @retval CF_FANOUT_CRC_PENDING if more of the file is left to read, crc is not set
+ * @retval CF_ERROR if the file could not be read
+ */
+CFE_Status_t CF_FanOut_GetCrc(CF_FanOut_t *group, CF_Crc_t *crc, uint32 max_bytes);
+
+#endif /* !CF_FANOUT_H */
@@ -0,0 +1,111 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ *  The CF Application filestore interface source file
+ *
+ *  The OSAL filestore serves every path by default. Other filestores are
+ *  mounted on a path prefix in the table below.
+ */
+
+#include "cfe.h"
+#include "cf_filestore.h"
+#include "cf_memstore.h"
+#include "cf_app.h"
+
+#include <string.h>
+
+/**
+ * @brief The OSAL filestore, for files on a real file system
+ */
+const CF_Filestore_t CF_Filestore_Osal = {.OpenCreate = OS_OpenCreate,
+                                          .Close      = OS_close,
+                                          .Read       = OS_read,
+                                          .Write      = OS_write,
+                                          .Lseek      = CF_Filestore_OsalLseek,
+                                          .Remove     = OS_remove,
+                                          .Rename     = OS_mv,
+                                          .Stat       = OS_stat,
+                                          .OwnsFd     = NULL};
+
+/**
+ * @brief Filestores other than OSAL, by path prefix
+ */
+static const CF_FilestoreMount_t CF_FILESTORE_MOUNTS[] = {
+    {CF_MEMSTORE_PATH_PREFIX, &CF_Memstore_Filestore},
+};
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_filestore.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 CF_Filestore_OsalLseek(osal_id_t fd, off_t offset, int mode)
+{
+    return OS_lseek(fd, offset, mode);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_filestore.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+const CF_Filestore_t *CF_Filestore_FromPath(const char *fname)
+{
+    const CF_Filestore_t *store = &CF_Filestore_Osal;
+    int                   i;
+
+    for (i = 0; i < (sizeof(CF_FILESTORE_MOUNTS) / sizeof(CF_FILESTORE_MOUNTS[0])); ++i)
+    {
+        if (strncmp(fname, CF_FILESTORE_MOUNTS[i].prefix, strlen(CF_FILESTORE_MOUNTS[i].prefix)) == 0)
+        {
+            store = CF_FILESTORE_MOUNTS[i].store;
+            break;
+        }
+    }
+
+    return store;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_filestore.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+const CF_Filestore_t *CF_Filestore_FromFd(osal_id_t fd)
+{
+    const CF_Filestore_t *store = &CF_Filestore_Osal;
+    int                   i;
+
+    for (i = 0; i < (sizeof(CF_FILESTORE_MOUNTS) / sizeof(CF_FILESTORE_MOUNTS[0])); ++i)
+    {
+        if (CF_FILESTORE_MOUNTS[i].store->OwnsFd(fd))
+        {
+            store = CF_FILESTORE_MOUNTS[i].store;
+            break;
+        }
+    }
+
+    return store;
+}
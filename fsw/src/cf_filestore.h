@@ -0,0 +1,114 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ *  The CF Application filestore interface header file
+ *
+ *  All file access done by the CFDP engine goes through a filestore,
+ *  which is a table of operations with the same semantics as the
+ *  OSAL file API. The filestore is chosen by path prefix when a file
+ *  is opened, and by file descriptor after that.
+ */
+
+#ifndef CF_FILESTORE_H
+#define CF_FILESTORE_H
+
+#include "cfe.h"
+
+#include <sys/types.h>
+
+/**
+ * @brief Filestore operations
+ *
+ * Each operation takes the same arguments and returns the same values
+ * (byte counts or OSAL status codes) as the OSAL call of the same name:
+ * OS_OpenCreate(), OS_close(), OS_read(), OS_write(), OS_lseek(), OS_remove(),
+ * OS_mv() and OS_stat().
+ */
+typedef struct CF_Filestore
+{
+    int32 (*OpenCreate)(osal_id_t *fd, const char *fname, int32 flags, int32 access);
+    int32 (*Close)(osal_id_t fd);
+    int32 (*Read)(osal_id_t fd, void *buf, size_t read_size);
+    int32 (*Write)(osal_id_t fd, const void *buf, size_t write_size);
+    int32 (*Lseek)(osal_id_t fd, off_t offset, int mode);
+    int32 (*Remove)(const char *fname);
+    int32 (*Rename)(const char *old_filename, const char *new_filename);
+    int32 (*Stat)(const char *path, os_fstat_t *filestats);
+
+    /** \brief true if fd is a descriptor this filestore handed out */
+    bool (*OwnsFd)(osal_id_t fd);
+} CF_Filestore_t;
+
+/**
+ * @brief A filestore and the path prefix it serves
+ */
+typedef struct CF_FilestoreMount
+{
+    const char *          prefix; /**< \brief paths starting with this string use store */
+    const CF_Filestore_t *store;
+} CF_FilestoreMount_t;
+
+/**
+ * @brief The OSAL filestore, for files on a real file system
+ */
+extern const CF_Filestore_t CF_Filestore_Osal;
+
+/************************************************************************/
+/** @brief Seek within an OSAL file.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       Only adapts the argument types of OS_lseek() to the filestore interface.
+ *
+ * @param fd      Passed directly to OS_lseek()
+ * @param offset  Passed directly to OS_lseek()
+ * @param mode    Passed directly to OS_lseek()
+ *
+ * @returns Status code from OSAL (byte offset or error code)
+ */
+int32 CF_Filestore_OsalLseek(osal_id_t fd, off_t offset, int mode);
+
+/************************************************************************/
+/** @brief Get the filestore that serves a path.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       fname must not be NULL. Paths that do not match any mounted
+ *       prefix are served by the OSAL filestore.
+ *
+ * @param fname  File name
+ *
+ * @returns Pointer to the filestore, never NULL
+ */
+const CF_Filestore_t *CF_Filestore_FromPath(const char *fname);
+
+/************************************************************************/
+/** @brief Get the filestore that opened a file descriptor.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       Descriptors not claimed by any mounted filestore are OSAL descriptors.
+ *
+ * @param fd  File descriptor
+ *
+ * @returns Pointer to the filestore, never NULL
+ */
+const CF_Filestore_t *CF_Filestore_FromFd(osal_id_t fd);
+
+#endif /* !CF_FILESTORE_H */
@@ -0,0 +1,275 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ *  The CF Application per-peer flow control source file
+ *
+ *  Each destination entity gets a window of file data bytes it may be
+ *  sent per wakeup. The window is driven by the loss the peer reports
+ *  in its NAK PDUs, so that retransmission volume on a congested link
+ *  goes down instead of up.
+ */
+
+#include "cfe.h"
+#include "cf_verify.h"
+#include "cf_flow.h"
+#include "cf_app.h"
+#include "cf_assert.h"
+
+#include <string.h>
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_flow.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CF_FlowPeer_t *CF_Flow_FindPeer(CF_EntityId_t eid)
+{
+    CF_FlowPeer_t *peer;
+    CF_FlowPeer_t *ret = NULL;
+    int            i;
+
+    for (i = 0; i < CF_NUM_FLOW_PEERS; ++i)
+    {
+        peer = &CF_AppData.engine.flow_peers[i];
+        if (peer->in_use)
+        {
+            if (peer->eid == eid)
+            {
+                ret = peer;
+                break;
+            }
+        }
+        else if (!ret)
+        {
+            ret = peer; /* remember the first free entry, in case eid is not found */
+        }
+    }
+
+    if (ret && !ret->in_use)
+    {
+        memset(ret, 0, sizeof(*ret));
+        ret->eid    = eid;
+        ret->in_use = true;
+        ret->window = CF_FLOW_MAX_WINDOW;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_flow.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CF_FlowPeer_t *CF_Flow_LookupPeer(CF_EntityId_t eid)
+{
+    CF_FlowPeer_t *peer;
+    int            i;
+
+    for (i = 0; i < CF_NUM_FLOW_PEERS; ++i)
+    {
+        peer = &CF_AppData.engine.flow_peers[i];
+        if (peer->in_use && peer->eid == eid)
+        {
+            return peer;
+        }
+    }
+
+    return NULL;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_flow.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_Flow_Permit(const CF_FlowPeer_t *peer, uint32 bytes)
+{
+    /* always allow the first PDU of a wakeup, so a peer can never be starved completely */
+    return (!peer || !peer->sent || ((peer->sent + bytes) <= peer->window));
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_flow.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Flow_Sent(CF_FlowPeer_t *peer, uint32 bytes, bool acked)
+{
+    if (peer)
+    {
+        peer->sent += bytes;
+        if (acked)
+        {
+            peer->in_flight += bytes;
+        }
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_flow.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Flow_Feedback(CF_FlowPeer_t *peer, uint32 released, uint32 lost)
+{
+    uint32 sample;
+
+    if (peer)
+    {
+        CF_Flow_Release(peer, released);
+
+        if (released || lost)
+        {
+            if (lost >= released)
+            {
+                sample = 1000;
+            }
+            else
+            {
+                sample = (uint32)(((uint64)lost * 1000) / released);
+            }
+
+            peer->loss = ((peer->loss * 7) + sample) / 8;
+
+            if (sample > CF_FLOW_LOSS_THRESHOLD)
+            {
+                peer->loss_event = true;
+            }
+        }
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_flow.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Flow_Release(CF_FlowPeer_t *peer, uint32 bytes)
+{
+    if (peer)
+    {
+        if (bytes > peer->in_flight)
+        {
+            bytes = peer->in_flight;
+        }
+        peer->in_flight -= bytes;
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_flow.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Flow_Cycle(void)
+{
+    CF_FlowPeer_t *   peer;
+    CF_HkPeer_Data_t *hk;
+    uint32            step;
+    uint32            base;
+    int               i;
+
+    /* one file data PDU is both the additive step and the smallest window */
+    step = CF_AppData.config_table->outgoing_file_chunk_size;
+    if (!step)
+    {
+        step = 1;
+    }
+
+    for (i = 0; i < CF_NUM_FLOW_PEERS; ++i)
+    {
+        peer = &CF_AppData.engine.flow_peers[i];
+        hk   = &CF_AppData.hk.Payload.peer_hk[i];
+
+        if (peer->in_use)
+        {
+            if (peer->sent)
+            {
+                peer->rate = ((peer->rate * 3) + peer->sent) / 4;
+            }
+
+            if (peer->loss_event)
+            {
+                /* multiplicative decrease from what was actually achieved, so an oversized
+                 * window that was never filled collapses to something meaningful at once */
+                base = peer->window;
+                if (peer->rate && peer->rate < base)
+                {
+                    base = peer->rate;
+                }
+                peer->window     = base / 2;
+                peer->loss_event = false;
+            }
+            else if ((peer->sent + step) > peer->window)
+            {
+                /* the window was the limiting factor, and no loss was reported: additive increase */
+                peer->window += step;
+            }
+
+            if (peer->window < step)
+            {
+                peer->window = step;
+            }
+            else if (peer->window > CF_FLOW_MAX_WINDOW)
+            {
+                peer->window = CF_FLOW_MAX_WINDOW;
+            }
+
+            if (peer->sent || peer->in_flight)
+            {
+                peer->idle = 0;
+            }
+            else
+            {
+                ++peer->idle;
+            }
+
+            peer->sent = 0;
+
+            if (peer->idle >= CF_FLOW_PEER_IDLE_CYCLES)
+            {
+                /* nothing has gone to this peer for a long time, so let another one have the entry */
+                memset(peer, 0, sizeof(*peer));
+                memset(hk, 0, sizeof(*hk));
+                continue;
+            }
+
+            hk->eid       = peer->eid;
+            hk->window    = peer->window;
+            hk->rate      = peer->rate;
+            hk->in_flight = peer->in_flight;
+            hk->loss      = peer->loss;
+        }
+        else
+        {
+            memset(hk, 0, sizeof(*hk));
+        }
+    }
+}
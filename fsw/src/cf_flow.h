@@ -0,0 +1,144 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ *  The CF Application per-peer flow control header file
+ */
+
+#ifndef CF_FLOW_H
+#define CF_FLOW_H
+
+#include "cfe.h"
+#include "cf_extern_typedefs.h"
+
+/**
+ * @brief Flow control state for a single destination entity
+ *
+ * The window is adjusted once per wakeup in an additive-increase,
+ * multiplicative-decrease fashion: it grows by one file data chunk
+ * whenever the peer used its whole window without reported loss, and
+ * is halved whenever the peer NAKs more than CF_FLOW_LOSS_THRESHOLD of
+ * the data sent since its previous feedback.
+ */
+typedef struct CF_FlowPeer
+{
+    CF_EntityId_t eid;        /**< \brief destination entity id */
+    bool          in_use;     /**< \brief entry has been assigned to eid */
+    bool          loss_event; /**< \brief loss above threshold was reported since the last update */
+    uint16        loss;       /**< \brief smoothed loss estimate, parts per thousand */
+    uint32        window;     /**< \brief file data bytes permitted per wakeup */
+    uint32        sent;       /**< \brief file data bytes sent so far this wakeup */
+    uint32        rate;       /**< \brief smoothed file data bytes sent per wakeup that sent any */
+    uint32        in_flight;  /**< \brief class 2 file data bytes not yet acknowledged */
+    uint32        idle;       /**< \brief engine cycles with nothing sent or in flight */
+} CF_FlowPeer_t;
+
+/************************************************************************/
+/** @brief Find the flow control entry for a destination entity.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       If no entry exists for eid, an unused entry is assigned to it.
+ *
+ * @param eid    Destination entity id
+ *
+ * @returns Pointer to the flow control entry
+ * @retval NULL if all entries are in use by other entities
+ */
+CF_FlowPeer_t *CF_Flow_FindPeer(CF_EntityId_t eid);
+
+/************************************************************************/
+/** @brief Look up the flow control entry for a destination entity.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       Unlike CF_Flow_FindPeer(), no entry is assigned if none exists, so
+ *       this is used where data is only released or acknowledged.
+ *
+ * @param eid    Destination entity id
+ *
+ * @returns Pointer to the flow control entry
+ * @retval NULL if there is no entry for eid
+ */
+CF_FlowPeer_t *CF_Flow_LookupPeer(CF_EntityId_t eid);
+
+/************************************************************************/
+/** @brief Check if file data may be sent to a peer this wakeup.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       peer may be NULL, in which case sending is always permitted.
+ *
+ * @param peer   Flow control entry for the destination
+ * @param bytes  Number of file data bytes about to be sent
+ *
+ * @returns true if the bytes fit in the window, false if the peer is throttled
+ */
+bool CF_Flow_Permit(const CF_FlowPeer_t *peer, uint32 bytes);
+
+/************************************************************************/
+/** @brief Account for file data sent to a peer.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       peer may be NULL, in which case nothing is done.
+ *
+ * @param peer   Flow control entry for the destination
+ * @param bytes  Number of file data bytes sent
+ * @param acked  true if the data will be acknowledged by the peer (class 2)
+ */
+void CF_Flow_Sent(CF_FlowPeer_t *peer, uint32 bytes, bool acked);
+
+/************************************************************************/
+/** @brief Process feedback received from a peer.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       peer may be NULL, in which case nothing is done.  The released bytes
+ *       are the class 2 bytes sent since the previous feedback for the
+ *       transaction, and lost is the number of bytes the peer requested again.
+ *
+ * @param peer     Flow control entry for the destination
+ * @param released Number of in-flight bytes covered by this feedback
+ * @param lost     Number of bytes reported missing by the peer
+ */
+void CF_Flow_Feedback(CF_FlowPeer_t *peer, uint32 released, uint32 lost);
+
+/************************************************************************/
+/** @brief Release in-flight bytes without treating them as feedback.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       peer may be NULL, in which case nothing is done. Used when a
+ *       transaction ends before the peer acknowledged all of its data.
+ *
+ * @param peer   Flow control entry for the destination
+ * @param bytes  Number of in-flight bytes to release
+ */
+void CF_Flow_Release(CF_FlowPeer_t *peer, uint32 bytes);
+
+/************************************************************************/
+/** @brief Adjust all peer windows and publish them to housekeeping.
+ *
+ * @par Description
+ *       A peer that has had nothing sent or in flight for
+ *       CF_FLOW_PEER_IDLE_CYCLES engine cycles gives up its entry.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       Called once per engine cycle before any file data is sent.
+ */
+void CF_Flow_Cycle(void);
+
+#endif /* !CF_FLOW_H */
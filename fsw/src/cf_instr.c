@@ -0,0 +1,192 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ *  The CF Application latency instrumentation source file
+ *
+ *  Each channel keeps a fixed-bucket latency histogram for every
+ *  instrumented hot path. The histograms live in the diagnostics packet
+ *  itself, so sending them needs no copying.
+ */
+
+#include "cfe.h"
+#include "cf_verify.h"
+#include "cf_instr.h"
+#include "cf_app.h"
+#include "cf_assert.h"
+
+#include <string.h>
+
+/**
+ * \brief Upper bound of the first histogram bucket, in microseconds
+ */
+#define CF_INSTR_FIRST_BUCKET_USEC (16)
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_instr.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Instr_Init(void)
+{
+    CFE_MSG_Init(CFE_MSG_PTR(CF_AppData.diag.TelemetryHeader), CFE_SB_ValueToMsgId(CF_DIAG_TLM_MID),
+                 sizeof(CF_AppData.diag));
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_instr.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Instr_SetChannel(uint8 chan_num)
+{
+    CF_Assert(chan_num < CF_NUM_CHANNELS);
+    CF_AppData.engine.instr_chan = chan_num;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_instr.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Instr_Start(OS_time_t *stamp)
+{
+    OS_GetLocalTime(stamp);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_instr.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Instr_Record(CF_InstrHist_t id, OS_time_t start)
+{
+    CF_DiagHist_Data_t *hist;
+    OS_time_t           now;
+    int64               elapsed;
+    uint32              usec;
+    uint32              limit;
+    int                 b;
+
+    OS_GetLocalTime(&now);
+    elapsed = OS_TimeGetTotalMicroseconds(OS_TimeSubtract(now, start));
+
+    if (elapsed < 0)
+    {
+        usec = 0;
+    }
+    else if (elapsed > UINT32_MAX)
+    {
+        usec = UINT32_MAX;
+    }
+    else
+    {
+        usec = (uint32)elapsed;
+    }
+
+    /* bucket b covers samples below CF_INSTR_FIRST_BUCKET_USEC * 4^b, the last one everything else */
+    limit = CF_INSTR_FIRST_BUCKET_USEC;
+    for (b = 0; b < (CF_INSTR_NUM_BUCKETS - 1) && usec >= limit; ++b)
+    {
+        limit <<= 2;
+    }
+
+    hist = &CF_AppData.diag.Payload.channel[CF_AppData.engine.instr_chan].hist[id];
+    if (hist->bucket[b] < UINT32_MAX)
+    {
+        ++hist->bucket[b];
+    }
+    if (usec > hist->max_usec)
+    {
+        hist->max_usec = usec;
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_instr.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CF_InstrHist_t CF_Instr_PduHist(const CF_Logical_PduBuffer_t *ph)
+{
+    CF_InstrHist_t id;
+
+    if (ph->pdu_header.pdu_type)
+    {
+        id = CF_InstrHist_RX_FD;
+    }
+    else
+    {
+        switch (ph->fdirective.directive_code)
+        {
+            case CF_CFDP_FileDirective_METADATA:
+                id = CF_InstrHist_RX_MD;
+                break;
+            case CF_CFDP_FileDirective_EOF:
+                id = CF_InstrHist_RX_EOF;
+                break;
+            case CF_CFDP_FileDirective_FIN:
+                id = CF_InstrHist_RX_FIN;
+                break;
+            case CF_CFDP_FileDirective_ACK:
+                id = CF_InstrHist_RX_ACK;
+                break;
+            case CF_CFDP_FileDirective_NAK:
+                id = CF_InstrHist_RX_NAK;
+                break;
+            default:
+                id = CF_InstrHist_RX_OTHER;
+                break;
+        }
+    }
+
+    return id;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_instr.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Instr_Reset(void)
+{
+    memset(&CF_AppData.diag.Payload, 0, sizeof(CF_AppData.diag.Payload));
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_instr.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Instr_SendDiag(void)
+{
+#if CF_INSTR_ENABLE
+    CFE_SB_TimeStampMsg(CFE_MSG_PTR(CF_AppData.diag.TelemetryHeader));
+    /* return value ignored */ CFE_SB_TransmitMsg(CFE_MSG_PTR(CF_AppData.diag.TelemetryHeader), true);
+#endif
+}
@@ -0,0 +1,151 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ *  The CF Application latency instrumentation header file
+ */
+
+#ifndef CF_INSTR_H
+#define CF_INSTR_H
+
+#include "cfe.h"
+#include "cf_msg.h"
+#include "cf_platform_cfg.h"
+#include "cf_logical_pdu.h"
+
+/**
+ * \name CF latency instrumentation macros
+ *
+ * Hot paths are timed by declaring a CF_InstrStamp_t, starting it with
+ * CF_INSTR_START() and recording it into a histogram with CF_INSTR_RECORD().
+ * When CF_INSTR_ENABLE is zero the stamp is a plain byte and both macros
+ * compile to nothing, so the instrumented code costs nothing.
+ * \{
+ */
+
+#if CF_INSTR_ENABLE
+
+/**
+ * \brief Start time of an instrumented operation
+ */
+typedef OS_time_t CF_InstrStamp_t;
+
+/**
+ * \brief Start timing an instrumented operation
+ */
+#define CF_INSTR_START(stamp) CF_Instr_Start(&(stamp))
+
+/**
+ * \brief Record the time since CF_INSTR_START() in a latency histogram
+ */
+#define CF_INSTR_RECORD(id, stamp) CF_Instr_Record((id), (stamp))
+
+#else /* CF_INSTR_ENABLE */
+
+typedef uint8 CF_InstrStamp_t;
+
+#define CF_INSTR_START(stamp)      ((stamp) = 0)
+#define CF_INSTR_RECORD(id, stamp) ((void)(stamp))
+
+#endif /* CF_INSTR_ENABLE */
+
+/**\}*/
+
+/************************************************************************/
+/** @brief Initialize the diagnostics packet.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       Called once at application startup. The histograms are not
+ *       cleared when the engine is restarted.
+ */
+void CF_Instr_Init(void);
+
+/************************************************************************/
+/** @brief Select the channel that latency samples are recorded against.
+ *
+ * @par Description
+ *       File I/O and buffer allocations do not know which channel they
+ *       are working for, so the engine selects the channel before it does
+ *       any work on it.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       chan_num must be less than CF_NUM_CHANNELS.
+ *
+ * @param chan_num  Channel number
+ */
+void CF_Instr_SetChannel(uint8 chan_num);
+
+/************************************************************************/
+/** @brief Get the start time of an instrumented operation.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       stamp must not be NULL. Use CF_INSTR_START() rather than calling
+ *       this directly.
+ *
+ * @param stamp  Set to the current local time
+ */
+void CF_Instr_Start(OS_time_t *stamp);
+
+/************************************************************************/
+/** @brief Record the time since a start time in a latency histogram.
+ *
+ * @par Description
+ *       Adds one sample to the bucket covering the elapsed time in the
+ *       histogram of the current channel, and updates its maximum.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       Use CF_INSTR_RECORD() rather than calling this directly.
+ *
+ * @param id     Histogram to record in
+ * @param start  Start time from CF_INSTR_START()
+ */
+void CF_Instr_Record(CF_InstrHist_t id, OS_time_t start);
+
+/************************************************************************/
+/** @brief Get the dispatch histogram for a received PDU.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       ph must not be NULL, and its header must already be decoded.
+ *
+ * @param ph  Received PDU
+ *
+ * @returns Histogram for the type of the PDU
+ */
+CF_InstrHist_t CF_Instr_PduHist(const CF_Logical_PduBuffer_t *ph);
+
+/************************************************************************/
+/** @brief Clear all latency histograms.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       None
+ */
+void CF_Instr_Reset(void);
+
+/************************************************************************/
+/** @brief Send the diagnostics packet.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       Sent alongside every housekeeping packet. Nothing is sent when
+ *       CF_INSTR_ENABLE is zero.
+ */
+void CF_Instr_SendDiag(void);
+
+#endif /* !CF_INSTR_H */
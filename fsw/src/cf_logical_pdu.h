@@ -271,6 +271,8 @@ typedef struct CF_Logical_PduMd
 
     CF_Logical_Lv_t source_filename;
     CF_Logical_Lv_t dest_filename;
+
+    CF_Logical_TlvList_t tlv_list; /**< \brief metadata options */
 } CF_Logical_PduMd_t;
 
 /**
@@ -303,6 +305,26 @@ typedef struct CF_Logical_PduFileDataHeader
     size_t      data_len; /**< \brief Length of data blob within encoded PDU (derived field) */
 } CF_Logical_PduFileDataHeader_t;
 
+/**
+ * @brief Structure representing logical Prompt PDU
+ *
+ * Defined per section 5.2.7 / table 5-12 of CCSDS 727.0-B-5
+ */
+typedef struct CF_Logical_PduPrompt
+{
+    CF_CFDP_PromptResponse_t response_required; /**< \brief the response the receiver is asked for */
+} CF_Logical_PduPrompt_t;
+
+/**
+ * @brief Structure representing logical Keep Alive PDU
+ *
+ * Defined per section 5.2.8 / table 5-13 of CCSDS 727.0-B-5
+ */
+typedef struct CF_Logical_PduKeepAlive
+{
+    CF_FileSize_t progress; /**< \brief file data received without gaps from the start of the file */
+} CF_Logical_PduKeepAlive_t;
+
 /**
  * @brief A union of all possible internal header types in a PDU
  *
@@ -311,12 +333,14 @@ typedef struct CF_Logical_PduFileDataHeader
  */
 typedef union CF_Logical_IntHeader
 {
-    CF_Logical_PduEof_t            eof; /**< \brief valid when pdu_type=0 + directive_code=EOF (4) */
-    CF_Logical_PduFin_t            fin; /**< \brief valid when pdu_type=0 + directive_code=FIN (5) */
-    CF_Logical_PduAck_t            ack; /**< \brief valid when pdu_type=0 + directive_code=ACK (6) */
-    CF_Logical_PduMd_t             md;  /**< \brief valid when pdu_type=0 + directive_code=METADATA (7) */
-    CF_Logical_PduNak_t            nak; /**< \brief valid when pdu_type=0 + directive_code=NAK (8) */
-    CF_Logical_PduFileDataHeader_t fd;  /**< \brief valid when pdu_type=1 (directive_code is not applicable) */
+    CF_Logical_PduEof_t            eof;        /**< \brief valid when pdu_type=0 + directive_code=EOF (4) */
+    CF_Logical_PduFin_t            fin;        /**< \brief valid when pdu_type=0 + directive_code=FIN (5) */
+    CF_Logical_PduAck_t            ack;        /**< \brief valid when pdu_type=0 + directive_code=ACK (6) */
+    CF_Logical_PduMd_t             md;         /**< \brief valid when pdu_type=0 + directive_code=METADATA (7) */
+    CF_Logical_PduNak_t            nak;        /**< \brief valid when pdu_type=0 + directive_code=NAK (8) */
+    CF_Logical_PduPrompt_t         prompt;     /**< \brief valid when pdu_type=0 + directive_code=PROMPT (9) */
+    CF_Logical_PduKeepAlive_t      keep_alive; /**< \brief valid when pdu_type=0 + directive_code=KEEP_ALIVE (12) */
+    CF_Logical_PduFileDataHeader_t fd;         /**< \brief valid when pdu_type=1 (directive_code is not applicable) */
 } CF_Logical_IntHeader_t;
 
 /**
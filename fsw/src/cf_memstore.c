@@ -0,0 +1,503 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ *  The CF Application RAM filestore source file
+ *
+ *  Files are held in a fixed pool inside the application, or in a buffer
+ *  attached by its owner. They behave like OSAL files as far as the CFDP
+ *  engine can tell, so they can be sent and received without touching a
+ *  file system.
+ */
+
+#include "cfe.h"
+#include "cf_memstore.h"
+#include "cf_app.h"
+
+#include <string.h>
+
+const CF_Filestore_t CF_Memstore_Filestore = {.OpenCreate = CF_Memstore_OpenCreate,
+                                              .Close      = CF_Memstore_Close,
+                                              .Read       = CF_Memstore_Read,
+                                              .Write      = CF_Memstore_Write,
+                                              .Lseek      = CF_Memstore_Lseek,
+                                              .Remove     = CF_Memstore_Remove,
+                                              .Rename     = CF_Memstore_Rename,
+                                              .Stat       = CF_Memstore_Stat,
+                                              .OwnsFd     = CF_Memstore_OwnsFd};
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_memstore.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 CF_Memstore_Attach(const char *fname, const void *buf, uint32 size)
+{
+    CF_MemstoreFile_t *file = NULL;
+    int32              ret  = OS_SUCCESS;
+    int                i;
+
+    if (strlen(fname) >= sizeof(file->name))
+    {
+        ret = OS_FS_ERR_PATH_TOO_LONG;
+    }
+    else if (CF_Memstore_FindFile(fname))
+    {
+        ret = OS_ERR_NAME_TAKEN;
+    }
+    else
+    {
+        for (i = 0; i < CF_MEMSTORE_NUM_FILES; ++i)
+        {
+            if (!CF_AppData.memstore.files[i].data)
+            {
+                file = &CF_AppData.memstore.files[i];
+                break;
+            }
+        }
+
+        if (!file)
+        {
+            ret = OS_ERR_NO_FREE_IDS;
+        }
+        else
+        {
+            strcpy(file->name, fname); /* length was checked above */
+            file->data      = (uint8 *)buf; /* never written through, see read_only */
+            file->size      = size;
+            file->capacity  = size;
+            file->read_only = true;
+        }
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_memstore.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CF_MemstoreFile_t *CF_Memstore_FindFile(const char *fname)
+{
+    CF_MemstoreFile_t *file = NULL;
+    int                i;
+
+    for (i = 0; i < CF_MEMSTORE_NUM_FILES; ++i)
+    {
+        if (CF_AppData.memstore.files[i].data && !strcmp(CF_AppData.memstore.files[i].name, fname))
+        {
+            file = &CF_AppData.memstore.files[i];
+            break;
+        }
+    }
+
+    return file;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_memstore.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CF_MemstoreHandle_t *CF_Memstore_GetHandle(osal_id_t fd)
+{
+    CF_MemstoreHandle_t *handle = NULL;
+
+    if (CF_Memstore_OwnsFd(fd))
+    {
+        handle = &CF_AppData.memstore.handles[OS_ObjectIdToInteger(fd) - CF_MEMSTORE_FD_BASE];
+        if (!handle->file)
+        {
+            handle = NULL;
+        }
+    }
+
+    return handle;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_memstore.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 CF_Memstore_OpenCreate(osal_id_t *fd, const char *fname, int32 flags, int32 access)
+{
+    CF_MemstoreFile_t *  file   = NULL;
+    CF_MemstoreHandle_t *handle = NULL;
+    int32                ret    = OS_SUCCESS;
+    int                  i;
+    int                  h;
+
+    *fd = OS_OBJECT_ID_UNDEFINED;
+
+    for (h = 0; h < CF_MEMSTORE_NUM_HANDLES; ++h)
+    {
+        if (!CF_AppData.memstore.handles[h].file)
+        {
+            handle = &CF_AppData.memstore.handles[h];
+            break;
+        }
+    }
+
+    if (!handle)
+    {
+        ret = OS_ERR_NO_FREE_IDS;
+    }
+    else if (strlen(fname) >= sizeof(file->name))
+    {
+        ret = OS_FS_ERR_PATH_TOO_LONG;
+    }
+    else
+    {
+        file = CF_Memstore_FindFile(fname);
+        if (!file && (flags & OS_FILE_FLAG_CREATE))
+        {
+            for (i = 0; i < CF_MEMSTORE_NUM_FILES; ++i)
+            {
+                if (!CF_AppData.memstore.files[i].data)
+                {
+                    file = &CF_AppData.memstore.files[i];
+                    strcpy(file->name, fname); /* length was checked above */
+                    file->data      = CF_AppData.memstore.pool[i];
+                    file->size      = 0;
+                    file->capacity  = sizeof(CF_AppData.memstore.pool[i]);
+                    file->read_only = false;
+                    break;
+                }
+            }
+        }
+
+        if (!file)
+        {
+            ret = OS_ERR_NAME_NOT_FOUND;
+        }
+        else if (access != OS_READ_ONLY && file->read_only)
+        {
+            ret = OS_ERROR;
+        }
+        else
+        {
+            if (flags & OS_FILE_FLAG_TRUNCATE)
+            {
+                file->size = 0;
+            }
+
+            handle->file     = file;
+            handle->pos      = 0;
+            handle->writable = (access != OS_READ_ONLY);
+
+            *fd = OS_ObjectIdFromInteger(CF_MEMSTORE_FD_BASE + h);
+        }
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_memstore.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 CF_Memstore_Close(osal_id_t fd)
+{
+    CF_MemstoreHandle_t *handle = CF_Memstore_GetHandle(fd);
+    int32                ret    = OS_SUCCESS;
+
+    if (!handle)
+    {
+        ret = OS_ERR_INVALID_ID;
+    }
+    else
+    {
+        handle->file = NULL;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_memstore.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 CF_Memstore_Read(osal_id_t fd, void *buf, size_t read_size)
+{
+    CF_MemstoreHandle_t *handle = CF_Memstore_GetHandle(fd);
+    int32                ret;
+
+    if (!handle)
+    {
+        ret = OS_ERR_INVALID_ID;
+    }
+    else
+    {
+        if (handle->pos >= handle->file->size)
+        {
+            read_size = 0;
+        }
+        else if (read_size > (handle->file->size - handle->pos))
+        {
+            read_size = handle->file->size - handle->pos;
+        }
+
+        memcpy(buf, &handle->file->data[handle->pos], read_size);
+        handle->pos += read_size;
+        ret = read_size;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_memstore.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 CF_Memstore_Write(osal_id_t fd, const void *buf, size_t write_size)
+{
+    CF_MemstoreHandle_t *handle = CF_Memstore_GetHandle(fd);
+    CF_MemstoreFile_t *  file;
+    int32                ret;
+
+    if (!handle)
+    {
+        ret = OS_ERR_INVALID_ID;
+    }
+    else if (!handle->writable)
+    {
+        ret = OS_ERROR;
+    }
+    else
+    {
+        file = handle->file;
+
+        if (write_size > (file->capacity - handle->pos))
+        {
+            write_size = file->capacity - handle->pos;
+        }
+
+        if (handle->pos > file->size)
+        {
+            /* seeked past the end, same as a sparse file */
+            memset(&file->data[file->size], 0, handle->pos - file->size);
+        }
+
+        memcpy(&file->data[handle->pos], buf, write_size);
+        handle->pos += write_size;
+        if (file->size < handle->pos)
+        {
+            file->size = handle->pos;
+        }
+        ret = write_size;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_memstore.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 CF_Memstore_Lseek(osal_id_t fd, off_t offset, int mode)
+{
+    CF_MemstoreHandle_t *handle = CF_Memstore_GetHandle(fd);
+    int64                pos;
+    int32                ret;
+
+    if (!handle)
+    {
+        ret = OS_ERR_INVALID_ID;
+    }
+    else
+    {
+        switch (mode)
+        {
+            case OS_SEEK_SET:
+                pos = 0;
+                break;
+            case OS_SEEK_CUR:
+                pos = handle->pos;
+                break;
+            case OS_SEEK_END:
+                pos = handle->file->size;
+                break;
+            default:
+                pos = -1;
+                break;
+        }
+
+        if (pos >= 0)
+        {
+            pos += offset;
+        }
+
+        if (pos < 0 || pos > handle->file->capacity)
+        {
+            ret = OS_ERROR;
+        }
+        else
+        {
+            handle->pos = pos;
+            ret         = pos;
+        }
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static bool CF_Memstore_IsOpen(const CF_MemstoreFile_t *file)
+{
+    bool is_open = false;
+    int  h;
+
+    for (h = 0; h < CF_MEMSTORE_NUM_HANDLES; ++h)
+    {
+        if (CF_AppData.memstore.handles[h].file == file)
+        {
+            is_open = true;
+            break;
+        }
+    }
+
+    return is_open;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_memstore.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 CF_Memstore_Remove(const char *fname)
+{
+    CF_MemstoreFile_t *file = CF_Memstore_FindFile(fname);
+    int32              ret  = OS_SUCCESS;
+
+    if (!file)
+    {
+        ret = OS_ERR_NAME_NOT_FOUND;
+    }
+    else if (CF_Memstore_IsOpen(file))
+    {
+        ret = OS_ERROR;
+    }
+    else
+    {
+        memset(file, 0, sizeof(*file));
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_memstore.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 CF_Memstore_Rename(const char *old_filename, const char *new_filename)
+{
+    CF_MemstoreFile_t *file   = CF_Memstore_FindFile(old_filename);
+    CF_MemstoreFile_t *target = CF_Memstore_FindFile(new_filename);
+    int32              ret    = OS_SUCCESS;
+
+    if (!file)
+    {
+        ret = OS_ERR_NAME_NOT_FOUND;
+    }
+    else if (strlen(new_filename) >= sizeof(file->name))
+    {
+        ret = OS_FS_ERR_PATH_TOO_LONG;
+    }
+    else if (CF_Memstore_IsOpen(file) || (target && CF_Memstore_IsOpen(target)))
+    {
+        ret = OS_ERROR;
+    }
+    else if (target != file)
+    {
+        if (target)
+        {
+            memset(target, 0, sizeof(*target)); /* replaced, like OS_mv() */
+        }
+
+        strcpy(file->name, new_filename); /* length was checked above */
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_memstore.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+int32 CF_Memstore_Stat(const char *path, os_fstat_t *filestats)
+{
+    CF_MemstoreFile_t *file = CF_Memstore_FindFile(path);
+    int32              ret  = OS_SUCCESS;
+
+    memset(filestats, 0, sizeof(*filestats));
+
+    if (!file)
+    {
+        ret = OS_ERR_NAME_NOT_FOUND;
+    }
+    else
+    {
+        filestats->FileSize     = file->size;
+        filestats->FileModeBits = OS_FILESTAT_MODE_READ;
+        if (!file->read_only)
+        {
+            filestats->FileModeBits |= OS_FILESTAT_MODE_WRITE;
+        }
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_memstore.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+bool CF_Memstore_OwnsFd(osal_id_t fd)
+{
+    unsigned long val = OS_ObjectIdToInteger(fd);
+
+    return (val >= CF_MEMSTORE_FD_BASE && val < (CF_MEMSTORE_FD_BASE + CF_MEMSTORE_NUM_HANDLES));
+}
@@ -0,0 +1,220 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ *  The CF Application RAM filestore header file
+ */
+
+#ifndef CF_MEMSTORE_H
+#define CF_MEMSTORE_H
+
+#include "cfe.h"
+#include "cf_filestore.h"
+#include "cf_platform_cfg.h"
+#include "cf_extern_typedefs.h"
+
+/**
+ * @brief Descriptor values handed out by the RAM filestore start here
+ *
+ * This is above any object id that OSAL assigns, so that the owner of a
+ * descriptor can be told from its value alone.
+ */
+#define CF_MEMSTORE_FD_BASE (0x7F000000)
+
+/**
+ * @brief A file in the RAM filestore
+ */
+typedef struct CF_MemstoreFile
+{
+    char   name[CF_FILENAME_MAX_LEN];
+    uint8 *data;      /**< \brief file contents, NULL if the entry is unused */
+    uint32 size;      /**< \brief current file size */
+    uint32 capacity;  /**< \brief size of the buffer at data */
+    bool   read_only; /**< \brief buffer was attached, and belongs to someone else */
+} CF_MemstoreFile_t;
+
+/**
+ * @brief An open file in the RAM filestore
+ */
+typedef struct CF_MemstoreHandle
+{
+    CF_MemstoreFile_t *file; /**< \brief NULL if the handle is free */
+    uint32             pos;
+    bool               writable;
+} CF_MemstoreHandle_t;
+
+/**
+ * @brief RAM filestore state
+ */
+typedef struct CF_Memstore
+{
+    CF_MemstoreFile_t   files[CF_MEMSTORE_NUM_FILES];
+    CF_MemstoreHandle_t handles[CF_MEMSTORE_NUM_HANDLES];
+    uint8               pool[CF_MEMSTORE_NUM_FILES][CF_MEMSTORE_FILE_SIZE]; /**< \brief storage for files[] */
+} CF_Memstore_t;
+
+/**
+ * @brief The RAM filestore operations
+ */
+extern const CF_Filestore_t CF_Memstore_Filestore;
+
+/************************************************************************/
+/** @brief Make an existing buffer available as a read-only RAM file.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       fname and buf must not be NULL. fname should start with
+ *       CF_MEMSTORE_PATH_PREFIX for CF to look for it in the RAM filestore.
+ *       buf must stay valid until the file is removed, which happens when
+ *       a transaction sending it with keep set to 0 completes.
+ *
+ * @param fname  File name
+ * @param buf    File contents
+ * @param size   Size of buf in bytes
+ *
+ * @retval OS_SUCCESS on success
+ * @retval OS_FS_ERR_PATH_TOO_LONG if fname does not fit
+ * @retval OS_ERR_NAME_TAKEN if fname already exists
+ * @retval OS_ERR_NO_FREE_IDS if all RAM files are in use
+ */
+int32 CF_Memstore_Attach(const char *fname, const void *buf, uint32 size);
+
+/************************************************************************/
+/** @brief Find a RAM file by name.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       fname must not be NULL.
+ *
+ * @param fname  File name
+ *
+ * @returns Pointer to the file, or NULL if it does not exist
+ */
+CF_MemstoreFile_t *CF_Memstore_FindFile(const char *fname);
+
+/************************************************************************/
+/** @brief Get the RAM filestore handle for a descriptor.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       None
+ *
+ * @param fd  File descriptor
+ *
+ * @returns Pointer to the handle, or NULL if fd is not an open RAM file
+ */
+CF_MemstoreHandle_t *CF_Memstore_GetHandle(osal_id_t fd);
+
+/************************************************************************/
+/** @brief Open or create a RAM file.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       fd and fname must not be NULL.
+ *
+ * @sa OS_OpenCreate() for argument/return detail
+ */
+int32 CF_Memstore_OpenCreate(osal_id_t *fd, const char *fname, int32 flags, int32 access);
+
+/************************************************************************/
+/** @brief Close a RAM file.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       None
+ *
+ * @sa OS_close() for argument/return detail
+ */
+int32 CF_Memstore_Close(osal_id_t fd);
+
+/************************************************************************/
+/** @brief Read from a RAM file.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       buf must not be NULL.
+ *
+ * @sa OS_read() for argument/return detail
+ */
+int32 CF_Memstore_Read(osal_id_t fd, void *buf, size_t read_size);
+
+/************************************************************************/
+/** @brief Write to a RAM file.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       buf must not be NULL. A write that would go past the capacity of
+ *       the file is short.
+ *
+ * @sa OS_write() for argument/return detail
+ */
+int32 CF_Memstore_Write(osal_id_t fd, const void *buf, size_t write_size);
+
+/************************************************************************/
+/** @brief Seek within a RAM file.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       Seeking past the end of the file is allowed up to its capacity.
+ *       The gap is zero filled by the next write.
+ *
+ * @sa OS_lseek() for argument/return detail
+ */
+int32 CF_Memstore_Lseek(osal_id_t fd, off_t offset, int mode);
+
+/************************************************************************/
+/** @brief Remove a RAM file.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       fname must not be NULL. The file must not be open.
+ *
+ * @sa OS_remove() for argument/return detail
+ */
+int32 CF_Memstore_Remove(const char *fname);
+
+/************************************************************************/
+/** @brief Rename a RAM file.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       old_filename and new_filename must not be NULL. Neither file may
+ *       be open. An existing file named new_filename is replaced.
+ *
+ * @sa OS_mv() for argument/return detail
+ */
+int32 CF_Memstore_Rename(const char *old_filename, const char *new_filename);
+
+/************************************************************************/
+/** @brief Get the size and mode of a RAM file.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       path and filestats must not be NULL. Attached files are reported
+ *       read-only. RAM files carry no time stamp, so FileTime is zero.
+ *
+ * @sa OS_stat() for argument/return detail
+ */
+int32 CF_Memstore_Stat(const char *path, os_fstat_t *filestats);
+
+/************************************************************************/
+/** @brief Check if a descriptor belongs to the RAM filestore.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       None
+ *
+ * @param fd  File descriptor
+ *
+ * @retval true if fd is in the range handed out by the RAM filestore
+ * @retval false otherwise
+ */
+bool CF_Memstore_OwnsFd(osal_id_t fd);
+
+#endif /* !CF_MEMSTORE_H */
@@ -0,0 +1,282 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ *  The CF Application binary trace ring source file
+ *
+ *  Recording an entry is a handful of stores into a fixed ring, with no
+ *  formatting and no locking, so trace points can sit on the hot path.
+ *  Entries only become text on the ground.
+ */
+
+#include "cfe.h"
+#include "cf_verify.h"
+#include "cf_trace.h"
+#include "cf_app.h"
+#include "cf_events.h"
+#include "cf_utils.h"
+
+#include <string.h>
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_trace.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Trace_Record(CF_TraceEvent_t event, uint8 chan_num, uint32 seq_num, uint8 code, uint8 sub_code, uint32 offset,
+                     uint16 length)
+{
+    CF_TraceEntry_t *entry;
+    OS_time_t        now;
+
+    entry = &CF_AppData.trace.ring[CF_AppData.trace.head & (CF_TRACE_RING_ENTRIES - 1)];
+    ++CF_AppData.trace.head;
+    if ((CF_AppData.trace.head & (CF_TRACE_RING_ENTRIES - 1)) == 0)
+    {
+        CF_AppData.trace.full = true;
+    }
+
+    OS_GetLocalTime(&now);
+
+    entry->sec      = (uint32)OS_TimeGetTotalSeconds(now);
+    entry->usec     = OS_TimeGetMicrosecondsPart(now);
+    entry->seq_num  = seq_num;
+    entry->offset   = offset;
+    entry->length   = length;
+    entry->event    = event;
+    entry->chan_num = chan_num;
+    entry->code     = code;
+    entry->sub_code = sub_code;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static uint8 CF_Trace_SubState(const CF_Transaction_t *txn)
+{
+    uint8 sub_state;
+
+    switch (txn->state)
+    {
+        case CF_TxnState_S1:
+        case CF_TxnState_S2:
+            sub_state = txn->state_data.send.sub_state;
+            break;
+        case CF_TxnState_R1:
+        case CF_TxnState_R2:
+            sub_state = txn->state_data.receive.sub_state;
+            break;
+        default:
+            sub_state = 0;
+            break;
+    }
+
+    return sub_state;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_trace.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Trace_Pdu(CF_TraceEvent_t event, uint8 chan_num, const CF_Logical_PduBuffer_t *ph)
+{
+    if (ph->pdu_header.pdu_type)
+    {
+        CF_Trace_Record(event, chan_num, (uint32)ph->pdu_header.sequence_num, 0, 0, (uint32)ph->int_header.fd.offset,
+                        (uint16)ph->int_header.fd.data_len);
+    }
+    else
+    {
+        CF_Trace_Record(event, chan_num, (uint32)ph->pdu_header.sequence_num, ph->fdirective.directive_code, 0, 0,
+                        ph->pdu_header.data_encoded_length);
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_trace.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Trace_SaveState(CF_TraceState_t *saved, const CF_Transaction_t *txn)
+{
+    saved->has_seq   = (txn->history != NULL);
+    saved->seq_num   = saved->has_seq ? (uint32)txn->history->seq_num : 0;
+    saved->state     = txn->state;
+    saved->sub_state = CF_Trace_SubState(txn);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_trace.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Trace_CheckState(const CF_TraceState_t *saved, const CF_Transaction_t *txn)
+{
+    uint8  sub_state = CF_Trace_SubState(txn);
+    uint32 seq_num   = saved->seq_num;
+
+    if (txn->state != saved->state || sub_state != saved->sub_state)
+    {
+        /* an idle transaction only gets its history when it starts */
+        if (!saved->has_seq && txn->history != NULL)
+        {
+            seq_num = (uint32)txn->history->seq_num;
+        }
+
+        CF_Trace_Record(CF_TraceEvent_STATE, txn->chan_num, seq_num, txn->state, sub_state, 0, 0);
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_trace.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_Trace_StartDump(const char *filename)
+{
+    CF_Trace_t *         trace = &CF_AppData.trace;
+    CF_TraceFileHeader_t hdr;
+    CFE_Status_t         ret;
+
+    if (trace->dumping)
+    {
+        ret = CF_ERROR;
+    }
+    else
+    {
+        ret = CF_WrappedOpenCreate(&trace->dump_fd, filename, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE,
+                                   OS_WRITE_ONLY);
+        if (ret >= 0)
+        {
+            trace->dump_end  = trace->head;
+            trace->dump_next = trace->full ? (trace->head - CF_TRACE_RING_ENTRIES) : 0;
+            trace->dump_lost = 0;
+
+            memset(&hdr, 0, sizeof(hdr));
+            hdr.magic      = CF_TRACE_FILE_MAGIC;
+            hdr.version    = CF_TRACE_FILE_VERSION;
+            hdr.entry_size = sizeof(CF_TraceEntry_t);
+            hdr.count      = trace->dump_end - trace->dump_next;
+            hdr.first      = trace->dump_next;
+
+            if (CF_WrappedWrite(trace->dump_fd, &hdr, sizeof(hdr)) == (CFE_Status_t)sizeof(hdr))
+            {
+                trace->dumping = true;
+                ret            = CFE_SUCCESS;
+            }
+            else
+            {
+                CF_WrappedClose(trace->dump_fd);
+                ret = CF_ERROR;
+            }
+        }
+        else
+        {
+            ret = CF_ERROR;
+        }
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_trace.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_Trace_DumpCycle(void)
+{
+    CF_Trace_t * trace = &CF_AppData.trace;
+    uint32       budget;
+    uint32       index;
+    uint32       num;
+    uint32       skip;
+    int32        bytes;
+    CFE_Status_t ret = CFE_SUCCESS;
+
+    if (trace->dumping)
+    {
+        /* tracing carried on since the last wakeup, so skip whatever has been overwritten in the meantime */
+        if ((trace->head - trace->dump_next) > CF_TRACE_RING_ENTRIES)
+        {
+            skip = (trace->head - CF_TRACE_RING_ENTRIES) - trace->dump_next;
+            if (skip > (trace->dump_end - trace->dump_next))
+            {
+                skip = trace->dump_end - trace->dump_next;
+            }
+            trace->dump_lost += skip;
+            trace->dump_next += skip;
+        }
+
+        budget = CF_TRACE_DUMP_ENTRIES_PER_WAKEUP;
+        while (budget > 0 && trace->dump_next != trace->dump_end && ret == CFE_SUCCESS)
+        {
+            /* one write for each contiguous run of the ring */
+            index = trace->dump_next & (CF_TRACE_RING_ENTRIES - 1);
+            num   = trace->dump_end - trace->dump_next;
+            if (num > budget)
+            {
+                num = budget;
+            }
+            if (num > (CF_TRACE_RING_ENTRIES - index))
+            {
+                num = CF_TRACE_RING_ENTRIES - index;
+            }
+
+            bytes = num * sizeof(CF_TraceEntry_t);
+            if (CF_WrappedWrite(trace->dump_fd, &trace->ring[index], bytes) != bytes)
+            {
+                ret = CF_ERROR;
+            }
+            else
+            {
+                trace->dump_next += num;
+                budget -= num;
+            }
+        }
+
+        if (ret != CFE_SUCCESS)
+        {
+            CFE_EVS_SendEvent(CF_TRACE_DUMP_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "CF: failed to write trace dump, %lu entries left",
+                              (unsigned long)(trace->dump_end - trace->dump_next));
+            CF_WrappedClose(trace->dump_fd);
+            trace->dumping = false;
+        }
+        else if (trace->dump_next == trace->dump_end)
+        {
+            CFE_EVS_SendEvent(CF_TRACE_DUMP_INF_EID, CFE_EVS_EventType_INFORMATION,
+                              "CF: trace dump complete, %lu entries were overwritten before being written",
+                              (unsigned long)trace->dump_lost);
+            CF_WrappedClose(trace->dump_fd);
+            trace->dumping = false;
+        }
+    }
+}
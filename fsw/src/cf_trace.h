@@ -0,0 +1,283 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ *  The CF Application binary trace ring header file
+ *
+ *  The layout of the dump file is decoded on the ground by
+ *  tools/cf_trace_decode.py, which must be kept in step with the
+ *  structures here.
+ */
+
+#ifndef CF_TRACE_H
+#define CF_TRACE_H
+
+#include "cfe.h"
+#include "cf_platform_cfg.h"
+#include "cf_extern_typedefs.h"
+#include "cf_cfdp_types.h"
+#include "cf_logical_pdu.h"
+
+/**
+ * @brief Magic number at the start of a trace dump file, "CFTR"
+ *
+ * The dump is written in the byte order of the flight processor, so the
+ * decoder uses this to tell which byte order the file has.
+ */
+#define CF_TRACE_FILE_MAGIC (0x43465452)
+
+/**
+ * @brief Version of the trace dump file layout
+ */
+#define CF_TRACE_FILE_VERSION (1)
+
+/**
+ * @brief Kinds of trace entry
+ */
+typedef enum
+{
+    CF_TraceEvent_PDU_TX = 1, /**< \brief PDU sent, code is the directive code (0 for file data) */
+    CF_TraceEvent_PDU_RX = 2, /**< \brief PDU received, code is the directive code (0 for file data) */
+    CF_TraceEvent_STATE  = 3, /**< \brief Transaction state change, code is the state and sub_code the sub state */
+    CF_TraceEvent_TIMER  = 4, /**< \brief Transaction timer expired, code is a #CF_TraceTimer_t */
+    CF_TraceEvent_STALL  = 5, /**< \brief Transaction could not send, code is a #CF_TraceStall_t */
+} CF_TraceEvent_t;
+
+/**
+ * @brief Timers reported by #CF_TraceEvent_TIMER
+ */
+typedef enum
+{
+    CF_TraceTimer_ACK        = 1, /**< \brief ACK (or NAK retry) timer */
+    CF_TraceTimer_INACTIVITY = 2, /**< \brief Inactivity timer */
+} CF_TraceTimer_t;
+
+/**
+ * @brief Reasons reported by #CF_TraceEvent_STALL
+ */
+typedef enum
+{
+    CF_TraceStall_NO_BUF = 1, /**< \brief No output buffer was available */
+    CF_TraceStall_FLOW   = 2, /**< \brief File data was held back by flow control */
+    CF_TraceStall_FOLLOW = 3, /**< \brief A followed file had no new data yet */
+} CF_TraceStall_t;
+
+/**
+ * @brief One trace entry, as kept in the ring and written to the dump file
+ */
+typedef struct CF_TraceEntry
+{
+    uint32 sec;      /**< \brief Local time, seconds */
+    uint32 usec;     /**< \brief Local time, microseconds within the second */
+    uint32 seq_num;  /**< \brief Transaction sequence number */
+    uint32 offset;   /**< \brief File offset of file data PDUs, else 0 */
+    uint16 length;   /**< \brief Encoded length of the PDU data field, or of file data, else 0 */
+    uint8  event;    /**< \brief Kind of entry, a #CF_TraceEvent_t */
+    uint8  chan_num; /**< \brief Channel number */
+    uint8  code;     /**< \brief Depends on event, see #CF_TraceEvent_t */
+    uint8  sub_code; /**< \brief Depends on event, see #CF_TraceEvent_t */
+    uint8  spare[2];
+} CF_TraceEntry_t;
+
+/**
+ * @brief Header at the start of a trace dump file
+ */
+typedef struct CF_TraceFileHeader
+{
+    uint32 magic;      /**< \brief #CF_TRACE_FILE_MAGIC */
+    uint16 version;    /**< \brief #CF_TRACE_FILE_VERSION */
+    uint16 entry_size; /**< \brief sizeof(CF_TraceEntry_t) */
+    uint32 count;      /**< \brief Entries in the ring when the dump started */
+    uint32 first;      /**< \brief Index since startup of the oldest entry in the ring when the dump started */
+} CF_TraceFileHeader_t;
+
+/**
+ * @brief Trace ring and dump state
+ */
+typedef struct CF_Trace
+{
+    CF_TraceEntry_t ring[CF_TRACE_RING_ENTRIES];
+
+    uint32 head; /**< \brief Entries recorded since startup, index of the next one is head modulo the ring size */
+    bool   full; /**< \brief The ring has wrapped, so all of its entries are valid */
+
+    osal_id_t dump_fd;   /**< \brief File being dumped to */
+    bool      dumping;   /**< \brief A dump is in progress */
+    uint32    dump_next; /**< \brief Next entry to write */
+    uint32    dump_end;  /**< \brief Entry the dump stops at, the head when the dump started */
+    uint32    dump_lost; /**< \brief Entries overwritten before they could be written */
+} CF_Trace_t;
+
+/**
+ * @brief Transaction state before a state machine call, see CF_TRACE_STATE_SAVE()
+ */
+typedef struct CF_TraceState
+{
+    uint32 seq_num;   /**< \brief Sequence number, if the transaction had a history */
+    bool   has_seq;   /**< \brief The transaction had a history */
+    uint8  state;     /**< \brief Transaction state */
+    uint8  sub_state; /**< \brief Send or receive sub state */
+} CF_TraceState_t;
+
+/**
+ * \name CF trace macros
+ *
+ * Trace points use these rather than calling the functions directly. When
+ * CF_TRACE_ENABLE is zero the saved state is a plain byte and every macro
+ * compiles to nothing, so the traced code costs nothing.
+ * \{
+ */
+
+#if CF_TRACE_ENABLE
+
+typedef CF_TraceState_t CF_TraceStateStamp_t;
+
+/**
+ * \brief Add an entry to the trace ring, see CF_Trace_Record()
+ */
+#define CF_TRACE(event, chan_num, seq_num, code, sub_code, offset, length) \
+    CF_Trace_Record((event), (chan_num), (seq_num), (code), (sub_code), (offset), (length))
+
+/**
+ * \brief Add an entry for a PDU to the trace ring, see CF_Trace_Pdu()
+ */
+#define CF_TRACE_PDU(event, chan_num, ph) CF_Trace_Pdu((event), (chan_num), (ph))
+
+/**
+ * \brief Save the state of a transaction before calling its state machine
+ */
+#define CF_TRACE_STATE_SAVE(saved, txn) CF_Trace_SaveState(&(saved), (txn))
+
+/**
+ * \brief Add an entry if the state machine changed the state saved by CF_TRACE_STATE_SAVE()
+ */
+#define CF_TRACE_STATE_CHECK(saved, txn) CF_Trace_CheckState(&(saved), (txn))
+
+#else /* CF_TRACE_ENABLE */
+
+typedef uint8 CF_TraceStateStamp_t;
+
+#define CF_TRACE(event, chan_num, seq_num, code, sub_code, offset, length) ((void)0)
+#define CF_TRACE_PDU(event, chan_num, ph)                                  ((void)0)
+#define CF_TRACE_STATE_SAVE(saved, txn)                                    ((saved) = 0)
+#define CF_TRACE_STATE_CHECK(saved, txn)                                   ((void)(saved))
+
+#endif /* CF_TRACE_ENABLE */
+
+/**\}*/
+
+/************************************************************************/
+/** @brief Add an entry to the trace ring.
+ *
+ * @par Description
+ *       Overwrites the oldest entry once the ring is full.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       Use CF_TRACE() rather than calling this directly, so that the
+ *       trace point compiles away when CF_TRACE_ENABLE is zero.
+ *
+ * @param event     Kind of entry
+ * @param chan_num  Channel number
+ * @param seq_num   Transaction sequence number
+ * @param code      Depends on event, see #CF_TraceEvent_t
+ * @param sub_code  Depends on event, see #CF_TraceEvent_t
+ * @param offset    File offset of file data, else 0
+ * @param length    Length of the PDU data field, or of file data, else 0
+ */
+void CF_Trace_Record(CF_TraceEvent_t event, uint8 chan_num, uint32 seq_num, uint8 code, uint8 sub_code, uint32 offset,
+                     uint16 length);
+
+/************************************************************************/
+/** @brief Add an entry for a PDU to the trace ring.
+ *
+ * @par Description
+ *       The code is the directive code, or 0 for file data. File data
+ *       entries also record the file offset and data length, directives
+ *       the encoded length of the data field.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       ph must not be NULL. For received file data, the file data header
+ *       must already be decoded.
+ *
+ * @param event     #CF_TraceEvent_PDU_TX or #CF_TraceEvent_PDU_RX
+ * @param chan_num  Channel number
+ * @param ph        PDU sent or received
+ */
+void CF_Trace_Pdu(CF_TraceEvent_t event, uint8 chan_num, const CF_Logical_PduBuffer_t *ph);
+
+/************************************************************************/
+/** @brief Save the state of a transaction.
+ *
+ * @par Description
+ *       The sequence number is saved as well, since the transaction may
+ *       give up its history before the state is checked.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       saved and txn must not be NULL.
+ *
+ * @param saved  Set to the current state
+ * @param txn    Transaction
+ */
+void CF_Trace_SaveState(CF_TraceState_t *saved, const CF_Transaction_t *txn);
+
+/************************************************************************/
+/** @brief Add an entry if the state of a transaction has changed.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       saved and txn must not be NULL.
+ *
+ * @param saved  State from CF_Trace_SaveState()
+ * @param txn    Transaction
+ */
+void CF_Trace_CheckState(const CF_TraceState_t *saved, const CF_Transaction_t *txn);
+
+/************************************************************************/
+/** @brief Start dumping the trace ring to a file.
+ *
+ * @par Description
+ *       Opens the file and writes the file header. The entries in the ring
+ *       at this point are written by CF_Trace_DumpCycle() over the
+ *       following wakeups, while tracing carries on.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       filename must not be NULL.
+ *
+ * @param filename  File to write
+ *
+ * @retval CFE_SUCCESS if the dump was started
+ * @retval CF_ERROR if a dump is already in progress, or the file could not be written
+ */
+CFE_Status_t CF_Trace_StartDump(const char *filename);
+
+/************************************************************************/
+/** @brief Write the next part of a trace dump.
+ *
+ * @par Description
+ *       Writes up to CF_TRACE_DUMP_ENTRIES_PER_WAKEUP entries, and closes
+ *       the file once every entry that was in the ring when the dump
+ *       started has been written, or skipped because it was overwritten.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       Called once per wakeup. Does nothing when no dump is in progress.
+ */
+void CF_Trace_DumpCycle(void);
+
+#endif /* !CF_TRACE_H */
@@ -0,0 +1,188 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ *  The CF Application UDP transport source file
+ *
+ *  Each PDU is sent as a single UDP datagram with no encapsulation, to
+ *  a peer address and port set per channel in the configuration table.
+ *  This allows CF to move PDUs without the software bus, for example in
+ *  a ground system or between two CF instances on the same host.
+ */
+
+#include "cfe.h"
+#include "cf_verify.h"
+#include "cf_app.h"
+#include "cf_events.h"
+#include "cf_udpintf.h"
+#include "cf_assert.h"
+
+#include <string.h>
+
+/**
+ * @brief The UDP transport
+ */
+const CF_Transport_t CF_Transport_Udp = {.GetBuffer     = CF_UdpIntf_GetBuffer,
+                                         .ReleaseBuffer = CF_UdpIntf_ReleaseBuffer,
+                                         .Send          = CF_UdpIntf_Send,
+                                         .ReceiveBatch  = CF_UdpIntf_ReceiveBatch};
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_udpintf.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_UdpIntf_Open(uint8 chan_num)
+{
+    const CF_ChannelConfig_t *cc  = &CF_AppData.config_table->chan[chan_num];
+    CF_UdpIntf_t *            udp = &CF_AppData.engine.udp;
+    OS_SockAddr_t             local_addr;
+    int32                     ret;
+
+    ret = OS_SocketOpen(&udp->sock_id[chan_num], OS_SocketDomain_INET, OS_SocketType_DATAGRAM);
+    if (ret == OS_SUCCESS)
+    {
+        ret = OS_SocketAddrInit(&local_addr, OS_SocketDomain_INET);
+    }
+    if (ret == OS_SUCCESS)
+    {
+        ret = OS_SocketAddrSetPort(&local_addr, cc->udp_local_port);
+    }
+    if (ret == OS_SUCCESS)
+    {
+        ret = OS_SocketBind(udp->sock_id[chan_num], &local_addr);
+    }
+    if (ret == OS_SUCCESS)
+    {
+        ret = OS_SocketAddrInit(&udp->peer_addr[chan_num], OS_SocketDomain_INET);
+    }
+    if (ret == OS_SUCCESS)
+    {
+        ret = OS_SocketAddrFromString(&udp->peer_addr[chan_num], cc->udp_peer_addr);
+    }
+    if (ret == OS_SUCCESS)
+    {
+        ret = OS_SocketAddrSetPort(&udp->peer_addr[chan_num], cc->udp_peer_port);
+    }
+
+    if (ret != OS_SUCCESS)
+    {
+        CFE_EVS_SendEvent(CF_INIT_UDP_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "CF: failed to open UDP port %u to %s:%u on channel %d, error=%ld",
+                          (unsigned int)cc->udp_local_port, cc->udp_peer_addr, (unsigned int)cc->udp_peer_port,
+                          chan_num, (long)ret);
+        CF_UdpIntf_Close(chan_num);
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_udpintf.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_UdpIntf_Close(uint8 chan_num)
+{
+    CF_UdpIntf_t *udp = &CF_AppData.engine.udp;
+
+    if (OS_ObjectIdDefined(udp->sock_id[chan_num]))
+    {
+        OS_close(udp->sock_id[chan_num]);
+        udp->sock_id[chan_num] = OS_OBJECT_ID_UNDEFINED;
+    }
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_udpintf.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void *CF_UdpIntf_GetBuffer(uint8 chan_num, size_t *encap_hdr_size)
+{
+    *encap_hdr_size = 0;
+
+    return CF_AppData.engine.udp.tx_buf;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_udpintf.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_UdpIntf_ReleaseBuffer(uint8 chan_num, void *buf)
+{
+    /* nothing to do, there is only the one static buffer */
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_udpintf.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_UdpIntf_Send(uint8 chan_num, void *buf, size_t pdu_size)
+{
+    CF_UdpIntf_t *udp = &CF_AppData.engine.udp;
+
+    /* as with SB, a PDU lost here is recovered by the protocol (class 2) or not at all (class 1) */
+    OS_SocketSendTo(udp->sock_id[chan_num], buf, pdu_size, &udp->peer_addr[chan_num]);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_udpintf.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+uint32 CF_UdpIntf_ReceiveBatch(uint8 chan_num, CF_TransportRxMsg_t *msgs, uint32 max_msgs)
+{
+    CF_UdpIntf_t *udp   = &CF_AppData.engine.udp;
+    CF_Input_t *  in    = &CF_AppData.engine.in;
+    uint32        count = 0;
+    OS_SockAddr_t remote_addr;
+    int32         status;
+
+    CF_Assert(max_msgs <= CF_TRANSPORT_RX_BATCH_SIZE);
+
+    if (OS_ObjectIdDefined(udp->sock_id[chan_num]))
+    {
+        for (; count < max_msgs; ++count)
+        {
+            status = OS_SocketRecvFrom(udp->sock_id[chan_num], in->rx_buf[count], sizeof(in->rx_buf[count]),
+                                       &remote_addr, OS_CHECK);
+            if (status <= 0)
+            {
+                break; /* nothing more waiting */
+            }
+
+            msgs[count].buf            = in->rx_buf[count];
+            msgs[count].encap_hdr_size = 0;
+            msgs[count].total_size     = status;
+        }
+    }
+
+    return count;
+}
@@ -0,0 +1,119 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ *  The CF Application UDP transport header file
+ */
+
+#ifndef CF_UDPINTF_H
+#define CF_UDPINTF_H
+
+#include "cfe.h"
+#include "cf_cfdp_types.h"
+
+/**
+ * @brief The UDP transport
+ */
+extern const CF_Transport_t CF_Transport_Udp;
+
+/************************************************************************/
+/** @brief Open and bind the UDP socket for a channel.
+ *
+ * @par Description
+ *       The socket is bound to udp_local_port from the channel
+ *       configuration, and PDUs are sent to udp_peer_addr and
+ *       udp_peer_port.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       chan_num must be less than CF_NUM_CHANNELS.
+ *
+ * @param chan_num Channel number
+ *
+ * @returns OSAL status code
+ * @retval  OS_SUCCESS on success
+ */
+CFE_Status_t CF_UdpIntf_Open(uint8 chan_num);
+
+/************************************************************************/
+/** @brief Close the UDP socket for a channel, if it is open.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       chan_num must be less than CF_NUM_CHANNELS.
+ *
+ * @param chan_num Channel number
+ */
+void CF_UdpIntf_Close(uint8 chan_num);
+
+/************************************************************************/
+/** @brief Get the buffer to encode an outgoing PDU into.
+ *
+ * @par Description
+ *       There is no encapsulation, the PDU is the whole datagram.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       encap_hdr_size must not be NULL.
+ *
+ * @param chan_num       Channel number, not used
+ * @param encap_hdr_size Output: always 0
+ *
+ * @returns Pointer to the buffer, never NULL
+ */
+void *CF_UdpIntf_GetBuffer(uint8 chan_num, size_t *encap_hdr_size);
+
+/************************************************************************/
+/** @brief Give back the outgoing buffer without sending it.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       Nothing to do, the buffer is static.
+ *
+ * @param chan_num Channel number, not used
+ * @param buf      Buffer from CF_UdpIntf_GetBuffer(), not used
+ */
+void CF_UdpIntf_ReleaseBuffer(uint8 chan_num, void *buf);
+
+/************************************************************************/
+/** @brief Send a PDU as a datagram to the channel's peer.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       buf must be from CF_UdpIntf_GetBuffer().
+ *
+ * @param chan_num Channel number
+ * @param buf      Buffer holding the PDU
+ * @param pdu_size Size of the encoded PDU
+ */
+void CF_UdpIntf_Send(uint8 chan_num, void *buf, size_t pdu_size);
+
+/************************************************************************/
+/** @brief Receive the datagrams already waiting on the channel's socket.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       msgs must have room for max_msgs entries, and max_msgs must
+ *       not be more than CF_TRANSPORT_RX_BATCH_SIZE.
+ *
+ * @param chan_num Channel number
+ * @param msgs     Output: received messages
+ * @param max_msgs Maximum number of messages to return
+ *
+ * @returns Number of messages returned, 0 if nothing is waiting
+ */
+uint32 CF_UdpIntf_ReceiveBatch(uint8 chan_num, CF_TransportRxMsg_t *msgs, uint32 max_msgs);
+
+#endif /* !CF_UDPINTF_H */
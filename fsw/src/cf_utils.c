@@ -31,6 +31,8 @@
 #include "cf_utils.h"
 #include "cf_events.h"
 #include "cf_perfids.h"
+#include "cf_filestore.h"
+#include "cf_instr.h"
 
 #include "cf_assert.h"
 
@@ -70,6 +72,11 @@ CF_Transaction_t *CF_FindUnusedTransaction(CF_Channel_t *chan)
         txn->history      = container_of(chan->qs[q_index], CF_History_t, cl_node);
         txn->history->dir = CF_Direction_NUM; /* start with no direction */
 
+        /* start a fresh performance record; a reused slot still holds the previous one */
+        memset(&txn->history->perf, 0, sizeof(txn->history->perf));
+        txn->history->perf.start_time = CFE_TIME_GetTime();
+        txn->history->waiting         = false;
+
         CF_CList_Remove_Ex(chan, q_index, &txn->history->cl_node);
 
         return txn;
@@ -104,6 +111,7 @@ void CF_FreeTransaction(CF_Transaction_t *txn)
     memset(txn, 0, sizeof(*txn));
     txn->flags.com.q_index = CF_QueueIdx_FREE;
     txn->fd                = OS_OBJECT_ID_UNDEFINED;
+    txn->zfd               = OS_OBJECT_ID_UNDEFINED;
     txn->chan_num          = chan;
     txn->state             = CF_TxnState_IDLE; /* NOTE: this is redundant as long as CF_TxnState_IDLE == 0 */
     CF_CList_InitNode(&txn->cl_node);
@@ -178,7 +186,7 @@ CFE_Status_t CF_WriteHistoryEntryToFile(osal_id_t fd, const CF_History_t *histor
     size_t       len;
     char         linebuf[(CF_FILENAME_MAX_LEN * 2) + 128]; /* buffer for line data */
 
-    for (i = 0; i < 3; ++i)
+    for (i = 0; i < 4; ++i)
     {
         switch (i)
         {
@@ -194,9 +202,20 @@ CFE_Status_t CF_WriteHistoryEntryToFile(osal_id_t fd, const CF_History_t *histor
                 snprintf(linebuf, sizeof(linebuf), "SRC: %s\t", history->fnames.src_filename);
                 break;
             case 2:
+                /* SAD: No need to check snprintf return; buffer size is sufficient for the formatted output */
+                snprintf(linebuf, sizeof(linebuf), "DST: %s\t", history->fnames.dst_filename);
+                break;
+            case 3:
             default:
                 /* SAD: No need to check snprintf return; buffer size is sufficient for the formatted output */
-                snprintf(linebuf, sizeof(linebuf), "DST: %s\n", history->fnames.dst_filename);
+                snprintf(linebuf, sizeof(linebuf),
+                         "PERF: START %lu END %lu BYTES %lu RETX %lu NAK %lu/%lu PDU %lu/%lu WAIT %lu IO %lu CRC %lu\n",
+                         (unsigned long)history->perf.start_time.Seconds,
+                         (unsigned long)history->perf.end_time.Seconds, (unsigned long)history->perf.file_bytes,
+                         (unsigned long)history->perf.retx_bytes, (unsigned long)history->perf.nak_rounds,
+                         (unsigned long)history->perf.nak_segments, (unsigned long)history->perf.pdus_sent,
+                         (unsigned long)history->perf.pdus_recv, (unsigned long)history->perf.wait_usec,
+                         (unsigned long)history->perf.io_usec, (unsigned long)history->perf.crc_usec);
                 break;
         }
 
@@ -423,7 +442,7 @@ CFE_Status_t CF_WrappedOpenCreate(osal_id_t *fd, const char *fname, int32 flags,
     CFE_Status_t ret;
 
     CFE_ES_PerfLogEntry(CF_PERF_ID_FOPEN);
-    ret = OS_OpenCreate(fd, fname, flags, access);
+    ret = CF_Filestore_FromPath(fname)->OpenCreate(fd, fname, flags, access);
     CFE_ES_PerfLogExit(CF_PERF_ID_FOPEN);
     return ret;
 }
@@ -439,7 +458,7 @@ void CF_WrappedClose(osal_id_t fd)
     int32 ret;
 
     CFE_ES_PerfLogEntry(CF_PERF_ID_FCLOSE);
-    ret = OS_close(fd);
+    ret = CF_Filestore_FromFd(fd)->Close(fd);
     CFE_ES_PerfLogExit(CF_PERF_ID_FCLOSE);
 
     if (ret != OS_SUCCESS)
@@ -457,10 +476,13 @@ void CF_WrappedClose(osal_id_t fd)
  *-----------------------------------------------------------------*/
 CFE_Status_t CF_WrappedRead(osal_id_t fd, void *buf, size_t read_size)
 {
-    CFE_Status_t ret;
+    CFE_Status_t    ret;
+    CF_InstrStamp_t stamp;
 
     CFE_ES_PerfLogEntry(CF_PERF_ID_FREAD);
-    ret = OS_read(fd, buf, read_size);
+    CF_INSTR_START(stamp);
+    ret = CF_Filestore_FromFd(fd)->Read(fd, buf, read_size);
+    CF_INSTR_RECORD(CF_InstrHist_FREAD, stamp);
     CFE_ES_PerfLogExit(CF_PERF_ID_FREAD);
     return ret;
 }
@@ -473,10 +495,13 @@ CFE_Status_t CF_WrappedRead(osal_id_t fd, void *buf, size_t read_size)
  *-----------------------------------------------------------------*/
 CFE_Status_t CF_WrappedWrite(osal_id_t fd, const void *buf, size_t write_size)
 {
-    CFE_Status_t ret;
+    CFE_Status_t    ret;
+    CF_InstrStamp_t stamp;
 
     CFE_ES_PerfLogEntry(CF_PERF_ID_FWRITE);
-    ret = OS_write(fd, buf, write_size);
+    CF_INSTR_START(stamp);
+    ret = CF_Filestore_FromFd(fd)->Write(fd, buf, write_size);
+    CF_INSTR_RECORD(CF_InstrHist_FWRITE, stamp);
     CFE_ES_PerfLogExit(CF_PERF_ID_FWRITE);
     return ret;
 }
@@ -489,13 +514,140 @@ CFE_Status_t CF_WrappedWrite(osal_id_t fd, const void *buf, size_t write_size)
  *-----------------------------------------------------------------*/
 CFE_Status_t CF_WrappedLseek(osal_id_t fd, off_t offset, int mode)
 {
-    CFE_Status_t ret;
+    CFE_Status_t    ret;
+    CF_InstrStamp_t stamp;
+
     CFE_ES_PerfLogEntry(CF_PERF_ID_FSEEK);
-    ret = OS_lseek(fd, offset, mode);
+    CF_INSTR_START(stamp);
+    ret = CF_Filestore_FromFd(fd)->Lseek(fd, offset, mode);
+    CF_INSTR_RECORD(CF_InstrHist_FSEEK, stamp);
     CFE_ES_PerfLogExit(CF_PERF_ID_FSEEK);
     return ret;
 }
 
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_utils.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_WrappedRemove(const char *fname)
+{
+    return CF_Filestore_FromPath(fname)->Remove(fname);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Internal helper routine only, not part of API.
+ *
+ *-----------------------------------------------------------------*/
+static CFE_Status_t CF_CopyFile(const char *src_filename, const char *dst_filename)
+{
+    osal_id_t    src_fd = OS_OBJECT_ID_UNDEFINED;
+    osal_id_t    dst_fd = OS_OBJECT_ID_UNDEFINED;
+    uint8        buf[CF_R2_CRC_CHUNK_SIZE];
+    CFE_Status_t ret;
+    int32        wret;
+
+    ret = CF_WrappedOpenCreate(&src_fd, src_filename, OS_FILE_FLAG_NONE, OS_READ_ONLY);
+    if (ret >= 0)
+    {
+        ret = CF_WrappedOpenCreate(&dst_fd, dst_filename, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY);
+        if (ret >= 0)
+        {
+            do
+            {
+                ret = CF_WrappedRead(src_fd, buf, sizeof(buf));
+                if (ret > 0)
+                {
+                    wret = CF_WrappedWrite(dst_fd, buf, ret);
+                    if (wret != ret)
+                    {
+                        ret = OS_ERROR; /* short write, destination is full */
+                    }
+                }
+            } while (ret > 0);
+
+            CF_WrappedClose(dst_fd);
+
+            if (ret != OS_SUCCESS)
+            {
+                CF_WrappedRemove(dst_filename);
+            }
+        }
+
+        CF_WrappedClose(src_fd);
+    }
+
+    if (ret == OS_SUCCESS)
+    {
+        ret = CF_WrappedRemove(src_filename);
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_utils.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_WrappedRename(const char *old_filename, const char *new_filename)
+{
+    const CF_Filestore_t *store = CF_Filestore_FromPath(old_filename);
+    CFE_Status_t          ret;
+
+    if (store == CF_Filestore_FromPath(new_filename))
+    {
+        ret = store->Rename(old_filename, new_filename);
+    }
+    else
+    {
+        ret = CF_CopyFile(old_filename, new_filename);
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_utils.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+CFE_Status_t CF_WrappedStat(const char *path, os_fstat_t *filestats)
+{
+    return CF_Filestore_FromPath(path)->Stat(path, filestats);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Application-scope internal function
+ * See description in cf_utils.h for argument/return detail
+ *
+ *-----------------------------------------------------------------*/
+void CF_AddElapsedUsec(uint32 *total, OS_time_t since)
+{
+    OS_time_t now;
+    int64     usec;
+
+    OS_GetLocalTime(&now);
+    usec = OS_TimeGetTotalMicroseconds(OS_TimeSubtract(now, since));
+
+    if (usec > 0)
+    {
+        if ((uint64)usec >= (UINT32_MAX - *total))
+        {
+            *total = UINT32_MAX;
+        }
+        else
+        {
+            *total += (uint32)usec;
+        }
+    }
+}
+
 /*----------------------------------------------------------------
  *
  * Function: CF_TxnStatus_IsError
@@ -474,6 +474,66 @@ CFE_Status_t CF_WrappedWrite(osal_id_t fd, const void *buf, size_t write_size);
  */
 CFE_Status_t CF_WrappedLseek(osal_id_t fd, off_t offset, int mode);
 
+/************************************************************************/
+/** @brief Remove a file from whichever filestore holds it.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       fname must not be NULL.
+ *
+ * @sa OS_remove() for parameter descriptions
+ *
+ * @param fname      Passed directly to underlying filestore call
+ *
+ * @returns Status code from the filestore
+ */
+CFE_Status_t CF_WrappedRemove(const char *fname);
+
+/************************************************************************/
+/** @brief Rename a file, moving it between filestores if needed.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       old_filename and new_filename must not be NULL. When both names
+ *       are served by the same filestore this is that filestore's rename.
+ *       Otherwise the file is copied to new_filename and then removed from
+ *       old_filename; on failure a partial copy is removed and the original
+ *       is kept.
+ *
+ * @sa OS_mv() for parameter descriptions
+ *
+ * @param old_filename  Current file name
+ * @param new_filename  New file name
+ *
+ * @returns Status code from the filestore
+ */
+CFE_Status_t CF_WrappedRename(const char *old_filename, const char *new_filename);
+
+/************************************************************************/
+/** @brief Get file information from whichever filestore holds it.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       path and filestats must not be NULL.
+ *
+ * @sa OS_stat() for parameter descriptions
+ *
+ * @param path       Passed directly to underlying filestore call
+ * @param filestats  Passed directly to underlying filestore call
+ *
+ * @returns Status code from the filestore
+ */
+CFE_Status_t CF_WrappedStat(const char *path, os_fstat_t *filestats);
+
+/************************************************************************/
+/** @brief Add the microseconds elapsed since a start time to a running total.
+ *
+ * @par Assumptions, External Events, and Notes:
+ *       total must not be NULL.  The total saturates at UINT32_MAX rather
+ *       than wrapping, and a start time in the future adds nothing.
+ *
+ * @param total      Running total in microseconds to add to
+ * @param since      Local time at which the measured interval started
+ */
+void CF_AddElapsedUsec(uint32 *total, OS_time_t since);
+
 /************************************************************************/
 /** @brief Converts the internal transaction status to a CFDP condition code
  *
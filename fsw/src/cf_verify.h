@@ -43,6 +43,86 @@
 #error refactor code for 32 bit CF_NUM_HISTORIES
 #endif
 
+#if CF_NUM_RX_STAGING_BUFFERS == 0
+#error Must have at least one rx staging buffer, disable staging in the channel configuration instead.
+#endif
+
+#if CF_TRANSPORT_RX_BATCH_SIZE < 1
+#error CF_TRANSPORT_RX_BATCH_SIZE must be at least 1.
+#endif
+
+#if CF_EVENT_POLL_TIMEOUT < 1 || CF_EVENT_POLL_TIMEOUT > CF_RCVMSG_TIMEOUT
+#error CF_EVENT_POLL_TIMEOUT must be between 1 and CF_RCVMSG_TIMEOUT.
+#endif
+
+#if CF_INSTR_NUM_BUCKETS < 2 || CF_INSTR_NUM_BUCKETS > 15
+#error CF_INSTR_NUM_BUCKETS must be between 2 and 15.
+#endif
+
+#if CF_TRACE_RING_ENTRIES == 0 || (CF_TRACE_RING_ENTRIES & (CF_TRACE_RING_ENTRIES - 1)) != 0
+#error CF_TRACE_RING_ENTRIES must be a power of two.
+#endif
+
+#if CF_TRACE_DUMP_ENTRIES_PER_WAKEUP < 1
+#error CF_TRACE_DUMP_ENTRIES_PER_WAKEUP must be at least 1.
+#endif
+
+#if CF_EVENT_AGG_INTERVAL_S < 1
+#error CF_EVENT_AGG_INTERVAL_S must be at least 1.
+#endif
+
+#if CF_CHECKPOINT_WRITES_PER_WAKEUP < 1
+#error CF_CHECKPOINT_WRITES_PER_WAKEUP must be at least 1.
+#endif
+
+#if CF_NUM_FANOUT_GROUPS < 1 || CF_FANOUT_CACHE_BLOCKS < 1
+#error CF_NUM_FANOUT_GROUPS and CF_FANOUT_CACHE_BLOCKS must be at least 1.
+#endif
+
+#if CF_TX_MULTI_MAX_DEST < 1
+#error CF_TX_MULTI_MAX_DEST must be at least 1.
+#endif
+
+#if CF_DELIVERED_INDEX_ENTRIES < 1
+#error CF_DELIVERED_INDEX_ENTRIES must be at least 1.
+#endif
+
+#if CF_COMPRESS_BLOCK_SIZE < 64 || CF_COMPRESS_BLOCK_SIZE > 32768
+#error CF_COMPRESS_BLOCK_SIZE must be between 64 and 32768.
+#endif
+
+#if CF_FLOW_PEER_IDLE_CYCLES < 1
+#error CF_FLOW_PEER_IDLE_CYCLES must be greater than 0.
+#endif
+
+#if CF_DELTA_BLOCK_SIZE < 64 || CF_DELTA_BLOCK_SIZE > 32768
+#error CF_DELTA_BLOCK_SIZE must be between 64 and 32768.
+#endif
+
+#if CF_DELTA_MAX_BLOCKS < 1 || CF_DELTA_MAX_BLOCKS > 65535
+#error CF_DELTA_MAX_BLOCKS must be between 1 and 65535.
+#endif
+
+#if CF_BUNDLE_MAX_FILES < 2
+#error CF_BUNDLE_MAX_FILES must be at least 2.
+#endif
+
+#if CF_NUM_TX_PREFETCH_BUFFERS < 1
+#error CF_NUM_TX_PREFETCH_BUFFERS must be at least 1.
+#endif
+
+#if CF_NUM_TRANSACTIONS_PER_PLAYBACK < 1 || CF_NUM_TRANSACTIONS_PER_PLAYBACK > 255
+#error CF_NUM_TRANSACTIONS_PER_PLAYBACK must be between 1 and 255.
+#endif
+
+#if CF_PLAYBACK_WORK_LIST_SIZE < 1 || CF_PLAYBACK_WORK_LIST_SIZE > 65535
+#error CF_PLAYBACK_WORK_LIST_SIZE must be between 1 and 65535.
+#endif
+
+#if CF_PLAYBACK_ORDER_LIST_SIZE < CF_PLAYBACK_WORK_LIST_SIZE || CF_PLAYBACK_ORDER_LIST_SIZE > 65535
+#error CF_PLAYBACK_ORDER_LIST_SIZE must be between CF_PLAYBACK_WORK_LIST_SIZE and 65535.
+#endif
+
 #if (CF_PERF_ID_PDURCVD(CF_NUM_CHANNELS - 1) >= CF_PERF_ID_PDUSENT(0))
 #error Collision between CF_PERF_ID_PDURCVD and CF_PERF_ID_PDUSENT given number of channels
 #endif
@@ -28,15 +28,24 @@
 CF_ConfigTable_t CF_config_table = {
     10,    /* ticks_per_second */
     16384, /* max number of bytes per wakeup to calculate r2 recv file CRC */
+    0,     /* max microseconds of engine work per wakeup, 0 means unlimited */
     25,    /* local entity id */
     {      /* channel configuration for CF_NUM_CHANNELS */
      {
          /* channel 0 */
          5,      /* max number of outgoing messages per wakeup */
          5,      /* max number of rx messages per wakeup */
+         0,      /* adaptive max rx messages per wakeup, 0 means not adaptive */
+         0,      /* max microseconds receiving per wakeup, 0 means unlimited */
          3,      /* ACK timer */
          3,      /* NAK timer */
          30,     /* inactivity timer */
+         0,      /* prompt (NAK) every this many file bytes, 0 means never */
+         0,      /* prompt (NAK) interval seconds, 0 means never */
+         0,      /* keep alive interval seconds, 0 means never */
+         0,      /* bundle files up to this size, 0 means never */
+         65536,  /* most bytes of file data in one bundle */
+         10,     /* followed file quiet seconds before its EOF */
          4,      /* ACK limit */
          4,      /* NAK limit */
          0x18c8, /* input message id */
@@ -45,27 +54,49 @@ CF_ConfigTable_t CF_config_table = {
          {       /* polling directory configuration for CF_MAX_POLLING_DIR_PER_CHAN */
           {
               /* polling directory 0 */
-              5,               /* interval seconds */
-              25,              /* priority */
-              CF_CFDP_CLASS_2, /* class to send */
-              23,              /* destination entity id */
-              "/cf/poll_dir",  /* source directory */
-              "./poll_dir",    /* destination directory */
-              0                /* polling directory enable flag (1 = enabled) */
+              5,                    /* interval seconds */
+              25,                   /* priority */
+              CF_CFDP_CLASS_2,      /* class to send */
+              23,                   /* destination entity id */
+              "/cf/poll_dir",       /* source directory */
+              "./poll_dir",         /* destination directory */
+              0,                    /* polling directory enable flag (1 = enabled) */
+              0,                    /* most files sent at once, 0 means CF_NUM_TRANSACTIONS_PER_PLAYBACK */
+              CF_PlaybackOrder_NAME /* order files are sent in */
           },
           {
               0 /* zero fill unused polling directory slots */
           }},
          "",            /* throttle sem, empty string means no throttle */
          1,             /* dequeue enable flag (1 = enabled) */
+         0,             /* rx staging enable flag (1 = enabled) */
+         0,             /* event-driven rx flag (1 = enabled) */
+         0,             /* retain partial rx files flag (1 = enabled) */
+         0,             /* trim retransmits on keep alive flag (1 = enabled) */
+         0,             /* skip files already delivered flag (1 = enabled) */
+         0,             /* compress file data flag (1 = enabled) */
+         0,             /* delta against last delivered file flag (1 = enabled) */
+         0,             /* pending sends to open and read ahead, 0 means none */
+         32,            /* playback directory entries read per wakeup, 0 means unlimited */
+         0,             /* UDP local port, 0 means use SB */
+         0,             /* UDP peer port */
+         "",            /* UDP peer address */
          .move_dir = "" /* If not empty, will attempt move instead of delete on TX file complete */
      },
      {        /* channel 1 */
       5,      /* max number of outgoing messages per wakeup */
       5,      /* max number of rx messages per wakeup */
+      0,      /* adaptive max rx messages per wakeup, 0 means not adaptive */
+      0,      /* max microseconds receiving per wakeup, 0 means unlimited */
       3,      /* ack timer */
       3,      /* nak timer */
       30,     /* inactivity timer */
+      0,      /* prompt (NAK) every this many file bytes, 0 means never */
+      0,      /* prompt (NAK) interval seconds, 0 means never */
+      0,      /* keep alive interval seconds, 0 means never */
+      0,      /* bundle files up to this size, 0 means never */
+      65536,  /* most bytes of file data in one bundle */
+      10,     /* followed file quiet seconds before its EOF */
       4,      /* ack limit */
       4,      /* nak limit */
       0x18c9, /* input message id */
@@ -77,6 +108,18 @@ CF_ConfigTable_t CF_config_table = {
        }},
       "", /* throttle sem, empty string means no throttle */
       1,  /* dequeue enable flag (1 = enabled) */
+      0,  /* rx staging enable flag (1 = enabled) */
+      0,  /* event-driven rx flag (1 = enabled) */
+      0,  /* retain partial rx files flag (1 = enabled) */
+      0,  /* trim retransmits on keep alive flag (1 = enabled) */
+      0,  /* skip files already delivered flag (1 = enabled) */
+      0,  /* compress file data flag (1 = enabled) */
+      0,  /* delta against last delivered file flag (1 = enabled) */
+      0,  /* pending sends to open and read ahead, 0 means none */
+      32, /* playback directory entries read per wakeup, 0 means unlimited */
+      0,  /* UDP local port, 0 means use SB */
+      0,  /* UDP peer port */
+      "", /* UDP peer address */
       .move_dir = ""}},
     480,       /* outgoing_file_chunk_size */
     "/cf/tmp", /* temporary file directory */
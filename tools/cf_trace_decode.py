@@ -0,0 +1,125 @@
+#!/usr/bin/env python3
+#
+# NASA Docket No. GSC-18,447-1, and identified as "CFS CFDP (CF)
+# Application version 3.0.0"
+#
+# Copyright (c) 2019 United States Government as represented by the
+# Administrator of the National Aeronautics and Space Administration.
+# All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may
+# not use this file except in compliance with the License. You may obtain
+# a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+"""Decode a CF trace dump written by the CF_WRITE_TRACE_CC command.
+
+The file layout is CF_TraceFileHeader_t followed by CF_TraceEntry_t
+records, see fsw/src/cf_trace.h. Both are written in the byte order of
+the flight processor, which is worked out from the magic number.
+
+usage: cf_trace_decode.py [--relative] trace.bin
+"""
+
+import argparse
+import struct
+import sys
+
+TRACE_FILE_MAGIC = 0x43465452
+TRACE_FILE_VERSION = 1
+
+HEADER_FORMAT = "IHHII"
+ENTRY_FORMAT = "IIIIHBBBB2x"
+
+EVENTS = {1: "PDU_TX", 2: "PDU_RX", 3: "STATE", 4: "TIMER", 5: "STALL"}
+
+# CF_CFDP_FileDirective_t
+DIRECTIVES = {0: "FD", 4: "EOF", 5: "FIN", 6: "ACK", 7: "MD", 8: "NAK", 9: "PROMPT", 12: "KEEP_ALIVE"}
+
+# CF_TxnState_t
+STATES = {0: "IDLE", 1: "R1", 2: "S1", 3: "R2", 4: "S2", 5: "DROP"}
+
+# CF_TxSubState_t and CF_RxSubState_t
+TX_SUB_STATES = {0: "METADATA", 1: "FILEDATA", 2: "EOF", 3: "WAIT_FOR_EOF_ACK", 4: "WAIT_FOR_FIN", 5: "SEND_FIN_ACK"}
+RX_SUB_STATES = {0: "FILEDATA", 1: "EOF", 2: "WAIT_FOR_FIN_ACK"}
+
+TIMERS = {1: "ACK", 2: "INACTIVITY"}
+STALLS = {1: "NO_BUF", 2: "FLOW", 3: "FOLLOW"}
+
+
+def describe(event, code, sub_code, offset, length):
+    """Return the event specific part of a timeline line"""
+    if event in (1, 2):
+        name = DIRECTIVES.get(code, "DIR_%d" % code)
+        if code == 0:
+            return "%-10s offset=%u len=%u" % (name, offset, length)
+        return "%-10s len=%u" % (name, length)
+    if event == 3:
+        state = STATES.get(code, "STATE_%d" % code)
+        if state in ("S1", "S2"):
+            sub = TX_SUB_STATES.get(sub_code, str(sub_code))
+        elif state in ("R1", "R2"):
+            sub = RX_SUB_STATES.get(sub_code, str(sub_code))
+        else:
+            sub = ""
+        return "%s %s" % (state, sub)
+    if event == 4:
+        return TIMERS.get(code, "TIMER_%d" % code)
+    if event == 5:
+        if code == 2:
+            return "%s offset=%u" % (STALLS[code], offset)
+        return STALLS.get(code, "STALL_%d" % code)
+    return "code=%u sub_code=%u offset=%u len=%u" % (code, sub_code, offset, length)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode a CF trace dump into a timeline")
+    parser.add_argument("file", help="trace dump file")
+    parser.add_argument("--relative", action="store_true", help="print times relative to the first entry")
+    args = parser.parse_args()
+
+    with open(args.file, "rb") as f:
+        data = f.read()
+
+    for order in ("<", ">"):
+        if struct.unpack_from(order + "I", data, 0)[0] == TRACE_FILE_MAGIC:
+            break
+    else:
+        sys.exit("%s: not a CF trace dump" % args.file)
+
+    magic, version, entry_size, count, first = struct.unpack_from(order + HEADER_FORMAT, data, 0)
+    if version != TRACE_FILE_VERSION:
+        sys.exit("%s: unsupported trace version %d" % (args.file, version))
+    if entry_size != struct.calcsize(order + ENTRY_FORMAT):
+        sys.exit("%s: unexpected entry size %d" % (args.file, entry_size))
+
+    pos = struct.calcsize(order + HEADER_FORMAT)
+    avail = (len(data) - pos) // entry_size
+    print("# %u entries in the ring from index %u, %u in file" % (count, first, avail))
+
+    start = None
+    for i in range(avail):
+        sec, usec, seq_num, offset, length, event, chan_num, code, sub_code = struct.unpack_from(
+            order + ENTRY_FORMAT, data, pos + i * entry_size)
+        stamp = sec * 1000000 + usec
+        if start is None:
+            start = stamp
+        if args.relative:
+            when = "%+.6f" % ((stamp - start) / 1e6)
+        else:
+            when = "%u.%06u" % (sec, usec)
+        print("%s ch=%u seq=%-6u %-6s %s" % (when, chan_num, seq_num, EVENTS.get(event, str(event)),
+                                             describe(event, code, sub_code, offset, length)))
+
+    if avail < count:
+        print("# %u entries were overwritten before they could be written" % (count - avail))
+
+
+if __name__ == "__main__":
+    main()
@@ -23,6 +23,7 @@
 #include "cf_dispatch.h"
 #include "cf_app.h"
 #include "cf_cmd.h"
+#include "cf_instr.h"
 
 /*******************************************************************************
 **
@@ -445,7 +446,7 @@ void Test_CF_AppInit_Success(void)
     UtAssert_INT32_EQ(CF_AppInit(), CFE_SUCCESS);
 
     /* Assert */
-    UtAssert_STUB_COUNT(CFE_MSG_Init, 1);
+    UtAssert_STUB_COUNT(CFE_MSG_Init, 1);    UtAssert_STUB_COUNT(CF_Instr_Init, 1);
 }
 
 /*******************************************************************************
@@ -518,6 +519,38 @@ void Test_CF_AppMain_CFE_SB_ReceiveBuffer_Cases(void)
     UtAssert_STUB_COUNT(CFE_ES_RunLoop, 3);
 }
 
+static int32 Ut_Hook_ReceiveBuffer_SaveTimeOut(void *UserObj, int32 StubRetcode, uint32 CallCount,
+                                               const UT_StubContext_t *Context)
+{
+    int32 *timeouts = UserObj;
+
+    if (CallCount < 2)
+    {
+        timeouts[CallCount] = UT_Hook_GetArgValueByName(Context, "TimeOut", int32);
+    }
+
+    return StubRetcode;
+}
+
+void Test_CF_AppMain_EventDriven(void)
+{
+    int32 timeouts[2] = {0, 0};
+
+    /* Run loop twice, a channel is event-driven after the first time */
+    UT_SetDeferredRetcode(UT_KEY(CFE_ES_RunLoop), 1, true);
+    UT_SetDeferredRetcode(UT_KEY(CFE_ES_RunLoop), 1, true);
+    UT_SetDefaultReturnValue(UT_KEY(CFE_ES_RunLoop), false);
+    UT_SetDefaultReturnValue(UT_KEY(CFE_SB_ReceiveBuffer), CFE_SB_TIME_OUT);
+    UT_SetDeferredRetcode(UT_KEY(CF_CFDP_ServiceInput), 1, true);
+    UT_SetHookFunction(UT_KEY(CFE_SB_ReceiveBuffer), Ut_Hook_ReceiveBuffer_SaveTimeOut, timeouts);
+
+    UtAssert_VOIDCALL(CF_AppMain());
+
+    UtAssert_STUB_COUNT(CF_CFDP_ServiceInput, 2);
+    UtAssert_INT32_EQ(timeouts[0], CF_RCVMSG_TIMEOUT);
+    UtAssert_INT32_EQ(timeouts[1], CF_EVENT_POLL_TIMEOUT);
+}
+
 void Test_CF_AppMain_RunLoopCallTo_CFE_SB_ReceiveBuffer_Returns_CFE_SUCCESS_AndValid_msg_Call_CF_AppPipe(void)
 {
     /* Arrange */
@@ -635,6 +668,7 @@ void add_CF_AppMain_tests(void)
         "ERROR");
     UtTest_Add(Test_CF_AppMain_CFE_SB_ReceiveBuffer_Cases, cf_app_tests_Setup, CF_App_Tests_Teardown,
                "Test_CF_AppMain_CFE_SB_ReceiveBuffer_Cases");
+    UtTest_Add(Test_CF_AppMain_EventDriven, cf_app_tests_Setup, CF_App_Tests_Teardown, "Test_CF_AppMain_EventDriven");
     UtTest_Add(Test_CF_AppMain_RunLoopCallTo_CFE_SB_ReceiveBuffer_Returns_CFE_SUCCESS_AndValid_msg_Call_CF_AppPipe,
                cf_app_tests_Setup, CF_App_Tests_Teardown,
                "Test_CF_AppMain_RunLoopCallTo_CFE_SB_ReceiveBuffer_Returns_CFE_SUCCESS_AndValid_msg_Call_CF_AppPipe");
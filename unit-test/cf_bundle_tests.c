@@ -0,0 +1,395 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* cf testing includes */
+#include "cf_test_utils.h"
+#include "cf_bundle.h"
+
+/*******************************************************************************
+**
+**  cf_bundle_tests local utility functions
+**
+*******************************************************************************/
+
+#define UT_CF_BUNDLE_SRC_SIZE (1500)
+
+static CF_Bundle_t      UT_CF_Bundle_Work;
+static CF_ConfigTable_t UT_CF_Bundle_Config;
+static uint8            UT_CF_Bundle_Src[UT_CF_BUNDLE_SRC_SIZE];
+static uint32           UT_CF_Bundle_SrcPos;
+static uint8            UT_CF_Bundle_Image[4 * UT_CF_BUNDLE_SRC_SIZE];
+static uint32           UT_CF_Bundle_ImageLen;
+
+/* a write appended to the bundle file image, or the status code if set */
+static void UT_AltHandler_CF_WrappedWrite_Image(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    const void * buf    = UT_Hook_GetArgValueByName(Context, "buf", const void *);
+    CFE_Status_t retval = (CFE_Status_t)UT_Hook_GetArgValueByName(Context, "write_size", size_t);
+    int32        status_code;
+
+    if (UT_Stub_GetInt32StatusCode(Context, &status_code))
+    {
+        retval = status_code;
+    }
+    else
+    {
+        memcpy(&UT_CF_Bundle_Image[UT_CF_Bundle_ImageLen], buf, retval);
+        UT_CF_Bundle_ImageLen += retval;
+    }
+    UT_Stub_SetReturnValue(FuncKey, retval);
+}
+
+/* a read of the next bytes of the source file image, or of the status code if set */
+static void UT_AltHandler_CF_WrappedRead_Src(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    void *       buf    = UT_Hook_GetArgValueByName(Context, "buf", void *);
+    CFE_Status_t retval = (CFE_Status_t)UT_Hook_GetArgValueByName(Context, "read_size", size_t);
+    int32        status_code;
+
+    if (UT_Stub_GetInt32StatusCode(Context, &status_code))
+    {
+        retval = status_code;
+    }
+    else
+    {
+        if (retval > (CFE_Status_t)(sizeof(UT_CF_Bundle_Src) - UT_CF_Bundle_SrcPos))
+        {
+            retval = sizeof(UT_CF_Bundle_Src) - UT_CF_Bundle_SrcPos;
+        }
+        memcpy(buf, &UT_CF_Bundle_Src[UT_CF_Bundle_SrcPos], retval);
+        UT_CF_Bundle_SrcPos += retval;
+    }
+    UT_Stub_SetReturnValue(FuncKey, retval);
+}
+
+static void UT_CF_Bundle_SetConfig(void)
+{
+    memset(&UT_CF_Bundle_Config, 0, sizeof(UT_CF_Bundle_Config));
+    strncpy(UT_CF_Bundle_Config.tmp_dir, "/cf/tmp", sizeof(UT_CF_Bundle_Config.tmp_dir) - 1);
+    CF_AppData.config_table = &UT_CF_Bundle_Config;
+}
+
+/*******************************************************************************
+**
+**  cf_bundle_tests Tests
+**
+*******************************************************************************/
+
+void Test_CF_Bundle_Start(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_Bundle_Start(CF_Bundle_t *bundle, struct CF_Playback *owner);
+     */
+    CF_Bundle_t * bundle = &UT_CF_Bundle_Work;
+    CF_Playback_t pb;
+
+    UT_CF_Bundle_SetConfig();
+    memset(bundle, 0, sizeof(*bundle));
+
+    /* nominal */
+    bundle->count = 3;
+    UtAssert_INT32_EQ(CF_Bundle_Start(bundle, &pb), CFE_SUCCESS);
+    UtAssert_ADDRESS_EQ(bundle->owner, &pb);
+    UtAssert_UINT32_EQ(bundle->count, 0);
+    UtAssert_UINT32_EQ(bundle->size, 0);
+
+    /* file not created, the work area is not taken */
+    bundle->owner = NULL;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UtAssert_INT32_EQ(CF_Bundle_Start(bundle, &pb), CF_ERROR);
+    UtAssert_NULL(bundle->owner);
+    UtAssert_BOOL_FALSE(OS_ObjectIdDefined(bundle->fd));
+}
+
+void Test_CF_Bundle_AddFile(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_Bundle_AddFile(CF_Bundle_t *bundle, const char *src_filename, const char *name, uint32 size);
+     */
+    CF_Bundle_t *bundle = &UT_CF_Bundle_Work;
+    uint32       i;
+
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedWrite), UT_AltHandler_CF_WrappedWrite_Image, NULL);
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedRead), UT_AltHandler_CF_WrappedRead_Src, NULL);
+
+    for (i = 0; i < sizeof(UT_CF_Bundle_Src); ++i)
+    {
+        UT_CF_Bundle_Src[i] = i * 7;
+    }
+
+    memset(bundle, 0, sizeof(*bundle));
+    bundle->fd            = OS_ObjectIdFromInteger(1);
+    UT_CF_Bundle_ImageLen = 0;
+
+    /* nominal, copied a buffer at a time */
+    UT_CF_Bundle_SrcPos = 0;
+    UtAssert_INT32_EQ(CF_Bundle_AddFile(bundle, "/src/a.dat", "a.dat", UT_CF_BUNDLE_SRC_SIZE), CFE_SUCCESS);
+    UtAssert_UINT32_EQ(bundle->count, 1);
+    UtAssert_UINT32_EQ(bundle->size, UT_CF_BUNDLE_SRC_SIZE);
+    UtAssert_UINT32_EQ(bundle->entries[0].offset, 0);
+    UtAssert_UINT32_EQ(bundle->entries[0].size, UT_CF_BUNDLE_SRC_SIZE);
+    UtAssert_STRINGBUF_EQ(bundle->entries[0].name, sizeof(bundle->entries[0].name), "a.dat", -1);
+    UtAssert_UINT32_EQ(UT_CF_Bundle_ImageLen, UT_CF_BUNDLE_SRC_SIZE);
+    UtAssert_MemCmp(UT_CF_Bundle_Image, UT_CF_Bundle_Src, UT_CF_BUNDLE_SRC_SIZE, "file data");
+    UtAssert_STUB_COUNT(CF_WrappedRead, 2);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+
+    /* the next file follows it */
+    UT_CF_Bundle_SrcPos = 0;
+    UtAssert_INT32_EQ(CF_Bundle_AddFile(bundle, "/src/b.dat", "b.dat", 10), CFE_SUCCESS);
+    UtAssert_UINT32_EQ(bundle->count, 2);
+    UtAssert_UINT32_EQ(bundle->size, UT_CF_BUNDLE_SRC_SIZE + 10);
+    UtAssert_UINT32_EQ(bundle->entries[1].offset, UT_CF_BUNDLE_SRC_SIZE);
+
+    /* an empty file only takes an index entry */
+    UtAssert_INT32_EQ(CF_Bundle_AddFile(bundle, "/src/c.dat", "c.dat", 0), CFE_SUCCESS);
+    UtAssert_UINT32_EQ(bundle->count, 3);
+    UtAssert_UINT32_EQ(bundle->entries[2].offset, UT_CF_BUNDLE_SRC_SIZE + 10);
+    UtAssert_UINT32_EQ(bundle->entries[2].size, 0);
+
+    /* file not opened */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UtAssert_INT32_EQ(CF_Bundle_AddFile(bundle, "/src/d.dat", "d.dat", 10), CF_ERROR);
+    UtAssert_UINT32_EQ(bundle->count, 3);
+    UtAssert_STUB_COUNT(CF_WrappedLseek, 0);
+
+    /* file shorter than it was, what got written is left out of the index */
+    UT_CF_Bundle_SrcPos = 0;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 2, 5);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, UT_CF_BUNDLE_SRC_SIZE + 10 + 1024);
+    UtAssert_INT32_EQ(CF_Bundle_AddFile(bundle, "/src/d.dat", "d.dat", UT_CF_BUNDLE_SRC_SIZE), CF_ERROR);
+    UtAssert_UINT32_EQ(bundle->count, 3);
+    UtAssert_UINT32_EQ(bundle->size, UT_CF_BUNDLE_SRC_SIZE + 10 + 1024);
+    UtAssert_BOOL_TRUE(OS_ObjectIdDefined(bundle->fd));
+
+    /* and if where it got to is not known, the bundle cannot be used */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 1, -1);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, -1);
+    UtAssert_INT32_EQ(CF_Bundle_AddFile(bundle, "/src/d.dat", "d.dat", 10), CF_ERROR);
+    UtAssert_UINT32_EQ(bundle->count, 3);
+    UtAssert_BOOL_FALSE(OS_ObjectIdDefined(bundle->fd));
+}
+
+void Test_CF_Bundle_Finish(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_Bundle_Finish(CF_Bundle_t *bundle);
+     */
+    CF_Bundle_t *    bundle = &UT_CF_Bundle_Work;
+    CF_BundleEntry_t entry;
+    uint32           count;
+    uint32           index_offset;
+    uint32           pos;
+    uint32           n;
+    uint32           i;
+
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedWrite), UT_AltHandler_CF_WrappedWrite_Image, NULL);
+
+    /* names long enough that the index takes several buffers */
+    memset(bundle, 0, sizeof(*bundle));
+    bundle->fd = OS_ObjectIdFromInteger(1);
+    for (i = 0; i < CF_BUNDLE_MAX_FILES; ++i)
+    {
+        bundle->entries[i].offset = i * 10;
+        bundle->entries[i].size   = 10;
+        snprintf(bundle->entries[i].name, sizeof(bundle->entries[i].name), "file_with_a_long_name_%08lu",
+                 (unsigned long)i);
+    }
+    bundle->count = CF_BUNDLE_MAX_FILES;
+    bundle->size  = CF_BUNDLE_MAX_FILES * 10;
+
+    /* nominal, the index written after the data reads back, entries then trailer */
+    UT_CF_Bundle_ImageLen = bundle->size;
+    UtAssert_INT32_EQ(CF_Bundle_Finish(bundle), CFE_SUCCESS);
+    UtAssert_BOOL_FALSE(OS_ObjectIdDefined(bundle->fd));
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+    UtAssert_UINT32_GT(UT_GetStubCount(UT_KEY(CF_WrappedWrite)), 1);
+
+    UtAssert_BOOL_TRUE(CF_Bundle_ParseTrailer(&UT_CF_Bundle_Image[UT_CF_Bundle_ImageLen - CF_BUNDLE_TRAILER_SIZE],
+                                              UT_CF_Bundle_ImageLen, &count, &index_offset));
+    UtAssert_UINT32_EQ(count, CF_BUNDLE_MAX_FILES);
+    UtAssert_UINT32_EQ(index_offset, CF_BUNDLE_MAX_FILES * 10);
+
+    pos = index_offset;
+    for (i = 0; i < count; ++i)
+    {
+        n = CF_Bundle_ParseEntry(&UT_CF_Bundle_Image[pos], UT_CF_Bundle_ImageLen - pos, &entry);
+        UtAssert_UINT32_GT(n, 0);
+        UtAssert_UINT32_EQ(entry.offset, bundle->entries[i].offset);
+        UtAssert_STRINGBUF_EQ(entry.name, sizeof(entry.name), bundle->entries[i].name, sizeof(entry.name));
+        pos += n;
+    }
+    UtAssert_UINT32_EQ(pos, UT_CF_Bundle_ImageLen - CF_BUNDLE_TRAILER_SIZE);
+
+    /* index not written */
+    bundle->fd = OS_ObjectIdFromInteger(1);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 1, -1);
+    UtAssert_INT32_EQ(CF_Bundle_Finish(bundle), CF_ERROR);
+    UtAssert_BOOL_FALSE(OS_ObjectIdDefined(bundle->fd));
+
+    /* trailer not written */
+    bundle->fd    = OS_ObjectIdFromInteger(1);
+    bundle->count = 2;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 1, 1);
+    UtAssert_INT32_EQ(CF_Bundle_Finish(bundle), CF_ERROR);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 3);
+}
+
+void Test_CF_Bundle_Release(void)
+{
+    /* Test case for:
+     * void CF_Bundle_Release(CF_Bundle_t *bundle);
+     */
+    CF_Bundle_t * bundle = &UT_CF_Bundle_Work;
+    CF_Playback_t pb;
+
+    UT_CF_Bundle_SetConfig();
+
+    /* a bundle being built is thrown away */
+    memset(bundle, 0, sizeof(*bundle));
+    bundle->owner = &pb;
+    bundle->fd    = OS_ObjectIdFromInteger(1);
+    bundle->count = 2;
+    bundle->size  = 20;
+    UtAssert_VOIDCALL(CF_Bundle_Release(bundle));
+    UtAssert_NULL(bundle->owner);
+    UtAssert_UINT32_EQ(bundle->count, 0);
+    UtAssert_UINT32_EQ(bundle->size, 0);
+    UtAssert_BOOL_FALSE(OS_ObjectIdDefined(bundle->fd));
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 1);
+
+    /* a finished one is left for the caller */
+    bundle->owner = &pb;
+    UtAssert_VOIDCALL(CF_Bundle_Release(bundle));
+    UtAssert_NULL(bundle->owner);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 1);
+}
+
+void Test_CF_Bundle_ParseEntry(void)
+{
+    /* Test case for:
+     * uint32 CF_Bundle_PutEntry(uint8 *out, const CF_BundleEntry_t *entry);
+     * uint32 CF_Bundle_ParseEntry(const uint8 *in, uint32 in_len, CF_BundleEntry_t *entry);
+     */
+    const uint8      expect[] = {0x00, 0x01, 0x02, 0x03, 0x00, 0x00, 0x04, 0x00, 0x03, 'a', '.', 'b'};
+    uint8            out[CF_BUNDLE_ENTRY_HDR_SIZE + CF_FILENAME_MAX_NAME];
+    CF_BundleEntry_t entry;
+    CF_BundleEntry_t back;
+
+    /* big endian, and back again */
+    memset(&entry, 0, sizeof(entry));
+    entry.offset = 0x10203;
+    entry.size   = 0x400;
+    strncpy(entry.name, "a.b", sizeof(entry.name) - 1);
+    UtAssert_UINT32_EQ(CF_Bundle_PutEntry(out, &entry), sizeof(expect));
+    UtAssert_MemCmp(out, expect, sizeof(expect), "entry");
+    UtAssert_UINT32_EQ(CF_Bundle_ParseEntry(out, sizeof(expect), &back), sizeof(expect));
+    UtAssert_UINT32_EQ(back.offset, entry.offset);
+    UtAssert_UINT32_EQ(back.size, entry.size);
+    UtAssert_STRINGBUF_EQ(back.name, sizeof(back.name), "a.b", -1);
+
+    /* cut short, in the header or in the name */
+    UtAssert_UINT32_EQ(CF_Bundle_ParseEntry(out, CF_BUNDLE_ENTRY_HDR_SIZE - 1, &back), 0);
+    UtAssert_UINT32_EQ(CF_Bundle_ParseEntry(out, sizeof(expect) - 1, &back), 0);
+
+    /* no name, or one too long to hold */
+    out[8] = 0;
+    UtAssert_UINT32_EQ(CF_Bundle_ParseEntry(out, sizeof(out), &back), 0);
+    out[8] = CF_FILENAME_MAX_NAME;
+    UtAssert_UINT32_EQ(CF_Bundle_ParseEntry(out, sizeof(out), &back), 0);
+
+    /* names that would land somewhere else */
+    out[8]  = 3;
+    out[10] = '/';
+    UtAssert_UINT32_EQ(CF_Bundle_ParseEntry(out, sizeof(expect), &back), 0);
+    out[10] = 0;
+    UtAssert_UINT32_EQ(CF_Bundle_ParseEntry(out, sizeof(expect), &back), 0);
+    out[8]  = 2;
+    out[9]  = '.';
+    out[10] = '.';
+    UtAssert_UINT32_EQ(CF_Bundle_ParseEntry(out, sizeof(expect), &back), 0);
+    out[8] = 1;
+    UtAssert_UINT32_EQ(CF_Bundle_ParseEntry(out, sizeof(expect), &back), 0);
+}
+
+void Test_CF_Bundle_ParseTrailer(void)
+{
+    /* Test case for:
+     * void CF_Bundle_PutTrailer(uint8 *out, uint32 count, uint32 index_offset);
+     * bool CF_Bundle_ParseTrailer(const uint8 *in, uint32 fsize, uint32 *count, uint32 *index_offset);
+     */
+    const uint8 expect[CF_BUNDLE_TRAILER_SIZE] = {'C', 'F', 'B', '1', 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x01, 0x00};
+    uint8       out[CF_BUNDLE_TRAILER_SIZE];
+    uint32      count;
+    uint32      index_offset;
+
+    /* two files of 128 bytes, and two entries of 10 bytes */
+    UtAssert_VOIDCALL(CF_Bundle_PutTrailer(out, 2, 0x100));
+    UtAssert_MemCmp(out, expect, sizeof(expect), "trailer");
+    UtAssert_BOOL_TRUE(CF_Bundle_ParseTrailer(out, 0x100 + 20 + CF_BUNDLE_TRAILER_SIZE, &count, &index_offset));
+    UtAssert_UINT32_EQ(count, 2);
+    UtAssert_UINT32_EQ(index_offset, 0x100);
+
+    /* more entries than the index has room for */
+    UtAssert_BOOL_FALSE(CF_Bundle_ParseTrailer(out, 0x100 + 19 + CF_BUNDLE_TRAILER_SIZE, &count, &index_offset));
+
+    /* index past the trailer, or a file too short to have one */
+    UtAssert_BOOL_FALSE(CF_Bundle_ParseTrailer(out, 0x100 - 1, &count, &index_offset));
+    UtAssert_BOOL_FALSE(CF_Bundle_ParseTrailer(out, CF_BUNDLE_TRAILER_SIZE - 1, &count, &index_offset));
+
+    /* not a bundle */
+    out[3] = '2';
+    UtAssert_BOOL_FALSE(CF_Bundle_ParseTrailer(out, 0x100 + 20 + CF_BUNDLE_TRAILER_SIZE, &count, &index_offset));
+}
+
+void Test_CF_Bundle_GetFilename(void)
+{
+    /* Test case for:
+     * void CF_Bundle_GetBuildFilename(char *buf, size_t buf_size);
+     * void CF_Bundle_GetFilename(char *buf, size_t buf_size, CF_EntityId_t src_eid, CF_TransactionSeq_t seq_num);
+     */
+    char buf[OS_MAX_PATH_LEN];
+
+    UT_CF_Bundle_SetConfig();
+
+    UtAssert_VOIDCALL(CF_Bundle_GetBuildFilename(buf, sizeof(buf)));
+    UtAssert_STRINGBUF_EQ(buf, sizeof(buf), "/cf/tmp/bundle.cfb", -1);
+
+    UtAssert_VOIDCALL(CF_Bundle_GetFilename(buf, sizeof(buf), 2, 34));
+    UtAssert_STRINGBUF_EQ(buf, sizeof(buf), "/cf/tmp/2:34.cfb", -1);
+}
+
+/*******************************************************************************
+**
+**  cf_bundle_tests UtTest_Setup
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    TEST_CF_ADD(Test_CF_Bundle_Start);
+    TEST_CF_ADD(Test_CF_Bundle_AddFile);
+    TEST_CF_ADD(Test_CF_Bundle_Finish);
+    TEST_CF_ADD(Test_CF_Bundle_Release);
+    TEST_CF_ADD(Test_CF_Bundle_ParseEntry);
+    TEST_CF_ADD(Test_CF_Bundle_ParseTrailer);
+    TEST_CF_ADD(Test_CF_Bundle_GetFilename);
+}
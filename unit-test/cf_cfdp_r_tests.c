@@ -27,6 +27,63 @@
 #include "cf_cfdp_r.h"
 #include "cf_cfdp_s.h"
 
+/* records the progress handed to CF_CFDP_SendKeepAlive */
+static void UT_AltHandler_CaptureKeepAliveProgress(void *UserObj, UT_EntryKey_t FuncKey,
+                                                   const UT_StubContext_t *Context)
+{
+    CF_FileSize_t *progress = UserObj;
+
+    *progress = UT_Hook_GetArgValueByName(Context, "progress", CF_FileSize_t);
+}
+
+/* hands out the delta header in UserObj, as if it were read from the file */
+static void UT_AltHandler_DeltaParseHeader(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CF_DeltaHeader_t *hdr = UT_Hook_GetArgValueByName(Context, "hdr", CF_DeltaHeader_t *);
+    bool              ok  = true;
+
+    *hdr = *(const CF_DeltaHeader_t *)UserObj;
+    UT_Stub_SetReturnValue(FuncKey, ok);
+}
+
+/* hands out the delta instruction in UserObj, its size then arg then count, as if it were read from the file */
+static void UT_AltHandler_DeltaParseOp(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    const uint32 *op    = UserObj;
+    uint32 *      arg   = UT_Hook_GetArgValueByName(Context, "arg", uint32 *);
+    uint32 *      count = UT_Hook_GetArgValueByName(Context, "count", uint32 *);
+    uint32        size  = op[0];
+
+    *arg   = op[1];
+    *count = op[2];
+    UT_Stub_SetReturnValue(FuncKey, size);
+}
+
+/* a bundle trailer for the number of files in UserObj, with 20 bytes of index */
+static void UT_AltHandler_BundleTrailer(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    uint32 *count        = UT_Hook_GetArgValueByName(Context, "count", uint32 *);
+    uint32 *index_offset = UT_Hook_GetArgValueByName(Context, "index_offset", uint32 *);
+    uint32  fsize        = UT_Hook_GetArgValueByName(Context, "fsize", uint32);
+    bool    retval       = true;
+
+    *count        = *(const uint32 *)UserObj;
+    *index_offset = fsize - CF_BUNDLE_TRAILER_SIZE - 20;
+    UT_Stub_SetReturnValue(FuncKey, retval);
+}
+
+/* an index entry of the size in UserObj, for a 10 byte file named "m" at the start of the bundle */
+static void UT_AltHandler_BundleEntry(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CF_BundleEntry_t *entry  = UT_Hook_GetArgValueByName(Context, "entry", CF_BundleEntry_t *);
+    uint32            retval = *(const uint32 *)UserObj;
+
+    memset(entry, 0, sizeof(*entry));
+    entry->size = 10;
+    strcpy(entry->name, "m");
+    UT_Stub_SetReturnValue(FuncKey, retval);
+}
+
 static void UT_CFDP_R_SetupBasicRxState(CF_Logical_PduBuffer_t *pdu_buffer)
 {
     /* placeholder, nothing for now in this module */
@@ -171,6 +228,104 @@ void Test_CF_CFDP_R2_Recv(void)
     UtAssert_VOIDCALL(CF_CFDP_R2_Recv(txn, ph));
 }
 
+void Test_CF_CFDP_R_Respond(void)
+{
+    /* Test case for:
+     * void CF_CFDP_R_Respond(CF_Transaction_t *txn, int *cont);
+     */
+    CF_Transaction_t *txn;
+    int               cont;
+
+    /* not in R2 state, noop */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    txn->flags.rx.send_ack = true;
+    UtAssert_VOIDCALL(CF_CFDP_R_Respond(txn, &cont));
+    UtAssert_STUB_COUNT(CF_CFDP_SendAck, 0);
+    UtAssert_BOOL_TRUE(txn->flags.rx.send_ack);
+
+    /* everything pending goes out in one call, and no timers are touched */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->state              = CF_TxnState_R2;
+    txn->flags.rx.send_ack  = true;
+    txn->flags.rx.send_nak  = true;
+    txn->flags.rx.send_fin  = true;
+    txn->flags.com.crc_calc = true;
+    UtAssert_VOIDCALL(CF_CFDP_R_Respond(txn, &cont));
+    UtAssert_STUB_COUNT(CF_CFDP_SendAck, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_SendNak, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_SendFin, 1);
+    UtAssert_BOOL_FALSE(txn->flags.rx.send_ack);
+    UtAssert_BOOL_FALSE(txn->flags.rx.send_nak);
+    UtAssert_BOOL_FALSE(txn->flags.rx.send_fin);
+    UtAssert_STUB_COUNT(CF_Timer_Tick, 0);
+    UtAssert_STUB_COUNT(CF_Timer_Expired, 0);
+
+    /* ACK cannot be sent, the rest waits behind it */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    UT_SetDeferredRetcode(UT_KEY(CF_CFDP_SendAck), 1, CF_SEND_PDU_NO_BUF_AVAIL_ERROR);
+    txn->state             = CF_TxnState_R2;
+    txn->flags.rx.send_ack = true;
+    txn->flags.rx.send_nak = true;
+    UtAssert_VOIDCALL(CF_CFDP_R_Respond(txn, &cont));
+    UtAssert_BOOL_TRUE(txn->flags.rx.send_ack);
+    UtAssert_BOOL_TRUE(txn->flags.rx.send_nak);
+    UtAssert_STUB_COUNT(CF_CFDP_SendNak, 1);
+
+    /* NAK cannot be sent, FIN waits behind it */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    UT_SetDeferredRetcode(UT_KEY(CF_CFDP_SendNak), 1, CF_SEND_PDU_NO_BUF_AVAIL_ERROR);
+    txn->state              = CF_TxnState_R2;
+    txn->flags.rx.send_nak  = true;
+    txn->flags.rx.send_fin  = true;
+    txn->flags.com.crc_calc = true;
+    UtAssert_VOIDCALL(CF_CFDP_R_Respond(txn, &cont));
+    UtAssert_BOOL_TRUE(txn->flags.rx.send_nak);
+    UtAssert_BOOL_TRUE(txn->flags.rx.send_fin);
+    UtAssert_STUB_COUNT(CF_CFDP_SendFin, 1);
+
+    /* FIN is left for the tick while the CRC still needs to be calculated */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->state             = CF_TxnState_R2;
+    txn->flags.rx.send_fin = true;
+    UtAssert_VOIDCALL(CF_CFDP_R_Respond(txn, &cont));
+    UtAssert_BOOL_TRUE(txn->flags.rx.send_fin);
+    UtAssert_STUB_COUNT(CF_CFDP_SendFin, 1);
+
+    /* ... unless the transaction already failed, so there is nothing to check */
+    txn->history->txn_stat = CF_TxnStatus_FILESTORE_REJECTION;
+    UT_SetDefaultReturnValue(UT_KEY(CF_TxnStatus_IsError), true);
+    UtAssert_VOIDCALL(CF_CFDP_R_Respond(txn, &cont));
+    UtAssert_BOOL_FALSE(txn->flags.rx.send_fin);
+    UtAssert_STUB_COUNT(CF_CFDP_SendFin, 2);
+    UT_ResetState(UT_KEY(CF_TxnStatus_IsError));
+
+    /* FIN cannot be sent */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    UT_SetDeferredRetcode(UT_KEY(CF_CFDP_SendFin), 1, CF_SEND_PDU_NO_BUF_AVAIL_ERROR);
+    txn->state              = CF_TxnState_R2;
+    txn->flags.rx.send_fin  = true;
+    txn->flags.com.crc_calc = true;
+    UtAssert_VOIDCALL(CF_CFDP_R_Respond(txn, &cont));
+    UtAssert_BOOL_TRUE(txn->flags.rx.send_fin);
+
+    /* keep alive goes out once nothing else is pending */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->state                    = CF_TxnState_R2;
+    txn->flags.rx.send_keep_alive = true;
+    UtAssert_VOIDCALL(CF_CFDP_R_Respond(txn, &cont));
+    UtAssert_STUB_COUNT(CF_CFDP_SendKeepAlive, 1);
+    UtAssert_BOOL_FALSE(txn->flags.rx.send_keep_alive);
+
+    /* ... and waits behind the FIN */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->state                    = CF_TxnState_R2;
+    txn->flags.rx.send_fin        = true;
+    txn->flags.rx.send_keep_alive = true;
+    UtAssert_VOIDCALL(CF_CFDP_R_Respond(txn, &cont));
+    UtAssert_STUB_COUNT(CF_CFDP_SendKeepAlive, 1);
+    UtAssert_BOOL_TRUE(txn->flags.rx.send_keep_alive);
+}
+
 void Test_CF_CFDP_R_Tick(void)
 {
     /* Test case for:
@@ -314,6 +469,38 @@ void Test_CF_CFDP_R_Tick(void)
     UtAssert_VOIDCALL(CF_CFDP_R_Tick(txn, &cont));
     UtAssert_STUB_COUNT(CF_CFDP_ArmAckTimer, 3);
     UtAssert_BOOL_FALSE(txn->flags.rx.send_fin);
+
+    /* in R2 state, keep alive timer expires and the keep alive goes out */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->chan[txn->chan_num].keep_alive_s = 10;
+    txn->state                               = CF_TxnState_R2;
+    txn->flags.rx.inactivity_fired           = true;
+    UT_SetDeferredRetcode(UT_KEY(CF_Timer_Expired), 1, 1);
+    UtAssert_VOIDCALL(CF_CFDP_R_Tick(txn, &cont));
+    UtAssert_STUB_COUNT(CF_Timer_InitRelSec, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_SendKeepAlive, 1);
+    UtAssert_BOOL_FALSE(txn->flags.rx.send_keep_alive);
+
+    /* same as above, but there is no buffer for it */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->chan[txn->chan_num].keep_alive_s = 10;
+    txn->state                               = CF_TxnState_R2;
+    txn->flags.rx.inactivity_fired           = true;
+    UT_SetDeferredRetcode(UT_KEY(CF_Timer_Expired), 1, 1);
+    UT_SetDeferredRetcode(UT_KEY(CF_CFDP_SendKeepAlive), 1, CF_SEND_PDU_NO_BUF_AVAIL_ERROR);
+    UtAssert_VOIDCALL(CF_CFDP_R_Tick(txn, &cont));
+    UtAssert_BOOL_TRUE(txn->flags.rx.send_keep_alive);
+
+    /* keep alive timer is not run once the file is complete */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->chan[txn->chan_num].keep_alive_s = 10;
+    txn->state                               = CF_TxnState_R2;
+    txn->flags.rx.inactivity_fired           = true;
+    txn->flags.rx.complete                   = true;
+    UT_SetDeferredRetcode(UT_KEY(CF_Timer_Expired), 1, 1);
+    UtAssert_VOIDCALL(CF_CFDP_R_Tick(txn, &cont));
+    UtAssert_STUB_COUNT(CF_CFDP_SendKeepAlive, 2);
+    UtAssert_BOOL_FALSE(txn->flags.rx.send_keep_alive);
 }
 
 void Test_CF_CFDP_R_Cancel(void)
@@ -348,6 +535,7 @@ void Test_CF_CFDP_R_Init(void)
      * void CF_CFDP_R_Init(CF_Transaction_t *txn);
      */
     CF_Transaction_t *txn;
+    CF_ConfigTable_t *config;
 
     /* nominal */
     UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
@@ -387,6 +575,140 @@ void Test_CF_CFDP_R_Init(void)
     UT_CF_AssertEventID(CF_CFDP_R_CREAT_ERR_EID);
     UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_open, 2);
     UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_FILESTORE_REJECTION);
+
+    /* R2 state, no md_recv, staging enabled (no tempfile) */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, &config);
+    config->chan[UT_CFDP_CHANNEL].rx_staging_enabled = 1;
+    txn->state                                       = CF_TxnState_R2;
+    UtAssert_VOIDCALL(CF_CFDP_R_Init(txn));
+    UtAssert_ADDRESS_EQ(txn->state_data.receive.staging, &CF_AppData.engine.rx_staging[0]);
+    UtAssert_UINT32_EQ(txn->state_data.receive.sub_state, CF_RxSubState_FILEDATA);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 5);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+
+    /* R2 state, with md_recv, resuming a partial file kept from an earlier attempt */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    UT_SetDefaultReturnValue(UT_KEY(CF_Ckpt_ClaimPartial), true);
+    txn->state            = CF_TxnState_R2;
+    txn->flags.rx.md_recv = true;
+    UtAssert_VOIDCALL(CF_CFDP_R_Init(txn));
+    UtAssert_STUB_COUNT(CF_Ckpt_ClaimPartial, 2);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 5);
+    UtAssert_UINT32_EQ(txn->state_data.receive.sub_state, CF_RxSubState_FILEDATA);
+}
+
+void Test_CF_CFDP_R2_StagingAcquire(void)
+{
+    /* Test case for:
+     * bool CF_CFDP_R2_StagingAcquire(CF_Transaction_t *txn);
+     */
+    CF_Transaction_t *txn;
+    CF_ConfigTable_t *config;
+    CF_Transaction_t  other;
+    int               i;
+
+    /* staging disabled on the channel */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, &config);
+    UtAssert_BOOL_FALSE(CF_CFDP_R2_StagingAcquire(txn));
+    UtAssert_NULL(txn->state_data.receive.staging);
+
+    /* nominal, leftover data from a previous owner is cleared */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, &config);
+    config->chan[UT_CFDP_CHANNEL].rx_staging_enabled = 1;
+    CF_AppData.engine.rx_staging[0].size             = 10;
+    CF_AppData.engine.rx_staging[0].data[0]          = 0xAA;
+    UtAssert_BOOL_TRUE(CF_CFDP_R2_StagingAcquire(txn));
+    UtAssert_ADDRESS_EQ(txn->state_data.receive.staging, &CF_AppData.engine.rx_staging[0]);
+    UtAssert_ADDRESS_EQ(CF_AppData.engine.rx_staging[0].txn, txn);
+    UtAssert_ZERO(CF_AppData.engine.rx_staging[0].size);
+    UtAssert_ZERO(CF_AppData.engine.rx_staging[0].data[0]);
+
+    /* all buffers in use */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, &config);
+    config->chan[UT_CFDP_CHANNEL].rx_staging_enabled = 1;
+    for (i = 0; i < CF_NUM_RX_STAGING_BUFFERS; ++i)
+    {
+        CF_AppData.engine.rx_staging[i].txn = &other;
+    }
+    UtAssert_BOOL_FALSE(CF_CFDP_R2_StagingAcquire(txn));
+    UtAssert_NULL(txn->state_data.receive.staging);
+}
+
+void Test_CF_CFDP_R2_StagingFlush(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_CFDP_R2_StagingFlush(CF_Transaction_t *txn);
+     */
+    CF_Transaction_t *txn;
+    CF_RxStaging_t *  staging = &CF_AppData.engine.rx_staging[0];
+
+    /* nominal, nothing staged yet */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    staging->txn                    = txn;
+    staging->size                   = 0;
+    txn->state_data.receive.staging = staging;
+    UtAssert_INT32_EQ(CF_CFDP_R2_StagingFlush(txn), CFE_SUCCESS);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 1);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 0);
+    UtAssert_NULL(txn->state_data.receive.staging);
+    UtAssert_NULL(staging->txn);
+
+    /* nominal, with staged data */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    staging->txn                    = txn;
+    staging->size                   = 300;
+    txn->state_data.receive.staging = staging;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 1, 300);
+    UtAssert_INT32_EQ(CF_CFDP_R2_StagingFlush(txn), CFE_SUCCESS);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 1);
+    UtAssert_UINT32_EQ(txn->state_data.receive.cached_pos, 300);
+    UtAssert_NULL(txn->state_data.receive.staging);
+
+    /* file create failure */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    staging->txn                    = txn;
+    staging->size                   = 300;
+    txn->state_data.receive.staging = staging;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UtAssert_INT32_EQ(CF_CFDP_R2_StagingFlush(txn), CF_ERROR);
+    UT_CF_AssertEventID(CF_CFDP_R_CREAT_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_open, 1);
+    UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_FILESTORE_REJECTION);
+    UtAssert_NULL(txn->state_data.receive.staging);
+    UtAssert_NULL(staging->txn);
+
+    /* write failure */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    staging->txn                    = txn;
+    staging->size                   = 300;
+    txn->state_data.receive.staging = staging;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 1, -1);
+    UtAssert_INT32_EQ(CF_CFDP_R2_StagingFlush(txn), CF_ERROR);
+    UT_CF_AssertEventID(CF_CFDP_R_WRITE_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_write, 1);
+    UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_FILESTORE_REJECTION);
+    UtAssert_NULL(txn->state_data.receive.staging);
+}
+
+void Test_CF_CFDP_R2_StagingRelease(void)
+{
+    /* Test case for:
+     * void CF_CFDP_R2_StagingRelease(CF_Transaction_t *txn);
+     */
+    CF_Transaction_t *txn;
+    CF_RxStaging_t *  staging = &CF_AppData.engine.rx_staging[0];
+
+    /* nothing staged, noop */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    UtAssert_VOIDCALL(CF_CFDP_R2_StagingRelease(txn));
+    UtAssert_NULL(txn->state_data.receive.staging);
+
+    /* nominal */
+    staging->txn                    = txn;
+    txn->state_data.receive.staging = staging;
+    UtAssert_VOIDCALL(CF_CFDP_R2_StagingRelease(txn));
+    UtAssert_NULL(txn->state_data.receive.staging);
+    UtAssert_NULL(staging->txn);
 }
 
 void Test_CF_CFDP_R2_SetFinTxnStatus(void)
@@ -499,11 +821,13 @@ void Test_CF_CFDP_R2_Complete(void)
     UT_SetDeferredRetcode(UT_KEY(CF_TxnStatus_IsError), 1, true);
     UtAssert_VOIDCALL(CF_CFDP_R2_Complete(txn, 0));
 
-    /* nominal, send NAK */
+    /* nominal, send NAK, which replaces a pending prompted NAK */
     UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, &config);
     config->chan[txn->chan_num].nak_limit = 2;
+    txn->flags.rx.prompted                = true;
     UtAssert_VOIDCALL(CF_CFDP_R2_Complete(txn, 1));
     UtAssert_BOOL_TRUE(txn->flags.rx.send_nak);
+    UtAssert_BOOL_FALSE(txn->flags.rx.prompted);
     UtAssert_UINT32_EQ(txn->state_data.receive.sub_state, CF_RxSubState_FILEDATA);
     UtAssert_UINT32_EQ(txn->state_data.receive.r2.acknak_count, 1);
 
@@ -544,6 +868,8 @@ void Test_CF_CFDP_R_ProcessFd(void)
     CF_Transaction_t *              txn;
     CF_Logical_PduBuffer_t *        ph;
     CF_Logical_PduFileDataHeader_t *fd;
+    CF_RxStaging_t *                staging = &CF_AppData.engine.rx_staging[0];
+    uint8                           data[100];
 
     /* nominal */
     UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
@@ -553,8 +879,10 @@ void Test_CF_CFDP_R_ProcessFd(void)
     UtAssert_INT32_EQ(CF_CFDP_R_ProcessFd(txn, ph), 0);
     UtAssert_UINT32_EQ(txn->state_data.receive.cached_pos, 100);
     UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.file_data_bytes, 100);
+    UtAssert_UINT32_EQ(txn->history->perf.file_bytes, 100);
     UtAssert_STUB_COUNT(CF_WrappedLseek, 0);
     UtAssert_STUB_COUNT(CF_WrappedWrite, 1);
+    UtAssert_STUB_COUNT(CF_AddElapsedUsec, 1);
 
     /* call again, but for something at a different offset */
     UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
@@ -596,6 +924,52 @@ void Test_CF_CFDP_R_ProcessFd(void)
     /* these stats should have been updated during the course of this test */
     UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL].counters.fault.file_write, 1);
     UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL].counters.fault.file_seek, 1);
+
+    /* staged in RAM, out of order, does not touch the file */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    memset(data, 0x5A, sizeof(data));
+    memset(staging, 0, sizeof(*staging));
+    staging->txn                    = txn;
+    txn->state_data.receive.staging = staging;
+    fd                              = &ph->int_header.fd;
+    fd->data_ptr                    = data;
+    fd->data_len                    = sizeof(data);
+    fd->offset                      = 200;
+    UtAssert_INT32_EQ(CF_CFDP_R_ProcessFd(txn, ph), 0);
+    UtAssert_UINT32_EQ(staging->size, 300);
+    UtAssert_MemCmp(&staging->data[200], data, sizeof(data), "staged data");
+    fd->offset = 0;
+    UtAssert_INT32_EQ(CF_CFDP_R_ProcessFd(txn, ph), 0);
+    UtAssert_UINT32_EQ(staging->size, 300);
+    UtAssert_MemCmp(&staging->data[0], data, sizeof(data), "staged data");
+    UtAssert_STUB_COUNT(CF_WrappedLseek, 2);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 3);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+
+    /* beyond the staging buffer, spills to the temp file then writes there */
+    fd->offset = sizeof(staging->data);
+    UT_ResetState(UT_KEY(CF_WrappedWrite));
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 1, 300);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 1, fd->data_len);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, fd->offset);
+    UtAssert_INT32_EQ(CF_CFDP_R_ProcessFd(txn, ph), 0);
+    UT_CF_AssertEventID(CF_CFDP_R_TEMP_FILE_INF_EID);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 1);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 2);
+    UtAssert_NULL(txn->state_data.receive.staging);
+    UtAssert_UINT32_EQ(txn->state_data.receive.cached_pos, fd->offset + fd->data_len);
+
+    /* spill failure */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    staging->txn                    = txn;
+    txn->state_data.receive.staging = staging;
+    fd                              = &ph->int_header.fd;
+    fd->data_len                    = 100;
+    fd->offset                      = sizeof(staging->data) - 50;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UtAssert_INT32_EQ(CF_CFDP_R_ProcessFd(txn, ph), -1);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 2);
+    UtAssert_NULL(txn->state_data.receive.staging);
 }
 
 void Test_CF_CFDP_R_SubstateRecvEof(void)
@@ -619,6 +993,15 @@ void Test_CF_CFDP_R_SubstateRecvEof(void)
     txn->fsize            = 200;
     UtAssert_INT32_EQ(CF_CFDP_R_SubstateRecvEof(txn, ph), 0);
 
+    /* with md_recv giving an unbounded size, which the EOF then gives */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    eof                   = &ph->int_header.eof;
+    txn->flags.rx.md_recv = true;
+    eof->size             = 250;
+    txn->fsize            = 0;
+    UtAssert_INT32_EQ(CF_CFDP_R_SubstateRecvEof(txn, ph), 0);
+    UtAssert_UINT32_EQ(txn->fsize, 250);
+
     /* with md_recv and a different size */
     UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
     eof                   = &ph->int_header.eof;
@@ -672,6 +1055,38 @@ void Test_CF_CFDP_R1_SubstateRecvEof(void)
     txn->crc.result = ~eof->crc;
     UtAssert_VOIDCALL(CF_CFDP_R1_SubstateRecvEof(txn, ph));
     UtAssert_BOOL_FALSE(txn->keep);
+
+    /* compressed file data is expanded straight away */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    txn->flags.com.compressed = true;
+    UtAssert_VOIDCALL(CF_CFDP_R1_SubstateRecvEof(txn, ph));
+    UtAssert_BOOL_TRUE(txn->keep);
+    UtAssert_BOOL_TRUE(txn->flags.rx.expanded);
+    UtAssert_STUB_COUNT(CF_WrappedRename, 1);
+
+    /* and not kept if that fails */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    txn->flags.com.compressed = true;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRename), 1, OS_ERROR);
+    UtAssert_VOIDCALL(CF_CFDP_R1_SubstateRecvEof(txn, ph));
+    UtAssert_BOOL_FALSE(txn->keep);
+    UT_CF_AssertEventID(CF_CFDP_R_EXPAND_ERR_EID);
+
+    /* a delta is applied straight away too, and not kept if it is too short to be one */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    txn->flags.com.delta = true;
+    UtAssert_VOIDCALL(CF_CFDP_R1_SubstateRecvEof(txn, ph));
+    UtAssert_BOOL_FALSE(txn->keep);
+    UtAssert_BOOL_FALSE(txn->flags.rx.expanded);
+    UT_CF_AssertEventID(CF_CFDP_R_DELTA_ERR_EID);
+
+    /* as is a bundle */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    txn->flags.com.bundle = true;
+    UtAssert_VOIDCALL(CF_CFDP_R1_SubstateRecvEof(txn, ph));
+    UtAssert_BOOL_FALSE(txn->keep);
+    UtAssert_BOOL_FALSE(txn->flags.rx.expanded);
+    UT_CF_AssertEventID(CF_CFDP_R_BUNDLE_ERR_EID);
 }
 
 void Test_CF_CFDP_R2_SubstateRecvEof(void)
@@ -741,6 +1156,7 @@ void Test_CF_CFDP_R1_SubstateRecvFileData(void)
     UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
     UtAssert_VOIDCALL(CF_CFDP_R1_SubstateRecvFileData(txn, ph));
     UtAssert_STUB_COUNT(CF_CRC_Digest, 1);
+    UtAssert_STUB_COUNT(CF_AddElapsedUsec, 2); /* file I/O and CRC */
 
     /* failure in CF_CFDP_RecvFd */
     UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
@@ -843,6 +1259,7 @@ void Test_CF_CFDP_R_SubstateSendNak(void)
     CF_Transaction_t *      txn;
     CF_Logical_PduBuffer_t *ph;
     CF_ChunkWrapper_t       chunks;
+    CF_Chunk_t              chunk_mem[2];
 
     memset(&chunks, 0, sizeof(chunks));
 
@@ -855,6 +1272,7 @@ void Test_CF_CFDP_R_SubstateSendNak(void)
     UtAssert_INT32_EQ(CF_CFDP_R_SubstateSendNak(txn), 0);
     UT_CF_AssertEventID(CF_CFDP_R_REQUEST_MD_INF_EID);
     UtAssert_STUB_COUNT(CF_CFDP_SendNak, 1);
+    UtAssert_UINT32_EQ(txn->history->perf.nak_rounds, 1);
 
     /* same, but with failure of CF_CFDP_SendNak */
     UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_TX, &ph, NULL, NULL, &txn, NULL);
@@ -887,6 +1305,8 @@ void Test_CF_CFDP_R_SubstateSendNak(void)
     UtAssert_INT32_EQ(CF_CFDP_R_SubstateSendNak(txn), 0);
     UtAssert_STUB_COUNT(CF_CFDP_SendNak, 3);
     UtAssert_BOOL_TRUE(txn->flags.rx.fd_nak_sent);
+    UtAssert_UINT32_EQ(txn->history->perf.nak_rounds, 1);
+    UtAssert_UINT32_EQ(txn->history->perf.nak_segments, 1);
 
     /* same, nonzero number of gaps, but get failure in SendNak */
     /* this also should use the max chunks instead of count */
@@ -897,6 +1317,73 @@ void Test_CF_CFDP_R_SubstateSendNak(void)
     txn->chunks           = &chunks;
     UtAssert_INT32_EQ(CF_CFDP_R_SubstateSendNak(txn), -1);
     UtAssert_BOOL_TRUE(txn->flags.rx.fd_nak_sent); /* this flag is still set, even when it fails to send? */
+
+    /* resumed partial file, every gap listed, so the scope is the whole file */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_TX, &ph, NULL, NULL, &txn, NULL);
+    UT_SetDeferredRetcode(UT_KEY(CF_ChunkList_ComputeGaps), 1, 1);
+    txn->flags.rx.md_recv    = true;
+    txn->flags.rx.partial    = true;
+    txn->fsize               = 300;
+    txn->chunks              = &chunks;
+    chunks.chunks.count      = 1;
+    chunks.chunks.max_chunks = 2;
+    UtAssert_INT32_EQ(CF_CFDP_R_SubstateSendNak(txn), 0);
+    UtAssert_UINT32_EQ(ph->int_header.nak.scope_end, 300);
+
+    /* resumed partial file, chunk list full, so the scope ends with the listed segments */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_TX, &ph, NULL, NULL, &txn, NULL);
+    UT_SetDeferredRetcode(UT_KEY(CF_ChunkList_ComputeGaps), 1, 1);
+    txn->flags.rx.md_recv                                  = true;
+    txn->flags.rx.partial                                  = true;
+    txn->fsize                                             = 300;
+    txn->chunks                                            = &chunks;
+    chunks.chunks.count                                    = 2;
+    ph->int_header.nak.segment_list.num_segments           = 1;
+    ph->int_header.nak.segment_list.segments[0].offset_end = 120;
+    UtAssert_INT32_EQ(CF_CFDP_R_SubstateSendNak(txn), 0);
+    UtAssert_UINT32_EQ(ph->int_header.nak.scope_end, 120);
+
+    /* prompted before any file data, nothing is missing yet so nothing is sent */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_TX, &ph, NULL, NULL, &txn, NULL);
+    txn->flags.rx.md_recv    = true;
+    txn->flags.rx.prompted   = true;
+    txn->fsize               = 300;
+    txn->chunks              = &chunks;
+    chunks.chunks.count      = 0;
+    chunks.chunks.max_chunks = 2;
+    UtAssert_INT32_EQ(CF_CFDP_R_SubstateSendNak(txn), 0);
+    UtAssert_STUB_COUNT(CF_CFDP_SendNak, 6); /* did not increment */
+    UtAssert_BOOL_FALSE(txn->flags.rx.complete);
+    UtAssert_BOOL_FALSE(txn->flags.rx.prompted);
+
+    /* prompted with a gap, the scope ends at the furthest data received */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_TX, &ph, NULL, NULL, &txn, NULL);
+    UT_SetDeferredRetcode(UT_KEY(CF_ChunkList_ComputeGaps), 1, 1);
+    txn->flags.rx.md_recv    = true;
+    txn->flags.rx.prompted   = true;
+    txn->fsize               = 300;
+    txn->chunks              = &chunks;
+    chunks.chunks.chunks     = chunk_mem;
+    chunks.chunks.count      = 2;
+    chunks.chunks.max_chunks = 3;
+    chunk_mem[0].offset      = 0;
+    chunk_mem[0].size        = 50;
+    chunk_mem[1].offset      = 100;
+    chunk_mem[1].size        = 50;
+    UtAssert_INT32_EQ(CF_CFDP_R_SubstateSendNak(txn), 0);
+    UtAssert_UINT32_EQ(ph->int_header.nak.scope_end, 150);
+    UtAssert_STUB_COUNT(CF_CFDP_SendNak, 7);
+    UtAssert_BOOL_FALSE(txn->flags.rx.prompted);
+
+    /* same, but no buffer for the NAK, so the prompt is still pending */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_TX, &ph, NULL, NULL, &txn, NULL);
+    UT_SetDeferredRetcode(UT_KEY(CF_ChunkList_ComputeGaps), 1, 1);
+    UT_SetDeferredRetcode(UT_KEY(CF_CFDP_SendNak), 1, CF_SEND_PDU_NO_BUF_AVAIL_ERROR);
+    txn->flags.rx.md_recv  = true;
+    txn->flags.rx.prompted = true;
+    txn->chunks            = &chunks;
+    UtAssert_INT32_EQ(CF_CFDP_R_SubstateSendNak(txn), -1);
+    UtAssert_BOOL_TRUE(txn->flags.rx.prompted);
 }
 
 void Test_CF_CFDP_R2_CalcCrcChunk(void)
@@ -919,6 +1406,7 @@ void Test_CF_CFDP_R2_CalcCrcChunk(void)
     UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, txn->fsize);
     UtAssert_INT32_EQ(CF_CFDP_R2_CalcCrcChunk(txn), 0);
     UtAssert_BOOL_TRUE(txn->flags.com.crc_calc);
+    UtAssert_STUB_COUNT(CF_AddElapsedUsec, 2); /* file I/O and CRC */
 
     /* force a CRC mismatch */
     UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
@@ -945,6 +1433,17 @@ void Test_CF_CFDP_R2_CalcCrcChunk(void)
     UtAssert_INT32_EQ(CF_CFDP_R2_CalcCrcChunk(txn), 0);
     UtAssert_BOOL_TRUE(txn->flags.com.crc_calc);
 
+    /* same, but the engine cycle runs out of time after the first read */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, &config);
+    config->rx_crc_calc_bytes_per_wakeup = CF_R2_CRC_CHUNK_SIZE * 2;
+    txn->fsize                           = CF_R2_CRC_CHUNK_SIZE + 100;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, CF_R2_CRC_CHUNK_SIZE);
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_CycleBudgetExpired), true);
+    UtAssert_INT32_EQ(CF_CFDP_R2_CalcCrcChunk(txn), -1);
+    UtAssert_BOOL_FALSE(txn->flags.com.crc_calc);
+    UtAssert_UINT32_EQ(txn->state_data.receive.r2.rx_crc_calc_bytes, CF_R2_CRC_CHUNK_SIZE);
+    UT_ResetState(UT_KEY(CF_CFDP_CycleBudgetExpired));
+
     /* nominal with seek required */
     UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, &config);
     txn->state_data.receive.r2.rx_crc_calc_bytes = 10;
@@ -1011,6 +1510,451 @@ void Test_CF_CFDP_R2_SubstateSendFin(void)
     UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
     txn->flags.com.crc_calc = true;
     UtAssert_INT32_EQ(CF_CFDP_R2_SubstateSendFin(txn), 0);
+
+    /* compressed file data is expanded before the FIN */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->flags.com.crc_calc   = true;
+    txn->flags.com.compressed = true;
+    UtAssert_INT32_EQ(CF_CFDP_R2_SubstateSendFin(txn), 0);
+    UtAssert_BOOL_TRUE(txn->flags.rx.expanded);
+    UtAssert_STUB_COUNT(CF_CFDP_SendFin, 5);
+
+    /* expansion not finished, so no FIN yet */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->flags.com.crc_calc   = true;
+    txn->flags.com.compressed = true;
+    txn->fsize                = 100;
+    UtAssert_INT32_EQ(CF_CFDP_R2_SubstateSendFin(txn), -1);
+    UtAssert_BOOL_FALSE(txn->flags.rx.expanded);
+    UtAssert_STUB_COUNT(CF_CFDP_SendFin, 5);
+
+    /* a bundle is unpacked before the FIN too, and none is sent while that fails */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->flags.com.crc_calc = true;
+    txn->flags.com.bundle   = true;
+    UtAssert_INT32_EQ(CF_CFDP_R2_SubstateSendFin(txn), -1);
+    UT_CF_AssertEventID(CF_CFDP_R_BUNDLE_ERR_EID);
+    UtAssert_STUB_COUNT(CF_CFDP_SendFin, 5);
+
+    /* already unpacked */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->flags.com.crc_calc = true;
+    txn->flags.com.bundle   = true;
+    txn->flags.rx.expanded  = true;
+    UtAssert_INT32_EQ(CF_CFDP_R2_SubstateSendFin(txn), 0);
+    UtAssert_STUB_COUNT(CF_CFDP_SendFin, 6);
+}
+
+void Test_CF_CFDP_R_ApplyDelta(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_CFDP_R_ApplyDelta(CF_Transaction_t *txn, uint32 max_bytes);
+     */
+    CF_Transaction_t *txn;
+    CF_DeltaHeader_t  hdr;
+    uint32            op[3];
+
+    /* these handlers are sticky and apply for the rest of the test cases */
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.raw_size   = 20;
+    hdr.base_size  = 128;
+    hdr.block_size = 64;
+    UT_SetHandlerFunction(UT_KEY(CF_Delta_ParseHeader), UT_AltHandler_DeltaParseHeader, &hdr);
+    UT_SetHandlerFunction(UT_KEY(CF_Delta_ParseOp), UT_AltHandler_DeltaParseOp, op);
+
+    /* two data instructions of 10 bytes, only the first this time */
+    op[0] = CF_DELTA_DATA_HDR_SIZE;
+    op[1] = 10;
+    op[2] = 0;
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    txn->state = CF_TxnState_R2;
+    txn->fsize = CF_DELTA_HDR_SIZE + (2 * (CF_DELTA_DATA_HDR_SIZE + 10));
+    txn->keep  = 1;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, CF_DELTA_HDR_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, CF_DELTA_COPY_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, 10);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 2, 128);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, CF_DELTA_HDR_SIZE + CF_DELTA_DATA_HDR_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 1, 10);
+    UtAssert_INT32_EQ(CF_CFDP_R_ApplyDelta(txn, 10), CF_ERROR);
+    UtAssert_UINT32_EQ(txn->zoffs, CF_DELTA_HDR_SIZE + CF_DELTA_DATA_HDR_SIZE + 10);
+    UtAssert_UINT32_EQ(txn->raw_size, 10);
+    UtAssert_BOOL_FALSE(txn->flags.rx.expanded);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 2);
+    UtAssert_STUB_COUNT(CF_CRC_Digest, 1);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+
+    /* the rest next time, then the size and checksum match and the new file is moved into place */
+    OS_OpenCreate(&txn->zfd, "ut", 0, 0); /* sets zfd */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, CF_DELTA_HDR_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, CF_DELTA_COPY_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, 10);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 2, 128);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, txn->zoffs);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, txn->zoffs + CF_DELTA_DATA_HDR_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 1, 10);
+    UtAssert_INT32_EQ(CF_CFDP_R_ApplyDelta(txn, 10), CFE_SUCCESS);
+    UtAssert_BOOL_TRUE(txn->flags.rx.expanded);
+    UtAssert_BOOL_TRUE(txn->keep);
+    UtAssert_UINT32_EQ(txn->raw_size, 20);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 3);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 2);
+    UtAssert_STUB_COUNT(CF_WrappedRename, 1);
+
+    /* a copy of blocks the old file does not have */
+    op[0] = CF_DELTA_COPY_SIZE;
+    op[1] = 2;
+    op[2] = 1;
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    txn->state = CF_TxnState_R2;
+    txn->fsize = CF_DELTA_HDR_SIZE + CF_DELTA_COPY_SIZE;
+    txn->keep  = 1;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, CF_DELTA_HDR_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, CF_DELTA_COPY_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 2, 128);
+    UtAssert_INT32_EQ(CF_CFDP_R_ApplyDelta(txn, 100), CF_ERROR);
+    UT_CF_AssertEventID(CF_CFDP_R_DELTA_ERR_EID);
+    UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_INVALID_FILE_STRUCTURE);
+    UtAssert_BOOL_FALSE(txn->keep);
+    UtAssert_UINT32_EQ(txn->state_data.receive.r2.fs, CF_CFDP_FinFileStatus_DISCARDED);
+
+    /* a block of the old file is copied, but the new file does not match its checksum */
+    op[1]        = 1;
+    hdr.raw_size = 64;
+    hdr.raw_crc  = 5;
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    txn->fsize = CF_DELTA_HDR_SIZE + CF_DELTA_COPY_SIZE;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, CF_DELTA_HDR_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, CF_DELTA_COPY_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, 64);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 2, 128);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 64);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 1, 64);
+    UtAssert_INT32_EQ(CF_CFDP_R_ApplyDelta(txn, 100), CF_ERROR);
+    UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_FILE_CHECKSUM_FAILURE);
+    UtAssert_UINT32_EQ(txn->raw_size, 64);
+
+    /* the old file is not the one the delta was made against */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    txn->fsize = CF_DELTA_HDR_SIZE + CF_DELTA_COPY_SIZE;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, CF_DELTA_HDR_SIZE);
+    UtAssert_INT32_EQ(CF_CFDP_R_ApplyDelta(txn, 100), CF_ERROR);
+    UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_FILE_SIZE_ERROR);
+
+    /* the old file cannot be opened */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    txn->fsize = CF_DELTA_HDR_SIZE + CF_DELTA_COPY_SIZE;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, CF_DELTA_HDR_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UtAssert_INT32_EQ(CF_CFDP_R_ApplyDelta(txn, 100), CF_ERROR);
+    UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_FILESTORE_REJECTION);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_open, 1);
+
+    /* too short to be a delta */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    txn->fsize = CF_DELTA_HDR_SIZE - 1;
+    UtAssert_INT32_EQ(CF_CFDP_R_ApplyDelta(txn, 100), CF_ERROR);
+    UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_INVALID_FILE_STRUCTURE);
+    UtAssert_STUB_COUNT(CF_Delta_ParseHeader, 6);
+}
+
+void Test_CF_CFDP_R_Unbundle(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_CFDP_R_Unbundle(CF_Transaction_t *txn, uint32 max_bytes);
+     */
+    CF_Transaction_t *txn;
+    uint32            count = 2;
+    uint32            n     = 10;
+
+    /* these handlers are sticky and apply for the rest of the test cases */
+    UT_SetHandlerFunction(UT_KEY(CF_Bundle_ParseTrailer), UT_AltHandler_BundleTrailer, &count);
+    UT_SetHandlerFunction(UT_KEY(CF_Bundle_ParseEntry), UT_AltHandler_BundleEntry, &n);
+
+    /* two files with 10 byte entries, only the first this time */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    strcpy(txn->history->fnames.dst_filename, "/cf/rx/b.cfb");
+    txn->state = CF_TxnState_R2;
+    txn->fsize = 100;
+    txn->keep  = 1;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 100 - CF_BUNDLE_TRAILER_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 100 - CF_BUNDLE_TRAILER_SIZE - 20);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 0);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, CF_BUNDLE_TRAILER_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, 20);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, 10);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 1, 10);
+    UtAssert_INT32_EQ(CF_CFDP_R_Unbundle(txn, 10), CF_ERROR);
+    UtAssert_UINT32_EQ(txn->zoffs, 100 - CF_BUNDLE_TRAILER_SIZE - 10);
+    UtAssert_UINT32_EQ(txn->raw_size, 1);
+    UtAssert_BOOL_FALSE(txn->flags.rx.expanded);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 1);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+
+    /* the rest next time, then the bundle itself is removed */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 100 - CF_BUNDLE_TRAILER_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 100 - CF_BUNDLE_TRAILER_SIZE - 10);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 0);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, CF_BUNDLE_TRAILER_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, 10);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, 10);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 1, 10);
+    UtAssert_INT32_EQ(CF_CFDP_R_Unbundle(txn, 10), CFE_SUCCESS);
+    UtAssert_BOOL_TRUE(txn->flags.rx.expanded);
+    UtAssert_BOOL_TRUE(txn->keep);
+    UtAssert_UINT32_EQ(txn->raw_size, 2);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 2);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 3);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 1);
+    UtAssert_BOOL_FALSE(OS_ObjectIdDefined(txn->fd));
+
+    /* the index holds fewer files than the trailer says */
+    count = 3;
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    txn->state = CF_TxnState_R2;
+    txn->fsize = 100;
+    txn->keep  = 1;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 100 - CF_BUNDLE_TRAILER_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 100 - CF_BUNDLE_TRAILER_SIZE - 20);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 0);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 100 - CF_BUNDLE_TRAILER_SIZE - 10);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 0);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, CF_BUNDLE_TRAILER_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, 20);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, 10);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, 10);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, 10);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 1, 10);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 1, 10);
+    UtAssert_INT32_EQ(CF_CFDP_R_Unbundle(txn, UINT32_MAX), CF_ERROR);
+    UT_CF_AssertEventID(CF_CFDP_R_BUNDLE_ERR_EID);
+    UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_INVALID_FILE_STRUCTURE);
+    UtAssert_BOOL_FALSE(txn->keep);
+    UtAssert_UINT32_EQ(txn->state_data.receive.r2.fs, CF_CFDP_FinFileStatus_DISCARDED);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 1);
+    count = 2;
+
+    /* an entry that does not parse */
+    n = 0;
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    txn->fsize = 100;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 100 - CF_BUNDLE_TRAILER_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 100 - CF_BUNDLE_TRAILER_SIZE - 20);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, CF_BUNDLE_TRAILER_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, 20);
+    UtAssert_INT32_EQ(CF_CFDP_R_Unbundle(txn, UINT32_MAX), CF_ERROR);
+    UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_INVALID_FILE_STRUCTURE);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 4);
+    n = 10;
+
+    /* a file cannot be created */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    txn->fsize = 100;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 100 - CF_BUNDLE_TRAILER_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 100 - CF_BUNDLE_TRAILER_SIZE - 20);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 0);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, CF_BUNDLE_TRAILER_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, 20);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UtAssert_INT32_EQ(CF_CFDP_R_Unbundle(txn, UINT32_MAX), CF_ERROR);
+    UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_FILESTORE_REJECTION);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_open, 1);
+
+    /* the trailer cannot be read */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    txn->fsize = 100;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 100 - CF_BUNDLE_TRAILER_SIZE);
+    UtAssert_INT32_EQ(CF_CFDP_R_Unbundle(txn, UINT32_MAX), CF_ERROR);
+    UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_FILESTORE_REJECTION);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_read, 1);
+
+    /* too short to be a bundle */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    txn->fsize = CF_BUNDLE_TRAILER_SIZE - 1;
+    UtAssert_INT32_EQ(CF_CFDP_R_Unbundle(txn, UINT32_MAX), CF_ERROR);
+    UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_INVALID_FILE_STRUCTURE);
+    UtAssert_STUB_COUNT(CF_Bundle_ParseTrailer, 5);
+}
+
+void Test_CF_CFDP_R_DeltaSetAside(void)
+{
+    /* Test case for:
+     * void CF_CFDP_R_DeltaSetAside(CF_Transaction_t *txn);
+     */
+    CF_Transaction_t *txn;
+
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    UtAssert_VOIDCALL(CF_CFDP_R_DeltaSetAside(txn));
+    UtAssert_STUB_COUNT(CF_Delta_GetFilename, 1);
+    UtAssert_STUB_COUNT(CF_WrappedRename, 1);
+}
+
+void Test_CF_CFDP_R_DeltaReset(void)
+{
+    /* Test case for:
+     * void CF_CFDP_R_DeltaReset(CF_Transaction_t *txn);
+     */
+    CF_Transaction_t *txn;
+
+    /* not a delta, nothing to do */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    UtAssert_VOIDCALL(CF_CFDP_R_DeltaReset(txn));
+    UtAssert_STUB_COUNT(CF_Delta_GetFilename, 0);
+
+    /* applied, so the old file is removed */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    txn->flags.com.delta   = true;
+    txn->flags.rx.expanded = true;
+    UtAssert_VOIDCALL(CF_CFDP_R_DeltaReset(txn));
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 1);
+    UtAssert_STUB_COUNT(CF_WrappedRename, 0);
+
+    /* not applied, so the old file is put back */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    txn->flags.com.delta = true;
+    UtAssert_VOIDCALL(CF_CFDP_R_DeltaReset(txn));
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 1);
+    UtAssert_STUB_COUNT(CF_WrappedRename, 1);
+}
+
+void Test_CF_CFDP_R_ExpandChunk(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_CFDP_R_ExpandChunk(CF_Transaction_t *txn, uint32 max_bytes);
+     */
+    CF_Transaction_t *txn;
+
+    /* these retvals are sticky and apply for the rest of the test cases */
+    UT_SetDefaultReturnValue(UT_KEY(CF_Compress_ParseHeader), true);
+    UT_SetDefaultReturnValue(UT_KEY(CF_Compress_Unpack), true);
+
+    /* one block this time, stubbed to be a header with no data */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    txn->state = CF_TxnState_R2;
+    txn->fsize = CF_COMPRESS_BLOCK_HDR_SIZE * 2;
+    txn->keep  = 1;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, CF_COMPRESS_BLOCK_HDR_SIZE);
+    UtAssert_INT32_EQ(CF_CFDP_R_ExpandChunk(txn, CF_COMPRESS_BLOCK_HDR_SIZE), CF_ERROR);
+    UtAssert_UINT32_EQ(txn->zoffs, CF_COMPRESS_BLOCK_HDR_SIZE);
+    UtAssert_BOOL_FALSE(txn->flags.rx.expanded);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 1);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 1);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+
+    /* the rest next time, then the expanded file is moved into place */
+    OS_OpenCreate(&txn->zfd, "ut", 0, 0); /* sets zfd */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, CF_COMPRESS_BLOCK_HDR_SIZE);
+    UtAssert_INT32_EQ(CF_CFDP_R_ExpandChunk(txn, CF_COMPRESS_BLOCK_HDR_SIZE), CFE_SUCCESS);
+    UtAssert_BOOL_TRUE(txn->flags.rx.expanded);
+    UtAssert_BOOL_TRUE(txn->keep);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 1);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 2);
+    UtAssert_STUB_COUNT(CF_WrappedRename, 1);
+
+    /* seek error */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    txn->state                         = CF_TxnState_R2;
+    txn->fsize                         = 100;
+    txn->keep                          = 1;
+    txn->state_data.receive.cached_pos = 100;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, -1);
+    UtAssert_INT32_EQ(CF_CFDP_R_ExpandChunk(txn, 100), CF_ERROR);
+    UT_CF_AssertEventID(CF_CFDP_R_EXPAND_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_seek, 1);
+    UtAssert_BOOL_FALSE(txn->keep);
+    UtAssert_UINT32_EQ(txn->state_data.receive.r2.fs, CF_CFDP_FinFileStatus_DISCARDED);
+
+    /* short header read */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    txn->fsize = 100;
+    UtAssert_INT32_EQ(CF_CFDP_R_ExpandChunk(txn, 100), CF_ERROR);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_read, 1);
+
+    /* not enough left for a header */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    txn->fsize = CF_COMPRESS_BLOCK_HDR_SIZE - 1;
+    UtAssert_INT32_EQ(CF_CFDP_R_ExpandChunk(txn, 100), CF_ERROR);
+    UtAssert_STUB_COUNT(CF_Compress_ParseHeader, 2);
+
+    /* bad header */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    txn->fsize = 100;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, CF_COMPRESS_BLOCK_HDR_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_Compress_ParseHeader), 1, false);
+    UtAssert_INT32_EQ(CF_CFDP_R_ExpandChunk(txn, 100), CF_ERROR);
+    UtAssert_STUB_COUNT(CF_Compress_Unpack, 2);
+
+    /* short data read */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    txn->fsize = 100;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, CF_COMPRESS_BLOCK_HDR_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, -1);
+    UtAssert_INT32_EQ(CF_CFDP_R_ExpandChunk(txn, 100), CF_ERROR);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_read, 2);
+
+    /* block does not expand */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    txn->fsize = 100;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, CF_COMPRESS_BLOCK_HDR_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_Compress_Unpack), 1, false);
+    UtAssert_INT32_EQ(CF_CFDP_R_ExpandChunk(txn, 100), CF_ERROR);
+    UtAssert_STUB_COUNT(CF_Compress_Unpack, 3);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 2);
+
+    /* write error */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    txn->fsize = 100;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, CF_COMPRESS_BLOCK_HDR_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 1, -1);
+    UtAssert_INT32_EQ(CF_CFDP_R_ExpandChunk(txn, 100), CF_ERROR);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_write, 1);
+
+    /* temp file cannot be opened */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, &txn, NULL);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UtAssert_INT32_EQ(CF_CFDP_R_ExpandChunk(txn, 100), CF_ERROR);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_open, 1);
+    UtAssert_STUB_COUNT(CF_WrappedRename, 1);
+}
+
+void Test_CF_CFDP_R2_SubstateSendKeepAlive(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_CFDP_R2_SubstateSendKeepAlive(CF_Transaction_t *txn);
+     */
+    CF_Transaction_t *txn;
+    CF_ChunkWrapper_t chunks;
+    CF_Chunk_t        ut_chunk;
+    CF_FileSize_t     progress;
+
+    memset(&chunks, 0, sizeof(chunks));
+    UT_SetHandlerFunction(UT_KEY(CF_CFDP_SendKeepAlive), UT_AltHandler_CaptureKeepAliveProgress, &progress);
+
+    /* nothing received yet */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->chunks = &chunks;
+    progress    = 1;
+    UtAssert_INT32_EQ(CF_CFDP_R2_SubstateSendKeepAlive(txn), CFE_SUCCESS);
+    UtAssert_UINT32_EQ(progress, 0);
+
+    /* everything up to the first gap has been received */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->chunks     = &chunks;
+    ut_chunk.offset = 0;
+    ut_chunk.size   = 80;
+    UT_SetHandlerFunction(UT_KEY(CF_ChunkList_GetFirstChunk), UT_AltHandler_GenericPointerReturn, &ut_chunk);
+    UtAssert_INT32_EQ(CF_CFDP_R2_SubstateSendKeepAlive(txn), CFE_SUCCESS);
+    UtAssert_UINT32_EQ(progress, 80);
+
+    /* the start of the file is still missing */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->chunks     = &chunks;
+    ut_chunk.offset = 20;
+    ut_chunk.size   = 60;
+    UtAssert_INT32_EQ(CF_CFDP_R2_SubstateSendKeepAlive(txn), CFE_SUCCESS);
+    UtAssert_UINT32_EQ(progress, 0);
+    UtAssert_STUB_COUNT(CF_CFDP_SendKeepAlive, 3);
 }
 
 void Test_CF_CFDP_R2_Recv_fin_ack(void)
@@ -1034,6 +1978,44 @@ void Test_CF_CFDP_R2_Recv_fin_ack(void)
     UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.error, 1);
 }
 
+void Test_CF_CFDP_R2_RecvPrompt(void)
+{
+    /* Test case for:
+     * void CF_CFDP_R2_RecvPrompt(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph);
+     */
+    CF_Transaction_t *      txn;
+    CF_Logical_PduBuffer_t *ph;
+
+    /* prompt for a NAK before EOF */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    ph->int_header.prompt.response_required = CF_CFDP_PromptResponse_NAK;
+    UtAssert_VOIDCALL(CF_CFDP_R2_RecvPrompt(txn, ph));
+    UtAssert_BOOL_TRUE(txn->flags.rx.send_nak);
+    UtAssert_BOOL_TRUE(txn->flags.rx.prompted);
+
+    /* after EOF the usual NAK is sent */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    ph->int_header.prompt.response_required = CF_CFDP_PromptResponse_NAK;
+    txn->flags.rx.eof_recv                  = true;
+    UtAssert_VOIDCALL(CF_CFDP_R2_RecvPrompt(txn, ph));
+    UtAssert_BOOL_TRUE(txn->flags.rx.send_nak);
+    UtAssert_BOOL_FALSE(txn->flags.rx.prompted);
+
+    /* a keep alive prompt asks for a keep alive, not a NAK */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    ph->int_header.prompt.response_required = CF_CFDP_PromptResponse_KEEP_ALIVE;
+    UtAssert_VOIDCALL(CF_CFDP_R2_RecvPrompt(txn, ph));
+    UtAssert_BOOL_FALSE(txn->flags.rx.send_nak);
+    UtAssert_BOOL_TRUE(txn->flags.rx.send_keep_alive);
+
+    /* failure in CF_CFDP_RecvPrompt */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    UT_SetDeferredRetcode(UT_KEY(CF_CFDP_RecvPrompt), 1, CF_SHORT_PDU_ERROR);
+    UtAssert_VOIDCALL(CF_CFDP_R2_RecvPrompt(txn, ph));
+    UtAssert_BOOL_FALSE(txn->flags.rx.send_nak);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.error, 1);
+}
+
 void Test_CF_CFDP_R2_RecvMd(void)
 {
     /* Test case for:
@@ -1050,6 +2032,7 @@ void Test_CF_CFDP_R2_RecvMd(void)
     UtAssert_UINT32_EQ(txn->state_data.receive.cached_pos, 0);
     UtAssert_UINT32_EQ(txn->flags.rx.md_recv, 1);
     UtAssert_UINT32_EQ(txn->state_data.receive.r2.acknak_count, 0);
+    UtAssert_STUB_COUNT(CF_Ckpt_DropPartial, 1);
 
     /* md_recv already set */
     UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
@@ -1072,9 +2055,18 @@ void Test_CF_CFDP_R2_RecvMd(void)
     UT_CF_AssertEventID(CF_CFDP_R_EOF_MD_SIZE_ERR_EID);
     UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_FILE_SIZE_ERROR);
 
-    /* OS_mv failure */
+    /* EOF already received, and the metadata gives the size as unbounded */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    txn->fsize                          = 0;
+    txn->state_data.receive.r2.eof_size = 120;
+    txn->flags.rx.eof_recv              = true;
+    UtAssert_VOIDCALL(CF_CFDP_R2_RecvMd(txn, ph));
+    UtAssert_UINT32_EQ(txn->fsize, 120);
+    UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_NO_ERROR);
+
+    /* CF_WrappedRename failure */
     UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
-    UT_SetDeferredRetcode(UT_KEY(OS_mv), 1, CF_ERROR);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRename), 1, CF_ERROR);
     UtAssert_VOIDCALL(CF_CFDP_R2_RecvMd(txn, ph));
     UT_CF_AssertEventID(CF_CFDP_R_RENAME_ERR_EID);
     UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_FILESTORE_REJECTION);
@@ -1092,6 +2084,30 @@ void Test_CF_CFDP_R2_RecvMd(void)
     UtAssert_VOIDCALL(CF_CFDP_R2_RecvMd(txn, ph));
     UT_CF_AssertEventID(CF_CFDP_R_PDU_MD_ERR_EID);
     UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.error, 1);
+
+    /* staged in RAM, written directly to the destination without a rename */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    UT_ResetState(UT_KEY(CF_WrappedRename));
+    UT_ResetState(UT_KEY(CF_WrappedOpenCreate));
+    CF_AppData.engine.rx_staging[0].txn  = txn;
+    CF_AppData.engine.rx_staging[0].size = 0;
+    txn->state_data.receive.staging      = &CF_AppData.engine.rx_staging[0];
+    UtAssert_VOIDCALL(CF_CFDP_R2_RecvMd(txn, ph));
+    UtAssert_BOOL_TRUE(txn->flags.rx.md_recv);
+    UtAssert_NULL(txn->state_data.receive.staging);
+    UtAssert_STUB_COUNT(CF_WrappedRename, 0);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 1);
+
+    /* staged in RAM, flush failure */
+    UT_CFDP_R_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    CF_AppData.engine.rx_staging[0].txn = txn;
+    txn->state_data.receive.staging     = &CF_AppData.engine.rx_staging[0];
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, CF_ERROR);
+    UtAssert_VOIDCALL(CF_CFDP_R2_RecvMd(txn, ph));
+    UT_CF_AssertEventID(CF_CFDP_R_CREAT_ERR_EID);
+    UtAssert_BOOL_FALSE(txn->flags.rx.md_recv);
+    UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_FILESTORE_REJECTION);
+    UtAssert_STUB_COUNT(CF_WrappedRename, 0);
 }
 
 void Test_CF_CFDP_R_SendInactivityEvent(void)
@@ -1118,9 +2134,16 @@ void UtTest_Setup(void)
 {
     UtTest_Add(Test_CF_CFDP_R1_Recv, cf_cfdp_r_tests_Setup, cf_cfdp_r_tests_Teardown, "CF_CFDP_R1_Recv");
     UtTest_Add(Test_CF_CFDP_R2_Recv, cf_cfdp_r_tests_Setup, cf_cfdp_r_tests_Teardown, "CF_CFDP_R2_Recv");
+    UtTest_Add(Test_CF_CFDP_R_Respond, cf_cfdp_r_tests_Setup, cf_cfdp_r_tests_Teardown, "CF_CFDP_R_Respond");
     UtTest_Add(Test_CF_CFDP_R_Tick, cf_cfdp_r_tests_Setup, cf_cfdp_r_tests_Teardown, "CF_CFDP_R_Tick");
     UtTest_Add(Test_CF_CFDP_R_Cancel, cf_cfdp_r_tests_Setup, cf_cfdp_r_tests_Teardown, "CF_CFDP_R_Cancel");
     UtTest_Add(Test_CF_CFDP_R_Init, cf_cfdp_r_tests_Setup, cf_cfdp_r_tests_Teardown, "CF_CFDP_R_Init");
+    UtTest_Add(Test_CF_CFDP_R2_StagingAcquire, cf_cfdp_r_tests_Setup, cf_cfdp_r_tests_Teardown,
+               "CF_CFDP_R2_StagingAcquire");
+    UtTest_Add(Test_CF_CFDP_R2_StagingFlush, cf_cfdp_r_tests_Setup, cf_cfdp_r_tests_Teardown,
+               "CF_CFDP_R2_StagingFlush");
+    UtTest_Add(Test_CF_CFDP_R2_StagingRelease, cf_cfdp_r_tests_Setup, cf_cfdp_r_tests_Teardown,
+               "CF_CFDP_R2_StagingRelease");
     UtTest_Add(Test_CF_CFDP_R2_SetFinTxnStatus, cf_cfdp_r_tests_Setup, cf_cfdp_r_tests_Teardown,
                "CF_CFDP_R2_SetFinTxnStatus");
     UtTest_Add(Test_CF_CFDP_R1_Reset, cf_cfdp_r_tests_Setup, cf_cfdp_r_tests_Teardown, "CF_CFDP_R1_Reset");
@@ -1145,8 +2168,19 @@ void UtTest_Setup(void)
                "CF_CFDP_R2_CalcCrcChunk");
     UtTest_Add(Test_CF_CFDP_R2_SubstateSendFin, cf_cfdp_r_tests_Setup, cf_cfdp_r_tests_Teardown,
                "CF_CFDP_R2_SubstateSendFin");
+    UtTest_Add(Test_CF_CFDP_R_ExpandChunk, cf_cfdp_r_tests_Setup, cf_cfdp_r_tests_Teardown,
+               "CF_CFDP_R_ExpandChunk");
+    UtTest_Add(Test_CF_CFDP_R_ApplyDelta, cf_cfdp_r_tests_Setup, cf_cfdp_r_tests_Teardown, "CF_CFDP_R_ApplyDelta");
+    UtTest_Add(Test_CF_CFDP_R_Unbundle, cf_cfdp_r_tests_Setup, cf_cfdp_r_tests_Teardown, "CF_CFDP_R_Unbundle");
+    UtTest_Add(Test_CF_CFDP_R_DeltaSetAside, cf_cfdp_r_tests_Setup, cf_cfdp_r_tests_Teardown,
+               "CF_CFDP_R_DeltaSetAside");
+    UtTest_Add(Test_CF_CFDP_R_DeltaReset, cf_cfdp_r_tests_Setup, cf_cfdp_r_tests_Teardown, "CF_CFDP_R_DeltaReset");
+    UtTest_Add(Test_CF_CFDP_R2_SubstateSendKeepAlive, cf_cfdp_r_tests_Setup, cf_cfdp_r_tests_Teardown,
+               "CF_CFDP_R2_SubstateSendKeepAlive");
     UtTest_Add(Test_CF_CFDP_R2_Recv_fin_ack, cf_cfdp_r_tests_Setup, cf_cfdp_r_tests_Teardown,
                "CF_CFDP_R2_Recv_fin_ack");
+    UtTest_Add(Test_CF_CFDP_R2_RecvPrompt, cf_cfdp_r_tests_Setup, cf_cfdp_r_tests_Teardown,
+               "CF_CFDP_R2_RecvPrompt");
     UtTest_Add(Test_CF_CFDP_R2_RecvMd, cf_cfdp_r_tests_Setup, cf_cfdp_r_tests_Teardown, "CF_CFDP_R2_RecvMd");
     UtTest_Add(Test_CF_CFDP_R_SendInactivityEvent, cf_cfdp_r_tests_Setup, cf_cfdp_r_tests_Teardown,
                "CF_CFDP_R_SendInactivityEvent");
@@ -27,6 +27,34 @@
 #include "cf_cfdp_r.h"
 #include "cf_cfdp_s.h"
 
+/* moves the chunk handed out by CF_ChunkList_GetFirstChunk along as if it were trimmed */
+static void UT_AltHandler_RemoveFromFirst(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CF_Chunk_t *   chunk = UserObj;
+    CF_ChunkSize_t size  = UT_Hook_GetArgValueByName(Context, "size", CF_ChunkSize_t);
+
+    chunk->offset += size;
+    chunk->size -= size;
+}
+
+/* takes the delta work area for the send, as the real CF_Delta_Start() does */
+static void UT_AltHandler_DeltaStart(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CF_Delta_t *delta = UT_Hook_GetArgValueByName(Context, "delta", CF_Delta_t *);
+
+    delta->owner = UT_Hook_GetArgValueByName(Context, "owner", struct CF_Transaction *);
+}
+
+/* drops the data in the work area and leaves a block of room, as a shift after a block is encoded does */
+static void UT_AltHandler_DeltaShift(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CF_Delta_t *delta = UT_Hook_GetArgValueByName(Context, "delta", CF_Delta_t *);
+    uint32      room  = CF_DELTA_BLOCK_SIZE;
+
+    delta->buf_len = 0;
+    UT_Stub_SetReturnValue(FuncKey, room);
+}
+
 static void UT_CFDP_S_SetupBasicRxState(CF_Logical_PduBuffer_t *pdu_buffer)
 {
     static CF_DecoderState_t ut_decoder;
@@ -61,6 +89,30 @@ static void UT_CFDP_S_SetupBasicTxState(CF_Logical_PduBuffer_t *pdu_buffer)
     UT_SetHandlerFunction(UT_KEY(CF_CFDP_ConstructPduHeader), UT_AltHandler_GenericPointerReturn, pdu_buffer);
 }
 
+/* a bundle trailer of two files, whose index starts 20 bytes before it */
+static void UT_AltHandler_BundleTrailer(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    uint32 *count        = UT_Hook_GetArgValueByName(Context, "count", uint32 *);
+    uint32 *index_offset = UT_Hook_GetArgValueByName(Context, "index_offset", uint32 *);
+    uint32  fsize        = UT_Hook_GetArgValueByName(Context, "fsize", uint32);
+    bool    retval       = true;
+
+    *count        = 2;
+    *index_offset = fsize - CF_BUNDLE_TRAILER_SIZE - 20;
+    UT_Stub_SetReturnValue(FuncKey, retval);
+}
+
+/* an index entry of 10 bytes, for a file named "m" */
+static void UT_AltHandler_BundleEntry(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CF_BundleEntry_t *entry  = UT_Hook_GetArgValueByName(Context, "entry", CF_BundleEntry_t *);
+    uint32            retval = 10;
+
+    memset(entry, 0, sizeof(*entry));
+    strcpy(entry->name, "m");
+    UT_Stub_SetReturnValue(FuncKey, retval);
+}
+
 static void UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_t setup, CF_Logical_PduBuffer_t **pdu_buffer_p,
                                           CF_Channel_t **channel_p, CF_History_t **history_p, CF_Transaction_t **txn_p,
                                           CF_ConfigTable_t **config_table_p)
@@ -218,6 +270,35 @@ void Test_CF_CFDP_S2_Tx(void)
     UtAssert_VOIDCALL(CF_CFDP_S2_Tx(txn));
 }
 
+void Test_CF_CFDP_S_Respond(void)
+{
+    /* Test case for:
+     * void CF_CFDP_S_Respond(CF_Transaction_t *txn, int *cont);
+     */
+    CF_Transaction_t *txn;
+    int               cont;
+
+    /* not in CF_TxnState_S2, noop */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->state_data.send.sub_state = CF_TxSubState_SEND_FIN_ACK;
+    UtAssert_VOIDCALL(CF_CFDP_S_Respond(txn, &cont));
+    UtAssert_STUB_COUNT(CF_CFDP_SendAck, 0);
+
+    /* S2 without anything to answer */
+    txn->state                     = CF_TxnState_S2;
+    txn->state_data.send.sub_state = CF_TxSubState_WAIT_FOR_EOF_ACK;
+    UtAssert_VOIDCALL(CF_CFDP_S_Respond(txn, &cont));
+    UtAssert_STUB_COUNT(CF_CFDP_SendAck, 0);
+    UtAssert_STUB_COUNT(CF_CFDP_SendEof, 0);
+
+    /* FIN-ACK pending, no timers are touched */
+    txn->state_data.send.sub_state = CF_TxSubState_SEND_FIN_ACK;
+    UtAssert_VOIDCALL(CF_CFDP_S_Respond(txn, &cont));
+    UtAssert_STUB_COUNT(CF_CFDP_SendAck, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_ResetTransaction, 1);
+    UtAssert_STUB_COUNT(CF_Timer_Tick, 0);
+}
+
 void Test_CF_CFDP_S_Tick(void)
 {
     /* Test case for:
@@ -239,6 +320,21 @@ void Test_CF_CFDP_S_Tick(void)
     UtAssert_VOIDCALL(CF_CFDP_S_Tick(txn, &cont));
     UtAssert_STUB_COUNT(CF_Timer_Tick, 1);
 
+    /* a followed file waiting for more data is only checked for it, no timers run */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->chan[txn->chan_num].tx_follow_quiet_s = 1000;
+    txn->state                                    = CF_TxnState_S2;
+    txn->state_data.send.sub_state                = CF_TxSubState_FILEDATA;
+    txn->flags.tx.follow                          = true;
+    txn->flags.tx.follow_wait                     = true;
+    txn->fsize                                    = 100;
+    OS_GetLocalTime(&txn->state_data.send.follow_time);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 100);
+    UtAssert_VOIDCALL(CF_CFDP_S_Tick(txn, &cont));
+    UtAssert_STUB_COUNT(CF_WrappedLseek, 1);
+    UtAssert_STUB_COUNT(CF_Timer_Tick, 1);
+    UtAssert_BOOL_TRUE(txn->flags.tx.follow_wait);
+
     /* nominal, in CF_TxnState_S2, with timer expiry */
     UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
     UT_SetDeferredRetcode(UT_KEY(CF_Timer_Expired), 1, 1);
@@ -343,6 +439,18 @@ void Test_CF_CFDP_S_Cancel(void)
     txn->state_data.send.sub_state = CF_TxSubState_EOF;
     UtAssert_VOIDCALL(CF_CFDP_S_Cancel(txn));
     UtAssert_UINT32_EQ(txn->state_data.send.sub_state, CF_TxSubState_EOF);
+    UtAssert_STUB_COUNT(CF_InsertSortPrio, 0);
+
+    /* a followed file waiting for more data goes back to TXA to send its EOF */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->state_data.send.sub_state                                                  = CF_TxSubState_FILEDATA;
+    txn->flags.tx.follow                                                            = true;
+    txn->flags.tx.follow_wait                                                       = true;
+    CF_AppData.hk.Payload.channel_hk[txn->chan_num].q_size[txn->flags.com.q_index] = 1;
+    UtAssert_VOIDCALL(CF_CFDP_S_Cancel(txn));
+    UtAssert_UINT32_EQ(txn->state_data.send.sub_state, CF_TxSubState_EOF);
+    UtAssert_BOOL_FALSE(txn->flags.tx.follow_wait);
+    UtAssert_STUB_COUNT(CF_InsertSortPrio, 1);
 }
 
 void Test_CF_CFDP_S_SendEof(void)
@@ -365,6 +473,56 @@ void Test_CF_CFDP_S_SendEof(void)
     UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
     UT_SetDeferredRetcode(UT_KEY(CF_CFDP_SendEof), 1, CF_SEND_PDU_NO_BUF_AVAIL_ERROR);
     UtAssert_INT32_EQ(CF_CFDP_S_SendEof(txn), CF_SEND_PDU_NO_BUF_AVAIL_ERROR);
+
+    UtAssert_STUB_COUNT(CF_CRC_Finalize, 2);
+}
+
+void Test_CF_CFDP_S_GetFanOutCrc(void)
+{
+    /* Test case for:
+     * bool CF_CFDP_S_GetFanOutCrc(CF_Transaction_t *txn);
+     */
+    CF_Transaction_t *txn;
+    CF_ConfigTable_t *config;
+
+    /* single destination, nothing to do */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    UtAssert_BOOL_TRUE(CF_CFDP_S_GetFanOutCrc(txn));
+    UtAssert_STUB_COUNT(CF_FanOut_GetCrc, 0);
+    UtAssert_BOOL_FALSE(txn->flags.com.crc_calc);
+
+    /* multi-destination send takes the checksum from its group */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->rx_crc_calc_bytes_per_wakeup = CF_R2_CRC_CHUNK_SIZE;
+    txn->fanout                          = &CF_AppData.engine.fanouts[0];
+    UtAssert_BOOL_TRUE(CF_CFDP_S_GetFanOutCrc(txn));
+    UtAssert_STUB_COUNT(CF_FanOut_GetCrc, 1);
+    UtAssert_BOOL_TRUE(txn->flags.com.crc_calc);
+    UtAssert_NULL(CF_AppData.engine.channels[txn->chan_num].cur);
+
+    /* already complete, not read again */
+    UtAssert_BOOL_TRUE(CF_CFDP_S_GetFanOutCrc(txn));
+    UtAssert_STUB_COUNT(CF_FanOut_GetCrc, 1);
+
+    /* the reading for this wakeup is used up, carries on next time */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->rx_crc_calc_bytes_per_wakeup = CF_R2_CRC_CHUNK_SIZE;
+    UT_SetDeferredRetcode(UT_KEY(CF_FanOut_GetCrc), 1, CF_FANOUT_CRC_PENDING);
+    txn->fanout = &CF_AppData.engine.fanouts[0];
+    UtAssert_BOOL_FALSE(CF_CFDP_S_GetFanOutCrc(txn));
+    UtAssert_BOOL_FALSE(txn->flags.com.crc_calc);
+    UtAssert_ADDRESS_EQ(CF_AppData.engine.channels[txn->chan_num].cur, txn);
+
+    /* group could not read the rest of the file */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->rx_crc_calc_bytes_per_wakeup = CF_R2_CRC_CHUNK_SIZE;
+    UT_SetDeferredRetcode(UT_KEY(CF_FanOut_GetCrc), 1, CF_ERROR);
+    txn->fanout = &CF_AppData.engine.fanouts[0];
+    UtAssert_BOOL_TRUE(CF_CFDP_S_GetFanOutCrc(txn));
+    UT_CF_AssertEventID(CF_CFDP_S_READ_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_read, 1);
+    UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_FILESTORE_REJECTION);
+    UtAssert_BOOL_TRUE(txn->flags.com.crc_calc);
 }
 
 void Test_CF_CFDP_S1_SubstateSendEof(void)
@@ -384,6 +542,14 @@ void Test_CF_CFDP_S1_SubstateSendEof(void)
     UT_SetDeferredRetcode(UT_KEY(CF_CFDP_SendEof), 1, CF_SEND_PDU_NO_BUF_AVAIL_ERROR);
     UtAssert_VOIDCALL(CF_CFDP_S1_SubstateSendEof(txn));
     UtAssert_STUB_COUNT(CF_CFDP_ResetTransaction, 1); /* no increment */
+
+    /* multi-destination checksum not complete yet, no EOF */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    UT_SetDeferredRetcode(UT_KEY(CF_FanOut_GetCrc), 1, CF_FANOUT_CRC_PENDING);
+    txn->fanout = &CF_AppData.engine.fanouts[0];
+    UtAssert_VOIDCALL(CF_CFDP_S1_SubstateSendEof(txn));
+    UtAssert_STUB_COUNT(CF_CFDP_SendEof, 2);
+    UtAssert_STUB_COUNT(CF_CFDP_ResetTransaction, 1);
 }
 
 void Test_CF_CFDP_S2_SubstateSendEof(void)
@@ -399,6 +565,15 @@ void Test_CF_CFDP_S2_SubstateSendEof(void)
     UtAssert_VOIDCALL(CF_CFDP_S2_SubstateSendEof(txn));
     UtAssert_UINT32_EQ(txn->state_data.send.sub_state, CF_TxSubState_WAIT_FOR_EOF_ACK);
     UtAssert_BOOL_TRUE(txn->flags.com.ack_timer_armed);
+
+    /* multi-destination checksum not complete yet, stays put */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    UT_SetDeferredRetcode(UT_KEY(CF_FanOut_GetCrc), 1, CF_FANOUT_CRC_PENDING);
+    txn->fanout                    = &CF_AppData.engine.fanouts[0];
+    txn->state_data.send.sub_state = CF_TxSubState_EOF;
+    UtAssert_VOIDCALL(CF_CFDP_S2_SubstateSendEof(txn));
+    UtAssert_UINT32_EQ(txn->state_data.send.sub_state, CF_TxSubState_EOF);
+    UtAssert_STUB_COUNT(CF_InsertSortPrio, 1);
 }
 
 void Test_CF_CFDP_S_SendFileData(void)
@@ -408,9 +583,11 @@ void Test_CF_CFDP_S_SendFileData(void)
      */
     CF_Transaction_t *txn;
     CF_ConfigTable_t *config;
+    CF_Channel_t *    chan;
     uint32            cumulative_read;
     uint32            read_size;
     uint32            offset;
+    uint8             file_data[100];
 
     cumulative_read = 0;
     offset          = 0;
@@ -429,6 +606,9 @@ void Test_CF_CFDP_S_SendFileData(void)
     UtAssert_INT32_EQ(CF_CFDP_S_SendFileData(txn, offset, read_size, false), read_size);
     cumulative_read += read_size;
     UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.sent.file_data_bytes, cumulative_read);
+    UtAssert_UINT32_EQ(txn->history->perf.file_bytes, read_size);
+    UtAssert_UINT32_EQ(txn->history->perf.retx_bytes, read_size);
+    UtAssert_STUB_COUNT(CF_AddElapsedUsec, 1);
 
     /* nominal, larger than PDU, no CRC */
     UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
@@ -451,6 +631,9 @@ void Test_CF_CFDP_S_SendFileData(void)
     cumulative_read += config->outgoing_file_chunk_size;
     UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.sent.file_data_bytes, cumulative_read);
     UtAssert_STUB_COUNT(CF_CRC_Digest, 1);
+    UtAssert_UINT32_EQ(txn->history->perf.file_bytes, config->outgoing_file_chunk_size);
+    UtAssert_ZERO(txn->history->perf.retx_bytes);
+    UtAssert_STUB_COUNT(CF_AddElapsedUsec, 4); /* file I/O and CRC */
 
     /* read w/failure */
     UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
@@ -482,6 +665,73 @@ void Test_CF_CFDP_S_SendFileData(void)
     UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.sent.file_data_bytes, cumulative_read);
     UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_seek, 1);
     UT_CF_AssertEventID(CF_CFDP_S_SEEK_FD_ERR_EID);
+
+    /* peer is throttled by flow control - no buffer taken, resume here next wakeup */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, &chan, NULL, &txn, &config);
+    UT_SetDeferredRetcode(UT_KEY(CF_Flow_Permit), 1, false);
+    config->outgoing_file_chunk_size = read_size;
+    txn->fsize                       = 300;
+    UtAssert_INT32_EQ(CF_CFDP_S_SendFileData(txn, offset, read_size, true), 0);
+    UtAssert_ADDRESS_EQ(chan->cur, txn);
+    UtAssert_STUB_COUNT(CF_CFDP_ConstructPduHeader, 7);
+    UtAssert_STUB_COUNT(CF_CFDP_PerfWait, 1);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.sent.file_data_bytes, cumulative_read);
+    chan->cur = NULL;
+
+    /* class 2 file data is accounted as in flight until the peer responds */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, offset);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, read_size);
+    config->outgoing_file_chunk_size = read_size;
+    txn->fsize                       = 300;
+    txn->state                       = CF_TxnState_S2;
+    UtAssert_INT32_EQ(CF_CFDP_S_SendFileData(txn, offset, read_size, true), read_size);
+    UtAssert_UINT32_EQ(txn->state_data.send.s2.fc_in_flight, read_size);
+    UtAssert_STUB_COUNT(CF_Flow_Sent, 5);
+
+    /* multi-destination send reads through the shared group, which also does the checksum */
+    UT_ResetState(UT_KEY(CF_WrappedRead));
+    UT_ResetState(UT_KEY(CF_CRC_Digest));
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    UT_SetDeferredRetcode(UT_KEY(CF_FanOut_Read), 1, read_size);
+    config->outgoing_file_chunk_size = read_size;
+    txn->fsize                       = 300;
+    txn->fanout                      = &CF_AppData.engine.fanouts[0];
+    UtAssert_INT32_EQ(CF_CFDP_S_SendFileData(txn, offset, read_size, true), read_size);
+    UtAssert_STUB_COUNT(CF_FanOut_Read, 1);
+    UtAssert_STUB_COUNT(CF_WrappedRead, 0);
+    UtAssert_STUB_COUNT(CF_CRC_Digest, 0);
+
+    /* short read from the group */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    UT_SetDeferredRetcode(UT_KEY(CF_FanOut_Read), 1, 10);
+    config->outgoing_file_chunk_size = read_size;
+    txn->fsize                       = 300;
+    txn->fanout                      = &CF_AppData.engine.fanouts[0];
+    UtAssert_INT32_EQ(CF_CFDP_S_SendFileData(txn, offset, read_size, true), -1);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_read, 2);
+    UT_CF_AssertEventID(CF_CFDP_S_READ_ERR_EID);
+
+    /* the first block was read ahead, so it is sent from there and the buffer let go */
+    UT_ResetState(UT_KEY(CF_WrappedRead));
+    UT_ResetState(UT_KEY(CF_WrappedLseek));
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->outgoing_file_chunk_size      = read_size;
+    txn->fsize                            = 300;
+    txn->state_data.send.cached_pos       = read_size;
+    txn->state_data.send.prefetch         = &CF_AppData.engine.tx_prefetch[0];
+    CF_AppData.engine.tx_prefetch[0].txn  = txn;
+    CF_AppData.engine.tx_prefetch[0].size = read_size;
+    memset(CF_AppData.engine.tx_prefetch[0].data, 0x5a, read_size);
+    memset(file_data, 0, sizeof(file_data));
+    UT_SetHandlerFunction(UT_KEY(CF_CFDP_DoEncodeChunk), UT_AltHandler_GenericPointerReturn, file_data);
+    UtAssert_INT32_EQ(CF_CFDP_S_SendFileData(txn, 0, read_size, true), read_size);
+    UtAssert_STUB_COUNT(CF_WrappedRead, 0);
+    UtAssert_STUB_COUNT(CF_WrappedLseek, 0);
+    UtAssert_MemCmpValue(file_data, 0x5a, sizeof(file_data), "file data copied from the read ahead block");
+    UtAssert_UINT32_EQ(txn->state_data.send.cached_pos, read_size);
+    UtAssert_NULL(txn->state_data.send.prefetch);
+    UtAssert_NULL(CF_AppData.engine.tx_prefetch[0].txn);
 }
 
 void Test_CF_CFDP_S_SubstateSendFileData(void)
@@ -522,6 +772,239 @@ void Test_CF_CFDP_S_SubstateSendFileData(void)
     UtAssert_VOIDCALL(CF_CFDP_S_SubstateSendFileData(txn));
     UtAssert_UINT32_EQ(txn->state_data.send.sub_state, CF_TxSubState_EOF);
     UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_FILESTORE_REJECTION);
+
+    /* a followed file that has all been sent stays in file data to look for more */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->outgoing_file_chunk_size = CF_MAX_PDU_SIZE;
+    txn->state_data.send.sub_state   = CF_TxSubState_FILEDATA;
+    txn->fsize                       = CF_MAX_PDU_SIZE / 2;
+    txn->flags.tx.follow             = true;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, txn->fsize);
+    UtAssert_VOIDCALL(CF_CFDP_S_SubstateSendFileData(txn));
+    UtAssert_UINT32_EQ(txn->foffs, txn->fsize);
+    UtAssert_UINT32_EQ(txn->state_data.send.sub_state, CF_TxSubState_FILEDATA);
+
+    /* and the next time it checks the file */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, txn->fsize);
+    UtAssert_VOIDCALL(CF_CFDP_S_SubstateSendFileData(txn));
+    UtAssert_UINT32_EQ(txn->state_data.send.sub_state, CF_TxSubState_EOF);
+
+    /* all that is compressed so far has been sent, so the next block is compressed instead */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->outgoing_file_chunk_size = CF_MAX_PDU_SIZE;
+    txn->state_data.send.sub_state   = CF_TxSubState_FILEDATA;
+    txn->flags.tx.compressing        = true;
+    txn->raw_size                    = CF_COMPRESS_BLOCK_SIZE * 2;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, CF_COMPRESS_BLOCK_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_Compress_Pack), 1, CF_MAX_PDU_SIZE / 2);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 1, CF_MAX_PDU_SIZE / 2);
+    UtAssert_VOIDCALL(CF_CFDP_S_SubstateSendFileData(txn));
+    UtAssert_UINT32_EQ(txn->fsize, CF_MAX_PDU_SIZE / 2);
+    UtAssert_ZERO(txn->foffs);
+    UtAssert_UINT32_EQ(txn->state_data.send.sub_state, CF_TxSubState_FILEDATA);
+
+    /* what was compressed is sent, but the EOF waits while more is to come */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, CF_MAX_PDU_SIZE / 2);
+    UtAssert_VOIDCALL(CF_CFDP_S_SubstateSendFileData(txn));
+    UtAssert_UINT32_EQ(txn->foffs, txn->fsize);
+    UtAssert_UINT32_EQ(txn->zoffs, CF_COMPRESS_BLOCK_SIZE);
+    UtAssert_UINT32_EQ(txn->state_data.send.sub_state, CF_TxSubState_FILEDATA);
+
+    /* nothing was left to compress, so the EOF is next */
+    txn->zoffs = txn->raw_size;
+    UtAssert_VOIDCALL(CF_CFDP_S_SubstateSendFileData(txn));
+    UtAssert_BOOL_FALSE(txn->flags.tx.compressing);
+    UtAssert_UINT32_EQ(txn->state_data.send.sub_state, CF_TxSubState_EOF);
+    UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_UNDEFINED);
+
+    /* the next block could not be compressed */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->state_data.send.sub_state = CF_TxSubState_FILEDATA;
+    txn->flags.tx.compressing      = true;
+    txn->raw_size                  = CF_COMPRESS_BLOCK_SIZE;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, -1);
+    UtAssert_VOIDCALL(CF_CFDP_S_SubstateSendFileData(txn));
+    UtAssert_UINT32_EQ(txn->state_data.send.sub_state, CF_TxSubState_EOF);
+    UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_FILESTORE_REJECTION);
+}
+
+void Test_CF_CFDP_S_FollowFile(void)
+{
+    /* Test case for:
+     * void CF_CFDP_S_FollowFile(CF_Transaction_t *txn);
+     */
+    CF_Transaction_t *txn;
+    CF_ConfigTable_t *config;
+    CF_Channel_t *    chan;
+
+    /* the file grew, so there is more to send */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    txn->state_data.send.sub_state = CF_TxSubState_FILEDATA;
+    txn->flags.tx.follow           = true;
+    txn->fsize                     = 100;
+    txn->foffs                     = 100;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 150);
+    UtAssert_VOIDCALL(CF_CFDP_S_FollowFile(txn));
+    UtAssert_UINT32_EQ(txn->fsize, 150);
+    UtAssert_UINT32_EQ(txn->state_data.send.cached_pos, 150);
+    UtAssert_UINT32_EQ(txn->state_data.send.sub_state, CF_TxSubState_FILEDATA);
+
+    /* unchanged and not yet quiet for long enough, so it waits on TXW and leaves the channel to others */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, &chan, NULL, &txn, &config);
+    config->chan[txn->chan_num].tx_follow_quiet_s = 1000;
+    txn->state_data.send.sub_state                = CF_TxSubState_FILEDATA;
+    txn->flags.tx.follow                          = true;
+    txn->fsize                                    = 100;
+    txn->foffs                                    = 100;
+    OS_GetLocalTime(&txn->state_data.send.follow_time);
+    CF_AppData.hk.Payload.channel_hk[txn->chan_num].q_size[txn->flags.com.q_index] = 2; /* moved twice */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 100);
+    UtAssert_VOIDCALL(CF_CFDP_S_FollowFile(txn));
+    UtAssert_UINT32_EQ(txn->state_data.send.sub_state, CF_TxSubState_FILEDATA);
+    UtAssert_BOOL_TRUE(txn->flags.tx.follow_wait);
+    UtAssert_STUB_COUNT(CF_InsertSortPrio, 1);
+    UtAssert_NULL(chan->cur);
+    UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_UNDEFINED);
+
+    /* still nothing new, so it stays where it is */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 100);
+    UtAssert_VOIDCALL(CF_CFDP_S_FollowFile(txn));
+    UtAssert_BOOL_TRUE(txn->flags.tx.follow_wait);
+    UtAssert_STUB_COUNT(CF_InsertSortPrio, 1);
+
+    /* then the file grows, and it goes back to TXA to send the new data */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 150);
+    UtAssert_VOIDCALL(CF_CFDP_S_FollowFile(txn));
+    UtAssert_BOOL_FALSE(txn->flags.tx.follow_wait);
+    UtAssert_STUB_COUNT(CF_InsertSortPrio, 2);
+    UtAssert_UINT32_EQ(txn->fsize, 150);
+
+    /* unchanged for long enough, so the file is finished */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, &chan, NULL, &txn, &config);
+    txn->state_data.send.sub_state = CF_TxSubState_FILEDATA;
+    txn->flags.tx.follow           = true;
+    txn->fsize                     = 100;
+    txn->foffs                     = 100;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 100);
+    UtAssert_VOIDCALL(CF_CFDP_S_FollowFile(txn));
+    UtAssert_UINT32_EQ(txn->state_data.send.sub_state, CF_TxSubState_EOF);
+    UtAssert_NULL(chan->cur);
+    UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_UNDEFINED);
+
+    /* the file shrank */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    txn->state_data.send.sub_state = CF_TxSubState_FILEDATA;
+    txn->flags.tx.follow           = true;
+    txn->fsize                     = 100;
+    txn->foffs                     = 100;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 50);
+    UtAssert_VOIDCALL(CF_CFDP_S_FollowFile(txn));
+    UT_CF_AssertEventID(CF_CFDP_S_FOLLOW_ERR_EID);
+    UtAssert_UINT32_EQ(txn->state_data.send.sub_state, CF_TxSubState_EOF);
+    UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_FILE_SIZE_ERROR);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_size_mismatch, 1);
+
+    /* seek failed */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    txn->state_data.send.sub_state = CF_TxSubState_FILEDATA;
+    txn->flags.tx.follow           = true;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, -1);
+    UtAssert_VOIDCALL(CF_CFDP_S_FollowFile(txn));
+    UT_CF_AssertEventID(CF_CFDP_S_SEEK_END_ERR_EID);
+    UtAssert_UINT32_EQ(txn->state_data.send.sub_state, CF_TxSubState_EOF);
+    UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_FILESTORE_REJECTION);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_seek, 1);
+}
+
+void Test_CF_CFDP_S_Prefetch(void)
+{
+    /* Test case for:
+     * bool CF_CFDP_S_Prefetch(CF_Transaction_t *txn);
+     * void CF_CFDP_S_PrefetchRelease(CF_Transaction_t *txn);
+     */
+    CF_Transaction_t *txn;
+    CF_ConfigTable_t *config;
+    int               i;
+
+    /* every buffer is held */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    for (i = 0; i < CF_NUM_TX_PREFETCH_BUFFERS; ++i)
+    {
+        CF_AppData.engine.tx_prefetch[i].txn = txn;
+    }
+    UtAssert_BOOL_FALSE(CF_CFDP_S_Prefetch(txn));
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+    UtAssert_BOOL_FALSE(txn->flags.tx.prefetched);
+    memset(CF_AppData.engine.tx_prefetch, 0, sizeof(CF_AppData.engine.tx_prefetch));
+
+    /* with no setup, OS_FileOpenCheck returns SUCCESS, so the file is left for the metadata */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    UtAssert_BOOL_TRUE(CF_CFDP_S_Prefetch(txn));
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+    UtAssert_BOOL_FALSE(txn->flags.tx.prefetched);
+    UtAssert_NULL(txn->state_data.send.prefetch);
+
+    /* this retval is sticky and applies for the rest of the test cases */
+    UT_SetDefaultReturnValue(UT_KEY(OS_FileOpenCheck), OS_ERROR);
+
+    /* nominal, the first block is no more than a chunk */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->outgoing_file_chunk_size = 50;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 100);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, 50);
+    UtAssert_BOOL_TRUE(CF_CFDP_S_Prefetch(txn));
+    UtAssert_BOOL_TRUE(txn->flags.tx.prefetched);
+    UtAssert_UINT32_EQ(txn->fsize, 100);
+    UtAssert_ADDRESS_EQ(txn->state_data.send.prefetch, &CF_AppData.engine.tx_prefetch[0]);
+    UtAssert_ADDRESS_EQ(CF_AppData.engine.tx_prefetch[0].txn, txn);
+    UtAssert_UINT32_EQ(CF_AppData.engine.tx_prefetch[0].size, 50);
+    UtAssert_UINT32_EQ(txn->state_data.send.cached_pos, 50);
+
+    /* letting it go frees the buffer */
+    UtAssert_VOIDCALL(CF_CFDP_S_PrefetchRelease(txn));
+    UtAssert_NULL(txn->state_data.send.prefetch);
+    UtAssert_NULL(CF_AppData.engine.tx_prefetch[0].txn);
+    UtAssert_VOIDCALL(CF_CFDP_S_PrefetchRelease(txn));
+
+    /* a file smaller than a chunk is read whole */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->outgoing_file_chunk_size = 50;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 10);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, 10);
+    UtAssert_BOOL_TRUE(CF_CFDP_S_Prefetch(txn));
+    UtAssert_UINT32_EQ(CF_AppData.engine.tx_prefetch[0].size, 10);
+    UtAssert_STUB_COUNT(CF_WrappedRead, 2);
+    CF_CFDP_S_PrefetchRelease(txn);
+
+    /* an empty file is only opened */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->outgoing_file_chunk_size = 50;
+    UtAssert_BOOL_TRUE(CF_CFDP_S_Prefetch(txn));
+    UtAssert_BOOL_TRUE(txn->flags.tx.prefetched);
+    UtAssert_ZERO(CF_AppData.engine.tx_prefetch[0].size);
+    UtAssert_STUB_COUNT(CF_WrappedRead, 2);
+    CF_CFDP_S_PrefetchRelease(txn);
+
+    /* the file cannot be opened, which fails the send now */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UtAssert_BOOL_TRUE(CF_CFDP_S_Prefetch(txn));
+    UT_CF_AssertEventID(CF_CFDP_S_OPEN_ERR_EID);
+    UtAssert_BOOL_FALSE(txn->flags.tx.prefetched);
+    UtAssert_NULL(CF_AppData.engine.tx_prefetch[0].txn);
+    UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_FILESTORE_REJECTION);
+
+    /* the first block cannot be read */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->outgoing_file_chunk_size = 50;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 100);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, -1);
+    UtAssert_BOOL_TRUE(CF_CFDP_S_Prefetch(txn));
+    UT_CF_AssertEventID(CF_CFDP_S_READ_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_read, 1);
+    UtAssert_BOOL_FALSE(txn->flags.tx.prefetched);
+    UtAssert_NULL(CF_AppData.engine.tx_prefetch[0].txn);
+    UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_FILESTORE_REJECTION);
 }
 
 void Test_CF_CFDP_S_CheckAndRespondNak(void)
@@ -599,6 +1082,7 @@ void Test_CF_CFDP_S2_SubstateSendFileData(void)
      * void CF_CFDP_S2_SubstateSendFileData(CF_Transaction_t *txn);
      */
     CF_Transaction_t *txn;
+    CF_ConfigTable_t *config;
 
     /* nominal, just invokes CF_CFDP_S_SubstateSendFileData */
     UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
@@ -616,6 +1100,262 @@ void Test_CF_CFDP_S2_SubstateSendFileData(void)
     UT_SetDeferredRetcode(UT_KEY(CF_CFDP_SendMd), 1, CF_SEND_PDU_ERROR);
     UtAssert_VOIDCALL(CF_CFDP_S2_SubstateSendFileData(txn));
     UtAssert_STUB_COUNT(CF_CFDP_ResetTransaction, 1);
+
+    /* data the receiver already holds is skipped rather than sent */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->rx_crc_calc_bytes_per_wakeup = 1000;
+    txn->fsize                           = 300;
+    txn->state_data.send.s2.skip_to      = 100;
+    UT_SetDefaultReturnValue(UT_KEY(CF_WrappedRead), 100);
+    UT_ResetState(UT_KEY(CF_CFDP_SendFd));
+    UtAssert_VOIDCALL(CF_CFDP_S2_SubstateSendFileData(txn));
+    UtAssert_UINT32_EQ(txn->foffs, 100);
+    UtAssert_STUB_COUNT(CF_CFDP_SendFd, 0);
+
+    /* same, but prompt_nak_bytes of file data are now past the last prompt */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->rx_crc_calc_bytes_per_wakeup         = 1000;
+    config->chan[txn->chan_num].prompt_nak_bytes = 100;
+    txn->state                                   = CF_TxnState_S2;
+    txn->state_data.send.sub_state               = CF_TxSubState_FILEDATA;
+    txn->fsize                                   = 300;
+    txn->state_data.send.s2.skip_to              = 100;
+    UT_SetDefaultReturnValue(UT_KEY(CF_WrappedRead), 100);
+    UtAssert_VOIDCALL(CF_CFDP_S2_SubstateSendFileData(txn));
+    UtAssert_BOOL_TRUE(txn->flags.tx.send_prompt);
+
+    /* not yet enough file data since the last prompt */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->rx_crc_calc_bytes_per_wakeup         = 1000;
+    config->chan[txn->chan_num].prompt_nak_bytes = 100;
+    txn->state                                   = CF_TxnState_S2;
+    txn->state_data.send.sub_state               = CF_TxSubState_FILEDATA;
+    txn->fsize                                   = 300;
+    txn->state_data.send.s2.skip_to              = 100;
+    txn->state_data.send.s2.prompt_foffs         = 50;
+    UT_SetDefaultReturnValue(UT_KEY(CF_WrappedRead), 100);
+    UtAssert_VOIDCALL(CF_CFDP_S2_SubstateSendFileData(txn));
+    UtAssert_BOOL_FALSE(txn->flags.tx.send_prompt);
+
+    /* a prompt is due, it goes out before any file data */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->flags.tx.send_prompt = true;
+    txn->foffs                = 40;
+    UtAssert_VOIDCALL(CF_CFDP_S2_SubstateSendFileData(txn));
+    UtAssert_STUB_COUNT(CF_CFDP_SendPrompt, 1);
+    UtAssert_BOOL_FALSE(txn->flags.tx.send_prompt);
+    UtAssert_UINT32_EQ(txn->state_data.send.s2.prompt_foffs, 40);
+    UtAssert_STUB_COUNT(CF_CFDP_SendFd, 0);
+
+    /* same, but no buffer for the prompt, so it stays due */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    UT_SetDeferredRetcode(UT_KEY(CF_CFDP_SendPrompt), 1, CF_SEND_PDU_NO_BUF_AVAIL_ERROR);
+    txn->flags.tx.send_prompt = true;
+    UtAssert_VOIDCALL(CF_CFDP_S2_SubstateSendFileData(txn));
+    UtAssert_BOOL_TRUE(txn->flags.tx.send_prompt);
+    UtAssert_STUB_COUNT(CF_CFDP_SendFd, 0);
+}
+
+void Test_CF_CFDP_S2_SubstateSendFileData_PromptTimer(void)
+{
+    /* Test case for:
+     * void CF_CFDP_S2_SubstateSendFileData(CF_Transaction_t *txn);
+     * with a prompt interval, on an active transaction as CF_CFDP_CycleTx() runs it:
+     * once per file data PDU, many times per wakeup, and never from the tick
+     */
+    CF_Transaction_t *txn;
+    CF_ConfigTable_t *config;
+    uint32            sent;
+    int               i;
+
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->outgoing_file_chunk_size         = 100;
+    config->chan[txn->chan_num].prompt_nak_s = 5;
+    txn->state                               = CF_TxnState_S2;
+    txn->state_data.send.sub_state           = CF_TxSubState_FILEDATA;
+    txn->flags.com.q_index                   = CF_QueueIdx_TXA;
+    txn->fsize                               = 10000;
+    txn->state_data.send.s2.prompt_cycle     = CF_AppData.engine.cycle_num;
+    UT_SetDefaultReturnValue(UT_KEY(CF_WrappedRead), 100);
+
+    /* the cycle the timer was started on does not count */
+    UtAssert_VOIDCALL(CF_CFDP_S2_SubstateSendFileData(txn));
+    UtAssert_STUB_COUNT(CF_Timer_Tick, 0);
+
+    /* later cycles tick the timer once, however many PDUs go out */
+    for (i = 1; i <= 3; ++i)
+    {
+        ++CF_AppData.engine.cycle_num;
+        UtAssert_VOIDCALL(CF_CFDP_S2_SubstateSendFileData(txn));
+        UtAssert_VOIDCALL(CF_CFDP_S2_SubstateSendFileData(txn));
+        UtAssert_VOIDCALL(CF_CFDP_S2_SubstateSendFileData(txn));
+        UtAssert_STUB_COUNT(CF_Timer_Tick, i);
+    }
+    UtAssert_BOOL_FALSE(txn->flags.tx.send_prompt);
+    UtAssert_STUB_COUNT(CF_CFDP_SendPrompt, 0);
+
+    /* expired: the prompt goes out ahead of the file data of that cycle, and the timer restarts */
+    ++CF_AppData.engine.cycle_num;
+    UT_SetDeferredRetcode(UT_KEY(CF_Timer_Expired), 1, 1);
+    sent = UT_GetStubCount(UT_KEY(CF_CFDP_SendFd));
+    UtAssert_VOIDCALL(CF_CFDP_S2_SubstateSendFileData(txn));
+    UtAssert_STUB_COUNT(CF_Timer_InitRelSec, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_SendPrompt, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_SendFd, sent);
+    UtAssert_BOOL_FALSE(txn->flags.tx.send_prompt);
+    UtAssert_UINT32_EQ(txn->state_data.send.s2.prompt_foffs, txn->foffs);
+
+    /* the rest of that cycle is file data again, without another tick */
+    UtAssert_VOIDCALL(CF_CFDP_S2_SubstateSendFileData(txn));
+    UtAssert_STUB_COUNT(CF_CFDP_SendPrompt, 1);
+    UtAssert_STUB_COUNT(CF_Timer_Tick, 3);
+
+    /* no interval set, no timer */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    UT_ResetState(UT_KEY(CF_Timer_Expired));
+    UT_ResetState(UT_KEY(CF_Timer_Tick));
+    ++CF_AppData.engine.cycle_num;
+    UtAssert_VOIDCALL(CF_CFDP_S2_SubstateSendFileData(txn));
+    UtAssert_STUB_COUNT(CF_Timer_Expired, 0);
+    UtAssert_STUB_COUNT(CF_Timer_Tick, 0);
+}
+
+void Test_CF_CFDP_S2_SubstateSkipFileData(void)
+{
+    /* Test case for:
+     * void CF_CFDP_S2_SubstateSkipFileData(CF_Transaction_t *txn);
+     */
+    CF_Transaction_t *txn;
+    CF_ConfigTable_t *config;
+
+    /* nominal, up to where the receiver's data ends */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->rx_crc_calc_bytes_per_wakeup = 1000;
+    txn->fsize                           = 300;
+    txn->state_data.send.sub_state       = CF_TxSubState_FILEDATA;
+    txn->state_data.send.s2.skip_to      = 100;
+    UT_SetDefaultReturnValue(UT_KEY(CF_WrappedRead), 100);
+    UtAssert_VOIDCALL(CF_CFDP_S2_SubstateSkipFileData(txn));
+    UtAssert_UINT32_EQ(txn->foffs, 100);
+    UtAssert_UINT32_EQ(txn->state_data.send.cached_pos, 100);
+    UtAssert_UINT32_EQ(txn->state_data.send.sub_state, CF_TxSubState_FILEDATA);
+    UtAssert_STUB_COUNT(CF_CRC_Digest, 1);
+    UtAssert_STUB_COUNT(CF_WrappedLseek, 0);
+    UtAssert_NULL(CF_AppData.engine.channels[txn->chan_num].cur);
+
+    /* the reading for this wakeup is used up */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->rx_crc_calc_bytes_per_wakeup = 50;
+    txn->fsize                           = 3 * CF_R2_CRC_CHUNK_SIZE;
+    txn->state_data.send.s2.skip_to      = 2 * CF_R2_CRC_CHUNK_SIZE;
+    UT_SetDefaultReturnValue(UT_KEY(CF_WrappedRead), CF_R2_CRC_CHUNK_SIZE);
+    UtAssert_VOIDCALL(CF_CFDP_S2_SubstateSkipFileData(txn));
+    UtAssert_UINT32_EQ(txn->foffs, CF_R2_CRC_CHUNK_SIZE);
+    UtAssert_ADDRESS_EQ(CF_AppData.engine.channels[txn->chan_num].cur, txn);
+
+    /* the receiver holds the rest of the file */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->rx_crc_calc_bytes_per_wakeup = 1000;
+    txn->fsize                           = 100;
+    txn->state_data.send.s2.skip_to      = 100;
+    UT_SetDefaultReturnValue(UT_KEY(CF_WrappedRead), 100);
+    UtAssert_VOIDCALL(CF_CFDP_S2_SubstateSkipFileData(txn));
+    UtAssert_UINT32_EQ(txn->state_data.send.sub_state, CF_TxSubState_EOF);
+
+    /* read failure */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->rx_crc_calc_bytes_per_wakeup = 1000;
+    txn->fsize                           = 300;
+    txn->state_data.send.s2.skip_to      = 100;
+    UT_SetDefaultReturnValue(UT_KEY(CF_WrappedRead), -1);
+    UtAssert_VOIDCALL(CF_CFDP_S2_SubstateSkipFileData(txn));
+    UT_CF_AssertEventID(CF_CFDP_S_READ_ERR_EID);
+    UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_FILESTORE_REJECTION);
+    UtAssert_UINT32_EQ(txn->state_data.send.sub_state, CF_TxSubState_EOF);
+
+    /* seek failure */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->rx_crc_calc_bytes_per_wakeup = 1000;
+    txn->fsize                           = 300;
+    txn->foffs                           = 10;
+    txn->state_data.send.s2.skip_to      = 100;
+    UT_SetDefaultReturnValue(UT_KEY(CF_WrappedLseek), -1);
+    UtAssert_VOIDCALL(CF_CFDP_S2_SubstateSkipFileData(txn));
+    UT_CF_AssertEventID(CF_CFDP_S_SEEK_FD_ERR_EID);
+    UtAssert_UINT32_EQ(txn->foffs, 10);
+    UtAssert_UINT32_EQ(txn->state_data.send.sub_state, CF_TxSubState_EOF);
+
+    /* multi-destination send skips straight ahead, its group fills in the checksum */
+    UT_ResetState(UT_KEY(CF_WrappedRead));
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->rx_crc_calc_bytes_per_wakeup = 50;
+    txn->fsize                           = 300;
+    txn->state_data.send.sub_state       = CF_TxSubState_FILEDATA;
+    txn->state_data.send.s2.skip_to      = 200;
+    txn->fanout                          = &CF_AppData.engine.fanouts[0];
+    UtAssert_VOIDCALL(CF_CFDP_S2_SubstateSkipFileData(txn));
+    UtAssert_UINT32_EQ(txn->foffs, 200);
+    UtAssert_UINT32_EQ(txn->state_data.send.sub_state, CF_TxSubState_FILEDATA);
+    UtAssert_STUB_COUNT(CF_WrappedRead, 0);
+}
+
+void Test_CF_CFDP_S_CheckDelivered(void)
+{
+    /* Test case for:
+     * bool CF_CFDP_S_CheckDelivered(CF_Transaction_t *txn);
+     */
+    CF_Transaction_t *txn;
+    CF_ConfigTable_t *config;
+
+    /* this retval is sticky and applies for the rest of the test cases */
+    UT_SetDefaultReturnValue(UT_KEY(CF_WrappedRead), CF_R2_CRC_CHUNK_SIZE);
+
+    /* the reading for this wakeup is used up part way through */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->rx_crc_calc_bytes_per_wakeup = CF_R2_CRC_CHUNK_SIZE;
+    txn->fsize                           = CF_R2_CRC_CHUNK_SIZE * 2;
+    txn->flags.tx.delivered_check        = true;
+    txn->state_data.send.delivered_crc   = 0x55;
+    txn->crc.result                      = 0x55;
+    UtAssert_BOOL_TRUE(CF_CFDP_S_CheckDelivered(txn));
+    UtAssert_UINT32_EQ(txn->state_data.send.cached_pos, CF_R2_CRC_CHUNK_SIZE);
+    UtAssert_ADDRESS_EQ(CF_AppData.engine.channels[txn->chan_num].cur, txn);
+    UtAssert_BOOL_TRUE(txn->flags.tx.delivered_check);
+    UtAssert_STUB_COUNT(CF_CRC_Digest, 1);
+
+    /* the rest is read next time, and the checksum matches */
+    CF_AppData.engine.channels[txn->chan_num].cur = NULL;
+    UtAssert_BOOL_TRUE(CF_CFDP_S_CheckDelivered(txn));
+    UtAssert_NULL(CF_AppData.engine.channels[txn->chan_num].cur);
+    UtAssert_BOOL_FALSE(txn->flags.tx.delivered_check);
+    UtAssert_BOOL_TRUE(txn->flags.tx.delivered);
+    UtAssert_BOOL_TRUE(txn->flags.com.crc_calc);
+    UtAssert_STUB_COUNT(CF_CRC_Digest, 2);
+    UtAssert_STUB_COUNT(CF_CRC_Start, 0);
+
+    /* the file changed since it was delivered, checksum starts over for sending */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->rx_crc_calc_bytes_per_wakeup = CF_R2_CRC_CHUNK_SIZE * 4;
+    txn->fsize                           = CF_R2_CRC_CHUNK_SIZE;
+    txn->flags.tx.delivered_check        = true;
+    txn->state_data.send.delivered_crc   = 0x66;
+    txn->crc.result                      = 0x55;
+    UtAssert_BOOL_TRUE(CF_CFDP_S_CheckDelivered(txn));
+    UtAssert_BOOL_FALSE(txn->flags.tx.delivered_check);
+    UtAssert_BOOL_FALSE(txn->flags.tx.delivered);
+    UtAssert_BOOL_FALSE(txn->flags.com.crc_calc);
+    UtAssert_STUB_COUNT(CF_CRC_Start, 1);
+
+    /* read error */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->rx_crc_calc_bytes_per_wakeup = CF_R2_CRC_CHUNK_SIZE;
+    txn->fsize                           = CF_R2_CRC_CHUNK_SIZE;
+    txn->flags.tx.delivered_check        = true;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, -1);
+    UtAssert_BOOL_FALSE(CF_CFDP_S_CheckDelivered(txn));
+    UT_CF_AssertEventID(CF_CFDP_S_READ_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_read, 1);
+    UtAssert_BOOL_TRUE(txn->flags.tx.delivered_check);
 }
 
 void Test_CF_CFDP_S_SubstateSendMetadata(void)
@@ -623,7 +1363,9 @@ void Test_CF_CFDP_S_SubstateSendMetadata(void)
     /* Test case for:
      * void CF_CFDP_S_SubstateSendMetadata(CF_Transaction_t *txn);
      */
-    CF_Transaction_t *txn;
+    CF_Transaction_t *  txn;
+    CF_ConfigTable_t *  config;
+    CF_DeliveredEntry_t entry;
 
     /* with no setup, OS_FileOpenCheck returns SUCCESS (true) */
     UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
@@ -638,6 +1380,14 @@ void Test_CF_CFDP_S_SubstateSendMetadata(void)
     UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
     UtAssert_UINT32_EQ(txn->state_data.send.sub_state, CF_TxSubState_FILEDATA);
 
+    /* resumed from a checkpoint after all file data was sent, so straight on to the EOF */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    OS_OpenCreate(&txn->fd, "ut", 0, 0); /* sets fd */
+    txn->fsize = 100;
+    txn->foffs = 100;
+    UtAssert_VOIDCALL(CF_CFDP_S_SubstateSendMetadata(txn));
+    UtAssert_UINT32_EQ(txn->state_data.send.sub_state, CF_TxSubState_EOF);
+
     /* this retval is sticky and applies for the rest of the test cases */
     UT_SetDefaultReturnValue(UT_KEY(OS_FileOpenCheck), OS_ERROR);
 
@@ -683,6 +1433,575 @@ void Test_CF_CFDP_S_SubstateSendMetadata(void)
     UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
     UtAssert_VOIDCALL(CF_CFDP_S_SubstateSendMetadata(txn));
     UtAssert_UINT32_EQ(txn->state_data.send.sub_state, CF_TxSubState_FILEDATA);
+    UtAssert_STUB_COUNT(CF_Timer_InitRelSec, 0);
+
+    /* same for S2, which starts counting towards the next prompt */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->state = CF_TxnState_S2;
+    txn->foffs = 20;
+    UtAssert_VOIDCALL(CF_CFDP_S_SubstateSendMetadata(txn));
+    UtAssert_UINT32_EQ(txn->state_data.send.sub_state, CF_TxSubState_FILEDATA);
+    UtAssert_UINT32_EQ(txn->state_data.send.s2.prompt_foffs, 20);
+    UtAssert_STUB_COUNT(CF_Timer_InitRelSec, 1);
+
+    /* multi-destination send, the group already has the file open */
+    UT_ResetState(UT_KEY(CF_WrappedOpenCreate));
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    CF_AppData.engine.fanouts[0].fsize = 500;
+    txn->fanout                        = &CF_AppData.engine.fanouts[0];
+    UtAssert_VOIDCALL(CF_CFDP_S_SubstateSendMetadata(txn));
+    UtAssert_UINT32_EQ(txn->fsize, 500);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+    UtAssert_UINT32_EQ(txn->state_data.send.sub_state, CF_TxSubState_FILEDATA);
+
+    /* already delivered with the same contents, so nothing is sent */
+    UT_ResetState(UT_KEY(CF_CFDP_SendMd));
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->chan[txn->chan_num].tx_skip_delivered = 1;
+    memset(&entry, 0, sizeof(entry));
+    UT_SetHandlerFunction(UT_KEY(CF_Delivered_Find), UT_AltHandler_GenericPointerReturn, &entry);
+    UtAssert_VOIDCALL(CF_CFDP_S_SubstateSendMetadata(txn));
+    UT_CF_AssertEventID(CF_CFDP_S_DELIVERED_INF_EID);
+    UtAssert_BOOL_TRUE(txn->flags.tx.delivered);
+    UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_NO_ERROR);
+    UtAssert_STUB_COUNT(CF_CFDP_SendMd, 0);
+
+    /* the contents changed, so it is sent as usual */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->chan[txn->chan_num].tx_skip_delivered = 1;
+    entry.crc                                     = 0x66;
+    UtAssert_VOIDCALL(CF_CFDP_S_SubstateSendMetadata(txn));
+    UtAssert_BOOL_FALSE(txn->flags.tx.delivered);
+    UtAssert_STUB_COUNT(CF_CFDP_SendMd, 1);
+    UtAssert_UINT32_EQ(txn->state_data.send.sub_state, CF_TxSubState_FILEDATA);
+
+    /* not looked up unless the channel has it enabled */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    UtAssert_VOIDCALL(CF_CFDP_S_SubstateSendMetadata(txn));
+    UtAssert_STUB_COUNT(CF_Delivered_Find, 2);
+
+    /* compressed as it is sent, so the metadata goes straight away with the file yet to be compressed */
+    UT_ResetState(UT_KEY(CF_CFDP_SendMd));
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->chan[txn->chan_num].tx_compress = 1;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 100);
+    UtAssert_VOIDCALL(CF_CFDP_S_SubstateSendMetadata(txn));
+    UtAssert_BOOL_TRUE(txn->flags.tx.compressing);
+    UtAssert_BOOL_TRUE(txn->flags.com.compressed);
+    UtAssert_UINT32_EQ(txn->raw_size, 100);
+    UtAssert_ZERO(txn->fsize);
+    UtAssert_STUB_COUNT(CF_CFDP_SendMd, 1);
+    UtAssert_UINT32_EQ(txn->state_data.send.sub_state, CF_TxSubState_FILEDATA);
+    UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_UNDEFINED);
+
+    /* the command turns it off, whatever the channel has */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->chan[txn->chan_num].tx_compress = 1;
+    txn->compress                           = CF_TxCompress_OFF;
+    UtAssert_VOIDCALL(CF_CFDP_S_SubstateSendMetadata(txn));
+    UtAssert_BOOL_FALSE(txn->flags.tx.compressing);
+    UtAssert_STUB_COUNT(CF_CFDP_SendMd, 2);
+
+    /* or on, on a channel that does not */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    txn->compress = CF_TxCompress_ON;
+    UtAssert_VOIDCALL(CF_CFDP_S_SubstateSendMetadata(txn));
+    UtAssert_BOOL_TRUE(txn->flags.tx.compressing);
+    UtAssert_STUB_COUNT(CF_CFDP_SendMd, 3);
+    UT_ResetState(UT_KEY(CF_CFDP_SendMd));
+
+    /* the file could not be compressed */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->chan[txn->chan_num].tx_compress = 1;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 2, -1);
+    UtAssert_VOIDCALL(CF_CFDP_S_SubstateSendMetadata(txn));
+    UT_CF_AssertEventID(CF_CFDP_S_COMPRESS_ERR_EID);
+    UtAssert_STUB_COUNT(CF_CFDP_SendMd, 0);
+    UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_FILESTORE_REJECTION);
+
+    /* a class 2 send made into a delta first, which also waits for the metadata */
+    UT_SetHandlerFunction(UT_KEY(CF_Delta_Start), UT_AltHandler_DeltaStart, NULL);
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    txn->state                              = CF_TxnState_S2;
+    config->chan[txn->chan_num].tx_delta    = 1;
+    config->chan[txn->chan_num].tx_compress = 1;
+    config->rx_crc_calc_bytes_per_wakeup    = 0;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 100);
+    UtAssert_VOIDCALL(CF_CFDP_S_SubstateSendMetadata(txn));
+    UtAssert_BOOL_TRUE(txn->flags.tx.delta_encoding);
+    UtAssert_BOOL_FALSE(txn->flags.tx.compressing);
+    UtAssert_ADDRESS_EQ(CF_AppData.engine.delta.owner, txn);
+    UtAssert_STUB_COUNT(CF_CFDP_SendMd, 0);
+    CF_AppData.engine.channels[txn->chan_num].cur = NULL;
+    CF_AppData.engine.delta.owner                 = NULL;
+
+    /* class 1 is never sent as a delta */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->chan[txn->chan_num].tx_delta = 1;
+    UtAssert_VOIDCALL(CF_CFDP_S_SubstateSendMetadata(txn));
+    UtAssert_BOOL_FALSE(txn->flags.tx.delta_encoding);
+    UtAssert_STUB_COUNT(CF_Delta_Start, 1);
+
+    /* a bundle is sent as it is */
+    UT_ResetState(UT_KEY(CF_CFDP_SendMd));
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    txn->state                                    = CF_TxnState_S2;
+    txn->flags.com.bundle                         = true;
+    config->chan[txn->chan_num].tx_skip_delivered = 1;
+    config->chan[txn->chan_num].tx_delta          = 1;
+    config->chan[txn->chan_num].tx_compress       = 1;
+    UtAssert_VOIDCALL(CF_CFDP_S_SubstateSendMetadata(txn));
+    UtAssert_BOOL_FALSE(txn->flags.tx.delivered_check);
+    UtAssert_BOOL_FALSE(txn->flags.tx.delta_encoding);
+    UtAssert_BOOL_FALSE(txn->flags.tx.compressing);
+    UtAssert_STUB_COUNT(CF_Delivered_Find, 2);
+    UtAssert_STUB_COUNT(CF_CFDP_SendMd, 1);
+
+    /* a followed file is sent as it is too, since it is not finished yet */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    txn->state                                    = CF_TxnState_S2;
+    txn->flags.tx.follow                          = true;
+    config->chan[txn->chan_num].tx_skip_delivered = 1;
+    config->chan[txn->chan_num].tx_delta          = 1;
+    config->chan[txn->chan_num].tx_compress       = 1;
+    UtAssert_VOIDCALL(CF_CFDP_S_SubstateSendMetadata(txn));
+    UtAssert_BOOL_FALSE(txn->flags.tx.delivered_check);
+    UtAssert_BOOL_FALSE(txn->flags.tx.delta_encoding);
+    UtAssert_BOOL_FALSE(txn->flags.tx.compressing);
+    UtAssert_STUB_COUNT(CF_Delivered_Find, 2);
+    UtAssert_STUB_COUNT(CF_CFDP_SendMd, 2);
+    UtAssert_UINT32_EQ(txn->state_data.send.sub_state, CF_TxSubState_FILEDATA);
+
+    /* opened and read ahead while pending, so it is not opened again */
+    UT_ResetState(UT_KEY(CF_WrappedOpenCreate));
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    OS_OpenCreate(&txn->fd, "ut", 0, 0); /* sets fd */
+    txn->fsize                            = 100;
+    txn->flags.tx.prefetched              = true;
+    txn->state_data.send.prefetch         = &CF_AppData.engine.tx_prefetch[0];
+    CF_AppData.engine.tx_prefetch[0].txn  = txn;
+    CF_AppData.engine.tx_prefetch[0].size = 50;
+    UtAssert_VOIDCALL(CF_CFDP_S_SubstateSendMetadata(txn));
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+    UtAssert_BOOL_FALSE(txn->flags.tx.prefetched);
+    UtAssert_ADDRESS_EQ(txn->state_data.send.prefetch, &CF_AppData.engine.tx_prefetch[0]);
+    UtAssert_UINT32_EQ(txn->fsize, 100);
+    UtAssert_UINT32_EQ(txn->state_data.send.sub_state, CF_TxSubState_FILEDATA);
+    CF_CFDP_S_PrefetchRelease(txn);
+
+    /* checked against an earlier delivery, the block read ahead goes into the checksum first */
+    UT_ResetState(UT_KEY(CF_CRC_Digest));
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    OS_OpenCreate(&txn->fd, "ut", 0, 0); /* sets fd */
+    config->chan[txn->chan_num].tx_skip_delivered = 1;
+    config->rx_crc_calc_bytes_per_wakeup          = 0;
+    txn->fsize                                    = 100;
+    txn->flags.tx.prefetched                      = true;
+    txn->state_data.send.cached_pos               = 50;
+    txn->state_data.send.prefetch                 = &CF_AppData.engine.tx_prefetch[0];
+    CF_AppData.engine.tx_prefetch[0].txn          = txn;
+    CF_AppData.engine.tx_prefetch[0].size         = 50;
+    UtAssert_VOIDCALL(CF_CFDP_S_SubstateSendMetadata(txn));
+    UtAssert_BOOL_TRUE(txn->flags.tx.delivered_check);
+    UtAssert_STUB_COUNT(CF_CRC_Digest, 1);
+    UtAssert_UINT32_EQ(txn->state_data.send.cached_pos, 50);
+    CF_AppData.engine.channels[txn->chan_num].cur = NULL;
+    CF_CFDP_S_PrefetchRelease(txn);
+
+    /* compressed as it goes, so the block read ahead is of no use */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    OS_OpenCreate(&txn->fd, "ut", 0, 0); /* sets fd */
+    config->chan[txn->chan_num].tx_compress = 1;
+    txn->fsize                              = 100;
+    txn->flags.tx.prefetched                = true;
+    txn->state_data.send.prefetch           = &CF_AppData.engine.tx_prefetch[0];
+    CF_AppData.engine.tx_prefetch[0].txn    = txn;
+    UtAssert_VOIDCALL(CF_CFDP_S_SubstateSendMetadata(txn));
+    UtAssert_BOOL_TRUE(txn->flags.tx.compressing);
+    UtAssert_NULL(txn->state_data.send.prefetch);
+    UtAssert_NULL(CF_AppData.engine.tx_prefetch[0].txn);
+}
+
+void Test_CF_CFDP_S_DeltaChunk(void)
+{
+    /* Test case for:
+     * bool CF_CFDP_S_DeltaChunk(CF_Transaction_t *txn);
+     */
+    CF_Transaction_t *txn;
+    CF_ConfigTable_t *config;
+    CF_Transaction_t  other;
+
+    /* these retvals and handlers are sticky and apply for the rest of the test cases */
+    UT_SetHandlerFunction(UT_KEY(CF_Delta_Start), UT_AltHandler_DeltaStart, NULL);
+    UT_SetHandlerFunction(UT_KEY(CF_Delta_Shift), UT_AltHandler_DeltaShift, NULL);
+    UT_SetDefaultReturnValue(UT_KEY(CF_WrappedRead), CF_DELTA_BLOCK_SIZE);
+    UT_SetDefaultReturnValue(UT_KEY(CF_WrappedWrite), CF_DELTA_HDR_SIZE);
+
+    /* no earlier delivery, so the first block is only signed, then the reading for this wakeup is used up */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->rx_crc_calc_bytes_per_wakeup    = CF_DELTA_BLOCK_SIZE;
+    config->chan[txn->chan_num].tx_compress = 1;
+    txn->fsize                              = CF_DELTA_BLOCK_SIZE * 2;
+    txn->flags.tx.delta_encoding            = true;
+    UtAssert_BOOL_TRUE(CF_CFDP_S_DeltaChunk(txn));
+    UtAssert_ADDRESS_EQ(CF_AppData.engine.delta.owner, txn);
+    UtAssert_ADDRESS_EQ(CF_AppData.engine.channels[txn->chan_num].cur, txn);
+    UtAssert_UINT32_EQ(txn->zoffs, CF_DELTA_BLOCK_SIZE);
+    UtAssert_BOOL_FALSE(txn->flags.com.delta);
+    UtAssert_STUB_COUNT(CF_Delta_AddSigs, 1);
+    UtAssert_STUB_COUNT(CF_CRC_Digest, 0);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 0);
+
+    /* the rest is signed next time, the signatures are kept aside and the file is sent whole */
+    CF_AppData.engine.channels[txn->chan_num].cur = NULL;
+    UT_SetDeferredRetcode(UT_KEY(CF_Delta_Encode), 1, true);
+    UtAssert_BOOL_TRUE(CF_CFDP_S_DeltaChunk(txn));
+    UtAssert_NULL(CF_AppData.engine.channels[txn->chan_num].cur);
+    UtAssert_NULL(CF_AppData.engine.delta.owner);
+    UtAssert_BOOL_FALSE(txn->flags.tx.delta_encoding);
+    UtAssert_BOOL_TRUE(txn->flags.tx.delta_sigs);
+    UtAssert_BOOL_TRUE(txn->flags.tx.compressing);
+    UtAssert_UINT32_EQ(txn->fsize, CF_DELTA_BLOCK_SIZE * 2);
+    UtAssert_STUB_COUNT(CF_Delta_SaveSigs, 1);
+    UtAssert_STUB_COUNT(CF_Delta_Start, 1);
+
+    /* the signatures of the earlier delivery are on hand, so a delta replaces the file */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->rx_crc_calc_bytes_per_wakeup = CF_DELTA_BLOCK_SIZE;
+    txn->fsize                           = CF_DELTA_BLOCK_SIZE;
+    UT_SetDeferredRetcode(UT_KEY(CF_Delta_LoadSigs), 1, true);
+    UT_SetDeferredRetcode(UT_KEY(CF_Delta_Encode), 1, true);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 2, 300);
+    UtAssert_BOOL_TRUE(CF_CFDP_S_DeltaChunk(txn));
+    UtAssert_BOOL_TRUE(txn->flags.com.delta);
+    UtAssert_BOOL_FALSE(txn->flags.tx.compressing);
+    UtAssert_UINT32_EQ(txn->raw_size, CF_DELTA_BLOCK_SIZE);
+    UtAssert_UINT32_EQ(txn->fsize, 300);
+    UtAssert_UINT32_EQ(txn->state_data.send.cached_pos, 300);
+    UtAssert_STUB_COUNT(CF_Delta_PutHeader, 1);
+    UtAssert_STUB_COUNT(CF_CRC_Finalize, 1);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+
+    /* another send holds the work area, so this one waits */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    CF_AppData.engine.delta.owner = &other;
+    UtAssert_BOOL_TRUE(CF_CFDP_S_DeltaChunk(txn));
+    UtAssert_ADDRESS_EQ(CF_AppData.engine.channels[txn->chan_num].cur, txn);
+    UtAssert_ADDRESS_EQ(CF_AppData.engine.delta.owner, &other);
+    UtAssert_STUB_COUNT(CF_Delta_Start, 2);
+    CF_AppData.engine.channels[txn->chan_num].cur = NULL;
+    CF_AppData.engine.delta.owner                 = NULL;
+
+    /* too big to sign, so its signatures are dropped and it is sent whole */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    txn->fsize                   = CF_DELTA_BLOCK_SIZE * (CF_DELTA_MAX_BLOCKS + 1);
+    txn->flags.tx.delta_encoding = true;
+    UtAssert_BOOL_TRUE(CF_CFDP_S_DeltaChunk(txn));
+    UtAssert_NULL(CF_AppData.engine.delta.owner);
+    UtAssert_BOOL_FALSE(txn->flags.tx.delta_encoding);
+    UtAssert_BOOL_FALSE(txn->flags.tx.delta_sigs);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 1);
+
+    /* the signatures cannot be kept */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->rx_crc_calc_bytes_per_wakeup = CF_DELTA_BLOCK_SIZE;
+    txn->fsize                           = CF_DELTA_BLOCK_SIZE;
+    UT_SetDeferredRetcode(UT_KEY(CF_Delta_Encode), 1, true);
+    UT_SetDeferredRetcode(UT_KEY(CF_Delta_SaveSigs), 1, CF_ERROR);
+    UtAssert_BOOL_TRUE(CF_CFDP_S_DeltaChunk(txn));
+    UT_CF_AssertEventID(CF_CFDP_S_DELTA_ERR_EID);
+    UtAssert_BOOL_FALSE(txn->flags.tx.delta_sigs);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 2);
+
+    /* seek error */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->rx_crc_calc_bytes_per_wakeup = CF_DELTA_BLOCK_SIZE;
+    txn->fsize                           = CF_DELTA_BLOCK_SIZE;
+    txn->state_data.send.cached_pos      = 5;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, -1);
+    UtAssert_BOOL_FALSE(CF_CFDP_S_DeltaChunk(txn));
+    UT_CF_AssertEventID(CF_CFDP_S_SEEK_FD_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_seek, 1);
+    CF_AppData.engine.delta.owner = NULL;
+
+    /* read error */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->rx_crc_calc_bytes_per_wakeup = CF_DELTA_BLOCK_SIZE;
+    txn->fsize                           = CF_DELTA_BLOCK_SIZE;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, -1);
+    UtAssert_BOOL_FALSE(CF_CFDP_S_DeltaChunk(txn));
+    UT_CF_AssertEventID(CF_CFDP_S_READ_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_read, 1);
+    CF_AppData.engine.delta.owner = NULL;
+
+    /* write error */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->rx_crc_calc_bytes_per_wakeup = CF_DELTA_BLOCK_SIZE;
+    txn->fsize                           = CF_DELTA_BLOCK_SIZE;
+    UT_SetDeferredRetcode(UT_KEY(CF_Delta_LoadSigs), 1, true);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 1, 1);
+    UtAssert_BOOL_FALSE(CF_CFDP_S_DeltaChunk(txn));
+    UT_CF_AssertEventID(CF_CFDP_S_DELTA_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_write, 1);
+    CF_AppData.engine.delta.owner = NULL;
+
+    /* the header cannot be written */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    config->rx_crc_calc_bytes_per_wakeup = CF_DELTA_BLOCK_SIZE;
+    txn->fsize                           = CF_DELTA_BLOCK_SIZE;
+    UT_SetDeferredRetcode(UT_KEY(CF_Delta_LoadSigs), 1, true);
+    UT_SetDeferredRetcode(UT_KEY(CF_Delta_Encode), 1, true);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, -1);
+    UtAssert_BOOL_FALSE(CF_CFDP_S_DeltaChunk(txn));
+    UT_CF_AssertEventID(CF_CFDP_S_DELTA_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_write, 2);
+
+    /* the temp file cannot be opened */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, &config);
+    UT_SetDeferredRetcode(UT_KEY(CF_Delta_LoadSigs), 1, true);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UtAssert_BOOL_FALSE(CF_CFDP_S_DeltaChunk(txn));
+    UT_CF_AssertEventID(CF_CFDP_S_DELTA_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_open, 1);
+    UtAssert_BOOL_FALSE(txn->flags.com.delta);
+}
+
+void Test_CF_CFDP_S_DeltaReset(void)
+{
+    /* Test case for:
+     * void CF_CFDP_S_DeltaReset(CF_Transaction_t *txn);
+     */
+    CF_Transaction_t *txn;
+
+    /* nothing to settle, but the work area is let go of */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    CF_AppData.engine.delta.owner = txn;
+    UtAssert_VOIDCALL(CF_CFDP_S_DeltaReset(txn));
+    UtAssert_NULL(CF_AppData.engine.delta.owner);
+    UtAssert_STUB_COUNT(CF_WrappedRename, 0);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 0);
+
+    /* delivered, so the signatures are kept for the next send */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->state               = CF_TxnState_S2;
+    txn->history->txn_stat   = CF_TxnStatus_NO_ERROR;
+    txn->flags.com.crc_calc  = true;
+    txn->flags.tx.delta_sigs = true;
+    UtAssert_VOIDCALL(CF_CFDP_S_DeltaReset(txn));
+    UtAssert_STUB_COUNT(CF_WrappedRename, 1);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 0);
+    UtAssert_BOOL_FALSE(txn->flags.tx.delta_sigs);
+
+    /* and dropped if they cannot be */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->state               = CF_TxnState_S2;
+    txn->history->txn_stat   = CF_TxnStatus_NO_ERROR;
+    txn->flags.com.crc_calc  = true;
+    txn->flags.tx.delta_sigs = true;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRename), 1, OS_ERROR);
+    UtAssert_VOIDCALL(CF_CFDP_S_DeltaReset(txn));
+    UT_CF_AssertEventID(CF_CFDP_S_DELTA_ERR_EID);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 2);
+
+    /* a failed delta drops both, so the next send is whole */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->state               = CF_TxnState_S2;
+    txn->history->txn_stat   = CF_TxnStatus_FILE_CHECKSUM_FAILURE;
+    txn->flags.tx.delta_sigs = true;
+    txn->flags.com.delta     = true;
+    UtAssert_VOIDCALL(CF_CFDP_S_DeltaReset(txn));
+    UtAssert_STUB_COUNT(CF_WrappedRename, 2);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 4);
+}
+
+void Test_CF_CFDP_S_BundleReset(void)
+{
+    /* Test case for:
+     * void CF_CFDP_S_BundleReset(CF_Transaction_t *txn);
+     */
+    CF_Transaction_t *txn;
+    CF_Playback_t     pb;
+
+    UT_SetHandlerFunction(UT_KEY(CF_Bundle_ParseTrailer), UT_AltHandler_BundleTrailer, NULL);
+    UT_SetHandlerFunction(UT_KEY(CF_Bundle_ParseEntry), UT_AltHandler_BundleEntry, NULL);
+    memset(&pb, 0, sizeof(pb));
+
+    /* not a bundle, nothing to do */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->pb = &pb;
+    UtAssert_VOIDCALL(CF_CFDP_S_BundleReset(txn));
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 0);
+
+    /* sent, so each file in the index goes on to the move directory, and the bundle is removed */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->pb               = &pb;
+    txn->flags.com.bundle = true;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 100);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 100 - CF_BUNDLE_TRAILER_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 100 - CF_BUNDLE_TRAILER_SIZE - 20);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, CF_BUNDLE_TRAILER_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, 20);
+    UtAssert_VOIDCALL(CF_CFDP_S_BundleReset(txn));
+    UtAssert_STUB_COUNT(CF_Bundle_ParseEntry, 2);
+    UtAssert_STUB_COUNT(CF_CFDP_MoveFile, 2);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 1);
+
+    /* failed, so they only move out of a polling directory */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 100);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 100 - CF_BUNDLE_TRAILER_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 100 - CF_BUNDLE_TRAILER_SIZE - 20);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, CF_BUNDLE_TRAILER_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, 20);
+    UT_SetDefaultReturnValue(UT_KEY(CF_TxnStatus_IsError), true);
+    UT_SetDeferredRetcode(UT_KEY(CF_CFDP_IsPollingDir), 1, true);
+    UtAssert_VOIDCALL(CF_CFDP_S_BundleReset(txn));
+    UtAssert_STUB_COUNT(CF_CFDP_IsPollingDir, 2);
+    UtAssert_STUB_COUNT(CF_CFDP_MoveFile, 3);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 2);
+
+    /* the index could not be read, the files are left where they are */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 100);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 100 - CF_BUNDLE_TRAILER_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, CF_BUNDLE_TRAILER_SIZE - 1);
+    UtAssert_VOIDCALL(CF_CFDP_S_BundleReset(txn));
+    UT_CF_AssertEventID(CF_CFDP_BUNDLE_ERR_EID);
+    UtAssert_STUB_COUNT(CF_CFDP_MoveFile, 3);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 3);
+
+    /* the playback keeps its files, so the index is not read */
+    UT_ResetState(UT_KEY(CF_WrappedOpenCreate));
+    pb.keep = 1;
+    UtAssert_VOIDCALL(CF_CFDP_S_BundleReset(txn));
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 4);
+}
+
+void Test_CF_CFDP_S_CompressStart(void)
+{
+    /* Test case for:
+     * bool CF_CFDP_S_CompressStart(CF_Transaction_t *txn);
+     */
+    CF_Transaction_t *txn;
+    osal_id_t         fd;
+
+    /* the temp file becomes the one sent, starting empty, and the original is read from zfd */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    OS_OpenCreate(&txn->fd, "ut", 0, 0); /* sets fd */
+    fd                              = txn->fd;
+    txn->fsize                      = 500;
+    txn->state_data.send.cached_pos = 500;
+    txn->flags.tx.compressing       = true;
+    UtAssert_BOOL_TRUE(CF_CFDP_S_CompressStart(txn));
+    UtAssert_BOOL_TRUE(txn->flags.com.compressed);
+    UtAssert_BOOL_TRUE(OS_ObjectIdEqual(txn->zfd, fd));
+    UtAssert_UINT32_EQ(txn->raw_size, 500);
+    UtAssert_ZERO(txn->fsize);
+    UtAssert_ZERO(txn->zoffs);
+    UtAssert_ZERO(txn->state_data.send.cached_pos);
+    UtAssert_STUB_COUNT(CF_Compress_GetFilename, 1);
+    UtAssert_STUB_COUNT(CF_CRC_Start, 2);
+
+    /* the original cannot be rewound */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->fsize = 500;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, -1);
+    UtAssert_BOOL_FALSE(CF_CFDP_S_CompressStart(txn));
+    UT_CF_AssertEventID(CF_CFDP_S_SEEK_FD_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_seek, 1);
+    UtAssert_BOOL_FALSE(txn->flags.com.compressed);
+    UtAssert_UINT32_EQ(txn->fsize, 500);
+
+    /* the temp file cannot be opened */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->fsize = 500;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UtAssert_BOOL_FALSE(CF_CFDP_S_CompressStart(txn));
+    UT_CF_AssertEventID(CF_CFDP_S_COMPRESS_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_open, 1);
+    UtAssert_BOOL_FALSE(txn->flags.com.compressed);
+    UtAssert_UINT32_EQ(txn->fsize, 500);
+}
+
+void Test_CF_CFDP_S_CompressChunk(void)
+{
+    /* Test case for:
+     * bool CF_CFDP_S_CompressChunk(CF_Transaction_t *txn);
+     */
+    CF_Transaction_t *txn;
+
+    /* these retvals are sticky and apply for the rest of the test cases */
+    UT_SetDefaultReturnValue(UT_KEY(CF_WrappedRead), CF_COMPRESS_BLOCK_SIZE);
+    UT_SetDefaultReturnValue(UT_KEY(CF_Compress_Pack), 100);
+    UT_SetDefaultReturnValue(UT_KEY(CF_WrappedWrite), 100);
+
+    /* one block is compressed onto the end of the temp file, which can then be sent */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    OS_OpenCreate(&txn->zfd, "ut", 0, 0); /* sets zfd */
+    txn->raw_size             = CF_COMPRESS_BLOCK_SIZE * 2;
+    txn->flags.tx.compressing = true;
+    UtAssert_BOOL_TRUE(CF_CFDP_S_CompressChunk(txn));
+    UtAssert_BOOL_TRUE(txn->flags.tx.compressing);
+    UtAssert_UINT32_EQ(txn->zoffs, CF_COMPRESS_BLOCK_SIZE);
+    UtAssert_UINT32_EQ(txn->fsize, 100);
+    UtAssert_UINT32_EQ(txn->state_data.send.cached_pos, 100);
+    UtAssert_STUB_COUNT(CF_CRC_Digest, 1);
+    UtAssert_STUB_COUNT(CF_Compress_Pack, 1);
+    UtAssert_STUB_COUNT(CF_WrappedLseek, 0);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 0);
+
+    /* the temp file was read from in between, so the next block goes back to its end, and that is the last */
+    txn->state_data.send.cached_pos = 50;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 100);
+    UtAssert_BOOL_TRUE(CF_CFDP_S_CompressChunk(txn));
+    UtAssert_BOOL_FALSE(txn->flags.tx.compressing);
+    UtAssert_BOOL_FALSE(OS_ObjectIdDefined(txn->zfd));
+    UtAssert_UINT32_EQ(txn->zoffs, CF_COMPRESS_BLOCK_SIZE * 2);
+    UtAssert_UINT32_EQ(txn->fsize, 200);
+    UtAssert_UINT32_EQ(txn->state_data.send.cached_pos, 200);
+    UtAssert_STUB_COUNT(CF_WrappedLseek, 1);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+    UtAssert_STUB_COUNT(CF_CRC_Finalize, 1);
+
+    /* nothing was left to read */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->flags.tx.compressing = true;
+    UtAssert_BOOL_TRUE(CF_CFDP_S_CompressChunk(txn));
+    UtAssert_BOOL_FALSE(txn->flags.tx.compressing);
+    UtAssert_ZERO(txn->fsize);
+    UtAssert_STUB_COUNT(CF_WrappedRead, 2);
+
+    /* read error */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->raw_size             = CF_COMPRESS_BLOCK_SIZE;
+    txn->flags.tx.compressing = true;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, -1);
+    UtAssert_BOOL_FALSE(CF_CFDP_S_CompressChunk(txn));
+    UT_CF_AssertEventID(CF_CFDP_S_READ_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_read, 1);
+    UtAssert_BOOL_TRUE(txn->flags.tx.compressing);
+
+    /* seek error */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->raw_size                   = CF_COMPRESS_BLOCK_SIZE;
+    txn->fsize                      = 100;
+    txn->state_data.send.cached_pos = 5;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, -1);
+    UtAssert_BOOL_FALSE(CF_CFDP_S_CompressChunk(txn));
+    UT_CF_AssertEventID(CF_CFDP_S_SEEK_FD_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_seek, 1);
+    UtAssert_UINT32_EQ(txn->fsize, 100);
+
+    /* write error */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->raw_size = CF_COMPRESS_BLOCK_SIZE;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 1, 1);
+    UtAssert_BOOL_FALSE(CF_CFDP_S_CompressChunk(txn));
+    UT_CF_AssertEventID(CF_CFDP_S_COMPRESS_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.fault.file_write, 1);
+    UtAssert_ZERO(txn->fsize);
+    UtAssert_ZERO(txn->zoffs);
 }
 
 void Test_CF_CFDP_S_SubstateSendFinAck(void)
@@ -730,6 +2049,12 @@ void Test_CF_CFDP_S2_Fin(void)
     UtAssert_VOIDCALL(CF_CFDP_S2_Fin(txn, ph));
 }
 
+/* keeps the bytes reported lost in the last flow control feedback */
+static void UT_AltHandler_CF_Flow_Feedback_Lost(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    *((uint32 *)UserObj) = UT_Hook_GetArgValueByName(Context, "lost", uint32);
+}
+
 void Test_CF_CFDP_S2_Nak(void)
 {
     /* Test case for:
@@ -738,6 +2063,7 @@ void Test_CF_CFDP_S2_Nak(void)
     CF_Transaction_t *      txn;
     CF_Logical_PduBuffer_t *ph;
     CF_Logical_PduNak_t *   nak;
+    uint32                  lost;
 
     /* no segments */
     UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
@@ -756,13 +2082,34 @@ void Test_CF_CFDP_S2_Nak(void)
 
     /* nominal, nonzero offsets */
     UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    nak                                  = &ph->int_header.nak;
+    nak->segment_list.num_segments       = 2;
+    nak->segment_list.segments[0]        = (CF_Logical_SegmentRequest_t) {0, 200};
+    nak->segment_list.segments[1]        = (CF_Logical_SegmentRequest_t) {200, 300};
+    txn->fsize                           = 300;
+    txn->state_data.send.s2.fc_in_flight = 300;
+    UtAssert_VOIDCALL(CF_CFDP_S2_Nak(txn, ph));
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.nak_segment_requests, 3);
+    UtAssert_UINT32_EQ(txn->history->perf.nak_rounds, 1);
+    UtAssert_UINT32_EQ(txn->history->perf.nak_segments, 2);
+    UtAssert_STUB_COUNT(CF_Flow_Feedback, 2);
+    UtAssert_ZERO(txn->state_data.send.s2.fc_in_flight);
+
+    /* a gap NAK'd again is not counted as new loss, only the part not asked for before */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
     nak                            = &ph->int_header.nak;
     nak->segment_list.num_segments = 2;
     nak->segment_list.segments[0]  = (CF_Logical_SegmentRequest_t) {0, 200};
     nak->segment_list.segments[1]  = (CF_Logical_SegmentRequest_t) {200, 300};
     txn->fsize                     = 300;
+    lost                           = 0xFFFFFFFF;
+    UT_SetHandlerFunction(UT_KEY(CF_Flow_Feedback), UT_AltHandler_CF_Flow_Feedback_Lost, &lost);
+    UT_SetDeferredRetcode(UT_KEY(CF_ChunkList_CountUncovered), 1, 0);
+    UT_SetDeferredRetcode(UT_KEY(CF_ChunkList_CountUncovered), 1, 40);
+    UT_ResetState(UT_KEY(CF_ChunkListAdd));
     UtAssert_VOIDCALL(CF_CFDP_S2_Nak(txn, ph));
-    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.nak_segment_requests, 3);
+    UtAssert_UINT32_EQ(lost, 40);
+    UtAssert_STUB_COUNT(CF_ChunkListAdd, 2);
 
     /* bad segments */
     UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
@@ -773,8 +2120,32 @@ void Test_CF_CFDP_S2_Nak(void)
     nak->segment_list.segments[2]  = (CF_Logical_SegmentRequest_t) {400, 0};
     txn->fsize                     = 300;
     UtAssert_VOIDCALL(CF_CFDP_S2_Nak(txn, ph));
-    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.nak_segment_requests, 6);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.nak_segment_requests, 8);
     UT_CF_AssertEventID(CF_CFDP_S_INVALID_SR_ERR_EID);
+    UtAssert_ZERO(txn->state_data.send.s2.skip_to);
+
+    /* a receiver resuming a partial file reports a scope past the data sent so far */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    nak                            = &ph->int_header.nak;
+    nak->segment_list.num_segments = 1;
+    nak->segment_list.segments[0]  = (CF_Logical_SegmentRequest_t) {150, 200};
+    nak->scope_end                 = 300;
+    txn->fsize                     = 300;
+    txn->foffs                     = 100;
+    txn->state_data.send.sub_state = CF_TxSubState_FILEDATA;
+    UtAssert_VOIDCALL(CF_CFDP_S2_Nak(txn, ph));
+    UtAssert_UINT32_EQ(txn->state_data.send.s2.skip_to, 300);
+
+    /* a scope past the end of the file is not trusted */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    nak                            = &ph->int_header.nak;
+    nak->segment_list.num_segments = 1;
+    nak->segment_list.segments[0]  = (CF_Logical_SegmentRequest_t) {150, 200};
+    nak->scope_end                 = 400;
+    txn->fsize                     = 300;
+    txn->state_data.send.sub_state = CF_TxSubState_FILEDATA;
+    UtAssert_VOIDCALL(CF_CFDP_S2_Nak(txn, ph));
+    UtAssert_ZERO(txn->state_data.send.s2.skip_to);
 
     /* bad decode */
     UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
@@ -799,6 +2170,73 @@ void Test_CF_CFDP_S2_Nak_Arm(void)
     UtAssert_VOIDCALL(CF_CFDP_S2_Nak_Arm(txn, ph));
 }
 
+void Test_CF_CFDP_S2_KeepAlive(void)
+{
+    /* Test case for:
+     * void CF_CFDP_S2_KeepAlive(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph);
+     */
+    CF_Transaction_t *      txn;
+    CF_Logical_PduBuffer_t *ph;
+    CF_ConfigTable_t *      config;
+    CF_ChunkWrapper_t       chunks;
+    CF_Chunk_t              ut_chunk;
+
+    memset(&chunks, 0, sizeof(chunks));
+
+    /* nominal, trimming disabled */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    txn->fsize                         = 100;
+    txn->chunks                        = &chunks;
+    ph->int_header.keep_alive.progress = 40;
+    UtAssert_VOIDCALL(CF_CFDP_S2_KeepAlive(txn, ph));
+    UtAssert_STUB_COUNT(CF_ChunkList_GetFirstChunk, 0);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+
+    /* trimming enabled, first gap straddles the progress point */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, &config);
+    config->chan[txn->chan_num].tx_keep_alive_trim = true;
+    txn->fsize                                     = 100;
+    txn->chunks                                    = &chunks;
+    ph->int_header.keep_alive.progress             = 40;
+    ut_chunk.offset                                = 10;
+    ut_chunk.size                                  = 50;
+    UT_SetHandlerFunction(UT_KEY(CF_ChunkList_GetFirstChunk), UT_AltHandler_GenericPointerReturn, &ut_chunk);
+    UT_SetHandlerFunction(UT_KEY(CF_ChunkList_RemoveFromFirst), UT_AltHandler_RemoveFromFirst, &ut_chunk);
+    UtAssert_VOIDCALL(CF_CFDP_S2_KeepAlive(txn, ph));
+    UtAssert_STUB_COUNT(CF_ChunkList_RemoveFromFirst, 1);
+    UtAssert_UINT32_EQ(ut_chunk.offset, 40);
+    UtAssert_UINT32_EQ(ut_chunk.size, 20);
+
+    /* trimming enabled, first gap is beyond the progress point */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, &config);
+    config->chan[txn->chan_num].tx_keep_alive_trim = true;
+    txn->fsize                                     = 100;
+    txn->chunks                                    = &chunks;
+    ph->int_header.keep_alive.progress             = 40;
+    ut_chunk.offset                                = 50;
+    ut_chunk.size                                  = 10;
+    UT_SetHandlerFunction(UT_KEY(CF_ChunkList_GetFirstChunk), UT_AltHandler_GenericPointerReturn, &ut_chunk);
+    UtAssert_VOIDCALL(CF_CFDP_S2_KeepAlive(txn, ph));
+    UtAssert_STUB_COUNT(CF_ChunkList_GetFirstChunk, 3);
+    UtAssert_STUB_COUNT(CF_ChunkList_RemoveFromFirst, 1);
+    UtAssert_UINT32_EQ(ut_chunk.offset, 50);
+
+    /* progress beyond the end of the file */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    txn->fsize                         = 100;
+    ph->int_header.keep_alive.progress = 101;
+    UtAssert_VOIDCALL(CF_CFDP_S2_KeepAlive(txn, ph));
+    UT_CF_AssertEventID(CF_CFDP_S_PDU_KEEP_ALIVE_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.error, 1);
+
+    /* failure of CF_CFDP_RecvKeepAlive */
+    UT_CFDP_S_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    UT_SetDeferredRetcode(UT_KEY(CF_CFDP_RecvKeepAlive), 1, CF_SHORT_PDU_ERROR);
+    UtAssert_VOIDCALL(CF_CFDP_S2_KeepAlive(txn, ph));
+    UT_CF_AssertEventID(CF_CFDP_S_PDU_KEEP_ALIVE_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].counters.recv.error, 2);
+}
+
 void Test_CF_CFDP_S2_WaitForEofAck(void)
 {
     /* Test case for:
@@ -839,10 +2277,13 @@ void UtTest_Setup(void)
     UtTest_Add(Test_CF_CFDP_S2_Recv, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown, "CF_CFDP_S2_Recv");
     UtTest_Add(Test_CF_CFDP_S1_Tx, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown, "CF_CFDP_S1_Tx");
     UtTest_Add(Test_CF_CFDP_S2_Tx, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown, "CF_CFDP_S2_Tx");
+    UtTest_Add(Test_CF_CFDP_S_Respond, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown, "CF_CFDP_S_Respond");
     UtTest_Add(Test_CF_CFDP_S_Tick, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown, "CF_CFDP_S_Tick");
     UtTest_Add(Test_CF_CFDP_S_Tick_Nak, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown, "CF_CFDP_S_Tick_Nak");
     UtTest_Add(Test_CF_CFDP_S_Cancel, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown, "CF_CFDP_S_Cancel");
     UtTest_Add(Test_CF_CFDP_S_SendEof, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown, "CF_CFDP_S_SendEof");
+    UtTest_Add(Test_CF_CFDP_S_GetFanOutCrc, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown,
+               "CF_CFDP_S_GetFanOutCrc");
     UtTest_Add(Test_CF_CFDP_S1_SubstateSendEof, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown,
                "CF_CFDP_S1_SubstateSendEof");
     UtTest_Add(Test_CF_CFDP_S2_SubstateSendEof, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown,
@@ -850,10 +2291,25 @@ void UtTest_Setup(void)
     UtTest_Add(Test_CF_CFDP_S_SendFileData, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown, "CF_CFDP_S_SendFileData");
     UtTest_Add(Test_CF_CFDP_S_SubstateSendFileData, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown,
                "CF_CFDP_S_SubstateSendFileData");
+    UtTest_Add(Test_CF_CFDP_S_FollowFile, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown, "CF_CFDP_S_FollowFile");
+    UtTest_Add(Test_CF_CFDP_S_Prefetch, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown, "CF_CFDP_S_Prefetch");
     UtTest_Add(Test_CF_CFDP_S_CheckAndRespondNak, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown,
                "CF_CFDP_S_CheckAndRespondNak");
     UtTest_Add(Test_CF_CFDP_S2_SubstateSendFileData, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown,
                "CF_CFDP_S2_SubstateSendFileData");
+    UtTest_Add(Test_CF_CFDP_S2_SubstateSendFileData_PromptTimer, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown,
+               "CF_CFDP_S2_SubstateSendFileData_PromptTimer");
+    UtTest_Add(Test_CF_CFDP_S2_SubstateSkipFileData, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown,
+               "CF_CFDP_S2_SubstateSkipFileData");
+    UtTest_Add(Test_CF_CFDP_S_CheckDelivered, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown,
+               "CF_CFDP_S_CheckDelivered");
+    UtTest_Add(Test_CF_CFDP_S_CompressStart, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown,
+               "CF_CFDP_S_CompressStart");
+    UtTest_Add(Test_CF_CFDP_S_CompressChunk, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown,
+               "CF_CFDP_S_CompressChunk");
+    UtTest_Add(Test_CF_CFDP_S_DeltaChunk, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown, "CF_CFDP_S_DeltaChunk");
+    UtTest_Add(Test_CF_CFDP_S_DeltaReset, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown, "CF_CFDP_S_DeltaReset");
+    UtTest_Add(Test_CF_CFDP_S_BundleReset, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown, "CF_CFDP_S_BundleReset");
     UtTest_Add(Test_CF_CFDP_S_SubstateSendMetadata, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown,
                "CF_CFDP_S_SubstateSendMetadata");
     UtTest_Add(Test_CF_CFDP_S_SubstateSendFinAck, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown,
@@ -862,6 +2318,7 @@ void UtTest_Setup(void)
     UtTest_Add(Test_CF_CFDP_S2_Fin, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown, "CF_CFDP_S2_Fin");
     UtTest_Add(Test_CF_CFDP_S2_Nak, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown, "CF_CFDP_S2_Nak");
     UtTest_Add(Test_CF_CFDP_S2_Nak_Arm, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown, "CF_CFDP_S2_Nak_Arm");
+    UtTest_Add(Test_CF_CFDP_S2_KeepAlive, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown, "CF_CFDP_S2_KeepAlive");
     UtTest_Add(Test_CF_CFDP_S2_WaitForEofAck, cf_cfdp_s_tests_Setup, cf_cfdp_s_tests_Teardown,
                "CF_CFDP_S2_WaitForEofAck");
 }
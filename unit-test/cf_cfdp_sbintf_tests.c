@@ -22,6 +22,8 @@
 #include "cf_test_alt_handler.h"
 #include "cf_events.h"
 #include "cf_cfdp_sbintf.h"
+#include "cf_evagg.h"
+#include "cf_udpintf.h"
 #include "cf_cfdp_pdu.h"
 
 static union
@@ -38,6 +40,12 @@ static union
     uint8           bytes[CF_MAX_PDU_SIZE];
 } UT_s_msg;
 
+static union
+{
+    CFE_SB_Buffer_t sb_buf;
+    uint8           bytes[2 * CF_MAX_PDU_SIZE];
+} UT_big_msg;
+
 /*******************************************************************************
 **
 **  cf_cfdp_tests local utility functions
@@ -71,7 +79,7 @@ static void UT_CFDP_SetupBasicRxState(CF_Logical_PduBuffer_t *pdu_buffer)
     UT_SetDataBuffer(UT_KEY(CFE_MSG_GetSize), &sz, sizeof(sz), true);
 
     /* setup for a potential call to CFE_MSG_GetType() */
-    UT_SetDataBuffer(UT_KEY(CFE_MSG_GetType), &msg_type, sizeof(msg_type), false);
+    UT_SetDataBuffer(UT_KEY(CFE_MSG_GetType), &msg_type, sizeof(msg_type), true);
 }
 
 static void UT_CFDP_SetupBasicTxState(CF_Logical_PduBuffer_t *pdu_buffer)
@@ -130,7 +138,7 @@ static void UT_CFDP_SetupBasicTestState(UT_CF_Setup_t setup, CF_Logical_PduBuffe
         }
         else if (setup == UT_CF_Setup_RX)
         {
-            *pdu_buffer_p = &CF_AppData.engine.in.rx_pdudata;
+            *pdu_buffer_p = &CF_AppData.engine.in.rx_pdudata[0];
         }
         else
         {
@@ -172,7 +180,7 @@ static void UT_CFDP_SetupBasicTestState(UT_CF_Setup_t setup, CF_Logical_PduBuffe
     else if (setup == UT_CF_Setup_RX)
     {
         /* most calls on the RX side will do some sort of decode, so set up for that. */
-        UT_CFDP_SetupBasicRxState(&CF_AppData.engine.in.rx_pdudata);
+        UT_CFDP_SetupBasicRxState(&CF_AppData.engine.in.rx_pdudata[0]);
         ut_config_table.chan[UT_CFDP_CHANNEL].rx_max_messages_per_wakeup = 1;
     }
 
@@ -208,6 +216,20 @@ void cf_cfdp_tests_Teardown(void)
 **
 *******************************************************************************/
 
+static int32 Ut_Hook_DispatchRecv_SaveOrder(void *UserObj, int32 StubRetcode, uint32 CallCount,
+                                            const UT_StubContext_t *Context)
+{
+    CF_Logical_PduBuffer_t **order = UserObj;
+    CF_Logical_PduBuffer_t * ph    = UT_Hook_GetArgValueByName(Context, "ph", CF_Logical_PduBuffer_t *);
+
+    if (CallCount < CF_TRANSPORT_RX_BATCH_SIZE)
+    {
+        order[CallCount] = ph;
+    }
+
+    return StubRetcode;
+}
+
 void Test_CF_CFDP_ReceiveMessage(void)
 {
     /* Test case for:
@@ -219,6 +241,7 @@ void Test_CF_CFDP_ReceiveMessage(void)
     CF_Logical_PduBuffer_t *ph;
     CFE_MSG_Type_t          msg_type = CFE_MSG_Type_Tlm;
     size_t *                msg_size_buf;
+    uint32                  evs_count;
 
     /* no-config - the max per wakeup will be 0, and this is a noop */
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, &chan, NULL, NULL, NULL);
@@ -318,6 +341,15 @@ void Test_CF_CFDP_ReceiveMessage(void)
     UtAssert_VOIDCALL(CF_CFDP_ReceiveMessage(chan));
     UT_CF_AssertEventID(CF_CFDP_INVALID_DST_ERR_EID);
 
+    /* same, but a repeat within the aggregation interval is only counted */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, &ph, &chan, NULL, &txn, &config);
+    config->local_eid              = 123;
+    ph->pdu_header.destination_eid = ~config->local_eid;
+    UT_SetDeferredRetcode(UT_KEY(CF_EvAgg_Suppress), 1, true);
+    evs_count = UT_GetStubCount(UT_KEY(CFE_EVS_SendEvent));
+    UtAssert_VOIDCALL(CF_CFDP_ReceiveMessage(chan));
+    UtAssert_UINT32_EQ(UT_GetStubCount(UT_KEY(CFE_EVS_SendEvent)), evs_count);
+
     /* recv correct destination_eid but CF_MAX_SIMULTANEOUS_RX hit */
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, &ph, &chan, NULL, &txn, &config);
     CF_AppData.hk.Payload.channel_hk[txn->chan_num].q_size[CF_QueueIdx_RX] = CF_MAX_SIMULTANEOUS_RX;
@@ -325,6 +357,292 @@ void Test_CF_CFDP_ReceiveMessage(void)
     ph->pdu_header.destination_eid                                         = config->local_eid;
     UtAssert_VOIDCALL(CF_CFDP_ReceiveMessage(chan));
     UT_CF_AssertEventID(CF_CFDP_RX_DROPPED_ERR_EID);
+
+    /* transport that returns several PDUs per call, stops at the per wakeup limit */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, NULL, &chan, NULL, &txn, &config);
+    config->chan[UT_CFDP_CHANNEL].udp_local_port             = 1234;
+    config->chan[UT_CFDP_CHANNEL].rx_max_messages_per_wakeup = CF_TRANSPORT_RX_BATCH_SIZE + 2;
+    UT_SetDeferredRetcode(UT_KEY(CF_UdpIntf_ReceiveBatch), 1, CF_TRANSPORT_RX_BATCH_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_UdpIntf_ReceiveBatch), 1, 2);
+    UT_ResetState(UT_KEY(CF_CFDP_RecvPh));
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_RecvPh), -1);
+    UtAssert_VOIDCALL(CF_CFDP_ReceiveMessage(chan));
+    UtAssert_STUB_COUNT(CF_UdpIntf_ReceiveBatch, 2);
+    UtAssert_STUB_COUNT(CF_CFDP_RecvPh, CF_TRANSPORT_RX_BATCH_SIZE + 2);
+
+    /* transport runs dry before the limit */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, NULL, &chan, NULL, &txn, &config);
+    config->chan[UT_CFDP_CHANNEL].udp_local_port             = 1234;
+    config->chan[UT_CFDP_CHANNEL].rx_max_messages_per_wakeup = CF_TRANSPORT_RX_BATCH_SIZE + 2;
+    UT_SetDeferredRetcode(UT_KEY(CF_UdpIntf_ReceiveBatch), 1, 1);
+    UtAssert_VOIDCALL(CF_CFDP_ReceiveMessage(chan));
+    UtAssert_STUB_COUNT(CF_UdpIntf_ReceiveBatch, 4);
+    UtAssert_STUB_COUNT(CF_CFDP_RecvPh, CF_TRANSPORT_RX_BATCH_SIZE + 3);
+
+    /* time limit ends the wakeup after the first batch, budget is not raised */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, NULL, &chan, NULL, &txn, &config);
+    config->chan[UT_CFDP_CHANNEL].udp_local_port             = 1234;
+    config->chan[UT_CFDP_CHANNEL].rx_max_messages_per_wakeup = CF_TRANSPORT_RX_BATCH_SIZE + 2;
+    config->chan[UT_CFDP_CHANNEL].rx_adaptive_max_per_wakeup = 4 * CF_TRANSPORT_RX_BATCH_SIZE;
+    config->chan[UT_CFDP_CHANNEL].rx_max_usec_per_wakeup     = 1;
+    UT_SetDeferredRetcode(UT_KEY(CF_UdpIntf_ReceiveBatch), 1, CF_TRANSPORT_RX_BATCH_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_UdpIntf_ReceiveBatch), 1, 2);
+    UtAssert_VOIDCALL(CF_CFDP_ReceiveMessage(chan));
+    UtAssert_STUB_COUNT(CF_UdpIntf_ReceiveBatch, 5);
+    UtAssert_STUB_COUNT(OS_GetLocalTime, 2);
+    UtAssert_UINT32_EQ(chan->rx_budget, CF_TRANSPORT_RX_BATCH_SIZE + 2);
+
+    /* time limit not reached */
+    config->chan[UT_CFDP_CHANNEL].rx_max_usec_per_wakeup = 1000000;
+    UT_SetDeferredRetcode(UT_KEY(CF_UdpIntf_ReceiveBatch), 1, CF_TRANSPORT_RX_BATCH_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_UdpIntf_ReceiveBatch), 1, 2);
+    UtAssert_VOIDCALL(CF_CFDP_ReceiveMessage(chan));
+    UtAssert_STUB_COUNT(CF_UdpIntf_ReceiveBatch, 7);
+    UtAssert_STUB_COUNT(OS_GetLocalTime, 5);
+    UtAssert_UINT32_EQ(chan->rx_budget, 2 * (CF_TRANSPORT_RX_BATCH_SIZE + 2));
+
+    /* engine cycle out of time also ends the wakeup after the first batch */
+    config->chan[UT_CFDP_CHANNEL].rx_max_usec_per_wakeup = 0;
+    UT_SetDeferredRetcode(UT_KEY(CF_UdpIntf_ReceiveBatch), 1, CF_TRANSPORT_RX_BATCH_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_UdpIntf_ReceiveBatch), 1, 2);
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_CycleBudgetExpired), true);
+    UtAssert_VOIDCALL(CF_CFDP_ReceiveMessage(chan));
+    UtAssert_STUB_COUNT(CF_UdpIntf_ReceiveBatch, 8);
+    UT_ResetState(UT_KEY(CF_CFDP_CycleBudgetExpired));
+}
+
+void Test_CF_CFDP_ReceiveMessage_Grouped(void)
+{
+    /* Test case for:
+     * void CF_CFDP_ReceiveMessage(CF_Channel_t *chan);
+     * with several PDUs per batch
+     */
+    CF_Channel_t *          chan;
+    CF_ConfigTable_t *      config;
+    CF_Transaction_t *      txn;
+    CF_History_t *          history;
+    CF_Input_t *            in = &CF_AppData.engine.in;
+    CF_Logical_PduBuffer_t *order[CF_TRANSPORT_RX_BATCH_SIZE];
+    uint32                  i;
+
+    /*
+     * three PDUs, the first and last belong to the same transaction.
+     * They should be dispatched back to back, and the second transaction after them.
+     * The transaction is only looked up once per group.
+     */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, NULL, &chan, &history, &txn, &config);
+    config->chan[UT_CFDP_CHANNEL].udp_local_port             = 1234;
+    config->chan[UT_CFDP_CHANNEL].rx_max_messages_per_wakeup = 3;
+    UT_SetDeferredRetcode(UT_KEY(CF_UdpIntf_ReceiveBatch), 1, 3);
+    in->rx_pdudata[0].pdu_header.source_eid   = 10;
+    in->rx_pdudata[0].pdu_header.sequence_num = 1;
+    in->rx_pdudata[1].pdu_header.source_eid   = 10;
+    in->rx_pdudata[1].pdu_header.sequence_num = 2;
+    in->rx_pdudata[2].pdu_header.source_eid   = 10;
+    in->rx_pdudata[2].pdu_header.sequence_num = 1;
+    history->src_eid                          = 10;
+    history->seq_num                          = 1;
+    txn->state                                = CF_TxnState_R2;
+    memset(order, 0, sizeof(order));
+    UT_SetHandlerFunction(UT_KEY(CF_FindTransactionBySequenceNumber), UT_AltHandler_GenericPointerReturn, txn);
+    UT_SetHookFunction(UT_KEY(CF_CFDP_DispatchRecv), Ut_Hook_DispatchRecv_SaveOrder, order);
+    UtAssert_VOIDCALL(CF_CFDP_ReceiveMessage(chan));
+    UtAssert_STUB_COUNT(CF_CFDP_RecvPh, 3);
+    UtAssert_STUB_COUNT(CF_CFDP_DispatchRecv, 3);
+    UtAssert_STUB_COUNT(CF_FindTransactionBySequenceNumber, 2);
+    UtAssert_ADDRESS_EQ(order[0], &in->rx_pdudata[0]);
+    UtAssert_ADDRESS_EQ(order[1], &in->rx_pdudata[2]);
+    UtAssert_ADDRESS_EQ(order[2], &in->rx_pdudata[1]);
+
+    /* a PDU with a bad header is not dispatched, and does not stop the rest of the group */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, NULL, &chan, &history, &txn, &config);
+    config->chan[UT_CFDP_CHANNEL].udp_local_port             = 1234;
+    config->chan[UT_CFDP_CHANNEL].rx_max_messages_per_wakeup = 3;
+    UT_SetDeferredRetcode(UT_KEY(CF_UdpIntf_ReceiveBatch), 1, 3);
+    UT_SetDeferredRetcode(UT_KEY(CF_CFDP_RecvPh), 2, -1);
+    for (i = 0; i < 3; ++i)
+    {
+        in->rx_pdudata[i].pdu_header.source_eid   = 10;
+        in->rx_pdudata[i].pdu_header.sequence_num = 1;
+    }
+    history->src_eid = 10;
+    history->seq_num = 1;
+    txn->state                                = CF_TxnState_R2;
+    UtAssert_VOIDCALL(CF_CFDP_ReceiveMessage(chan));
+    UtAssert_STUB_COUNT(CF_CFDP_DispatchRecv, 5);
+    UtAssert_STUB_COUNT(CF_FindTransactionBySequenceNumber, 3);
+
+    /* first PDU of the group not taken by any transaction, the next one is looked up again */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, NULL, &chan, NULL, NULL, &config);
+    config->chan[UT_CFDP_CHANNEL].udp_local_port             = 1234;
+    config->chan[UT_CFDP_CHANNEL].rx_max_messages_per_wakeup = 2;
+    config->local_eid                                        = 123;
+    UT_SetDeferredRetcode(UT_KEY(CF_UdpIntf_ReceiveBatch), 1, 2);
+    for (i = 0; i < 2; ++i)
+    {
+        in->rx_pdudata[i].pdu_header.source_eid   = 10;
+        in->rx_pdudata[i].pdu_header.sequence_num = 1;
+    }
+    UT_ResetState(UT_KEY(CF_FindTransactionBySequenceNumber));
+    UT_ResetState(UT_KEY(CF_CFDP_DispatchRecv));
+    UtAssert_VOIDCALL(CF_CFDP_ReceiveMessage(chan));
+    UtAssert_STUB_COUNT(CF_FindTransactionBySequenceNumber, 2);
+    UtAssert_STUB_COUNT(CF_CFDP_DispatchRecv, 0);
+    UT_CF_AssertEventID(CF_CFDP_INVALID_DST_ERR_EID);
+}
+
+void Test_CF_CFDP_GetRxBudget(void)
+{
+    /* Test case for:
+     * uint32 CF_CFDP_GetRxBudget(uint8 chan_num);
+     */
+    CF_Channel_t *    chan;
+    CF_ConfigTable_t *config;
+
+    /* adaptive mode off */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, &chan, NULL, NULL, &config);
+    config->chan[UT_CFDP_CHANNEL].rx_max_messages_per_wakeup = 5;
+    chan->rx_budget                                          = 20;
+    UtAssert_UINT32_EQ(CF_CFDP_GetRxBudget(UT_CFDP_CHANNEL), 5);
+    config->chan[UT_CFDP_CHANNEL].rx_adaptive_max_per_wakeup = 5;
+    UtAssert_UINT32_EQ(CF_CFDP_GetRxBudget(UT_CFDP_CHANNEL), 5);
+
+    /* adaptive mode, first wakeup starts at the configured cap */
+    config->chan[UT_CFDP_CHANNEL].rx_adaptive_max_per_wakeup = 16;
+    chan->rx_budget                                          = 0;
+    UtAssert_UINT32_EQ(CF_CFDP_GetRxBudget(UT_CFDP_CHANNEL), 5);
+
+    /* adaptive mode, keeps the current budget */
+    chan->rx_budget = 12;
+    UtAssert_UINT32_EQ(CF_CFDP_GetRxBudget(UT_CFDP_CHANNEL), 12);
+
+    /* adaptive maximum lowered below the current budget */
+    chan->rx_budget = 20;
+    UtAssert_UINT32_EQ(CF_CFDP_GetRxBudget(UT_CFDP_CHANNEL), 16);
+    UtAssert_UINT32_EQ(chan->rx_budget, 16);
+}
+
+void Test_CF_CFDP_UpdateRxBudget(void)
+{
+    /* Test case for:
+     * void CF_CFDP_UpdateRxBudget(uint8 chan_num, uint32 count, bool time_limited);
+     */
+    CF_Channel_t *       chan;
+    CF_ConfigTable_t *   config;
+    CF_HkChannel_Data_t *hk = &CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL];
+
+    /* adaptive mode off, only the statistics are kept */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, &chan, NULL, NULL, &config);
+    config->chan[UT_CFDP_CHANNEL].rx_max_messages_per_wakeup = 5;
+    config->chan[UT_CFDP_CHANNEL].pipe_depth_input           = 16;
+    chan->rx_budget                                          = 5;
+    UtAssert_VOIDCALL(CF_CFDP_UpdateRxBudget(UT_CFDP_CHANNEL, 5, false));
+    UtAssert_UINT32_EQ(chan->rx_budget, 5);
+    UtAssert_UINT32_EQ(hk->rx_budget, 5);
+    UtAssert_UINT32_EQ(hk->rx_pipe_high_water, 5);
+    UtAssert_ZERO(hk->rx_pipe_full);
+
+    /* high water only goes up */
+    UtAssert_VOIDCALL(CF_CFDP_UpdateRxBudget(UT_CFDP_CHANNEL, 2, false));
+    UtAssert_UINT32_EQ(hk->rx_pipe_high_water, 5);
+
+    /* budget used up, doubles */
+    config->chan[UT_CFDP_CHANNEL].rx_adaptive_max_per_wakeup = 16;
+    UtAssert_VOIDCALL(CF_CFDP_UpdateRxBudget(UT_CFDP_CHANNEL, 5, false));
+    UtAssert_UINT32_EQ(chan->rx_budget, 10);
+    UtAssert_UINT32_EQ(hk->rx_budget, 10);
+
+    /* ... up to the adaptive maximum */
+    UtAssert_VOIDCALL(CF_CFDP_UpdateRxBudget(UT_CFDP_CHANNEL, 10, false));
+    UtAssert_UINT32_EQ(chan->rx_budget, 16);
+
+    /* used up, but limited by time */
+    chan->rx_budget = 10;
+    UtAssert_VOIDCALL(CF_CFDP_UpdateRxBudget(UT_CFDP_CHANNEL, 10, true));
+    UtAssert_UINT32_EQ(chan->rx_budget, 10);
+
+    /* more than half used, stays */
+    UtAssert_VOIDCALL(CF_CFDP_UpdateRxBudget(UT_CFDP_CHANNEL, 6, false));
+    UtAssert_UINT32_EQ(chan->rx_budget, 10);
+
+    /* mostly idle, moves halfway back to the configured cap */
+    UtAssert_VOIDCALL(CF_CFDP_UpdateRxBudget(UT_CFDP_CHANNEL, 1, false));
+    UtAssert_UINT32_EQ(chan->rx_budget, 8);
+    chan->rx_budget = 5;
+    UtAssert_VOIDCALL(CF_CFDP_UpdateRxBudget(UT_CFDP_CHANNEL, 0, false));
+    UtAssert_UINT32_EQ(chan->rx_budget, 5);
+
+    /* a full pipe is counted and goes straight to the adaptive maximum */
+    chan->rx_budget = 16;
+    UtAssert_VOIDCALL(CF_CFDP_UpdateRxBudget(UT_CFDP_CHANNEL, 16, true));
+    UtAssert_UINT32_EQ(hk->rx_pipe_full, 1);
+    UtAssert_UINT32_EQ(hk->rx_pipe_high_water, 16);
+    UtAssert_UINT32_EQ(chan->rx_budget, 16);
+
+    /* no pipe depth configured, never full */
+    config->chan[UT_CFDP_CHANNEL].pipe_depth_input = 0;
+    UtAssert_VOIDCALL(CF_CFDP_UpdateRxBudget(UT_CFDP_CHANNEL, 16, true));
+    UtAssert_UINT32_EQ(hk->rx_pipe_full, 1);
+
+    /* UDP does not use the pipe */
+    config->chan[UT_CFDP_CHANNEL].pipe_depth_input = 16;
+    config->chan[UT_CFDP_CHANNEL].udp_local_port   = 1234;
+    UtAssert_VOIDCALL(CF_CFDP_UpdateRxBudget(UT_CFDP_CHANNEL, 16, true));
+    UtAssert_UINT32_EQ(hk->rx_pipe_full, 1);
+
+    /* values beyond the range of the HK fields are saturated */
+    config->chan[UT_CFDP_CHANNEL].rx_adaptive_max_per_wakeup = 100000;
+    chan->rx_budget                                          = 70000;
+    UtAssert_VOIDCALL(CF_CFDP_UpdateRxBudget(UT_CFDP_CHANNEL, 70000, true));
+    UtAssert_UINT32_EQ(hk->rx_pipe_high_water, UINT16_MAX);
+    UtAssert_UINT32_EQ(hk->rx_budget, UINT16_MAX);
+}
+
+void Test_CF_CFDP_ReceivePdu(void)
+{
+    /* Test case for:
+     * CF_Transaction_t *CF_CFDP_ReceivePdu(CF_Channel_t *chan, CF_Logical_PduBuffer_t *ph, CF_Transaction_t *hint);
+     */
+    CF_Channel_t *          chan;
+    CF_Transaction_t *      txn;
+    CF_History_t *          history;
+    CF_Logical_PduBuffer_t *ph;
+
+    /* hint matches, no lookup */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, &ph, &chan, &history, &txn, NULL);
+    ph->pdu_header.source_eid   = 5;
+    ph->pdu_header.sequence_num = 6;
+    history->src_eid            = 5;
+    history->seq_num            = 6;
+    txn->state                  = CF_TxnState_R2;
+    UtAssert_ADDRESS_EQ(CF_CFDP_ReceivePdu(chan, ph, txn), txn);
+    UtAssert_STUB_COUNT(CF_FindTransactionBySequenceNumber, 0);
+    UtAssert_STUB_COUNT(CF_CFDP_DispatchRecv, 1);
+
+    /* hint for a different sequence number, or a different source */
+    history->seq_num = 7;
+    UT_SetHandlerFunction(UT_KEY(CF_FindTransactionBySequenceNumber), UT_AltHandler_GenericPointerReturn, txn);
+    UtAssert_ADDRESS_EQ(CF_CFDP_ReceivePdu(chan, ph, txn), txn);
+    history->seq_num = 6;
+    history->src_eid = 4;
+    UtAssert_ADDRESS_EQ(CF_CFDP_ReceivePdu(chan, ph, txn), txn);
+    UtAssert_STUB_COUNT(CF_FindTransactionBySequenceNumber, 2);
+    UtAssert_STUB_COUNT(CF_CFDP_DispatchRecv, 3);
+    UtAssert_UINT32_EQ(history->perf.pdus_recv, 3);
+
+    /* hint no longer active, and not for this entity */
+    history->src_eid               = 5;
+    txn->state                     = CF_TxnState_IDLE;
+    ph->pdu_header.destination_eid = 1;
+    UT_ResetState(UT_KEY(CF_FindTransactionBySequenceNumber));
+    UtAssert_NULL(CF_CFDP_ReceivePdu(chan, ph, txn));
+    UtAssert_STUB_COUNT(CF_FindTransactionBySequenceNumber, 1);
+
+    /* no match, not for this entity */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, &ph, &chan, NULL, NULL, NULL);
+    ph->pdu_header.destination_eid = 1;
+    UtAssert_NULL(CF_CFDP_ReceivePdu(chan, ph, NULL));
+    UT_CF_AssertEventID(CF_CFDP_INVALID_DST_ERR_EID);
 }
 
 void Test_CF_CFDP_Send(void)
@@ -336,10 +654,141 @@ void Test_CF_CFDP_Send(void)
 
     /* nominal */
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, &ph, NULL, NULL, NULL, NULL);
+    CF_AppData.engine.out.transport = &CF_Transport_Sb;
+    CF_AppData.engine.out.msg       = &UT_s_msg.sb_buf;
     UtAssert_VOIDCALL(CF_CFDP_Send(UT_CFDP_CHANNEL, ph));
     UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL].counters.sent.pdu, 1);
     UtAssert_STUB_COUNT(CFE_MSG_SetSize, 1);
     UtAssert_STUB_COUNT(CFE_SB_TransmitBuffer, 1);
+    UtAssert_NULL(CF_AppData.engine.out.msg);
+
+    /* goes to whichever transport the buffer came from */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, &ph, NULL, NULL, NULL, NULL);
+    CF_AppData.engine.out.transport = &CF_Transport_Udp;
+    CF_AppData.engine.out.msg       = &UT_s_msg.sb_buf;
+    UtAssert_VOIDCALL(CF_CFDP_Send(UT_CFDP_CHANNEL, ph));
+    UtAssert_STUB_COUNT(CF_UdpIntf_Send, 1);
+    UtAssert_STUB_COUNT(CFE_SB_TransmitBuffer, 1);
+}
+
+void Test_CF_CFDP_GetTransport(void)
+{
+    /* Test case for:
+     * const CF_Transport_t *CF_CFDP_GetTransport(uint8 chan_num);
+     */
+    CF_ConfigTable_t *config;
+
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, NULL, &config);
+    UtAssert_ADDRESS_EQ(CF_CFDP_GetTransport(UT_CFDP_CHANNEL), &CF_Transport_Sb);
+
+    config->chan[UT_CFDP_CHANNEL].udp_local_port = 1234;
+    UtAssert_ADDRESS_EQ(CF_CFDP_GetTransport(UT_CFDP_CHANNEL), &CF_Transport_Udp);
+}
+
+void Test_CF_CFDP_SbGetBuffer(void)
+{
+    /* Test case for:
+     * void *CF_CFDP_SbGetBuffer(uint8 chan_num, size_t *encap_hdr_size);
+     */
+    size_t encap_hdr_size;
+
+    /* nominal */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, NULL, NULL);
+    UtAssert_ADDRESS_EQ(CF_CFDP_SbGetBuffer(UT_CFDP_CHANNEL, &encap_hdr_size), &UT_s_msg.sb_buf);
+    UtAssert_UINT32_EQ(encap_hdr_size, offsetof(CF_PduTlmMsg_t, ph));
+    UtAssert_STUB_COUNT(CFE_MSG_Init, 1);
+
+    /* no buffer */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, NULL, NULL);
+    UtAssert_NULL(CF_CFDP_SbGetBuffer(UT_CFDP_CHANNEL, &encap_hdr_size));
+    UtAssert_STUB_COUNT(CFE_MSG_Init, 1);
+}
+
+void Test_CF_CFDP_SbReleaseBuffer(void)
+{
+    /* Test case for:
+     * void CF_CFDP_SbReleaseBuffer(uint8 chan_num, void *buf);
+     */
+    UtAssert_VOIDCALL(CF_CFDP_SbReleaseBuffer(UT_CFDP_CHANNEL, &UT_s_msg.sb_buf));
+    UtAssert_STUB_COUNT(CFE_SB_ReleaseMessageBuffer, 1);
+}
+
+void Test_CF_CFDP_SbSend(void)
+{
+    /* Test case for:
+     * void CF_CFDP_SbSend(uint8 chan_num, void *buf, size_t pdu_size);
+     */
+    UtAssert_VOIDCALL(CF_CFDP_SbSend(UT_CFDP_CHANNEL, &UT_s_msg.sb_buf, 30));
+    UtAssert_STUB_COUNT(CFE_MSG_SetSize, 1);
+    UtAssert_STUB_COUNT(CFE_MSG_SetMsgTime, 1);
+    UtAssert_STUB_COUNT(CFE_SB_TransmitBuffer, 1);
+}
+
+void Test_CF_CFDP_SbReceiveBatch(void)
+{
+    /* Test case for:
+     * uint32 CF_CFDP_SbReceiveBatch(uint8 chan_num, CF_TransportRxMsg_t *msgs, uint32 max_msgs);
+     */
+    CF_TransportRxMsg_t msgs[2];
+    CFE_MSG_Type_t      msg_type = CFE_MSG_Type_Tlm;
+    CFE_MSG_Size_t      msg_size;
+    CFE_MSG_Size_t      msg_sizes[2];
+    CFE_SB_Buffer_t *   bufptr;
+    CFE_SB_Buffer_t *   bufptrs[2];
+
+    /* no room */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, NULL, NULL);
+    UtAssert_UINT32_EQ(CF_CFDP_SbReceiveBatch(UT_CFDP_CHANNEL, msgs, 0), 0);
+    UtAssert_STUB_COUNT(CFE_SB_ReceiveBuffer, 0);
+
+    /* command encapsulation, each PDU is copied out of its SB buffer */
+    bufptrs[0] = &UT_r_msg.sb_buf;
+    bufptrs[1] = &UT_r_msg.sb_buf;
+    UT_SetDataBuffer(UT_KEY(CFE_SB_ReceiveBuffer), bufptrs, sizeof(bufptrs), false);
+    msg_sizes[0] = sizeof(UT_r_msg) + CF_PDU_ENCAPSULATION_EXTRA_TRAILING_BYTES;
+    msg_sizes[1] = msg_sizes[0];
+    UT_SetDataBuffer(UT_KEY(CFE_MSG_GetSize), msg_sizes, sizeof(msg_sizes), false);
+    UT_r_msg.bytes[offsetof(CF_PduCmdMsg_t, ph)] = 0xA5;
+    UtAssert_UINT32_EQ(CF_CFDP_SbReceiveBatch(UT_CFDP_CHANNEL, msgs, 2), 2);
+    UtAssert_ADDRESS_EQ(msgs[0].buf, CF_AppData.engine.in.rx_buf[0]);
+    UtAssert_ADDRESS_EQ(msgs[1].buf, CF_AppData.engine.in.rx_buf[1]);
+    UtAssert_UINT32_EQ(msgs[0].encap_hdr_size, 0);
+    UtAssert_UINT32_EQ(msgs[0].total_size, sizeof(UT_r_msg) - offsetof(CF_PduCmdMsg_t, ph));
+    UtAssert_UINT32_EQ(CF_AppData.engine.in.rx_buf[0][0], 0xA5);
+    UtAssert_UINT32_EQ(CF_AppData.engine.in.rx_buf[1][0], 0xA5);
+    UtAssert_STUB_COUNT(CFE_SB_ReceiveBuffer, 2);
+
+    /* telemetry encapsulation */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, NULL, NULL);
+    UT_ResetState(UT_KEY(CFE_MSG_GetType));
+    UT_SetDataBuffer(UT_KEY(CFE_MSG_GetType), &msg_type, sizeof(msg_type), false);
+    UT_r_msg.bytes[offsetof(CF_PduTlmMsg_t, ph)] = 0x5A;
+    UtAssert_UINT32_EQ(CF_CFDP_SbReceiveBatch(UT_CFDP_CHANNEL, msgs, 1), 1);
+    UtAssert_UINT32_EQ(msgs[0].total_size, sizeof(UT_r_msg) - offsetof(CF_PduTlmMsg_t, ph));
+    UtAssert_UINT32_EQ(CF_AppData.engine.in.rx_buf[0][0], 0x5A);
+
+    /* message too small to hold a PDU */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, NULL, NULL);
+    msg_size = offsetof(CF_PduCmdMsg_t, ph);
+    UT_ResetState(UT_KEY(CFE_MSG_GetSize));
+    UT_SetDataBuffer(UT_KEY(CFE_MSG_GetSize), &msg_size, sizeof(msg_size), false);
+    UtAssert_UINT32_EQ(CF_CFDP_SbReceiveBatch(UT_CFDP_CHANNEL, msgs, 1), 1);
+    UtAssert_UINT32_EQ(msgs[0].total_size, 0);
+
+    /* message larger than any PDU, copy is limited to the buffer */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, NULL, NULL, NULL);
+    bufptr = &UT_big_msg.sb_buf;
+    UT_ResetState(UT_KEY(CFE_SB_ReceiveBuffer));
+    UT_SetDataBuffer(UT_KEY(CFE_SB_ReceiveBuffer), &bufptr, sizeof(bufptr), false);
+    msg_size = sizeof(UT_big_msg);
+    UT_ResetState(UT_KEY(CFE_MSG_GetSize));
+    UT_SetDataBuffer(UT_KEY(CFE_MSG_GetSize), &msg_size, sizeof(msg_size), false);
+    UtAssert_UINT32_EQ(CF_CFDP_SbReceiveBatch(UT_CFDP_CHANNEL, msgs, 1), 1);
+    UtAssert_UINT32_EQ(msgs[0].total_size, CF_MAX_PDU_SIZE);
+
+    /* pipe empty */
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_ReceiveBuffer), 1, CFE_SB_NO_MESSAGE);
+    UtAssert_UINT32_EQ(CF_CFDP_SbReceiveBatch(UT_CFDP_CHANNEL, msgs, 2), 0);
 }
 
 void Test_CF_CFDP_MsgOutGet(void)
@@ -350,6 +799,7 @@ void Test_CF_CFDP_MsgOutGet(void)
     CF_Transaction_t *txn;
     CF_ConfigTable_t *config;
     CF_Channel_t *    chan;
+    uint32            evs_count;
 
     /* nominal */
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
@@ -395,6 +845,13 @@ void Test_CF_CFDP_MsgOutGet(void)
     UtAssert_NULL(CF_CFDP_MsgOutGet(txn, false));
     UT_CF_AssertEventID(CF_CFDP_NO_MSG_ERR_EID);
 
+    /* same, but a repeat within the aggregation interval is only counted */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    UT_SetDeferredRetcode(UT_KEY(CF_EvAgg_Suppress), 1, true);
+    evs_count = UT_GetStubCount(UT_KEY(CFE_EVS_SendEvent));
+    UtAssert_NULL(CF_CFDP_MsgOutGet(txn, false));
+    UtAssert_UINT32_EQ(UT_GetStubCount(UT_KEY(CFE_EVS_SendEvent)), evs_count);
+
     /* same, but the silent flag should suppress the event */
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
     UtAssert_NULL(CF_CFDP_MsgOutGet(txn, true));
@@ -410,7 +867,17 @@ void Test_CF_CFDP_MsgOutGet(void)
 void UtTest_Setup(void)
 {
     UtTest_Add(Test_CF_CFDP_ReceiveMessage, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_ReceiveMessage");
+    UtTest_Add(Test_CF_CFDP_ReceiveMessage_Grouped, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown,
+               "CF_CFDP_ReceiveMessage_Grouped");
+    UtTest_Add(Test_CF_CFDP_ReceivePdu, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_ReceivePdu");
+    UtTest_Add(Test_CF_CFDP_GetRxBudget, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_GetRxBudget");
+    UtTest_Add(Test_CF_CFDP_UpdateRxBudget, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_UpdateRxBudget");
 
     UtTest_Add(Test_CF_CFDP_MsgOutGet, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_MsgOutGet");
     UtTest_Add(Test_CF_CFDP_Send, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_Send");
+    UtTest_Add(Test_CF_CFDP_GetTransport, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_GetTransport");
+    UtTest_Add(Test_CF_CFDP_SbGetBuffer, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_SbGetBuffer");
+    UtTest_Add(Test_CF_CFDP_SbReleaseBuffer, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_SbReleaseBuffer");
+    UtTest_Add(Test_CF_CFDP_SbSend, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_SbSend");
+    UtTest_Add(Test_CF_CFDP_SbReceiveBatch, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_SbReceiveBatch");
 }
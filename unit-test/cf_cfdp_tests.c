@@ -22,10 +22,15 @@
 #include "cf_test_alt_handler.h"
 #include "cf_events.h"
 #include "cf_cfdp.h"
+#include "cf_cfdp_r.h"
 #include "cf_cfdp_s.h"
 #include "cf_cfdp_pdu.h"
 #include "cf_cfdp_sbintf.h"
 #include "cf_cfdp_dispatch.h"
+#include "cf_udpintf.h"
+#include "cf_instr.h"
+#include "cf_trace.h"
+#include "cf_evagg.h"
 
 /*******************************************************************************
 **
@@ -256,6 +261,7 @@ void Test_CF_CFDP_RecvPh(void)
      * int CF_CFDP_RecvPh(uint8 chan_num, const CFE_SB_Buffer_t *msgbuf, CF_Logical_PduBuffer_t **pph)
      */
     CF_Logical_PduBuffer_t *ph;
+    uint32                  evs_count;
 
     /* nominal, file directive */
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, NULL, NULL);
@@ -272,6 +278,14 @@ void Test_CF_CFDP_RecvPh(void)
     UtAssert_INT32_EQ(CF_CFDP_RecvPh(UT_CFDP_CHANNEL, ph), CF_SHORT_PDU_ERROR);
     UT_CF_AssertEventID(CF_PDU_SHORT_HEADER_ERR_EID);
 
+    /* same, but a repeat within the aggregation interval is only counted */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, NULL, NULL);
+    CF_CODEC_SET_DONE(ph->pdec);
+    UT_SetDeferredRetcode(UT_KEY(CF_EvAgg_Suppress), 1, true);
+    evs_count = UT_GetStubCount(UT_KEY(CFE_EVS_SendEvent));
+    UtAssert_INT32_EQ(CF_CFDP_RecvPh(UT_CFDP_CHANNEL, ph), CF_SHORT_PDU_ERROR);
+    UtAssert_UINT32_EQ(UT_GetStubCount(UT_KEY(CFE_EVS_SendEvent)), evs_count);
+
     /* decode error, large file bit set */
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, NULL, NULL);
     ph->pdu_header.large_flag = true;
@@ -311,6 +325,42 @@ void Test_CF_CFDP_RecvMd(void)
                           sizeof(history->fnames.dst_filename));
     UtAssert_STRINGBUF_EQ(md->source_filename.data_ptr, md->source_filename.length, history->fnames.src_filename,
                           sizeof(history->fnames.src_filename));
+    UtAssert_BOOL_FALSE(txn->flags.com.compressed);
+
+    /* compressed file data is marked by a message to user, other options are ignored */
+    md->tlv_list.num_tlv              = 3;
+    md->tlv_list.tlv[0].type          = CF_CFDP_TLV_TYPE_ENTITY_ID;
+    md->tlv_list.tlv[1].type          = CF_CFDP_TLV_TYPE_MESSAGE_TO_USER;
+    md->tlv_list.tlv[1].length        = 4;
+    md->tlv_list.tlv[1].data.data_ptr = "CFZ0";
+    md->tlv_list.tlv[2].type          = CF_CFDP_TLV_TYPE_MESSAGE_TO_USER;
+    md->tlv_list.tlv[2].length        = sizeof(CF_COMPRESS_TLV_MSG) - 1;
+    md->tlv_list.tlv[2].data.data_ptr = CF_COMPRESS_TLV_MSG;
+    UtAssert_INT32_EQ(CF_CFDP_RecvMd(txn, ph), 0);
+    UtAssert_BOOL_TRUE(txn->flags.com.compressed);
+
+    /* a message to user that is not CF's */
+    md->tlv_list.num_tlv = 2;
+    UtAssert_INT32_EQ(CF_CFDP_RecvMd(txn, ph), 0);
+    UtAssert_BOOL_FALSE(txn->flags.com.compressed);
+    UtAssert_STUB_COUNT(CF_CFDP_R_DeltaSetAside, 0);
+
+    /* a delta is marked by another, and the old copy of the file is set aside for it */
+    md->tlv_list.num_tlv              = 3;
+    md->tlv_list.tlv[2].length        = sizeof(CF_DELTA_TLV_MSG) - 1;
+    md->tlv_list.tlv[2].data.data_ptr = CF_DELTA_TLV_MSG;
+    UtAssert_INT32_EQ(CF_CFDP_RecvMd(txn, ph), 0);
+    UtAssert_BOOL_FALSE(txn->flags.com.compressed);
+    UtAssert_BOOL_TRUE(txn->flags.com.delta);
+    UtAssert_STUB_COUNT(CF_CFDP_R_DeltaSetAside, 1);
+
+    /* and a bundle by another again */
+    md->tlv_list.tlv[2].length        = sizeof(CF_BUNDLE_TLV_MSG) - 1;
+    md->tlv_list.tlv[2].data.data_ptr = CF_BUNDLE_TLV_MSG;
+    UtAssert_INT32_EQ(CF_CFDP_RecvMd(txn, ph), 0);
+    UtAssert_BOOL_FALSE(txn->flags.com.delta);
+    UtAssert_BOOL_TRUE(txn->flags.com.bundle);
+    UtAssert_STUB_COUNT(CF_CFDP_R_DeltaSetAside, 1);
 
     /* decode errors: fixed part */
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
@@ -351,6 +401,7 @@ void Test_CF_CFDP_RecvFd(void)
     ph->int_header.fd.data_len = 10 + sizeof(CF_CFDP_uint32_t);
     UtAssert_INT32_EQ(CF_CFDP_RecvFd(txn, ph), 0);
     UtAssert_UINT32_EQ(ph->int_header.fd.data_len, 10);
+    UtAssert_STUB_COUNT(CF_Trace_Pdu, 2);
 
     /* decode errors: fixed part */
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
@@ -372,6 +423,9 @@ void Test_CF_CFDP_RecvFd(void)
     UtAssert_INT32_EQ(CF_CFDP_RecvFd(txn, ph), CF_ERROR);
     UtAssert_INT32_EQ(txn->history->txn_stat, CF_TxnStatus_PROTOCOL_ERROR);
     UT_CF_AssertEventID(CF_PDU_FD_UNSUPPORTED_ERR_EID);
+
+    /* only file data that decoded is traced */
+    UtAssert_STUB_COUNT(CF_Trace_Pdu, 2);
 }
 
 void Test_CF_CFDP_RecvEof(void)
@@ -453,6 +507,48 @@ void Test_CF_CFDP_RecvNak(void)
     UT_CF_AssertEventID(CF_PDU_NAK_SHORT_ERR_EID);
 }
 
+void Test_CF_CFDP_RecvPrompt(void)
+{
+    /* Test case for:
+     * int CF_CFDP_RecvPrompt(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
+     */
+
+    CF_Transaction_t *      txn;
+    CF_Logical_PduBuffer_t *ph;
+
+    /* nominal call */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    UtAssert_INT32_EQ(CF_CFDP_RecvPrompt(txn, ph), 0);
+    UtAssert_STUB_COUNT(CF_CFDP_DecodePrompt, 1);
+
+    /* decode errors: fixed part */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    CF_CODEC_SET_DONE(ph->pdec);
+    UtAssert_INT32_EQ(CF_CFDP_RecvPrompt(txn, ph), CF_SHORT_PDU_ERROR);
+    UT_CF_AssertEventID(CF_PDU_PROMPT_SHORT_ERR_EID);
+}
+
+void Test_CF_CFDP_RecvKeepAlive(void)
+{
+    /* Test case for:
+     * int CF_CFDP_RecvKeepAlive(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
+     */
+
+    CF_Transaction_t *      txn;
+    CF_Logical_PduBuffer_t *ph;
+
+    /* nominal call */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    UtAssert_INT32_EQ(CF_CFDP_RecvKeepAlive(txn, ph), 0);
+    UtAssert_STUB_COUNT(CF_CFDP_DecodeKeepAlive, 1);
+
+    /* decode errors: fixed part */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, &ph, NULL, NULL, &txn, NULL);
+    CF_CODEC_SET_DONE(ph->pdec);
+    UtAssert_INT32_EQ(CF_CFDP_RecvKeepAlive(txn, ph), CF_SHORT_PDU_ERROR);
+    UT_CF_AssertEventID(CF_PDU_KEEP_ALIVE_SHORT_ERR_EID);
+}
+
 void Test_CF_CFDP_RecvDrop(void)
 {
     /* Test case for:
@@ -555,13 +651,26 @@ CF_Logical_PduBuffer_t *CF_CFDP_ConstructPduHeader(const CF_Transaction_t *txn,
 
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
     UtAssert_NULL(CF_CFDP_ConstructPduHeader(txn, CF_CFDP_FileDirective_ACK, 3, 2, true, 42, false));
+    UtAssert_BOOL_TRUE(txn->history->waiting);
+
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    UtAssert_NULL(CF_CFDP_ConstructPduHeader(txn, CF_CFDP_FileDirective_ACK, 3, 2, true, 42, true));
 
+    /* a temporary transaction has no history to record the wait in */
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    txn->history = NULL;
     UtAssert_NULL(CF_CFDP_ConstructPduHeader(txn, CF_CFDP_FileDirective_ACK, 3, 2, true, 42, true));
 
+    /* every failure to get a buffer is traced as a stall */
+    UtAssert_STUB_COUNT(CF_Trace_Record, 3);
+
+    /* getting a buffer ends a wait */
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, &ph, NULL, NULL, &txn, NULL);
-    txn->state = CF_TxnState_S1;
+    txn->state            = CF_TxnState_S1;
+    txn->history->waiting = true;
     UtAssert_NOT_NULL(CF_CFDP_ConstructPduHeader(txn, CF_CFDP_FileDirective_ACK, 3, 2, true, 42, false));
+    UtAssert_BOOL_FALSE(txn->history->waiting);
+    UtAssert_STUB_COUNT(CF_AddElapsedUsec, 1);
     hdr = &ph->pdu_header;
     UtAssert_UINT32_EQ(hdr->version, 1);
     UtAssert_UINT32_EQ(hdr->pdu_type, 0);
@@ -612,6 +721,7 @@ void Test_CF_CFDP_SendMd(void)
     txn->state = CF_TxnState_S1;
     txn->fsize = 1234;
     UtAssert_INT32_EQ(CF_CFDP_SendMd(txn), CFE_SUCCESS);
+    UtAssert_UINT32_EQ(history->perf.pdus_sent, 1);
     UtAssert_UINT32_EQ(md->size, txn->fsize);
     UtAssert_STRINGBUF_EQ(md->dest_filename.data_ptr, md->dest_filename.length, history->fnames.dst_filename,
                           sizeof(history->fnames.dst_filename));
@@ -630,6 +740,63 @@ void Test_CF_CFDP_SendMd(void)
     UtAssert_UINT32_EQ(md->dest_filename.length, sizeof(history->fnames.dst_filename));
     UtAssert_STRINGBUF_EQ(md->source_filename.data_ptr, md->source_filename.length, history->fnames.src_filename,
                           sizeof(history->fnames.src_filename));
+    UtAssert_UINT32_EQ(md->tlv_list.num_tlv, 0);
+
+    /* compressed file data is marked for the receiver */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, &ph, NULL, &history, &txn, NULL);
+    md                        = &ph->int_header.md;
+    txn->state                = CF_TxnState_S2;
+    txn->flags.com.compressed = true;
+    UtAssert_INT32_EQ(CF_CFDP_SendMd(txn), CFE_SUCCESS);
+    UtAssert_UINT32_EQ(md->tlv_list.num_tlv, 1);
+    UtAssert_UINT32_EQ(md->tlv_list.tlv[0].type, CF_CFDP_TLV_TYPE_MESSAGE_TO_USER);
+
+    /* and so is a delta, with its own message */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, &ph, NULL, &history, &txn, NULL);
+    md                   = &ph->int_header.md;
+    txn->state           = CF_TxnState_S2;
+    txn->flags.com.delta = true;
+    UtAssert_INT32_EQ(CF_CFDP_SendMd(txn), CFE_SUCCESS);
+    UtAssert_UINT32_EQ(md->tlv_list.num_tlv, 1);
+    UtAssert_UINT32_EQ(md->tlv_list.tlv[0].type, CF_CFDP_TLV_TYPE_MESSAGE_TO_USER);
+    UtAssert_STRINGBUF_EQ(md->tlv_list.tlv[0].data.data_ptr, md->tlv_list.tlv[0].length, CF_DELTA_TLV_MSG,
+                          sizeof(CF_DELTA_TLV_MSG) - 1);
+
+    /* and a bundle */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, &ph, NULL, &history, &txn, NULL);
+    md                    = &ph->int_header.md;
+    txn->state            = CF_TxnState_S1;
+    txn->flags.com.bundle = true;
+    UtAssert_INT32_EQ(CF_CFDP_SendMd(txn), CFE_SUCCESS);
+    UtAssert_UINT32_EQ(md->tlv_list.num_tlv, 1);
+    UtAssert_STRINGBUF_EQ(md->tlv_list.tlv[0].data.data_ptr, md->tlv_list.tlv[0].length, CF_BUNDLE_TLV_MSG,
+                          sizeof(CF_BUNDLE_TLV_MSG) - 1);
+
+    /* a followed file has no size yet */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, &ph, NULL, &history, &txn, NULL);
+    md                   = &ph->int_header.md;
+    txn->state           = CF_TxnState_S2;
+    txn->fsize           = 4321;
+    txn->flags.tx.follow = true;
+    UtAssert_INT32_EQ(CF_CFDP_SendMd(txn), CFE_SUCCESS);
+    UtAssert_UINT32_EQ(md->size, 0);
+
+    /* nor does a file still being compressed */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, &ph, NULL, &history, &txn, NULL);
+    md                        = &ph->int_header.md;
+    txn->state                = CF_TxnState_S2;
+    txn->fsize                = 4321;
+    txn->flags.com.compressed = true;
+    txn->flags.tx.compressing = true;
+    UtAssert_INT32_EQ(CF_CFDP_SendMd(txn), CFE_SUCCESS);
+    UtAssert_UINT32_EQ(md->size, 0);
+    UtAssert_UINT32_EQ(md->tlv_list.num_tlv, 1);
+
+    /* once it is all compressed, a metadata sent again has the size */
+    txn->flags.tx.compressing = false;
+    md->tlv_list.num_tlv      = 0;
+    UtAssert_INT32_EQ(CF_CFDP_SendMd(txn), CFE_SUCCESS);
+    UtAssert_UINT32_EQ(md->size, 4321);
 }
 
 void Test_CF_CFDP_SendFd(void)
@@ -735,6 +902,15 @@ void Test_CF_CFDP_SendAck(void)
     UtAssert_UINT32_EQ(ack->ack_subtype_code, 1);
     UtAssert_UINT32_EQ(ack->txn_status, CF_CFDP_AckTxnStatus_TERMINATED);
     UtAssert_UINT32_EQ(ack->cc, CF_CFDP_ConditionCode_FILESTORE_REJECTION);
+
+    /* temporary transaction without history, as used to answer a spurious FIN */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, &ph, NULL, NULL, &txn, NULL);
+    txn->state   = CF_TxnState_S2;
+    txn->history = NULL;
+    UtAssert_INT32_EQ(CF_CFDP_SendAck(txn, CF_CFDP_AckTxnStatus_UNRECOGNIZED, CF_CFDP_FileDirective_FIN,
+                                      CF_CFDP_ConditionCode_NO_ERROR, 1, 42),
+                      CFE_SUCCESS);
+    UtAssert_STUB_COUNT(CF_CFDP_Send, 4);
 }
 
 void Test_CF_CFDP_SendFin(void)
@@ -796,6 +972,48 @@ void Test_CF_CFDP_SendNak(void)
     UtAssert_STUB_COUNT(CF_CFDP_Send, 1);
 }
 
+void Test_CF_CFDP_SendPrompt(void)
+{
+    /* Test case for:
+        CFE_Status_t CF_CFDP_SendPrompt(CF_Transaction_t *txn, CF_CFDP_PromptResponse_t response);
+     */
+    CF_Transaction_t *      txn;
+    CF_Logical_PduBuffer_t *ph;
+
+    /* setup without a tx message */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    UtAssert_INT32_EQ(CF_CFDP_SendPrompt(txn, CF_CFDP_PromptResponse_NAK), CF_SEND_PDU_NO_BUF_AVAIL_ERROR);
+
+    /* nominal */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, &ph, NULL, NULL, &txn, NULL);
+    txn->state = CF_TxnState_S2;
+    UtAssert_INT32_EQ(CF_CFDP_SendPrompt(txn, CF_CFDP_PromptResponse_KEEP_ALIVE), CFE_SUCCESS);
+    UtAssert_UINT32_EQ(ph->int_header.prompt.response_required, CF_CFDP_PromptResponse_KEEP_ALIVE);
+    UtAssert_STUB_COUNT(CF_CFDP_EncodePrompt, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_Send, 1);
+}
+
+void Test_CF_CFDP_SendKeepAlive(void)
+{
+    /* Test case for:
+        CFE_Status_t CF_CFDP_SendKeepAlive(CF_Transaction_t *txn, CF_FileSize_t progress);
+     */
+    CF_Transaction_t *      txn;
+    CF_Logical_PduBuffer_t *ph;
+
+    /* setup without a tx message */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    UtAssert_INT32_EQ(CF_CFDP_SendKeepAlive(txn, 100), CF_SEND_PDU_NO_BUF_AVAIL_ERROR);
+
+    /* nominal */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, &ph, NULL, NULL, &txn, NULL);
+    txn->state = CF_TxnState_R2;
+    UtAssert_INT32_EQ(CF_CFDP_SendKeepAlive(txn, 100), CFE_SUCCESS);
+    UtAssert_UINT32_EQ(ph->int_header.keep_alive.progress, 100);
+    UtAssert_STUB_COUNT(CF_CFDP_EncodeKeepAlive, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_Send, 1);
+}
+
 void Test_CF_CFDP_AppendTlv(void)
 {
     /* Test case for:
@@ -820,6 +1038,11 @@ void Test_CF_CFDP_AppendTlv(void)
     UtAssert_UINT32_EQ(tlv_list->tlv[1].data.eid, config->local_eid);
     UtAssert_UINT32_EQ(tlv_list->num_tlv, 2);
 
+    UtAssert_VOIDCALL(CF_CFDP_AppendTlv(tlv_list, CF_CFDP_TLV_TYPE_MESSAGE_TO_USER));
+    UtAssert_STRINGBUF_EQ(tlv_list->tlv[2].data.data_ptr, tlv_list->tlv[2].length, CF_COMPRESS_TLV_MSG, -1);
+    UtAssert_UINT32_EQ(tlv_list->tlv[2].length, sizeof(CF_COMPRESS_TLV_MSG) - 1);
+    UtAssert_UINT32_EQ(tlv_list->num_tlv, 3);
+
     /* call w/max should be no-op */
     tlv_list->num_tlv = CF_PDU_MAX_TLV;
     UtAssert_VOIDCALL(CF_CFDP_AppendTlv(tlv_list, 1));
@@ -856,6 +1079,8 @@ void Test_CF_CFDP_InitEngine(void)
     UtAssert_INT32_EQ(CF_CFDP_InitEngine(), 0);
     UtAssert_BOOL_TRUE(CF_AppData.engine.enabled);
     UtAssert_STUB_COUNT(CF_FreeTransaction, CF_NUM_TRANSACTIONS_PER_CHANNEL * CF_NUM_CHANNELS);
+    UtAssert_STUB_COUNT(CF_Ckpt_Restore, 1);
+    UtAssert_STUB_COUNT(CF_Delivered_Load, 1);
 
     /* nominal call, with sem */
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, NULL, &config);
@@ -870,6 +1095,7 @@ void Test_CF_CFDP_InitEngine(void)
     UtAssert_INT32_EQ(CF_CFDP_InitEngine(), OS_ERROR);
     UtAssert_BOOL_FALSE(CF_AppData.engine.enabled);
     UT_CF_AssertEventID(CF_INIT_SEM_ERR_EID);
+    UtAssert_STUB_COUNT(CF_Ckpt_Restore, 2);
 
     /* Max retries of OS_CountSemGetIdByName - sem was never created at all  */
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, NULL, &config);
@@ -899,13 +1125,28 @@ void Test_CF_CFDP_InitEngine(void)
     UT_SetDeferredRetcode(UT_KEY(CFE_SB_SubscribeLocal), 1, CFE_STATUS_EXTERNAL_RESOURCE_FAIL);
     UtAssert_INT32_EQ(CF_CFDP_InitEngine(), CFE_STATUS_EXTERNAL_RESOURCE_FAIL);
     UtAssert_BOOL_FALSE(CF_AppData.engine.enabled);
+
+    /* channel configured for UDP */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, NULL, &config);
+    config->chan[0].udp_local_port = 1234;
+    UtAssert_INT32_EQ(CF_CFDP_InitEngine(), 0);
+    UtAssert_BOOL_TRUE(CF_AppData.engine.enabled);
+    UtAssert_STUB_COUNT(CF_UdpIntf_Open, 1);
+
+    /* failure of CF_UdpIntf_Open */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, NULL, &config);
+    config->chan[0].udp_local_port = 1234;
+    UT_SetDeferredRetcode(UT_KEY(CF_UdpIntf_Open), 1, OS_ERROR);
+    UtAssert_INT32_EQ(CF_CFDP_InitEngine(), OS_ERROR);
+    UtAssert_BOOL_FALSE(CF_AppData.engine.enabled);
 }
 
 void Test_CF_CFDP_TxFile(void)
 {
     /* Test case for:
      * int32 CF_CFDP_TxFile(const char *src_filename, const char *dst_filename,
-                            CF_CFDP_Class_t cfdp_class, uint8 keep, uint8 chan, uint8 priority, CF_EntityId_t dest_id);
+                            CF_CFDP_Class_t cfdp_class, uint8 keep, uint8 chan, uint8 priority, CF_EntityId_t dest_id,
+                            uint8 compress);
 
      */
     const char        src[]  = "tsrc";
@@ -924,7 +1165,7 @@ void Test_CF_CFDP_TxFile(void)
     UT_SetHandlerFunction(UT_KEY(CF_FindUnusedTransaction), UT_AltHandler_GenericPointerReturn, txn);
     UT_SetHandlerFunction(UT_KEY(CF_CList_Pop), UT_AltHandler_GenericPointerReturn, &chunk_wrap.cl_node);
     chan->cs[CF_Direction_TX] = &chunk_wrap.cl_node;
-    UtAssert_INT32_EQ(CF_CFDP_TxFile(src, dest, CF_CFDP_CLASS_1, 1, UT_CFDP_CHANNEL, 0, 1), 0);
+    UtAssert_INT32_EQ(CF_CFDP_TxFile(src, dest, CF_CFDP_CLASS_1, 1, UT_CFDP_CHANNEL, 0, 1, CF_TxCompress_CHANNEL), 0);
     UtAssert_STRINGBUF_EQ(dest, -1, history->fnames.dst_filename, sizeof(history->fnames.dst_filename));
     UtAssert_STRINGBUF_EQ(src, -1, history->fnames.src_filename, sizeof(history->fnames.src_filename));
     UtAssert_UINT32_EQ(chan->num_cmd_tx, 1);
@@ -935,17 +1176,101 @@ void Test_CF_CFDP_TxFile(void)
     UT_SetHandlerFunction(UT_KEY(CF_FindUnusedTransaction), UT_AltHandler_GenericPointerReturn, txn);
     UT_SetHandlerFunction(UT_KEY(CF_CList_Pop), UT_AltHandler_GenericPointerReturn, &chunk_wrap.cl_node);
     chan->cs[CF_Direction_TX] = &chunk_wrap.cl_node;
-    UtAssert_INT32_EQ(CF_CFDP_TxFile(src, dest, CF_CFDP_CLASS_2, 1, UT_CFDP_CHANNEL, 0, 1), 0);
+    UtAssert_INT32_EQ(CF_CFDP_TxFile(src, dest, CF_CFDP_CLASS_2, 1, UT_CFDP_CHANNEL, 0, 1, CF_TxCompress_ON), 0);
     UtAssert_STRINGBUF_EQ(dest, -1, history->fnames.dst_filename, sizeof(history->fnames.dst_filename));
     UtAssert_STRINGBUF_EQ(src, -1, history->fnames.src_filename, sizeof(history->fnames.src_filename));
     UtAssert_UINT32_EQ(chan->num_cmd_tx, 2);
+    UtAssert_UINT32_EQ(txn->compress, CF_TxCompress_ON);
     UT_CF_AssertEventID(CF_CFDP_S_START_SEND_INF_EID);
 
     /* max TX */
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, &chan, &history, &txn, NULL);
     chan->num_cmd_tx = CF_MAX_COMMANDED_PLAYBACK_FILES_PER_CHAN;
-    UtAssert_INT32_EQ(CF_CFDP_TxFile(src, dest, CF_CFDP_CLASS_1, 1, UT_CFDP_CHANNEL, 0, 1), -1);
+    UtAssert_INT32_EQ(CF_CFDP_TxFile(src, dest, CF_CFDP_CLASS_1, 1, UT_CFDP_CHANNEL, 0, 1, CF_TxCompress_CHANNEL), -1);
+    UT_CF_AssertEventID(CF_CFDP_MAX_CMD_TX_ERR_EID);
+}
+
+void Test_CF_CFDP_TxFileMulti(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_CFDP_TxFileMulti(const char *src_filename, const char *dst_filename, CF_CFDP_Class_t cfdp_class,
+     *                                  uint8 keep, uint8 chan_num, uint8 priority, const CF_EntityId_t *dest_ids,
+     *                                  uint8 num_dest);
+     */
+    const char          src[]      = "msrc";
+    const char          dest[]     = "mdest";
+    const CF_EntityId_t dest_ids[] = {2, 3};
+    CF_History_t *      history;
+    CF_Transaction_t *  txn;
+    CF_Channel_t *      chan;
+    CF_ChunkWrapper_t   chunk_wrap;
+    CF_FanOut_t         group;
+
+    memset(&chunk_wrap, 0, sizeof(chunk_wrap));
+    memset(&group, 0, sizeof(group));
+
+    /* nominal call, one transaction per destination sharing one group */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, &chan, &history, &txn, NULL);
+    UT_SetHandlerFunction(UT_KEY(CF_FanOut_Open), UT_AltHandler_GenericPointerReturn, &group);
+    UT_SetHandlerFunction(UT_KEY(CF_FindUnusedTransaction), UT_AltHandler_GenericPointerReturn, txn);
+    UT_SetHandlerFunction(UT_KEY(CF_CList_Pop), UT_AltHandler_GenericPointerReturn, &chunk_wrap.cl_node);
+    chan->cs[CF_Direction_TX] = &chunk_wrap.cl_node;
+    UtAssert_INT32_EQ(CF_CFDP_TxFileMulti(src, dest, CF_CFDP_CLASS_2, 0, UT_CFDP_CHANNEL, 0, dest_ids, 2), CFE_SUCCESS);
+    UtAssert_STRINGBUF_EQ(dest, -1, history->fnames.dst_filename, sizeof(history->fnames.dst_filename));
+    UtAssert_STRINGBUF_EQ(src, -1, history->fnames.src_filename, sizeof(history->fnames.src_filename));
+    UtAssert_ADDRESS_EQ(txn->fanout, &group);
+    UtAssert_STUB_COUNT(CF_FanOut_Open, 1);
+    UtAssert_STUB_COUNT(CF_FanOut_Attach, 2);
+    UtAssert_UINT32_EQ(chan->num_cmd_tx, 2);
+    UtAssert_UINT32_EQ(history->peer_eid, 3);
+
+    /* source file could not be opened */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, &chan, NULL, NULL, NULL);
+    UT_SetHandlerFunction(UT_KEY(CF_FanOut_Open), NULL, NULL);
+    chan->num_cmd_tx = 0;
+    UtAssert_INT32_EQ(CF_CFDP_TxFileMulti(src, dest, CF_CFDP_CLASS_2, 0, UT_CFDP_CHANNEL, 0, dest_ids, 2), CF_ERROR);
+    UT_CF_AssertEventID(CF_CFDP_FANOUT_ERR_EID);
+    UtAssert_UINT32_EQ(chan->num_cmd_tx, 0);
+
+    /* not enough room for all destinations */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, &chan, NULL, NULL, NULL);
+    chan->num_cmd_tx = CF_MAX_COMMANDED_PLAYBACK_FILES_PER_CHAN - 1;
+    UtAssert_INT32_EQ(CF_CFDP_TxFileMulti(src, dest, CF_CFDP_CLASS_2, 0, UT_CFDP_CHANNEL, 0, dest_ids, 2), CF_ERROR);
+    UT_CF_AssertEventID(CF_CFDP_MAX_CMD_TX_ERR_EID);
+    UtAssert_STUB_COUNT(CF_FanOut_Open, 2);
+}
+
+void Test_CF_CFDP_TxFileFollow(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_CFDP_TxFileFollow(const char *src_filename, const char *dst_filename, CF_CFDP_Class_t cfdp_class,
+     *                                   uint8 keep, uint8 chan_num, uint8 priority, CF_EntityId_t dest_id);
+     */
+    const char        src[]  = "fsrc";
+    const char        dest[] = "fdest";
+    CF_History_t *    history;
+    CF_Transaction_t *txn;
+    CF_Channel_t *    chan;
+    CF_ChunkWrapper_t chunk_wrap;
+
+    memset(&chunk_wrap, 0, sizeof(chunk_wrap));
+
+    /* nominal call, the transaction is marked as following its file */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, &chan, &history, &txn, NULL);
+    UT_SetHandlerFunction(UT_KEY(CF_FindUnusedTransaction), UT_AltHandler_GenericPointerReturn, txn);
+    UT_SetHandlerFunction(UT_KEY(CF_CList_Pop), UT_AltHandler_GenericPointerReturn, &chunk_wrap.cl_node);
+    chan->cs[CF_Direction_TX] = &chunk_wrap.cl_node;
+    UtAssert_INT32_EQ(CF_CFDP_TxFileFollow(src, dest, CF_CFDP_CLASS_2, 1, UT_CFDP_CHANNEL, 0, 1), CFE_SUCCESS);
+    UtAssert_STRINGBUF_EQ(src, -1, history->fnames.src_filename, sizeof(history->fnames.src_filename));
+    UtAssert_BOOL_TRUE(txn->flags.tx.follow);
+    UtAssert_UINT32_EQ(chan->num_cmd_tx, 1);
+
+    /* max TX */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, &chan, &history, &txn, NULL);
+    chan->num_cmd_tx = CF_MAX_COMMANDED_PLAYBACK_FILES_PER_CHAN;
+    UtAssert_INT32_EQ(CF_CFDP_TxFileFollow(src, dest, CF_CFDP_CLASS_2, 1, UT_CFDP_CHANNEL, 0, 1), CF_ERROR);
     UT_CF_AssertEventID(CF_CFDP_MAX_CMD_TX_ERR_EID);
+    UtAssert_BOOL_FALSE(txn->flags.tx.follow);
 }
 
 void Test_CF_CFDP_PlaybackDir(void)
@@ -953,7 +1278,8 @@ void Test_CF_CFDP_PlaybackDir(void)
     /* Test case for:
      * int32 CF_CFDP_PlaybackDir(const char *src_filename,
                                  const char *dst_filename, CF_CFDP_Class_t cfdp_class, uint8 keep,
-                                 uint8 chan, uint8 priority, uint16 dest_id);
+                                 uint8 chan, uint8 priority, uint16 dest_id, uint8 max_ts,
+                                 uint8 order, uint8 compress);
      */
     const char     src[]  = "psrc";
     const char     dest[] = "pdest";
@@ -965,16 +1291,32 @@ void Test_CF_CFDP_PlaybackDir(void)
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, &chan, NULL, NULL, NULL);
     pb = &chan->playback[0];
     memset(pb, 0, sizeof(*pb));
-    UtAssert_INT32_EQ(CF_CFDP_PlaybackDir(src, dest, CF_CFDP_CLASS_1, 1, UT_CFDP_CHANNEL, 0, 1), 0);
+    UtAssert_INT32_EQ(CF_CFDP_PlaybackDir(src, dest, CF_CFDP_CLASS_1, 1, UT_CFDP_CHANNEL, 0, 1, 0, 0, 0), 0);
     UtAssert_STRINGBUF_EQ(dest, -1, pb->fnames.dst_filename, sizeof(pb->fnames.dst_filename));
     UtAssert_STRINGBUF_EQ(src, -1, pb->fnames.src_filename, sizeof(pb->fnames.src_filename));
     UtAssert_BOOL_TRUE(pb->diropen);
     UtAssert_BOOL_TRUE(pb->busy);
+    UtAssert_UINT32_EQ(pb->max_ts, CF_NUM_TRANSACTIONS_PER_PLAYBACK);
+    UtAssert_UINT32_EQ(pb->order, CF_PlaybackOrder_NAME);
+
+    /* fewer files at once, or more than are set aside */
+    memset(pb, 0, sizeof(*pb));
+    UtAssert_INT32_EQ(CF_CFDP_PlaybackDir(src, dest, CF_CFDP_CLASS_1, 1, UT_CFDP_CHANNEL, 0, 1, 1,
+                                          CF_PlaybackOrder_NEWEST, CF_TxCompress_OFF),
+                      0);
+    UtAssert_UINT32_EQ(pb->max_ts, 1);
+    UtAssert_UINT32_EQ(pb->order, CF_PlaybackOrder_NEWEST);
+    UtAssert_UINT32_EQ(pb->compress, CF_TxCompress_OFF);
+    memset(pb, 0, sizeof(*pb));
+    UtAssert_INT32_EQ(CF_CFDP_PlaybackDir(src, dest, CF_CFDP_CLASS_1, 1, UT_CFDP_CHANNEL, 0, 1,
+                                          CF_NUM_TRANSACTIONS_PER_PLAYBACK + 1, 0, 0),
+                      0);
+    UtAssert_UINT32_EQ(pb->max_ts, CF_NUM_TRANSACTIONS_PER_PLAYBACK + 1);
 
     /* OS_DirectoryOpen fail */
     memset(pb, 0, sizeof(*pb));
     UT_SetDeferredRetcode(UT_KEY(OS_DirectoryOpen), 1, OS_ERROR);
-    UtAssert_INT32_EQ(CF_CFDP_PlaybackDir(src, dest, CF_CFDP_CLASS_1, 1, UT_CFDP_CHANNEL, 0, 1), -1);
+    UtAssert_INT32_EQ(CF_CFDP_PlaybackDir(src, dest, CF_CFDP_CLASS_1, 1, UT_CFDP_CHANNEL, 0, 1, 0, 0, 0), -1);
     UT_CF_AssertEventID(CF_CFDP_OPENDIR_ERR_EID);
 
     /* no non-busy entries */
@@ -984,7 +1326,7 @@ void Test_CF_CFDP_PlaybackDir(void)
         pb       = &chan->playback[i];
         pb->busy = true;
     }
-    UtAssert_INT32_EQ(CF_CFDP_PlaybackDir(src, dest, CF_CFDP_CLASS_1, 1, UT_CFDP_CHANNEL, 0, 1), -1);
+    UtAssert_INT32_EQ(CF_CFDP_PlaybackDir(src, dest, CF_CFDP_CLASS_1, 1, UT_CFDP_CHANNEL, 0, 1, 0, 0, 0), -1);
     UT_CF_AssertEventID(CF_CFDP_DIR_SLOT_ERR_EID);
 }
 
@@ -1001,6 +1343,68 @@ static int32 Ut_Hook_CycleTx_SetRanOne(void *UserObj, int32 StubRetcode, uint32
     return StubRetcode;
 }
 
+/* a member of a group takes a turn and the channel is then out of buffers */
+static void UT_AltHandler_CycleTx_OutOfBuffers(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CF_CFDP_CycleTx_args_t *args = UT_Hook_GetArgValueByName(Context, "context", CF_CFDP_CycleTx_args_t *);
+
+    args->ran_one    = 1;
+    args->ran_fanout = true;
+    args->chan->cur  = UserObj;
+}
+
+/* the first pass finds nothing on TXA, then the group takes two turns and the third runs out of room */
+static int32 Ut_Hook_CycleTx_FanOut(void *UserObj, int32 StubRetcode, uint32 CallCount,
+                                    const UT_StubContext_t *Context)
+{
+    CF_CListFn_t            fn     = UT_Hook_GetArgValueByName(Context, "fn", CF_CListFn_t);
+    CF_CFDP_CycleTx_args_t *args   = UT_Hook_GetArgValueByName(Context, "context", CF_CFDP_CycleTx_args_t *);
+    uint32 *                passes = UserObj;
+
+    if (fn == CF_CFDP_CycleTxFirstActive && (*passes)++ > 0)
+    {
+        args->ran_one = 1;
+        if (*passes < 4)
+        {
+            args->ran_fanout = true;
+        }
+    }
+
+    return StubRetcode;
+}
+
+/* a followed file catches up with the data written so far and waits on TXW for more, any other send finishes */
+static int32 Ut_Hook_StateHandler_FollowWait(void *UserObj, int32 StubRetcode, uint32 CallCount,
+                                             const UT_StubContext_t *Context)
+{
+    CF_Transaction_t *txn = UT_Hook_GetArgValueByName(Context, "txn", CF_Transaction_t *);
+
+    if (txn->flags.tx.follow)
+    {
+        txn->flags.com.q_index    = CF_QueueIdx_TXW;
+        txn->flags.tx.follow_wait = true;
+    }
+    else
+    {
+        txn->flags.com.q_index = CF_QueueIdx_FREE;
+    }
+    return StubRetcode;
+}
+
+/* runs CF_CFDP_CycleTxFirstActive() on the head of TXA, and TXA then holds what is in UserObj */
+static void UT_AltHandler_CycleTx_RunTxa(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CF_CListNode_t *        start = UT_Hook_GetArgValueByName(Context, "start", CF_CListNode_t *);
+    CF_CListFn_t            fn    = UT_Hook_GetArgValueByName(Context, "fn", CF_CListFn_t);
+    CF_CFDP_CycleTx_args_t *args  = UT_Hook_GetArgValueByName(Context, "context", CF_CFDP_CycleTx_args_t *);
+
+    if (fn == CF_CFDP_CycleTxFirstActive && start)
+    {
+        fn(start, args);
+        args->chan->qs[CF_QueueIdx_TXA] = UserObj;
+    }
+}
+
 void Test_CF_CFDP_CycleTx(void)
 {
     /* Test case for:
@@ -1010,6 +1414,7 @@ void Test_CF_CFDP_CycleTx(void)
     CF_Transaction_t *txn;
     CF_ConfigTable_t *config;
     CF_Transaction_t  txn2;
+    uint32            passes;
 
     memset(&txn2, 0, sizeof(txn2));
 
@@ -1034,6 +1439,102 @@ void Test_CF_CFDP_CycleTx(void)
     chan->qs[CF_QueueIdx_PEND] = &txn2.cl_node;
     UtAssert_VOIDCALL(CF_CFDP_CycleTx(chan));
     UtAssert_STUB_COUNT(CF_CList_Traverse, 2);
+
+    /* the next pending sends are got ready, even when picking up from tick processing */
+    UT_ResetState(UT_KEY(CF_CList_Traverse));
+    config->chan[UT_CFDP_CHANNEL].tx_prefetch_depth = 2;
+    chan->cur                                       = txn;
+    UtAssert_VOIDCALL(CF_CFDP_CycleTx(chan));
+    UtAssert_STUB_COUNT(CF_CList_Traverse, 1);
+    UtAssert_NULL(chan->cur);
+
+    /* the first of a multi-destination send starts the rest of its group, then they take turns */
+    UT_ResetState(UT_KEY(CF_CList_Traverse));
+    config->chan[UT_CFDP_CHANNEL].tx_prefetch_depth = 0;
+    txn2.fanout                                     = &CF_AppData.engine.fanouts[0];
+    txn2.flags.com.q_index                          = CF_QueueIdx_PEND;
+    passes                                          = 0;
+    UT_SetHookFunction(UT_KEY(CF_CList_Traverse), Ut_Hook_CycleTx_FanOut, &passes);
+    UtAssert_VOIDCALL(CF_CFDP_CycleTx(chan));
+    UtAssert_UINT32_EQ(passes, 4);
+    UtAssert_STUB_COUNT(CF_CList_Traverse, 5);
+    UtAssert_UINT32_EQ(txn2.flags.com.q_index, CF_QueueIdx_TXA);
+
+    /* a turn that runs out of buffers ends the cycle */
+    UT_ResetState(UT_KEY(CF_CList_Traverse));
+    UT_SetHandlerFunction(UT_KEY(CF_CList_Traverse), UT_AltHandler_CycleTx_OutOfBuffers, txn);
+    UtAssert_VOIDCALL(CF_CFDP_CycleTx(chan));
+    UtAssert_STUB_COUNT(CF_CList_Traverse, 1);
+    UtAssert_NULL(chan->cur);
+
+    /* a followed file on TXA with nothing new steps aside, so the pending send behind it starts this cycle */
+    UT_ResetState(UT_KEY(CF_CList_Traverse));
+    txn->flags.com.q_index     = CF_QueueIdx_TXA;
+    txn->flags.tx.follow       = true;
+    txn2.fanout                = NULL;
+    txn2.flags.com.q_index     = CF_QueueIdx_PEND;
+    chan->qs[CF_QueueIdx_TXA]  = &txn->cl_node;
+    chan->qs[CF_QueueIdx_PEND] = &txn2.cl_node;
+    UT_SetHandlerFunction(UT_KEY(CF_CList_Traverse), UT_AltHandler_CycleTx_RunTxa, &txn2.cl_node);
+    UT_SetHookFunction(UT_KEY(CF_CFDP_TxStateDispatch), Ut_Hook_StateHandler_FollowWait, NULL);
+    UtAssert_VOIDCALL(CF_CFDP_CycleTx(chan));
+    UtAssert_STUB_COUNT(CF_CList_Traverse, 2);
+    UtAssert_STUB_COUNT(CF_CFDP_TxStateDispatch, 2);
+    UtAssert_BOOL_TRUE(txn->flags.tx.follow_wait);
+    UtAssert_UINT32_EQ(txn->flags.com.q_index, CF_QueueIdx_TXW);
+    UtAssert_UINT32_EQ(txn2.flags.com.q_index, CF_QueueIdx_FREE);
+}
+
+void Test_CF_CFDP_PrefetchTxNext(void)
+{
+    /* Test case for:
+     * CF_CListTraverse_Status_t CF_CFDP_PrefetchTxNext(CF_CListNode_t *node, void *context);
+     */
+    CF_CFDP_PrefetchTx_args_t args;
+    CF_Transaction_t *        txn;
+
+    /* nominal, the send is got ready */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    args.count = 0;
+    args.depth = 2;
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_S_Prefetch), true);
+    UtAssert_INT32_EQ(CF_CFDP_PrefetchTxNext(&txn->cl_node, &args), CF_CLIST_CONT);
+    UtAssert_STUB_COUNT(CF_CFDP_S_Prefetch, 1);
+    UtAssert_UINT32_EQ(args.count, 1);
+
+    /* already open, resumed part way through, suspended, or sharing a group's file, so nothing to do */
+    txn->fd = OS_ObjectIdFromInteger(1);
+    UtAssert_INT32_EQ(CF_CFDP_PrefetchTxNext(&txn->cl_node, &args), CF_CLIST_CONT);
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    args.count = 0;
+    txn->foffs = 100;
+    UtAssert_INT32_EQ(CF_CFDP_PrefetchTxNext(&txn->cl_node, &args), CF_CLIST_CONT);
+    txn->foffs               = 0;
+    txn->flags.com.suspended = true;
+    UtAssert_INT32_EQ(CF_CFDP_PrefetchTxNext(&txn->cl_node, &args), CF_CLIST_CONT);
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    args.count  = 0;
+    txn->fanout = &CF_AppData.engine.fanouts[0];
+    UtAssert_INT32_EQ(CF_CFDP_PrefetchTxNext(&txn->cl_node, &args), CF_CLIST_CONT);
+    UtAssert_STUB_COUNT(CF_CFDP_S_Prefetch, 1);
+
+    /* deep enough */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    args.count = 2;
+    UtAssert_INT32_EQ(CF_CFDP_PrefetchTxNext(&txn->cl_node, &args), CF_CLIST_EXIT);
+    UtAssert_STUB_COUNT(CF_CFDP_S_Prefetch, 1);
+
+    /* no buffer free */
+    args.count = 0;
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_S_Prefetch), false);
+    UtAssert_INT32_EQ(CF_CFDP_PrefetchTxNext(&txn->cl_node, &args), CF_CLIST_EXIT);
+    UtAssert_STUB_COUNT(CF_CFDP_S_Prefetch, 2);
+
+    /* out of time */
+    args.count                      = 0;
+    CF_AppData.engine.cycle_expired = true;
+    UtAssert_INT32_EQ(CF_CFDP_PrefetchTxNext(&txn->cl_node, &args), CF_CLIST_EXIT);
+    UtAssert_STUB_COUNT(CF_CFDP_S_Prefetch, 2);
 }
 
 static int32 Ut_Hook_StateHandler_SetQIndex(void *UserObj, int32 StubRetcode, uint32 CallCount,
@@ -1075,6 +1576,90 @@ void Test_CF_CFDP_CycleTxFirstActive(void)
     args.chan->cur         = NULL;
     UT_SetHookFunction(UT_KEY(CF_CFDP_TxStateDispatch), Ut_Hook_StateHandler_SetQIndex, NULL);
     UtAssert_INT32_EQ(CF_CFDP_CycleTxFirstActive(&txn->cl_node, &args), CF_CListTraverse_Status_EXIT);
+    UtAssert_STUB_COUNT(CF_CFDP_TxStateDispatch, 1);
+
+    /* out of time this cycle, nothing is sent but the traversal still stops here */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->flags.com.q_index          = CF_QueueIdx_TXA;
+    args.chan->cur                  = NULL;
+    args.ran_one                    = 0;
+    CF_AppData.engine.cycle_usec    = 1;
+    CF_AppData.engine.cycle_expired = true;
+    UtAssert_INT32_EQ(CF_CFDP_CycleTxFirstActive(&txn->cl_node, &args), CF_CListTraverse_Status_EXIT);
+    UtAssert_STUB_COUNT(CF_CFDP_TxStateDispatch, 1);
+    UtAssert_BOOL_TRUE(args.ran_one);
+
+    /* a member of a multi-destination send takes one step, and the traversal goes on to the next member */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->flags.com.q_index          = CF_QueueIdx_TXA;
+    txn->fanout                     = &CF_AppData.engine.fanouts[0];
+    args.chan->cur                  = NULL;
+    args.ran_one                    = 0;
+    args.ran_fanout                 = false;
+    CF_AppData.engine.cycle_usec    = 0;
+    CF_AppData.engine.cycle_expired = false;
+    UtAssert_INT32_EQ(CF_CFDP_CycleTxFirstActive(&txn->cl_node, &args), CF_CListTraverse_Status_CONTINUE);
+    UtAssert_STUB_COUNT(CF_CFDP_TxStateDispatch, 2);
+    UtAssert_BOOL_TRUE(args.ran_one);
+    UtAssert_BOOL_TRUE(args.ran_fanout);
+
+    /* ... unless that step used up the output buffers */
+    args.chan->cur = txn;
+    UtAssert_INT32_EQ(CF_CFDP_CycleTxFirstActive(&txn->cl_node, &args), CF_CListTraverse_Status_EXIT);
+    UtAssert_STUB_COUNT(CF_CFDP_TxStateDispatch, 2);
+
+    /* out of time, no step is taken */
+    args.chan->cur                  = NULL;
+    args.ran_fanout                 = false;
+    CF_AppData.engine.cycle_usec    = 1;
+    CF_AppData.engine.cycle_expired = true;
+    UtAssert_INT32_EQ(CF_CFDP_CycleTxFirstActive(&txn->cl_node, &args), CF_CListTraverse_Status_CONTINUE);
+    UtAssert_STUB_COUNT(CF_CFDP_TxStateDispatch, 2);
+    UtAssert_BOOL_FALSE(args.ran_fanout);
+
+    /* a followed file waiting for more data does not hold up the channel, so a pending send can start */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->flags.com.q_index          = CF_QueueIdx_TXA;
+    txn->flags.tx.follow            = true;
+    args.chan->cur                  = NULL;
+    args.ran_one                    = 0;
+    CF_AppData.engine.cycle_usec    = 0;
+    CF_AppData.engine.cycle_expired = false;
+    UT_SetHookFunction(UT_KEY(CF_CFDP_TxStateDispatch), Ut_Hook_StateHandler_FollowWait, NULL);
+    UtAssert_INT32_EQ(CF_CFDP_CycleTxFirstActive(&txn->cl_node, &args), CF_CListTraverse_Status_CONTINUE);
+    UtAssert_STUB_COUNT(CF_CFDP_TxStateDispatch, 3);
+    UtAssert_BOOL_FALSE(args.ran_one);
+    UtAssert_NULL(args.chan->cur);
+
+    /* ... unless the cycle is out of time by then */
+    txn->flags.com.q_index          = CF_QueueIdx_TXA;
+    CF_AppData.engine.cycle_usec    = 1;
+    CF_AppData.engine.cycle_expired = true;
+    UtAssert_INT32_EQ(CF_CFDP_CycleTxFirstActive(&txn->cl_node, &args), CF_CListTraverse_Status_EXIT);
+    UtAssert_BOOL_TRUE(args.ran_one);
+}
+
+void Test_CF_CFDP_ActivateFanOut(void)
+{
+    /* Test case for:
+     * CF_CListTraverse_Status_t CF_CFDP_ActivateFanOut(CF_CListNode_t *node, void *context);
+     */
+    CF_Transaction_t *txn;
+
+    /* another group, or none, is left pending */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->flags.com.q_index                                                   = CF_QueueIdx_PEND;
+    CF_AppData.hk.Payload.channel_hk[txn->chan_num].q_size[CF_QueueIdx_PEND] = 1;
+    UtAssert_INT32_EQ(CF_CFDP_ActivateFanOut(&txn->cl_node, &CF_AppData.engine.fanouts[0]), CF_CLIST_CONT);
+    txn->fanout = &CF_AppData.engine.fanouts[1];
+    UtAssert_INT32_EQ(CF_CFDP_ActivateFanOut(&txn->cl_node, &CF_AppData.engine.fanouts[0]), CF_CLIST_CONT);
+    UtAssert_UINT32_EQ(txn->flags.com.q_index, CF_QueueIdx_PEND);
+
+    /* same group, made active */
+    txn->fanout = &CF_AppData.engine.fanouts[0];
+    UtAssert_INT32_EQ(CF_CFDP_ActivateFanOut(&txn->cl_node, &CF_AppData.engine.fanouts[0]), CF_CLIST_CONT);
+    UtAssert_UINT32_EQ(txn->flags.com.q_index, CF_QueueIdx_TXA);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[txn->chan_num].q_size[CF_QueueIdx_TXA], 1);
 }
 
 static void DoTickFnClearCont(CF_Transaction_t *txn, int *cont)
@@ -1121,6 +1706,25 @@ void Test_CF_CFDP_DoTick(void)
     args.fn = DoTickFnSetCur;
     UtAssert_INT32_EQ(CF_CFDP_DoTick(&txn->cl_node, &args), CF_CLIST_EXIT);
     UtAssert_BOOL_TRUE(args.early_exit);
+
+    /* out of time, but nothing was ticked yet in this traversal, so this one still is */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, &args.chan, NULL, &txn, NULL);
+    args.fn                         = DoTickFnClearCont;
+    args.early_exit                 = false;
+    args.ticked                     = false;
+    args.cont                       = true;
+    CF_AppData.engine.cycle_usec    = 1;
+    CF_AppData.engine.cycle_expired = true;
+    UtAssert_INT32_EQ(CF_CFDP_DoTick(&txn->cl_node, &args), CF_CLIST_CONT);
+    UtAssert_BOOL_FALSE(args.cont);
+    UtAssert_BOOL_TRUE(args.ticked);
+
+    /* out of time after ticking one, this becomes the resume point for the next cycle */
+    args.cont = true;
+    UtAssert_INT32_EQ(CF_CFDP_DoTick(&txn->cl_node, &args), CF_CLIST_EXIT);
+    UtAssert_BOOL_TRUE(args.cont);
+    UtAssert_BOOL_TRUE(args.early_exit);
+    UtAssert_ADDRESS_EQ(args.chan->cur, txn);
 }
 
 void Test_CF_CFDP_ProcessPollingDirectories(void)
@@ -1161,11 +1765,13 @@ void Test_CF_CFDP_ProcessPollingDirectories(void)
     UtAssert_BOOL_TRUE(poll->timer_set);
     UtAssert_STUB_COUNT(CF_Timer_Tick, 2);
 
-    /* call again timer should expire and start a playback */
+    /* call again timer should expire and start a playback, in the order configured */
+    pdcfg->order = CF_PlaybackOrder_NEWEST;
     UT_SetDeferredRetcode(UT_KEY(CF_Timer_Expired), 1, true);
     UtAssert_VOIDCALL(CF_CFDP_ProcessPollingDirectories(chan));
     UtAssert_BOOL_FALSE(poll->timer_set);
     UtAssert_BOOL_TRUE(poll->pb.busy);
+    UtAssert_UINT32_EQ(poll->pb.order, CF_PlaybackOrder_NEWEST);
     UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL].poll_counter, 1);
 
     /* make an error occur in CF_CFDP_PlaybackDir_Initiate() */
@@ -1199,32 +1805,94 @@ void Test_CF_CFDP_ProcessPollingDirectories(void)
     UtAssert_UINT32_EQ(CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL].poll_counter, 0);
 }
 
-void Test_CF_CFDP_ProcessPlaybackDirectory(void)
+/* a directory of the given entries, which ends in an error and can be read again once rewound */
+typedef struct UT_CF_Dir
 {
-    /* Test case for:
-     * void CF_CFDP_ProcessPlaybackDirectory(CF_Channel_t *chan, CF_Playback_t *pb)
-     */
-    CF_Transaction_t *txn;
-    CF_History_t *    history;
+    const os_dirent_t *dirent;
+    uint32             count;
+    uint32             pos;
+} UT_CF_Dir_t;
+
+static void UT_AltHandler_OS_DirectoryRead(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    UT_CF_Dir_t *dir    = UserObj;
+    os_dirent_t *dirent = UT_Hook_GetArgValueByName(Context, "dirent", os_dirent_t *);
+    int32        status = OS_ERROR;
+
+    if (dir->pos < dir->count)
+    {
+        *dirent = dir->dirent[dir->pos];
+        ++dir->pos;
+        status = OS_SUCCESS;
+    }
+    UT_Stub_SetReturnValue(FuncKey, status);
+}
+
+static void UT_AltHandler_OS_DirectoryRewind(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    UT_CF_Dir_t *dir    = UserObj;
+    int32        status = OS_SUCCESS;
+
+    UT_Stub_GetInt32StatusCode(Context, &status);
+    if (status == OS_SUCCESS)
+    {
+        dir->pos = 0;
+    }
+    UT_Stub_SetReturnValue(FuncKey, status);
+}
+
+static void UT_CF_SetDir(UT_CF_Dir_t *dir, const os_dirent_t *dirent, uint32 count)
+{
+    dir->dirent = dirent;
+    dir->count  = count;
+    dir->pos    = 0;
+    UT_SetHandlerFunction(UT_KEY(OS_DirectoryRead), UT_AltHandler_OS_DirectoryRead, dir);
+    UT_SetHandlerFunction(UT_KEY(OS_DirectoryRewind), UT_AltHandler_OS_DirectoryRewind, dir);
+}
+
+void Test_CF_CFDP_ProcessPlaybackDirectory(void)
+{
+    /* Test case for:
+     * void CF_CFDP_ProcessPlaybackDirectory(CF_Channel_t *chan, CF_Playback_t *pb)
+     */
+    CF_Transaction_t *txn;
+    CF_History_t *    history;
     CF_Channel_t *    chan;
     CF_ConfigTable_t *config;
     CF_Playback_t     pb;
     os_dirent_t       dirent[3];
     CF_ChunkWrapper_t chunk_wrap;
+    UT_CF_Dir_t       dir;
 
     memset(&chunk_wrap, 0, sizeof(chunk_wrap));
     memset(&pb, 0, sizeof(pb));
     memset(dirent, 0, sizeof(dirent));
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, &chan, &history, &txn, &config);
     CF_AppData.engine.enabled = true;
+    pb.max_ts                 = CF_NUM_TRANSACTIONS_PER_PLAYBACK;
 
-    /* diropen is true but num_ts is high so operations are restricted */
+    /* none of the channel's transactions are in use */
+    CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL].q_size[CF_QueueIdx_FREE] = CF_NUM_TRANSACTIONS_PER_CHANNEL;
+
+    /* diropen is true but num_ts is high so operations are restricted, the directory is still read */
     pb.busy    = true;
     pb.num_ts  = CF_NUM_TRANSACTIONS_PER_PLAYBACK + 1;
     pb.diropen = true;
+    strcpy(dirent[0].FileName, "a");
+    strcpy(dirent[1].FileName, "b");
+    UT_CF_SetDir(&dir, dirent, 2);
     UtAssert_VOIDCALL(CF_CFDP_ProcessPlaybackDirectory(chan, &pb));
     UtAssert_BOOL_TRUE(pb.busy);
-    UtAssert_BOOL_TRUE(pb.diropen);
+    UtAssert_BOOL_FALSE(pb.diropen);
+    UtAssert_BOOL_TRUE(pb.ready);
+    UtAssert_UINT32_EQ(pb.work_count, 2);
+    UtAssert_ZERO(pb.work_next);
+    UtAssert_STUB_COUNT(OS_DirectoryRead, 3);
+    UtAssert_STUB_COUNT(CF_FindUnusedTransaction, 0);
+    UT_ResetState(UT_KEY(OS_DirectoryRead));
+    UT_ResetState(UT_KEY(OS_DirectoryClose));
+    pb.work_count = 0;
+    pb.ready      = false;
 
     /*
      * enter the loop, but error calling OS_DirectoryRead().
@@ -1247,24 +1915,527 @@ void Test_CF_CFDP_ProcessPlaybackDirectory(void)
      *  - this calls CF_FindUnusedTransaction() so that must return non-NULL.
      *  - this also calls CF_CFDP_FindUnusedChunks() and that pops an entry
      */
-    pb.busy    = true;
+    pb.busy     = true;
     pb.diropen = true;
+    pb.ready   = false;
     pb.num_ts  = 0;
+    pb.compress = CF_TxCompress_ON;
     strcpy(dirent[0].FileName, ".");  /* ignored */
     strcpy(dirent[1].FileName, ".."); /* ignored */
     strcpy(dirent[2].FileName, "ut"); /* valid file */
     OS_DirectoryOpen(&pb.dir_id, "ut");
-    UT_SetDataBuffer(UT_KEY(OS_DirectoryRead), dirent, sizeof(dirent), false);
-    UT_SetDeferredRetcode(UT_KEY(OS_DirectoryRead), 4, OS_ERROR); /* end of dir */
+    UT_CF_SetDir(&dir, dirent, 3);
     UT_SetHandlerFunction(UT_KEY(CF_FindUnusedTransaction), UT_AltHandler_GenericPointerReturn, txn);
     UT_SetHandlerFunction(UT_KEY(CF_CList_Pop), UT_AltHandler_GenericPointerReturn, &chunk_wrap.cl_node);
     chan->cs[CF_Direction_TX] = &chunk_wrap.cl_node;
     UtAssert_VOIDCALL(CF_CFDP_ProcessPlaybackDirectory(chan, &pb));
     UtAssert_BOOL_TRUE(pb.busy);
     UtAssert_BOOL_FALSE(pb.diropen);
+    UtAssert_STUB_COUNT(OS_DirectoryRewind, 0);
+    UtAssert_STUB_COUNT(OS_DirectoryClose, 2);
     UtAssert_STRINGBUF_EQ(history->fnames.src_filename, sizeof(history->fnames.src_filename), "/ut", -1);
     UtAssert_STRINGBUF_EQ(history->fnames.dst_filename, sizeof(history->fnames.dst_filename), "/ut", -1);
+    UtAssert_UINT32_EQ(txn->compress, CF_TxCompress_ON);
     UT_CF_AssertEventID(CF_CFDP_S_START_SEND_INF_EID);
+
+    /* out of time this cycle, the directory is left open for the next one */
+    UT_ResetState(UT_KEY(OS_DirectoryRead));
+    pb.busy                         = true;
+    pb.diropen                      = true;
+    pb.ready                        = false;
+    pb.num_ts                       = 0;
+    CF_AppData.engine.cycle_usec    = 1;
+    CF_AppData.engine.cycle_expired = true;
+    UtAssert_VOIDCALL(CF_CFDP_ProcessPlaybackDirectory(chan, &pb));
+    UtAssert_STUB_COUNT(OS_DirectoryRead, 0);
+    UtAssert_BOOL_TRUE(pb.busy);
+    UtAssert_BOOL_TRUE(pb.diropen);
+}
+
+void Test_CF_CFDP_ProcessPlaybackDirectory_WorkList(void)
+{
+    /* Test case for:
+     * void CF_CFDP_ProcessPlaybackDirectory(CF_Channel_t *chan, CF_Playback_t *pb)
+     * with the directory read over more than one wakeup, and in more than one list
+     */
+    static const char *names[] = {"m", "c", "x", "a", "k", "b"};
+    CF_Transaction_t * txn;
+    CF_Channel_t *     chan;
+    CF_ConfigTable_t * config;
+    CF_Playback_t      pb;
+    os_dirent_t        dirent[CF_PLAYBACK_ORDER_LIST_SIZE + 1];
+    CF_ChunkWrapper_t  chunk_wrap;
+    UT_CF_Dir_t        dir;
+    int                i;
+
+    memset(&chunk_wrap, 0, sizeof(chunk_wrap));
+    memset(&pb, 0, sizeof(pb));
+    memset(dirent, 0, sizeof(dirent));
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, &chan, NULL, &txn, &config);
+    CF_AppData.engine.enabled = true;
+    UT_SetHandlerFunction(UT_KEY(CF_FindUnusedTransaction), UT_AltHandler_GenericPointerReturn, txn);
+    UT_SetHandlerFunction(UT_KEY(CF_CList_Pop), UT_AltHandler_GenericPointerReturn, &chunk_wrap.cl_node);
+    chan->cs[CF_Direction_TX] = &chunk_wrap.cl_node;
+
+    /* none of the channel's transactions are in use */
+    CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL].q_size[CF_QueueIdx_FREE] = CF_NUM_TRANSACTIONS_PER_CHANNEL;
+
+    /* the reads for this wakeup run out before the list is full, so nothing is sent yet */
+    config->chan[UT_CFDP_CHANNEL].dir_reads_per_wakeup = 4;
+    for (i = 0; i < 6; ++i)
+    {
+        strcpy(dirent[i].FileName, names[i]);
+    }
+    pb.busy    = true;
+    pb.diropen = true;
+    pb.max_ts  = 2;
+    OS_DirectoryOpen(&pb.dir_id, "ut");
+    UT_CF_SetDir(&dir, dirent, 6);
+    UtAssert_VOIDCALL(CF_CFDP_ProcessPlaybackDirectory(chan, &pb));
+    UtAssert_STUB_COUNT(OS_DirectoryRead, 4);
+    UtAssert_UINT32_EQ(chan->dir_reads, 4);
+    UtAssert_UINT32_EQ(pb.work_count, 4);
+    UtAssert_STUB_COUNT(CF_FindUnusedTransaction, 0);
+
+    /* next wakeup finds the end, which is the last of the directory, and the first two by name go */
+    chan->dir_reads = 0;
+    UtAssert_VOIDCALL(CF_CFDP_ProcessPlaybackDirectory(chan, &pb));
+    UtAssert_BOOL_FALSE(pb.diropen);
+    UtAssert_BOOL_TRUE(pb.ready);
+    UtAssert_UINT32_EQ(pb.work_count, 6);
+    UtAssert_UINT32_EQ(pb.work_next, 2);
+    UtAssert_UINT32_EQ(pb.num_ts, 2);
+    UtAssert_STRINGBUF_EQ(pb.work[0].name, sizeof(pb.work[0].name), "a", -1);
+    UtAssert_STRINGBUF_EQ(pb.work[1].name, sizeof(pb.work[1].name), "b", -1);
+    UtAssert_STRINGBUF_EQ(pb.work[2].name, sizeof(pb.work[2].name), "c", -1);
+    UtAssert_STRINGBUF_EQ(pb.work[3].name, sizeof(pb.work[3].name), "k", -1);
+    UtAssert_STRINGBUF_EQ(pb.work[4].name, sizeof(pb.work[4].name), "m", -1);
+    UtAssert_STRINGBUF_EQ(pb.work[5].name, sizeof(pb.work[5].name), "x", -1);
+    UtAssert_STRINGBUF_EQ(txn->history->fnames.src_filename, sizeof(txn->history->fnames.src_filename), "/b", -1);
+
+    /* the rest go as transactions finish */
+    config->chan[UT_CFDP_CHANNEL].dir_reads_per_wakeup = 0;
+    pb.num_ts                                          = 0;
+    UtAssert_VOIDCALL(CF_CFDP_ProcessPlaybackDirectory(chan, &pb));
+    UtAssert_UINT32_EQ(pb.work_next, 4);
+    UtAssert_BOOL_TRUE(pb.busy);
+    pb.num_ts = 0;
+    UtAssert_VOIDCALL(CF_CFDP_ProcessPlaybackDirectory(chan, &pb));
+    UtAssert_STRINGBUF_EQ(txn->history->fnames.src_filename, sizeof(txn->history->fnames.src_filename), "/x", -1);
+    UtAssert_STUB_COUNT(OS_DirectoryRead, 7);
+    UtAssert_BOOL_TRUE(pb.busy);
+    pb.num_ts = 0;
+    UtAssert_VOIDCALL(CF_CFDP_ProcessPlaybackDirectory(chan, &pb));
+    UtAssert_BOOL_FALSE(pb.busy);
+    UtAssert_STUB_COUNT(CF_FindUnusedTransaction, 6);
+
+    /* in name order a full list is sent as soon as it is read, and the directory is read on from there */
+    UT_ResetState(UT_KEY(OS_DirectoryRead));
+    UT_ResetState(UT_KEY(CF_FindUnusedTransaction));
+    UT_SetHandlerFunction(UT_KEY(CF_FindUnusedTransaction), UT_AltHandler_GenericPointerReturn, txn);
+    for (i = 0; i <= CF_PLAYBACK_WORK_LIST_SIZE; ++i)
+    {
+        snprintf(dirent[i].FileName, sizeof(dirent[i].FileName), "f%02d", CF_PLAYBACK_WORK_LIST_SIZE - i);
+    }
+    memset(&pb, 0, sizeof(pb));
+    pb.busy    = true;
+    pb.diropen = true;
+    pb.max_ts  = CF_PLAYBACK_WORK_LIST_SIZE;
+    UT_CF_SetDir(&dir, dirent, CF_PLAYBACK_WORK_LIST_SIZE + 1);
+    UtAssert_VOIDCALL(CF_CFDP_ProcessPlaybackDirectory(chan, &pb));
+    UtAssert_STUB_COUNT(OS_DirectoryRead, CF_PLAYBACK_WORK_LIST_SIZE + 2);
+    UtAssert_STUB_COUNT(CF_FindUnusedTransaction, CF_PLAYBACK_WORK_LIST_SIZE);
+    UtAssert_STRINGBUF_EQ(txn->history->fnames.src_filename, sizeof(txn->history->fnames.src_filename), "/f16", -1);
+    UtAssert_BOOL_FALSE(pb.diropen);
+    UtAssert_UINT32_EQ(pb.work_count, 1);
+    UtAssert_STRINGBUF_EQ(pb.work[0].name, sizeof(pb.work[0].name), "f00", -1);
+    pb.num_ts = 0;
+    UtAssert_VOIDCALL(CF_CFDP_ProcessPlaybackDirectory(chan, &pb));
+    UtAssert_STUB_COUNT(OS_DirectoryRead, CF_PLAYBACK_WORK_LIST_SIZE + 2);
+    UtAssert_STUB_COUNT(CF_FindUnusedTransaction, CF_PLAYBACK_WORK_LIST_SIZE + 1);
+    UtAssert_STRINGBUF_EQ(txn->history->fnames.src_filename, sizeof(txn->history->fnames.src_filename), "/f00", -1);
+    UtAssert_STUB_COUNT(OS_DirectoryRewind, 0);
+
+    /* in size order a full list keeps the first of the whole directory, and the rest go after the next pass.
+     * No file can be stat'd, so they all sort by name. */
+    UT_ResetState(UT_KEY(OS_DirectoryRead));
+    UT_ResetState(UT_KEY(CF_FindUnusedTransaction));
+    UT_SetHandlerFunction(UT_KEY(CF_FindUnusedTransaction), UT_AltHandler_GenericPointerReturn, txn);
+    UT_SetDefaultReturnValue(UT_KEY(CF_WrappedStat), OS_ERROR);
+    for (i = 0; i <= CF_PLAYBACK_ORDER_LIST_SIZE; ++i)
+    {
+        snprintf(dirent[i].FileName, sizeof(dirent[i].FileName), "f%03d", CF_PLAYBACK_ORDER_LIST_SIZE - i);
+    }
+    memset(&pb, 0, sizeof(pb));
+    pb.busy    = true;
+    pb.diropen = true;
+    pb.order   = CF_PlaybackOrder_SMALLEST;
+    pb.max_ts  = CF_PLAYBACK_ORDER_LIST_SIZE;
+    UT_CF_SetDir(&dir, dirent, CF_PLAYBACK_ORDER_LIST_SIZE + 1);
+    UtAssert_VOIDCALL(CF_CFDP_ProcessPlaybackDirectory(chan, &pb));
+    UtAssert_STUB_COUNT(OS_DirectoryRead, 2 * (CF_PLAYBACK_ORDER_LIST_SIZE + 2));
+    UtAssert_STUB_COUNT(OS_DirectoryRewind, 1);
+    UtAssert_STUB_COUNT(CF_WrappedStat, 2 * (CF_PLAYBACK_ORDER_LIST_SIZE + 1));
+    UtAssert_STUB_COUNT(CF_FindUnusedTransaction, CF_PLAYBACK_ORDER_LIST_SIZE);
+    UtAssert_STRINGBUF_EQ(txn->history->fnames.src_filename, sizeof(txn->history->fnames.src_filename), "/f063",
+                          -1);
+    UtAssert_BOOL_FALSE(pb.diropen);
+    UtAssert_UINT32_EQ(pb.work_count, 1);
+    UtAssert_STRINGBUF_EQ(pb.work[0].name, sizeof(pb.work[0].name), "f064", -1);
+    pb.num_ts = 0;
+    UtAssert_VOIDCALL(CF_CFDP_ProcessPlaybackDirectory(chan, &pb));
+    UtAssert_STUB_COUNT(OS_DirectoryRead, 2 * (CF_PLAYBACK_ORDER_LIST_SIZE + 2));
+    UtAssert_STUB_COUNT(OS_DirectoryRewind, 1);
+    UtAssert_STUB_COUNT(CF_FindUnusedTransaction, CF_PLAYBACK_ORDER_LIST_SIZE + 1);
+    UtAssert_STRINGBUF_EQ(txn->history->fnames.src_filename, sizeof(txn->history->fnames.src_filename), "/f064",
+                          -1);
+
+    /* the directory cannot be read again, so the playback ends there */
+    UT_ResetState(UT_KEY(OS_DirectoryClose));
+    memset(&pb, 0, sizeof(pb));
+    pb.busy    = true;
+    pb.diropen = true;
+    pb.order   = CF_PlaybackOrder_SMALLEST;
+    pb.max_ts  = CF_PLAYBACK_ORDER_LIST_SIZE;
+    UT_CF_SetDir(&dir, dirent, CF_PLAYBACK_ORDER_LIST_SIZE + 1);
+    UT_SetDeferredRetcode(UT_KEY(OS_DirectoryRewind), 1, OS_ERROR);
+    UtAssert_VOIDCALL(CF_CFDP_ProcessPlaybackDirectory(chan, &pb));
+    UtAssert_STUB_COUNT(OS_DirectoryClose, 1);
+    UtAssert_BOOL_FALSE(pb.diropen);
+    UtAssert_ZERO(pb.work_count);
+}
+
+void Test_CF_CFDP_ProcessPlaybackDirectory_Borrow(void)
+{
+    /* Test case for:
+     * void CF_CFDP_ProcessPlaybackDirectory(CF_Channel_t *chan, CF_Playback_t *pb)
+     * drawing on the channel's free transactions
+     */
+    CF_Transaction_t *   txn;
+    CF_Channel_t *       chan;
+    CF_Playback_t *      pb;
+    CF_HkChannel_Data_t *hk;
+    os_dirent_t          dirent[CF_NUM_TRANSACTIONS_PER_PLAYBACK + 3];
+    CF_ChunkWrapper_t    chunk_wrap;
+    UT_CF_Dir_t          dir;
+    int                  i;
+
+    memset(&chunk_wrap, 0, sizeof(chunk_wrap));
+    memset(dirent, 0, sizeof(dirent));
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, &chan, NULL, &txn, NULL);
+    CF_AppData.engine.enabled = true;
+    UT_SetHandlerFunction(UT_KEY(CF_FindUnusedTransaction), UT_AltHandler_GenericPointerReturn, txn);
+    UT_SetHandlerFunction(UT_KEY(CF_CList_Pop), UT_AltHandler_GenericPointerReturn, &chunk_wrap.cl_node);
+    chan->cs[CF_Direction_TX] = &chunk_wrap.cl_node;
+    hk                        = &CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL];
+    for (i = 0; i < (CF_NUM_TRANSACTIONS_PER_PLAYBACK + 3); ++i)
+    {
+        snprintf(dirent[i].FileName, sizeof(dirent[i].FileName), "f%02d", i);
+    }
+
+    /* the only free transactions are those receives and commanded sends have yet to use */
+    pb                           = &chan->playback[0];
+    pb->busy                     = true;
+    pb->diropen                  = true;
+    pb->max_ts                   = CF_NUM_TRANSACTIONS_PER_PLAYBACK + 2;
+    hk->q_size[CF_QueueIdx_FREE] = CF_MAX_SIMULTANEOUS_RX + CF_MAX_COMMANDED_PLAYBACK_FILES_PER_CHAN;
+    OS_DirectoryOpen(&pb->dir_id, "ut");
+    UT_CF_SetDir(&dir, dirent, CF_NUM_TRANSACTIONS_PER_PLAYBACK + 3);
+    UtAssert_VOIDCALL(CF_CFDP_ProcessPlaybackDirectory(chan, pb));
+    UtAssert_BOOL_TRUE(pb->ready);
+    UtAssert_UINT32_EQ(pb->work_count, CF_NUM_TRANSACTIONS_PER_PLAYBACK + 3);
+    UtAssert_ZERO(pb->num_ts);
+    UtAssert_STUB_COUNT(CF_FindUnusedTransaction, 0);
+
+    /* once those are all in use, one more free is enough for more than CF_NUM_TRANSACTIONS_PER_PLAYBACK */
+    hk->q_size[CF_QueueIdx_FREE] = 1;
+    hk->q_size[CF_QueueIdx_RX]   = CF_MAX_SIMULTANEOUS_RX;
+    chan->num_cmd_tx             = CF_MAX_COMMANDED_PLAYBACK_FILES_PER_CHAN;
+    UtAssert_VOIDCALL(CF_CFDP_ProcessPlaybackDirectory(chan, pb));
+    UtAssert_UINT32_EQ(pb->num_ts, CF_NUM_TRANSACTIONS_PER_PLAYBACK + 2);
+    UtAssert_STUB_COUNT(CF_FindUnusedTransaction, CF_NUM_TRANSACTIONS_PER_PLAYBACK + 2);
+
+    /* max_ts is reached, however many are free */
+    hk->q_size[CF_QueueIdx_FREE] = CF_NUM_TRANSACTIONS_PER_CHANNEL;
+    UtAssert_VOIDCALL(CF_CFDP_ProcessPlaybackDirectory(chan, pb));
+    UtAssert_UINT32_EQ(pb->num_ts, CF_NUM_TRANSACTIONS_PER_PLAYBACK + 2);
+    UtAssert_UINT32_EQ(pb->work_next, CF_NUM_TRANSACTIONS_PER_PLAYBACK + 2);
+
+    /* and the last file goes when one of its own finishes */
+    --pb->num_ts;
+    UtAssert_VOIDCALL(CF_CFDP_ProcessPlaybackDirectory(chan, pb));
+    UtAssert_STUB_COUNT(CF_FindUnusedTransaction, CF_NUM_TRANSACTIONS_PER_PLAYBACK + 3);
+    UtAssert_BOOL_FALSE(pb->diropen);
+}
+
+/* the bundle stubs keep just enough of the work area for the playback to act on */
+static void UT_AltHandler_CF_Bundle_Start(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CF_Bundle_t *  bundle      = UT_Hook_GetArgValueByName(Context, "bundle", CF_Bundle_t *);
+    CF_Playback_t *owner       = UT_Hook_GetArgValueByName(Context, "owner", CF_Playback_t *);
+    int32          status_code = CFE_SUCCESS;
+
+    UT_Stub_GetInt32StatusCode(Context, &status_code);
+    if (status_code == CFE_SUCCESS)
+    {
+        bundle->owner = owner;
+        bundle->count = 0;
+        bundle->size  = 0;
+    }
+    UT_Stub_SetReturnValue(FuncKey, status_code);
+}
+
+static void UT_AltHandler_CF_Bundle_AddFile(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CF_Bundle_t *bundle      = UT_Hook_GetArgValueByName(Context, "bundle", CF_Bundle_t *);
+    const char * name        = UT_Hook_GetArgValueByName(Context, "name", const char *);
+    uint32       size        = UT_Hook_GetArgValueByName(Context, "size", uint32);
+    int32        status_code = CFE_SUCCESS;
+
+    UT_Stub_GetInt32StatusCode(Context, &status_code);
+    if (status_code == CFE_SUCCESS)
+    {
+        strncpy(bundle->entries[bundle->count].name, name, sizeof(bundle->entries[0].name) - 1);
+        bundle->size += size;
+        ++bundle->count;
+    }
+    UT_Stub_SetReturnValue(FuncKey, status_code);
+}
+
+static void UT_AltHandler_CF_Bundle_Release(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CF_Bundle_t *bundle = UT_Hook_GetArgValueByName(Context, "bundle", CF_Bundle_t *);
+
+    bundle->owner = NULL;
+    bundle->count = 0;
+    bundle->size  = 0;
+}
+
+/* the size of each file stat'd, in turn */
+static uint32 UT_CF_StatCount;
+
+static void UT_AltHandler_CF_WrappedStat_Size(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    const uint32 *sizes     = UserObj;
+    os_fstat_t *  filestats = UT_Hook_GetArgValueByName(Context, "filestats", os_fstat_t *);
+    int32         status    = OS_SUCCESS;
+
+    memset(filestats, 0, sizeof(*filestats));
+    filestats->FileSize = sizes[UT_CF_StatCount++];
+    UT_Stub_SetReturnValue(FuncKey, status);
+}
+
+void Test_CF_CFDP_ProcessPlaybackDirectory_Bundle(void)
+{
+    /* Test case for:
+     * void CF_CFDP_ProcessPlaybackDirectory(CF_Channel_t *chan, CF_Playback_t *pb)
+     * with small files sent in bundles
+     */
+    static const uint32 sizes[] = {10, 10, 10, 200, 10, 10, 10, 10, 10, 10};
+    CF_Transaction_t *  txn;
+    CF_History_t *      history;
+    CF_Channel_t *      chan;
+    CF_ConfigTable_t *  config;
+    CF_Playback_t       pb;
+    CF_Playback_t       other;
+    os_dirent_t         dirent[3];
+    CF_ChunkWrapper_t   chunk_wrap;
+    UT_CF_Dir_t         dir;
+    CF_Bundle_t *       bundle = &CF_AppData.engine.bundle;
+
+    memset(&chunk_wrap, 0, sizeof(chunk_wrap));
+    memset(&pb, 0, sizeof(pb));
+    memset(dirent, 0, sizeof(dirent));
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, &chan, &history, &txn, &config);
+    CF_AppData.engine.enabled                      = true;
+    pb.max_ts                                      = CF_NUM_TRANSACTIONS_PER_PLAYBACK;
+    config->chan[UT_CFDP_CHANNEL].bundle_file_size = 100;
+    config->chan[UT_CFDP_CHANNEL].bundle_max_size  = 25;
+
+    /* none of the channel's transactions are in use */
+    CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL].q_size[CF_QueueIdx_FREE] = CF_NUM_TRANSACTIONS_PER_CHANNEL;
+
+    UT_SetHandlerFunction(UT_KEY(CF_Bundle_Start), UT_AltHandler_CF_Bundle_Start, NULL);
+    UT_SetHandlerFunction(UT_KEY(CF_Bundle_AddFile), UT_AltHandler_CF_Bundle_AddFile, NULL);
+    UT_SetHandlerFunction(UT_KEY(CF_Bundle_Release), UT_AltHandler_CF_Bundle_Release, NULL);
+    UT_CF_StatCount = 0;
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedStat), UT_AltHandler_CF_WrappedStat_Size, (void *)sizes);
+    UT_SetHandlerFunction(UT_KEY(CF_FindUnusedTransaction), UT_AltHandler_GenericPointerReturn, txn);
+    UT_SetHandlerFunction(UT_KEY(CF_CList_Pop), UT_AltHandler_GenericPointerReturn, &chunk_wrap.cl_node);
+    chan->cs[CF_Direction_TX] = &chunk_wrap.cl_node;
+
+    /* two small files go in one bundle, sent once the directory is done */
+    pb.busy    = true;
+    pb.diropen = true;
+    strcpy(dirent[0].FileName, "a");
+    strcpy(dirent[1].FileName, "b");
+    OS_DirectoryOpen(&pb.dir_id, "ut");
+    UT_CF_SetDir(&dir, dirent, 2);
+    UtAssert_VOIDCALL(CF_CFDP_ProcessPlaybackDirectory(chan, &pb));
+    UtAssert_STUB_COUNT(CF_Bundle_AddFile, 2);
+    UtAssert_STUB_COUNT(CF_Bundle_Finish, 1);
+    UtAssert_STUB_COUNT(CF_WrappedRename, 1);
+    UtAssert_BOOL_TRUE(txn->flags.com.bundle);
+    UtAssert_UINT32_EQ(txn->keep, 1);
+    UtAssert_UINT32_EQ(pb.num_ts, 1);
+    UtAssert_NULL(bundle->owner);
+    UtAssert_BOOL_TRUE(pb.busy);
+
+    /* a lone small file is sent as it is, and one too big to bundle is sent alone */
+    UT_ResetState(UT_KEY(OS_DirectoryRead));
+    txn->flags.com.bundle = false;
+    pb.diropen            = true;
+    pb.ready              = false;
+    pb.num_ts             = 0;
+    strcpy(dirent[0].FileName, "c");
+    strcpy(dirent[1].FileName, "d");
+    UT_CF_SetDir(&dir, dirent, 2);
+    UtAssert_VOIDCALL(CF_CFDP_ProcessPlaybackDirectory(chan, &pb));
+    UtAssert_STUB_COUNT(CF_Bundle_AddFile, 3);
+    UtAssert_STUB_COUNT(CF_Bundle_Finish, 1);
+    UtAssert_BOOL_FALSE(txn->flags.com.bundle);
+    UtAssert_STRINGBUF_EQ(history->fnames.src_filename, sizeof(history->fnames.src_filename), "/c", -1);
+    UtAssert_UINT32_EQ(pb.num_ts, 2);
+
+    /* a file that does not fit sends the bundle first, and starts the next */
+    UT_ResetState(UT_KEY(OS_DirectoryRead));
+    pb.diropen = true;
+    pb.ready   = false;
+    pb.num_ts  = 0;
+    strcpy(dirent[0].FileName, "e");
+    strcpy(dirent[1].FileName, "f");
+    strcpy(dirent[2].FileName, "g");
+    UT_CF_SetDir(&dir, dirent, 3);
+    UtAssert_VOIDCALL(CF_CFDP_ProcessPlaybackDirectory(chan, &pb));
+    UtAssert_STUB_COUNT(CF_Bundle_AddFile, 6);
+    UtAssert_STUB_COUNT(CF_Bundle_Start, 4);
+    UtAssert_STUB_COUNT(CF_Bundle_Finish, 2);
+    UtAssert_UINT32_EQ(pb.num_ts, 2);
+
+    /* a file that could not be added is left for another pass */
+    UT_ResetState(UT_KEY(OS_DirectoryRead));
+    pb.diropen = true;
+    pb.ready   = false;
+    pb.num_ts  = 0;
+    UT_CF_SetDir(&dir, dirent, 1);
+    UT_SetDeferredRetcode(UT_KEY(CF_Bundle_AddFile), 1, CF_ERROR);
+    UT_CF_ResetEventCapture();
+    UtAssert_VOIDCALL(CF_CFDP_ProcessPlaybackDirectory(chan, &pb));
+    UT_CF_AssertEventID(CF_CFDP_BUNDLE_ERR_EID);
+    UtAssert_UINT32_EQ(pb.num_ts, 0);
+    UtAssert_NULL(bundle->owner);
+    UtAssert_BOOL_FALSE(pb.busy);
+
+    /* a bundle that could not be built leaves its files */
+    UT_ResetState(UT_KEY(OS_DirectoryRead));
+    pb.busy    = true;
+    pb.diropen = true;
+    pb.ready   = false;
+    UT_CF_SetDir(&dir, dirent, 2);
+    UT_SetDeferredRetcode(UT_KEY(CF_Bundle_Finish), 1, CF_ERROR);
+    UtAssert_VOIDCALL(CF_CFDP_ProcessPlaybackDirectory(chan, &pb));
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 1);
+    UtAssert_UINT32_EQ(pb.num_ts, 0);
+    UtAssert_NULL(bundle->owner);
+
+    /* while another playback builds a bundle, files are sent alone */
+    UT_ResetState(UT_KEY(OS_DirectoryRead));
+    UT_ResetState(UT_KEY(CF_WrappedStat));
+    bundle->owner = &other;
+    pb.busy       = true;
+    pb.diropen    = true;
+    pb.ready      = false;
+    UT_CF_SetDir(&dir, dirent, 1);
+    UtAssert_VOIDCALL(CF_CFDP_ProcessPlaybackDirectory(chan, &pb));
+    UtAssert_STUB_COUNT(CF_WrappedStat, 0);
+    UtAssert_UINT32_EQ(pb.num_ts, 1);
+    UtAssert_ADDRESS_EQ(bundle->owner, &other);
+}
+
+/* the time and size of each file stat'd, in turn */
+static void UT_AltHandler_CF_WrappedStat_Entry(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    const os_fstat_t *stats     = UserObj;
+    os_fstat_t *      filestats = UT_Hook_GetArgValueByName(Context, "filestats", os_fstat_t *);
+    int32             status    = OS_SUCCESS;
+
+    UT_Stub_GetInt32StatusCode(Context, &status);
+    if (status == OS_SUCCESS)
+    {
+        *filestats = stats[UT_CF_StatCount];
+    }
+    ++UT_CF_StatCount;
+    UT_Stub_SetReturnValue(FuncKey, status);
+}
+
+void Test_CF_CFDP_ProcessPlaybackDirectory_Order(void)
+{
+    /* Test case for:
+     * void CF_CFDP_ProcessPlaybackDirectory(CF_Channel_t *chan, CF_Playback_t *pb)
+     * with the work list sorted by time or size
+     */
+    static const char *names[] = {"b", "a", "c", "d"};
+    static const struct
+    {
+        uint8       order;
+        const char *sent;
+        uint32      stats;
+    } cases[] = {
+        {CF_PlaybackOrder_NAME, "abcd", 0},
+        {CF_PlaybackOrder_OLDEST, "dacb", 4},
+        {CF_PlaybackOrder_NEWEST, "bcad", 4},
+        {CF_PlaybackOrder_SMALLEST, "dbca", 4},
+        {CF_PlaybackOrder_NUM, "abcd", 0}, /* not an order, so by name */
+    };
+    CF_Channel_t *    chan;
+    CF_ConfigTable_t *config;
+    CF_Playback_t     pb;
+    os_dirent_t       dirent[4];
+    os_fstat_t        stats[4];
+    uint32            i;
+    int               j;
+
+    memset(dirent, 0, sizeof(dirent));
+    memset(stats, 0, sizeof(stats));
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, &chan, NULL, NULL, &config);
+    config->chan[UT_CFDP_CHANNEL].dir_reads_per_wakeup = 0;
+
+    /* "d" cannot be stat'd, so it is the oldest and smallest; "b" and "c" are the same size */
+    for (i = 0; i < 4; ++i)
+    {
+        strcpy(dirent[i].FileName, names[i]);
+    }
+    stats[0].FileTime = OS_TimeAssembleFromMilliseconds(30, 0);
+    stats[0].FileSize = 5;
+    stats[1].FileTime = OS_TimeAssembleFromMilliseconds(10, 0);
+    stats[1].FileSize = 20;
+    stats[2].FileTime = OS_TimeAssembleFromMilliseconds(20, 0);
+    stats[2].FileSize = 5;
+
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i)
+    {
+        UT_ResetState(UT_KEY(OS_DirectoryRead));
+        UT_ResetState(UT_KEY(CF_WrappedStat));
+        UT_CF_StatCount = 0;
+        UT_SetHandlerFunction(UT_KEY(CF_WrappedStat), UT_AltHandler_CF_WrappedStat_Entry, stats);
+        UT_SetDeferredRetcode(UT_KEY(CF_WrappedStat), 4, OS_ERROR);
+        UT_SetDataBuffer(UT_KEY(OS_DirectoryRead), dirent, sizeof(dirent), false);
+        UT_SetDeferredRetcode(UT_KEY(OS_DirectoryRead), 5, OS_ERROR);
+
+        /* nothing is sent, so the whole list is left to look at */
+        memset(&pb, 0, sizeof(pb));
+        pb.busy    = true;
+        pb.diropen = true;
+        pb.order   = cases[i].order;
+        OS_DirectoryOpen(&pb.dir_id, "ut");
+        UtAssert_VOIDCALL(CF_CFDP_ProcessPlaybackDirectory(chan, &pb));
+        UtAssert_STUB_COUNT(CF_WrappedStat, cases[i].stats);
+        UtAssert_UINT32_EQ(pb.work_count, 4);
+        for (j = 0; j < 4; ++j)
+        {
+            UtAssert_INT32_EQ(pb.work[j].name[0], cases[i].sent[j]);
+        }
+    }
 }
 
 static int32 Ut_Hook_TickTransactions_SetEarlyExit(void *UserObj, int32 StubRetcode, uint32 CallCount,
@@ -1295,6 +2466,16 @@ static int32 Ut_Hook_TickTransactions_SetCont(void *UserObj, int32 StubRetcode,
     return StubRetcode;
 }
 
+static int32 Ut_Hook_TickTransactions_AlwaysEarlyExit(void *UserObj, int32 StubRetcode, uint32 CallCount,
+                                                      const UT_StubContext_t *Context)
+{
+    CF_CFDP_Tick_args_t *args = UT_Hook_GetArgValueByName(Context, "context", CF_CFDP_Tick_args_t *);
+
+    args->early_exit = true;
+
+    return StubRetcode;
+}
+
 void Test_CF_CFDP_TickTransactions(void)
 {
     /* Test case for:
@@ -1325,6 +2506,119 @@ void Test_CF_CFDP_TickTransactions(void)
     UT_SetHookFunction(UT_KEY(CF_CList_Traverse), Ut_Hook_TickTransactions_SetCont, NULL);
     UtAssert_VOIDCALL(CF_CFDP_TickTransactions(chan));
     UtAssert_UINT32_EQ(chan->tick_type, CF_TickType_RX);
+
+    /* a resume point that is not on the queue anymore is dropped */
+    UT_ResetState(UT_KEY(CF_CList_Traverse));
+    chan->cur = &CF_AppData.engine.transactions[0];
+    UtAssert_VOIDCALL(CF_CFDP_TickTransactions(chan));
+    UtAssert_NULL(chan->cur);
+
+    /* out of messages during NAK response, start over with RX next time */
+    UT_SetHookFunction(UT_KEY(CF_CList_Traverse), Ut_Hook_TickTransactions_AlwaysEarlyExit, NULL);
+    chan->tick_type = CF_TickType_TXW_NAK;
+    UtAssert_VOIDCALL(CF_CFDP_TickTransactions(chan));
+    UtAssert_UINT32_EQ(chan->tick_type, CF_TickType_RX);
+
+    /* out of time during NAK response, resume it next time */
+    chan->tick_type                 = CF_TickType_TXW_NAK;
+    CF_AppData.engine.cycle_usec    = 1;
+    CF_AppData.engine.cycle_expired = true;
+    UtAssert_VOIDCALL(CF_CFDP_TickTransactions(chan));
+    UtAssert_UINT32_EQ(chan->tick_type, CF_TickType_TXW_NAK);
+}
+
+static void UT_AltHandler_ReceiveMessage_CountPdu(void *UserObj, UT_EntryKey_t FuncKey,
+                                                  const UT_StubContext_t *Context)
+{
+    CF_Channel_t *chan = UT_Hook_GetArgValueByName(Context, "chan", CF_Channel_t *);
+
+    ++CF_AppData.hk.Payload.channel_hk[chan - CF_AppData.engine.channels].counters.recv.pdu;
+}
+
+static int32 Ut_Hook_RespondTransactions_SetEarlyExit(void *UserObj, int32 StubRetcode, uint32 CallCount,
+                                                      const UT_StubContext_t *Context)
+{
+    CF_CFDP_Tick_args_t *args = UT_Hook_GetArgValueByName(Context, "context", CF_CFDP_Tick_args_t *);
+
+    args->early_exit = true;
+    args->chan->cur  = UserObj;
+
+    return StubRetcode;
+}
+
+void Test_CF_CFDP_RespondTransactions(void)
+{
+    /* Test case for:
+        void CF_CFDP_RespondTransactions(CF_Channel_t *chan);
+     */
+    CF_Channel_t *    chan;
+    CF_Transaction_t *txn;
+
+    /* nominal, nothing to resume */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, &chan, NULL, &txn, NULL);
+    UtAssert_VOIDCALL(CF_CFDP_RespondTransactions(chan));
+    UtAssert_STUB_COUNT(CF_CList_Traverse, 2);
+    UtAssert_NULL(chan->cur);
+
+    /* tick resume point is kept */
+    txn->flags.com.q_index = CF_QueueIdx_RX;
+    chan->cur              = txn;
+    UtAssert_VOIDCALL(CF_CFDP_RespondTransactions(chan));
+    UtAssert_STUB_COUNT(CF_CList_Traverse, 4);
+    UtAssert_ADDRESS_EQ(chan->cur, txn);
+
+    /* out of messages during RX, TXW is not done, resume point still kept */
+    UT_SetHookFunction(UT_KEY(CF_CList_Traverse), Ut_Hook_RespondTransactions_SetEarlyExit, NULL);
+    UtAssert_VOIDCALL(CF_CFDP_RespondTransactions(chan));
+    UtAssert_STUB_COUNT(CF_CList_Traverse, 5);
+    UtAssert_ADDRESS_EQ(chan->cur, txn);
+
+    /* resume point finished meanwhile */
+    UT_ResetState(UT_KEY(CF_CList_Traverse));
+    txn->flags.com.q_index = CF_QueueIdx_FREE;
+    UtAssert_VOIDCALL(CF_CFDP_RespondTransactions(chan));
+    UtAssert_NULL(chan->cur);
+}
+
+void Test_CF_CFDP_ServiceInput(void)
+{
+    /* Test case for:
+     * bool CF_CFDP_ServiceInput(void)
+     */
+    CF_ConfigTable_t *config;
+    CF_Channel_t *    chan;
+
+    /* engine disabled */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, &chan, NULL, NULL, &config);
+    config->chan[UT_CFDP_CHANNEL].rx_event_driven = 1;
+    UtAssert_BOOL_FALSE(CF_CFDP_ServiceInput());
+    UtAssert_STUB_COUNT(CF_CFDP_ReceiveMessage, 0);
+
+    /* no channel is event-driven */
+    CF_AppData.engine.enabled                     = true;
+    config->chan[UT_CFDP_CHANNEL].rx_event_driven = 0;
+    UtAssert_BOOL_FALSE(CF_CFDP_ServiceInput());
+    UtAssert_STUB_COUNT(CF_CFDP_ReceiveMessage, 0);
+
+    /* nothing received, so nothing to answer; what the last wakeup sent still counts */
+    config->chan[UT_CFDP_CHANNEL].rx_event_driven = 1;
+    chan->outgoing_counter                        = 3;
+    UtAssert_BOOL_TRUE(CF_CFDP_ServiceInput());
+    UtAssert_STUB_COUNT(CF_CFDP_ReceiveMessage, 1);
+    UtAssert_STUB_COUNT(CF_CList_Traverse, 0);
+    UtAssert_UINT32_EQ(chan->outgoing_counter, 3);
+
+    /* a PDU was received, the responses go out */
+    UT_SetHandlerFunction(UT_KEY(CF_CFDP_ReceiveMessage), UT_AltHandler_ReceiveMessage_CountPdu, NULL);
+    UtAssert_BOOL_TRUE(CF_CFDP_ServiceInput());
+    UtAssert_STUB_COUNT(CF_CFDP_ReceiveMessage, 2);
+    UtAssert_STUB_COUNT(CF_CList_Traverse, 2);
+
+    /* ... but not while frozen */
+    CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL].frozen = 1;
+    UtAssert_BOOL_TRUE(CF_CFDP_ServiceInput());
+    UtAssert_STUB_COUNT(CF_CFDP_ReceiveMessage, 3);
+    UtAssert_STUB_COUNT(CF_CList_Traverse, 2);
 }
 
 void Test_CF_CFDP_CycleEngine(void)
@@ -1337,14 +2631,119 @@ void Test_CF_CFDP_CycleEngine(void)
     /* nominal with engine disabled, noop */
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, &chan, NULL, NULL, NULL);
     UtAssert_VOIDCALL(CF_CFDP_CycleEngine());
+    UtAssert_STUB_COUNT(CF_Flow_Cycle, 0);
+    UtAssert_STUB_COUNT(CF_Ckpt_Cycle, 0);
 
-    /* enabled but frozen */
+    /* enabled but frozen, a new wakeup period still starts */
     CF_AppData.engine.enabled                                = true;
     CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL].frozen = 1;
+    chan->outgoing_counter                                   = 3;
     UtAssert_VOIDCALL(CF_CFDP_CycleEngine());
+    UtAssert_STUB_COUNT(CF_Flow_Cycle, 1);
+    UtAssert_STUB_COUNT(CF_Ckpt_Cycle, 1);
+    UtAssert_ZERO(chan->outgoing_counter);
+    UtAssert_UINT32_EQ(CF_AppData.engine.cycle_num, 1);
+
+    /* every channel is timed, even when frozen */
+    UtAssert_STUB_COUNT(CF_Instr_SetChannel, CF_NUM_CHANNELS);
+    UtAssert_STUB_COUNT(CF_Instr_Record, CF_NUM_CHANNELS);
 
     CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL].frozen = 0;
     UtAssert_VOIDCALL(CF_CFDP_CycleEngine());
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.cycle.count, 2);
+    UtAssert_ZERO(CF_AppData.hk.Payload.cycle.overruns);
+    UtAssert_STUB_COUNT(CF_CFDP_ReceiveMessage, 2 * CF_NUM_CHANNELS);
+    UtAssert_NONZERO(UT_GetStubCount(UT_KEY(CF_CList_Traverse)));
+
+    /* a budget that is not used up changes nothing */
+    UT_ResetState(UT_KEY(CF_CList_Traverse));
+    CF_AppData.config_table->cycle_max_usec = UINT32_MAX;
+    UtAssert_VOIDCALL(CF_CFDP_CycleEngine());
+    UtAssert_NONZERO(UT_GetStubCount(UT_KEY(CF_CList_Traverse)));
+    UtAssert_ZERO(CF_AppData.hk.Payload.cycle.overruns);
+    UtAssert_ZERO(CF_AppData.engine.cycle_chan);
+
+    /* budget used up: every channel still receives, but nothing else is done */
+    UT_ResetState(UT_KEY(CF_CList_Traverse));
+    CF_AppData.config_table->cycle_max_usec = 1;
+    CF_AppData.engine.cycle_chan            = CF_NUM_CHANNELS - 1;
+    UtAssert_VOIDCALL(CF_CFDP_CycleEngine());
+    UtAssert_STUB_COUNT(CF_CFDP_ReceiveMessage, 4 * CF_NUM_CHANNELS);
+    UtAssert_STUB_COUNT(CF_CList_Traverse, 0);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.cycle.count, 4);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.cycle.overruns, 1);
+
+    /* the channel that was cut short goes first next cycle, and nothing is budgeted between cycles */
+    UtAssert_UINT32_EQ(CF_AppData.engine.cycle_chan, CF_NUM_CHANNELS - 1);
+    UtAssert_ZERO(CF_AppData.engine.cycle_usec);
+    UtAssert_BOOL_FALSE(CF_AppData.engine.cycle_expired);
+}
+
+void Test_CF_CFDP_CycleBudgetExpired(void)
+{
+    /* Test case for:
+     * bool CF_CFDP_CycleBudgetExpired(void)
+     */
+
+    /* no budget, or outside of a cycle */
+    UtAssert_BOOL_FALSE(CF_CFDP_CycleBudgetExpired());
+    UtAssert_STUB_COUNT(OS_GetLocalTime, 0);
+
+    /* budget not used up yet */
+    OS_GetLocalTime(&CF_AppData.engine.cycle_start);
+    CF_AppData.engine.cycle_usec = UINT32_MAX;
+    UtAssert_BOOL_FALSE(CF_CFDP_CycleBudgetExpired());
+    UtAssert_STUB_COUNT(OS_GetLocalTime, 2);
+
+    /* budget used up */
+    CF_AppData.engine.cycle_usec = 1;
+    UtAssert_BOOL_TRUE(CF_CFDP_CycleBudgetExpired());
+    UtAssert_STUB_COUNT(OS_GetLocalTime, 3);
+
+    /* stays used up without checking the time again */
+    CF_AppData.engine.cycle_usec = UINT32_MAX;
+    UtAssert_BOOL_TRUE(CF_CFDP_CycleBudgetExpired());
+    UtAssert_STUB_COUNT(OS_GetLocalTime, 3);
+}
+
+void Test_CF_CFDP_UpdateCycleStats(void)
+{
+    /* Test case for:
+     * void CF_CFDP_UpdateCycleStats(uint32 usec, uint32 budget)
+     */
+    CF_HkCycle_Data_t *hk = &CF_AppData.hk.Payload.cycle;
+
+    /* first sample sets everything */
+    UtAssert_VOIDCALL(CF_CFDP_UpdateCycleStats(100, 0));
+    UtAssert_UINT32_EQ(hk->count, 1);
+    UtAssert_UINT32_EQ(hk->min_usec, 100);
+    UtAssert_UINT32_EQ(hk->mean_usec, 100);
+    UtAssert_UINT32_EQ(hk->max_usec, 100);
+
+    /* shorter cycle */
+    UtAssert_VOIDCALL(CF_CFDP_UpdateCycleStats(20, 0));
+    UtAssert_UINT32_EQ(hk->count, 2);
+    UtAssert_UINT32_EQ(hk->min_usec, 20);
+    UtAssert_UINT32_EQ(hk->mean_usec, 90);
+    UtAssert_UINT32_EQ(hk->max_usec, 100);
+
+    /* longer cycle, over budget */
+    UtAssert_VOIDCALL(CF_CFDP_UpdateCycleStats(250, 200));
+    UtAssert_UINT32_EQ(hk->min_usec, 20);
+    UtAssert_UINT32_EQ(hk->mean_usec, 110);
+    UtAssert_UINT32_EQ(hk->max_usec, 250);
+    UtAssert_UINT32_EQ(hk->overruns, 1);
+
+    /* exactly on budget, and unlimited, are not overruns */
+    UtAssert_VOIDCALL(CF_CFDP_UpdateCycleStats(200, 200));
+    UtAssert_VOIDCALL(CF_CFDP_UpdateCycleStats(500, 0));
+    UtAssert_UINT32_EQ(hk->overruns, 1);
+    UtAssert_UINT32_EQ(hk->count, 5);
+
+    /* count saturates */
+    hk->count = UINT32_MAX;
+    UtAssert_VOIDCALL(CF_CFDP_UpdateCycleStats(500, 0));
+    UtAssert_UINT32_EQ(hk->count, UINT32_MAX);
 }
 
 void Test_CF_CFDP_ResetTransaction(void)
@@ -1372,17 +2771,26 @@ void Test_CF_CFDP_ResetTransaction(void)
     CF_AppData.hk.Payload.channel_hk[UT_CFDP_CHANNEL].q_size[txn->flags.com.q_index] = 10;
     UtAssert_VOIDCALL(CF_CFDP_ResetTransaction(txn, true));
     UtAssert_STUB_COUNT(CF_FreeTransaction, 1);
+    UtAssert_STUB_COUNT(CF_Ckpt_Remove, 1);
 
     UT_ResetState(UT_KEY(CF_FreeTransaction));
+    UT_ResetState(UT_KEY(CF_AddElapsedUsec));
+    UT_ResetState(UT_KEY(CFE_TIME_GetTime));
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, &history, &txn, NULL);
-    txn->fd      = OS_ObjectIdFromInteger(1);
-    history->dir = CF_Direction_TX;
-    txn->state   = CF_TxnState_S1;
+    txn->fd          = OS_ObjectIdFromInteger(1);
+    history->dir     = CF_Direction_TX;
+    history->waiting = true;
+    txn->state       = CF_TxnState_S1;
     UtAssert_VOIDCALL(CF_CFDP_ResetTransaction(txn, true));
+    UtAssert_BOOL_FALSE(history->waiting);
+    UtAssert_STUB_COUNT(CF_AddElapsedUsec, 1);
+    UtAssert_STUB_COUNT(CFE_TIME_GetTime, 1);
     UtAssert_VOIDCALL(CF_CFDP_ResetTransaction(txn, false));
     UtAssert_STUB_COUNT(CF_FreeTransaction, 2);
 
     UT_ResetState(UT_KEY(CF_FreeTransaction));
+    UT_ResetState(UT_KEY(CF_CFDP_R2_StagingRelease));
+    UT_ResetState(UT_KEY(CF_CFDP_R_DeltaReset));
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, &history, &txn, NULL);
     txn->fd      = OS_ObjectIdFromInteger(1);
     history->dir = CF_Direction_RX;
@@ -1390,6 +2798,19 @@ void Test_CF_CFDP_ResetTransaction(void)
     UtAssert_VOIDCALL(CF_CFDP_ResetTransaction(txn, true));
     UtAssert_VOIDCALL(CF_CFDP_ResetTransaction(txn, false));
     UtAssert_STUB_COUNT(CF_FreeTransaction, 2);
+    UtAssert_STUB_COUNT(CF_CFDP_R2_StagingRelease, 2);
+    UtAssert_STUB_COUNT(CF_CFDP_R_DeltaReset, 2);
+
+    /* a failed R2 that keeps its partial file does not remove it */
+    UT_ResetState(UT_KEY(CF_WrappedRemove));
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_RX, NULL, NULL, &history, &txn, NULL);
+    UT_SetDefaultReturnValue(UT_KEY(CF_Ckpt_RetainPartial), true);
+    txn->fd      = OS_ObjectIdFromInteger(1);
+    history->dir = CF_Direction_RX;
+    txn->state   = CF_TxnState_R2;
+    UtAssert_VOIDCALL(CF_CFDP_ResetTransaction(txn, true));
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 0);
+    UT_ResetState(UT_KEY(CF_Ckpt_RetainPartial));
 
     UT_ResetState(UT_KEY(CF_FreeTransaction));
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
@@ -1401,6 +2822,67 @@ void Test_CF_CFDP_ResetTransaction(void)
     UtAssert_VOIDCALL(CF_CFDP_ResetTransaction(txn, false));
     UtAssert_STUB_COUNT(CF_FreeTransaction, 2);
 
+    /* multi-destination send, the file is moved only once the last destination is done */
+    UT_ResetState(UT_KEY(CF_WrappedClose));
+    UT_ResetState(UT_KEY(CF_WrappedRemove));
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, &history, &txn, NULL);
+    txn->fanout  = &CF_AppData.engine.fanouts[0];
+    history->dir = CF_Direction_TX;
+    txn->state   = CF_TxnState_S2;
+    UtAssert_VOIDCALL(CF_CFDP_ResetTransaction(txn, true));
+    UtAssert_STUB_COUNT(CF_FanOut_Release, 1);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 0);
+    UT_SetDeferredRetcode(UT_KEY(CF_FanOut_Release), 1, true);
+    UtAssert_VOIDCALL(CF_CFDP_ResetTransaction(txn, true));
+    UtAssert_STUB_COUNT(CF_FanOut_Release, 2);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 1); /* no move directory configured */
+    UtAssert_STUB_COUNT(CF_WrappedClose, 0);
+
+    /* a successful class 2 send is recorded as delivered when the channel skips those */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, &history, &txn, &config);
+    history->dir                                  = CF_Direction_TX;
+    history->txn_stat                             = CF_TxnStatus_NO_ERROR;
+    txn->state                                    = CF_TxnState_S2;
+    txn->flags.com.crc_calc                       = true;
+    config->chan[txn->chan_num].tx_skip_delivered = 1;
+    UtAssert_VOIDCALL(CF_CFDP_ResetTransaction(txn, true));
+    UtAssert_STUB_COUNT(CF_Delivered_Add, 1);
+
+    /* but not when it was found to be delivered already, or failed */
+    txn->flags.tx.delivered = true;
+    UtAssert_VOIDCALL(CF_CFDP_ResetTransaction(txn, true));
+    txn->flags.tx.delivered = false;
+    history->txn_stat       = CF_TxnStatus_FILESTORE_REJECTION;
+    UtAssert_VOIDCALL(CF_CFDP_ResetTransaction(txn, true));
+    UtAssert_STUB_COUNT(CF_Delivered_Add, 1);
+
+    /* a compressed send is recorded as the original file, and its temp file is closed and removed */
+    history->txn_stat         = CF_TxnStatus_NO_ERROR;
+    txn->flags.com.compressed = true;
+    OS_OpenCreate(&txn->zfd, "ut", 0, 0); /* sets zfd */
+    UtAssert_VOIDCALL(CF_CFDP_ResetTransaction(txn, true));
+    UtAssert_STUB_COUNT(CF_Delivered_Add, 2);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 2);
+
+    /* likewise a delta, whose signatures are then settled */
+    UT_ResetState(UT_KEY(CF_CFDP_S_DeltaReset));
+    txn->flags.com.compressed = false;
+    txn->flags.com.delta      = true;
+    UtAssert_VOIDCALL(CF_CFDP_ResetTransaction(txn, true));
+    UtAssert_STUB_COUNT(CF_Delivered_Add, 3);
+    UtAssert_STUB_COUNT(CF_Delta_GetFilename, 1);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 3);
+    UtAssert_STUB_COUNT(CF_CFDP_S_DeltaReset, 1);
+
+    /* a bundle is never recorded, its files are settled instead */
+    UT_ResetState(UT_KEY(CF_CFDP_S_BundleReset));
+    txn->flags.com.delta  = false;
+    txn->flags.com.bundle = true;
+    UtAssert_VOIDCALL(CF_CFDP_ResetTransaction(txn, true));
+    UtAssert_STUB_COUNT(CF_Delivered_Add, 3);
+    UtAssert_STUB_COUNT(CF_CFDP_S_BundleReset, 1);
+
     /* coverage completeness:
      * test decrement of chan->num_cmd_tx
      * test decrement of playback num_ts
@@ -1421,16 +2903,24 @@ void Test_CF_CFDP_ResetTransaction(void)
     UtAssert_UINT32_EQ(chan->num_cmd_tx, 7);
     UtAssert_STUB_COUNT(CF_FreeTransaction, 1);
 
+    /* S2 with file data still in flight gives it back to the peer */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, &history, &txn, NULL);
+    history->dir                         = CF_Direction_TX;
+    txn->state                           = CF_TxnState_S2;
+    txn->state_data.send.s2.fc_in_flight = 100;
+    UtAssert_VOIDCALL(CF_CFDP_ResetTransaction(txn, true));
+    UtAssert_STUB_COUNT(CF_Flow_Release, 1);
+
     /*
      * File is in Polling Directory, Not Keep, and is Error
      * Move to fail directory successful
      */
     UT_ResetState(UT_KEY(CF_FreeTransaction));
-    UT_ResetState(UT_KEY(OS_remove));
-    UT_ResetState(UT_KEY(OS_mv));
+    UT_ResetState(UT_KEY(CF_WrappedRemove));
+    UT_ResetState(UT_KEY(CF_WrappedRename));
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, &chan, &history, &txn, &config);
     UT_SetDefaultReturnValue(UT_KEY(CF_TxnStatus_IsError), true);
-    UT_SetDefaultReturnValue(UT_KEY(OS_mv), OS_SUCCESS);
+    UT_SetDefaultReturnValue(UT_KEY(CF_WrappedRename), OS_SUCCESS);
     txn->fd    = OS_ObjectIdFromInteger(1);
     txn->keep  = 0;
     txn->state = CF_TxnState_S2;
@@ -1440,19 +2930,19 @@ void Test_CF_CFDP_ResetTransaction(void)
 
     UtAssert_VOIDCALL(CF_CFDP_ResetTransaction(txn, 0));
     UtAssert_STUB_COUNT(CF_FreeTransaction, 1);
-    UtAssert_STUB_COUNT(OS_mv, 1);
-    UtAssert_STUB_COUNT(OS_remove, 0);
+    UtAssert_STUB_COUNT(CF_WrappedRename, 1);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 0);
 
     /*
      * File is in Polling Directory, Not Keep, and is Error
      * Move to fail directory not successful
      */
     UT_ResetState(UT_KEY(CF_FreeTransaction));
-    UT_ResetState(UT_KEY(OS_remove));
-    UT_ResetState(UT_KEY(OS_mv));
+    UT_ResetState(UT_KEY(CF_WrappedRemove));
+    UT_ResetState(UT_KEY(CF_WrappedRename));
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, &chan, &history, &txn, &config);
     UT_SetDefaultReturnValue(UT_KEY(CF_TxnStatus_IsError), true);
-    UT_SetDefaultReturnValue(UT_KEY(OS_mv), OS_ERROR);
+    UT_SetDefaultReturnValue(UT_KEY(CF_WrappedRename), OS_ERROR);
     txn->fd    = OS_ObjectIdFromInteger(1);
     txn->keep  = 0;
     txn->state = CF_TxnState_S2;
@@ -1462,15 +2952,15 @@ void Test_CF_CFDP_ResetTransaction(void)
 
     UtAssert_VOIDCALL(CF_CFDP_ResetTransaction(txn, 0));
     UtAssert_STUB_COUNT(CF_FreeTransaction, 1);
-    UtAssert_STUB_COUNT(OS_mv, 1);
-    UtAssert_STUB_COUNT(OS_remove, 1);
+    UtAssert_STUB_COUNT(CF_WrappedRename, 1);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 1);
 
     /*
      * Source file outside polling directory, Not Keep, is Error
      */
     UT_ResetState(UT_KEY(CF_FreeTransaction));
-    UT_ResetState(UT_KEY(OS_remove));
-    UT_ResetState(UT_KEY(OS_mv));
+    UT_ResetState(UT_KEY(CF_WrappedRemove));
+    UT_ResetState(UT_KEY(CF_WrappedRename));
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, &chan, &history, &txn, &config);
     UT_SetDefaultReturnValue(UT_KEY(CF_TxnStatus_IsError), true);
     txn->fd    = OS_ObjectIdFromInteger(1);
@@ -1482,15 +2972,15 @@ void Test_CF_CFDP_ResetTransaction(void)
 
     UtAssert_VOIDCALL(CF_CFDP_ResetTransaction(txn, 0));
     UtAssert_STUB_COUNT(CF_FreeTransaction, 1);
-    UtAssert_STUB_COUNT(OS_mv, 0);
-    UtAssert_STUB_COUNT(OS_remove, 0);
+    UtAssert_STUB_COUNT(CF_WrappedRename, 0);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 0);
 
     /*
      * Source File is empty string. Not Keep, is Error
      */
     UT_ResetState(UT_KEY(CF_FreeTransaction));
-    UT_ResetState(UT_KEY(OS_remove));
-    UT_ResetState(UT_KEY(OS_mv));
+    UT_ResetState(UT_KEY(CF_WrappedRemove));
+    UT_ResetState(UT_KEY(CF_WrappedRename));
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, &chan, &history, &txn, &config);
     UT_SetDefaultReturnValue(UT_KEY(CF_TxnStatus_IsError), true);
     txn->fd    = OS_ObjectIdFromInteger(1);
@@ -1502,8 +2992,30 @@ void Test_CF_CFDP_ResetTransaction(void)
 
     UtAssert_VOIDCALL(CF_CFDP_ResetTransaction(txn, 0));
     UtAssert_STUB_COUNT(CF_FreeTransaction, 1);
-    UtAssert_STUB_COUNT(OS_mv, 0);
-    UtAssert_STUB_COUNT(OS_remove, 1);
+    UtAssert_STUB_COUNT(CF_WrappedRename, 0);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 1);
+
+    /*
+     * File in Polling Directory only opened ahead of time, Not Keep, is Error
+     */
+    UT_ResetState(UT_KEY(CF_WrappedRemove));
+    UT_ResetState(UT_KEY(CF_WrappedRename));
+    UT_ResetState(UT_KEY(CF_CFDP_S_PrefetchRelease));
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, &chan, &history, &txn, &config);
+    UT_SetDefaultReturnValue(UT_KEY(CF_TxnStatus_IsError), true);
+    txn->fd                  = OS_ObjectIdFromInteger(1);
+    txn->keep                = 0;
+    txn->state               = CF_TxnState_S2;
+    history->dir             = CF_Direction_TX;
+    txn->flags.tx.prefetched = true;
+    strcpy(history->fnames.src_filename, "/ram/poll1/test1");
+    strcpy(config->chan[0].polldir[0].src_dir, "/ram/poll1");
+    strcpy(config->fail_dir, "/ram/fail");
+
+    UtAssert_VOIDCALL(CF_CFDP_ResetTransaction(txn, 0));
+    UtAssert_STUB_COUNT(CF_WrappedRename, 0);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 0);
+    UtAssert_STUB_COUNT(CF_CFDP_S_PrefetchRelease, 1);
 }
 
 void Test_CF_CFDP_SetTxnStatus(void)
@@ -1535,11 +3047,14 @@ void Test_CF_CFDP_SendEotPkt(void)
     CF_EotPacket_t *PktBufPtr;
 
     CF_Transaction_t *txn;
+    CF_History_t *    history;
     CF_Playback_t     pb;
 
     memset(&pb, 0, sizeof(pb));
 
-    UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, NULL, &txn, NULL);
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, &history, &txn, NULL);
+    history->perf.file_bytes = 1234;
+    history->perf.pdus_recv  = 56;
 
     /* Test case where CF_EotPktBuf_t is NULL */
     UtAssert_VOIDCALL(CF_CFDP_SendEotPkt(txn));
@@ -1562,6 +3077,57 @@ void Test_CF_CFDP_SendEotPkt(void)
     UtAssert_STUB_COUNT(CFE_MSG_Init, 1);
     UtAssert_STUB_COUNT(CFE_SB_TimeStampMsg, 1);
     UtAssert_STUB_COUNT(CFE_SB_TransmitBuffer, 1);
+    UtAssert_UINT32_EQ(PktBuf.Payload.perf.file_bytes, 1234);
+    UtAssert_UINT32_EQ(PktBuf.Payload.perf.pdus_recv, 56);
+    UtAssert_UINT32_EQ(PktBuf.Payload.delivered, 0);
+    UtAssert_UINT32_EQ(PktBuf.Payload.raw_size, 0);
+    UtAssert_UINT32_EQ(PktBuf.Payload.zip_ratio, 100);
+    UtAssert_UINT32_EQ(PktBuf.Payload.zip_per_mb, 0);
+
+    /* compressed to a quarter, taking 2 ms per MiB */
+    txn->flags.com.compressed = true;
+    txn->raw_size             = 4 << 20;
+    txn->fsize                = 1 << 20;
+    history->perf.zip_usec    = 8000;
+    UT_SetDataBuffer(UT_KEY(CFE_SB_AllocateMessageBuffer), &PktBufPtr, sizeof(PktBufPtr), true);
+    UtAssert_VOIDCALL(CF_CFDP_SendEotPkt(txn));
+    UtAssert_UINT32_EQ(PktBuf.Payload.raw_size, 4 << 20);
+    UtAssert_UINT32_EQ(PktBuf.Payload.zip_ratio, 400);
+    UtAssert_UINT32_EQ(PktBuf.Payload.zip_per_mb, 2000);
+    txn->flags.com.compressed = false;
+
+    /* a send that found the file already delivered says so */
+    history->dir            = CF_Direction_TX;
+    txn->flags.tx.delivered = true;
+    UT_SetDataBuffer(UT_KEY(CFE_SB_AllocateMessageBuffer), &PktBufPtr, sizeof(PktBufPtr), true);
+    UtAssert_VOIDCALL(CF_CFDP_SendEotPkt(txn));
+    UtAssert_UINT32_EQ(PktBuf.Payload.delivered, 1);
+}
+
+void Test_CF_CFDP_PerfWait(void)
+{
+    /* Test case for:
+     * void CF_CFDP_PerfWait(CF_History_t *history, bool waiting)
+     */
+    CF_History_t *history;
+
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_NONE, NULL, NULL, &history, NULL, NULL);
+
+    /* not waiting, nothing to stop */
+    UtAssert_VOIDCALL(CF_CFDP_PerfWait(history, false));
+    UtAssert_STUB_COUNT(OS_GetLocalTime, 0);
+    UtAssert_STUB_COUNT(CF_AddElapsedUsec, 0);
+
+    /* start waiting, only the first call records the start */
+    UtAssert_VOIDCALL(CF_CFDP_PerfWait(history, true));
+    UtAssert_BOOL_TRUE(history->waiting);
+    UtAssert_VOIDCALL(CF_CFDP_PerfWait(history, true));
+    UtAssert_STUB_COUNT(OS_GetLocalTime, 1);
+
+    /* stop waiting, the time goes to the wait total */
+    UtAssert_VOIDCALL(CF_CFDP_PerfWait(history, false));
+    UtAssert_BOOL_FALSE(history->waiting);
+    UtAssert_STUB_COUNT(CF_AddElapsedUsec, 1);
 }
 
 void Test_CF_CFDP_DisableEngine(void)
@@ -1574,7 +3140,9 @@ void Test_CF_CFDP_DisableEngine(void)
     CF_AppData.engine.enabled = true;
     UtAssert_VOIDCALL(CF_CFDP_DisableEngine());
     UtAssert_STUB_COUNT(CFE_SB_DeletePipe, CF_NUM_CHANNELS);
+    UtAssert_STUB_COUNT(CF_UdpIntf_Close, CF_NUM_CHANNELS);
     UtAssert_BOOL_FALSE(CF_AppData.engine.enabled);
+    UtAssert_STUB_COUNT(CF_Bundle_Release, 1);
 
     /* nominal call with playbacks and polls active */
     CF_AppData.engine.channels[UT_CFDP_CHANNEL].playback[0].busy = true;
@@ -1600,6 +3168,20 @@ void Test_CF_CFDP_CloseFiles(void)
     UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
     txn->fd = OS_ObjectIdFromInteger(1);
     UtAssert_INT32_EQ(CF_CFDP_CloseFiles(&txn->cl_node, NULL), CF_CLIST_CONT);
+
+    /* multi-destination send, the shared file is released as not complete and never moved */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->fanout = &CF_AppData.engine.fanouts[0];
+    UtAssert_INT32_EQ(CF_CFDP_CloseFiles(&txn->cl_node, NULL), CF_CLIST_CONT);
+    UtAssert_STUB_COUNT(CF_FanOut_Release, 1);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 0);
+
+    /* a compression or expansion pass has a second file open */
+    UT_CFDP_SetupBasicTestState(UT_CF_Setup_TX, NULL, NULL, NULL, &txn, NULL);
+    txn->zfd = OS_ObjectIdFromInteger(2);
+    UtAssert_INT32_EQ(CF_CFDP_CloseFiles(&txn->cl_node, NULL), CF_CLIST_CONT);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 2);
 }
 
 void Test_CF_CFDP_CancelTransaction(void)
@@ -1630,35 +3212,35 @@ void Test_CF_CFDP_MoveFile(void)
     memset(test_filename, 0, sizeof(test_filename));
     memset(test_dest_dir, 0, sizeof(test_dest_dir));
 
-    /* nominal call, no OS_remove  */
-    UT_ResetState(UT_KEY(OS_remove));
-    UT_ResetState(UT_KEY(OS_mv));
-    UT_SetDefaultReturnValue(UT_KEY(OS_mv), OS_SUCCESS);
+    /* nominal call, no CF_WrappedRemove  */
+    UT_ResetState(UT_KEY(CF_WrappedRemove));
+    UT_ResetState(UT_KEY(CF_WrappedRename));
+    UT_SetDefaultReturnValue(UT_KEY(CF_WrappedRename), OS_SUCCESS);
     snprintf(test_filename, sizeof(test_filename), "/ram");
     snprintf(test_dest_dir, sizeof(test_dest_dir), "/test");
     UtAssert_VOIDCALL(CF_CFDP_MoveFile(test_filename, test_dest_dir));
-    UtAssert_STUB_COUNT(OS_remove, 0);
-    UtAssert_STUB_COUNT(OS_mv, 1);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 0);
+    UtAssert_STUB_COUNT(CF_WrappedRename, 1);
 
     /* no filename with '/' found */
-    UT_ResetState(UT_KEY(OS_mv));
+    UT_ResetState(UT_KEY(CF_WrappedRename));
     snprintf(test_filename, sizeof(test_filename), "ram");
     snprintf(test_dest_dir, sizeof(test_dest_dir), "/test");
     UtAssert_VOIDCALL(CF_CFDP_MoveFile(test_filename, test_dest_dir));
-    UtAssert_STUB_COUNT(OS_remove, 1);
-    UtAssert_STUB_COUNT(OS_mv, 0);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 1);
+    UtAssert_STUB_COUNT(CF_WrappedRename, 0);
 
     /* no dest dir */
-    UT_ResetState(UT_KEY(OS_remove));
-    UT_ResetState(UT_KEY(OS_mv));
+    UT_ResetState(UT_KEY(CF_WrappedRemove));
+    UT_ResetState(UT_KEY(CF_WrappedRename));
     memset(test_dest_dir, 0, sizeof(test_dest_dir));
     UtAssert_VOIDCALL(CF_CFDP_MoveFile(test_filename, test_dest_dir));
-    UtAssert_STUB_COUNT(OS_remove, 1);
-    UtAssert_STUB_COUNT(OS_mv, 0);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 1);
+    UtAssert_STUB_COUNT(CF_WrappedRename, 0);
 
     /* nominal call, potential truncation detected */
-    UT_ResetState(UT_KEY(OS_remove));
-    UT_ResetState(UT_KEY(OS_mv));
+    UT_ResetState(UT_KEY(CF_WrappedRemove));
+    UT_ResetState(UT_KEY(CF_WrappedRename));
     memset(test_filename, 'X', sizeof(test_filename) - 1);
     test_filename[0]                         = '/';
     test_filename[sizeof(test_filename) - 1] = '\0';
@@ -1667,8 +3249,8 @@ void Test_CF_CFDP_MoveFile(void)
     test_dest_dir[sizeof(test_dest_dir) - 1] = '\0';
     UtAssert_VOIDCALL(CF_CFDP_MoveFile(test_filename, test_dest_dir));
     UT_CF_AssertEventID(CF_EID_INF_CFDP_BUF_EXCEED);
-    UtAssert_STUB_COUNT(OS_remove, 0);
-    UtAssert_STUB_COUNT(OS_mv, 1);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 0);
+    UtAssert_STUB_COUNT(CF_WrappedRename, 1);
 }
 
 /*******************************************************************************
@@ -1681,18 +3263,36 @@ void UtTest_Setup(void)
 {
     UtTest_Add(Test_CF_CFDP_InitEngine, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_InitEngine");
     UtTest_Add(Test_CF_CFDP_CycleEngine, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_CycleEngine");
+    UtTest_Add(Test_CF_CFDP_CycleBudgetExpired, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown,
+               "CF_CFDP_CycleBudgetExpired");
+    UtTest_Add(Test_CF_CFDP_UpdateCycleStats, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown,
+               "CF_CFDP_UpdateCycleStats");
+    UtTest_Add(Test_CF_CFDP_ServiceInput, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_ServiceInput");
     UtTest_Add(Test_CF_CFDP_ProcessPlaybackDirectory, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown,
                "Test_CF_CFDP_ProcessPlaybackDirectory");
+    UtTest_Add(Test_CF_CFDP_ProcessPlaybackDirectory_Borrow, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown,
+               "Test_CF_CFDP_ProcessPlaybackDirectory_Borrow");
+    UtTest_Add(Test_CF_CFDP_ProcessPlaybackDirectory_Bundle, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown,
+               "Test_CF_CFDP_ProcessPlaybackDirectory_Bundle");
+    UtTest_Add(Test_CF_CFDP_ProcessPlaybackDirectory_WorkList, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown,
+               "Test_CF_CFDP_ProcessPlaybackDirectory_WorkList");
+    UtTest_Add(Test_CF_CFDP_ProcessPlaybackDirectory_Order, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown,
+               "Test_CF_CFDP_ProcessPlaybackDirectory_Order");
     UtTest_Add(Test_CF_CFDP_ProcessPollingDirectories, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown,
                "Test_CF_CFDP_ProcessPollingDirectories");
     UtTest_Add(Test_CF_CFDP_CycleTx, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "Test_CF_CFDP_CycleTx");
+    UtTest_Add(Test_CF_CFDP_PrefetchTxNext, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_PrefetchTxNext");
     UtTest_Add(Test_CF_CFDP_CycleTxFirstActive, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown,
                "Test_CF_CFDP_CycleTxFirstActive");
+    UtTest_Add(Test_CF_CFDP_ActivateFanOut, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_ActivateFanOut");
     UtTest_Add(Test_CF_CFDP_DoTick, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_DoTick");
     UtTest_Add(Test_CF_CFDP_TickTransactions, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_TickTransactions");
+    UtTest_Add(Test_CF_CFDP_RespondTransactions, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown,
+               "CF_CFDP_RespondTransactions");
     UtTest_Add(Test_CF_CFDP_ResetTransaction, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_ResetTransaction");
     UtTest_Add(Test_CF_CFDP_SetTxnStatus, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_SetTxnStatus");
     UtTest_Add(Test_CF_CFDP_SendEotPkt, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "Test_CF_CFDP_SendEotPkt");
+    UtTest_Add(Test_CF_CFDP_PerfWait, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_PerfWait");
     UtTest_Add(Test_CF_CFDP_CancelTransaction, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown,
                "CF_CFDP_CancelTransaction");
     UtTest_Add(Test_CF_CFDP_DisableEngine, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_DisableEngine");
@@ -1700,6 +3300,8 @@ void UtTest_Setup(void)
     UtTest_Add(Test_CF_CFDP_CancelTransaction, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown,
                "CF_CFDP_CancelTransaction");
     UtTest_Add(Test_CF_CFDP_TxFile, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_TxFile");
+    UtTest_Add(Test_CF_CFDP_TxFileMulti, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_TxFileMulti");
+    UtTest_Add(Test_CF_CFDP_TxFileFollow, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_TxFileFollow");
     UtTest_Add(Test_CF_CFDP_PlaybackDir, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_PlaybackDir");
     UtTest_Add(Test_CF_CFDP_ArmAckTimer, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_ArmAckTimer");
 
@@ -1717,6 +3319,8 @@ void UtTest_Setup(void)
     UtTest_Add(Test_CF_CFDP_RecvAck, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_RecvAck");
     UtTest_Add(Test_CF_CFDP_RecvFin, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_RecvFin");
     UtTest_Add(Test_CF_CFDP_RecvNak, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_RecvNak");
+    UtTest_Add(Test_CF_CFDP_RecvPrompt, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_RecvPrompt");
+    UtTest_Add(Test_CF_CFDP_RecvKeepAlive, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_RecvKeepAlive");
     UtTest_Add(Test_CF_CFDP_CopyStringFromLV, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_CopyStringFromLV");
 
     UtTest_Add(Test_CF_CFDP_ConstructPduHeader, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown,
@@ -1727,6 +3331,8 @@ void UtTest_Setup(void)
     UtTest_Add(Test_CF_CFDP_SendAck, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_SendAck");
     UtTest_Add(Test_CF_CFDP_SendFin, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_SendFin");
     UtTest_Add(Test_CF_CFDP_SendNak, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_SendNak");
+    UtTest_Add(Test_CF_CFDP_SendPrompt, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_SendPrompt");
+    UtTest_Add(Test_CF_CFDP_SendKeepAlive, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_SendKeepAlive");
     UtTest_Add(Test_CF_CFDP_AppendTlv, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_AppendTlv");
 
     UtTest_Add(Test_CF_CFDP_MoveFile, cf_cfdp_tests_Setup, cf_cfdp_tests_Teardown, "CF_CFDP_MoveFile");
@@ -288,6 +288,34 @@ void Test_CF_Chunk_GetRmFirst(void)
     UtAssert_UINT32_EQ(clist.count, 1);
 }
 
+void Test_CF_Chunk_CountUncovered(void)
+{
+    CF_ChunkList_t clist;
+    CF_Chunk_t     chunks[2];
+
+    CF_ChunkListInit(&clist, sizeof(chunks) / sizeof(chunks[0]), chunks);
+
+    /* nothing in the list */
+    UtAssert_UINT32_EQ(CF_ChunkList_CountUncovered(&clist, 0, 100), 100);
+
+    CF_ChunkListAdd(&clist, 10, 10);
+    CF_ChunkListAdd(&clist, 30, 10);
+
+    /* all of the range is already in the list */
+    UtAssert_UINT32_EQ(CF_ChunkList_CountUncovered(&clist, 12, 5), 0);
+    UtAssert_UINT32_EQ(CF_ChunkList_CountUncovered(&clist, 30, 10), 0);
+
+    /* range overlaps the ends of chunks, and spans both */
+    UtAssert_UINT32_EQ(CF_ChunkList_CountUncovered(&clist, 5, 10), 5);
+    UtAssert_UINT32_EQ(CF_ChunkList_CountUncovered(&clist, 35, 10), 5);
+    UtAssert_UINT32_EQ(CF_ChunkList_CountUncovered(&clist, 0, 50), 30);
+
+    /* range between or past the chunks */
+    UtAssert_UINT32_EQ(CF_ChunkList_CountUncovered(&clist, 20, 10), 10);
+    UtAssert_UINT32_EQ(CF_ChunkList_CountUncovered(&clist, 40, 10), 10);
+    UtAssert_UINT32_EQ(CF_ChunkList_CountUncovered(&clist, 20, 0), 0);
+}
+
 void Test_CF_Chunk_ComputeGaps(void)
 {
     CF_ChunkList_t clist;
@@ -355,5 +383,6 @@ void UtTest_Setup(void)
     TEST_CF_ADD(Test_CF_Chunk_CreateAddReset);
     TEST_CF_ADD(Test_CF_Chunk_Combine);
     TEST_CF_ADD(Test_CF_Chunk_GetRmFirst);
+    TEST_CF_ADD(Test_CF_Chunk_CountUncovered);
     TEST_CF_ADD(Test_CF_Chunk_ComputeGaps);
 }
@@ -0,0 +1,622 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* cf testing includes */
+#include "cf_test_utils.h"
+#include "cf_test_alt_handler.h"
+#include "cf_ckpt.h"
+#include "cf_cfdp.h"
+#include "cf_cfdp_r.h"
+#include "cf_events.h"
+
+/*******************************************************************************
+**
+**  cf_ckpt_tests local utility functions
+**
+*******************************************************************************/
+
+static CF_History_t      UT_CF_Ckpt_History[3];
+static CF_ChunkWrapper_t UT_CF_Ckpt_Chunks;
+static CF_Chunk_t        UT_CF_Ckpt_ChunkMem[4];
+static CF_ConfigTable_t  UT_CF_Ckpt_Config;
+
+/* a write of every byte asked for */
+static void UT_AltHandler_CF_WrappedWrite_All(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CFE_Status_t retval = (CFE_Status_t)UT_Hook_GetArgValueByName(Context, "write_size", size_t);
+
+    UT_Stub_SetReturnValue(FuncKey, retval);
+}
+
+/* a read of every byte asked for, all zero */
+static void UT_AltHandler_CF_WrappedRead_All(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    void *       buf    = UT_Hook_GetArgValueByName(Context, "buf", void *);
+    CFE_Status_t retval = (CFE_Status_t)UT_Hook_GetArgValueByName(Context, "read_size", size_t);
+
+    memset(buf, 0, retval);
+    UT_Stub_SetReturnValue(FuncKey, retval);
+}
+
+/* a read of the record in UserObj, and of zeros after it */
+static void UT_AltHandler_CF_WrappedRead_Record(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    void *       buf    = UT_Hook_GetArgValueByName(Context, "buf", void *);
+    CFE_Status_t retval = (CFE_Status_t)UT_Hook_GetArgValueByName(Context, "read_size", size_t);
+
+    if (retval == sizeof(CF_CkptRecord_t))
+    {
+        memcpy(buf, UserObj, retval);
+    }
+    else
+    {
+        memset(buf, 0, retval);
+    }
+    UT_Stub_SetReturnValue(FuncKey, retval);
+}
+
+/* CF_ChunkListInit() is a stub here */
+static void UT_CF_Ckpt_SetupChunks(void)
+{
+    memset(&UT_CF_Ckpt_Chunks, 0, sizeof(UT_CF_Ckpt_Chunks));
+    UT_CF_Ckpt_Chunks.chunks.max_chunks = 4;
+    UT_CF_Ckpt_Chunks.chunks.chunks     = UT_CF_Ckpt_ChunkMem;
+}
+
+/* the time given by UserObj */
+static void UT_AltHandler_CFE_TIME_GetTime(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CFE_TIME_SysTime_t retval = *(CFE_TIME_SysTime_t *)UserObj;
+
+    UT_Stub_SetReturnValue(FuncKey, retval);
+}
+
+static CF_Transaction_t *UT_CF_Ckpt_SetupTxn(int idx, CF_TxnState_t state)
+{
+    CF_Transaction_t *txn = &CF_AppData.engine.transactions[idx];
+
+    memset(&UT_CF_Ckpt_History[idx], 0, sizeof(UT_CF_Ckpt_History[idx]));
+    UT_CF_Ckpt_SetupChunks();
+
+    txn->state             = state;
+    txn->history           = &UT_CF_Ckpt_History[idx];
+    txn->chunks            = &UT_CF_Ckpt_Chunks;
+    txn->flags.com.q_index = (state == CF_TxnState_S2) ? CF_QueueIdx_TXA : CF_QueueIdx_RX;
+    txn->history->src_eid  = 1;
+    txn->history->seq_num  = idx + 10;
+
+    return txn;
+}
+
+static void UT_CF_Ckpt_SetupRecord(CF_CkptRecord_t *rec, CF_TxnState_t state)
+{
+    memset(rec, 0, sizeof(*rec));
+    rec->magic    = CF_CKPT_FILE_MAGIC;
+    rec->version  = CF_CKPT_FILE_VERSION;
+    rec->chan_num = 0;
+    rec->state    = state;
+    rec->src_eid  = 1;
+    rec->seq_num  = 5;
+    rec->fsize    = 100;
+    strcpy(rec->fnames.src_filename, "/cf/src");
+    strcpy(rec->fnames.dst_filename, "/cf/dst");
+}
+
+static void UT_CF_Ckpt_SetupResume(CF_Transaction_t *txn, CF_CListNode_t *free_node)
+{
+    memset(txn, 0, sizeof(*txn));
+    memset(&UT_CF_Ckpt_History[0], 0, sizeof(UT_CF_Ckpt_History[0]));
+    txn->history = &UT_CF_Ckpt_History[0];
+    UT_CF_Ckpt_SetupChunks();
+
+    memset(&UT_CF_Ckpt_Config, 0, sizeof(UT_CF_Ckpt_Config));
+    UT_CF_Ckpt_Config.local_eid = 1;
+    CF_AppData.config_table     = &UT_CF_Ckpt_Config;
+
+    CF_AppData.engine.channels[0].qs[CF_QueueIdx_FREE] = free_node;
+
+    UT_SetHandlerFunction(UT_KEY(CF_FindUnusedTransaction), UT_AltHandler_GenericPointerReturn, txn);
+    UT_SetHandlerFunction(UT_KEY(CF_CFDP_FindUnusedChunks), UT_AltHandler_GenericPointerReturn, &UT_CF_Ckpt_Chunks);
+}
+
+/*******************************************************************************
+**
+**  cf_ckpt_tests
+**
+*******************************************************************************/
+
+void Test_CF_Ckpt_GetFilename(void)
+{
+    /* Test case for:
+     * void CF_Ckpt_GetFilename(char *buf, size_t buf_size, const CF_Transaction_t *txn, const char *ext);
+     */
+    CF_Transaction_t *txn = UT_CF_Ckpt_SetupTxn(1, CF_TxnState_S2);
+    char              buf[OS_MAX_PATH_LEN];
+    char              expected[OS_MAX_PATH_LEN];
+
+    txn->chan_num = 1;
+    snprintf(expected, sizeof(expected), "%s/1_1_11.ckp", CF_CHECKPOINT_DIR);
+    UtAssert_VOIDCALL(CF_Ckpt_GetFilename(buf, sizeof(buf), txn, CF_CKPT_FILE_EXT));
+    UtAssert_STRINGBUF_EQ(buf, sizeof(buf), expected, sizeof(expected));
+}
+
+void Test_CF_Ckpt_Write(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_Ckpt_Write(CF_Transaction_t *txn);
+     */
+    CF_Transaction_t *txn;
+
+    /* the open fails */
+    txn = UT_CF_Ckpt_SetupTxn(0, CF_TxnState_S2);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UtAssert_INT32_EQ(CF_Ckpt_Write(txn), CF_ERROR);
+    UT_CF_AssertEventID(CF_CKPT_WRITE_ERR_EID);
+    UtAssert_BOOL_FALSE(txn->flags.com.checkpointed);
+
+    /* the record is not written in full, so the previous checkpoint stays */
+    UtAssert_INT32_EQ(CF_Ckpt_Write(txn), CF_ERROR);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+    UtAssert_STUB_COUNT(CF_WrappedRename, 0);
+    UtAssert_BOOL_FALSE(txn->flags.com.checkpointed);
+
+    /* a sender, with its chunk list */
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedWrite), UT_AltHandler_CF_WrappedWrite_All, NULL);
+    txn->chunks->chunks.count = 1;
+    txn->foffs = 50;
+    UtAssert_INT32_EQ(CF_Ckpt_Write(txn), CFE_SUCCESS);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 3);
+    UtAssert_STUB_COUNT(CF_WrappedRename, 1);
+    UtAssert_BOOL_TRUE(txn->flags.com.checkpointed);
+
+    /* a receiver, with no chunks yet */
+    txn = UT_CF_Ckpt_SetupTxn(1, CF_TxnState_R2);
+    UtAssert_INT32_EQ(CF_Ckpt_Write(txn), CFE_SUCCESS);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 4);
+    UtAssert_BOOL_TRUE(txn->flags.com.checkpointed);
+
+    /* the rename fails */
+    txn = UT_CF_Ckpt_SetupTxn(2, CF_TxnState_R2);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRename), 1, OS_ERROR);
+    UtAssert_INT32_EQ(CF_Ckpt_Write(txn), CF_ERROR);
+    UtAssert_BOOL_FALSE(txn->flags.com.checkpointed);
+}
+
+void Test_CF_Ckpt_Remove(void)
+{
+    /* Test case for:
+     * void CF_Ckpt_Remove(CF_Transaction_t *txn);
+     */
+    CF_Transaction_t *txn = UT_CF_Ckpt_SetupTxn(0, CF_TxnState_S2);
+
+    /* never checkpointed */
+    UtAssert_VOIDCALL(CF_Ckpt_Remove(txn));
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 0);
+
+    txn->flags.com.checkpointed = true;
+    UtAssert_VOIDCALL(CF_Ckpt_Remove(txn));
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 1);
+    UtAssert_BOOL_FALSE(txn->flags.com.checkpointed);
+}
+
+void Test_CF_Ckpt_Cycle(void)
+{
+    /* Test case for:
+     * void CF_Ckpt_Cycle(void);
+     */
+    CF_Transaction_t * txn;
+    CFE_TIME_SysTime_t now = {CF_CHECKPOINT_INTERVAL_S + 1, 0};
+    int                i;
+
+    for (i = 0; i < CF_NUM_TRANSACTIONS; ++i)
+    {
+        CF_AppData.engine.transactions[i].flags.com.q_index = CF_QueueIdx_FREE;
+    }
+
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedWrite), UT_AltHandler_CF_WrappedWrite_All, NULL);
+
+    /* within the interval */
+    UtAssert_VOIDCALL(CF_Ckpt_Cycle());
+    UtAssert_STUB_COUNT(CF_Timer_Tick, 1);
+    UtAssert_BOOL_FALSE(CF_AppData.ckpt.active);
+
+    /* a pass over transactions that are all too young, or not worth resuming */
+    txn                            = UT_CF_Ckpt_SetupTxn(0, CF_TxnState_S2);
+    txn->state_data.send.sub_state = CF_TxSubState_FILEDATA;
+    UT_CF_Ckpt_SetupTxn(1, CF_TxnState_R2);
+    UT_CF_Ckpt_SetupTxn(2, CF_TxnState_S1);
+    UT_SetDefaultReturnValue(UT_KEY(CF_Timer_Expired), true);
+    UtAssert_VOIDCALL(CF_Ckpt_Cycle());
+    UtAssert_STUB_COUNT(CF_Timer_InitRelSec, 1);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+    UtAssert_BOOL_FALSE(CF_AppData.ckpt.active);
+
+    /* old enough, but still a receiver without metadata and a sender that only has the FIN to ACK */
+    UT_SetHandlerFunction(UT_KEY(CFE_TIME_GetTime), UT_AltHandler_CFE_TIME_GetTime, &now);
+    CF_AppData.engine.transactions[0].state_data.send.sub_state = CF_TxSubState_SEND_FIN_ACK;
+    UtAssert_VOIDCALL(CF_Ckpt_Cycle());
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+
+    /* nor is one destination of a multi-destination send */
+    CF_AppData.engine.transactions[0].state_data.send.sub_state = CF_TxSubState_FILEDATA;
+    CF_AppData.engine.transactions[0].fanout                    = &CF_AppData.engine.fanouts[0];
+    UtAssert_VOIDCALL(CF_Ckpt_Cycle());
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+
+    /* nor a sender still checking its file against an earlier delivery */
+    CF_AppData.engine.transactions[0].fanout                   = NULL;
+    CF_AppData.engine.transactions[0].flags.tx.delivered_check = true;
+    UtAssert_VOIDCALL(CF_Ckpt_Cycle());
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+
+    /* nor a sender following a file still being written */
+    CF_AppData.engine.transactions[0].flags.tx.delivered_check = false;
+    CF_AppData.engine.transactions[0].flags.tx.follow          = true;
+    UtAssert_VOIDCALL(CF_Ckpt_Cycle());
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+
+    /* three due, so the pass takes two wakeups */
+    CF_AppData.engine.transactions[0].flags.tx.follow = false;
+    CF_AppData.engine.transactions[1].flags.rx.md_recv         = true;
+    UT_CF_Ckpt_SetupTxn(2, CF_TxnState_S2);
+    UtAssert_VOIDCALL(CF_Ckpt_Cycle());
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, CF_CHECKPOINT_WRITES_PER_WAKEUP);
+    UtAssert_BOOL_TRUE(CF_AppData.ckpt.active);
+
+    /* the interval is up again, but the pass in progress is finished first */
+    UtAssert_VOIDCALL(CF_Ckpt_Cycle());
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 3);
+    UtAssert_BOOL_FALSE(CF_AppData.ckpt.active);
+}
+
+void Test_CF_Ckpt_Restore(void)
+{
+    /* Test case for:
+     * void CF_Ckpt_Restore(void);
+     */
+    os_dirent_t dirent[3];
+
+    /* no checkpoint directory */
+    UT_SetDeferredRetcode(UT_KEY(OS_DirectoryOpen), 1, OS_ERROR);
+    UtAssert_VOIDCALL(CF_Ckpt_Restore());
+    UtAssert_STUB_COUNT(CF_Timer_InitRelSec, 1);
+    UtAssert_STUB_COUNT(OS_DirectoryRead, 0);
+
+    /* only finished checkpoints are loaded, and one that cannot be resumed is removed */
+    memset(dirent, 0, sizeof(dirent));
+    strcpy(dirent[0].FileName, "readme.txt");
+    strcpy(dirent[1].FileName, "0_1_2.tmp");
+    strcpy(dirent[2].FileName, "0_1_2.ckp");
+    UT_SetDataBuffer(UT_KEY(OS_DirectoryRead), dirent, sizeof(dirent), false);
+    UT_SetDeferredRetcode(UT_KEY(OS_DirectoryRead), 4, OS_ERROR);
+    UtAssert_VOIDCALL(CF_Ckpt_Restore());
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 1);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 1);
+    UtAssert_STUB_COUNT(OS_DirectoryClose, 1);
+    UT_CF_AssertEventID(CF_CKPT_RESUME_ERR_EID);
+}
+
+void Test_CF_Ckpt_Load(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_Ckpt_Load(const char *fname);
+     */
+
+    /* the open fails */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UtAssert_INT32_EQ(CF_Ckpt_Load("ut"), CF_ERROR);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 0);
+
+    /* too short */
+    UtAssert_INT32_EQ(CF_Ckpt_Load("ut"), CF_ERROR);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+
+    /* read in full, but not a checkpoint */
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedRead), UT_AltHandler_CF_WrappedRead_All, NULL);
+    UtAssert_INT32_EQ(CF_Ckpt_Load("ut"), CF_ERROR);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 2);
+}
+
+void Test_CF_Ckpt_Resume(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_Ckpt_Resume(const CF_CkptRecord_t *rec, osal_id_t fd);
+     */
+    CF_CkptRecord_t  rec;
+    CF_Transaction_t txn;
+    CF_CListNode_t   free_node;
+    CF_Channel_t *   chan = &CF_AppData.engine.channels[0];
+
+    /* not a checkpoint */
+    UT_CF_Ckpt_SetupRecord(&rec, CF_TxnState_S2);
+    rec.version = CF_CKPT_FILE_VERSION + 1;
+    UtAssert_INT32_EQ(CF_Ckpt_Resume(&rec, OS_OBJECT_ID_UNDEFINED), CF_ERROR);
+
+    /* class 1 is never checkpointed */
+    UT_CF_Ckpt_SetupRecord(&rec, CF_TxnState_S1);
+    UT_CF_Ckpt_SetupResume(&txn, &free_node);
+    UtAssert_INT32_EQ(CF_Ckpt_Resume(&rec, OS_OBJECT_ID_UNDEFINED), CF_ERROR);
+
+    /* no free transaction */
+    UT_CF_Ckpt_SetupRecord(&rec, CF_TxnState_S2);
+    UT_CF_Ckpt_SetupResume(&txn, NULL);
+    UtAssert_INT32_EQ(CF_Ckpt_Resume(&rec, OS_OBJECT_ID_UNDEFINED), CF_ERROR);
+    UtAssert_STUB_COUNT(CF_FindUnusedTransaction, 0);
+
+    /* the source file has gone since some of it was sent */
+    UT_CF_Ckpt_SetupResume(&txn, &free_node);
+    rec.foffs = 50;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedStat), 1, OS_ERROR);
+    UtAssert_INT32_EQ(CF_Ckpt_Resume(&rec, OS_OBJECT_ID_UNDEFINED), CF_ERROR);
+
+    /* too many commanded transfers on the channel already */
+    rec.foffs        = 0;
+    chan->num_cmd_tx = CF_MAX_COMMANDED_PLAYBACK_FILES_PER_CHAN;
+    UtAssert_INT32_EQ(CF_Ckpt_Resume(&rec, OS_OBJECT_ID_UNDEFINED), CF_ERROR);
+    chan->num_cmd_tx = 0;
+
+    /* a sender, which takes its sequence number past the checkpointed one */
+    rec.crc.working = 0x1234;
+    UtAssert_INT32_EQ(CF_Ckpt_Resume(&rec, OS_OBJECT_ID_UNDEFINED), CFE_SUCCESS);
+    UtAssert_INT32_EQ(txn.state, CF_TxnState_S2);
+    UtAssert_UINT32_EQ(txn.state_data.send.sub_state, CF_TxSubState_METADATA);
+    UtAssert_UINT32_EQ(txn.crc.working, 0x1234);
+    UtAssert_BOOL_TRUE(txn.flags.tx.cmd_tx);
+    UtAssert_BOOL_TRUE(txn.flags.com.checkpointed);
+    UtAssert_UINT32_EQ(chan->num_cmd_tx, 1);
+    UtAssert_UINT32_EQ(CF_AppData.engine.seq_num, 5);
+    UtAssert_STUB_COUNT(CF_InsertSortPrio, 1);
+    UtAssert_STRINGBUF_EQ(txn.history->fnames.src_filename, sizeof(txn.history->fnames.src_filename), "/cf/src",
+                          sizeof("/cf/src"));
+    UT_CF_AssertEventID(CF_CKPT_RESUME_INF_EID);
+
+    /* a receiver whose file cannot be opened */
+    UT_CF_Ckpt_SetupRecord(&rec, CF_TxnState_R2);
+    UT_CF_Ckpt_SetupResume(&txn, &free_node);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UtAssert_INT32_EQ(CF_Ckpt_Resume(&rec, OS_OBJECT_ID_UNDEFINED), CF_ERROR);
+
+    /* a receiver with more chunks than fit, the chunk list and file are given back */
+    rec.num_chunks = 5;
+    UtAssert_INT32_EQ(CF_Ckpt_Resume(&rec, OS_OBJECT_ID_UNDEFINED), CF_ERROR);
+    UtAssert_STUB_COUNT(CF_CList_InsertBack, 1);
+
+    /* a receiver, which asks for what is missing */
+    rec.num_chunks = 2;
+    rec.eof_recv   = true;
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedRead), UT_AltHandler_CF_WrappedRead_All, NULL);
+    UtAssert_INT32_EQ(CF_Ckpt_Resume(&rec, OS_OBJECT_ID_UNDEFINED), CFE_SUCCESS);
+    UtAssert_INT32_EQ(txn.state, CF_TxnState_R2);
+    UtAssert_UINT32_EQ(txn.chunks->chunks.count, 2);
+    UtAssert_BOOL_TRUE(txn.flags.rx.md_recv);
+    UtAssert_BOOL_TRUE(txn.flags.rx.eof_recv);
+    UtAssert_UINT32_EQ(txn.flags.com.q_index, CF_QueueIdx_RX);
+    UtAssert_STUB_COUNT(CF_CFDP_ArmAckTimer, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_R2_Complete, 1);
+
+    /* no room for another receiver */
+    CF_AppData.hk.Payload.channel_hk[0].q_size[CF_QueueIdx_RX] = CF_MAX_SIMULTANEOUS_RX;
+    UtAssert_INT32_EQ(CF_Ckpt_Resume(&rec, OS_OBJECT_ID_UNDEFINED), CF_ERROR);
+}
+
+void Test_CF_Ckpt_GetPartialFilename(void)
+{
+    /* Test case for:
+     * void CF_Ckpt_GetPartialFilename(char *buf, size_t buf_size, CF_EntityId_t src_eid, const char *dst_filename,
+     *                                 const char *ext);
+     */
+    char buf[OS_MAX_PATH_LEN];
+    char expected[OS_MAX_PATH_LEN];
+
+    /* the CRC is a stub, so the name hash is 0 */
+    snprintf(expected, sizeof(expected), "%s/p7_00000000.prt", CF_CHECKPOINT_DIR);
+    UtAssert_VOIDCALL(CF_Ckpt_GetPartialFilename(buf, sizeof(buf), 7, "/cf/dst", CF_CKPT_PARTIAL_EXT));
+    UtAssert_STRINGBUF_EQ(buf, sizeof(buf), expected, sizeof(expected));
+    UtAssert_STUB_COUNT(CF_CRC_Digest, 1);
+}
+
+void Test_CF_Ckpt_RetainPartial(void)
+{
+    /* Test case for:
+     * bool CF_Ckpt_RetainPartial(CF_Transaction_t *txn);
+     */
+    CF_Transaction_t *txn = UT_CF_Ckpt_SetupTxn(0, CF_TxnState_R2);
+
+    memset(&UT_CF_Ckpt_Config, 0, sizeof(UT_CF_Ckpt_Config));
+    CF_AppData.config_table = &UT_CF_Ckpt_Config;
+
+    txn->flags.rx.md_recv     = true;
+    txn->chunks->chunks.count = 1;
+    txn->history->txn_stat    = CF_TxnStatus_CANCEL_REQUEST_RECEIVED;
+    txn->fsize                = 100;
+    strcpy(txn->history->fnames.dst_filename, "/cf/dst");
+
+    /* not enabled on the channel */
+    UtAssert_BOOL_FALSE(CF_Ckpt_RetainPartial(txn));
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+
+    /* the data failed its checksum */
+    UT_CF_Ckpt_Config.chan[0].rx_retain_partial = 1;
+    txn->history->txn_stat                      = CF_TxnStatus_FILE_CHECKSUM_FAILURE;
+    UtAssert_BOOL_FALSE(CF_Ckpt_RetainPartial(txn));
+
+    /* nothing received yet */
+    txn->history->txn_stat    = CF_TxnStatus_INACTIVITY_DETECTED;
+    txn->chunks->chunks.count = 0;
+    UtAssert_BOOL_FALSE(CF_Ckpt_RetainPartial(txn));
+
+    /* never got its metadata */
+    txn->chunks->chunks.count = 1;
+    txn->flags.rx.md_recv     = false;
+    UtAssert_BOOL_FALSE(CF_Ckpt_RetainPartial(txn));
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+
+    /* compressed file data */
+    txn->flags.rx.md_recv     = true;
+    txn->flags.com.compressed = true;
+    UtAssert_BOOL_FALSE(CF_Ckpt_RetainPartial(txn));
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+    txn->flags.com.compressed = false;
+
+    /* a delta */
+    txn->flags.com.delta = true;
+    UtAssert_BOOL_FALSE(CF_Ckpt_RetainPartial(txn));
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+    txn->flags.com.delta = false;
+
+    /* a bundle */
+    txn->flags.com.bundle = true;
+    UtAssert_BOOL_FALSE(CF_Ckpt_RetainPartial(txn));
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+    txn->flags.com.bundle = false;
+
+    /* an unbounded size */
+    txn->fsize = 0;
+    UtAssert_BOOL_FALSE(CF_Ckpt_RetainPartial(txn));
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+    txn->fsize = 100;
+
+    /* the record cannot be written */
+    txn->flags.rx.md_recv = true;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UtAssert_BOOL_FALSE(CF_Ckpt_RetainPartial(txn));
+    UT_CF_AssertEventID(CF_CKPT_WRITE_ERR_EID);
+
+    /* kept */
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedWrite), UT_AltHandler_CF_WrappedWrite_All, NULL);
+    UtAssert_BOOL_TRUE(CF_Ckpt_RetainPartial(txn));
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 2);
+    UtAssert_STUB_COUNT(CF_WrappedRename, 1);
+
+    /* a sender never keeps a partial file */
+    txn->state = CF_TxnState_S2;
+    UtAssert_BOOL_FALSE(CF_Ckpt_RetainPartial(txn));
+}
+
+void Test_CF_Ckpt_ClaimPartial(void)
+{
+    /* Test case for:
+     * bool CF_Ckpt_ClaimPartial(CF_Transaction_t *txn);
+     */
+    CF_Transaction_t *txn = UT_CF_Ckpt_SetupTxn(0, CF_TxnState_R2);
+    CF_CkptRecord_t   rec;
+
+    memset(&UT_CF_Ckpt_Config, 0, sizeof(UT_CF_Ckpt_Config));
+    CF_AppData.config_table = &UT_CF_Ckpt_Config;
+
+    UT_CF_Ckpt_SetupRecord(&rec, CF_TxnState_R2);
+    rec.num_chunks = 2;
+    strcpy(txn->history->fnames.dst_filename, "/cf/dst");
+    txn->fsize = 100;
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedRead), UT_AltHandler_CF_WrappedRead_Record, &rec);
+
+    /* not enabled on the channel */
+    UtAssert_BOOL_FALSE(CF_Ckpt_ClaimPartial(txn));
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+
+    /* compressed file data never resumes a partial file */
+    UT_CF_Ckpt_Config.chan[0].rx_retain_partial = 1;
+    txn->flags.com.compressed                   = true;
+    UtAssert_BOOL_FALSE(CF_Ckpt_ClaimPartial(txn));
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+    txn->flags.com.compressed = false;
+
+    /* nor does a delta */
+    txn->flags.com.delta = true;
+    UtAssert_BOOL_FALSE(CF_Ckpt_ClaimPartial(txn));
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+    txn->flags.com.delta = false;
+
+    /* nor does a bundle */
+    txn->flags.com.bundle = true;
+    UtAssert_BOOL_FALSE(CF_Ckpt_ClaimPartial(txn));
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+    txn->flags.com.bundle = false;
+
+    /* nor an unbounded size */
+    txn->fsize = 0;
+    UtAssert_BOOL_FALSE(CF_Ckpt_ClaimPartial(txn));
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+    txn->fsize = 100;
+
+    /* no record */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UtAssert_BOOL_FALSE(CF_Ckpt_ClaimPartial(txn));
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 0);
+
+    /* a record for a file of another size is removed */
+    txn->fsize = 200;
+    UtAssert_BOOL_FALSE(CF_Ckpt_ClaimPartial(txn));
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 2);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 1);
+
+    /* the destination file has gone */
+    txn->fsize = 100;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 2, -1);
+    UtAssert_BOOL_FALSE(CF_Ckpt_ClaimPartial(txn));
+    UtAssert_UINT32_EQ(txn->chunks->chunks.count, 0);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 2);
+
+    /* picked up, and the missing ranges are NAK'd */
+    UtAssert_BOOL_TRUE(CF_Ckpt_ClaimPartial(txn));
+    UtAssert_UINT32_EQ(txn->chunks->chunks.count, 2);
+    UtAssert_BOOL_TRUE(txn->flags.rx.partial);
+    UtAssert_BOOL_TRUE(txn->flags.rx.send_nak);
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 3);
+    UT_CF_AssertEventID(CF_CKPT_PARTIAL_INF_EID);
+}
+
+void Test_CF_Ckpt_DropPartial(void)
+{
+    /* Test case for:
+     * void CF_Ckpt_DropPartial(CF_Transaction_t *txn);
+     */
+    CF_Transaction_t *txn = UT_CF_Ckpt_SetupTxn(0, CF_TxnState_R2);
+
+    memset(&UT_CF_Ckpt_Config, 0, sizeof(UT_CF_Ckpt_Config));
+    CF_AppData.config_table = &UT_CF_Ckpt_Config;
+
+    UtAssert_VOIDCALL(CF_Ckpt_DropPartial(txn));
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 0);
+
+    UT_CF_Ckpt_Config.chan[0].rx_retain_partial = 1;
+    UtAssert_VOIDCALL(CF_Ckpt_DropPartial(txn));
+    UtAssert_STUB_COUNT(CF_WrappedRemove, 1);
+}
+
+/*******************************************************************************
+**
+**  cf_ckpt_tests UtTest_Setup
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    TEST_CF_ADD(Test_CF_Ckpt_GetFilename);
+    TEST_CF_ADD(Test_CF_Ckpt_Write);
+    TEST_CF_ADD(Test_CF_Ckpt_Remove);
+    TEST_CF_ADD(Test_CF_Ckpt_Cycle);
+    TEST_CF_ADD(Test_CF_Ckpt_Restore);
+    TEST_CF_ADD(Test_CF_Ckpt_Load);
+    TEST_CF_ADD(Test_CF_Ckpt_Resume);
+    TEST_CF_ADD(Test_CF_Ckpt_GetPartialFilename);
+    TEST_CF_ADD(Test_CF_Ckpt_RetainPartial);
+    TEST_CF_ADD(Test_CF_Ckpt_ClaimPartial);
+    TEST_CF_ADD(Test_CF_Ckpt_DropPartial);
+}
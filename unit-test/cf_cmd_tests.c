@@ -20,6 +20,9 @@
 /* cf testing includes */
 #include "cf_test_utils.h"
 #include "cf_cmd.h"
+#include "cf_instr.h"
+#include "cf_trace.h"
+#include "cf_evagg.h"
 #include "cf_events.h"
 #include "cf_test_alt_handler.h"
 
@@ -148,7 +151,7 @@ void Test_CF_NoopCmd_SendNoopEventAndAcceptCommand(void)
 **
 *******************************************************************************/
 
-void Test_CF_ResetCountersCmd_tests_WhenCommandByteIsEqTo_5_SendEventAndRejectCommand(void)
+void Test_CF_ResetCountersCmd_tests_WhenCommandByteIsEqTo_6_SendEventAndRejectCommand(void)
 {
     /* Arrange */
     CF_ResetCountersCmd_t   utbuf;
@@ -157,7 +160,7 @@ void Test_CF_ResetCountersCmd_tests_WhenCommandByteIsEqTo_5_SendEventAndRejectCo
 
     memset(&utbuf, 0, sizeof(utbuf));
 
-    data->byte[0] = 5; /* 5 is size of 'names' */
+    data->byte[0] = 6; /* 6 is size of 'names' */
 
     CF_AppData.hk.Payload.counters.err = initial_hk_err_counter;
 
@@ -171,7 +174,7 @@ void Test_CF_ResetCountersCmd_tests_WhenCommandByteIsEqTo_5_SendEventAndRejectCo
     UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, (initial_hk_err_counter + 1) & 0xFFFF);
 }
 
-void Test_CF_ResetCountersCmd_tests_WhenCommandByteIsGreaterThan_5_SendEventAndRejectCommand(void)
+void Test_CF_ResetCountersCmd_tests_WhenCommandByteIsGreaterThan_6_SendEventAndRejectCommand(void)
 {
     /* Arrange */
     CF_ResetCountersCmd_t   utbuf;
@@ -180,7 +183,7 @@ void Test_CF_ResetCountersCmd_tests_WhenCommandByteIsGreaterThan_5_SendEventAndR
 
     memset(&utbuf, 0, sizeof(utbuf));
 
-    data->byte[0] = Any_uint8_GreaterThan(5); /* 5 is size of 'names' */
+    data->byte[0] = Any_uint8_GreaterThan(6); /* 6 is size of 'names' */
 
     CF_AppData.hk.Payload.counters.err = initial_hk_err_counter;
 
@@ -293,6 +296,8 @@ void Test_CF_ResetCountersCmd_tests_WhenCommandByteIs_up_AndResetAllHkRecvCountS
         CF_AppData.hk.Payload.channel_hk[i].counters.recv.spurious             = Any_uint16_Except(0);
         CF_AppData.hk.Payload.channel_hk[i].counters.recv.dropped              = Any_uint16_Except(0);
         CF_AppData.hk.Payload.channel_hk[i].counters.recv.nak_segment_requests = Any_uint32_Except(0);
+        CF_AppData.hk.Payload.channel_hk[i].rx_pipe_high_water                 = Any_uint16_Except(0);
+        CF_AppData.hk.Payload.channel_hk[i].rx_pipe_full                       = Any_uint16_Except(0);
     }
 
     CF_AppData.hk.Payload.counters.cmd = initial_hk_cmd_counter;
@@ -306,6 +311,8 @@ void Test_CF_ResetCountersCmd_tests_WhenCommandByteIs_up_AndResetAllHkRecvCountS
 
     for (i = 0; i < CF_NUM_CHANNELS; ++i)
     {
+        UtAssert_ZERO(CF_AppData.hk.Payload.channel_hk[i].rx_pipe_high_water);
+        UtAssert_ZERO(CF_AppData.hk.Payload.channel_hk[i].rx_pipe_full);
         UtAssert_ZERO(CF_AppData.hk.Payload.channel_hk[i].counters.recv.file_data_bytes);
         UtAssert_ZERO(CF_AppData.hk.Payload.channel_hk[i].counters.recv.pdu);
         UtAssert_ZERO(CF_AppData.hk.Payload.channel_hk[i].counters.recv.error);
@@ -407,12 +414,19 @@ void Test_CF_ResetCountersCmd_tests_WhenCommandByteIs_all_AndResetAllMemValuesSe
         CF_AppData.hk.Payload.channel_hk[i].counters.sent.pdu                  = Any_uint32_Except(0);
     }
 
+    CF_AppData.hk.Payload.cycle.count    = Any_uint32_Except(0);
+    CF_AppData.hk.Payload.cycle.max_usec = Any_uint32_Except(0);
+    CF_AppData.hk.Payload.cycle.overruns = Any_uint32_Except(0);
+
     /* Act */
     CF_ResetCountersCmd(&utbuf);
 
     /* Assert */
     UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 1);
     UT_CF_AssertEventID(CF_RESET_INF_EID);
+    UtAssert_MemCmpValue(&CF_AppData.hk.Payload.cycle, 0, sizeof(CF_AppData.hk.Payload.cycle),
+                         "cycle timing was completely cleared to 0");
+    UtAssert_STUB_COUNT(CF_Instr_Reset, 1);
 
     UtAssert_ZERO(CF_AppData.hk.Payload.counters.cmd);
     UtAssert_ZERO(CF_AppData.hk.Payload.counters.err);
@@ -436,6 +450,32 @@ void Test_CF_ResetCountersCmd_tests_WhenCommandByteIs_all_AndResetAllMemValuesSe
     }
 }
 
+void Test_CF_ResetCountersCmd_tests_WhenCommandByteIs_diag_ResetHistogramsSendEventAndAcceptCommand(void)
+{
+    /* Arrange */
+    CF_ResetCountersCmd_t   utbuf;
+    CF_UnionArgs_Payload_t *data                   = &utbuf.Payload;
+    uint16                  initial_hk_cmd_counter = Any_uint16();
+
+    memset(&utbuf, 0, sizeof(utbuf));
+
+    data->byte[0] = CF_Reset_diag;
+
+    CF_AppData.hk.Payload.counters.cmd = initial_hk_cmd_counter;
+    CF_AppData.hk.Payload.cycle.count  = Any_uint32_Except(0);
+
+    /* Act */
+    CF_ResetCountersCmd(&utbuf);
+
+    /* Assert */
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 1);
+    UT_CF_AssertEventID(CF_RESET_INF_EID);
+    UtAssert_STUB_COUNT(CF_Instr_Reset, 1);
+    UtAssert_NONZERO(CF_AppData.hk.Payload.cycle.count);
+    /* Assert to show counter incremented */
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.cmd, (initial_hk_cmd_counter + 1) & 0xFFFF);
+}
+
 /*******************************************************************************
 **
 **  CF_TxFileCmd tests
@@ -447,8 +487,9 @@ void Test_CF_TxFileCmd(void)
     /* Test case for:
      * void CF_TxFileCmd(CFE_SB_Buffer_t *msg);
      */
-    CF_TxFileCmd_t       utbuf;
-    CF_TxFile_Payload_t *msg = &utbuf.Payload;
+    CF_TxFileCmd_t           utbuf;
+    CF_TxFile_Payload_t *    msg = &utbuf.Payload;
+    CF_CFDP_TxFile_context_t ctxt;
 
     memset(&CF_AppData.hk.Payload.counters, 0, sizeof(CF_AppData.hk.Payload.counters));
 
@@ -499,13 +540,167 @@ void Test_CF_TxFileCmd(void)
     UT_CF_AssertEventID(CF_CMD_BAD_PARAM_ERR_EID);
     UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, 4);
 
+    /* out of range arguments: bad compress */
+    UT_CF_ResetEventCapture();
+    memset(msg, 0, sizeof(*msg));
+    msg->compress = CF_TxCompress_NUM;
+    UtAssert_VOIDCALL(CF_TxFileCmd(&utbuf));
+    UT_CF_AssertEventID(CF_CMD_BAD_PARAM_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, 5);
+
+    /* the compress option is passed on */
+    memset(msg, 0, sizeof(*msg));
+    memset(&ctxt, 0, sizeof(ctxt));
+    msg->compress = CF_TxCompress_OFF;
+    UT_SetDataBuffer(UT_KEY(CF_CFDP_TxFile), &ctxt, sizeof(ctxt), false);
+    UtAssert_VOIDCALL(CF_TxFileCmd(&utbuf));
+    UtAssert_UINT32_EQ(ctxt.compress, CF_TxCompress_OFF);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.cmd, 3);
+    UT_ResetState(UT_KEY(CF_CFDP_TxFile));
+
     /* CF_CFDP_TxFile fails*/
     UT_CF_ResetEventCapture();
     UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_TxFile), -1);
     memset(msg, 0, sizeof(*msg));
     UtAssert_VOIDCALL(CF_TxFileCmd(&utbuf));
     UT_CF_AssertEventID(CF_CMD_TX_FILE_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, 6);
+}
+
+/*******************************************************************************
+**
+**  CF_TxFileMultiCmd tests
+**
+*******************************************************************************/
+
+void Test_CF_TxFileMultiCmd(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_TxFileMultiCmd(const CF_TxFileMultiCmd_t *msg);
+     */
+    CF_TxFileMultiCmd_t       utbuf;
+    CF_TxFileMulti_Payload_t *msg = &utbuf.Payload;
+
+    memset(&CF_AppData.hk.Payload.counters, 0, sizeof(CF_AppData.hk.Payload.counters));
+
+    /* nominal, two destinations */
+    memset(msg, 0, sizeof(*msg));
+    msg->cfdp_class = CF_CFDP_CLASS_2;
+    msg->num_dest   = 2;
+    UtAssert_INT32_EQ(CF_TxFileMultiCmd(&utbuf), CFE_SUCCESS);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.cmd, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_TxFileMulti, 1);
+    UT_CF_AssertEventID(CF_CMD_TX_FILE_MULTI_INF_EID);
+
+    /* out of range arguments: no destinations */
+    UT_CF_ResetEventCapture();
+    memset(msg, 0, sizeof(*msg));
+    msg->cfdp_class = CF_CFDP_CLASS_1;
+    UtAssert_INT32_EQ(CF_TxFileMultiCmd(&utbuf), CFE_SUCCESS);
+    UT_CF_AssertEventID(CF_CMD_BAD_PARAM_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, 1);
+
+    /* out of range arguments: too many destinations */
+    UT_CF_ResetEventCapture();
+    msg->num_dest = CF_TX_MULTI_MAX_DEST + 1;
+    UtAssert_INT32_EQ(CF_TxFileMultiCmd(&utbuf), CFE_SUCCESS);
+    UT_CF_AssertEventID(CF_CMD_BAD_PARAM_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, 2);
+
+    /* out of range arguments: bad class */
+    UT_CF_ResetEventCapture();
+    memset(msg, 0, sizeof(*msg));
+    msg->num_dest   = 1;
+    msg->cfdp_class = 10;
+    UtAssert_INT32_EQ(CF_TxFileMultiCmd(&utbuf), CFE_SUCCESS);
+    UT_CF_AssertEventID(CF_CMD_BAD_PARAM_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, 3);
+
+    /* out of range arguments: bad channel */
+    UT_CF_ResetEventCapture();
+    memset(msg, 0, sizeof(*msg));
+    msg->num_dest = 1;
+    msg->chan_num = CF_NUM_CHANNELS;
+    UtAssert_INT32_EQ(CF_TxFileMultiCmd(&utbuf), CFE_SUCCESS);
+    UT_CF_AssertEventID(CF_CMD_BAD_PARAM_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, 4);
+
+    /* out of range arguments: bad keep */
+    UT_CF_ResetEventCapture();
+    memset(msg, 0, sizeof(*msg));
+    msg->num_dest = 1;
+    msg->keep     = 15;
+    UtAssert_INT32_EQ(CF_TxFileMultiCmd(&utbuf), CFE_SUCCESS);
+    UT_CF_AssertEventID(CF_CMD_BAD_PARAM_ERR_EID);
     UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, 5);
+    UtAssert_STUB_COUNT(CF_CFDP_TxFileMulti, 1);
+
+    /* CF_CFDP_TxFileMulti fails */
+    UT_CF_ResetEventCapture();
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_TxFileMulti), -1);
+    memset(msg, 0, sizeof(*msg));
+    msg->num_dest = 1;
+    UtAssert_INT32_EQ(CF_TxFileMultiCmd(&utbuf), CFE_SUCCESS);
+    UT_CF_AssertEventID(CF_CMD_TX_FILE_MULTI_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, 6);
+}
+
+/*******************************************************************************
+**
+**  CF_TxFileFollowCmd tests
+**
+*******************************************************************************/
+
+void Test_CF_TxFileFollowCmd(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_TxFileFollowCmd(const CF_TxFileFollowCmd_t *msg);
+     */
+    CF_TxFileFollowCmd_t utbuf;
+    CF_TxFile_Payload_t *msg = &utbuf.Payload;
+
+    memset(&CF_AppData.hk.Payload.counters, 0, sizeof(CF_AppData.hk.Payload.counters));
+
+    /* nominal */
+    memset(msg, 0, sizeof(*msg));
+    msg->cfdp_class = CF_CFDP_CLASS_2;
+    UtAssert_INT32_EQ(CF_TxFileFollowCmd(&utbuf), CFE_SUCCESS);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.cmd, 1);
+    UtAssert_STUB_COUNT(CF_CFDP_TxFileFollow, 1);
+    UT_CF_AssertEventID(CF_CMD_TX_FILE_FOLLOW_INF_EID);
+
+    /* out of range arguments: bad class */
+    UT_CF_ResetEventCapture();
+    memset(msg, 0, sizeof(*msg));
+    msg->cfdp_class = 10;
+    UtAssert_INT32_EQ(CF_TxFileFollowCmd(&utbuf), CFE_SUCCESS);
+    UT_CF_AssertEventID(CF_CMD_BAD_PARAM_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, 1);
+
+    /* out of range arguments: bad channel */
+    UT_CF_ResetEventCapture();
+    memset(msg, 0, sizeof(*msg));
+    msg->chan_num = CF_NUM_CHANNELS;
+    UtAssert_INT32_EQ(CF_TxFileFollowCmd(&utbuf), CFE_SUCCESS);
+    UT_CF_AssertEventID(CF_CMD_BAD_PARAM_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, 2);
+
+    /* out of range arguments: bad keep */
+    UT_CF_ResetEventCapture();
+    memset(msg, 0, sizeof(*msg));
+    msg->keep = 15;
+    UtAssert_INT32_EQ(CF_TxFileFollowCmd(&utbuf), CFE_SUCCESS);
+    UT_CF_AssertEventID(CF_CMD_BAD_PARAM_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, 3);
+    UtAssert_STUB_COUNT(CF_CFDP_TxFileFollow, 1);
+
+    /* CF_CFDP_TxFileFollow fails */
+    UT_CF_ResetEventCapture();
+    UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_TxFileFollow), -1);
+    memset(msg, 0, sizeof(*msg));
+    UtAssert_INT32_EQ(CF_TxFileFollowCmd(&utbuf), CFE_SUCCESS);
+    UT_CF_AssertEventID(CF_CMD_TX_FILE_FOLLOW_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, 4);
 }
 
 /*******************************************************************************
@@ -519,8 +714,9 @@ void Test_CF_PlaybackDirCmd(void)
     /* Test case for:
      * void CF_PlaybackDirCmd(CFE_SB_Buffer_t *msg);
      */
-    CF_PlaybackDirCmd_t  utbuf;
-    CF_TxFile_Payload_t *msg = &utbuf.Payload;
+    CF_PlaybackDirCmd_t           utbuf;
+    CF_TxFile_Payload_t *         msg = &utbuf.Payload;
+    CF_CFDP_PlaybackDir_context_t ctxt;
 
     memset(&CF_AppData.hk.Payload.counters, 0, sizeof(CF_AppData.hk.Payload.counters));
 
@@ -565,13 +761,43 @@ void Test_CF_PlaybackDirCmd(void)
     UT_CF_AssertEventID(CF_CMD_BAD_PARAM_ERR_EID);
     UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, 4);
 
+    /* out of range arguments: an order that does not exist */
+    UT_CF_ResetEventCapture();
+    memset(msg, 0, sizeof(*msg));
+    msg->order = CF_PlaybackOrder_NUM;
+    UtAssert_VOIDCALL(CF_PlaybackDirCmd(&utbuf));
+    UT_CF_AssertEventID(CF_CMD_BAD_PARAM_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, 5);
+
+    /* out of range arguments: bad compress */
+    UT_CF_ResetEventCapture();
+    memset(msg, 0, sizeof(*msg));
+    msg->compress = CF_TxCompress_NUM;
+    UtAssert_VOIDCALL(CF_PlaybackDirCmd(&utbuf));
+    UT_CF_AssertEventID(CF_CMD_BAD_PARAM_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, 6);
+
+    /* more files at once than are set aside, the order and the compress option are passed on */
+    memset(msg, 0, sizeof(*msg));
+    memset(&ctxt, 0, sizeof(ctxt));
+    msg->max_ts   = CF_NUM_TRANSACTIONS_PER_PLAYBACK + 1;
+    msg->order    = CF_PlaybackOrder_SMALLEST;
+    msg->compress = CF_TxCompress_ON;
+    UT_SetDataBuffer(UT_KEY(CF_CFDP_PlaybackDir), &ctxt, sizeof(ctxt), false);
+    UtAssert_VOIDCALL(CF_PlaybackDirCmd(&utbuf));
+    UtAssert_UINT32_EQ(ctxt.max_ts, CF_NUM_TRANSACTIONS_PER_PLAYBACK + 1);
+    UtAssert_UINT32_EQ(ctxt.order, CF_PlaybackOrder_SMALLEST);
+    UtAssert_UINT32_EQ(ctxt.compress, CF_TxCompress_ON);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.cmd, 3);
+    UT_ResetState(UT_KEY(CF_CFDP_PlaybackDir));
+
     /* CF_CFDP_PlaybackDir fails*/
     UT_CF_ResetEventCapture();
     UT_SetDefaultReturnValue(UT_KEY(CF_CFDP_PlaybackDir), -1);
     memset(msg, 0, sizeof(*msg));
     UtAssert_VOIDCALL(CF_PlaybackDirCmd(&utbuf));
     UT_CF_AssertEventID(CF_CMD_PLAYBACK_DIR_ERR_EID);
-    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, 5);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, 7);
 }
 
 /*******************************************************************************
@@ -3294,6 +3520,56 @@ void Test_CF_WriteQueueCmd_Success_type_DownAnd_q_Pend(void)
     UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.cmd, (initial_hk_cmd_counter + 1) & 0xFFFF);
 }
 
+/*******************************************************************************
+**
+**  CF_WriteTraceCmd tests
+**
+*******************************************************************************/
+
+void Test_CF_WriteTraceCmd_Success(void)
+{
+    /* Arrange */
+    CF_WriteTraceCmd_t utbuf;
+    uint16             initial_hk_cmd_counter = Any_uint16();
+
+    memset(&utbuf, 0, sizeof(utbuf));
+    strncpy(utbuf.Payload.filename, "/cf/trace.bin", sizeof(utbuf.Payload.filename) - 1);
+
+    CF_AppData.hk.Payload.counters.cmd = initial_hk_cmd_counter;
+
+    /* Act */
+    CF_WriteTraceCmd(&utbuf);
+
+    /* Assert */
+    UtAssert_STUB_COUNT(CF_Trace_StartDump, 1);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 1);
+    UT_CF_AssertEventID(CF_CMD_WRITE_TRACE_INF_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.cmd, (initial_hk_cmd_counter + 1) & 0xFFFF);
+}
+
+void Test_CF_WriteTraceCmd_WhenStartDumpFails_SendEventAndRejectCommand(void)
+{
+    /* Arrange */
+    CF_WriteTraceCmd_t utbuf;
+    uint16             initial_hk_err_counter = Any_uint16();
+
+    memset(&utbuf, 0, sizeof(utbuf));
+    strncpy(utbuf.Payload.filename, "/cf/trace.bin", sizeof(utbuf.Payload.filename) - 1);
+
+    UT_SetDefaultReturnValue(UT_KEY(CF_Trace_StartDump), CF_ERROR);
+
+    CF_AppData.hk.Payload.counters.err = initial_hk_err_counter;
+
+    /* Act */
+    CF_WriteTraceCmd(&utbuf);
+
+    /* Assert */
+    UtAssert_STUB_COUNT(CF_Trace_StartDump, 1);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 1);
+    UT_CF_AssertEventID(CF_CMD_WRITE_TRACE_ERR_EID);
+    UtAssert_UINT32_EQ(CF_AppData.hk.Payload.counters.err, (initial_hk_err_counter + 1) & 0xFFFF);
+}
+
 /*******************************************************************************
 **
 **  CF_ValidateChunkSizeCmd tests
@@ -3455,6 +3731,7 @@ void Test_CF_GetSetParamCmd(void)
     UtAssert_UINT32_EQ(ut_config_table.chan[UT_CFDP_CHANNEL].nak_limit, 8);
     UtAssert_UINT32_EQ(ut_config_table.local_eid, 9);
     UtAssert_UINT32_EQ(ut_config_table.chan[UT_CFDP_CHANNEL].max_outgoing_messages_per_wakeup, 10);
+    UtAssert_UINT32_EQ(ut_config_table.cycle_max_usec, 11);
 
     /* Nominal: "get" for each parameter */
     for (param_id = 0; param_id < CF_GetSet_ValueID_MAX; ++param_id)
@@ -3704,6 +3981,7 @@ void Test_CF_SendHkCmd(void)
     /* Assert */
     UtAssert_STUB_COUNT(CFE_SB_TimeStampMsg, 1);
     UtAssert_STUB_COUNT(CFE_SB_TransmitMsg, 1);
+    UtAssert_STUB_COUNT(CF_Instr_SendDiag, 1);
 }
 
 /*******************************************************************************
@@ -3722,6 +4000,8 @@ void Test_CF_WakeupCmd(void)
 
     /* Assert */
     UtAssert_STUB_COUNT(CF_CFDP_CycleEngine, 1);
+    UtAssert_STUB_COUNT(CF_Trace_DumpCycle, 1);
+    UtAssert_STUB_COUNT(CF_EvAgg_Tick, 1);
 }
 
 /*******************************************************************************
@@ -3738,12 +4018,12 @@ void add_CF_NoopCmd_tests(void)
 
 void add_CF_ResetCountersCmd_tests(void)
 {
-    UtTest_Add(Test_CF_ResetCountersCmd_tests_WhenCommandByteIsEqTo_5_SendEventAndRejectCommand, cf_cmd_tests_Setup,
+    UtTest_Add(Test_CF_ResetCountersCmd_tests_WhenCommandByteIsEqTo_6_SendEventAndRejectCommand, cf_cmd_tests_Setup,
                cf_cmd_tests_Teardown,
-               "Test_CF_ResetCountersCmd_tests_WhenCommandByteIsEqTo_5_SendEventAndRejectCommand");
-    UtTest_Add(Test_CF_ResetCountersCmd_tests_WhenCommandByteIsGreaterThan_5_SendEventAndRejectCommand,
+               "Test_CF_ResetCountersCmd_tests_WhenCommandByteIsEqTo_6_SendEventAndRejectCommand");
+    UtTest_Add(Test_CF_ResetCountersCmd_tests_WhenCommandByteIsGreaterThan_6_SendEventAndRejectCommand,
                cf_cmd_tests_Setup, cf_cmd_tests_Teardown,
-               "Test_CF_ResetCountersCmd_tests_WhenCommandByteIsGreaterThan_5_SendEventAndRejectCommand");
+               "Test_CF_ResetCountersCmd_tests_WhenCommandByteIsGreaterThan_6_SendEventAndRejectCommand");
     UtTest_Add(Test_CF_ResetCountersCmd_tests_WhenCommandByteIs_command_AndResetHkCmdAndErrCountSendEvent,
                cf_cmd_tests_Setup, cf_cmd_tests_Teardown,
                "Test_CF_ResetCountersCmd_tests_WhenCommandByteIs_command_AndResetHkCmdAndErrCountSendEvent");
@@ -3759,6 +4039,9 @@ void add_CF_ResetCountersCmd_tests(void)
     UtTest_Add(Test_CF_ResetCountersCmd_tests_WhenCommandByteIs_all_AndResetAllMemValuesSendEvent, cf_cmd_tests_Setup,
                cf_cmd_tests_Teardown,
                "Test_CF_ResetCountersCmd_tests_WhenCommandByteIs_all_AndResetAllMemValuesSendEvent");
+    UtTest_Add(Test_CF_ResetCountersCmd_tests_WhenCommandByteIs_diag_ResetHistogramsSendEventAndAcceptCommand,
+               cf_cmd_tests_Setup, cf_cmd_tests_Teardown,
+               "Test_CF_ResetCountersCmd_tests_WhenCommandByteIs_diag_ResetHistogramsSendEventAndAcceptCommand");
 }
 
 void add_CF_TxFileCmd_tests(void)
@@ -3766,6 +4049,16 @@ void add_CF_TxFileCmd_tests(void)
     UtTest_Add(Test_CF_TxFileCmd, cf_cmd_tests_Setup, cf_cmd_tests_Teardown, "CF_TxFileCmd");
 }
 
+void add_CF_TxFileMultiCmd_tests(void)
+{
+    UtTest_Add(Test_CF_TxFileMultiCmd, cf_cmd_tests_Setup, cf_cmd_tests_Teardown, "CF_TxFileMultiCmd");
+}
+
+void add_CF_TxFileFollowCmd_tests(void)
+{
+    UtTest_Add(Test_CF_TxFileFollowCmd, cf_cmd_tests_Setup, cf_cmd_tests_Teardown, "CF_TxFileFollowCmd");
+}
+
 void add_CF_PlaybackDirCmd_tests(void)
 {
     UtTest_Add(Test_CF_PlaybackDirCmd, cf_cmd_tests_Setup, cf_cmd_tests_Teardown, "CF_PlaybackDirCmd");
@@ -4054,6 +4347,14 @@ void add_CF_WriteQueueCmd_tests(void)
                "Test_CF_WriteQueueCmd_Success_type_DownAnd_q_Pend");
 }
 
+void add_CF_WriteTraceCmd_tests(void)
+{
+    UtTest_Add(Test_CF_WriteTraceCmd_Success, cf_cmd_tests_Setup, cf_cmd_tests_Teardown,
+               "Test_CF_WriteTraceCmd_Success");
+    UtTest_Add(Test_CF_WriteTraceCmd_WhenStartDumpFails_SendEventAndRejectCommand, cf_cmd_tests_Setup,
+               cf_cmd_tests_Teardown, "Test_CF_WriteTraceCmd_WhenStartDumpFails_SendEventAndRejectCommand");
+}
+
 void add_CF_ValidateChunkSizeCmd_tests(void)
 {
     UtTest_Add(Test_CF_ValidateChunkSizeCmd_val_GreaterThan_pdu_fd_data_t_FailAndReturn_1, cf_cmd_tests_Setup,
@@ -4142,6 +4443,10 @@ void UtTest_Setup(void)
 
     add_CF_TxFileCmd_tests();
 
+    add_CF_TxFileMultiCmd_tests();
+
+    add_CF_TxFileFollowCmd_tests();
+
     add_CF_PlaybackDirCmd_tests();
 
     add_CF_DoChanAction_tests();
@@ -4194,6 +4499,8 @@ void UtTest_Setup(void)
 
     add_CF_WriteQueueCmd_tests();
 
+    add_CF_WriteTraceCmd_tests();
+
     add_CF_ValidateChunkSizeCmd_tests();
 
     add_CF_ValidateMaxOutgoingCmd_tests();
@@ -447,7 +447,8 @@ void Test_CF_CFDP_EncodeMd(void)
     CF_EncoderState_t  state;
     CF_Logical_PduMd_t in;
     uint8              bytes[20];
-    const uint8        expected[] = {0x00, 0x00, 0x00, 0x12, 0x34, 0x03, 's', 'r', 'c', 0x04, 'd', 'e', 's', 't'};
+    const uint8        expected[]     = {0x00, 0x00, 0x00, 0x12, 0x34, 0x03, 's', 'r', 'c', 0x04, 'd', 'e', 's', 't'};
+    const uint8        expected_tlv[] = {0x02, 0x02, 'h', 'i'};
 
     memset(&in, 0, sizeof(in));
     in.size                     = 0x1234;
@@ -472,6 +473,18 @@ void Test_CF_CFDP_EncodeMd(void)
     UtAssert_UINT32_EQ(CF_CODEC_GET_POSITION(&state), sizeof(expected));
     UtAssert_MemCmp(bytes, expected, sizeof(expected), "Encoded Bytes");
     UtAssert_MemCmpValue(bytes + sizeof(expected), 0xEE, sizeof(bytes) - sizeof(expected), "Remainder unchanged");
+
+    /* options follow the file names */
+    in.tlv_list.num_tlv              = 1;
+    in.tlv_list.tlv[0].type          = CF_CFDP_TLV_TYPE_MESSAGE_TO_USER;
+    in.tlv_list.tlv[0].length        = 2;
+    in.tlv_list.tlv[0].data.data_ptr = "hi";
+    UT_CF_SetupEncodeState(&state, bytes, sizeof(bytes));
+    CF_CFDP_EncodeMd(&state, &in);
+    UtAssert_BOOL_TRUE(CF_CODEC_IS_OK(&state));
+    UtAssert_UINT32_EQ(CF_CODEC_GET_POSITION(&state), sizeof(expected) + sizeof(expected_tlv));
+    UtAssert_MemCmp(bytes, expected, sizeof(expected), "Encoded Bytes");
+    UtAssert_MemCmp(bytes + sizeof(expected), expected_tlv, sizeof(expected_tlv), "Encoded TLV");
 }
 
 void Test_CF_CFDP_EncodeFileDataHeader(void)
@@ -663,6 +676,68 @@ void Test_CF_CFDP_EncodeNak(void)
     UtAssert_MemCmpValue(bytes + sizeof(expected), 0xEE, sizeof(bytes) - sizeof(expected), "Remainder unchanged");
 }
 
+void Test_CF_CFDP_EncodePrompt(void)
+{
+    /* Test for:
+     * void CF_CFDP_EncodePrompt(CF_EncoderState_t *state, CF_Logical_PduPrompt_t *plprompt);
+     */
+    CF_EncoderState_t      state;
+    CF_Logical_PduPrompt_t in;
+    uint8                  bytes[4];
+    const uint8            expected[] = {0x80};
+
+    memset(&in, 0, sizeof(in));
+    in.response_required = CF_CFDP_PromptResponse_KEEP_ALIVE;
+
+    /* fill with nonzero bytes so it is evident what was set */
+    memset(bytes, 0xEE, sizeof(bytes));
+
+    /* call w/zero state should be noop */
+    UT_CF_SetupEncodeState(&state, bytes, 0);
+    CF_CFDP_EncodePrompt(&state, &in);
+    UtAssert_BOOL_FALSE(CF_CODEC_IS_OK(&state));
+    UtAssert_MemCmpValue(bytes, 0xEE, sizeof(bytes), "Bytes unchanged");
+
+    /* setup nominal */
+    UT_CF_SetupEncodeState(&state, bytes, sizeof(bytes));
+    CF_CFDP_EncodePrompt(&state, &in);
+    UtAssert_BOOL_TRUE(CF_CODEC_IS_OK(&state));
+    UtAssert_UINT32_EQ(CF_CODEC_GET_POSITION(&state), sizeof(expected));
+    UtAssert_MemCmp(bytes, expected, sizeof(expected), "Encoded Bytes");
+    UtAssert_MemCmpValue(bytes + sizeof(expected), 0xEE, sizeof(bytes) - sizeof(expected), "Remainder unchanged");
+}
+
+void Test_CF_CFDP_EncodeKeepAlive(void)
+{
+    /* Test for:
+     * void CF_CFDP_EncodeKeepAlive(CF_EncoderState_t *state, CF_Logical_PduKeepAlive_t *plka);
+     */
+    CF_EncoderState_t         state;
+    CF_Logical_PduKeepAlive_t in;
+    uint8                     bytes[8];
+    const uint8               expected[] = {0x00, 0x01, 0x02, 0x03};
+
+    memset(&in, 0, sizeof(in));
+    in.progress = 0x010203;
+
+    /* fill with nonzero bytes so it is evident what was set */
+    memset(bytes, 0xEE, sizeof(bytes));
+
+    /* call w/zero state should be noop */
+    UT_CF_SetupEncodeState(&state, bytes, 0);
+    CF_CFDP_EncodeKeepAlive(&state, &in);
+    UtAssert_BOOL_FALSE(CF_CODEC_IS_OK(&state));
+    UtAssert_MemCmpValue(bytes, 0xEE, sizeof(bytes), "Bytes unchanged");
+
+    /* setup nominal */
+    UT_CF_SetupEncodeState(&state, bytes, sizeof(bytes));
+    CF_CFDP_EncodeKeepAlive(&state, &in);
+    UtAssert_BOOL_TRUE(CF_CODEC_IS_OK(&state));
+    UtAssert_UINT32_EQ(CF_CODEC_GET_POSITION(&state), sizeof(expected));
+    UtAssert_MemCmp(bytes, expected, sizeof(expected), "Encoded Bytes");
+    UtAssert_MemCmpValue(bytes + sizeof(expected), 0xEE, sizeof(bytes) - sizeof(expected), "Remainder unchanged");
+}
+
 void Test_CF_CFDP_EncodeCrc(void)
 {
     /* Test for:
@@ -1017,6 +1092,8 @@ void Test_CF_CFDP_DecodeMd(void)
     CF_Logical_PduMd_t out;
     const uint8        bytes[]     = {0x00, 0x00, 0x00, 0x12, 0x34, 0x03, 's', 'r', 'c', 0x04, 'd', 'e', 's', 't'};
     const uint8        bad_input[] = {0x00, 0x00, 0x00, 0x12, 0x34, 0x56, 's', 'r', 'c', 0x04, 'd', 'e', 's', 't'};
+    const uint8        with_tlv[]  = {0x00, 0x00, 0x00, 0x12, 0x34, 0x03, 's', 'r', 'c',
+                                      0x04, 'd',  'e',  's',  't',  0x02, 0x02, 'h', 'i'};
 
     /* fill with nonzero bytes so it is evident what was set */
     memset(&out, 0xEE, sizeof(out));
@@ -1037,6 +1114,17 @@ void Test_CF_CFDP_DecodeMd(void)
     UtAssert_UINT32_EQ(out.source_filename.length, 3);
     UtAssert_ADDRESS_EQ(out.dest_filename.data_ptr, &bytes[10]);
     UtAssert_UINT32_EQ(out.dest_filename.length, 4);
+    UtAssert_ZERO(out.tlv_list.num_tlv);
+
+    /* options follow the file names */
+    UT_CF_SetupDecodeState(&state, with_tlv, sizeof(with_tlv));
+    CF_CFDP_DecodeMd(&state, &out);
+    UtAssert_BOOL_TRUE(CF_CODEC_IS_OK(&state));
+    UtAssert_UINT32_EQ(CF_CODEC_GET_POSITION(&state), sizeof(with_tlv));
+    UtAssert_UINT32_EQ(out.tlv_list.num_tlv, 1);
+    UtAssert_UINT32_EQ(out.tlv_list.tlv[0].type, CF_CFDP_TLV_TYPE_MESSAGE_TO_USER);
+    UtAssert_UINT32_EQ(out.tlv_list.tlv[0].length, 2);
+    UtAssert_ADDRESS_EQ(out.tlv_list.tlv[0].data.data_ptr, &with_tlv[16]);
 
     /* The bad input has a long length that would go beyond the end */
     UT_CF_SetupDecodeState(&state, bad_input, sizeof(bad_input));
@@ -1227,6 +1315,65 @@ void Test_CF_CFDP_DecodeNak(void)
     UtAssert_UINT32_EQ(out.segment_list.segments[1].offset_end, 0x8);
 }
 
+void Test_CF_CFDP_DecodePrompt(void)
+{
+    /* Test for:
+     * void   CF_CFDP_DecodePrompt(CF_DecoderState_t *state, CF_Logical_PduPrompt_t *plprompt);
+     */
+    CF_DecoderState_t      state;
+    CF_Logical_PduPrompt_t out;
+    const uint8            bytes[]  = {0x80};
+    const uint8            nak_in[] = {0x7F};
+
+    /* fill with nonzero bytes so it is evident what was set */
+    memset(&out, 0xEE, sizeof(out));
+
+    /* call w/zero state should be noop */
+    UT_CF_SetupDecodeState(&state, bytes, 0);
+    CF_CFDP_DecodePrompt(&state, &out);
+    UtAssert_BOOL_FALSE(CF_CODEC_IS_OK(&state));
+    UtAssert_MemCmpValue(&out, 0xEE, sizeof(out), "Bytes unchanged");
+
+    /* setup nominal */
+    UT_CF_SetupDecodeState(&state, bytes, sizeof(bytes));
+    CF_CFDP_DecodePrompt(&state, &out);
+    UtAssert_BOOL_TRUE(CF_CODEC_IS_OK(&state));
+    UtAssert_UINT32_EQ(CF_CODEC_GET_POSITION(&state), sizeof(bytes));
+    UtAssert_UINT32_EQ(out.response_required, CF_CFDP_PromptResponse_KEEP_ALIVE);
+
+    /* spare bits are ignored */
+    UT_CF_SetupDecodeState(&state, nak_in, sizeof(nak_in));
+    CF_CFDP_DecodePrompt(&state, &out);
+    UtAssert_BOOL_TRUE(CF_CODEC_IS_OK(&state));
+    UtAssert_UINT32_EQ(out.response_required, CF_CFDP_PromptResponse_NAK);
+}
+
+void Test_CF_CFDP_DecodeKeepAlive(void)
+{
+    /* Test for:
+     * void   CF_CFDP_DecodeKeepAlive(CF_DecoderState_t *state, CF_Logical_PduKeepAlive_t *plka);
+     */
+    CF_DecoderState_t         state;
+    CF_Logical_PduKeepAlive_t out;
+    const uint8               bytes[] = {0x00, 0x01, 0x02, 0x03};
+
+    /* fill with nonzero bytes so it is evident what was set */
+    memset(&out, 0xEE, sizeof(out));
+
+    /* call w/zero state should be noop */
+    UT_CF_SetupDecodeState(&state, bytes, 0);
+    CF_CFDP_DecodeKeepAlive(&state, &out);
+    UtAssert_BOOL_FALSE(CF_CODEC_IS_OK(&state));
+    UtAssert_MemCmpValue(&out, 0xEE, sizeof(out), "Bytes unchanged");
+
+    /* setup nominal */
+    UT_CF_SetupDecodeState(&state, bytes, sizeof(bytes));
+    CF_CFDP_DecodeKeepAlive(&state, &out);
+    UtAssert_BOOL_TRUE(CF_CODEC_IS_OK(&state));
+    UtAssert_UINT32_EQ(CF_CODEC_GET_POSITION(&state), sizeof(bytes));
+    UtAssert_UINT32_EQ(out.progress, 0x010203);
+}
+
 void Test_CF_CFDP_DecodeCrc(void)
 {
     /* Test for:
@@ -1276,6 +1423,8 @@ void Add_CF_Encode_tests(void)
     UtTest_Add(Test_CF_CFDP_EncodeFin, NULL, NULL, "CF_CFDP_EncodeFin");
     UtTest_Add(Test_CF_CFDP_EncodeAck, NULL, NULL, "CF_CFDP_EncodeAck");
     UtTest_Add(Test_CF_CFDP_EncodeNak, NULL, NULL, "CF_CFDP_EncodeNak");
+    UtTest_Add(Test_CF_CFDP_EncodePrompt, NULL, NULL, "CF_CFDP_EncodePrompt");
+    UtTest_Add(Test_CF_CFDP_EncodeKeepAlive, NULL, NULL, "CF_CFDP_EncodeKeepAlive");
     UtTest_Add(Test_CF_CFDP_EncodeCrc, NULL, NULL, "CF_CFDP_EncodeCrc");
 }
 
@@ -1295,6 +1444,8 @@ void Add_CF_Decode_tests(void)
     UtTest_Add(Test_CF_CFDP_DecodeFin, NULL, NULL, "CF_CFDP_DecodeFin");
     UtTest_Add(Test_CF_CFDP_DecodeAck, NULL, NULL, "CF_CFDP_DecodeAck");
     UtTest_Add(Test_CF_CFDP_DecodeNak, NULL, NULL, "CF_CFDP_DecodeNak");
+    UtTest_Add(Test_CF_CFDP_DecodePrompt, NULL, NULL, "CF_CFDP_DecodePrompt");
+    UtTest_Add(Test_CF_CFDP_DecodeKeepAlive, NULL, NULL, "CF_CFDP_DecodeKeepAlive");
     UtTest_Add(Test_CF_CFDP_DecodeCrc, NULL, NULL, "CF_CFDP_DecodeCrc");
 }
 
@@ -0,0 +1,196 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* cf testing includes */
+#include "cf_test_utils.h"
+#include "cf_compress.h"
+
+/*******************************************************************************
+**
+**  cf_compress_tests local utility functions
+**
+*******************************************************************************/
+
+static CF_Compress_t UT_CF_Compress_Work;
+static uint8         UT_CF_Compress_Raw[CF_COMPRESS_BLOCK_SIZE];
+static uint8         UT_CF_Compress_Out[sizeof(UT_CF_Compress_Work.packed)];
+static uint8         UT_CF_Compress_Back[CF_COMPRESS_BLOCK_SIZE];
+
+/* pack a block, check the header matches what was written, and expand it again */
+static uint32 UT_CF_Compress_RoundTrip(uint32 raw_len)
+{
+    uint32 total;
+    uint32 packed_len = 0;
+    uint32 out_len    = 0;
+
+    memset(UT_CF_Compress_Back, 0, sizeof(UT_CF_Compress_Back));
+
+    total = CF_Compress_Pack(&UT_CF_Compress_Work, UT_CF_Compress_Raw, raw_len, UT_CF_Compress_Out);
+    UtAssert_BOOL_TRUE(CF_Compress_ParseHeader(UT_CF_Compress_Out, &packed_len, &out_len));
+    UtAssert_UINT32_EQ(total, CF_COMPRESS_BLOCK_HDR_SIZE + packed_len);
+    UtAssert_UINT32_EQ(out_len, raw_len);
+    UtAssert_BOOL_TRUE(CF_Compress_Unpack(&UT_CF_Compress_Out[CF_COMPRESS_BLOCK_HDR_SIZE], packed_len,
+                                          UT_CF_Compress_Back, raw_len));
+    UtAssert_MemCmp(UT_CF_Compress_Back, UT_CF_Compress_Raw, raw_len, "expanded data");
+
+    return packed_len;
+}
+
+/*******************************************************************************
+**
+**  cf_compress_tests
+**
+*******************************************************************************/
+
+void Test_CF_Compress_Pack(void)
+{
+    /* Test case for:
+     * uint32 CF_Compress_Pack(CF_Compress_t *work, const uint8 *raw, uint32 raw_len, uint8 *out);
+     */
+    uint32 i;
+    uint32 seed = 1;
+
+    /* repeated text shrinks, with literal and match lengths both long enough to need extra bytes */
+    for (i = 0; i < CF_COMPRESS_BLOCK_SIZE; ++i)
+    {
+        UT_CF_Compress_Raw[i] = "housekeeping telemetry "[i % 23];
+    }
+    UtAssert_UINT32_LT(UT_CF_Compress_RoundTrip(CF_COMPRESS_BLOCK_SIZE), CF_COMPRESS_BLOCK_SIZE / 10);
+
+    /* a run of one byte is a match that overlaps itself */
+    memset(UT_CF_Compress_Raw, 0x55, 1000);
+    UtAssert_UINT32_LT(UT_CF_Compress_RoundTrip(1000), 20);
+
+    /* noise does not shrink, so it is stored */
+    for (i = 0; i < CF_COMPRESS_BLOCK_SIZE; ++i)
+    {
+        seed                  = (seed * 1103515245) + 12345;
+        UT_CF_Compress_Raw[i] = seed >> 16;
+    }
+    UtAssert_UINT32_EQ(UT_CF_Compress_RoundTrip(CF_COMPRESS_BLOCK_SIZE), CF_COMPRESS_BLOCK_SIZE);
+    UtAssert_MemCmp(&UT_CF_Compress_Out[CF_COMPRESS_BLOCK_HDR_SIZE], UT_CF_Compress_Raw, CF_COMPRESS_BLOCK_SIZE,
+                    "stored data");
+
+    /* blocks too short to hold a match */
+    UtAssert_UINT32_EQ(UT_CF_Compress_RoundTrip(1), 1);
+    UtAssert_UINT32_EQ(UT_CF_Compress_RoundTrip(12), 12);
+}
+
+void Test_CF_Compress_ParseHeader(void)
+{
+    /* Test case for:
+     * bool CF_Compress_ParseHeader(const uint8 *hdr, uint32 *packed_len, uint32 *raw_len);
+     */
+    uint8  hdr[CF_COMPRESS_BLOCK_HDR_SIZE] = {0x01, 0x02, 0x03, 0x04};
+    uint32 packed_len;
+    uint32 raw_len;
+
+    /* big endian packed then raw length */
+    UtAssert_BOOL_TRUE(CF_Compress_ParseHeader(hdr, &packed_len, &raw_len));
+    UtAssert_UINT32_EQ(packed_len, 0x0102);
+    UtAssert_UINT32_EQ(raw_len, 0x0304);
+
+    /* a stored block */
+    hdr[0] = 0x03;
+    hdr[1] = 0x04;
+    UtAssert_BOOL_TRUE(CF_Compress_ParseHeader(hdr, &packed_len, &raw_len));
+
+    /* packed longer than raw */
+    hdr[1] = 0x05;
+    UtAssert_BOOL_FALSE(CF_Compress_ParseHeader(hdr, &packed_len, &raw_len));
+
+    /* empty */
+    memset(hdr, 0, sizeof(hdr));
+    UtAssert_BOOL_FALSE(CF_Compress_ParseHeader(hdr, &packed_len, &raw_len));
+    hdr[3] = 1;
+    UtAssert_BOOL_FALSE(CF_Compress_ParseHeader(hdr, &packed_len, &raw_len));
+
+    /* more than a block */
+    hdr[1] = 1;
+    hdr[2] = ((CF_COMPRESS_BLOCK_SIZE + 1) >> 8) & 0xff;
+    hdr[3] = (CF_COMPRESS_BLOCK_SIZE + 1) & 0xff;
+    UtAssert_BOOL_FALSE(CF_Compress_ParseHeader(hdr, &packed_len, &raw_len));
+}
+
+void Test_CF_Compress_Unpack(void)
+{
+    /* Test case for:
+     * bool CF_Compress_Unpack(const uint8 *packed, uint32 packed_len, uint8 *raw, uint32 raw_len);
+     */
+    const uint8 long_match[]   = {0x1f, 'a', 0x01, 0x00, 0x05, 0x00};
+    const uint8 long_lit[]     = {0xf0, 0xff};
+    const uint8 over_lit[]     = {0xf0, 0x05};
+    const uint8 short_offset[] = {0x10, 'a', 0x01};
+    const uint8 zero_offset[]  = {0x10, 'a', 0x00, 0x00, 0x00};
+    const uint8 far_offset[]   = {0x10, 'a', 0x02, 0x00, 0x00};
+    const uint8 short_data[]   = {0x10, 'a'};
+    uint8       raw[300];
+
+    /* one literal, then a match of 4 + 15 + 5 that overlaps it */
+    memset(raw, 0, sizeof(raw));
+    UtAssert_BOOL_TRUE(CF_Compress_Unpack(long_match, sizeof(long_match), raw, 25));
+    UtAssert_MemCmpValue(raw, 'a', 25, "expanded run");
+
+    /* the match is longer than the block */
+    UtAssert_BOOL_FALSE(CF_Compress_Unpack(long_match, sizeof(long_match), raw, 20));
+
+    /* length bytes run off the end */
+    UtAssert_BOOL_FALSE(CF_Compress_Unpack(long_lit, sizeof(long_lit), raw, sizeof(raw)));
+
+    /* more literals than there is data */
+    UtAssert_BOOL_FALSE(CF_Compress_Unpack(over_lit, sizeof(over_lit), raw, sizeof(raw)));
+
+    /* offset cut short, zero, or before the start of the block */
+    UtAssert_BOOL_FALSE(CF_Compress_Unpack(short_offset, sizeof(short_offset), raw, sizeof(raw)));
+    UtAssert_BOOL_FALSE(CF_Compress_Unpack(zero_offset, sizeof(zero_offset), raw, sizeof(raw)));
+    UtAssert_BOOL_FALSE(CF_Compress_Unpack(far_offset, sizeof(far_offset), raw, sizeof(raw)));
+
+    /* well formed, but not the size the header gave */
+    UtAssert_BOOL_FALSE(CF_Compress_Unpack(short_data, sizeof(short_data), raw, 10));
+}
+
+void Test_CF_Compress_GetFilename(void)
+{
+    /* Test case for:
+     * void CF_Compress_GetFilename(char *buf, size_t buf_size, CF_EntityId_t src_eid, CF_TransactionSeq_t seq_num);
+     */
+    CF_ConfigTable_t config;
+    char             buf[OS_MAX_PATH_LEN];
+
+    memset(&config, 0, sizeof(config));
+    strncpy(config.tmp_dir, "/cf/tmp", sizeof(config.tmp_dir) - 1);
+    CF_AppData.config_table = &config;
+
+    UtAssert_VOIDCALL(CF_Compress_GetFilename(buf, sizeof(buf), 2, 34));
+    UtAssert_STRINGBUF_EQ(buf, sizeof(buf), "/cf/tmp/2:34.cfz", -1);
+}
+
+/*******************************************************************************
+**
+**  cf_compress_tests UtTest_Setup
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    TEST_CF_ADD(Test_CF_Compress_Pack);
+    TEST_CF_ADD(Test_CF_Compress_ParseHeader);
+    TEST_CF_ADD(Test_CF_Compress_Unpack);
+    TEST_CF_ADD(Test_CF_Compress_GetFilename);
+}
@@ -0,0 +1,234 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* cf testing includes */
+#include "cf_test_utils.h"
+#include "cf_delivered.h"
+#include "cf_events.h"
+
+/*******************************************************************************
+**
+**  cf_delivered_tests local utility functions
+**
+*******************************************************************************/
+
+typedef struct UT_CF_Delivered_Image
+{
+    CF_DeliveredFileHeader_t hdr;
+    CF_DeliveredEntry_t      entries[CF_DELIVERED_INDEX_ENTRIES];
+} UT_CF_Delivered_Image_t;
+
+static UT_CF_Delivered_Image_t UT_CF_Delivered_File;
+
+/* a write of every byte asked for, or of the status code if set */
+static void UT_AltHandler_CF_WrappedWrite_All(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CFE_Status_t retval = (CFE_Status_t)UT_Hook_GetArgValueByName(Context, "write_size", size_t);
+    int32        status_code;
+
+    if (UT_Stub_GetInt32StatusCode(Context, &status_code))
+    {
+        retval = status_code;
+    }
+    UT_Stub_SetReturnValue(FuncKey, retval);
+}
+
+/* a read of the header, then of the entries, of the index file image in UserObj, or of the status code if set */
+static void UT_AltHandler_CF_WrappedRead_Image(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    UT_CF_Delivered_Image_t *image  = UserObj;
+    void *                   buf    = UT_Hook_GetArgValueByName(Context, "buf", void *);
+    CFE_Status_t             retval = (CFE_Status_t)UT_Hook_GetArgValueByName(Context, "read_size", size_t);
+    int32                    status_code;
+
+    if (UT_Stub_GetInt32StatusCode(Context, &status_code))
+    {
+        retval = status_code;
+    }
+    else if (retval == sizeof(image->hdr))
+    {
+        memcpy(buf, &image->hdr, retval);
+    }
+    else
+    {
+        memcpy(buf, image->entries, retval);
+    }
+    UT_Stub_SetReturnValue(FuncKey, retval);
+}
+
+static void UT_CF_Delivered_SetEntry(CF_DeliveredEntry_t *entry, CF_EntityId_t peer_eid, const char *dst_filename,
+                                     uint32 fsize, uint32 last_use)
+{
+    memset(entry, 0, sizeof(*entry));
+    entry->peer_eid = peer_eid;
+    entry->fsize    = fsize;
+    entry->crc      = 0x1234;
+    entry->last_use = last_use;
+    strncpy(entry->dst_filename, dst_filename, sizeof(entry->dst_filename) - 1);
+}
+
+/*******************************************************************************
+**
+**  cf_delivered_tests
+**
+*******************************************************************************/
+
+void Test_CF_Delivered_Load(void)
+{
+    /* Test case for:
+     * void CF_Delivered_Load(void);
+     */
+    CF_Delivered_t *index = &CF_AppData.delivered;
+
+    /* no index file, starts empty */
+    index->use_count = 7;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UtAssert_VOIDCALL(CF_Delivered_Load());
+    UtAssert_UINT32_EQ(index->use_count, 0);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 0);
+
+    /* bad magic, discarded */
+    memset(&UT_CF_Delivered_File, 0, sizeof(UT_CF_Delivered_File));
+    UT_CF_Delivered_File.hdr.magic   = ~CF_DELIVERED_FILE_MAGIC;
+    UT_CF_Delivered_File.hdr.version = CF_DELIVERED_FILE_VERSION;
+    UT_CF_Delivered_SetEntry(&UT_CF_Delivered_File.entries[0], 2, "dst", 100, 5);
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedRead), UT_AltHandler_CF_WrappedRead_Image, &UT_CF_Delivered_File);
+    UtAssert_VOIDCALL(CF_Delivered_Load());
+    UtAssert_UINT32_EQ(index->entries[0].last_use, 0);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+
+    /* short read of the entries, discarded */
+    UT_CF_Delivered_File.hdr.magic       = CF_DELIVERED_FILE_MAGIC;
+    UT_CF_Delivered_File.hdr.num_entries = 1;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 2, 1);
+    UtAssert_VOIDCALL(CF_Delivered_Load());
+    UtAssert_UINT32_EQ(index->entries[0].last_use, 0);
+
+    /* nominal, an index with more entries than fit keeps the ones that do */
+    UT_CF_Delivered_File.hdr.num_entries = CF_DELIVERED_INDEX_ENTRIES + 1;
+    UT_CF_Delivered_SetEntry(&UT_CF_Delivered_File.entries[CF_DELIVERED_INDEX_ENTRIES - 1], 3, "other", 50, 9);
+    memset(UT_CF_Delivered_File.entries[0].dst_filename, 'a', CF_FILENAME_MAX_LEN);
+    UtAssert_VOIDCALL(CF_Delivered_Load());
+    UtAssert_UINT32_EQ(index->use_count, 9);
+    UtAssert_UINT32_EQ(index->entries[0].last_use, 5);
+    UtAssert_UINT32_EQ(index->entries[0].dst_filename[CF_FILENAME_MAX_LEN - 1], 0);
+    UtAssert_UINT32_EQ(index->entries[CF_DELIVERED_INDEX_ENTRIES - 1].peer_eid, 3);
+}
+
+void Test_CF_Delivered_Find(void)
+{
+    /* Test case for:
+     * const CF_DeliveredEntry_t *CF_Delivered_Find(CF_EntityId_t peer_eid, const char *dst_filename, uint32 fsize);
+     */
+    CF_Delivered_t *index = &CF_AppData.delivered;
+
+    index->use_count = 4;
+    UT_CF_Delivered_SetEntry(&index->entries[0], 2, "dst", 100, 4);
+
+    /* a match is marked as used */
+    UtAssert_ADDRESS_EQ(CF_Delivered_Find(2, "dst", 100), &index->entries[0]);
+    UtAssert_UINT32_EQ(index->entries[0].last_use, 5);
+    UtAssert_UINT32_EQ(index->use_count, 5);
+
+    /* different size, peer, or name */
+    UtAssert_NULL(CF_Delivered_Find(2, "dst", 101));
+    UtAssert_NULL(CF_Delivered_Find(3, "dst", 100));
+    UtAssert_NULL(CF_Delivered_Find(2, "other", 100));
+
+    /* an unused entry never matches */
+    index->entries[0].last_use = 0;
+    UtAssert_NULL(CF_Delivered_Find(2, "dst", 100));
+    UtAssert_UINT32_EQ(index->use_count, 5);
+}
+
+void Test_CF_Delivered_Add(void)
+{
+    /* Test case for:
+     * void CF_Delivered_Add(CF_EntityId_t peer_eid, const char *dst_filename, uint32 fsize, uint32 crc);
+     */
+    CF_Delivered_t *index = &CF_AppData.delivered;
+    int             i;
+
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedWrite), UT_AltHandler_CF_WrappedWrite_All, NULL);
+
+    /* first entry goes into the first unused slot, and the index is written out */
+    UtAssert_VOIDCALL(CF_Delivered_Add(2, "dst", 100, 0xabcd));
+    UtAssert_UINT32_EQ(index->entries[0].peer_eid, 2);
+    UtAssert_UINT32_EQ(index->entries[0].fsize, 100);
+    UtAssert_UINT32_EQ(index->entries[0].crc, 0xabcd);
+    UtAssert_UINT32_EQ(index->entries[0].last_use, 1);
+    UtAssert_STRINGBUF_EQ(index->entries[0].dst_filename, sizeof(index->entries[0].dst_filename), "dst", -1);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 2);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+    UtAssert_STUB_COUNT(CF_WrappedRename, 1);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+
+    /* another destination takes the next unused slot */
+    UtAssert_VOIDCALL(CF_Delivered_Add(2, "other", 50, 1));
+    UtAssert_UINT32_EQ(index->entries[1].last_use, 2);
+
+    /* the same destination again replaces its entry */
+    UtAssert_VOIDCALL(CF_Delivered_Add(2, "dst", 200, 0x1111));
+    UtAssert_UINT32_EQ(index->entries[0].fsize, 200);
+    UtAssert_UINT32_EQ(index->entries[0].last_use, 3);
+    UtAssert_UINT32_EQ(index->entries[2].last_use, 0);
+
+    /* a full index drops the least recently used entry */
+    for (i = 0; i < CF_DELIVERED_INDEX_ENTRIES; ++i)
+    {
+        index->entries[i].last_use = 10 + i;
+    }
+    index->entries[CF_DELIVERED_INDEX_ENTRIES - 1].last_use = 5;
+    index->use_count                                        = 10 + CF_DELIVERED_INDEX_ENTRIES;
+    UtAssert_VOIDCALL(CF_Delivered_Add(4, "new", 1, 1));
+    UtAssert_UINT32_EQ(index->entries[CF_DELIVERED_INDEX_ENTRIES - 1].peer_eid, 4);
+    UtAssert_UINT32_EQ(index->entries[CF_DELIVERED_INDEX_ENTRIES - 1].last_use, 11 + CF_DELIVERED_INDEX_ENTRIES);
+
+    /* rename fails, entry is still kept in memory */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRename), 1, OS_ERROR);
+    UtAssert_VOIDCALL(CF_Delivered_Add(4, "new", 2, 2));
+    UtAssert_UINT32_EQ(index->entries[CF_DELIVERED_INDEX_ENTRIES - 1].fsize, 2);
+    UT_CF_AssertEventID(CF_DELIVERED_WRITE_ERR_EID);
+
+    /* write fails, no rename */
+    UT_ResetState(UT_KEY(CF_WrappedRename));
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 1, -1);
+    UtAssert_VOIDCALL(CF_Delivered_Add(4, "new", 3, 3));
+    UtAssert_STUB_COUNT(CF_WrappedRename, 0);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 2);
+
+    /* open fails */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UtAssert_VOIDCALL(CF_Delivered_Add(4, "new", 4, 4));
+    UtAssert_STUB_COUNT(CF_WrappedRename, 0);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 3);
+}
+
+/*******************************************************************************
+**
+**  cf_delivered_tests UtTest_Setup
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    TEST_CF_ADD(Test_CF_Delivered_Load);
+    TEST_CF_ADD(Test_CF_Delivered_Find);
+    TEST_CF_ADD(Test_CF_Delivered_Add);
+}
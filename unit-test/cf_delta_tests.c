@@ -0,0 +1,586 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* cf testing includes */
+#include "cf_test_utils.h"
+#include "cf_delta.h"
+
+/*******************************************************************************
+**
+**  cf_delta_tests local utility functions
+**
+*******************************************************************************/
+
+#define UT_CF_DELTA_BASE_BLOCKS (20)
+#define UT_CF_DELTA_BASE_SIZE   (UT_CF_DELTA_BASE_BLOCKS * CF_DELTA_BLOCK_SIZE)
+
+static CF_Delta_t UT_CF_Delta_Work;
+static uint8      UT_CF_Delta_Base[UT_CF_DELTA_BASE_SIZE];
+static uint8      UT_CF_Delta_New[UT_CF_DELTA_BASE_SIZE + CF_DELTA_BLOCK_SIZE];
+static uint8      UT_CF_Delta_Back[sizeof(UT_CF_Delta_New)];
+static uint8      UT_CF_Delta_Ops[sizeof(UT_CF_Delta_New) + CF_DELTA_BLOCK_SIZE];
+static uint8      UT_CF_Delta_SigFile[sizeof(CF_DeltaSigHeader_t) + sizeof(UT_CF_Delta_Work.next)];
+static uint32     UT_CF_Delta_SigLen;
+static uint32     UT_CF_Delta_SigPos;
+
+/* a write appended to the signature file image, or the status code if set */
+static void UT_AltHandler_CF_WrappedWrite_SigFile(void *UserObj, UT_EntryKey_t FuncKey,
+                                                  const UT_StubContext_t *Context)
+{
+    const void * buf    = UT_Hook_GetArgValueByName(Context, "buf", const void *);
+    CFE_Status_t retval = (CFE_Status_t)UT_Hook_GetArgValueByName(Context, "write_size", size_t);
+    int32        status_code;
+
+    if (UT_Stub_GetInt32StatusCode(Context, &status_code))
+    {
+        retval = status_code;
+    }
+    else
+    {
+        memcpy(&UT_CF_Delta_SigFile[UT_CF_Delta_SigLen], buf, retval);
+        UT_CF_Delta_SigLen += retval;
+    }
+    UT_Stub_SetReturnValue(FuncKey, retval);
+}
+
+/* a read of the next bytes of the signature file image, or of the status code if set */
+static void UT_AltHandler_CF_WrappedRead_SigFile(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    void *       buf    = UT_Hook_GetArgValueByName(Context, "buf", void *);
+    CFE_Status_t retval = (CFE_Status_t)UT_Hook_GetArgValueByName(Context, "read_size", size_t);
+    int32        status_code;
+
+    if (UT_Stub_GetInt32StatusCode(Context, &status_code))
+    {
+        retval = status_code;
+    }
+    else
+    {
+        if (retval > (CFE_Status_t)(UT_CF_Delta_SigLen - UT_CF_Delta_SigPos))
+        {
+            retval = UT_CF_Delta_SigLen - UT_CF_Delta_SigPos;
+        }
+        memcpy(buf, &UT_CF_Delta_SigFile[UT_CF_Delta_SigPos], retval);
+        UT_CF_Delta_SigPos += retval;
+    }
+    UT_Stub_SetReturnValue(FuncKey, retval);
+}
+
+static void UT_CF_Delta_Fill(uint8 *data, uint32 len, uint32 seed)
+{
+    uint32 i;
+
+    for (i = 0; i < len; ++i)
+    {
+        seed    = (seed * 1103515245) + 12345;
+        data[i] = seed >> 16;
+    }
+}
+
+/* feed a file through the encoder a chunk at a time, the way a send does, collecting what it puts out */
+static uint32 UT_CF_Delta_Run(const uint8 *data, uint32 fsize, uint32 chunk)
+{
+    CF_Delta_t *delta   = &UT_CF_Delta_Work;
+    uint32      ops_len = 0;
+    uint32      steps;
+    uint32      have;
+    uint32      len;
+    bool        done = false;
+
+    for (steps = 0; !done && steps < 1000; ++steps)
+    {
+        len  = CF_Delta_Shift(delta);
+        have = delta->buf_offs + delta->buf_len;
+        if (len > (fsize - have))
+        {
+            len = fsize - have;
+        }
+        if (len > chunk)
+        {
+            len = chunk;
+        }
+        memcpy(&delta->buf[delta->buf_len], &data[have], len);
+        delta->buf_len += len;
+
+        CF_Delta_AddSigs(delta);
+        done = CF_Delta_Encode(delta, fsize);
+
+        if ((ops_len + delta->out_len) <= sizeof(UT_CF_Delta_Ops))
+        {
+            memcpy(&UT_CF_Delta_Ops[ops_len], delta->out, delta->out_len);
+        }
+        ops_len += delta->out_len;
+        delta->out_len = 0;
+    }
+
+    UtAssert_BOOL_TRUE(done);
+    UtAssert_UINT32_LTEQ(ops_len, sizeof(UT_CF_Delta_Ops));
+
+    return ops_len;
+}
+
+/* sign the old file, save and load the signatures, then encode the new file and rebuild it from the delta */
+static uint32 UT_CF_Delta_RoundTrip(uint32 fsize, uint32 chunk)
+{
+    CF_Delta_t *delta = &UT_CF_Delta_Work;
+    uint32      ops_len;
+    uint32      pos = 0;
+    uint32      len = 0;
+    uint32      size;
+    uint32      arg;
+    uint32      count;
+
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedWrite), UT_AltHandler_CF_WrappedWrite_SigFile, NULL);
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedRead), UT_AltHandler_CF_WrappedRead_SigFile, NULL);
+
+    CF_Delta_Start(delta, NULL);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UtAssert_BOOL_FALSE(CF_Delta_LoadSigs(delta, "none"));
+    UtAssert_UINT32_EQ(UT_CF_Delta_Run(UT_CF_Delta_Base, UT_CF_DELTA_BASE_SIZE, chunk), 0);
+    UtAssert_UINT32_EQ(delta->num_next, UT_CF_DELTA_BASE_BLOCKS);
+
+    UT_CF_Delta_SigLen = 0;
+    UtAssert_INT32_EQ(CF_Delta_SaveSigs(delta, "sig", UT_CF_DELTA_BASE_SIZE), CFE_SUCCESS);
+
+    CF_Delta_Start(delta, NULL);
+    UT_CF_Delta_SigPos = 0;
+    UtAssert_BOOL_TRUE(CF_Delta_LoadSigs(delta, "sig"));
+    UtAssert_UINT32_EQ(delta->base_size, UT_CF_DELTA_BASE_SIZE);
+
+    ops_len = UT_CF_Delta_Run(UT_CF_Delta_New, fsize, chunk);
+
+    memset(UT_CF_Delta_Back, 0, sizeof(UT_CF_Delta_Back));
+    while (pos < ops_len && len <= fsize)
+    {
+        size = CF_Delta_ParseOp(&UT_CF_Delta_Ops[pos], ops_len - pos, &arg, &count);
+        UtAssert_NONZERO(size);
+        if (size == 0)
+        {
+            break;
+        }
+
+        if (UT_CF_Delta_Ops[pos] == CF_DELTA_OP_COPY)
+        {
+            memcpy(&UT_CF_Delta_Back[len], &UT_CF_Delta_Base[arg * CF_DELTA_BLOCK_SIZE], count * CF_DELTA_BLOCK_SIZE);
+            len += count * CF_DELTA_BLOCK_SIZE;
+        }
+        else
+        {
+            memcpy(&UT_CF_Delta_Back[len], &UT_CF_Delta_Ops[pos + size], arg);
+            len += arg;
+            size += arg;
+        }
+        pos += size;
+    }
+
+    UtAssert_UINT32_EQ(len, fsize);
+    UtAssert_MemCmp(UT_CF_Delta_Back, UT_CF_Delta_New, fsize, "rebuilt file");
+
+    /* the signatures of the new file are ready for the next delta */
+    UtAssert_UINT32_EQ(delta->num_next, fsize / CF_DELTA_BLOCK_SIZE);
+
+    return ops_len;
+}
+
+/*******************************************************************************
+**
+**  cf_delta_tests
+**
+*******************************************************************************/
+
+void Test_CF_Delta_Weak(void)
+{
+    /* Test case for:
+     * uint32 CF_Delta_Weak(const uint8 *data, uint32 len);
+     * uint32 CF_Delta_Roll(uint32 weak, uint8 out_byte, uint8 in_byte, uint32 len);
+     */
+    uint32 weak;
+    uint32 i;
+
+    /* sum of 'a' 'b' 'c' is 0x126, sum of the running sums is 0x24a */
+    UtAssert_UINT32_EQ(CF_Delta_Weak((const uint8 *)"abc", 3), 0x024a0126);
+    UtAssert_UINT32_EQ(CF_Delta_Weak((const uint8 *)"abc", 0), 0);
+
+    /* rolling on a byte at a time agrees with starting again at each position */
+    UT_CF_Delta_Fill(UT_CF_Delta_Base, CF_DELTA_BLOCK_SIZE + 50, 3);
+    weak = CF_Delta_Weak(UT_CF_Delta_Base, CF_DELTA_BLOCK_SIZE);
+    for (i = 0; i < 50; ++i)
+    {
+        weak = CF_Delta_Roll(weak, UT_CF_Delta_Base[i], UT_CF_Delta_Base[i + CF_DELTA_BLOCK_SIZE], CF_DELTA_BLOCK_SIZE);
+    }
+    UtAssert_UINT32_EQ(weak, CF_Delta_Weak(&UT_CF_Delta_Base[50], CF_DELTA_BLOCK_SIZE));
+}
+
+void Test_CF_Delta_Strong(void)
+{
+    /* Test case for:
+     * uint64 CF_Delta_Strong(const uint8 *data, uint32 len);
+     */
+
+    /* the published FNV-1a values */
+    UtAssert_BOOL_TRUE(CF_Delta_Strong((const uint8 *)"", 0) == 0xcbf29ce484222325ULL);
+    UtAssert_BOOL_TRUE(CF_Delta_Strong((const uint8 *)"a", 1) == 0xaf63dc4c8601ec8cULL);
+}
+
+void Test_CF_Delta_Start(void)
+{
+    /* Test case for:
+     * void CF_Delta_Start(CF_Delta_t *delta, struct CF_Transaction *owner);
+     */
+    CF_Delta_t *     delta = &UT_CF_Delta_Work;
+    CF_Transaction_t txn;
+
+    UT_CF_Delta_Fill((uint8 *)delta, sizeof(*delta), 5);
+    UtAssert_VOIDCALL(CF_Delta_Start(delta, &txn));
+    UtAssert_ADDRESS_EQ(delta->owner, &txn);
+    UtAssert_UINT32_EQ(delta->num_base, 0);
+    UtAssert_UINT32_EQ(delta->num_next, 0);
+    UtAssert_UINT32_EQ(delta->buf_len, 0);
+    UtAssert_UINT32_EQ(delta->sig_offs, 0);
+    UtAssert_UINT32_EQ(delta->copy_count, 0);
+    UtAssert_UINT32_EQ(delta->out_len, 0);
+    UtAssert_BOOL_FALSE(delta->rolling);
+}
+
+void Test_CF_Delta_Encode(void)
+{
+    /* Test case for:
+     * uint32 CF_Delta_Shift(CF_Delta_t *delta);
+     * void CF_Delta_AddSigs(CF_Delta_t *delta);
+     * bool CF_Delta_Encode(CF_Delta_t *delta, uint32 fsize);
+     */
+    const uint32 B = CF_DELTA_BLOCK_SIZE;
+
+    UT_CF_Delta_Fill(UT_CF_Delta_Base, UT_CF_DELTA_BASE_SIZE, 1);
+
+    /* unchanged, two copies as one covers at most CF_DELTA_COPY_MAX_BLOCKS */
+    memcpy(UT_CF_Delta_New, UT_CF_Delta_Base, UT_CF_DELTA_BASE_SIZE);
+    UtAssert_UINT32_EQ(UT_CF_Delta_RoundTrip(UT_CF_DELTA_BASE_SIZE, 700), 2 * CF_DELTA_COPY_SIZE);
+
+    /* bytes put in, a block changed, and more added at the end */
+    memcpy(UT_CF_Delta_New, UT_CF_Delta_Base, 3 * B);
+    UT_CF_Delta_Fill(&UT_CF_Delta_New[3 * B], 100, 7);
+    memcpy(&UT_CF_Delta_New[(3 * B) + 100], &UT_CF_Delta_Base[3 * B], 7 * B);
+    UT_CF_Delta_Fill(&UT_CF_Delta_New[(10 * B) + 100], B, 8);
+    memcpy(&UT_CF_Delta_New[(11 * B) + 100], &UT_CF_Delta_Base[11 * B], 9 * B);
+    UT_CF_Delta_Fill(&UT_CF_Delta_New[UT_CF_DELTA_BASE_SIZE + 100], 300, 9);
+    UtAssert_UINT32_EQ(UT_CF_Delta_RoundTrip(UT_CF_DELTA_BASE_SIZE + 400, 700),
+                       (3 * CF_DELTA_COPY_SIZE) + (3 * CF_DELTA_DATA_HDR_SIZE) + 100 + B + 300);
+
+    /* the same, fed in the largest pieces there is room for */
+    UtAssert_UINT32_EQ(UT_CF_Delta_RoundTrip(UT_CF_DELTA_BASE_SIZE + 400, UINT32_MAX),
+                       (3 * CF_DELTA_COPY_SIZE) + (3 * CF_DELTA_DATA_HDR_SIZE) + 100 + B + 300);
+
+    /* the last whole block changed */
+    memcpy(UT_CF_Delta_New, UT_CF_Delta_Base, UT_CF_DELTA_BASE_SIZE);
+    UT_CF_Delta_Fill(&UT_CF_Delta_New[UT_CF_DELTA_BASE_SIZE - B], B, 10);
+    UtAssert_UINT32_EQ(UT_CF_Delta_RoundTrip(UT_CF_DELTA_BASE_SIZE, 700),
+                       (2 * CF_DELTA_COPY_SIZE) + CF_DELTA_DATA_HDR_SIZE + B);
+
+    /* shorter than a block, so all data */
+    UtAssert_UINT32_EQ(UT_CF_Delta_RoundTrip(B - 1, 700), CF_DELTA_DATA_HDR_SIZE + B - 1);
+
+    /* empty */
+    UtAssert_UINT32_EQ(UT_CF_Delta_RoundTrip(0, 700), 0);
+}
+
+void Test_CF_Delta_Shift(void)
+{
+    /* Test case for:
+     * uint32 CF_Delta_Shift(CF_Delta_t *delta);
+     */
+    CF_Delta_t *delta = &UT_CF_Delta_Work;
+
+    CF_Delta_Start(delta, NULL);
+    delta->buf_offs = 100;
+    delta->buf_len  = 50;
+    delta->buf[10]  = 0x5a;
+
+    /* data not yet signed stays */
+    delta->lit      = 120;
+    delta->sig_offs = 110;
+    UtAssert_UINT32_EQ(CF_Delta_Shift(delta), sizeof(delta->buf) - 40);
+    UtAssert_UINT32_EQ(delta->buf_offs, 110);
+    UtAssert_UINT32_EQ(delta->buf[0], 0x5a);
+
+    /* data not yet put out stays */
+    delta->sig_offs = 130;
+    UtAssert_UINT32_EQ(CF_Delta_Shift(delta), sizeof(delta->buf) - 30);
+    UtAssert_UINT32_EQ(delta->buf_offs, 120);
+
+    /* nothing to drop */
+    UtAssert_UINT32_EQ(CF_Delta_Shift(delta), sizeof(delta->buf) - 30);
+}
+
+void Test_CF_Delta_AddSigs(void)
+{
+    /* Test case for:
+     * void CF_Delta_AddSigs(CF_Delta_t *delta);
+     */
+    CF_Delta_t *delta = &UT_CF_Delta_Work;
+
+    /* one whole block and part of the next */
+    CF_Delta_Start(delta, NULL);
+    UT_CF_Delta_Fill(delta->buf, sizeof(delta->buf), 4);
+    delta->buf_len = CF_DELTA_BLOCK_SIZE + 1;
+    UtAssert_VOIDCALL(CF_Delta_AddSigs(delta));
+    UtAssert_UINT32_EQ(delta->num_next, 1);
+    UtAssert_UINT32_EQ(delta->sig_offs, CF_DELTA_BLOCK_SIZE);
+    UtAssert_UINT32_EQ(delta->next[0].weak, CF_Delta_Weak(delta->buf, CF_DELTA_BLOCK_SIZE));
+    UtAssert_BOOL_TRUE(delta->next[0].strong == CF_Delta_Strong(delta->buf, CF_DELTA_BLOCK_SIZE));
+
+    /* past the end of the table, passed over but not signed */
+    delta->num_next = CF_DELTA_MAX_BLOCKS;
+    delta->buf_len  = sizeof(delta->buf);
+    UtAssert_VOIDCALL(CF_Delta_AddSigs(delta));
+    UtAssert_UINT32_EQ(delta->num_next, CF_DELTA_MAX_BLOCKS);
+    UtAssert_UINT32_EQ(delta->sig_offs, 2 * CF_DELTA_BLOCK_SIZE);
+}
+
+void Test_CF_Delta_LoadSigs(void)
+{
+    /* Test case for:
+     * bool CF_Delta_LoadSigs(CF_Delta_t *delta, const char *fname);
+     */
+    CF_Delta_t *         delta = &UT_CF_Delta_Work;
+    CF_DeltaSigHeader_t *hdr   = (CF_DeltaSigHeader_t *)UT_CF_Delta_SigFile;
+
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedRead), UT_AltHandler_CF_WrappedRead_SigFile, NULL);
+
+    memset(UT_CF_Delta_SigFile, 0, sizeof(UT_CF_Delta_SigFile));
+    hdr->magic         = CF_DELTA_SIG_MAGIC;
+    hdr->version       = CF_DELTA_SIG_VERSION;
+    hdr->block_size    = CF_DELTA_BLOCK_SIZE;
+    hdr->fsize         = (2 * CF_DELTA_BLOCK_SIZE) + 1;
+    hdr->num_blocks    = 2;
+    UT_CF_Delta_SigLen = sizeof(*hdr) + (2 * sizeof(CF_DeltaSig_t));
+
+    /* nominal */
+    UT_CF_Delta_SigPos = 0;
+    UtAssert_BOOL_TRUE(CF_Delta_LoadSigs(delta, "sig"));
+    UtAssert_UINT32_EQ(delta->num_base, 2);
+    UtAssert_UINT32_EQ(delta->base_size, (2 * CF_DELTA_BLOCK_SIZE) + 1);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+
+    /* two blocks with the same weak checksum are both found, lowest first */
+    UtAssert_UINT32_EQ(delta->chain[0], 2);
+    UtAssert_UINT32_EQ(delta->chain[1], 0);
+
+    /* no file */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UtAssert_BOOL_FALSE(CF_Delta_LoadSigs(delta, "sig"));
+    UtAssert_UINT32_EQ(delta->num_base, 0);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+
+    /* signatures cut short */
+    UT_CF_Delta_SigPos = 0;
+    UT_CF_Delta_SigLen -= 1;
+    UtAssert_BOOL_FALSE(CF_Delta_LoadSigs(delta, "sig"));
+    UT_CF_Delta_SigLen += 1;
+
+    /* more blocks than the file has */
+    UT_CF_Delta_SigPos = 0;
+    hdr->fsize         = (2 * CF_DELTA_BLOCK_SIZE) - 1;
+    UtAssert_BOOL_FALSE(CF_Delta_LoadSigs(delta, "sig"));
+    hdr->fsize = 2 * CF_DELTA_BLOCK_SIZE;
+
+    /* made with another block size */
+    UT_CF_Delta_SigPos = 0;
+    hdr->block_size    = CF_DELTA_BLOCK_SIZE / 2;
+    UtAssert_BOOL_FALSE(CF_Delta_LoadSigs(delta, "sig"));
+    hdr->block_size = CF_DELTA_BLOCK_SIZE;
+
+    /* another version */
+    UT_CF_Delta_SigPos = 0;
+    hdr->version       = CF_DELTA_SIG_VERSION + 1;
+    UtAssert_BOOL_FALSE(CF_Delta_LoadSigs(delta, "sig"));
+    hdr->version = CF_DELTA_SIG_VERSION;
+
+    /* not a signature file */
+    UT_CF_Delta_SigPos = 0;
+    hdr->magic         = ~CF_DELTA_SIG_MAGIC;
+    UtAssert_BOOL_FALSE(CF_Delta_LoadSigs(delta, "sig"));
+    hdr->magic = CF_DELTA_SIG_MAGIC;
+
+    /* header cut short */
+    UT_CF_Delta_SigPos = 0;
+    UT_CF_Delta_SigLen = sizeof(*hdr) - 1;
+    UtAssert_BOOL_FALSE(CF_Delta_LoadSigs(delta, "sig"));
+    UtAssert_UINT32_EQ(delta->base_size, 0);
+}
+
+void Test_CF_Delta_SaveSigs(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_Delta_SaveSigs(const CF_Delta_t *delta, const char *fname, uint32 fsize);
+     */
+    CF_Delta_t *         delta = &UT_CF_Delta_Work;
+    CF_DeltaSigHeader_t *hdr   = (CF_DeltaSigHeader_t *)UT_CF_Delta_SigFile;
+
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedWrite), UT_AltHandler_CF_WrappedWrite_SigFile, NULL);
+
+    CF_Delta_Start(delta, NULL);
+    delta->num_next       = 1;
+    delta->next[0].weak   = 0x1234;
+    delta->next[0].strong = 0x5678;
+
+    /* nominal */
+    UT_CF_Delta_SigLen = 0;
+    UtAssert_INT32_EQ(CF_Delta_SaveSigs(delta, "sig", 1500), CFE_SUCCESS);
+    UtAssert_UINT32_EQ(UT_CF_Delta_SigLen, sizeof(*hdr) + sizeof(CF_DeltaSig_t));
+    UtAssert_UINT32_EQ(hdr->magic, CF_DELTA_SIG_MAGIC);
+    UtAssert_UINT32_EQ(hdr->block_size, CF_DELTA_BLOCK_SIZE);
+    UtAssert_UINT32_EQ(hdr->fsize, 1500);
+    UtAssert_UINT32_EQ(hdr->num_blocks, 1);
+    UtAssert_MemCmp(&UT_CF_Delta_SigFile[sizeof(*hdr)], delta->next, sizeof(CF_DeltaSig_t), "signatures");
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+
+    /* signatures not all written */
+    UT_CF_Delta_SigLen = 0;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 2, 1);
+    UtAssert_INT32_EQ(CF_Delta_SaveSigs(delta, "sig", 1500), CF_ERROR);
+
+    /* header not written */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedWrite), 1, -1);
+    UtAssert_INT32_EQ(CF_Delta_SaveSigs(delta, "sig", 1500), CF_ERROR);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 3);
+
+    /* file not created */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UtAssert_INT32_EQ(CF_Delta_SaveSigs(delta, "sig", 1500), CF_ERROR);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 3);
+}
+
+void Test_CF_Delta_ParseHeader(void)
+{
+    /* Test case for:
+     * void CF_Delta_PutHeader(uint8 *out, const CF_DeltaHeader_t *hdr);
+     * bool CF_Delta_ParseHeader(const uint8 *in, CF_DeltaHeader_t *hdr);
+     */
+    const uint8      expect[CF_DELTA_HDR_SIZE] = {0x01, 0x02, 0x03, 0x04, 0xaa, 0xbb, 0xcc, 0xdd,
+                                             0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x04, 0x00};
+    uint8            out[CF_DELTA_HDR_SIZE];
+    CF_DeltaHeader_t hdr;
+    CF_DeltaHeader_t back;
+
+    /* big endian, and back again */
+    hdr.raw_size   = 0x01020304;
+    hdr.raw_crc    = 0xaabbccdd;
+    hdr.base_size  = 0x1000;
+    hdr.block_size = 0x400;
+    UtAssert_VOIDCALL(CF_Delta_PutHeader(out, &hdr));
+    UtAssert_MemCmp(out, expect, sizeof(expect), "header");
+    UtAssert_BOOL_TRUE(CF_Delta_ParseHeader(out, &back));
+    UtAssert_UINT32_EQ(back.raw_size, hdr.raw_size);
+    UtAssert_UINT32_EQ(back.raw_crc, hdr.raw_crc);
+    UtAssert_UINT32_EQ(back.base_size, hdr.base_size);
+    UtAssert_UINT32_EQ(back.block_size, hdr.block_size);
+
+    /* block size out of range */
+    hdr.block_size = 63;
+    CF_Delta_PutHeader(out, &hdr);
+    UtAssert_BOOL_FALSE(CF_Delta_ParseHeader(out, &back));
+    hdr.block_size = 32769;
+    CF_Delta_PutHeader(out, &hdr);
+    UtAssert_BOOL_FALSE(CF_Delta_ParseHeader(out, &back));
+}
+
+void Test_CF_Delta_ParseOp(void)
+{
+    /* Test case for:
+     * uint32 CF_Delta_ParseOp(const uint8 *in, uint32 in_len, uint32 *arg, uint32 *count);
+     */
+    uint8  copy[CF_DELTA_COPY_SIZE] = {CF_DELTA_OP_COPY, 0x00, 0x00, 0x01, 0x02, 0x00, 0x00, 0x00, 0x03};
+    uint8  data[]                   = {CF_DELTA_OP_DATA, 0x01, 0x02};
+    uint8  unknown[]                = {0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01};
+    uint32 arg;
+    uint32 count;
+
+    /* a copy */
+    UtAssert_UINT32_EQ(CF_Delta_ParseOp(copy, sizeof(copy), &arg, &count), CF_DELTA_COPY_SIZE);
+    UtAssert_UINT32_EQ(arg, 0x102);
+    UtAssert_UINT32_EQ(count, 3);
+
+    /* cut short */
+    UtAssert_UINT32_EQ(CF_Delta_ParseOp(copy, sizeof(copy) - 1, &arg, &count), 0);
+
+    /* no blocks, or more than one copy covers */
+    copy[8] = 0;
+    UtAssert_UINT32_EQ(CF_Delta_ParseOp(copy, sizeof(copy), &arg, &count), 0);
+    copy[8] = CF_DELTA_COPY_MAX_BLOCKS + 1;
+    UtAssert_UINT32_EQ(CF_Delta_ParseOp(copy, sizeof(copy), &arg, &count), 0);
+
+    /* data */
+    UtAssert_UINT32_EQ(CF_Delta_ParseOp(data, sizeof(data), &arg, &count), CF_DELTA_DATA_HDR_SIZE);
+    UtAssert_UINT32_EQ(arg, 0x102);
+    UtAssert_UINT32_EQ(count, 0);
+
+    /* cut short, or empty */
+    UtAssert_UINT32_EQ(CF_Delta_ParseOp(data, sizeof(data) - 1, &arg, &count), 0);
+    data[1] = 0;
+    data[2] = 0;
+    UtAssert_UINT32_EQ(CF_Delta_ParseOp(data, sizeof(data), &arg, &count), 0);
+
+    /* not an instruction */
+    UtAssert_UINT32_EQ(CF_Delta_ParseOp(unknown, sizeof(unknown), &arg, &count), 0);
+}
+
+void Test_CF_Delta_GetFilename(void)
+{
+    /* Test case for:
+     * void CF_Delta_GetSigFilename(char *buf, size_t buf_size, CF_EntityId_t peer_eid, const char *dst_filename);
+     * void CF_Delta_GetFilename(char *buf, size_t buf_size, CF_EntityId_t src_eid, CF_TransactionSeq_t seq_num,
+     *                           const char *ext);
+     */
+    CF_ConfigTable_t config;
+    char             buf[OS_MAX_PATH_LEN];
+
+    memset(&config, 0, sizeof(config));
+    strncpy(config.tmp_dir, "/cf/tmp", sizeof(config.tmp_dir) - 1);
+    CF_AppData.config_table = &config;
+
+    UtAssert_VOIDCALL(CF_Delta_GetFilename(buf, sizeof(buf), 2, 34, CF_DELTA_BASE_EXT));
+    UtAssert_STRINGBUF_EQ(buf, sizeof(buf), "/cf/tmp/2:34.base", -1);
+
+    /* named for the peer and a checksum of the destination name, which the stubs leave at 0 */
+    UtAssert_VOIDCALL(CF_Delta_GetSigFilename(buf, sizeof(buf), 5, "/ram/dst.bin"));
+    UtAssert_STRINGBUF_EQ(buf, sizeof(buf), "/cf/sig/d5_00000000.sig", -1);
+    UtAssert_STUB_COUNT(CF_CRC_Digest, 1);
+}
+
+/*******************************************************************************
+**
+**  cf_delta_tests UtTest_Setup
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    TEST_CF_ADD(Test_CF_Delta_Weak);
+    TEST_CF_ADD(Test_CF_Delta_Strong);
+    TEST_CF_ADD(Test_CF_Delta_Start);
+    TEST_CF_ADD(Test_CF_Delta_Encode);
+    TEST_CF_ADD(Test_CF_Delta_Shift);
+    TEST_CF_ADD(Test_CF_Delta_AddSigs);
+    TEST_CF_ADD(Test_CF_Delta_LoadSigs);
+    TEST_CF_ADD(Test_CF_Delta_SaveSigs);
+    TEST_CF_ADD(Test_CF_Delta_ParseHeader);
+    TEST_CF_ADD(Test_CF_Delta_ParseOp);
+    TEST_CF_ADD(Test_CF_Delta_GetFilename);
+}
@@ -55,7 +55,7 @@ void Test_CF_ProcessGroundCommand_When_cmd_EqTo_CF_NUM_COMMANDS_FailAndSendEvent
 {
     /* Arrange */
     CFE_SB_Buffer_t   utbuf;
-    CFE_MSG_FcnCode_t forced_return_CFE_MSG_GetFcnCode = 24;
+    CFE_MSG_FcnCode_t forced_return_CFE_MSG_GetFcnCode = CF_NUM_COMMANDS;
 
     memset(&utbuf, 0, sizeof(utbuf));
 
@@ -0,0 +1,110 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* cf testing includes */
+#include "cf_test_utils.h"
+#include "cf_evagg.h"
+#include "cf_events.h"
+
+/*******************************************************************************
+**
+**  cf_evagg_tests
+**
+*******************************************************************************/
+
+void Test_CF_EvAgg_Suppress(void)
+{
+    /* Test case for:
+     * bool CF_EvAgg_Suppress(CF_EvAggId_t id, uint32 arg1, uint32 arg2);
+     */
+    CF_EvAggSlot_t *slot = &CF_AppData.evagg.slot[CF_EvAgg_RX_DROPPED];
+
+    /* the first in an interval is sent */
+    UtAssert_BOOL_FALSE(CF_EvAgg_Suppress(CF_EvAgg_RX_DROPPED, 1, 2));
+    UtAssert_UINT32_EQ(slot->count, 1);
+
+    /* repeats are counted and keep the last arguments */
+    UtAssert_BOOL_TRUE(CF_EvAgg_Suppress(CF_EvAgg_RX_DROPPED, 3, 4));
+    UtAssert_UINT32_EQ(slot->count, 2);
+    UtAssert_UINT32_EQ(slot->arg[0], 3);
+    UtAssert_UINT32_EQ(slot->arg[1], 4);
+
+    /* other events are counted separately */
+    UtAssert_BOOL_FALSE(CF_EvAgg_Suppress(CF_EvAgg_NO_MSG, 0, 0));
+
+    /* the count saturates */
+    slot->count = UINT32_MAX;
+    UtAssert_BOOL_TRUE(CF_EvAgg_Suppress(CF_EvAgg_RX_DROPPED, 5, 6));
+    UtAssert_UINT32_EQ(slot->count, UINT32_MAX);
+}
+
+void Test_CF_EvAgg_Tick(void)
+{
+    /* Test case for:
+     * void CF_EvAgg_Tick(void);
+     */
+    int i;
+
+    /* within the interval */
+    CF_AppData.evagg.slot[CF_EvAgg_NO_MSG].count = 5;
+    UtAssert_VOIDCALL(CF_EvAgg_Tick());
+    UtAssert_STUB_COUNT(CF_Timer_Tick, 1);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+    UtAssert_UINT32_EQ(CF_AppData.evagg.slot[CF_EvAgg_NO_MSG].count, 5);
+
+    /* end of an interval, with nothing suppressed */
+    CF_AppData.evagg.slot[CF_EvAgg_NO_MSG].count = 1;
+    UT_SetDefaultReturnValue(UT_KEY(CF_Timer_Expired), true);
+    UtAssert_VOIDCALL(CF_EvAgg_Tick());
+    UtAssert_STUB_COUNT(CF_Timer_InitRelSec, 1);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+    UtAssert_ZERO(CF_AppData.evagg.slot[CF_EvAgg_NO_MSG].count);
+
+    /* end of an interval, with a summary for every event that was suppressed */
+    for (i = 0; i < CF_EvAgg_NUM; ++i)
+    {
+        CF_AppData.evagg.slot[i].count = 2;
+    }
+    UtAssert_VOIDCALL(CF_EvAgg_Tick());
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, CF_EvAgg_NUM);
+    UT_CF_AssertEventID(CF_PDU_TRUNCATION_ERR_EID);
+    for (i = 0; i < CF_EvAgg_NUM; ++i)
+    {
+        UtAssert_ZERO(CF_AppData.evagg.slot[i].count);
+    }
+
+    /* only the event capture buffer's worth of IDs are kept, so check the last summary on its own */
+    UT_CF_ResetEventCapture();
+    CF_AppData.evagg.slot[CF_EvAgg_INVALID_DST].count = 2;
+    UtAssert_VOIDCALL(CF_EvAgg_Tick());
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 1);
+    UT_CF_AssertEventID(CF_CFDP_INVALID_DST_ERR_EID);
+}
+
+/*******************************************************************************
+**
+**  cf_evagg_tests UtTest_Setup
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    TEST_CF_ADD(Test_CF_EvAgg_Suppress);
+    TEST_CF_ADD(Test_CF_EvAgg_Tick);
+}
@@ -0,0 +1,315 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* cf testing includes */
+#include "cf_test_utils.h"
+#include "cf_fanout.h"
+
+/*******************************************************************************
+**
+**  cf_fanout_tests local utility functions
+**
+*******************************************************************************/
+
+static CF_FanOut_t *UT_CF_FanOut_Setup(uint32 fsize)
+{
+    CF_FanOut_t *group = &CF_AppData.engine.fanouts[0];
+
+    group->in_use  = true;
+    group->fsize   = fsize;
+    group->num_txn = 1;
+    OS_OpenCreate(&group->fd, "ut", 0, 0); /* sets fd */
+
+    return group;
+}
+
+/* a seek that always lands where it was asked to */
+static void UT_AltHandler_CF_WrappedLseek_Offset(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CFE_Status_t retval = (CFE_Status_t)UT_Hook_GetArgValueByName(Context, "offset", off_t);
+
+    UT_Stub_SetReturnValue(FuncKey, retval);
+}
+
+/* a read that always fills the whole request */
+static void UT_AltHandler_CF_WrappedRead_Full(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CFE_Status_t retval = (CFE_Status_t)UT_Hook_GetArgValueByName(Context, "read_size", size_t);
+
+    UT_Stub_SetReturnValue(FuncKey, retval);
+}
+
+/*******************************************************************************
+**
+**  cf_fanout_tests
+**
+*******************************************************************************/
+
+void Test_CF_FanOut_Open(void)
+{
+    /* Test case for:
+     * CF_FanOut_t *CF_FanOut_Open(const char *filename);
+     */
+    CF_FanOut_t *group;
+    int          i;
+
+    /* with no setup, OS_FileOpenCheck returns SUCCESS, so the file is already open */
+    UtAssert_NULL(CF_FanOut_Open("src"));
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+
+    /* this retval is sticky and applies for the rest of the test cases */
+    UT_SetDefaultReturnValue(UT_KEY(OS_FileOpenCheck), OS_ERROR);
+
+    /* open fails */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UtAssert_NULL(CF_FanOut_Open("src"));
+    UtAssert_BOOL_FALSE(CF_AppData.engine.fanouts[0].in_use);
+
+    /* seek to the end fails, file is closed again */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, -1);
+    UtAssert_NULL(CF_FanOut_Open("src"));
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+    UtAssert_BOOL_FALSE(CF_AppData.engine.fanouts[0].in_use);
+
+    /* nominal, the cache starts empty */
+    CF_AppData.engine.fanouts[0].blocks[0].len = 10;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, 5000);
+    UtAssert_NOT_NULL(group = CF_FanOut_Open("src"));
+    UtAssert_ADDRESS_EQ(group, &CF_AppData.engine.fanouts[0]);
+    UtAssert_BOOL_TRUE(group->in_use);
+    UtAssert_BOOL_FALSE(group->failed);
+    UtAssert_UINT32_EQ(group->fsize, 5000);
+    UtAssert_UINT32_EQ(group->crc_offs, 0);
+    UtAssert_UINT32_EQ(group->num_txn, 0);
+    UtAssert_UINT32_EQ(group->blocks[0].len, 0);
+    UtAssert_STUB_COUNT(CF_CRC_Start, 1);
+
+    /* next open takes the next group */
+    UtAssert_ADDRESS_EQ(CF_FanOut_Open("src"), &CF_AppData.engine.fanouts[CF_NUM_FANOUT_GROUPS > 1]);
+
+    /* no free group */
+    for (i = 0; i < CF_NUM_FANOUT_GROUPS; ++i)
+    {
+        CF_AppData.engine.fanouts[i].in_use = true;
+    }
+    UtAssert_NULL(CF_FanOut_Open("src"));
+}
+
+void Test_CF_FanOut_Release(void)
+{
+    /* Test case for:
+     * void CF_FanOut_Attach(CF_FanOut_t *group);
+     * bool CF_FanOut_Release(CF_FanOut_t *group, bool success);
+     */
+    CF_FanOut_t *group = UT_CF_FanOut_Setup(100);
+
+    /* all destinations succeed */
+    UtAssert_VOIDCALL(CF_FanOut_Attach(group));
+    UtAssert_UINT32_EQ(group->num_txn, 2);
+    UtAssert_BOOL_FALSE(CF_FanOut_Release(group, true));
+    UtAssert_BOOL_TRUE(group->in_use);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 0);
+    UtAssert_BOOL_TRUE(CF_FanOut_Release(group, true));
+    UtAssert_BOOL_FALSE(group->in_use);
+    UtAssert_BOOL_FALSE(OS_ObjectIdDefined(group->fd));
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+
+    /* one destination fails, even if it is not the last one to finish */
+    group = UT_CF_FanOut_Setup(100);
+    UtAssert_VOIDCALL(CF_FanOut_Attach(group));
+    UtAssert_BOOL_FALSE(CF_FanOut_Release(group, false));
+    UtAssert_BOOL_TRUE(group->failed);
+    UtAssert_BOOL_FALSE(CF_FanOut_Release(group, true));
+    UtAssert_BOOL_FALSE(group->in_use);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 2);
+}
+
+void Test_CF_FanOut_Read(void)
+{
+    /* Test case for:
+     * int32 CF_FanOut_Read(CF_FanOut_t *group, uint32 offset, void *buf, uint32 len);
+     */
+    CF_FanOut_t *group;
+    uint8        buf[16];
+
+    /* cache miss, block is loaded and digested into the checksum */
+    group = UT_CF_FanOut_Setup(CF_FANOUT_CACHE_BLOCK_SIZE + 10);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, CF_FANOUT_CACHE_BLOCK_SIZE);
+    UtAssert_INT32_EQ(CF_FanOut_Read(group, 4, buf, sizeof(buf)), sizeof(buf));
+    UtAssert_STUB_COUNT(CF_WrappedRead, 1);
+    UtAssert_STUB_COUNT(CF_CRC_Digest, 1);
+    UtAssert_UINT32_EQ(group->crc_offs, CF_FANOUT_CACHE_BLOCK_SIZE);
+    UtAssert_UINT32_EQ(group->blocks[0].offset, 0);
+    UtAssert_UINT32_EQ(group->blocks[0].len, CF_FANOUT_CACHE_BLOCK_SIZE);
+
+    /* cache hit, no read and no second digest */
+    group->blocks[0].data[4] = 0x5a;
+    UtAssert_INT32_EQ(CF_FanOut_Read(group, 4, buf, sizeof(buf)), sizeof(buf));
+    UtAssert_UINT32_EQ(buf[0], 0x5a);
+    UtAssert_STUB_COUNT(CF_WrappedRead, 1);
+    UtAssert_STUB_COUNT(CF_CRC_Digest, 1);
+
+    /* spans into the short last block of the file */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, CF_FANOUT_CACHE_BLOCK_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, 10);
+    UtAssert_INT32_EQ(CF_FanOut_Read(group, CF_FANOUT_CACHE_BLOCK_SIZE - 8, buf, sizeof(buf)), sizeof(buf));
+    UtAssert_STUB_COUNT(CF_WrappedRead, 2);
+    UtAssert_STUB_COUNT(CF_CRC_Digest, 2);
+    UtAssert_UINT32_EQ(group->crc_offs, CF_FANOUT_CACHE_BLOCK_SIZE + 10);
+
+    /* request goes past the end of the file */
+    UtAssert_INT32_EQ(CF_FanOut_Read(group, CF_FANOUT_CACHE_BLOCK_SIZE + 4, buf, sizeof(buf)), 6);
+
+    /* read error, nothing is cached */
+    group = UT_CF_FanOut_Setup(100);
+    memset(group->blocks, 0, sizeof(group->blocks));
+    group->crc_offs = 0;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, -1);
+    UtAssert_INT32_EQ(CF_FanOut_Read(group, 0, buf, sizeof(buf)), 0);
+    UtAssert_UINT32_EQ(group->blocks[0].len, 0);
+    UtAssert_UINT32_EQ(group->crc_offs, 0);
+
+    /* seek error */
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, -1);
+    UtAssert_INT32_EQ(CF_FanOut_Read(group, 0, buf, sizeof(buf)), 0);
+
+    /* a block read out of order is not digested until the checksum gets to it */
+    group = UT_CF_FanOut_Setup(CF_FANOUT_CACHE_BLOCK_SIZE * 2);
+    memset(group->blocks, 0, sizeof(group->blocks));
+    group->crc_offs = 0;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 1, CF_FANOUT_CACHE_BLOCK_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, CF_FANOUT_CACHE_BLOCK_SIZE);
+    UtAssert_INT32_EQ(CF_FanOut_Read(group, CF_FANOUT_CACHE_BLOCK_SIZE, buf, sizeof(buf)), sizeof(buf));
+    UtAssert_STUB_COUNT(CF_CRC_Digest, 2);
+    UtAssert_UINT32_EQ(group->crc_offs, 0);
+}
+
+void Test_CF_FanOut_Read_TakingTurns(void)
+{
+    /* Test case for:
+     * int32 CF_FanOut_Read(CF_FanOut_t *group, uint32 offset, void *buf, uint32 len);
+     * with the destinations of a group each reading the next chunk in turn, the way
+     * CF_CFDP_CycleTx() runs them, over a file many times the size of the cache
+     */
+    const uint32 fsize   = CF_FANOUT_CACHE_BLOCKS * CF_FANOUT_CACHE_BLOCK_SIZE * 8;
+    const uint32 nblocks = fsize / CF_FANOUT_CACHE_BLOCK_SIZE;
+    CF_FanOut_t *group;
+    uint8        buf[200]; /* does not divide the block size, so some chunks straddle two blocks */
+    uint32       offset;
+    uint32       len;
+    int          i;
+
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedLseek), UT_AltHandler_CF_WrappedLseek_Offset, NULL);
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedRead), UT_AltHandler_CF_WrappedRead_Full, NULL);
+
+    /* three destinations in step: every block is read from the file once */
+    group = UT_CF_FanOut_Setup(fsize);
+    for (offset = 0; offset < fsize; offset += len)
+    {
+        len = ((fsize - offset) < sizeof(buf)) ? (fsize - offset) : sizeof(buf);
+        for (i = 0; i < 3; ++i)
+        {
+            UtAssert_INT32_EQ(CF_FanOut_Read(group, offset, buf, len), len);
+        }
+    }
+    UtAssert_STUB_COUNT(CF_WrappedRead, nblocks);
+    UtAssert_STUB_COUNT(CF_CRC_Digest, nblocks);
+    UtAssert_UINT32_EQ(group->crc_offs, fsize);
+
+    /* the same three one after the other: the cache has long lost the start of the file */
+    UT_ResetState(UT_KEY(CF_WrappedRead));
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedRead), UT_AltHandler_CF_WrappedRead_Full, NULL);
+    group = UT_CF_FanOut_Setup(fsize);
+    memset(group->blocks, 0, sizeof(group->blocks));
+    for (i = 0; i < 3; ++i)
+    {
+        for (offset = 0; offset < fsize; offset += len)
+        {
+            len = ((fsize - offset) < sizeof(buf)) ? (fsize - offset) : sizeof(buf);
+            UtAssert_INT32_EQ(CF_FanOut_Read(group, offset, buf, len), len);
+        }
+    }
+    UtAssert_STUB_COUNT(CF_WrappedRead, 3 * nblocks);
+}
+
+void Test_CF_FanOut_GetCrc(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_FanOut_GetCrc(CF_FanOut_t *group, CF_Crc_t *crc, uint32 max_bytes);
+     */
+    CF_FanOut_t *group;
+    CF_Crc_t     crc;
+
+    /* checksum already complete, nothing to read */
+    group           = UT_CF_FanOut_Setup(100);
+    group->crc_offs = 100;
+    UtAssert_INT32_EQ(CF_FanOut_GetCrc(group, &crc, CF_FANOUT_CACHE_BLOCK_SIZE), CFE_SUCCESS);
+    UtAssert_STUB_COUNT(CF_WrappedRead, 0);
+    UtAssert_STUB_COUNT(CF_CRC_Finalize, 1);
+
+    /* the rest of the file is read in to complete it */
+    group           = UT_CF_FanOut_Setup(CF_FANOUT_CACHE_BLOCK_SIZE + 10);
+    group->crc_offs = 0;
+    memset(group->blocks, 0, sizeof(group->blocks));
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, CF_FANOUT_CACHE_BLOCK_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 2, CF_FANOUT_CACHE_BLOCK_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, 10);
+    UtAssert_INT32_EQ(CF_FanOut_GetCrc(group, &crc, 2 * CF_FANOUT_CACHE_BLOCK_SIZE), CFE_SUCCESS);
+    UtAssert_STUB_COUNT(CF_WrappedRead, 2);
+    UtAssert_STUB_COUNT(CF_CRC_Digest, 2);
+    UtAssert_STUB_COUNT(CF_CRC_Finalize, 2);
+    UtAssert_UINT32_EQ(group->crc_offs, CF_FANOUT_CACHE_BLOCK_SIZE + 10);
+
+    /* the same, a block per call: not done after the first */
+    group->crc_offs = 0;
+    memset(group->blocks, 0, sizeof(group->blocks));
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, CF_FANOUT_CACHE_BLOCK_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedLseek), 2, CF_FANOUT_CACHE_BLOCK_SIZE);
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, 10);
+    UtAssert_INT32_EQ(CF_FanOut_GetCrc(group, &crc, CF_FANOUT_CACHE_BLOCK_SIZE), CF_FANOUT_CRC_PENDING);
+    UtAssert_STUB_COUNT(CF_WrappedRead, 3);
+    UtAssert_STUB_COUNT(CF_CRC_Finalize, 2);
+    UtAssert_UINT32_EQ(group->crc_offs, CF_FANOUT_CACHE_BLOCK_SIZE);
+    UtAssert_INT32_EQ(CF_FanOut_GetCrc(group, &crc, CF_FANOUT_CACHE_BLOCK_SIZE), CFE_SUCCESS);
+    UtAssert_STUB_COUNT(CF_WrappedRead, 4);
+    UtAssert_STUB_COUNT(CF_CRC_Finalize, 3);
+    UtAssert_UINT32_EQ(group->crc_offs, CF_FANOUT_CACHE_BLOCK_SIZE + 10);
+
+    /* read error */
+    group->crc_offs = 0;
+    memset(group->blocks, 0, sizeof(group->blocks));
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedRead), 1, -1);
+    UtAssert_INT32_EQ(CF_FanOut_GetCrc(group, &crc, CF_FANOUT_CACHE_BLOCK_SIZE), CF_ERROR);
+    UtAssert_STUB_COUNT(CF_CRC_Finalize, 3);
+}
+
+/*******************************************************************************
+**
+**  cf_fanout_tests UtTest_Setup
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    TEST_CF_ADD(Test_CF_FanOut_Open);
+    TEST_CF_ADD(Test_CF_FanOut_Release);
+    TEST_CF_ADD(Test_CF_FanOut_Read);
+    TEST_CF_ADD(Test_CF_FanOut_Read_TakingTurns);
+    TEST_CF_ADD(Test_CF_FanOut_GetCrc);
+}
@@ -0,0 +1,84 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* cf testing includes */
+#include "cf_test_utils.h"
+#include "cf_filestore.h"
+#include "cf_memstore.h"
+
+/*******************************************************************************
+**
+**  cf_filestore_tests
+**
+*******************************************************************************/
+
+void Test_CF_Filestore_OsalLseek(void)
+{
+    /* Test case for:
+     * int32 CF_Filestore_OsalLseek(osal_id_t fd, off_t offset, int mode);
+     */
+    UT_SetDefaultReturnValue(UT_KEY(OS_lseek), 42);
+    UtAssert_INT32_EQ(CF_Filestore_OsalLseek(OS_OBJECT_ID_UNDEFINED, 42, OS_SEEK_SET), 42);
+    UtAssert_STUB_COUNT(OS_lseek, 1);
+}
+
+void Test_CF_Filestore_FromPath(void)
+{
+    /* Test case for:
+     * const CF_Filestore_t *CF_Filestore_FromPath(const char *fname);
+     */
+
+    /* plain path goes to OSAL */
+    UtAssert_ADDRESS_EQ(CF_Filestore_FromPath("/cf/file.dat"), &CF_Filestore_Osal);
+
+    /* prefix must match from the start */
+    UtAssert_ADDRESS_EQ(CF_Filestore_FromPath("/cf/cfmem/file.dat"), &CF_Filestore_Osal);
+
+    /* RAM filestore prefix */
+    UtAssert_ADDRESS_EQ(CF_Filestore_FromPath("/cfmem/file.dat"), &CF_Memstore_Filestore);
+}
+
+void Test_CF_Filestore_FromFd(void)
+{
+    /* Test case for:
+     * const CF_Filestore_t *CF_Filestore_FromFd(osal_id_t fd);
+     */
+    osal_id_t fd = OS_ObjectIdFromInteger(CF_MEMSTORE_FD_BASE);
+
+    /* not claimed by any mount */
+    UtAssert_ADDRESS_EQ(CF_Filestore_FromFd(fd), &CF_Filestore_Osal);
+    UtAssert_STUB_COUNT(CF_Memstore_OwnsFd, 1);
+
+    /* claimed by the RAM filestore */
+    UT_SetDefaultReturnValue(UT_KEY(CF_Memstore_OwnsFd), true);
+    UtAssert_ADDRESS_EQ(CF_Filestore_FromFd(fd), &CF_Memstore_Filestore);
+}
+
+/*******************************************************************************
+**
+**  cf_filestore_tests UtTest_Setup
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    TEST_CF_ADD(Test_CF_Filestore_OsalLseek);
+    TEST_CF_ADD(Test_CF_Filestore_FromPath);
+    TEST_CF_ADD(Test_CF_Filestore_FromFd);
+}
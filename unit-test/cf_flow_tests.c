@@ -0,0 +1,315 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* cf testing includes */
+#include "cf_test_utils.h"
+#include "cf_flow.h"
+
+/*******************************************************************************
+**
+**  cf_flow_tests local utility functions
+**
+*******************************************************************************/
+
+static CF_ConfigTable_t UT_FlowConfig;
+
+static void UT_CF_Flow_SetupConfig(uint32 chunk_size)
+{
+    memset(&UT_FlowConfig, 0, sizeof(UT_FlowConfig));
+    UT_FlowConfig.outgoing_file_chunk_size = chunk_size;
+    CF_AppData.config_table                = &UT_FlowConfig;
+}
+
+/*******************************************************************************
+**
+**  cf_flow_tests
+**
+*******************************************************************************/
+
+void Test_CF_Flow_FindPeer(void)
+{
+    /* Test case for:
+     * CF_FlowPeer_t *CF_Flow_FindPeer(CF_EntityId_t eid);
+     */
+    CF_FlowPeer_t *peer;
+    int            i;
+
+    /* allocate a new entry */
+    UtAssert_NOT_NULL(peer = CF_Flow_FindPeer(10));
+    UtAssert_ADDRESS_EQ(peer, &CF_AppData.engine.flow_peers[0]);
+    UtAssert_BOOL_TRUE(peer->in_use);
+    UtAssert_UINT32_EQ(peer->eid, 10);
+    UtAssert_UINT32_EQ(peer->window, CF_FLOW_MAX_WINDOW);
+
+    /* existing entry is found again, and its state is kept */
+    peer->sent = 100;
+    UtAssert_ADDRESS_EQ(CF_Flow_FindPeer(10), peer);
+    UtAssert_UINT32_EQ(peer->sent, 100);
+
+    /* a freed slot before the match must not hide the existing entry */
+    CF_AppData.engine.flow_peers[0].in_use = false;
+    CF_AppData.engine.flow_peers[1].in_use = true;
+    CF_AppData.engine.flow_peers[1].eid    = 11;
+    UtAssert_ADDRESS_EQ(CF_Flow_FindPeer(11), &CF_AppData.engine.flow_peers[1]);
+
+    /* table full */
+    for (i = 0; i < CF_NUM_FLOW_PEERS; ++i)
+    {
+        CF_AppData.engine.flow_peers[i].in_use = true;
+        CF_AppData.engine.flow_peers[i].eid    = 20 + i;
+    }
+    UtAssert_NULL(CF_Flow_FindPeer(10));
+}
+
+void Test_CF_Flow_LookupPeer(void)
+{
+    /* Test case for:
+     * CF_FlowPeer_t *CF_Flow_LookupPeer(CF_EntityId_t eid);
+     */
+
+    /* no entry is assigned by a lookup */
+    UtAssert_NULL(CF_Flow_LookupPeer(10));
+    UtAssert_BOOL_FALSE(CF_AppData.engine.flow_peers[0].in_use);
+
+    /* an entry that exists is found */
+    CF_AppData.engine.flow_peers[1].in_use = true;
+    CF_AppData.engine.flow_peers[1].eid    = 10;
+    UtAssert_ADDRESS_EQ(CF_Flow_LookupPeer(10), &CF_AppData.engine.flow_peers[1]);
+
+    /* a free entry with the same eid is not */
+    CF_AppData.engine.flow_peers[1].in_use = false;
+    UtAssert_NULL(CF_Flow_LookupPeer(10));
+}
+
+void Test_CF_Flow_Permit(void)
+{
+    /* Test case for:
+     * bool CF_Flow_Permit(const CF_FlowPeer_t *peer, uint32 bytes);
+     */
+    CF_FlowPeer_t peer;
+
+    memset(&peer, 0, sizeof(peer));
+
+    /* no peer entry is never throttled */
+    UtAssert_BOOL_TRUE(CF_Flow_Permit(NULL, 1000));
+
+    /* first PDU of a wakeup is always allowed */
+    peer.window = 100;
+    UtAssert_BOOL_TRUE(CF_Flow_Permit(&peer, 1000));
+
+    /* within window */
+    peer.sent = 50;
+    UtAssert_BOOL_TRUE(CF_Flow_Permit(&peer, 50));
+
+    /* beyond window */
+    UtAssert_BOOL_FALSE(CF_Flow_Permit(&peer, 51));
+}
+
+void Test_CF_Flow_Sent(void)
+{
+    /* Test case for:
+     * void CF_Flow_Sent(CF_FlowPeer_t *peer, uint32 bytes, bool acked);
+     */
+    CF_FlowPeer_t peer;
+
+    memset(&peer, 0, sizeof(peer));
+
+    /* NULL is a no-op */
+    UtAssert_VOIDCALL(CF_Flow_Sent(NULL, 100, true));
+
+    /* unacknowledged mode only counts against the window */
+    UtAssert_VOIDCALL(CF_Flow_Sent(&peer, 100, false));
+    UtAssert_UINT32_EQ(peer.sent, 100);
+    UtAssert_ZERO(peer.in_flight);
+
+    /* acknowledged mode is also in flight */
+    UtAssert_VOIDCALL(CF_Flow_Sent(&peer, 200, true));
+    UtAssert_UINT32_EQ(peer.sent, 300);
+    UtAssert_UINT32_EQ(peer.in_flight, 200);
+}
+
+void Test_CF_Flow_Feedback(void)
+{
+    /* Test case for:
+     * void CF_Flow_Feedback(CF_FlowPeer_t *peer, uint32 released, uint32 lost);
+     */
+    CF_FlowPeer_t peer;
+
+    memset(&peer, 0, sizeof(peer));
+
+    /* NULL is a no-op */
+    UtAssert_VOIDCALL(CF_Flow_Feedback(NULL, 100, 100));
+
+    /* nothing released and nothing lost does not change the estimate */
+    peer.loss = 80;
+    UtAssert_VOIDCALL(CF_Flow_Feedback(&peer, 0, 0));
+    UtAssert_UINT32_EQ(peer.loss, 80);
+    UtAssert_BOOL_FALSE(peer.loss_event);
+
+    /* loss below threshold, in_flight released */
+    peer.loss      = 0;
+    peer.in_flight = 1000;
+    UtAssert_VOIDCALL(CF_Flow_Feedback(&peer, 1000, 10));
+    UtAssert_ZERO(peer.in_flight);
+    UtAssert_UINT32_EQ(peer.loss, 10 / 8);
+    UtAssert_BOOL_FALSE(peer.loss_event);
+
+    /* loss above threshold, releasing more than is in flight clamps at zero */
+    peer.loss      = 0;
+    peer.in_flight = 100;
+    UtAssert_VOIDCALL(CF_Flow_Feedback(&peer, 1000, 500));
+    UtAssert_ZERO(peer.in_flight);
+    UtAssert_UINT32_EQ(peer.loss, 500 / 8);
+    UtAssert_BOOL_TRUE(peer.loss_event);
+
+    /* more lost than released counts as total loss */
+    peer.loss       = 0;
+    peer.loss_event = false;
+    UtAssert_VOIDCALL(CF_Flow_Feedback(&peer, 0, 100));
+    UtAssert_UINT32_EQ(peer.loss, 1000 / 8);
+    UtAssert_BOOL_TRUE(peer.loss_event);
+}
+
+void Test_CF_Flow_Release(void)
+{
+    /* Test case for:
+     * void CF_Flow_Release(CF_FlowPeer_t *peer, uint32 bytes);
+     */
+    CF_FlowPeer_t peer;
+
+    memset(&peer, 0, sizeof(peer));
+
+    /* NULL is a no-op */
+    UtAssert_VOIDCALL(CF_Flow_Release(NULL, 100));
+
+    peer.in_flight = 300;
+    UtAssert_VOIDCALL(CF_Flow_Release(&peer, 100));
+    UtAssert_UINT32_EQ(peer.in_flight, 200);
+
+    UtAssert_VOIDCALL(CF_Flow_Release(&peer, 1000));
+    UtAssert_ZERO(peer.in_flight);
+}
+
+void Test_CF_Flow_Cycle(void)
+{
+    /* Test case for:
+     * void CF_Flow_Cycle(void);
+     */
+    CF_FlowPeer_t *   peer;
+    CF_HkPeer_Data_t *hk;
+
+    peer = &CF_AppData.engine.flow_peers[0];
+    hk   = &CF_AppData.hk.Payload.peer_hk[0];
+
+    /* unused entries are published as zero */
+    UT_CF_Flow_SetupConfig(100);
+    memset(&CF_AppData.hk.Payload.peer_hk, 0xFF, sizeof(CF_AppData.hk.Payload.peer_hk));
+    UtAssert_VOIDCALL(CF_Flow_Cycle());
+    UtAssert_MemCmpValue(&CF_AppData.hk.Payload.peer_hk, 0, sizeof(CF_AppData.hk.Payload.peer_hk),
+                         "peer_hk cleared");
+
+    /* window was not the limit: no change, sent is reset, rate is smoothed */
+    peer->in_use    = true;
+    peer->eid       = 5;
+    peer->window    = 1000;
+    peer->sent      = 400;
+    peer->in_flight = 300;
+    peer->loss      = 7;
+    UtAssert_VOIDCALL(CF_Flow_Cycle());
+    UtAssert_UINT32_EQ(peer->window, 1000);
+    UtAssert_UINT32_EQ(peer->rate, 100);
+    UtAssert_ZERO(peer->sent);
+    UtAssert_UINT32_EQ(hk->eid, 5);
+    UtAssert_UINT32_EQ(hk->window, 1000);
+    UtAssert_UINT32_EQ(hk->rate, 100);
+    UtAssert_UINT32_EQ(hk->in_flight, 300);
+    UtAssert_UINT32_EQ(hk->loss, 7);
+
+    /* window was the limit and no loss: additive increase by one chunk */
+    peer->sent = 950;
+    UtAssert_VOIDCALL(CF_Flow_Cycle());
+    UtAssert_UINT32_EQ(peer->window, 1100);
+
+    /* loss event: multiplicative decrease from the achieved rate */
+    peer->rate       = 800;
+    peer->sent       = 800;
+    peer->loss_event = true;
+    UtAssert_VOIDCALL(CF_Flow_Cycle());
+    UtAssert_UINT32_EQ(peer->window, 400);
+    UtAssert_BOOL_FALSE(peer->loss_event);
+
+    /* loss event with no rate history uses the window itself, and is clamped at one chunk */
+    peer->rate       = 0;
+    peer->window     = 150;
+    peer->loss_event = true;
+    UtAssert_VOIDCALL(CF_Flow_Cycle());
+    UtAssert_UINT32_EQ(peer->window, 100);
+
+    /* additive increase is clamped at the maximum */
+    peer->window = CF_FLOW_MAX_WINDOW;
+    peer->sent   = CF_FLOW_MAX_WINDOW;
+    UtAssert_VOIDCALL(CF_Flow_Cycle());
+    UtAssert_UINT32_EQ(peer->window, CF_FLOW_MAX_WINDOW);
+
+    /* zero chunk size still yields a nonzero window */
+    UT_CF_Flow_SetupConfig(0);
+    peer->window     = 10;
+    peer->loss_event = true;
+    UtAssert_VOIDCALL(CF_Flow_Cycle());
+    UtAssert_UINT32_EQ(peer->window, 5);
+    peer->window     = 1;
+    peer->loss_event = true;
+    UtAssert_VOIDCALL(CF_Flow_Cycle());
+    UtAssert_UINT32_EQ(peer->window, 1);
+
+    /* anything in flight keeps the peer from going idle */
+    peer->idle      = CF_FLOW_PEER_IDLE_CYCLES - 1;
+    peer->in_flight = 1;
+    UtAssert_VOIDCALL(CF_Flow_Cycle());
+    UtAssert_ZERO(peer->idle);
+    UtAssert_BOOL_TRUE(peer->in_use);
+
+    /* a peer idle for long enough gives up its entry */
+    peer->idle      = CF_FLOW_PEER_IDLE_CYCLES - 2;
+    peer->in_flight = 0;
+    UtAssert_VOIDCALL(CF_Flow_Cycle());
+    UtAssert_BOOL_TRUE(peer->in_use);
+    UtAssert_UINT32_EQ(hk->eid, 5);
+    UtAssert_VOIDCALL(CF_Flow_Cycle());
+    UtAssert_BOOL_FALSE(peer->in_use);
+    UtAssert_ZERO(hk->eid);
+    UtAssert_NULL(CF_Flow_LookupPeer(5));
+}
+
+/*******************************************************************************
+**
+**  cf_flow_tests UtTest_Setup
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    TEST_CF_ADD(Test_CF_Flow_FindPeer);
+    TEST_CF_ADD(Test_CF_Flow_LookupPeer);
+    TEST_CF_ADD(Test_CF_Flow_Permit);
+    TEST_CF_ADD(Test_CF_Flow_Sent);
+    TEST_CF_ADD(Test_CF_Flow_Feedback);
+    TEST_CF_ADD(Test_CF_Flow_Release);
+    TEST_CF_ADD(Test_CF_Flow_Cycle);
+}
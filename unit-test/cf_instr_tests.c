@@ -0,0 +1,166 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* cf testing includes */
+#include "cf_test_utils.h"
+#include "cf_instr.h"
+
+/*******************************************************************************
+**
+**  cf_instr_tests
+**
+*******************************************************************************/
+
+void Test_CF_Instr_Init(void)
+{
+    /* Test case for:
+     * void CF_Instr_Init(void);
+     */
+    UtAssert_VOIDCALL(CF_Instr_Init());
+    UtAssert_STUB_COUNT(CFE_MSG_Init, 1);
+}
+
+void Test_CF_Instr_SetChannel(void)
+{
+    /* Test case for:
+     * void CF_Instr_SetChannel(uint8 chan_num);
+     */
+    UtAssert_VOIDCALL(CF_Instr_SetChannel(CF_NUM_CHANNELS - 1));
+    UtAssert_UINT32_EQ(CF_AppData.engine.instr_chan, CF_NUM_CHANNELS - 1);
+}
+
+void Test_CF_Instr_Start(void)
+{
+    /* Test case for:
+     * void CF_Instr_Start(OS_time_t *stamp);
+     */
+    OS_time_t stamp;
+
+    UtAssert_VOIDCALL(CF_Instr_Start(&stamp));
+    UtAssert_STUB_COUNT(OS_GetLocalTime, 1);
+}
+
+void Test_CF_Instr_Record(void)
+{
+    /* Test case for:
+     * void CF_Instr_Record(CF_InstrHist_t id, OS_time_t start);
+     */
+    CF_DiagHist_Data_t *hist;
+    OS_time_t           start;
+
+    CF_Instr_SetChannel(CF_NUM_CHANNELS - 1);
+    hist = &CF_AppData.diag.Payload.channel[CF_NUM_CHANNELS - 1].hist[CF_InstrHist_FREAD];
+
+    /* a start time in the future counts as no time at all */
+    OS_GetLocalTime(&start);
+    start = OS_TimeAdd(start, OS_TimeAssembleFromMilliseconds(100, 0));
+    UtAssert_VOIDCALL(CF_Instr_Record(CF_InstrHist_FREAD, start));
+    UtAssert_UINT32_EQ(hist->bucket[0], 1);
+    UtAssert_ZERO(hist->max_usec);
+    UtAssert_ZERO(CF_AppData.diag.Payload.channel[0].hist[CF_InstrHist_FREAD].bucket[0]);
+
+    /* anything beyond the second to last bucket goes in the last one */
+    OS_GetLocalTime(&start);
+    start = OS_TimeSubtract(start, OS_TimeAssembleFromMilliseconds(1000, 0));
+    UtAssert_VOIDCALL(CF_Instr_Record(CF_InstrHist_FREAD, start));
+    UtAssert_UINT32_EQ(hist->bucket[CF_INSTR_NUM_BUCKETS - 1], 1);
+    UtAssert_UINT32_GT(hist->max_usec, 1000000000);
+
+    /* samples too long for 32 bits are clamped */
+    OS_GetLocalTime(&start);
+    start = OS_TimeSubtract(start, OS_TimeAssembleFromMilliseconds(10000, 0));
+    UtAssert_VOIDCALL(CF_Instr_Record(CF_InstrHist_FREAD, start));
+    UtAssert_UINT32_EQ(hist->bucket[CF_INSTR_NUM_BUCKETS - 1], 2);
+    UtAssert_UINT32_EQ(hist->max_usec, UINT32_MAX);
+
+    /* a shorter sample does not lower the maximum, and bucket counts saturate */
+    hist->bucket[0] = UINT32_MAX;
+    OS_GetLocalTime(&start);
+    start = OS_TimeAdd(start, OS_TimeAssembleFromMilliseconds(100, 0));
+    UtAssert_VOIDCALL(CF_Instr_Record(CF_InstrHist_FREAD, start));
+    UtAssert_UINT32_EQ(hist->bucket[0], UINT32_MAX);
+    UtAssert_UINT32_EQ(hist->max_usec, UINT32_MAX);
+}
+
+void Test_CF_Instr_PduHist(void)
+{
+    /* Test case for:
+     * CF_InstrHist_t CF_Instr_PduHist(const CF_Logical_PduBuffer_t *ph);
+     */
+    CF_Logical_PduBuffer_t ph;
+
+    memset(&ph, 0, sizeof(ph));
+
+    ph.pdu_header.pdu_type = 1;
+    UtAssert_INT32_EQ(CF_Instr_PduHist(&ph), CF_InstrHist_RX_FD);
+
+    ph.pdu_header.pdu_type       = 0;
+    ph.fdirective.directive_code = CF_CFDP_FileDirective_METADATA;
+    UtAssert_INT32_EQ(CF_Instr_PduHist(&ph), CF_InstrHist_RX_MD);
+    ph.fdirective.directive_code = CF_CFDP_FileDirective_EOF;
+    UtAssert_INT32_EQ(CF_Instr_PduHist(&ph), CF_InstrHist_RX_EOF);
+    ph.fdirective.directive_code = CF_CFDP_FileDirective_FIN;
+    UtAssert_INT32_EQ(CF_Instr_PduHist(&ph), CF_InstrHist_RX_FIN);
+    ph.fdirective.directive_code = CF_CFDP_FileDirective_ACK;
+    UtAssert_INT32_EQ(CF_Instr_PduHist(&ph), CF_InstrHist_RX_ACK);
+    ph.fdirective.directive_code = CF_CFDP_FileDirective_NAK;
+    UtAssert_INT32_EQ(CF_Instr_PduHist(&ph), CF_InstrHist_RX_NAK);
+    ph.fdirective.directive_code = CF_CFDP_FileDirective_PROMPT;
+    UtAssert_INT32_EQ(CF_Instr_PduHist(&ph), CF_InstrHist_RX_OTHER);
+}
+
+void Test_CF_Instr_Reset(void)
+{
+    /* Test case for:
+     * void CF_Instr_Reset(void);
+     */
+    CF_AppData.diag.Payload.channel[0].hist[CF_InstrHist_CYCLE].bucket[1]                    = 1;
+    CF_AppData.diag.Payload.channel[CF_NUM_CHANNELS - 1].hist[CF_InstrHist_SB_ALLOC].max_usec = 1;
+
+    UtAssert_VOIDCALL(CF_Instr_Reset());
+    UtAssert_MemCmpValue(&CF_AppData.diag.Payload, 0, sizeof(CF_AppData.diag.Payload),
+                         "histograms were completely cleared to 0");
+}
+
+void Test_CF_Instr_SendDiag(void)
+{
+    /* Test case for:
+     * void CF_Instr_SendDiag(void);
+     */
+    UtAssert_VOIDCALL(CF_Instr_SendDiag());
+    UtAssert_STUB_COUNT(CFE_SB_TimeStampMsg, 1);
+    UtAssert_STUB_COUNT(CFE_SB_TransmitMsg, 1);
+}
+
+/*******************************************************************************
+**
+**  cf_instr_tests UtTest_Setup
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    TEST_CF_ADD(Test_CF_Instr_Init);
+    TEST_CF_ADD(Test_CF_Instr_SetChannel);
+    TEST_CF_ADD(Test_CF_Instr_Start);
+    TEST_CF_ADD(Test_CF_Instr_Record);
+    TEST_CF_ADD(Test_CF_Instr_PduHist);
+    TEST_CF_ADD(Test_CF_Instr_Reset);
+    TEST_CF_ADD(Test_CF_Instr_SendDiag);
+}
@@ -0,0 +1,391 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* cf testing includes */
+#include "cf_test_utils.h"
+#include "cf_memstore.h"
+
+/*******************************************************************************
+**
+**  cf_memstore_tests local utility functions
+**
+*******************************************************************************/
+
+#define UT_MEMSTORE_FNAME "/cfmem/file.dat"
+
+static osal_id_t UT_CF_Memstore_Create(const char *fname)
+{
+    osal_id_t fd;
+
+    UtAssert_INT32_EQ(CF_Memstore_OpenCreate(&fd, fname, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_READ_WRITE),
+                      OS_SUCCESS);
+
+    return fd;
+}
+
+/*******************************************************************************
+**
+**  cf_memstore_tests
+**
+*******************************************************************************/
+
+void Test_CF_Memstore_Attach(void)
+{
+    /* Test case for:
+     * int32 CF_Memstore_Attach(const char *fname, const void *buf, uint32 size);
+     */
+    static const uint8 buf[10] = {1, 2, 3};
+    char               longname[CF_FILENAME_MAX_LEN + 1];
+    CF_MemstoreFile_t *file;
+    osal_id_t          fd;
+    int                i;
+
+    UtAssert_INT32_EQ(CF_Memstore_Attach(UT_MEMSTORE_FNAME, buf, sizeof(buf)), OS_SUCCESS);
+    UtAssert_NOT_NULL(file = CF_Memstore_FindFile(UT_MEMSTORE_FNAME));
+    UtAssert_ADDRESS_EQ(file->data, buf);
+    UtAssert_UINT32_EQ(file->size, sizeof(buf));
+    UtAssert_BOOL_TRUE(file->read_only);
+
+    /* may be opened for read, but not for write */
+    UtAssert_INT32_EQ(CF_Memstore_OpenCreate(&fd, UT_MEMSTORE_FNAME, OS_FILE_FLAG_NONE, OS_READ_WRITE), OS_ERROR);
+    UtAssert_INT32_EQ(CF_Memstore_OpenCreate(&fd, UT_MEMSTORE_FNAME, OS_FILE_FLAG_NONE, OS_READ_ONLY), OS_SUCCESS);
+    UtAssert_INT32_EQ(CF_Memstore_Close(fd), OS_SUCCESS);
+
+    /* name taken */
+    UtAssert_INT32_EQ(CF_Memstore_Attach(UT_MEMSTORE_FNAME, buf, sizeof(buf)), OS_ERR_NAME_TAKEN);
+
+    /* name too long */
+    memset(longname, 'a', sizeof(longname) - 1);
+    longname[sizeof(longname) - 1] = 0;
+    UtAssert_INT32_EQ(CF_Memstore_Attach(longname, buf, sizeof(buf)), OS_FS_ERR_PATH_TOO_LONG);
+
+    /* no free file entries */
+    for (i = 0; i < CF_MEMSTORE_NUM_FILES; ++i)
+    {
+        CF_AppData.memstore.files[i].data = CF_AppData.memstore.pool[i];
+    }
+    UtAssert_INT32_EQ(CF_Memstore_Attach("/cfmem/other", buf, sizeof(buf)), OS_ERR_NO_FREE_IDS);
+}
+
+void Test_CF_Memstore_FindFile(void)
+{
+    /* Test case for:
+     * CF_MemstoreFile_t *CF_Memstore_FindFile(const char *fname);
+     */
+
+    UtAssert_NULL(CF_Memstore_FindFile(UT_MEMSTORE_FNAME));
+
+    /* an unused entry with a matching name is not a file */
+    strcpy(CF_AppData.memstore.files[0].name, UT_MEMSTORE_FNAME);
+    UtAssert_NULL(CF_Memstore_FindFile(UT_MEMSTORE_FNAME));
+
+    CF_AppData.memstore.files[CF_MEMSTORE_NUM_FILES - 1].data = CF_AppData.memstore.pool[0];
+    strcpy(CF_AppData.memstore.files[CF_MEMSTORE_NUM_FILES - 1].name, UT_MEMSTORE_FNAME);
+    UtAssert_ADDRESS_EQ(CF_Memstore_FindFile(UT_MEMSTORE_FNAME), &CF_AppData.memstore.files[CF_MEMSTORE_NUM_FILES - 1]);
+}
+
+void Test_CF_Memstore_GetHandle(void)
+{
+    /* Test case for:
+     * CF_MemstoreHandle_t *CF_Memstore_GetHandle(osal_id_t fd);
+     */
+    osal_id_t fd = OS_ObjectIdFromInteger(CF_MEMSTORE_FD_BASE + 1);
+
+    /* out of range */
+    UtAssert_NULL(CF_Memstore_GetHandle(OS_OBJECT_ID_UNDEFINED));
+
+    /* in range, but not open */
+    UtAssert_NULL(CF_Memstore_GetHandle(fd));
+
+    CF_AppData.memstore.handles[1].file = &CF_AppData.memstore.files[0];
+    UtAssert_ADDRESS_EQ(CF_Memstore_GetHandle(fd), &CF_AppData.memstore.handles[1]);
+}
+
+void Test_CF_Memstore_OpenCreate(void)
+{
+    /* Test case for:
+     * int32 CF_Memstore_OpenCreate(osal_id_t *fd, const char *fname, int32 flags, int32 access);
+     */
+    char      longname[CF_FILENAME_MAX_LEN + 1];
+    osal_id_t fd;
+    int       i;
+
+    /* missing and not created */
+    UtAssert_INT32_EQ(CF_Memstore_OpenCreate(&fd, UT_MEMSTORE_FNAME, OS_FILE_FLAG_NONE, OS_READ_ONLY),
+                      OS_ERR_NAME_NOT_FOUND);
+    UtAssert_BOOL_FALSE(OS_ObjectIdDefined(fd));
+
+    /* created in the pool */
+    fd = UT_CF_Memstore_Create(UT_MEMSTORE_FNAME);
+    UtAssert_UINT32_EQ(OS_ObjectIdToInteger(fd), CF_MEMSTORE_FD_BASE);
+    UtAssert_ADDRESS_EQ(CF_AppData.memstore.files[0].data, CF_AppData.memstore.pool[0]);
+    UtAssert_UINT32_EQ(CF_AppData.memstore.files[0].capacity, CF_MEMSTORE_FILE_SIZE);
+    UtAssert_BOOL_TRUE(CF_AppData.memstore.handles[0].writable);
+
+    /* opened again, existing content is kept unless truncated */
+    CF_AppData.memstore.files[0].size = 5;
+    UtAssert_INT32_EQ(CF_Memstore_OpenCreate(&fd, UT_MEMSTORE_FNAME, OS_FILE_FLAG_NONE, OS_READ_ONLY), OS_SUCCESS);
+    UtAssert_UINT32_EQ(OS_ObjectIdToInteger(fd), CF_MEMSTORE_FD_BASE + 1);
+    UtAssert_UINT32_EQ(CF_AppData.memstore.files[0].size, 5);
+    UtAssert_BOOL_FALSE(CF_AppData.memstore.handles[1].writable);
+    fd = UT_CF_Memstore_Create(UT_MEMSTORE_FNAME);
+    UtAssert_UINT32_EQ(CF_AppData.memstore.files[0].size, 0);
+
+    /* name too long */
+    memset(longname, 'a', sizeof(longname) - 1);
+    longname[sizeof(longname) - 1] = 0;
+    UtAssert_INT32_EQ(CF_Memstore_OpenCreate(&fd, longname, OS_FILE_FLAG_CREATE, OS_READ_WRITE),
+                      OS_FS_ERR_PATH_TOO_LONG);
+
+    /* pool full */
+    for (i = 0; i < CF_MEMSTORE_NUM_FILES; ++i)
+    {
+        CF_AppData.memstore.files[i].data = CF_AppData.memstore.pool[i];
+    }
+    UtAssert_INT32_EQ(CF_Memstore_OpenCreate(&fd, "/cfmem/other", OS_FILE_FLAG_CREATE, OS_READ_WRITE),
+                      OS_ERR_NAME_NOT_FOUND);
+
+    /* no free handles */
+    for (i = 0; i < CF_MEMSTORE_NUM_HANDLES; ++i)
+    {
+        CF_AppData.memstore.handles[i].file = &CF_AppData.memstore.files[0];
+    }
+    UtAssert_INT32_EQ(CF_Memstore_OpenCreate(&fd, UT_MEMSTORE_FNAME, OS_FILE_FLAG_NONE, OS_READ_ONLY),
+                      OS_ERR_NO_FREE_IDS);
+}
+
+void Test_CF_Memstore_Close(void)
+{
+    /* Test case for:
+     * int32 CF_Memstore_Close(osal_id_t fd);
+     */
+    osal_id_t fd;
+
+    UtAssert_INT32_EQ(CF_Memstore_Close(OS_ObjectIdFromInteger(CF_MEMSTORE_FD_BASE)), OS_ERR_INVALID_ID);
+
+    fd = UT_CF_Memstore_Create(UT_MEMSTORE_FNAME);
+    UtAssert_INT32_EQ(CF_Memstore_Close(fd), OS_SUCCESS);
+    UtAssert_NULL(CF_AppData.memstore.handles[0].file);
+
+    /* file stays after close */
+    UtAssert_NOT_NULL(CF_Memstore_FindFile(UT_MEMSTORE_FNAME));
+}
+
+void Test_CF_Memstore_ReadWrite(void)
+{
+    /* Test case for:
+     * int32 CF_Memstore_Read(osal_id_t fd, void *buf, size_t read_size);
+     * int32 CF_Memstore_Write(osal_id_t fd, const void *buf, size_t write_size);
+     */
+    static const uint8 wbuf[4] = {1, 2, 3, 4};
+    uint8              rbuf[8];
+    osal_id_t          bad = OS_ObjectIdFromInteger(CF_MEMSTORE_FD_BASE + 1);
+    osal_id_t          fd;
+
+    UtAssert_INT32_EQ(CF_Memstore_Read(bad, rbuf, sizeof(rbuf)), OS_ERR_INVALID_ID);
+    UtAssert_INT32_EQ(CF_Memstore_Write(bad, wbuf, sizeof(wbuf)), OS_ERR_INVALID_ID);
+
+    fd = UT_CF_Memstore_Create(UT_MEMSTORE_FNAME);
+    UtAssert_INT32_EQ(CF_Memstore_Write(fd, wbuf, sizeof(wbuf)), sizeof(wbuf));
+    UtAssert_UINT32_EQ(CF_AppData.memstore.files[0].size, sizeof(wbuf));
+
+    /* write past the end leaves a zero filled gap */
+    CF_AppData.memstore.files[0].data[5] = 0xff;
+    UtAssert_INT32_EQ(CF_Memstore_Lseek(fd, 6, OS_SEEK_SET), 6);
+    UtAssert_INT32_EQ(CF_Memstore_Write(fd, wbuf, 2), 2);
+    UtAssert_UINT32_EQ(CF_AppData.memstore.files[0].size, 8);
+
+    /* read it back, short read at the end */
+    UtAssert_INT32_EQ(CF_Memstore_Lseek(fd, 0, OS_SEEK_SET), 0);
+    memset(rbuf, 0xaa, sizeof(rbuf));
+    UtAssert_INT32_EQ(CF_Memstore_Read(fd, rbuf, 3), 3);
+    UtAssert_INT32_EQ(CF_Memstore_Read(fd, &rbuf[3], 10), 5);
+    UtAssert_INT32_EQ(CF_Memstore_Read(fd, rbuf, 1), 0);
+    UtAssert_UINT32_EQ(rbuf[3], 4);
+    UtAssert_UINT32_EQ(rbuf[4], 0);
+    UtAssert_UINT32_EQ(rbuf[5], 0);
+    UtAssert_UINT32_EQ(rbuf[7], 2);
+
+    /* read past the end */
+    UtAssert_INT32_EQ(CF_Memstore_Lseek(fd, 2, OS_SEEK_END), 10);
+    UtAssert_INT32_EQ(CF_Memstore_Read(fd, rbuf, 1), 0);
+
+    /* write is clipped to capacity */
+    UtAssert_INT32_EQ(CF_Memstore_Lseek(fd, CF_MEMSTORE_FILE_SIZE - 1, OS_SEEK_SET), CF_MEMSTORE_FILE_SIZE - 1);
+    UtAssert_INT32_EQ(CF_Memstore_Write(fd, wbuf, sizeof(wbuf)), 1);
+    UtAssert_UINT32_EQ(CF_AppData.memstore.files[0].size, CF_MEMSTORE_FILE_SIZE);
+
+    /* write on a read only handle */
+    UtAssert_INT32_EQ(CF_Memstore_OpenCreate(&fd, UT_MEMSTORE_FNAME, OS_FILE_FLAG_NONE, OS_READ_ONLY), OS_SUCCESS);
+    UtAssert_INT32_EQ(CF_Memstore_Write(fd, wbuf, sizeof(wbuf)), OS_ERROR);
+}
+
+void Test_CF_Memstore_Lseek(void)
+{
+    /* Test case for:
+     * int32 CF_Memstore_Lseek(osal_id_t fd, off_t offset, int mode);
+     */
+    osal_id_t fd;
+
+    UtAssert_INT32_EQ(CF_Memstore_Lseek(OS_ObjectIdFromInteger(CF_MEMSTORE_FD_BASE), 0, OS_SEEK_SET),
+                      OS_ERR_INVALID_ID);
+
+    fd                                = UT_CF_Memstore_Create(UT_MEMSTORE_FNAME);
+    CF_AppData.memstore.files[0].size = 100;
+
+    UtAssert_INT32_EQ(CF_Memstore_Lseek(fd, 10, OS_SEEK_SET), 10);
+    UtAssert_INT32_EQ(CF_Memstore_Lseek(fd, 5, OS_SEEK_CUR), 15);
+    UtAssert_INT32_EQ(CF_Memstore_Lseek(fd, -1, OS_SEEK_END), 99);
+
+    /* out of range, position is kept */
+    UtAssert_INT32_EQ(CF_Memstore_Lseek(fd, -1, OS_SEEK_SET), OS_ERROR);
+    UtAssert_INT32_EQ(CF_Memstore_Lseek(fd, CF_MEMSTORE_FILE_SIZE + 1, OS_SEEK_SET), OS_ERROR);
+    UtAssert_INT32_EQ(CF_Memstore_Lseek(fd, 0, -1), OS_ERROR);
+    UtAssert_UINT32_EQ(CF_AppData.memstore.handles[0].pos, 99);
+}
+
+void Test_CF_Memstore_Remove(void)
+{
+    /* Test case for:
+     * int32 CF_Memstore_Remove(const char *fname);
+     */
+    osal_id_t fd;
+
+    UtAssert_INT32_EQ(CF_Memstore_Remove(UT_MEMSTORE_FNAME), OS_ERR_NAME_NOT_FOUND);
+
+    /* open files are not removed */
+    fd = UT_CF_Memstore_Create(UT_MEMSTORE_FNAME);
+    UtAssert_INT32_EQ(CF_Memstore_Remove(UT_MEMSTORE_FNAME), OS_ERROR);
+    UtAssert_NOT_NULL(CF_Memstore_FindFile(UT_MEMSTORE_FNAME));
+
+    UtAssert_INT32_EQ(CF_Memstore_Close(fd), OS_SUCCESS);
+    UtAssert_INT32_EQ(CF_Memstore_Remove(UT_MEMSTORE_FNAME), OS_SUCCESS);
+    UtAssert_NULL(CF_Memstore_FindFile(UT_MEMSTORE_FNAME));
+    UtAssert_NULL(CF_AppData.memstore.files[0].data);
+}
+
+void Test_CF_Memstore_Rename(void)
+{
+    /* Test case for:
+     * int32 CF_Memstore_Rename(const char *old_filename, const char *new_filename);
+     */
+    static const uint8 buf[4] = {1, 2, 3, 4};
+    char               longname[CF_FILENAME_MAX_LEN + 1];
+    osal_id_t          fd;
+
+    memset(longname, 'a', sizeof(longname) - 1);
+    longname[sizeof(longname) - 1] = 0;
+
+    UtAssert_INT32_EQ(CF_Memstore_Rename(UT_MEMSTORE_FNAME, "/cfmem/other.dat"), OS_ERR_NAME_NOT_FOUND);
+
+    /* open files are not renamed */
+    fd = UT_CF_Memstore_Create(UT_MEMSTORE_FNAME);
+    UtAssert_INT32_EQ(CF_Memstore_Rename(UT_MEMSTORE_FNAME, "/cfmem/other.dat"), OS_ERROR);
+    UtAssert_INT32_EQ(CF_Memstore_Close(fd), OS_SUCCESS);
+
+    UtAssert_INT32_EQ(CF_Memstore_Rename(UT_MEMSTORE_FNAME, longname), OS_FS_ERR_PATH_TOO_LONG);
+    UtAssert_NOT_NULL(CF_Memstore_FindFile(UT_MEMSTORE_FNAME));
+
+    UtAssert_INT32_EQ(CF_Memstore_Rename(UT_MEMSTORE_FNAME, "/cfmem/other.dat"), OS_SUCCESS);
+    UtAssert_NULL(CF_Memstore_FindFile(UT_MEMSTORE_FNAME));
+    UtAssert_ADDRESS_EQ(CF_Memstore_FindFile("/cfmem/other.dat"), &CF_AppData.memstore.files[0]);
+
+    /* renaming onto itself changes nothing */
+    UtAssert_INT32_EQ(CF_Memstore_Rename("/cfmem/other.dat", "/cfmem/other.dat"), OS_SUCCESS);
+    UtAssert_ADDRESS_EQ(CF_Memstore_FindFile("/cfmem/other.dat"), &CF_AppData.memstore.files[0]);
+
+    /* an existing target is replaced, unless it is open */
+    UtAssert_INT32_EQ(CF_Memstore_Attach(UT_MEMSTORE_FNAME, buf, sizeof(buf)), OS_SUCCESS);
+    fd = UT_CF_Memstore_Create("/cfmem/other.dat");
+    UtAssert_INT32_EQ(CF_Memstore_Rename(UT_MEMSTORE_FNAME, "/cfmem/other.dat"), OS_ERROR);
+    UtAssert_INT32_EQ(CF_Memstore_Close(fd), OS_SUCCESS);
+    UtAssert_INT32_EQ(CF_Memstore_Rename(UT_MEMSTORE_FNAME, "/cfmem/other.dat"), OS_SUCCESS);
+    UtAssert_NULL(CF_Memstore_FindFile(UT_MEMSTORE_FNAME));
+    UtAssert_ADDRESS_EQ(CF_Memstore_FindFile("/cfmem/other.dat")->data, buf);
+    UtAssert_NULL(CF_AppData.memstore.files[0].data);
+}
+
+void Test_CF_Memstore_Stat(void)
+{
+    /* Test case for:
+     * int32 CF_Memstore_Stat(const char *path, os_fstat_t *filestats);
+     */
+    static const uint8 buf[4] = {1, 2, 3, 4};
+    os_fstat_t         fst;
+    osal_id_t          fd;
+
+    UtAssert_INT32_EQ(CF_Memstore_Stat(UT_MEMSTORE_FNAME, &fst), OS_ERR_NAME_NOT_FOUND);
+
+    fd = UT_CF_Memstore_Create(UT_MEMSTORE_FNAME);
+    UtAssert_INT32_EQ(CF_Memstore_Write(fd, buf, sizeof(buf)), sizeof(buf));
+    UtAssert_INT32_EQ(CF_Memstore_Stat(UT_MEMSTORE_FNAME, &fst), OS_SUCCESS);
+    UtAssert_UINT32_EQ(OS_FILESTAT_SIZE(fst), sizeof(buf));
+    UtAssert_BOOL_FALSE(OS_FILESTAT_ISDIR(fst));
+    UtAssert_UINT32_EQ(OS_FILESTAT_MODE(fst), OS_FILESTAT_MODE_READ | OS_FILESTAT_MODE_WRITE);
+
+    /* attached files are read-only */
+    UtAssert_INT32_EQ(CF_Memstore_Attach("/cfmem/other.dat", buf, 3), OS_SUCCESS);
+    UtAssert_INT32_EQ(CF_Memstore_Stat("/cfmem/other.dat", &fst), OS_SUCCESS);
+    UtAssert_UINT32_EQ(OS_FILESTAT_SIZE(fst), 3);
+    UtAssert_UINT32_EQ(OS_FILESTAT_MODE(fst), OS_FILESTAT_MODE_READ);
+}
+
+void Test_CF_Memstore_OwnsFd(void)
+{
+    /* Test case for:
+     * bool CF_Memstore_OwnsFd(osal_id_t fd);
+     */
+    UtAssert_BOOL_FALSE(CF_Memstore_OwnsFd(OS_OBJECT_ID_UNDEFINED));
+    UtAssert_BOOL_FALSE(CF_Memstore_OwnsFd(OS_ObjectIdFromInteger(CF_MEMSTORE_FD_BASE - 1)));
+    UtAssert_BOOL_TRUE(CF_Memstore_OwnsFd(OS_ObjectIdFromInteger(CF_MEMSTORE_FD_BASE)));
+    UtAssert_BOOL_TRUE(CF_Memstore_OwnsFd(OS_ObjectIdFromInteger(CF_MEMSTORE_FD_BASE + CF_MEMSTORE_NUM_HANDLES - 1)));
+    UtAssert_BOOL_FALSE(CF_Memstore_OwnsFd(OS_ObjectIdFromInteger(CF_MEMSTORE_FD_BASE + CF_MEMSTORE_NUM_HANDLES)));
+}
+
+void Test_CF_Memstore_Filestore(void)
+{
+    /* the table must point at this module */
+    UtAssert_ADDRESS_EQ(CF_Memstore_Filestore.OpenCreate, CF_Memstore_OpenCreate);
+    UtAssert_ADDRESS_EQ(CF_Memstore_Filestore.Remove, CF_Memstore_Remove);
+    UtAssert_ADDRESS_EQ(CF_Memstore_Filestore.Rename, CF_Memstore_Rename);
+    UtAssert_ADDRESS_EQ(CF_Memstore_Filestore.Stat, CF_Memstore_Stat);
+    UtAssert_ADDRESS_EQ(CF_Memstore_Filestore.OwnsFd, CF_Memstore_OwnsFd);
+}
+
+/*******************************************************************************
+**
+**  cf_memstore_tests UtTest_Setup
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    TEST_CF_ADD(Test_CF_Memstore_Attach);
+    TEST_CF_ADD(Test_CF_Memstore_FindFile);
+    TEST_CF_ADD(Test_CF_Memstore_GetHandle);
+    TEST_CF_ADD(Test_CF_Memstore_OpenCreate);
+    TEST_CF_ADD(Test_CF_Memstore_Close);
+    TEST_CF_ADD(Test_CF_Memstore_ReadWrite);
+    TEST_CF_ADD(Test_CF_Memstore_Lseek);
+    TEST_CF_ADD(Test_CF_Memstore_Remove);
+    TEST_CF_ADD(Test_CF_Memstore_Rename);
+    TEST_CF_ADD(Test_CF_Memstore_Stat);
+    TEST_CF_ADD(Test_CF_Memstore_OwnsFd);
+    TEST_CF_ADD(Test_CF_Memstore_Filestore);
+}
@@ -0,0 +1,280 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* cf testing includes */
+#include "cf_test_utils.h"
+#include "cf_trace.h"
+#include "cf_events.h"
+
+/*******************************************************************************
+**
+**  cf_trace_tests local utility functions
+**
+*******************************************************************************/
+
+/* a write of every byte asked for */
+static void UT_AltHandler_CF_WrappedWrite_All(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CFE_Status_t retval = (CFE_Status_t)UT_Hook_GetArgValueByName(Context, "write_size", size_t);
+
+    UT_Stub_SetReturnValue(FuncKey, retval);
+}
+
+static void UT_CF_Trace_Fill(uint32 count)
+{
+    uint32 i;
+
+    for (i = 0; i < count; ++i)
+    {
+        CF_Trace_Record(CF_TraceEvent_PDU_TX, 0, i, 0, 0, 0, 0);
+    }
+}
+
+/*******************************************************************************
+**
+**  cf_trace_tests
+**
+*******************************************************************************/
+
+void Test_CF_Trace_Record(void)
+{
+    /* Test case for:
+     * void CF_Trace_Record(CF_TraceEvent_t event, uint8 chan_num, uint32 seq_num, uint8 code, uint8 sub_code,
+     *                      uint32 offset, uint16 length);
+     */
+    CF_TraceEntry_t *entry = &CF_AppData.trace.ring[0];
+
+    UtAssert_VOIDCALL(CF_Trace_Record(CF_TraceEvent_STATE, 1, 2, 3, 4, 5, 6));
+    UtAssert_UINT32_EQ(CF_AppData.trace.head, 1);
+    UtAssert_BOOL_FALSE(CF_AppData.trace.full);
+    UtAssert_UINT32_EQ(entry->event, CF_TraceEvent_STATE);
+    UtAssert_UINT32_EQ(entry->chan_num, 1);
+    UtAssert_UINT32_EQ(entry->seq_num, 2);
+    UtAssert_UINT32_EQ(entry->code, 3);
+    UtAssert_UINT32_EQ(entry->sub_code, 4);
+    UtAssert_UINT32_EQ(entry->offset, 5);
+    UtAssert_UINT32_EQ(entry->length, 6);
+    UtAssert_STUB_COUNT(OS_GetLocalTime, 1);
+
+    /* filling the ring wraps it, and the next entry overwrites the oldest */
+    UT_CF_Trace_Fill(CF_TRACE_RING_ENTRIES - 1);
+    UtAssert_UINT32_EQ(CF_AppData.trace.head, CF_TRACE_RING_ENTRIES);
+    UtAssert_BOOL_TRUE(CF_AppData.trace.full);
+    UtAssert_VOIDCALL(CF_Trace_Record(CF_TraceEvent_TIMER, 0, 7, 0, 0, 0, 0));
+    UtAssert_UINT32_EQ(entry->event, CF_TraceEvent_TIMER);
+    UtAssert_UINT32_EQ(entry->seq_num, 7);
+
+    /* the entry count wrapping does not upset the ring */
+    CF_AppData.trace.head = UINT32_MAX;
+    UtAssert_VOIDCALL(CF_Trace_Record(CF_TraceEvent_STALL, 0, 8, 0, 0, 0, 0));
+    UtAssert_UINT32_EQ(CF_AppData.trace.ring[CF_TRACE_RING_ENTRIES - 1].seq_num, 8);
+    UtAssert_ZERO(CF_AppData.trace.head);
+}
+
+void Test_CF_Trace_Pdu(void)
+{
+    /* Test case for:
+     * void CF_Trace_Pdu(CF_TraceEvent_t event, uint8 chan_num, const CF_Logical_PduBuffer_t *ph);
+     */
+    CF_Logical_PduBuffer_t ph;
+    CF_TraceEntry_t *      entry;
+
+    memset(&ph, 0, sizeof(ph));
+
+    /* file data */
+    ph.pdu_header.pdu_type     = 1;
+    ph.pdu_header.sequence_num = 12;
+    ph.int_header.fd.offset    = 1000;
+    ph.int_header.fd.data_len  = 200;
+    UtAssert_VOIDCALL(CF_Trace_Pdu(CF_TraceEvent_PDU_RX, 1, &ph));
+    entry = &CF_AppData.trace.ring[0];
+    UtAssert_UINT32_EQ(entry->event, CF_TraceEvent_PDU_RX);
+    UtAssert_UINT32_EQ(entry->chan_num, 1);
+    UtAssert_UINT32_EQ(entry->seq_num, 12);
+    UtAssert_ZERO(entry->code);
+    UtAssert_UINT32_EQ(entry->offset, 1000);
+    UtAssert_UINT32_EQ(entry->length, 200);
+
+    /* directive */
+    ph.pdu_header.pdu_type            = 0;
+    ph.pdu_header.data_encoded_length = 9;
+    ph.fdirective.directive_code      = CF_CFDP_FileDirective_EOF;
+    UtAssert_VOIDCALL(CF_Trace_Pdu(CF_TraceEvent_PDU_TX, 0, &ph));
+    entry = &CF_AppData.trace.ring[1];
+    UtAssert_UINT32_EQ(entry->event, CF_TraceEvent_PDU_TX);
+    UtAssert_UINT32_EQ(entry->code, CF_CFDP_FileDirective_EOF);
+    UtAssert_ZERO(entry->offset);
+    UtAssert_UINT32_EQ(entry->length, 9);
+}
+
+void Test_CF_Trace_SaveState_CheckState(void)
+{
+    /* Test case for:
+     * void CF_Trace_SaveState(CF_TraceState_t *saved, const CF_Transaction_t *txn);
+     * void CF_Trace_CheckState(const CF_TraceState_t *saved, const CF_Transaction_t *txn);
+     */
+    CF_Transaction_t txn;
+    CF_History_t     history;
+    CF_TraceState_t  saved;
+    CF_TraceEntry_t *entry = &CF_AppData.trace.ring[0];
+
+    memset(&txn, 0, sizeof(txn));
+    memset(&history, 0, sizeof(history));
+    history.seq_num = 33;
+    txn.chan_num    = 1;
+
+    /* no change, no entry */
+    txn.state   = CF_TxnState_S2;
+    txn.history = &history;
+    UtAssert_VOIDCALL(CF_Trace_SaveState(&saved, &txn));
+    UtAssert_VOIDCALL(CF_Trace_CheckState(&saved, &txn));
+    UtAssert_ZERO(CF_AppData.trace.head);
+
+    /* a change of sub state is an entry */
+    txn.state_data.send.sub_state = CF_TxSubState_WAIT_FOR_EOF_ACK;
+    UtAssert_VOIDCALL(CF_Trace_CheckState(&saved, &txn));
+    UtAssert_UINT32_EQ(CF_AppData.trace.head, 1);
+    UtAssert_UINT32_EQ(entry->event, CF_TraceEvent_STATE);
+    UtAssert_UINT32_EQ(entry->code, CF_TxnState_S2);
+    UtAssert_UINT32_EQ(entry->sub_code, CF_TxSubState_WAIT_FOR_EOF_ACK);
+    UtAssert_UINT32_EQ(entry->seq_num, 33);
+
+    /* an idle transaction that starts takes the sequence number of its new history */
+    memset(&txn, 0, sizeof(txn));
+    txn.state = CF_TxnState_IDLE;
+    UtAssert_VOIDCALL(CF_Trace_SaveState(&saved, &txn));
+    txn.state                        = CF_TxnState_R2;
+    txn.state_data.receive.sub_state = CF_RxSubState_FILEDATA;
+    txn.history                      = &history;
+    history.seq_num                  = 44;
+    UtAssert_VOIDCALL(CF_Trace_CheckState(&saved, &txn));
+    entry = &CF_AppData.trace.ring[1];
+    UtAssert_UINT32_EQ(entry->code, CF_TxnState_R2);
+    UtAssert_UINT32_EQ(entry->seq_num, 44);
+
+    /* a transaction that finishes keeps the sequence number it had */
+    UtAssert_VOIDCALL(CF_Trace_SaveState(&saved, &txn));
+    txn.state       = CF_TxnState_IDLE;
+    history.seq_num = 55;
+    UtAssert_VOIDCALL(CF_Trace_CheckState(&saved, &txn));
+    entry = &CF_AppData.trace.ring[2];
+    UtAssert_UINT32_EQ(entry->code, CF_TxnState_IDLE);
+    UtAssert_ZERO(entry->sub_code);
+    UtAssert_UINT32_EQ(entry->seq_num, 44);
+}
+
+void Test_CF_Trace_StartDump(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_Trace_StartDump(const char *filename);
+     */
+
+    /* a dump in progress */
+    CF_AppData.trace.dumping = true;
+    UtAssert_INT32_EQ(CF_Trace_StartDump("trace"), CF_ERROR);
+    UtAssert_STUB_COUNT(CF_WrappedOpenCreate, 0);
+
+    /* failure to open */
+    CF_AppData.trace.dumping = false;
+    UT_SetDeferredRetcode(UT_KEY(CF_WrappedOpenCreate), 1, -1);
+    UtAssert_INT32_EQ(CF_Trace_StartDump("trace"), CF_ERROR);
+    UtAssert_BOOL_FALSE(CF_AppData.trace.dumping);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 0);
+
+    /* failure to write the header */
+    UtAssert_INT32_EQ(CF_Trace_StartDump("trace"), CF_ERROR);
+    UtAssert_BOOL_FALSE(CF_AppData.trace.dumping);
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+
+    /* nominal, before the ring has wrapped */
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedWrite), UT_AltHandler_CF_WrappedWrite_All, NULL);
+    UT_CF_Trace_Fill(10);
+    UtAssert_INT32_EQ(CF_Trace_StartDump("trace"), CFE_SUCCESS);
+    UtAssert_BOOL_TRUE(CF_AppData.trace.dumping);
+    UtAssert_ZERO(CF_AppData.trace.dump_next);
+    UtAssert_UINT32_EQ(CF_AppData.trace.dump_end, 10);
+
+    /* nominal, after the ring has wrapped */
+    CF_AppData.trace.dumping = false;
+    UT_CF_Trace_Fill(CF_TRACE_RING_ENTRIES);
+    UtAssert_INT32_EQ(CF_Trace_StartDump("trace"), CFE_SUCCESS);
+    UtAssert_UINT32_EQ(CF_AppData.trace.dump_next, 10);
+    UtAssert_UINT32_EQ(CF_AppData.trace.dump_end, CF_TRACE_RING_ENTRIES + 10);
+}
+
+void Test_CF_Trace_DumpCycle(void)
+{
+    /* Test case for:
+     * void CF_Trace_DumpCycle(void);
+     */
+
+    /* nothing to do when not dumping */
+    UtAssert_VOIDCALL(CF_Trace_DumpCycle());
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 0);
+
+    /* a dump is written a wakeup's worth at a time, split where the ring wraps */
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedWrite), UT_AltHandler_CF_WrappedWrite_All, NULL);
+    UT_CF_Trace_Fill(CF_TRACE_RING_ENTRIES + 1);
+    UtAssert_INT32_EQ(CF_Trace_StartDump("trace"), CFE_SUCCESS);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 1);
+    UtAssert_VOIDCALL(CF_Trace_DumpCycle());
+    UtAssert_BOOL_TRUE(CF_AppData.trace.dumping);
+    UtAssert_UINT32_EQ(CF_AppData.trace.dump_next, 1 + CF_TRACE_DUMP_ENTRIES_PER_WAKEUP);
+    UtAssert_STUB_COUNT(CF_WrappedWrite, 2);
+    while (CF_AppData.trace.dumping)
+    {
+        CF_Trace_DumpCycle();
+    }
+    UtAssert_STUB_COUNT(CF_WrappedWrite,
+                        2 + ((CF_TRACE_RING_ENTRIES + CF_TRACE_DUMP_ENTRIES_PER_WAKEUP - 1) /
+                             CF_TRACE_DUMP_ENTRIES_PER_WAKEUP));
+    UtAssert_STUB_COUNT(CF_WrappedClose, 1);
+    UT_CF_AssertEventID(CF_TRACE_DUMP_INF_EID);
+    UtAssert_ZERO(CF_AppData.trace.dump_lost);
+
+    /* entries overwritten before being written are skipped */
+    UtAssert_INT32_EQ(CF_Trace_StartDump("trace"), CFE_SUCCESS);
+    UT_CF_Trace_Fill(CF_TRACE_RING_ENTRIES + 5);
+    UtAssert_VOIDCALL(CF_Trace_DumpCycle());
+    UtAssert_BOOL_FALSE(CF_AppData.trace.dumping);
+    UtAssert_UINT32_EQ(CF_AppData.trace.dump_lost, CF_TRACE_RING_ENTRIES);
+
+    /* failure to write */
+    UtAssert_INT32_EQ(CF_Trace_StartDump("trace"), CFE_SUCCESS);
+    UT_SetHandlerFunction(UT_KEY(CF_WrappedWrite), NULL, NULL);
+    UT_SetDefaultReturnValue(UT_KEY(CF_WrappedWrite), -1);
+    UtAssert_VOIDCALL(CF_Trace_DumpCycle());
+    UtAssert_BOOL_FALSE(CF_AppData.trace.dumping);
+    UT_CF_AssertEventID(CF_TRACE_DUMP_ERR_EID);
+}
+
+/*******************************************************************************
+**
+**  cf_trace_tests UtTest_Setup
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    TEST_CF_ADD(Test_CF_Trace_Record);
+    TEST_CF_ADD(Test_CF_Trace_Pdu);
+    TEST_CF_ADD(Test_CF_Trace_SaveState_CheckState);
+    TEST_CF_ADD(Test_CF_Trace_StartDump);
+    TEST_CF_ADD(Test_CF_Trace_DumpCycle);
+}
@@ -0,0 +1,174 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/* cf testing includes */
+#include "cf_test_utils.h"
+#include "cf_events.h"
+#include "cf_udpintf.h"
+
+/*******************************************************************************
+**
+**  cf_udpintf_tests local utility functions
+**
+*******************************************************************************/
+
+static CF_ConfigTable_t UT_UdpConfig;
+
+static void UT_CF_UdpIntf_SetupConfig(void)
+{
+    memset(&UT_UdpConfig, 0, sizeof(UT_UdpConfig));
+    UT_UdpConfig.chan[UT_CFDP_CHANNEL].udp_local_port = 1234;
+    UT_UdpConfig.chan[UT_CFDP_CHANNEL].udp_peer_port  = 5678;
+    strcpy(UT_UdpConfig.chan[UT_CFDP_CHANNEL].udp_peer_addr, "127.0.0.1");
+    CF_AppData.config_table = &UT_UdpConfig;
+}
+
+/*******************************************************************************
+**
+**  cf_udpintf_tests
+**
+*******************************************************************************/
+
+void Test_CF_UdpIntf_Open(void)
+{
+    /* Test case for:
+     * CFE_Status_t CF_UdpIntf_Open(uint8 chan_num);
+     */
+    static const UT_EntryKey_t FAIL_KEYS[] = {UT_KEY(OS_SocketOpen), UT_KEY(OS_SocketAddrInit),
+                                              UT_KEY(OS_SocketAddrSetPort), UT_KEY(OS_SocketBind),
+                                              UT_KEY(OS_SocketAddrFromString)};
+    int i;
+
+    /* nominal */
+    UT_CF_UdpIntf_SetupConfig();
+    UtAssert_INT32_EQ(CF_UdpIntf_Open(UT_CFDP_CHANNEL), OS_SUCCESS);
+    UtAssert_STUB_COUNT(OS_SocketBind, 1);
+    UtAssert_STUB_COUNT(OS_SocketAddrFromString, 1);
+    UtAssert_STUB_COUNT(OS_SocketAddrSetPort, 2);
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+
+    /* any failure sends an event and leaves the socket closed */
+    for (i = 0; i < (sizeof(FAIL_KEYS) / sizeof(FAIL_KEYS[0])); ++i)
+    {
+        UT_CF_ResetEventCapture();
+        UT_CF_UdpIntf_SetupConfig();
+        CF_AppData.engine.udp.sock_id[UT_CFDP_CHANNEL] = OS_OBJECT_ID_UNDEFINED;
+        UT_SetDefaultReturnValue(FAIL_KEYS[i], OS_ERROR);
+        UtAssert_INT32_EQ(CF_UdpIntf_Open(UT_CFDP_CHANNEL), OS_ERROR);
+        UT_CF_AssertEventID(CF_INIT_UDP_ERR_EID);
+        UtAssert_BOOL_FALSE(OS_ObjectIdDefined(CF_AppData.engine.udp.sock_id[UT_CFDP_CHANNEL]));
+        UT_ResetState(FAIL_KEYS[i]);
+    }
+}
+
+void Test_CF_UdpIntf_Close(void)
+{
+    /* Test case for:
+     * void CF_UdpIntf_Close(uint8 chan_num);
+     */
+
+    /* not open */
+    UtAssert_VOIDCALL(CF_UdpIntf_Close(UT_CFDP_CHANNEL));
+    UtAssert_STUB_COUNT(OS_close, 0);
+
+    /* open */
+    CF_AppData.engine.udp.sock_id[UT_CFDP_CHANNEL] = OS_ObjectIdFromInteger(1);
+    UtAssert_VOIDCALL(CF_UdpIntf_Close(UT_CFDP_CHANNEL));
+    UtAssert_STUB_COUNT(OS_close, 1);
+    UtAssert_BOOL_FALSE(OS_ObjectIdDefined(CF_AppData.engine.udp.sock_id[UT_CFDP_CHANNEL]));
+}
+
+void Test_CF_UdpIntf_GetBuffer(void)
+{
+    /* Test case for:
+     * void *CF_UdpIntf_GetBuffer(uint8 chan_num, size_t *encap_hdr_size);
+     */
+    size_t encap_hdr_size = 1;
+
+    UtAssert_ADDRESS_EQ(CF_UdpIntf_GetBuffer(UT_CFDP_CHANNEL, &encap_hdr_size), CF_AppData.engine.udp.tx_buf);
+    UtAssert_UINT32_EQ(encap_hdr_size, 0);
+}
+
+void Test_CF_UdpIntf_ReleaseBuffer(void)
+{
+    /* Test case for:
+     * void CF_UdpIntf_ReleaseBuffer(uint8 chan_num, void *buf);
+     */
+    UtAssert_VOIDCALL(CF_UdpIntf_ReleaseBuffer(UT_CFDP_CHANNEL, CF_AppData.engine.udp.tx_buf));
+}
+
+void Test_CF_UdpIntf_Send(void)
+{
+    /* Test case for:
+     * void CF_UdpIntf_Send(uint8 chan_num, void *buf, size_t pdu_size);
+     */
+    UtAssert_VOIDCALL(CF_UdpIntf_Send(UT_CFDP_CHANNEL, CF_AppData.engine.udp.tx_buf, 10));
+    UtAssert_STUB_COUNT(OS_SocketSendTo, 1);
+
+    /* errors are not reported */
+    UT_SetDeferredRetcode(UT_KEY(OS_SocketSendTo), 1, OS_ERROR);
+    UtAssert_VOIDCALL(CF_UdpIntf_Send(UT_CFDP_CHANNEL, CF_AppData.engine.udp.tx_buf, 10));
+    UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
+}
+
+void Test_CF_UdpIntf_ReceiveBatch(void)
+{
+    /* Test case for:
+     * uint32 CF_UdpIntf_ReceiveBatch(uint8 chan_num, CF_TransportRxMsg_t *msgs, uint32 max_msgs);
+     */
+    CF_TransportRxMsg_t msgs[CF_TRANSPORT_RX_BATCH_SIZE];
+
+    /* socket not open */
+    UtAssert_UINT32_EQ(CF_UdpIntf_ReceiveBatch(UT_CFDP_CHANNEL, msgs, CF_TRANSPORT_RX_BATCH_SIZE), 0);
+    UtAssert_STUB_COUNT(OS_SocketRecvFrom, 0);
+
+    /* two waiting */
+    CF_AppData.engine.udp.sock_id[UT_CFDP_CHANNEL] = OS_ObjectIdFromInteger(1);
+    UT_SetDeferredRetcode(UT_KEY(OS_SocketRecvFrom), 1, 100);
+    UT_SetDeferredRetcode(UT_KEY(OS_SocketRecvFrom), 1, 200);
+    UT_SetDeferredRetcode(UT_KEY(OS_SocketRecvFrom), 1, OS_ERROR_TIMEOUT);
+    UtAssert_UINT32_EQ(CF_UdpIntf_ReceiveBatch(UT_CFDP_CHANNEL, msgs, CF_TRANSPORT_RX_BATCH_SIZE), 2);
+    UtAssert_ADDRESS_EQ(msgs[0].buf, CF_AppData.engine.in.rx_buf[0]);
+    UtAssert_UINT32_EQ(msgs[0].encap_hdr_size, 0);
+    UtAssert_UINT32_EQ(msgs[0].total_size, 100);
+    UtAssert_ADDRESS_EQ(msgs[1].buf, CF_AppData.engine.in.rx_buf[1]);
+    UtAssert_UINT32_EQ(msgs[1].total_size, 200);
+    UtAssert_STUB_COUNT(OS_SocketRecvFrom, 3);
+
+    /* limited by max_msgs */
+    UT_SetDefaultReturnValue(UT_KEY(OS_SocketRecvFrom), 50);
+    UtAssert_UINT32_EQ(CF_UdpIntf_ReceiveBatch(UT_CFDP_CHANNEL, msgs, 1), 1);
+    UtAssert_STUB_COUNT(OS_SocketRecvFrom, 4);
+}
+
+/*******************************************************************************
+**
+**  cf_udpintf_tests UtTest_Setup
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    TEST_CF_ADD(Test_CF_UdpIntf_Open);
+    TEST_CF_ADD(Test_CF_UdpIntf_Close);
+    TEST_CF_ADD(Test_CF_UdpIntf_GetBuffer);
+    TEST_CF_ADD(Test_CF_UdpIntf_ReleaseBuffer);
+    TEST_CF_ADD(Test_CF_UdpIntf_Send);
+    TEST_CF_ADD(Test_CF_UdpIntf_ReceiveBatch);
+}
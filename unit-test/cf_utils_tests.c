@@ -22,6 +22,8 @@
 #include "cf_test_alt_handler.h"
 #include "cf_utils.h"
 #include "cf_events.h"
+#include "cf_filestore.h"
+#include "cf_memstore.h"
 
 /* A value that may be passed to stubs accepting osal_id_t values */
 #define UT_CF_OS_OBJID OS_ObjectIdFromInteger(1)
@@ -152,11 +154,20 @@ void Test_CF_FindUnusedTransaction(void)
 
     UtAssert_NULL(CF_FindUnusedTransaction(chan));
 
+    /* a reused history slot starts a fresh performance record */
+    hist.perf.file_bytes = 5;
+    hist.perf.pdus_sent  = 6;
+    hist.waiting         = true;
+
     chan->qs[CF_QueueIdx_FREE]      = &txn.cl_node;
     chan->qs[CF_QueueIdx_HIST_FREE] = &hist.cl_node;
     chan->qs[CF_QueueIdx_HIST]      = NULL;
     UtAssert_ADDRESS_EQ(CF_FindUnusedTransaction(chan), &txn);
     UtAssert_ADDRESS_EQ(txn.history, &hist);
+    UtAssert_ZERO(hist.perf.file_bytes);
+    UtAssert_ZERO(hist.perf.pdus_sent);
+    UtAssert_BOOL_FALSE(hist.waiting);
+    UtAssert_STUB_COUNT(CFE_TIME_GetTime, 1);
 
     chan->qs[CF_QueueIdx_FREE]      = &txn.cl_node;
     chan->qs[CF_QueueIdx_HIST_FREE] = NULL;
@@ -533,16 +544,25 @@ void Test_CF_WriteHistoryEntryToFile(void)
      */
     osal_id_t    arg_fd = OS_ObjectIdFromInteger(1);
     CF_History_t history;
+    const char * perf_line = "PERF: START 3 END 9 BYTES 1000 RETX 0 NAK 2/5 PDU 0/0 WAIT 25 IO 0 CRC 0\n";
 
     memset(&history, 0, sizeof(history));
     strcpy(history.fnames.src_filename, "sf");
     strcpy(history.fnames.dst_filename, "df");
-
-    /* Successful write - need to set up for 3 successful calls to OS_write() */
+    history.perf.start_time.Seconds = 3;
+    history.perf.end_time.Seconds   = 9;
+    history.perf.file_bytes         = 1000;
+    history.perf.nak_rounds         = 2;
+    history.perf.nak_segments       = 5;
+    history.perf.wait_usec          = 25;
+
+    /* Successful write - need to set up for 4 successful calls to OS_write() */
     UT_SetDeferredRetcode(UT_KEY(OS_write), 1, 44);
     UT_SetDeferredRetcode(UT_KEY(OS_write), 1, strlen(history.fnames.src_filename) + 6);
     UT_SetDeferredRetcode(UT_KEY(OS_write), 1, strlen(history.fnames.dst_filename) + 6);
+    UT_SetDeferredRetcode(UT_KEY(OS_write), 1, strlen(perf_line));
     UtAssert_INT32_EQ(CF_WriteHistoryEntryToFile(arg_fd, &history), 0);
+    UtAssert_STUB_COUNT(OS_write, 4);
     UtAssert_STUB_COUNT(CFE_EVS_SendEvent, 0);
 
     /* Unsuccessful write */
@@ -1071,6 +1091,175 @@ void Test_CF_WrappedLseek_Call_OS_lseek_WithGivenArgumentsAndReturnItsReturnValu
     UtAssert_INT32_EQ(CF_WrappedLseek(UT_CF_OS_OBJID, test_offset, test_mode), expected_result);
 }
 
+/*******************************************************************************
+**
+**  CF_WrappedRemove tests
+**
+*******************************************************************************/
+
+void Test_CF_WrappedRemove_Call_OS_remove_WithGivenArgumentsAndReturnItsReturnValue(void)
+{
+    /* Arrange */
+    int32 expected_result = Any_int32();
+
+    UT_SetDefaultReturnValue(UT_KEY(OS_remove), expected_result);
+
+    /* Act */
+    UtAssert_INT32_EQ(CF_WrappedRemove("/cf/file.dat"), expected_result);
+    UtAssert_STUB_COUNT(CF_Filestore_FromPath, 1);
+    UtAssert_STUB_COUNT(OS_remove, 1);
+}
+
+/*******************************************************************************
+**
+**  CF_WrappedRename tests
+**
+*******************************************************************************/
+
+/* paths under the RAM filestore prefix are served by it, like the real lookup */
+static void UT_AltHandler_CF_Filestore_FromPath_Mem(void *UserObj, UT_EntryKey_t FuncKey,
+                                                    const UT_StubContext_t *Context)
+{
+    const char *          fname  = UT_Hook_GetArgValueByName(Context, "fname", const char *);
+    const CF_Filestore_t *retval = &CF_Filestore_Osal;
+
+    if (strncmp(fname, CF_MEMSTORE_PATH_PREFIX, strlen(CF_MEMSTORE_PATH_PREFIX)) == 0)
+    {
+        retval = &CF_Memstore_Filestore;
+    }
+
+    UT_Stub_SetReturnValue(FuncKey, retval);
+}
+
+void Test_CF_WrappedRename_SameFilestore(void)
+{
+    /* Arrange */
+    int32 expected_result = Any_int32();
+
+    UT_SetDefaultReturnValue(UT_KEY(OS_mv), expected_result);
+
+    /* Act */
+    UtAssert_INT32_EQ(CF_WrappedRename("/cf/a.dat", "/cf/b.dat"), expected_result);
+
+    /* Assert */
+    UtAssert_STUB_COUNT(OS_mv, 1);
+    UtAssert_STUB_COUNT(OS_OpenCreate, 0);
+}
+
+void Test_CF_WrappedRename_CopyAcrossFilestores(void)
+{
+    /* Arrange */
+    UT_SetHandlerFunction(UT_KEY(CF_Filestore_FromPath), UT_AltHandler_CF_Filestore_FromPath_Mem, NULL);
+    UT_SetDeferredRetcode(UT_KEY(OS_read), 1, 10);
+    UT_SetDeferredRetcode(UT_KEY(OS_read), 1, 5);
+    UT_SetDeferredRetcode(UT_KEY(OS_write), 1, 10);
+    UT_SetDeferredRetcode(UT_KEY(OS_write), 1, 5);
+
+    /* Act */
+    UtAssert_INT32_EQ(CF_WrappedRename("/cf/a.dat", "/cfmem/b.dat"), OS_SUCCESS);
+
+    /* Assert: copied until end of file, then the source is removed */
+    UtAssert_STUB_COUNT(OS_mv, 0);
+    UtAssert_STUB_COUNT(CF_Memstore_Rename, 0);
+    UtAssert_STUB_COUNT(OS_OpenCreate, 1);
+    UtAssert_STUB_COUNT(CF_Memstore_OpenCreate, 1);
+    UtAssert_STUB_COUNT(OS_read, 3);
+    UtAssert_STUB_COUNT(OS_write, 2);
+    UtAssert_STUB_COUNT(OS_close, 2);
+    UtAssert_STUB_COUNT(OS_remove, 1);
+    UtAssert_STUB_COUNT(CF_Memstore_Remove, 0);
+}
+
+void Test_CF_WrappedRename_CopyFails(void)
+{
+    UT_SetHandlerFunction(UT_KEY(CF_Filestore_FromPath), UT_AltHandler_CF_Filestore_FromPath_Mem, NULL);
+
+    /* source does not open */
+    UT_SetDeferredRetcode(UT_KEY(CF_Memstore_OpenCreate), 1, OS_ERR_NAME_NOT_FOUND);
+    UtAssert_INT32_EQ(CF_WrappedRename("/cfmem/a.dat", "/cf/b.dat"), OS_ERR_NAME_NOT_FOUND);
+    UtAssert_STUB_COUNT(OS_OpenCreate, 0);
+    UtAssert_STUB_COUNT(OS_close, 0);
+    UtAssert_STUB_COUNT(CF_Memstore_Remove, 0);
+
+    /* destination does not open, source is closed and kept */
+    UT_SetDeferredRetcode(UT_KEY(OS_OpenCreate), 1, OS_ERROR);
+    UtAssert_INT32_EQ(CF_WrappedRename("/cfmem/a.dat", "/cf/b.dat"), OS_ERROR);
+    UtAssert_STUB_COUNT(OS_close, 1);
+    UtAssert_STUB_COUNT(OS_remove, 0);
+    UtAssert_STUB_COUNT(CF_Memstore_Remove, 0);
+
+    /* short write, the partial copy is removed and the source is kept */
+    UT_ResetState(UT_KEY(OS_close));
+    UT_SetDeferredRetcode(UT_KEY(OS_read), 1, 10);
+    UT_SetDeferredRetcode(UT_KEY(OS_write), 1, 4);
+    UtAssert_INT32_EQ(CF_WrappedRename("/cfmem/a.dat", "/cf/b.dat"), OS_ERROR);
+    UtAssert_STUB_COUNT(OS_close, 2);
+    UtAssert_STUB_COUNT(OS_remove, 1);
+    UtAssert_STUB_COUNT(CF_Memstore_Remove, 0);
+
+    /* read error, same */
+    UT_ResetState(UT_KEY(OS_remove));
+    UT_SetDeferredRetcode(UT_KEY(OS_read), 1, OS_ERROR);
+    UtAssert_INT32_EQ(CF_WrappedRename("/cfmem/a.dat", "/cf/b.dat"), OS_ERROR);
+    UtAssert_STUB_COUNT(OS_remove, 1);
+    UtAssert_STUB_COUNT(CF_Memstore_Remove, 0);
+}
+
+/*******************************************************************************
+**
+**  CF_WrappedStat tests
+**
+*******************************************************************************/
+
+void Test_CF_WrappedStat_Call_OS_stat_WithGivenArgumentsAndReturnItsReturnValue(void)
+{
+    /* Arrange */
+    int32      expected_result = Any_int32();
+    os_fstat_t fst;
+
+    UT_SetDefaultReturnValue(UT_KEY(OS_stat), expected_result);
+
+    /* Act */
+    UtAssert_INT32_EQ(CF_WrappedStat("/cf/file.dat", &fst), expected_result);
+    UtAssert_STUB_COUNT(CF_Filestore_FromPath, 1);
+    UtAssert_STUB_COUNT(OS_stat, 1);
+}
+
+/*******************************************************************************
+**
+**  CF_AddElapsedUsec tests
+**
+*******************************************************************************/
+
+void Test_CF_AddElapsedUsec(void)
+{
+    /* Test case for:
+     * void CF_AddElapsedUsec(uint32 *total, OS_time_t since)
+     */
+    OS_time_t since;
+    uint32    total;
+
+    /* time passes between the two local time reads */
+    OS_GetLocalTime(&since);
+    total = 7;
+    UtAssert_VOIDCALL(CF_AddElapsedUsec(&total, since));
+    UtAssert_UINT32_GT(total, 7);
+    UtAssert_STUB_COUNT(OS_GetLocalTime, 2);
+
+    /* a start time in the future adds nothing */
+    OS_GetLocalTime(&since);
+    since = OS_TimeAdd(since, OS_TimeAssembleFromMilliseconds(100, 0));
+    total = 7;
+    UtAssert_VOIDCALL(CF_AddElapsedUsec(&total, since));
+    UtAssert_UINT32_EQ(total, 7);
+
+    /* the total saturates */
+    OS_GetLocalTime(&since);
+    total = UINT32_MAX - 1;
+    UtAssert_VOIDCALL(CF_AddElapsedUsec(&total, since));
+    UtAssert_UINT32_EQ(total, UINT32_MAX);
+}
+
 void Test_CF_TxnStatus_IsError(void)
 {
     /* Test function for:
@@ -1291,6 +1480,33 @@ void add_CF_WrappedLseek_tests(void)
                cf_utils_tests_Teardown, "Test_CF_WrappedLseek_Call_OS_lseek_WithGivenArgumentsAndReturnItsReturnValue");
 }
 
+void add_CF_WrappedRemove_tests(void)
+{
+    UtTest_Add(Test_CF_WrappedRemove_Call_OS_remove_WithGivenArgumentsAndReturnItsReturnValue, cf_utils_tests_Setup,
+               cf_utils_tests_Teardown, "Test_CF_WrappedRemove_Call_OS_remove_WithGivenArgumentsAndReturnItsReturnValue");
+}
+
+void add_CF_WrappedRename_tests(void)
+{
+    UtTest_Add(Test_CF_WrappedRename_SameFilestore, cf_utils_tests_Setup, cf_utils_tests_Teardown,
+               "Test_CF_WrappedRename_SameFilestore");
+    UtTest_Add(Test_CF_WrappedRename_CopyAcrossFilestores, cf_utils_tests_Setup, cf_utils_tests_Teardown,
+               "Test_CF_WrappedRename_CopyAcrossFilestores");
+    UtTest_Add(Test_CF_WrappedRename_CopyFails, cf_utils_tests_Setup, cf_utils_tests_Teardown,
+               "Test_CF_WrappedRename_CopyFails");
+}
+
+void add_CF_WrappedStat_tests(void)
+{
+    UtTest_Add(Test_CF_WrappedStat_Call_OS_stat_WithGivenArgumentsAndReturnItsReturnValue, cf_utils_tests_Setup,
+               cf_utils_tests_Teardown, "Test_CF_WrappedStat_Call_OS_stat_WithGivenArgumentsAndReturnItsReturnValue");
+}
+
+void add_CF_AddElapsedUsec_tests(void)
+{
+    UtTest_Add(Test_CF_AddElapsedUsec, cf_utils_tests_Setup, cf_utils_tests_Teardown, "CF_AddElapsedUsec");
+}
+
 /*******************************************************************************
 **
 **  cf_utils_tests UtTest_Setup
@@ -1330,4 +1546,12 @@ void UtTest_Setup(void)
     add_CF_WrappedWrite_tests();
 
     add_CF_WrappedLseek_tests();
+
+    add_CF_WrappedRemove_tests();
+
+    add_CF_WrappedRename_tests();
+
+    add_CF_WrappedStat_tests();
+
+    add_CF_AddElapsedUsec_tests();
 }
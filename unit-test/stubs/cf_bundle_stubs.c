@@ -0,0 +1,187 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Auto-Generated stub implementations for functions defined in cf_bundle header
+ */
+
+#include "cf_bundle.h"
+#include "utgenstub.h"
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Bundle_AddFile()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_Bundle_AddFile(CF_Bundle_t *bundle, const char *src_filename, const char *name, uint32 size)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Bundle_AddFile, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_Bundle_AddFile, CF_Bundle_t *, bundle);
+    UT_GenStub_AddParam(CF_Bundle_AddFile, const char *, src_filename);
+    UT_GenStub_AddParam(CF_Bundle_AddFile, const char *, name);
+    UT_GenStub_AddParam(CF_Bundle_AddFile, uint32, size);
+
+    UT_GenStub_Execute(CF_Bundle_AddFile, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Bundle_AddFile, CFE_Status_t);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Bundle_Finish()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_Bundle_Finish(CF_Bundle_t *bundle)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Bundle_Finish, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_Bundle_Finish, CF_Bundle_t *, bundle);
+
+    UT_GenStub_Execute(CF_Bundle_Finish, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Bundle_Finish, CFE_Status_t);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Bundle_GetBuildFilename()
+ * ----------------------------------------------------
+ */
+void CF_Bundle_GetBuildFilename(char *buf, size_t buf_size)
+{
+    UT_GenStub_AddParam(CF_Bundle_GetBuildFilename, char *, buf);
+    UT_GenStub_AddParam(CF_Bundle_GetBuildFilename, size_t, buf_size);
+
+    UT_GenStub_Execute(CF_Bundle_GetBuildFilename, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Bundle_GetFilename()
+ * ----------------------------------------------------
+ */
+void CF_Bundle_GetFilename(char *buf, size_t buf_size, CF_EntityId_t src_eid, CF_TransactionSeq_t seq_num)
+{
+    UT_GenStub_AddParam(CF_Bundle_GetFilename, char *, buf);
+    UT_GenStub_AddParam(CF_Bundle_GetFilename, size_t, buf_size);
+    UT_GenStub_AddParam(CF_Bundle_GetFilename, CF_EntityId_t, src_eid);
+    UT_GenStub_AddParam(CF_Bundle_GetFilename, CF_TransactionSeq_t, seq_num);
+
+    UT_GenStub_Execute(CF_Bundle_GetFilename, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Bundle_ParseEntry()
+ * ----------------------------------------------------
+ */
+uint32 CF_Bundle_ParseEntry(const uint8 *in, uint32 in_len, CF_BundleEntry_t *entry)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Bundle_ParseEntry, uint32);
+
+    UT_GenStub_AddParam(CF_Bundle_ParseEntry, const uint8 *, in);
+    UT_GenStub_AddParam(CF_Bundle_ParseEntry, uint32, in_len);
+    UT_GenStub_AddParam(CF_Bundle_ParseEntry, CF_BundleEntry_t *, entry);
+
+    UT_GenStub_Execute(CF_Bundle_ParseEntry, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Bundle_ParseEntry, uint32);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Bundle_ParseTrailer()
+ * ----------------------------------------------------
+ */
+bool CF_Bundle_ParseTrailer(const uint8 *in, uint32 fsize, uint32 *count, uint32 *index_offset)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Bundle_ParseTrailer, bool);
+
+    UT_GenStub_AddParam(CF_Bundle_ParseTrailer, const uint8 *, in);
+    UT_GenStub_AddParam(CF_Bundle_ParseTrailer, uint32, fsize);
+    UT_GenStub_AddParam(CF_Bundle_ParseTrailer, uint32 *, count);
+    UT_GenStub_AddParam(CF_Bundle_ParseTrailer, uint32 *, index_offset);
+
+    UT_GenStub_Execute(CF_Bundle_ParseTrailer, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Bundle_ParseTrailer, bool);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Bundle_PutEntry()
+ * ----------------------------------------------------
+ */
+uint32 CF_Bundle_PutEntry(uint8 *out, const CF_BundleEntry_t *entry)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Bundle_PutEntry, uint32);
+
+    UT_GenStub_AddParam(CF_Bundle_PutEntry, uint8 *, out);
+    UT_GenStub_AddParam(CF_Bundle_PutEntry, const CF_BundleEntry_t *, entry);
+
+    UT_GenStub_Execute(CF_Bundle_PutEntry, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Bundle_PutEntry, uint32);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Bundle_PutTrailer()
+ * ----------------------------------------------------
+ */
+void CF_Bundle_PutTrailer(uint8 *out, uint32 count, uint32 index_offset)
+{
+    UT_GenStub_AddParam(CF_Bundle_PutTrailer, uint8 *, out);
+    UT_GenStub_AddParam(CF_Bundle_PutTrailer, uint32, count);
+    UT_GenStub_AddParam(CF_Bundle_PutTrailer, uint32, index_offset);
+
+    UT_GenStub_Execute(CF_Bundle_PutTrailer, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Bundle_Release()
+ * ----------------------------------------------------
+ */
+void CF_Bundle_Release(CF_Bundle_t *bundle)
+{
+    UT_GenStub_AddParam(CF_Bundle_Release, CF_Bundle_t *, bundle);
+
+    UT_GenStub_Execute(CF_Bundle_Release, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Bundle_Start()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_Bundle_Start(CF_Bundle_t *bundle, struct CF_Playback *owner)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Bundle_Start, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_Bundle_Start, CF_Bundle_t *, bundle);
+    UT_GenStub_AddParam(CF_Bundle_Start, struct CF_Playback *, owner);
+
+    UT_GenStub_Execute(CF_Bundle_Start, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Bundle_Start, CFE_Status_t);
+}
@@ -83,6 +83,7 @@ void UT_DefaultHandler_CF_CFDP_TxFile(void *UserObj, UT_EntryKey_t FuncKey, cons
         ctxt->chan       = UT_Hook_GetArgValueByName(Context, "chan", uint8);
         ctxt->priority   = UT_Hook_GetArgValueByName(Context, "priority", uint8);
         ctxt->dest_id    = UT_Hook_GetArgValueByName(Context, "dest_id", CF_EntityId_t);
+        ctxt->compress   = UT_Hook_GetArgValueByName(Context, "compress", uint8);
     }
 }
 
@@ -108,6 +109,9 @@ void UT_DefaultHandler_CF_CFDP_PlaybackDir(void *UserObj, UT_EntryKey_t FuncKey,
         ctxt->chan       = UT_Hook_GetArgValueByName(Context, "chan", uint8);
         ctxt->priority   = UT_Hook_GetArgValueByName(Context, "priority", uint8);
         ctxt->dest_id    = UT_Hook_GetArgValueByName(Context, "dest_id", uint16);
+        ctxt->max_ts     = UT_Hook_GetArgValueByName(Context, "max_ts", uint8);
+        ctxt->order      = UT_Hook_GetArgValueByName(Context, "order", uint8);
+        ctxt->compress   = UT_Hook_GetArgValueByName(Context, "compress", uint8);
     }
 }
 
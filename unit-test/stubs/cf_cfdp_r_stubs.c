@@ -146,6 +146,19 @@ void CF_CFDP_R2_RecvMd(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
     UT_GenStub_Execute(CF_CFDP_R2_RecvMd, Basic, NULL);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_R2_RecvPrompt()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_R2_RecvPrompt(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
+{
+    UT_GenStub_AddParam(CF_CFDP_R2_RecvPrompt, CF_Transaction_t *, txn);
+    UT_GenStub_AddParam(CF_CFDP_R2_RecvPrompt, CF_Logical_PduBuffer_t *, ph);
+
+    UT_GenStub_Execute(CF_CFDP_R2_RecvPrompt, Basic, NULL);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_R2_Recv_fin_ack()
@@ -184,6 +197,50 @@ void CF_CFDP_R2_SetFinTxnStatus(CF_Transaction_t *txn, CF_TxnStatus_t txn_stat)
     UT_GenStub_Execute(CF_CFDP_R2_SetFinTxnStatus, Basic, NULL);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_R2_StagingAcquire()
+ * ----------------------------------------------------
+ */
+bool CF_CFDP_R2_StagingAcquire(CF_Transaction_t *txn)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_R2_StagingAcquire, bool);
+
+    UT_GenStub_AddParam(CF_CFDP_R2_StagingAcquire, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_CFDP_R2_StagingAcquire, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_R2_StagingAcquire, bool);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_R2_StagingFlush()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_CFDP_R2_StagingFlush(CF_Transaction_t *txn)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_R2_StagingFlush, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_CFDP_R2_StagingFlush, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_CFDP_R2_StagingFlush, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_R2_StagingFlush, CFE_Status_t);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_R2_StagingRelease()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_R2_StagingRelease(CF_Transaction_t *txn)
+{
+    UT_GenStub_AddParam(CF_CFDP_R2_StagingRelease, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_CFDP_R2_StagingRelease, Basic, NULL);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_R2_SubstateRecvEof()
@@ -226,6 +283,39 @@ CFE_Status_t CF_CFDP_R2_SubstateSendFin(CF_Transaction_t *txn)
     return UT_GenStub_GetReturnValue(CF_CFDP_R2_SubstateSendFin, CFE_Status_t);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_R2_SubstateSendKeepAlive()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_CFDP_R2_SubstateSendKeepAlive(CF_Transaction_t *txn)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_R2_SubstateSendKeepAlive, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_CFDP_R2_SubstateSendKeepAlive, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_CFDP_R2_SubstateSendKeepAlive, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_R2_SubstateSendKeepAlive, CFE_Status_t);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_R_ApplyDelta()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_CFDP_R_ApplyDelta(CF_Transaction_t *txn, uint32 max_bytes)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_R_ApplyDelta, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_CFDP_R_ApplyDelta, CF_Transaction_t *, txn);
+    UT_GenStub_AddParam(CF_CFDP_R_ApplyDelta, uint32, max_bytes);
+
+    UT_GenStub_Execute(CF_CFDP_R_ApplyDelta, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_R_ApplyDelta, CFE_Status_t);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_R_Cancel()
@@ -255,6 +345,47 @@ CFE_Status_t CF_CFDP_R_CheckCrc(CF_Transaction_t *txn, uint32 expected_crc)
     return UT_GenStub_GetReturnValue(CF_CFDP_R_CheckCrc, CFE_Status_t);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_R_DeltaReset()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_R_DeltaReset(CF_Transaction_t *txn)
+{
+    UT_GenStub_AddParam(CF_CFDP_R_DeltaReset, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_CFDP_R_DeltaReset, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_R_DeltaSetAside()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_R_DeltaSetAside(CF_Transaction_t *txn)
+{
+    UT_GenStub_AddParam(CF_CFDP_R_DeltaSetAside, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_CFDP_R_DeltaSetAside, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_R_ExpandChunk()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_CFDP_R_ExpandChunk(CF_Transaction_t *txn, uint32 max_bytes)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_R_ExpandChunk, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_CFDP_R_ExpandChunk, CF_Transaction_t *, txn);
+    UT_GenStub_AddParam(CF_CFDP_R_ExpandChunk, uint32, max_bytes);
+
+    UT_GenStub_Execute(CF_CFDP_R_ExpandChunk, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_R_ExpandChunk, CFE_Status_t);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_R_Init()
@@ -284,6 +415,19 @@ CFE_Status_t CF_CFDP_R_ProcessFd(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *
     return UT_GenStub_GetReturnValue(CF_CFDP_R_ProcessFd, CFE_Status_t);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_R_Respond()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_R_Respond(CF_Transaction_t *txn, int *cont)
+{
+    UT_GenStub_AddParam(CF_CFDP_R_Respond, CF_Transaction_t *, txn);
+    UT_GenStub_AddParam(CF_CFDP_R_Respond, int *, cont);
+
+    UT_GenStub_Execute(CF_CFDP_R_Respond, Basic, NULL);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_R_SendInactivityEvent()
@@ -341,3 +485,20 @@ void CF_CFDP_R_Tick(CF_Transaction_t *txn, int *cont)
 
     UT_GenStub_Execute(CF_CFDP_R_Tick, Basic, NULL);
 }
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_R_Unbundle()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_CFDP_R_Unbundle(CF_Transaction_t *txn, uint32 max_bytes)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_R_Unbundle, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_CFDP_R_Unbundle, CF_Transaction_t *, txn);
+    UT_GenStub_AddParam(CF_CFDP_R_Unbundle, uint32, max_bytes);
+
+    UT_GenStub_Execute(CF_CFDP_R_Unbundle, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_R_Unbundle, CFE_Status_t);
+}
@@ -89,6 +89,32 @@ void CF_CFDP_S2_Fin(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
     UT_GenStub_Execute(CF_CFDP_S2_Fin, Basic, NULL);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_S2_FlowFeedback()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_S2_FlowFeedback(CF_Transaction_t *txn, uint32 lost)
+{
+    UT_GenStub_AddParam(CF_CFDP_S2_FlowFeedback, CF_Transaction_t *, txn);
+    UT_GenStub_AddParam(CF_CFDP_S2_FlowFeedback, uint32, lost);
+
+    UT_GenStub_Execute(CF_CFDP_S2_FlowFeedback, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_S2_KeepAlive()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_S2_KeepAlive(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
+{
+    UT_GenStub_AddParam(CF_CFDP_S2_KeepAlive, CF_Transaction_t *, txn);
+    UT_GenStub_AddParam(CF_CFDP_S2_KeepAlive, CF_Logical_PduBuffer_t *, ph);
+
+    UT_GenStub_Execute(CF_CFDP_S2_KeepAlive, Basic, NULL);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_S2_Nak()
@@ -152,6 +178,18 @@ void CF_CFDP_S2_SubstateSendFileData(CF_Transaction_t *txn)
     UT_GenStub_Execute(CF_CFDP_S2_SubstateSendFileData, Basic, NULL);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_S2_SubstateSkipFileData()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_S2_SubstateSkipFileData(CF_Transaction_t *txn)
+{
+    UT_GenStub_AddParam(CF_CFDP_S2_SubstateSkipFileData, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_CFDP_S2_SubstateSkipFileData, Basic, NULL);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_S2_Tx()
@@ -177,6 +215,18 @@ void CF_CFDP_S2_WaitForEofAck(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
     UT_GenStub_Execute(CF_CFDP_S2_WaitForEofAck, Basic, NULL);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_S_BundleReset()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_S_BundleReset(CF_Transaction_t *txn)
+{
+    UT_GenStub_AddParam(CF_CFDP_S_BundleReset, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_CFDP_S_BundleReset, Basic, NULL);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_S_Cancel()
@@ -205,6 +255,151 @@ CFE_Status_t CF_CFDP_S_CheckAndRespondNak(CF_Transaction_t *txn)
     return UT_GenStub_GetReturnValue(CF_CFDP_S_CheckAndRespondNak, CFE_Status_t);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_S_CheckDelivered()
+ * ----------------------------------------------------
+ */
+bool CF_CFDP_S_CheckDelivered(CF_Transaction_t *txn)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_S_CheckDelivered, bool);
+
+    UT_GenStub_AddParam(CF_CFDP_S_CheckDelivered, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_CFDP_S_CheckDelivered, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_S_CheckDelivered, bool);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_S_CompressChunk()
+ * ----------------------------------------------------
+ */
+bool CF_CFDP_S_CompressChunk(CF_Transaction_t *txn)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_S_CompressChunk, bool);
+
+    UT_GenStub_AddParam(CF_CFDP_S_CompressChunk, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_CFDP_S_CompressChunk, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_S_CompressChunk, bool);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_S_CompressStart()
+ * ----------------------------------------------------
+ */
+bool CF_CFDP_S_CompressStart(CF_Transaction_t *txn)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_S_CompressStart, bool);
+
+    UT_GenStub_AddParam(CF_CFDP_S_CompressStart, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_CFDP_S_CompressStart, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_S_CompressStart, bool);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_S_DeltaChunk()
+ * ----------------------------------------------------
+ */
+bool CF_CFDP_S_DeltaChunk(CF_Transaction_t *txn)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_S_DeltaChunk, bool);
+
+    UT_GenStub_AddParam(CF_CFDP_S_DeltaChunk, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_CFDP_S_DeltaChunk, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_S_DeltaChunk, bool);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_S_DeltaReset()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_S_DeltaReset(CF_Transaction_t *txn)
+{
+    UT_GenStub_AddParam(CF_CFDP_S_DeltaReset, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_CFDP_S_DeltaReset, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_S_FollowFile()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_S_FollowFile(CF_Transaction_t *txn)
+{
+    UT_GenStub_AddParam(CF_CFDP_S_FollowFile, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_CFDP_S_FollowFile, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_S_GetFanOutCrc()
+ * ----------------------------------------------------
+ */
+bool CF_CFDP_S_GetFanOutCrc(CF_Transaction_t *txn)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_S_GetFanOutCrc, bool);
+
+    UT_GenStub_AddParam(CF_CFDP_S_GetFanOutCrc, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_CFDP_S_GetFanOutCrc, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_S_GetFanOutCrc, bool);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_S_Prefetch()
+ * ----------------------------------------------------
+ */
+bool CF_CFDP_S_Prefetch(CF_Transaction_t *txn)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_S_Prefetch, bool);
+
+    UT_GenStub_AddParam(CF_CFDP_S_Prefetch, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_CFDP_S_Prefetch, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_S_Prefetch, bool);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_S_PrefetchRelease()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_S_PrefetchRelease(CF_Transaction_t *txn)
+{
+    UT_GenStub_AddParam(CF_CFDP_S_PrefetchRelease, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_CFDP_S_PrefetchRelease, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_S_Respond()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_S_Respond(CF_Transaction_t *txn, int *cont)
+{
+    UT_GenStub_AddParam(CF_CFDP_S_Respond, CF_Transaction_t *, txn);
+    UT_GenStub_AddParam(CF_CFDP_S_Respond, int *, cont);
+
+    UT_GenStub_Execute(CF_CFDP_S_Respond, Basic, NULL);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_S_SendEof()
@@ -28,6 +28,38 @@
 
 void UT_DefaultHandler_CF_CFDP_MsgOutGet(void *, UT_EntryKey_t, const UT_StubContext_t *);
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_GetRxBudget()
+ * ----------------------------------------------------
+ */
+uint32 CF_CFDP_GetRxBudget(uint8 chan_num)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_GetRxBudget, uint32);
+
+    UT_GenStub_AddParam(CF_CFDP_GetRxBudget, uint8, chan_num);
+
+    UT_GenStub_Execute(CF_CFDP_GetRxBudget, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_GetRxBudget, uint32);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_GetTransport()
+ * ----------------------------------------------------
+ */
+const CF_Transport_t *CF_CFDP_GetTransport(uint8 chan_num)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_GetTransport, const CF_Transport_t *);
+
+    UT_GenStub_AddParam(CF_CFDP_GetTransport, uint8, chan_num);
+
+    UT_GenStub_Execute(CF_CFDP_GetTransport, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_GetTransport, const CF_Transport_t *);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_MsgOutGet()
@@ -57,6 +89,86 @@ void CF_CFDP_ReceiveMessage(CF_Channel_t *chan)
     UT_GenStub_Execute(CF_CFDP_ReceiveMessage, Basic, NULL);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_ReceivePdu()
+ * ----------------------------------------------------
+ */
+CF_Transaction_t *CF_CFDP_ReceivePdu(CF_Channel_t *chan, CF_Logical_PduBuffer_t *ph, CF_Transaction_t *hint)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_ReceivePdu, CF_Transaction_t *);
+
+    UT_GenStub_AddParam(CF_CFDP_ReceivePdu, CF_Channel_t *, chan);
+    UT_GenStub_AddParam(CF_CFDP_ReceivePdu, CF_Logical_PduBuffer_t *, ph);
+    UT_GenStub_AddParam(CF_CFDP_ReceivePdu, CF_Transaction_t *, hint);
+
+    UT_GenStub_Execute(CF_CFDP_ReceivePdu, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_ReceivePdu, CF_Transaction_t *);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_SbGetBuffer()
+ * ----------------------------------------------------
+ */
+void *CF_CFDP_SbGetBuffer(uint8 chan_num, size_t *encap_hdr_size)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_SbGetBuffer, void *);
+
+    UT_GenStub_AddParam(CF_CFDP_SbGetBuffer, uint8, chan_num);
+    UT_GenStub_AddParam(CF_CFDP_SbGetBuffer, size_t *, encap_hdr_size);
+
+    UT_GenStub_Execute(CF_CFDP_SbGetBuffer, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_SbGetBuffer, void *);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_SbReceiveBatch()
+ * ----------------------------------------------------
+ */
+uint32 CF_CFDP_SbReceiveBatch(uint8 chan_num, CF_TransportRxMsg_t *msgs, uint32 max_msgs)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_SbReceiveBatch, uint32);
+
+    UT_GenStub_AddParam(CF_CFDP_SbReceiveBatch, uint8, chan_num);
+    UT_GenStub_AddParam(CF_CFDP_SbReceiveBatch, CF_TransportRxMsg_t *, msgs);
+    UT_GenStub_AddParam(CF_CFDP_SbReceiveBatch, uint32, max_msgs);
+
+    UT_GenStub_Execute(CF_CFDP_SbReceiveBatch, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_SbReceiveBatch, uint32);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_SbReleaseBuffer()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_SbReleaseBuffer(uint8 chan_num, void *buf)
+{
+    UT_GenStub_AddParam(CF_CFDP_SbReleaseBuffer, uint8, chan_num);
+    UT_GenStub_AddParam(CF_CFDP_SbReleaseBuffer, void *, buf);
+
+    UT_GenStub_Execute(CF_CFDP_SbReleaseBuffer, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_SbSend()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_SbSend(uint8 chan_num, void *buf, size_t pdu_size)
+{
+    UT_GenStub_AddParam(CF_CFDP_SbSend, uint8, chan_num);
+    UT_GenStub_AddParam(CF_CFDP_SbSend, void *, buf);
+    UT_GenStub_AddParam(CF_CFDP_SbSend, size_t, pdu_size);
+
+    UT_GenStub_Execute(CF_CFDP_SbSend, Basic, NULL);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_Send()
@@ -69,3 +181,17 @@ void CF_CFDP_Send(uint8 chan_num, const CF_Logical_PduBuffer_t *ph)
 
     UT_GenStub_Execute(CF_CFDP_Send, Basic, NULL);
 }
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_UpdateRxBudget()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_UpdateRxBudget(uint8 chan_num, uint32 count, bool time_limited)
+{
+    UT_GenStub_AddParam(CF_CFDP_UpdateRxBudget, uint8, chan_num);
+    UT_GenStub_AddParam(CF_CFDP_UpdateRxBudget, uint32, count);
+    UT_GenStub_AddParam(CF_CFDP_UpdateRxBudget, bool, time_limited);
+
+    UT_GenStub_Execute(CF_CFDP_UpdateRxBudget, Basic, NULL);
+}
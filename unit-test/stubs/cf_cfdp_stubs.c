@@ -32,6 +32,23 @@ void UT_DefaultHandler_CF_CFDP_PlaybackDir(void *, UT_EntryKey_t, const UT_StubC
 void UT_DefaultHandler_CF_CFDP_ResetTransaction(void *, UT_EntryKey_t, const UT_StubContext_t *);
 void UT_DefaultHandler_CF_CFDP_TxFile(void *, UT_EntryKey_t, const UT_StubContext_t *);
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_ActivateFanOut()
+ * ----------------------------------------------------
+ */
+CF_CListTraverse_Status_t CF_CFDP_ActivateFanOut(CF_CListNode_t *node, void *context)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_ActivateFanOut, CF_CListTraverse_Status_t);
+
+    UT_GenStub_AddParam(CF_CFDP_ActivateFanOut, CF_CListNode_t *, node);
+    UT_GenStub_AddParam(CF_CFDP_ActivateFanOut, void *, context);
+
+    UT_GenStub_Execute(CF_CFDP_ActivateFanOut, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_ActivateFanOut, CF_CListTraverse_Status_t);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_AppendTlv()
@@ -128,6 +145,21 @@ int CF_CFDP_CopyStringFromLV(char *buf, size_t buf_maxsz, const CF_Logical_Lv_t
     return UT_GenStub_GetReturnValue(CF_CFDP_CopyStringFromLV, int);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_CycleBudgetExpired()
+ * ----------------------------------------------------
+ */
+bool CF_CFDP_CycleBudgetExpired(void)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_CycleBudgetExpired, bool);
+
+
+    UT_GenStub_Execute(CF_CFDP_CycleBudgetExpired, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_CycleBudgetExpired, bool);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_CycleEngine()
@@ -243,6 +275,23 @@ void CF_CFDP_EncodeStart(CF_EncoderState_t *penc, void *msgbuf, CF_Logical_PduBu
     UT_GenStub_Execute(CF_CFDP_EncodeStart, Basic, NULL);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_FindUnusedChunks()
+ * ----------------------------------------------------
+ */
+CF_ChunkWrapper_t *CF_CFDP_FindUnusedChunks(CF_Channel_t *chan, CF_Direction_t dir)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_FindUnusedChunks, CF_ChunkWrapper_t *);
+
+    UT_GenStub_AddParam(CF_CFDP_FindUnusedChunks, CF_Channel_t *, chan);
+    UT_GenStub_AddParam(CF_CFDP_FindUnusedChunks, CF_Direction_t, dir);
+
+    UT_GenStub_Execute(CF_CFDP_FindUnusedChunks, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_FindUnusedChunks, CF_ChunkWrapper_t *);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_HandleNotKeepFile()
@@ -315,13 +364,27 @@ void CF_CFDP_MoveFile(const char *src, const char *dest_dir)
     UT_GenStub_Execute(CF_CFDP_MoveFile, Basic, NULL);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_PerfWait()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_PerfWait(CF_History_t *history, bool waiting)
+{
+    UT_GenStub_AddParam(CF_CFDP_PerfWait, CF_History_t *, history);
+    UT_GenStub_AddParam(CF_CFDP_PerfWait, bool, waiting);
+
+    UT_GenStub_Execute(CF_CFDP_PerfWait, Basic, NULL);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_PlaybackDir()
  * ----------------------------------------------------
  */
 CFE_Status_t CF_CFDP_PlaybackDir(const char *src_filename, const char *dst_filename, CF_CFDP_Class_t cfdp_class,
-                                 uint8 keep, uint8 chan, uint8 priority, uint16 dest_id)
+                                 uint8 keep, uint8 chan, uint8 priority, uint16 dest_id, uint8 max_ts, uint8 order,
+                                 uint8 compress)
 {
     UT_GenStub_SetupReturnBuffer(CF_CFDP_PlaybackDir, CFE_Status_t);
 
@@ -332,12 +395,32 @@ CFE_Status_t CF_CFDP_PlaybackDir(const char *src_filename, const char *dst_filen
     UT_GenStub_AddParam(CF_CFDP_PlaybackDir, uint8, chan);
     UT_GenStub_AddParam(CF_CFDP_PlaybackDir, uint8, priority);
     UT_GenStub_AddParam(CF_CFDP_PlaybackDir, uint16, dest_id);
+    UT_GenStub_AddParam(CF_CFDP_PlaybackDir, uint8, max_ts);
+    UT_GenStub_AddParam(CF_CFDP_PlaybackDir, uint8, order);
+    UT_GenStub_AddParam(CF_CFDP_PlaybackDir, uint8, compress);
 
     UT_GenStub_Execute(CF_CFDP_PlaybackDir, Basic, UT_DefaultHandler_CF_CFDP_PlaybackDir);
 
     return UT_GenStub_GetReturnValue(CF_CFDP_PlaybackDir, CFE_Status_t);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_PrefetchTxNext()
+ * ----------------------------------------------------
+ */
+CF_CListTraverse_Status_t CF_CFDP_PrefetchTxNext(CF_CListNode_t *node, void *context)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_PrefetchTxNext, CF_CListTraverse_Status_t);
+
+    UT_GenStub_AddParam(CF_CFDP_PrefetchTxNext, CF_CListNode_t *, node);
+    UT_GenStub_AddParam(CF_CFDP_PrefetchTxNext, void *, context);
+
+    UT_GenStub_Execute(CF_CFDP_PrefetchTxNext, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_PrefetchTxNext, CF_CListTraverse_Status_t);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_ProcessPlaybackDirectory()
@@ -457,6 +540,23 @@ void CF_CFDP_RecvIdle(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
     UT_GenStub_Execute(CF_CFDP_RecvIdle, Basic, NULL);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_RecvKeepAlive()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_CFDP_RecvKeepAlive(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_RecvKeepAlive, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_CFDP_RecvKeepAlive, CF_Transaction_t *, txn);
+    UT_GenStub_AddParam(CF_CFDP_RecvKeepAlive, CF_Logical_PduBuffer_t *, ph);
+
+    UT_GenStub_Execute(CF_CFDP_RecvKeepAlive, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_RecvKeepAlive, CFE_Status_t);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_RecvMd()
@@ -508,6 +608,23 @@ CFE_Status_t CF_CFDP_RecvPh(uint8 chan_num, CF_Logical_PduBuffer_t *ph)
     return UT_GenStub_GetReturnValue(CF_CFDP_RecvPh, CFE_Status_t);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_RecvPrompt()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_CFDP_RecvPrompt(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_RecvPrompt, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_CFDP_RecvPrompt, CF_Transaction_t *, txn);
+    UT_GenStub_AddParam(CF_CFDP_RecvPrompt, CF_Logical_PduBuffer_t *, ph);
+
+    UT_GenStub_Execute(CF_CFDP_RecvPrompt, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_RecvPrompt, CFE_Status_t);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_ResetTransaction()
@@ -521,6 +638,18 @@ void CF_CFDP_ResetTransaction(CF_Transaction_t *txn, bool keep_history)
     UT_GenStub_Execute(CF_CFDP_ResetTransaction, Basic, UT_DefaultHandler_CF_CFDP_ResetTransaction);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_RespondTransactions()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_RespondTransactions(CF_Channel_t *chan)
+{
+    UT_GenStub_AddParam(CF_CFDP_RespondTransactions, CF_Channel_t *, chan);
+
+    UT_GenStub_Execute(CF_CFDP_RespondTransactions, Basic, NULL);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_SendAck()
@@ -608,6 +737,23 @@ CFE_Status_t CF_CFDP_SendFin(CF_Transaction_t *txn, CF_CFDP_FinDeliveryCode_t dc
     return UT_GenStub_GetReturnValue(CF_CFDP_SendFin, CFE_Status_t);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_SendKeepAlive()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_CFDP_SendKeepAlive(CF_Transaction_t *txn, CF_FileSize_t progress)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_SendKeepAlive, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_CFDP_SendKeepAlive, CF_Transaction_t *, txn);
+    UT_GenStub_AddParam(CF_CFDP_SendKeepAlive, CF_FileSize_t, progress);
+
+    UT_GenStub_Execute(CF_CFDP_SendKeepAlive, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_SendKeepAlive, CFE_Status_t);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_SendMd()
@@ -641,6 +787,38 @@ CFE_Status_t CF_CFDP_SendNak(CF_Transaction_t *txn, CF_Logical_PduBuffer_t *ph)
     return UT_GenStub_GetReturnValue(CF_CFDP_SendNak, CFE_Status_t);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_SendPrompt()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_CFDP_SendPrompt(CF_Transaction_t *txn, CF_CFDP_PromptResponse_t response)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_SendPrompt, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_CFDP_SendPrompt, CF_Transaction_t *, txn);
+    UT_GenStub_AddParam(CF_CFDP_SendPrompt, CF_CFDP_PromptResponse_t, response);
+
+    UT_GenStub_Execute(CF_CFDP_SendPrompt, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_SendPrompt, CFE_Status_t);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_ServiceInput()
+ * ----------------------------------------------------
+ */
+bool CF_CFDP_ServiceInput(void)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_ServiceInput, bool);
+
+
+    UT_GenStub_Execute(CF_CFDP_ServiceInput, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_ServiceInput, bool);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_SetTxnStatus()
@@ -672,7 +850,7 @@ void CF_CFDP_TickTransactions(CF_Channel_t *chan)
  * ----------------------------------------------------
  */
 CFE_Status_t CF_CFDP_TxFile(const char *src_filename, const char *dst_filename, CF_CFDP_Class_t cfdp_class, uint8 keep,
-                            uint8 chan, uint8 priority, CF_EntityId_t dest_id)
+                            uint8 chan, uint8 priority, CF_EntityId_t dest_id, uint8 compress)
 {
     UT_GenStub_SetupReturnBuffer(CF_CFDP_TxFile, CFE_Status_t);
 
@@ -683,8 +861,70 @@ CFE_Status_t CF_CFDP_TxFile(const char *src_filename, const char *dst_filename,
     UT_GenStub_AddParam(CF_CFDP_TxFile, uint8, chan);
     UT_GenStub_AddParam(CF_CFDP_TxFile, uint8, priority);
     UT_GenStub_AddParam(CF_CFDP_TxFile, CF_EntityId_t, dest_id);
+    UT_GenStub_AddParam(CF_CFDP_TxFile, uint8, compress);
 
     UT_GenStub_Execute(CF_CFDP_TxFile, Basic, UT_DefaultHandler_CF_CFDP_TxFile);
 
     return UT_GenStub_GetReturnValue(CF_CFDP_TxFile, CFE_Status_t);
 }
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_TxFileFollow()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_CFDP_TxFileFollow(const char *src_filename, const char *dst_filename, CF_CFDP_Class_t cfdp_class,
+                                  uint8 keep, uint8 chan, uint8 priority, CF_EntityId_t dest_id)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_TxFileFollow, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_CFDP_TxFileFollow, const char *, src_filename);
+    UT_GenStub_AddParam(CF_CFDP_TxFileFollow, const char *, dst_filename);
+    UT_GenStub_AddParam(CF_CFDP_TxFileFollow, CF_CFDP_Class_t, cfdp_class);
+    UT_GenStub_AddParam(CF_CFDP_TxFileFollow, uint8, keep);
+    UT_GenStub_AddParam(CF_CFDP_TxFileFollow, uint8, chan);
+    UT_GenStub_AddParam(CF_CFDP_TxFileFollow, uint8, priority);
+    UT_GenStub_AddParam(CF_CFDP_TxFileFollow, CF_EntityId_t, dest_id);
+
+    UT_GenStub_Execute(CF_CFDP_TxFileFollow, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_TxFileFollow, CFE_Status_t);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_TxFileMulti()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_CFDP_TxFileMulti(const char *src_filename, const char *dst_filename, CF_CFDP_Class_t cfdp_class,
+                                 uint8 keep, uint8 chan, uint8 priority, const CF_EntityId_t *dest_ids,
+                                 uint8 num_dest)
+{
+    UT_GenStub_SetupReturnBuffer(CF_CFDP_TxFileMulti, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_CFDP_TxFileMulti, const char *, src_filename);
+    UT_GenStub_AddParam(CF_CFDP_TxFileMulti, const char *, dst_filename);
+    UT_GenStub_AddParam(CF_CFDP_TxFileMulti, CF_CFDP_Class_t, cfdp_class);
+    UT_GenStub_AddParam(CF_CFDP_TxFileMulti, uint8, keep);
+    UT_GenStub_AddParam(CF_CFDP_TxFileMulti, uint8, chan);
+    UT_GenStub_AddParam(CF_CFDP_TxFileMulti, uint8, priority);
+    UT_GenStub_AddParam(CF_CFDP_TxFileMulti, const CF_EntityId_t *, dest_ids);
+    UT_GenStub_AddParam(CF_CFDP_TxFileMulti, uint8, num_dest);
+
+    UT_GenStub_Execute(CF_CFDP_TxFileMulti, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_CFDP_TxFileMulti, CFE_Status_t);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_UpdateCycleStats()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_UpdateCycleStats(uint32 usec, uint32 budget)
+{
+    UT_GenStub_AddParam(CF_CFDP_UpdateCycleStats, uint32, usec);
+    UT_GenStub_AddParam(CF_CFDP_UpdateCycleStats, uint32, budget);
+
+    UT_GenStub_Execute(CF_CFDP_UpdateCycleStats, Basic, NULL);
+}
@@ -50,3 +50,22 @@ void UT_DefaultHandler_CF_ChunkList_GetFirstChunk(void *UserObj, UT_EntryKey_t F
     CF_Chunk_t *chunk = NULL;
     UT_Stub_SetReturnValue(FuncKey, chunk);
 }
+
+/*----------------------------------------------------------------
+ *
+ * Default returns the whole range as uncovered, unless a return value was set
+ *
+ *-----------------------------------------------------------------*/
+void UT_DefaultHandler_CF_ChunkList_CountUncovered(void *UserObj, UT_EntryKey_t FuncKey,
+                                                   const UT_StubContext_t *Context)
+{
+    CF_ChunkSize_t retval = UT_Hook_GetArgValueByName(Context, "size", CF_ChunkSize_t);
+    int32          status_code;
+
+    if (UT_Stub_GetInt32StatusCode(Context, &status_code))
+    {
+        retval = status_code;
+    }
+
+    UT_Stub_SetReturnValue(FuncKey, retval);
+}
@@ -27,6 +27,7 @@
 #include "utgenstub.h"
 
 void UT_DefaultHandler_CF_ChunkList_GetFirstChunk(void *, UT_EntryKey_t, const UT_StubContext_t *);
+void UT_DefaultHandler_CF_ChunkList_CountUncovered(void *, UT_EntryKey_t, const UT_StubContext_t *);
 
 /*
  * ----------------------------------------------------
@@ -90,6 +91,24 @@ uint32 CF_ChunkList_ComputeGaps(const CF_ChunkList_t *chunks, CF_ChunkIdx_t max_
     return UT_GenStub_GetReturnValue(CF_ChunkList_ComputeGaps, uint32);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_ChunkList_CountUncovered()
+ * ----------------------------------------------------
+ */
+CF_ChunkSize_t CF_ChunkList_CountUncovered(const CF_ChunkList_t *chunks, CF_ChunkOffset_t offset, CF_ChunkSize_t size)
+{
+    UT_GenStub_SetupReturnBuffer(CF_ChunkList_CountUncovered, CF_ChunkSize_t);
+
+    UT_GenStub_AddParam(CF_ChunkList_CountUncovered, const CF_ChunkList_t *, chunks);
+    UT_GenStub_AddParam(CF_ChunkList_CountUncovered, CF_ChunkOffset_t, offset);
+    UT_GenStub_AddParam(CF_ChunkList_CountUncovered, CF_ChunkSize_t, size);
+
+    UT_GenStub_Execute(CF_ChunkList_CountUncovered, Basic, UT_DefaultHandler_CF_ChunkList_CountUncovered);
+
+    return UT_GenStub_GetReturnValue(CF_ChunkList_CountUncovered, CF_ChunkSize_t);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_ChunkList_GetFirstChunk()
@@ -0,0 +1,186 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Auto-Generated stub implementations for functions defined in cf_ckpt header
+ */
+
+#include "cf_ckpt.h"
+#include "utgenstub.h"
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Ckpt_ClaimPartial()
+ * ----------------------------------------------------
+ */
+bool CF_Ckpt_ClaimPartial(CF_Transaction_t *txn)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Ckpt_ClaimPartial, bool);
+
+    UT_GenStub_AddParam(CF_Ckpt_ClaimPartial, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_Ckpt_ClaimPartial, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Ckpt_ClaimPartial, bool);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Ckpt_Cycle()
+ * ----------------------------------------------------
+ */
+void CF_Ckpt_Cycle(void)
+{
+
+    UT_GenStub_Execute(CF_Ckpt_Cycle, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Ckpt_DropPartial()
+ * ----------------------------------------------------
+ */
+void CF_Ckpt_DropPartial(CF_Transaction_t *txn)
+{
+    UT_GenStub_AddParam(CF_Ckpt_DropPartial, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_Ckpt_DropPartial, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Ckpt_GetFilename()
+ * ----------------------------------------------------
+ */
+void CF_Ckpt_GetFilename(char *buf, size_t buf_size, const CF_Transaction_t *txn, const char *ext)
+{
+    UT_GenStub_AddParam(CF_Ckpt_GetFilename, char *, buf);
+    UT_GenStub_AddParam(CF_Ckpt_GetFilename, size_t, buf_size);
+    UT_GenStub_AddParam(CF_Ckpt_GetFilename, const CF_Transaction_t *, txn);
+    UT_GenStub_AddParam(CF_Ckpt_GetFilename, const char *, ext);
+
+    UT_GenStub_Execute(CF_Ckpt_GetFilename, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Ckpt_GetPartialFilename()
+ * ----------------------------------------------------
+ */
+void CF_Ckpt_GetPartialFilename(char *buf, size_t buf_size, CF_EntityId_t src_eid, const char *dst_filename,
+                                const char *ext)
+{
+    UT_GenStub_AddParam(CF_Ckpt_GetPartialFilename, char *, buf);
+    UT_GenStub_AddParam(CF_Ckpt_GetPartialFilename, size_t, buf_size);
+    UT_GenStub_AddParam(CF_Ckpt_GetPartialFilename, CF_EntityId_t, src_eid);
+    UT_GenStub_AddParam(CF_Ckpt_GetPartialFilename, const char *, dst_filename);
+    UT_GenStub_AddParam(CF_Ckpt_GetPartialFilename, const char *, ext);
+
+    UT_GenStub_Execute(CF_Ckpt_GetPartialFilename, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Ckpt_Load()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_Ckpt_Load(const char *fname)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Ckpt_Load, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_Ckpt_Load, const char *, fname);
+
+    UT_GenStub_Execute(CF_Ckpt_Load, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Ckpt_Load, CFE_Status_t);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Ckpt_Remove()
+ * ----------------------------------------------------
+ */
+void CF_Ckpt_Remove(CF_Transaction_t *txn)
+{
+    UT_GenStub_AddParam(CF_Ckpt_Remove, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_Ckpt_Remove, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Ckpt_Restore()
+ * ----------------------------------------------------
+ */
+void CF_Ckpt_Restore(void)
+{
+
+    UT_GenStub_Execute(CF_Ckpt_Restore, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Ckpt_Resume()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_Ckpt_Resume(const CF_CkptRecord_t *rec, osal_id_t fd)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Ckpt_Resume, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_Ckpt_Resume, const CF_CkptRecord_t *, rec);
+    UT_GenStub_AddParam(CF_Ckpt_Resume, osal_id_t, fd);
+
+    UT_GenStub_Execute(CF_Ckpt_Resume, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Ckpt_Resume, CFE_Status_t);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Ckpt_RetainPartial()
+ * ----------------------------------------------------
+ */
+bool CF_Ckpt_RetainPartial(CF_Transaction_t *txn)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Ckpt_RetainPartial, bool);
+
+    UT_GenStub_AddParam(CF_Ckpt_RetainPartial, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_Ckpt_RetainPartial, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Ckpt_RetainPartial, bool);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Ckpt_Write()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_Ckpt_Write(CF_Transaction_t *txn)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Ckpt_Write, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_Ckpt_Write, CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_Ckpt_Write, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Ckpt_Write, CFE_Status_t);
+}
@@ -84,6 +84,22 @@ void CF_Cancel_TxnCmd(CF_Transaction_t *txn, void *ignored)
     UT_GenStub_Execute(CF_Cancel_TxnCmd, Basic, NULL);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_TxFileFollowCmd()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_TxFileFollowCmd(const CF_TxFileFollowCmd_t *msg)
+{
+    UT_GenStub_SetupReturnBuffer(CF_TxFileFollowCmd, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_TxFileFollowCmd, const CF_TxFileFollowCmd_t *, msg);
+
+    UT_GenStub_Execute(CF_TxFileFollowCmd, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_TxFileFollowCmd, CFE_Status_t);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_ValidateChunkSizeCmd()
@@ -606,6 +622,22 @@ CFE_Status_t CF_TxFileCmd(const CF_TxFileCmd_t *msg)
     return UT_GenStub_GetReturnValue(CF_TxFileCmd, CFE_Status_t);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_TxFileMultiCmd()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_TxFileMultiCmd(const CF_TxFileMultiCmd_t *msg)
+{
+    UT_GenStub_SetupReturnBuffer(CF_TxFileMultiCmd, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_TxFileMultiCmd, const CF_TxFileMultiCmd_t *, msg);
+
+    UT_GenStub_Execute(CF_TxFileMultiCmd, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_TxFileMultiCmd, CFE_Status_t);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_WakeupCmd()
@@ -637,3 +669,19 @@ CFE_Status_t CF_WriteQueueCmd(const CF_WriteQueueCmd_t *msg)
 
     return UT_GenStub_GetReturnValue(CF_WriteQueueCmd, CFE_Status_t);
 }
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_WriteTraceCmd()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_WriteTraceCmd(const CF_WriteTraceCmd_t *msg)
+{
+    UT_GenStub_SetupReturnBuffer(CF_WriteTraceCmd, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_WriteTraceCmd, const CF_WriteTraceCmd_t *, msg);
+
+    UT_GenStub_Execute(CF_WriteTraceCmd, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_WriteTraceCmd, CFE_Status_t);
+}
@@ -173,6 +173,19 @@ CFE_Status_t CF_CFDP_DecodeHeader(CF_DecoderState_t *state, CF_Logical_PduHeader
     return UT_GenStub_GetReturnValue(CF_CFDP_DecodeHeader, CFE_Status_t);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_DecodeKeepAlive()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_DecodeKeepAlive(CF_DecoderState_t *state, CF_Logical_PduKeepAlive_t *plka)
+{
+    UT_GenStub_AddParam(CF_CFDP_DecodeKeepAlive, CF_DecoderState_t *, state);
+    UT_GenStub_AddParam(CF_CFDP_DecodeKeepAlive, CF_Logical_PduKeepAlive_t *, plka);
+
+    UT_GenStub_Execute(CF_CFDP_DecodeKeepAlive, Basic, NULL);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_DecodeLV()
@@ -212,6 +225,19 @@ void CF_CFDP_DecodeNak(CF_DecoderState_t *state, CF_Logical_PduNak_t *plnak)
     UT_GenStub_Execute(CF_CFDP_DecodeNak, Basic, NULL);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_DecodePrompt()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_DecodePrompt(CF_DecoderState_t *state, CF_Logical_PduPrompt_t *plprompt)
+{
+    UT_GenStub_AddParam(CF_CFDP_DecodePrompt, CF_DecoderState_t *, state);
+    UT_GenStub_AddParam(CF_CFDP_DecodePrompt, CF_Logical_PduPrompt_t *, plprompt);
+
+    UT_GenStub_Execute(CF_CFDP_DecodePrompt, Basic, NULL);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_DecodeSegmentRequest()
@@ -403,6 +429,19 @@ void CF_CFDP_EncodeHeaderWithoutSize(CF_EncoderState_t *state, CF_Logical_PduHea
     UT_GenStub_Execute(CF_CFDP_EncodeHeaderWithoutSize, Basic, NULL);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_EncodeKeepAlive()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_EncodeKeepAlive(CF_EncoderState_t *state, CF_Logical_PduKeepAlive_t *plka)
+{
+    UT_GenStub_AddParam(CF_CFDP_EncodeKeepAlive, CF_EncoderState_t *, state);
+    UT_GenStub_AddParam(CF_CFDP_EncodeKeepAlive, CF_Logical_PduKeepAlive_t *, plka);
+
+    UT_GenStub_Execute(CF_CFDP_EncodeKeepAlive, Basic, NULL);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_EncodeLV()
@@ -442,6 +481,19 @@ void CF_CFDP_EncodeNak(CF_EncoderState_t *state, CF_Logical_PduNak_t *plnak)
     UT_GenStub_Execute(CF_CFDP_EncodeNak, Basic, NULL);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_CFDP_EncodePrompt()
+ * ----------------------------------------------------
+ */
+void CF_CFDP_EncodePrompt(CF_EncoderState_t *state, CF_Logical_PduPrompt_t *plprompt)
+{
+    UT_GenStub_AddParam(CF_CFDP_EncodePrompt, CF_EncoderState_t *, state);
+    UT_GenStub_AddParam(CF_CFDP_EncodePrompt, CF_Logical_PduPrompt_t *, plprompt);
+
+    UT_GenStub_Execute(CF_CFDP_EncodePrompt, Basic, NULL);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_CFDP_EncodeSegmentRequest()
@@ -0,0 +1,98 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Auto-Generated stub implementations for functions defined in cf_compress header
+ */
+
+#include "cf_compress.h"
+#include "utgenstub.h"
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Compress_GetFilename()
+ * ----------------------------------------------------
+ */
+void CF_Compress_GetFilename(char *buf, size_t buf_size, CF_EntityId_t src_eid, CF_TransactionSeq_t seq_num)
+{
+    UT_GenStub_AddParam(CF_Compress_GetFilename, char *, buf);
+    UT_GenStub_AddParam(CF_Compress_GetFilename, size_t, buf_size);
+    UT_GenStub_AddParam(CF_Compress_GetFilename, CF_EntityId_t, src_eid);
+    UT_GenStub_AddParam(CF_Compress_GetFilename, CF_TransactionSeq_t, seq_num);
+
+    UT_GenStub_Execute(CF_Compress_GetFilename, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Compress_Pack()
+ * ----------------------------------------------------
+ */
+uint32 CF_Compress_Pack(CF_Compress_t *work, const uint8 *raw, uint32 raw_len, uint8 *out)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Compress_Pack, uint32);
+
+    UT_GenStub_AddParam(CF_Compress_Pack, CF_Compress_t *, work);
+    UT_GenStub_AddParam(CF_Compress_Pack, const uint8 *, raw);
+    UT_GenStub_AddParam(CF_Compress_Pack, uint32, raw_len);
+    UT_GenStub_AddParam(CF_Compress_Pack, uint8 *, out);
+
+    UT_GenStub_Execute(CF_Compress_Pack, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Compress_Pack, uint32);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Compress_ParseHeader()
+ * ----------------------------------------------------
+ */
+bool CF_Compress_ParseHeader(const uint8 *hdr, uint32 *packed_len, uint32 *raw_len)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Compress_ParseHeader, bool);
+
+    UT_GenStub_AddParam(CF_Compress_ParseHeader, const uint8 *, hdr);
+    UT_GenStub_AddParam(CF_Compress_ParseHeader, uint32 *, packed_len);
+    UT_GenStub_AddParam(CF_Compress_ParseHeader, uint32 *, raw_len);
+
+    UT_GenStub_Execute(CF_Compress_ParseHeader, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Compress_ParseHeader, bool);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Compress_Unpack()
+ * ----------------------------------------------------
+ */
+bool CF_Compress_Unpack(const uint8 *packed, uint32 packed_len, uint8 *raw, uint32 raw_len)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Compress_Unpack, bool);
+
+    UT_GenStub_AddParam(CF_Compress_Unpack, const uint8 *, packed);
+    UT_GenStub_AddParam(CF_Compress_Unpack, uint32, packed_len);
+    UT_GenStub_AddParam(CF_Compress_Unpack, uint8 *, raw);
+    UT_GenStub_AddParam(CF_Compress_Unpack, uint32, raw_len);
+
+    UT_GenStub_Execute(CF_Compress_Unpack, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Compress_Unpack, bool);
+}
@@ -0,0 +1,71 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Auto-Generated stub implementations for functions defined in cf_delivered header
+ */
+
+#include "cf_delivered.h"
+#include "utgenstub.h"
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Delivered_Add()
+ * ----------------------------------------------------
+ */
+void CF_Delivered_Add(CF_EntityId_t peer_eid, const char *dst_filename, uint32 fsize, uint32 crc)
+{
+    UT_GenStub_AddParam(CF_Delivered_Add, CF_EntityId_t, peer_eid);
+    UT_GenStub_AddParam(CF_Delivered_Add, const char *, dst_filename);
+    UT_GenStub_AddParam(CF_Delivered_Add, uint32, fsize);
+    UT_GenStub_AddParam(CF_Delivered_Add, uint32, crc);
+
+    UT_GenStub_Execute(CF_Delivered_Add, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Delivered_Find()
+ * ----------------------------------------------------
+ */
+const CF_DeliveredEntry_t *CF_Delivered_Find(CF_EntityId_t peer_eid, const char *dst_filename, uint32 fsize)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Delivered_Find, const CF_DeliveredEntry_t *);
+
+    UT_GenStub_AddParam(CF_Delivered_Find, CF_EntityId_t, peer_eid);
+    UT_GenStub_AddParam(CF_Delivered_Find, const char *, dst_filename);
+    UT_GenStub_AddParam(CF_Delivered_Find, uint32, fsize);
+
+    UT_GenStub_Execute(CF_Delivered_Find, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Delivered_Find, const CF_DeliveredEntry_t *);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Delivered_Load()
+ * ----------------------------------------------------
+ */
+void CF_Delivered_Load(void)
+{
+
+    UT_GenStub_Execute(CF_Delivered_Load, Basic, NULL);
+}
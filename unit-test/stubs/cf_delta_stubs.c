@@ -0,0 +1,254 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Auto-Generated stub implementations for functions defined in cf_delta header
+ */
+
+#include "cf_delta.h"
+#include "utgenstub.h"
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Delta_AddSigs()
+ * ----------------------------------------------------
+ */
+void CF_Delta_AddSigs(CF_Delta_t *delta)
+{
+    UT_GenStub_AddParam(CF_Delta_AddSigs, CF_Delta_t *, delta);
+
+    UT_GenStub_Execute(CF_Delta_AddSigs, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Delta_Encode()
+ * ----------------------------------------------------
+ */
+bool CF_Delta_Encode(CF_Delta_t *delta, uint32 fsize)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Delta_Encode, bool);
+
+    UT_GenStub_AddParam(CF_Delta_Encode, CF_Delta_t *, delta);
+    UT_GenStub_AddParam(CF_Delta_Encode, uint32, fsize);
+
+    UT_GenStub_Execute(CF_Delta_Encode, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Delta_Encode, bool);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Delta_GetFilename()
+ * ----------------------------------------------------
+ */
+void CF_Delta_GetFilename(char *buf, size_t buf_size, CF_EntityId_t src_eid, CF_TransactionSeq_t seq_num,
+                          const char *ext)
+{
+    UT_GenStub_AddParam(CF_Delta_GetFilename, char *, buf);
+    UT_GenStub_AddParam(CF_Delta_GetFilename, size_t, buf_size);
+    UT_GenStub_AddParam(CF_Delta_GetFilename, CF_EntityId_t, src_eid);
+    UT_GenStub_AddParam(CF_Delta_GetFilename, CF_TransactionSeq_t, seq_num);
+    UT_GenStub_AddParam(CF_Delta_GetFilename, const char *, ext);
+
+    UT_GenStub_Execute(CF_Delta_GetFilename, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Delta_GetSigFilename()
+ * ----------------------------------------------------
+ */
+void CF_Delta_GetSigFilename(char *buf, size_t buf_size, CF_EntityId_t peer_eid, const char *dst_filename)
+{
+    UT_GenStub_AddParam(CF_Delta_GetSigFilename, char *, buf);
+    UT_GenStub_AddParam(CF_Delta_GetSigFilename, size_t, buf_size);
+    UT_GenStub_AddParam(CF_Delta_GetSigFilename, CF_EntityId_t, peer_eid);
+    UT_GenStub_AddParam(CF_Delta_GetSigFilename, const char *, dst_filename);
+
+    UT_GenStub_Execute(CF_Delta_GetSigFilename, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Delta_LoadSigs()
+ * ----------------------------------------------------
+ */
+bool CF_Delta_LoadSigs(CF_Delta_t *delta, const char *fname)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Delta_LoadSigs, bool);
+
+    UT_GenStub_AddParam(CF_Delta_LoadSigs, CF_Delta_t *, delta);
+    UT_GenStub_AddParam(CF_Delta_LoadSigs, const char *, fname);
+
+    UT_GenStub_Execute(CF_Delta_LoadSigs, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Delta_LoadSigs, bool);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Delta_ParseHeader()
+ * ----------------------------------------------------
+ */
+bool CF_Delta_ParseHeader(const uint8 *in, CF_DeltaHeader_t *hdr)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Delta_ParseHeader, bool);
+
+    UT_GenStub_AddParam(CF_Delta_ParseHeader, const uint8 *, in);
+    UT_GenStub_AddParam(CF_Delta_ParseHeader, CF_DeltaHeader_t *, hdr);
+
+    UT_GenStub_Execute(CF_Delta_ParseHeader, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Delta_ParseHeader, bool);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Delta_ParseOp()
+ * ----------------------------------------------------
+ */
+uint32 CF_Delta_ParseOp(const uint8 *in, uint32 in_len, uint32 *arg, uint32 *count)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Delta_ParseOp, uint32);
+
+    UT_GenStub_AddParam(CF_Delta_ParseOp, const uint8 *, in);
+    UT_GenStub_AddParam(CF_Delta_ParseOp, uint32, in_len);
+    UT_GenStub_AddParam(CF_Delta_ParseOp, uint32 *, arg);
+    UT_GenStub_AddParam(CF_Delta_ParseOp, uint32 *, count);
+
+    UT_GenStub_Execute(CF_Delta_ParseOp, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Delta_ParseOp, uint32);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Delta_PutHeader()
+ * ----------------------------------------------------
+ */
+void CF_Delta_PutHeader(uint8 *out, const CF_DeltaHeader_t *hdr)
+{
+    UT_GenStub_AddParam(CF_Delta_PutHeader, uint8 *, out);
+    UT_GenStub_AddParam(CF_Delta_PutHeader, const CF_DeltaHeader_t *, hdr);
+
+    UT_GenStub_Execute(CF_Delta_PutHeader, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Delta_Roll()
+ * ----------------------------------------------------
+ */
+uint32 CF_Delta_Roll(uint32 weak, uint8 out_byte, uint8 in_byte, uint32 len)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Delta_Roll, uint32);
+
+    UT_GenStub_AddParam(CF_Delta_Roll, uint32, weak);
+    UT_GenStub_AddParam(CF_Delta_Roll, uint8, out_byte);
+    UT_GenStub_AddParam(CF_Delta_Roll, uint8, in_byte);
+    UT_GenStub_AddParam(CF_Delta_Roll, uint32, len);
+
+    UT_GenStub_Execute(CF_Delta_Roll, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Delta_Roll, uint32);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Delta_SaveSigs()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_Delta_SaveSigs(const CF_Delta_t *delta, const char *fname, uint32 fsize)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Delta_SaveSigs, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_Delta_SaveSigs, const CF_Delta_t *, delta);
+    UT_GenStub_AddParam(CF_Delta_SaveSigs, const char *, fname);
+    UT_GenStub_AddParam(CF_Delta_SaveSigs, uint32, fsize);
+
+    UT_GenStub_Execute(CF_Delta_SaveSigs, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Delta_SaveSigs, CFE_Status_t);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Delta_Shift()
+ * ----------------------------------------------------
+ */
+uint32 CF_Delta_Shift(CF_Delta_t *delta)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Delta_Shift, uint32);
+
+    UT_GenStub_AddParam(CF_Delta_Shift, CF_Delta_t *, delta);
+
+    UT_GenStub_Execute(CF_Delta_Shift, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Delta_Shift, uint32);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Delta_Start()
+ * ----------------------------------------------------
+ */
+void CF_Delta_Start(CF_Delta_t *delta, struct CF_Transaction *owner)
+{
+    UT_GenStub_AddParam(CF_Delta_Start, CF_Delta_t *, delta);
+    UT_GenStub_AddParam(CF_Delta_Start, struct CF_Transaction *, owner);
+
+    UT_GenStub_Execute(CF_Delta_Start, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Delta_Strong()
+ * ----------------------------------------------------
+ */
+uint64 CF_Delta_Strong(const uint8 *data, uint32 len)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Delta_Strong, uint64);
+
+    UT_GenStub_AddParam(CF_Delta_Strong, const uint8 *, data);
+    UT_GenStub_AddParam(CF_Delta_Strong, uint32, len);
+
+    UT_GenStub_Execute(CF_Delta_Strong, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Delta_Strong, uint64);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Delta_Weak()
+ * ----------------------------------------------------
+ */
+uint32 CF_Delta_Weak(const uint8 *data, uint32 len)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Delta_Weak, uint32);
+
+    UT_GenStub_AddParam(CF_Delta_Weak, const uint8 *, data);
+    UT_GenStub_AddParam(CF_Delta_Weak, uint32, len);
+
+    UT_GenStub_Execute(CF_Delta_Weak, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Delta_Weak, uint32);
+}
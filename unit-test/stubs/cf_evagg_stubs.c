@@ -0,0 +1,56 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Auto-Generated stub implementations for functions defined in cf_evagg header
+ */
+
+#include "cf_evagg.h"
+#include "utgenstub.h"
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_EvAgg_Suppress()
+ * ----------------------------------------------------
+ */
+bool CF_EvAgg_Suppress(CF_EvAggId_t id, uint32 arg1, uint32 arg2)
+{
+    UT_GenStub_SetupReturnBuffer(CF_EvAgg_Suppress, bool);
+
+    UT_GenStub_AddParam(CF_EvAgg_Suppress, CF_EvAggId_t, id);
+    UT_GenStub_AddParam(CF_EvAgg_Suppress, uint32, arg1);
+    UT_GenStub_AddParam(CF_EvAgg_Suppress, uint32, arg2);
+
+    UT_GenStub_Execute(CF_EvAgg_Suppress, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_EvAgg_Suppress, bool);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_EvAgg_Tick()
+ * ----------------------------------------------------
+ */
+void CF_EvAgg_Tick(void)
+{
+
+    UT_GenStub_Execute(CF_EvAgg_Tick, Basic, NULL);
+}
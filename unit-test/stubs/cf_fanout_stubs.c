@@ -0,0 +1,109 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Auto-Generated stub implementations for functions defined in cf_fanout header
+ */
+
+#include "cf_fanout.h"
+#include "utgenstub.h"
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_FanOut_Attach()
+ * ----------------------------------------------------
+ */
+void CF_FanOut_Attach(CF_FanOut_t *group)
+{
+    UT_GenStub_AddParam(CF_FanOut_Attach, CF_FanOut_t *, group);
+
+    UT_GenStub_Execute(CF_FanOut_Attach, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_FanOut_GetCrc()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_FanOut_GetCrc(CF_FanOut_t *group, CF_Crc_t *crc, uint32 max_bytes)
+{
+    UT_GenStub_SetupReturnBuffer(CF_FanOut_GetCrc, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_FanOut_GetCrc, CF_FanOut_t *, group);
+    UT_GenStub_AddParam(CF_FanOut_GetCrc, CF_Crc_t *, crc);
+    UT_GenStub_AddParam(CF_FanOut_GetCrc, uint32, max_bytes);
+
+    UT_GenStub_Execute(CF_FanOut_GetCrc, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_FanOut_GetCrc, CFE_Status_t);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_FanOut_Open()
+ * ----------------------------------------------------
+ */
+CF_FanOut_t *CF_FanOut_Open(const char *filename)
+{
+    UT_GenStub_SetupReturnBuffer(CF_FanOut_Open, CF_FanOut_t *);
+
+    UT_GenStub_AddParam(CF_FanOut_Open, const char *, filename);
+
+    UT_GenStub_Execute(CF_FanOut_Open, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_FanOut_Open, CF_FanOut_t *);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_FanOut_Read()
+ * ----------------------------------------------------
+ */
+int32 CF_FanOut_Read(CF_FanOut_t *group, uint32 offset, void *buf, uint32 len)
+{
+    UT_GenStub_SetupReturnBuffer(CF_FanOut_Read, int32);
+
+    UT_GenStub_AddParam(CF_FanOut_Read, CF_FanOut_t *, group);
+    UT_GenStub_AddParam(CF_FanOut_Read, uint32, offset);
+    UT_GenStub_AddParam(CF_FanOut_Read, void *, buf);
+    UT_GenStub_AddParam(CF_FanOut_Read, uint32, len);
+
+    UT_GenStub_Execute(CF_FanOut_Read, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_FanOut_Read, int32);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_FanOut_Release()
+ * ----------------------------------------------------
+ */
+bool CF_FanOut_Release(CF_FanOut_t *group, bool success)
+{
+    UT_GenStub_SetupReturnBuffer(CF_FanOut_Release, bool);
+
+    UT_GenStub_AddParam(CF_FanOut_Release, CF_FanOut_t *, group);
+    UT_GenStub_AddParam(CF_FanOut_Release, bool, success);
+
+    UT_GenStub_Execute(CF_FanOut_Release, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_FanOut_Release, bool);
+}
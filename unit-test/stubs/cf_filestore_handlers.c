@@ -0,0 +1,70 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+#include "cf_test_utils.h"
+#include "cf_filestore.h"
+
+/* UT includes */
+#include "uttest.h"
+#include "utstubs.h"
+
+/*----------------------------------------------------------------
+ *
+ * The stubs below always select OSAL, so file access in other tests
+ * still lands on the OS_* stubs and can be checked the same way.
+ *
+ *-----------------------------------------------------------------*/
+static int32 UT_CF_Filestore_OsalLseek(osal_id_t fd, off_t offset, int mode)
+{
+    return OS_lseek(fd, offset, mode);
+}
+
+const CF_Filestore_t CF_Filestore_Osal = {.OpenCreate = OS_OpenCreate,
+                                          .Close      = OS_close,
+                                          .Read       = OS_read,
+                                          .Write      = OS_write,
+                                          .Lseek      = UT_CF_Filestore_OsalLseek,
+                                          .Remove     = OS_remove,
+                                          .Rename     = OS_mv,
+                                          .Stat       = OS_stat,
+                                          .OwnsFd     = NULL};
+
+/*----------------------------------------------------------------
+ *
+ * Default always returns the OSAL filestore
+ *
+ *-----------------------------------------------------------------*/
+void UT_DefaultHandler_CF_Filestore_FromPath(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    const CF_Filestore_t *retval = &CF_Filestore_Osal;
+
+    UT_Stub_SetReturnValue(FuncKey, retval);
+}
+
+/*----------------------------------------------------------------
+ *
+ * Default always returns the OSAL filestore
+ *
+ *-----------------------------------------------------------------*/
+void UT_DefaultHandler_CF_Filestore_FromFd(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    const CF_Filestore_t *retval = &CF_Filestore_Osal;
+
+    UT_Stub_SetReturnValue(FuncKey, retval);
+}
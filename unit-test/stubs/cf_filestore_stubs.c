@@ -0,0 +1,80 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Auto-Generated stub implementations for functions defined in cf_filestore header
+ */
+
+#include "cf_filestore.h"
+#include "utgenstub.h"
+
+void UT_DefaultHandler_CF_Filestore_FromPath(void *, UT_EntryKey_t, const UT_StubContext_t *);
+void UT_DefaultHandler_CF_Filestore_FromFd(void *, UT_EntryKey_t, const UT_StubContext_t *);
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Filestore_FromFd()
+ * ----------------------------------------------------
+ */
+const CF_Filestore_t *CF_Filestore_FromFd(osal_id_t fd)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Filestore_FromFd, const CF_Filestore_t *);
+
+    UT_GenStub_AddParam(CF_Filestore_FromFd, osal_id_t, fd);
+
+    UT_GenStub_Execute(CF_Filestore_FromFd, Basic, UT_DefaultHandler_CF_Filestore_FromFd);
+
+    return UT_GenStub_GetReturnValue(CF_Filestore_FromFd, const CF_Filestore_t *);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Filestore_FromPath()
+ * ----------------------------------------------------
+ */
+const CF_Filestore_t *CF_Filestore_FromPath(const char *fname)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Filestore_FromPath, const CF_Filestore_t *);
+
+    UT_GenStub_AddParam(CF_Filestore_FromPath, const char *, fname);
+
+    UT_GenStub_Execute(CF_Filestore_FromPath, Basic, UT_DefaultHandler_CF_Filestore_FromPath);
+
+    return UT_GenStub_GetReturnValue(CF_Filestore_FromPath, const CF_Filestore_t *);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Filestore_OsalLseek()
+ * ----------------------------------------------------
+ */
+int32 CF_Filestore_OsalLseek(osal_id_t fd, off_t offset, int mode)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Filestore_OsalLseek, int32);
+
+    UT_GenStub_AddParam(CF_Filestore_OsalLseek, osal_id_t, fd);
+    UT_GenStub_AddParam(CF_Filestore_OsalLseek, off_t, offset);
+    UT_GenStub_AddParam(CF_Filestore_OsalLseek, int, mode);
+
+    UT_GenStub_Execute(CF_Filestore_OsalLseek, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Filestore_OsalLseek, int32);
+}
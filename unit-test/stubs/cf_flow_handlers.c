@@ -0,0 +1,48 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+#include "cf_test_utils.h"
+#include "cf_flow.h"
+
+/* UT includes */
+#include "uttest.h"
+#include "utstubs.h"
+
+/*----------------------------------------------------------------
+ *
+ * Default permits sending, so flow control does not get in the way of other tests.
+ * A status code may be set to return false instead.
+ *
+ *-----------------------------------------------------------------*/
+void UT_DefaultHandler_CF_Flow_Permit(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    bool  retval;
+    int32 status_code;
+
+    if (UT_Stub_GetInt32StatusCode(Context, &status_code))
+    {
+        retval = status_code;
+    }
+    else
+    {
+        retval = true;
+    }
+
+    UT_Stub_SetReturnValue(FuncKey, retval);
+}
@@ -0,0 +1,130 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Auto-Generated stub implementations for functions defined in cf_flow header
+ */
+
+#include "cf_flow.h"
+#include "utgenstub.h"
+
+void UT_DefaultHandler_CF_Flow_Permit(void *, UT_EntryKey_t, const UT_StubContext_t *);
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Flow_Cycle()
+ * ----------------------------------------------------
+ */
+void CF_Flow_Cycle(void)
+{
+
+    UT_GenStub_Execute(CF_Flow_Cycle, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Flow_Feedback()
+ * ----------------------------------------------------
+ */
+void CF_Flow_Feedback(CF_FlowPeer_t *peer, uint32 released, uint32 lost)
+{
+    UT_GenStub_AddParam(CF_Flow_Feedback, CF_FlowPeer_t *, peer);
+    UT_GenStub_AddParam(CF_Flow_Feedback, uint32, released);
+    UT_GenStub_AddParam(CF_Flow_Feedback, uint32, lost);
+
+    UT_GenStub_Execute(CF_Flow_Feedback, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Flow_FindPeer()
+ * ----------------------------------------------------
+ */
+CF_FlowPeer_t *CF_Flow_FindPeer(CF_EntityId_t eid)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Flow_FindPeer, CF_FlowPeer_t *);
+
+    UT_GenStub_AddParam(CF_Flow_FindPeer, CF_EntityId_t, eid);
+
+    UT_GenStub_Execute(CF_Flow_FindPeer, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Flow_FindPeer, CF_FlowPeer_t *);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Flow_LookupPeer()
+ * ----------------------------------------------------
+ */
+CF_FlowPeer_t *CF_Flow_LookupPeer(CF_EntityId_t eid)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Flow_LookupPeer, CF_FlowPeer_t *);
+
+    UT_GenStub_AddParam(CF_Flow_LookupPeer, CF_EntityId_t, eid);
+
+    UT_GenStub_Execute(CF_Flow_LookupPeer, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Flow_LookupPeer, CF_FlowPeer_t *);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Flow_Permit()
+ * ----------------------------------------------------
+ */
+bool CF_Flow_Permit(const CF_FlowPeer_t *peer, uint32 bytes)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Flow_Permit, bool);
+
+    UT_GenStub_AddParam(CF_Flow_Permit, const CF_FlowPeer_t *, peer);
+    UT_GenStub_AddParam(CF_Flow_Permit, uint32, bytes);
+
+    UT_GenStub_Execute(CF_Flow_Permit, Basic, UT_DefaultHandler_CF_Flow_Permit);
+
+    return UT_GenStub_GetReturnValue(CF_Flow_Permit, bool);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Flow_Release()
+ * ----------------------------------------------------
+ */
+void CF_Flow_Release(CF_FlowPeer_t *peer, uint32 bytes)
+{
+    UT_GenStub_AddParam(CF_Flow_Release, CF_FlowPeer_t *, peer);
+    UT_GenStub_AddParam(CF_Flow_Release, uint32, bytes);
+
+    UT_GenStub_Execute(CF_Flow_Release, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Flow_Sent()
+ * ----------------------------------------------------
+ */
+void CF_Flow_Sent(CF_FlowPeer_t *peer, uint32 bytes, bool acked)
+{
+    UT_GenStub_AddParam(CF_Flow_Sent, CF_FlowPeer_t *, peer);
+    UT_GenStub_AddParam(CF_Flow_Sent, uint32, bytes);
+    UT_GenStub_AddParam(CF_Flow_Sent, bool, acked);
+
+    UT_GenStub_Execute(CF_Flow_Sent, Basic, NULL);
+}
@@ -0,0 +1,113 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Auto-Generated stub implementations for functions defined in cf_instr header
+ */
+
+#include "cf_instr.h"
+#include "utgenstub.h"
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Instr_Init()
+ * ----------------------------------------------------
+ */
+void CF_Instr_Init(void)
+{
+
+    UT_GenStub_Execute(CF_Instr_Init, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Instr_PduHist()
+ * ----------------------------------------------------
+ */
+CF_InstrHist_t CF_Instr_PduHist(const CF_Logical_PduBuffer_t *ph)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Instr_PduHist, CF_InstrHist_t);
+
+    UT_GenStub_AddParam(CF_Instr_PduHist, const CF_Logical_PduBuffer_t *, ph);
+
+    UT_GenStub_Execute(CF_Instr_PduHist, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Instr_PduHist, CF_InstrHist_t);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Instr_Record()
+ * ----------------------------------------------------
+ */
+void CF_Instr_Record(CF_InstrHist_t id, OS_time_t start)
+{
+    UT_GenStub_AddParam(CF_Instr_Record, CF_InstrHist_t, id);
+    UT_GenStub_AddParam(CF_Instr_Record, OS_time_t, start);
+
+    UT_GenStub_Execute(CF_Instr_Record, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Instr_Reset()
+ * ----------------------------------------------------
+ */
+void CF_Instr_Reset(void)
+{
+
+    UT_GenStub_Execute(CF_Instr_Reset, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Instr_SendDiag()
+ * ----------------------------------------------------
+ */
+void CF_Instr_SendDiag(void)
+{
+
+    UT_GenStub_Execute(CF_Instr_SendDiag, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Instr_SetChannel()
+ * ----------------------------------------------------
+ */
+void CF_Instr_SetChannel(uint8 chan_num)
+{
+    UT_GenStub_AddParam(CF_Instr_SetChannel, uint8, chan_num);
+
+    UT_GenStub_Execute(CF_Instr_SetChannel, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Instr_Start()
+ * ----------------------------------------------------
+ */
+void CF_Instr_Start(OS_time_t *stamp)
+{
+    UT_GenStub_AddParam(CF_Instr_Start, OS_time_t *, stamp);
+
+    UT_GenStub_Execute(CF_Instr_Start, Basic, NULL);
+}
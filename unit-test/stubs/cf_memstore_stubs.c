@@ -0,0 +1,232 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Auto-Generated stub implementations for functions defined in cf_memstore header
+ */
+
+#include "cf_memstore.h"
+#include "utgenstub.h"
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Memstore_Attach()
+ * ----------------------------------------------------
+ */
+int32 CF_Memstore_Attach(const char *fname, const void *buf, uint32 size)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Memstore_Attach, int32);
+
+    UT_GenStub_AddParam(CF_Memstore_Attach, const char *, fname);
+    UT_GenStub_AddParam(CF_Memstore_Attach, const void *, buf);
+    UT_GenStub_AddParam(CF_Memstore_Attach, uint32, size);
+
+    UT_GenStub_Execute(CF_Memstore_Attach, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Memstore_Attach, int32);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Memstore_Close()
+ * ----------------------------------------------------
+ */
+int32 CF_Memstore_Close(osal_id_t fd)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Memstore_Close, int32);
+
+    UT_GenStub_AddParam(CF_Memstore_Close, osal_id_t, fd);
+
+    UT_GenStub_Execute(CF_Memstore_Close, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Memstore_Close, int32);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Memstore_FindFile()
+ * ----------------------------------------------------
+ */
+CF_MemstoreFile_t *CF_Memstore_FindFile(const char *fname)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Memstore_FindFile, CF_MemstoreFile_t *);
+
+    UT_GenStub_AddParam(CF_Memstore_FindFile, const char *, fname);
+
+    UT_GenStub_Execute(CF_Memstore_FindFile, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Memstore_FindFile, CF_MemstoreFile_t *);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Memstore_GetHandle()
+ * ----------------------------------------------------
+ */
+CF_MemstoreHandle_t *CF_Memstore_GetHandle(osal_id_t fd)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Memstore_GetHandle, CF_MemstoreHandle_t *);
+
+    UT_GenStub_AddParam(CF_Memstore_GetHandle, osal_id_t, fd);
+
+    UT_GenStub_Execute(CF_Memstore_GetHandle, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Memstore_GetHandle, CF_MemstoreHandle_t *);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Memstore_Lseek()
+ * ----------------------------------------------------
+ */
+int32 CF_Memstore_Lseek(osal_id_t fd, off_t offset, int mode)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Memstore_Lseek, int32);
+
+    UT_GenStub_AddParam(CF_Memstore_Lseek, osal_id_t, fd);
+    UT_GenStub_AddParam(CF_Memstore_Lseek, off_t, offset);
+    UT_GenStub_AddParam(CF_Memstore_Lseek, int, mode);
+
+    UT_GenStub_Execute(CF_Memstore_Lseek, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Memstore_Lseek, int32);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Memstore_OpenCreate()
+ * ----------------------------------------------------
+ */
+int32 CF_Memstore_OpenCreate(osal_id_t *fd, const char *fname, int32 flags, int32 access)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Memstore_OpenCreate, int32);
+
+    UT_GenStub_AddParam(CF_Memstore_OpenCreate, osal_id_t *, fd);
+    UT_GenStub_AddParam(CF_Memstore_OpenCreate, const char *, fname);
+    UT_GenStub_AddParam(CF_Memstore_OpenCreate, int32, flags);
+    UT_GenStub_AddParam(CF_Memstore_OpenCreate, int32, access);
+
+    UT_GenStub_Execute(CF_Memstore_OpenCreate, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Memstore_OpenCreate, int32);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Memstore_OwnsFd()
+ * ----------------------------------------------------
+ */
+bool CF_Memstore_OwnsFd(osal_id_t fd)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Memstore_OwnsFd, bool);
+
+    UT_GenStub_AddParam(CF_Memstore_OwnsFd, osal_id_t, fd);
+
+    UT_GenStub_Execute(CF_Memstore_OwnsFd, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Memstore_OwnsFd, bool);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Memstore_Read()
+ * ----------------------------------------------------
+ */
+int32 CF_Memstore_Read(osal_id_t fd, void *buf, size_t read_size)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Memstore_Read, int32);
+
+    UT_GenStub_AddParam(CF_Memstore_Read, osal_id_t, fd);
+    UT_GenStub_AddParam(CF_Memstore_Read, void *, buf);
+    UT_GenStub_AddParam(CF_Memstore_Read, size_t, read_size);
+
+    UT_GenStub_Execute(CF_Memstore_Read, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Memstore_Read, int32);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Memstore_Remove()
+ * ----------------------------------------------------
+ */
+int32 CF_Memstore_Remove(const char *fname)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Memstore_Remove, int32);
+
+    UT_GenStub_AddParam(CF_Memstore_Remove, const char *, fname);
+
+    UT_GenStub_Execute(CF_Memstore_Remove, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Memstore_Remove, int32);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Memstore_Rename()
+ * ----------------------------------------------------
+ */
+int32 CF_Memstore_Rename(const char *old_filename, const char *new_filename)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Memstore_Rename, int32);
+
+    UT_GenStub_AddParam(CF_Memstore_Rename, const char *, old_filename);
+    UT_GenStub_AddParam(CF_Memstore_Rename, const char *, new_filename);
+
+    UT_GenStub_Execute(CF_Memstore_Rename, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Memstore_Rename, int32);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Memstore_Stat()
+ * ----------------------------------------------------
+ */
+int32 CF_Memstore_Stat(const char *path, os_fstat_t *filestats)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Memstore_Stat, int32);
+
+    UT_GenStub_AddParam(CF_Memstore_Stat, const char *, path);
+    UT_GenStub_AddParam(CF_Memstore_Stat, os_fstat_t *, filestats);
+
+    UT_GenStub_Execute(CF_Memstore_Stat, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Memstore_Stat, int32);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Memstore_Write()
+ * ----------------------------------------------------
+ */
+int32 CF_Memstore_Write(osal_id_t fd, const void *buf, size_t write_size)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Memstore_Write, int32);
+
+    UT_GenStub_AddParam(CF_Memstore_Write, osal_id_t, fd);
+    UT_GenStub_AddParam(CF_Memstore_Write, const void *, buf);
+    UT_GenStub_AddParam(CF_Memstore_Write, size_t, write_size);
+
+    UT_GenStub_Execute(CF_Memstore_Write, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Memstore_Write, int32);
+}
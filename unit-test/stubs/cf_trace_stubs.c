@@ -0,0 +1,112 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Auto-Generated stub implementations for functions defined in cf_trace header
+ */
+
+#include "cf_trace.h"
+#include "utgenstub.h"
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Trace_CheckState()
+ * ----------------------------------------------------
+ */
+void CF_Trace_CheckState(const CF_TraceState_t *saved, const CF_Transaction_t *txn)
+{
+    UT_GenStub_AddParam(CF_Trace_CheckState, const CF_TraceState_t *, saved);
+    UT_GenStub_AddParam(CF_Trace_CheckState, const CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_Trace_CheckState, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Trace_DumpCycle()
+ * ----------------------------------------------------
+ */
+void CF_Trace_DumpCycle(void)
+{
+
+    UT_GenStub_Execute(CF_Trace_DumpCycle, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Trace_Pdu()
+ * ----------------------------------------------------
+ */
+void CF_Trace_Pdu(CF_TraceEvent_t event, uint8 chan_num, const CF_Logical_PduBuffer_t *ph)
+{
+    UT_GenStub_AddParam(CF_Trace_Pdu, CF_TraceEvent_t, event);
+    UT_GenStub_AddParam(CF_Trace_Pdu, uint8, chan_num);
+    UT_GenStub_AddParam(CF_Trace_Pdu, const CF_Logical_PduBuffer_t *, ph);
+
+    UT_GenStub_Execute(CF_Trace_Pdu, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Trace_Record()
+ * ----------------------------------------------------
+ */
+void CF_Trace_Record(CF_TraceEvent_t event, uint8 chan_num, uint32 seq_num, uint8 code, uint8 sub_code, uint32 offset, uint16 length)
+{
+    UT_GenStub_AddParam(CF_Trace_Record, CF_TraceEvent_t, event);
+    UT_GenStub_AddParam(CF_Trace_Record, uint8, chan_num);
+    UT_GenStub_AddParam(CF_Trace_Record, uint32, seq_num);
+    UT_GenStub_AddParam(CF_Trace_Record, uint8, code);
+    UT_GenStub_AddParam(CF_Trace_Record, uint8, sub_code);
+    UT_GenStub_AddParam(CF_Trace_Record, uint32, offset);
+    UT_GenStub_AddParam(CF_Trace_Record, uint16, length);
+
+    UT_GenStub_Execute(CF_Trace_Record, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Trace_SaveState()
+ * ----------------------------------------------------
+ */
+void CF_Trace_SaveState(CF_TraceState_t *saved, const CF_Transaction_t *txn)
+{
+    UT_GenStub_AddParam(CF_Trace_SaveState, CF_TraceState_t *, saved);
+    UT_GenStub_AddParam(CF_Trace_SaveState, const CF_Transaction_t *, txn);
+
+    UT_GenStub_Execute(CF_Trace_SaveState, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_Trace_StartDump()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_Trace_StartDump(const char *filename)
+{
+    UT_GenStub_SetupReturnBuffer(CF_Trace_StartDump, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_Trace_StartDump, const char *, filename);
+
+    UT_GenStub_Execute(CF_Trace_StartDump, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_Trace_StartDump, CFE_Status_t);
+}
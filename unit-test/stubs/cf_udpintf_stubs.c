@@ -0,0 +1,117 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,447-1, and identified as “CFS CFDP (CF)
+ * Application version 3.0.0”
+ *
+ * Copyright (c) 2019 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Auto-Generated stub implementations for functions defined in cf_udpintf header
+ */
+
+#include "cf_udpintf.h"
+#include "utgenstub.h"
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_UdpIntf_Close()
+ * ----------------------------------------------------
+ */
+void CF_UdpIntf_Close(uint8 chan_num)
+{
+    UT_GenStub_AddParam(CF_UdpIntf_Close, uint8, chan_num);
+
+    UT_GenStub_Execute(CF_UdpIntf_Close, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_UdpIntf_GetBuffer()
+ * ----------------------------------------------------
+ */
+void *CF_UdpIntf_GetBuffer(uint8 chan_num, size_t *encap_hdr_size)
+{
+    UT_GenStub_SetupReturnBuffer(CF_UdpIntf_GetBuffer, void *);
+
+    UT_GenStub_AddParam(CF_UdpIntf_GetBuffer, uint8, chan_num);
+    UT_GenStub_AddParam(CF_UdpIntf_GetBuffer, size_t *, encap_hdr_size);
+
+    UT_GenStub_Execute(CF_UdpIntf_GetBuffer, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_UdpIntf_GetBuffer, void *);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_UdpIntf_Open()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_UdpIntf_Open(uint8 chan_num)
+{
+    UT_GenStub_SetupReturnBuffer(CF_UdpIntf_Open, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_UdpIntf_Open, uint8, chan_num);
+
+    UT_GenStub_Execute(CF_UdpIntf_Open, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_UdpIntf_Open, CFE_Status_t);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_UdpIntf_ReceiveBatch()
+ * ----------------------------------------------------
+ */
+uint32 CF_UdpIntf_ReceiveBatch(uint8 chan_num, CF_TransportRxMsg_t *msgs, uint32 max_msgs)
+{
+    UT_GenStub_SetupReturnBuffer(CF_UdpIntf_ReceiveBatch, uint32);
+
+    UT_GenStub_AddParam(CF_UdpIntf_ReceiveBatch, uint8, chan_num);
+    UT_GenStub_AddParam(CF_UdpIntf_ReceiveBatch, CF_TransportRxMsg_t *, msgs);
+    UT_GenStub_AddParam(CF_UdpIntf_ReceiveBatch, uint32, max_msgs);
+
+    UT_GenStub_Execute(CF_UdpIntf_ReceiveBatch, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_UdpIntf_ReceiveBatch, uint32);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_UdpIntf_ReleaseBuffer()
+ * ----------------------------------------------------
+ */
+void CF_UdpIntf_ReleaseBuffer(uint8 chan_num, void *buf)
+{
+    UT_GenStub_AddParam(CF_UdpIntf_ReleaseBuffer, uint8, chan_num);
+    UT_GenStub_AddParam(CF_UdpIntf_ReleaseBuffer, void *, buf);
+
+    UT_GenStub_Execute(CF_UdpIntf_ReleaseBuffer, Basic, NULL);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_UdpIntf_Send()
+ * ----------------------------------------------------
+ */
+void CF_UdpIntf_Send(uint8 chan_num, void *buf, size_t pdu_size)
+{
+    UT_GenStub_AddParam(CF_UdpIntf_Send, uint8, chan_num);
+    UT_GenStub_AddParam(CF_UdpIntf_Send, void *, buf);
+    UT_GenStub_AddParam(CF_UdpIntf_Send, size_t, pdu_size);
+
+    UT_GenStub_Execute(CF_UdpIntf_Send, Basic, NULL);
+}
@@ -33,6 +33,8 @@
 
 #include "cf_assert.h"
 
+#include <string.h>
+
 /* UT includes */
 #include "uttest.h"
 #include "utstubs.h"
@@ -214,3 +216,22 @@ void UT_DefaultHandler_CF_TxnStatus_IsError(void *UserObj, UT_EntryKey_t FuncKey
 
     UT_Stub_SetReturnValue(FuncKey, result);
 }
+
+/*----------------------------------------------------------------
+ *
+ * Function: UT_DefaultHandler_CF_WrappedStat
+ *
+ * Fill in the file information from the test-provided data buffer, or zero it
+ *
+ *-----------------------------------------------------------------*/
+void UT_DefaultHandler_CF_WrappedStat(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    os_fstat_t *filestats = UT_Hook_GetArgValueByName(Context, "filestats", os_fstat_t *);
+    int32       status    = OS_SUCCESS;
+
+    UT_Stub_GetInt32StatusCode(Context, &status);
+    if (status == OS_SUCCESS && UT_Stub_CopyToLocal(FuncKey, filestats, sizeof(*filestats)) < sizeof(*filestats))
+    {
+        memset(filestats, 0, sizeof(*filestats));
+    }
+}
@@ -33,9 +33,23 @@ void UT_DefaultHandler_CF_TraverseAllTransactions(void *, UT_EntryKey_t, const U
 void UT_DefaultHandler_CF_TraverseAllTransactions_All_Channels(void *, UT_EntryKey_t, const UT_StubContext_t *);
 void UT_DefaultHandler_CF_TxnStatus_IsError(void *, UT_EntryKey_t, const UT_StubContext_t *);
 void UT_DefaultHandler_CF_WrappedOpenCreate(void *, UT_EntryKey_t, const UT_StubContext_t *);
+void UT_DefaultHandler_CF_WrappedStat(void *, UT_EntryKey_t, const UT_StubContext_t *);
 void UT_DefaultHandler_CF_WriteHistoryQueueDataToFile(void *, UT_EntryKey_t, const UT_StubContext_t *);
 void UT_DefaultHandler_CF_WriteTxnQueueDataToFile(void *, UT_EntryKey_t, const UT_StubContext_t *);
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_AddElapsedUsec()
+ * ----------------------------------------------------
+ */
+void CF_AddElapsedUsec(uint32 *total, OS_time_t since)
+{
+    UT_GenStub_AddParam(CF_AddElapsedUsec, uint32 *, total);
+    UT_GenStub_AddParam(CF_AddElapsedUsec, OS_time_t, since);
+
+    UT_GenStub_Execute(CF_AddElapsedUsec, Basic, NULL);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_FindTransactionBySequenceNumber()
@@ -346,6 +360,56 @@ CFE_Status_t CF_WrappedRead(osal_id_t fd, void *buf, size_t read_size)
     return UT_GenStub_GetReturnValue(CF_WrappedRead, CFE_Status_t);
 }
 
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_WrappedRemove()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_WrappedRemove(const char *fname)
+{
+    UT_GenStub_SetupReturnBuffer(CF_WrappedRemove, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_WrappedRemove, const char *, fname);
+
+    UT_GenStub_Execute(CF_WrappedRemove, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_WrappedRemove, CFE_Status_t);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_WrappedRename()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_WrappedRename(const char *old_filename, const char *new_filename)
+{
+    UT_GenStub_SetupReturnBuffer(CF_WrappedRename, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_WrappedRename, const char *, old_filename);
+    UT_GenStub_AddParam(CF_WrappedRename, const char *, new_filename);
+
+    UT_GenStub_Execute(CF_WrappedRename, Basic, NULL);
+
+    return UT_GenStub_GetReturnValue(CF_WrappedRename, CFE_Status_t);
+}
+
+/*
+ * ----------------------------------------------------
+ * Generated stub function for CF_WrappedStat()
+ * ----------------------------------------------------
+ */
+CFE_Status_t CF_WrappedStat(const char *path, os_fstat_t *filestats)
+{
+    UT_GenStub_SetupReturnBuffer(CF_WrappedStat, CFE_Status_t);
+
+    UT_GenStub_AddParam(CF_WrappedStat, const char *, path);
+    UT_GenStub_AddParam(CF_WrappedStat, os_fstat_t *, filestats);
+
+    UT_GenStub_Execute(CF_WrappedStat, Basic, UT_DefaultHandler_CF_WrappedStat);
+
+    return UT_GenStub_GetReturnValue(CF_WrappedStat, CFE_Status_t);
+}
+
 /*
  * ----------------------------------------------------
  * Generated stub function for CF_WrappedWrite()
@@ -72,6 +72,7 @@ typedef struct
     uint8           chan;
     uint8           priority;
     CF_EntityId_t   dest_id;
+    uint8           compress;
 } CF_CFDP_TxFile_context_t;
 
 typedef struct
@@ -83,6 +84,9 @@ typedef struct
     uint8           chan;
     uint8           priority;
     CF_EntityId_t   dest_id;
+    uint8           max_ts;
+    uint8           order;
+    uint8           compress;
 } CF_CFDP_PlaybackDir_context_t;
 
 typedef struct